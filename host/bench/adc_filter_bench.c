@@ -0,0 +1,134 @@
+#include "App.h"
+
+// Micro-benchmark of the ADC EMA filtering: the filter bank of ADC_driver.c against the unrolled code it
+// replaced (tests/adc_filter_ref.c). Both are compiled into this translation unit so the compiler can
+// inline them the same way it does in the ISR. Each iteration loads new samples, then filters them with
+// the multiplexer selection of that scan.
+
+#include "ADC_driver.c"
+#include "adc_filter_ref.c"
+
+#define BENCH_SAMPLE_SETS 1024u  // Sample sets cycled through, power of two
+#define BENCH_ROUNDS      7u     // The best round is reported
+
+static uint16_t  g_samples[BENCH_SAMPLE_SETS][32];
+static T_adc_ref g_ref;
+
+__attribute__((noinline)) static void _Bench_bank_scan(uint32_t n)
+{
+  const uint16_t *p_s = g_samples[n & (BENCH_SAMPLE_SETS - 1)];
+
+  adc.active_motor = (uint8_t)((n >> 1) & 1u);
+  adc.active_phase = (uint8_t)(n % 3u);
+  memcpy(adc.smpl_dir, &p_s[0], sizeof(adc.smpl_dir));
+  memcpy(adc.smpl_mot[adc.active_motor], &p_s[8], sizeof(adc.smpl_mot[0]));
+  memcpy(adc.smpl_phase[adc.active_phase], &p_s[16], sizeof(adc.smpl_phase[0]));
+  _Adc_apply_ema_filtering();
+}
+
+__attribute__((noinline)) static void _Bench_ref_scan(uint32_t n)
+{
+  const uint16_t *p_s = g_samples[n & (BENCH_SAMPLE_SETS - 1)];
+
+  g_ref.active_motor       = (uint8_t)((n >> 1) & 1u);
+  g_ref.active_phase       = (uint8_t)(n % 3u);
+  g_ref.smpl_v24v_mon      = p_s[0];
+  g_ref.smpl_v5v_mon       = p_s[1];
+  g_ref.smpl_v3v3_mon      = p_s[2];
+  g_ref.smpl_thermistor_m1 = p_s[3];
+  g_ref.smpl_thermistor_m2 = p_s[4];
+  g_ref.smpl_cpu_temp      = p_s[5];
+  if (g_ref.active_motor == ADC_MOTOR_1)
+  {
+    g_ref.smpl_i_u_motor1   = p_s[8];
+    g_ref.smpl_i_v_motor1   = p_s[9];
+    g_ref.smpl_i_w_motor1   = p_s[10];
+    g_ref.smpl_ipwr_motor1  = p_s[11];
+    g_ref.smpl_speed_motor1 = p_s[12];
+    g_ref.smpl_pos_motor1   = p_s[13];
+  }
+  else
+  {
+    g_ref.smpl_i_u_motor2   = p_s[8];
+    g_ref.smpl_i_v_motor2   = p_s[9];
+    g_ref.smpl_i_w_motor2   = p_s[10];
+    g_ref.smpl_ipwr_motor2  = p_s[11];
+    g_ref.smpl_speed_motor2 = p_s[12];
+    g_ref.smpl_pos_motor2   = p_s[13];
+  }
+  switch (g_ref.active_phase)
+  {
+    case ADC_PHASE_U:
+      g_ref.smpl_v_u_motor1 = p_s[16];
+      g_ref.smpl_v_u_motor2 = p_s[17];
+      break;
+    case ADC_PHASE_V:
+      g_ref.smpl_v_v_motor1 = p_s[16];
+      g_ref.smpl_v_v_motor2 = p_s[17];
+      break;
+    default:
+      g_ref.smpl_v_w_motor1 = p_s[16];
+      g_ref.smpl_v_w_motor2 = p_s[17];
+      break;
+  }
+  Adc_ref_apply_ema_filtering(&g_ref);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Best time per scan over several rounds
+
+  Parameters: scan   - scan function
+              scans  - scans per round
+
+  Return: Time per scan [ns]
+-----------------------------------------------------------------------------------------------------*/
+static double _Bench_measure(void (*scan)(uint32_t), uint32_t scans)
+{
+  double best = 1e30;
+
+  for (uint32_t r = 0; r < BENCH_ROUNDS; r++)
+  {
+    uint64_t t0 = Host_time_ns();
+    for (uint32_t n = 0; n < scans; n++)
+    {
+      scan(n);
+    }
+    double ns = (double)(Host_time_ns() - t0) / scans;
+    if (ns < best)
+    {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t scans = 2000000;
+  uint32_t rnd   = 1;
+
+  if (argc > 1)
+  {
+    scans = (uint32_t)strtoul(argv[1], NULL, 0);
+  }
+  for (uint32_t i = 0; i < BENCH_SAMPLE_SETS; i++)
+  {
+    for (uint32_t j = 0; j < 32; j++)
+    {
+      rnd             = rnd * 1664525u + 1013904223u;
+      g_samples[i][j] = (uint16_t)(rnd >> 20);
+    }
+  }
+  Adc_driver_set_pwm_frequency(16000);
+  _Bench_bank_scan(0);  // First call initializes the filter states
+  _Bench_ref_scan(0);
+
+  double bank_ns = _Bench_measure(_Bench_bank_scan, scans);
+  double ref_ns  = _Bench_measure(_Bench_ref_scan, scans);
+
+  printf("ADC EMA filtering, %u scans, best of %u rounds\n", scans, BENCH_ROUNDS);
+  printf("  filter bank      %6.2f ns/scan\n", bank_ns);
+  printf("  unrolled (old)   %6.2f ns/scan\n", ref_ns);
+  printf("  ratio bank/old   %6.2f\n", bank_ns / ref_ns);
+  return 0;
+}
@@ -0,0 +1,142 @@
+#include "App.h"
+#include "freemaster_private.h"
+
+// Cost of the FreeMASTER recorder in the ADC ISR for each decimation setting. Fmstr_rec_isr is called
+// once per simulated PWM cycle as in Adc_scan_end_isr, with the fault capture configuration armed at
+// start and with a configuration at the sampling cost limits of freemaster_rec.c: FMSTR_REC_MAX_COPY_RUNS
+// separate variables, FMSTR_REC_MAX_TRG_VARS of them with a trigger that never fires.
+
+#define BENCH_ROUNDS    5u                  // The best round is reported
+#define BENCH_LIMIT_VAR (2u * FMSTR_REC_MAX_COPY_RUNS)
+
+static uint32_t g_bench_vars[BENCH_LIMIT_VAR];  // Every second word is recorded, so no runs are merged
+static uint32_t g_bench_threshold = 0xFFFFFFFFu;
+
+FMSTR_TSA_TABLE_BEGIN(bench_vars)
+FMSTR_TSA_RW_MEM(adc, FMSTR_TSA_UINT8, &adc, sizeof(adc))
+FMSTR_TSA_RW_MEM(g_bench_vars, FMSTR_TSA_UINT8, g_bench_vars, sizeof(g_bench_vars))
+FMSTR_TSA_RW_MEM(g_bench_threshold, FMSTR_TSA_UINT8, &g_bench_threshold, sizeof(g_bench_threshold))
+FMSTR_TSA_TABLE_END();
+
+FMSTR_TSA_TABLE_LIST_BEGIN()
+FMSTR_TSA_TABLE(bench_vars)
+FMSTR_TSA_TABLE_LIST_END()
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Configure and start the recorder at the sampling cost limits
+
+  Parameters:
+
+  Return: RES_OK or RES_ERROR
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Bench_limit_config(void)
+{
+  FMSTR_REC_CFG cfg;
+  FMSTR_REC_VAR var;
+
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.varCount = (FMSTR_SIZE8)FMSTR_REC_MAX_COPY_RUNS;
+  if (!FMSTR_RecorderConfigure(FMREC_INDEX, &cfg)) return RES_ERROR;
+
+  for (uint32_t i = 0; i < FMSTR_REC_MAX_COPY_RUNS; i++)
+  {
+    memset(&var, 0, sizeof(var));
+    var.addr = (FMSTR_ADDR)&g_bench_vars[2 * i];
+    var.size = sizeof(uint32_t);
+    if (i < FMSTR_REC_MAX_TRG_VARS)
+    {
+      var.trgAddr     = (FMSTR_ADDR)&g_bench_threshold;
+      var.triggerMode = FMSTR_REC_TRG_TYPE_UINT | FMSTR_REC_TRG_F_ABOVE | FMSTR_REC_TRG_F_VARTHR;
+    }
+    if (!FMSTR_RecorderAddVariable(FMREC_INDEX, (FMSTR_INDEX)i, &var)) return RES_ERROR;
+  }
+  if (!FMSTR_RecorderStart(FMREC_INDEX)) return RES_ERROR;
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Run the recorder ISR for a number of PWM cycles
+
+  Parameters: decimation - PWM cycles per sample
+              cycles     - PWM cycles per round
+              p_rep      - sample time report of the best round
+
+  Return: Average time per ISR call of the best round [ns]
+-----------------------------------------------------------------------------------------------------*/
+static double _Bench_run(uint32_t decimation, uint32_t cycles, T_cycle_profile_report *p_rep)
+{
+  double best = 1e30;
+
+  memset(p_rep, 0, sizeof(*p_rep));
+  Fmstr_rec_set_decimation(decimation);
+  for (uint32_t r = 0; r < BENCH_ROUNDS; r++)
+  {
+    T_cycle_profile_report rep;
+    uint64_t               t0;
+    double                 ns;
+
+    Cycle_profile_reset(&g_fmrec_isr_profile);
+    t0 = Host_time_ns();
+    for (uint32_t n = 0; n < cycles; n++)
+    {
+      g_bench_vars[n & (BENCH_LIMIT_VAR - 1)] = n;
+      Fmstr_rec_isr();
+    }
+    ns = (double)(Host_time_ns() - t0) / cycles;
+    Cycle_profile_get_report(&g_fmrec_isr_profile, &rep);
+    if (ns < best)
+    {
+      best   = ns;
+      *p_rep = rep;
+    }
+  }
+  return best;
+}
+
+int main(int argc, char **argv)
+{
+  static const uint32_t decimations[] = {1, 2, 4, 8, 16, 100, FMREC_MAX_DECIMATION};
+  uint32_t              cycles        = 400000;
+
+  if (argc > 1)
+  {
+    cycles = (uint32_t)strtoul(argv[1], NULL, 0);
+  }
+  Adc_driver_set_pwm_frequency(16000);
+  Cycle_profiler_init();
+  if (!FMSTR_InitRec())
+  {
+    printf("Recorder init failed\n");
+    return 1;
+  }
+  Fmstr_rec_init();  // Arms the fault capture
+
+  for (uint32_t c = 0; c < 2; c++)
+  {
+    if (c == 1)
+    {
+      if (_Bench_limit_config() != RES_OK)
+      {
+        printf("Limit configuration rejected\n");
+        return 1;
+      }
+      printf("\nLimit: %u variables in separate runs, %u with trigger\n", FMSTR_REC_MAX_COPY_RUNS, FMSTR_REC_MAX_TRG_VARS);
+    }
+    else
+    {
+      printf("FreeMASTER recorder in the ADC ISR, PWM %u Hz, %u PWM cycles, best of %u rounds\n", g_adc_pwm_frequency, cycles, BENCH_ROUNDS);
+      printf("Times are host ns, cycles are host ns at %u MHz\n", FRQ_CPUCLK_MHZ);
+      printf("\nFault capture: %u phase currents\n", 6u);
+    }
+    printf("Decimation  Sample rate,Hz   ISR avg,ns  ISR avg,cycles  Sample min,ns  Sample avg,ns\n");
+    for (uint32_t i = 0; i < sizeof(decimations) / sizeof(decimations[0]); i++)
+    {
+      T_cycle_profile_report rep;
+      double                 isr_ns = _Bench_run(decimations[i], cycles, &rep);
+
+      printf("%10u  %14u  %11.2f  %14.1f  %13u  %13u\n", decimations[i], g_adc_pwm_frequency / decimations[i], isr_ns,
+             isr_ns * FRQ_CPUCLK_MHZ / 1000.0, rep.min_ns, rep.avg_ns);
+    }
+  }
+  return 0;
+}
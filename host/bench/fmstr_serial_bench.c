@@ -0,0 +1,126 @@
+#include "App.h"
+#include "fmstr_usb_model.h"
+#include "../../src/FreeMaster/freemaster_serial.c"
+
+// Memory read throughput of the FreeMASTER serial transport over the USB driver model (fmstr_usb_model.c):
+// the time of FMSTR_Poll for a stream of READMEM commands, from the USB packets to the encoded reply.
+// Requests arrive in 64 byte packets as from the USB FS bulk endpoint, and in 1 byte packets that make
+// the transport take the bytes one by one as the per byte receive path did. The payload rate the USB
+// FS line allows is computed from the wire bytes of a request and its reply: 19 bulk packets of 64 bytes
+// per 1 ms frame, 1.216 MB/s for both directions together.
+//
+// Usage: fmstr_serial_bench [rounds]
+
+#define BENCH_ROUNDS_DEF  20u
+#define BENCH_REQUESTS    1000u
+#define BENCH_MEM_SIZE    4096u
+#define BENCH_USB_FS_MBPS (19.0 * 64.0 * 1000.0 / 1e6)  // Bulk payload per 1 ms frame
+
+static uint8_t        g_mem[BENCH_MEM_SIZE];
+static uint8_t        g_stream[BENCH_REQUESTS * 24u];
+static const uint32_t g_sizes[]   = {16, 64, 128, FMSTR_COMM_BUFFER_SIZE};
+static const uint32_t g_packets[] = {64, 1};
+
+FMSTR_TSA_TABLE_BEGIN(bench_vars)
+FMSTR_TSA_RW_MEM(g_mem, FMSTR_TSA_UINT8, g_mem, sizeof(g_mem))
+FMSTR_TSA_TABLE_END();
+
+FMSTR_TSA_TABLE_LIST_BEGIN()
+FMSTR_TSA_TABLE(bench_vars)
+FMSTR_TSA_TABLE_LIST_END()
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Build a stream of READMEM commands of one size at offsets moving through the memory
+
+  Parameters: size - bytes read by a command
+
+  Return: Number of bytes of the stream
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Bench_build_stream(uint32_t size)
+{
+  uint32_t len = 0;
+
+  for (uint32_t r = 0; r < BENCH_REQUESTS; r++)
+  {
+    uint8_t  payload[24];
+    uint32_t offs = (r * 97u) % (BENCH_MEM_SIZE - size);
+    uint32_t n    = Fmstr_pc_uleb(payload, (uint64_t)(uintptr_t)&g_mem[offs]);
+
+    n   += Fmstr_pc_uleb(&payload[n], size);
+    len += Fmstr_pc_encode(FMSTR_CMD_READMEM, payload, n, &g_stream[len]);
+  }
+  return len;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Poll the transport until the stream is processed
+
+  Parameters: len    - number of bytes of the stream
+              packet - USB packet size
+
+  Return: Time [ns] or 0 if a request was not answered
+-----------------------------------------------------------------------------------------------------*/
+static uint64_t _Bench_run(uint32_t len, uint32_t packet)
+{
+  uint64_t t0;
+  uint64_t t1;
+
+  Fmstr_usb_model_reset();
+  Fmstr_usb_model_put(g_stream, len, packet, packet);
+  t0 = Host_time_ns();
+  while (Fmstr_usb_model_pending() > 0)
+  {
+    FMSTR_Poll();
+  }
+  t1 = Host_time_ns();
+  return (g_fmstr_usb_tx_writes == BENCH_REQUESTS) ? (t1 - t0) : 0;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t rounds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_ROUNDS_DEF;
+
+  for (uint32_t i = 0; i < BENCH_MEM_SIZE; i++)
+  {
+    g_mem[i] = (uint8_t)(i * 7u);  // SOB bytes among the data, the reply has escapes
+  }
+  frm_serial_drv = &g_fmstr_usb_model;
+  if (!FMSTR_Init((void *)&FMSTR_SERIAL))
+  {
+    return 1;
+  }
+  printf("FreeMASTER serial READMEM benchmark (host), %u requests, best of %u rounds\n", (unsigned)BENCH_REQUESTS, (unsigned)rounds);
+  printf("  %6s %7s %9s %9s %10s %10s %10s\n", "Size", "Packet", "Req,B", "Reply,B", "Time,us", "CPU MB/s", "USB MB/s");
+
+  for (uint32_t s = 0; s < sizeof(g_sizes) / sizeof(g_sizes[0]); s++)
+  {
+    uint32_t size = g_sizes[s];
+    uint32_t len  = _Bench_build_stream(size);
+
+    for (uint32_t p = 0; p < sizeof(g_packets) / sizeof(g_packets[0]); p++)
+    {
+      uint64_t best = UINT64_MAX;
+      double   req;
+      double   reply;
+      double   us;
+
+      for (uint32_t r = 0; r < rounds; r++)
+      {
+        uint64_t ns = _Bench_run(len, g_packets[p]);
+
+        if (ns == 0)
+        {
+          printf("Requests of %u bytes were not answered\n", (unsigned)size);
+          return 1;
+        }
+        best = (ns < best) ? ns : best;
+      }
+      req   = (double)len / BENCH_REQUESTS;
+      reply = (double)g_fmstr_usb_tx_len / BENCH_REQUESTS;
+      us    = (double)best / 1000.0 / BENCH_REQUESTS;
+      printf("  %6u %7u %9.1f %9.1f %10.3f %10.1f %10.3f\n", (unsigned)size, (unsigned)g_packets[p], req, reply, us, (double)size / us,
+             BENCH_USB_FS_MBPS * size / (req + reply));
+    }
+  }
+  return 0;
+}
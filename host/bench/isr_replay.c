@@ -0,0 +1,324 @@
+#include "App.h"
+#include <setjmp.h>
+
+// ISR replay benchmark. Runs the motor driver thread of the firmware on the host and replays the ADC
+// scan end interrupt at the PWM frequency with synthetic ADC codes. All four motors are started with
+// the selected acceleration algorithm and stopped again before the end of the run.
+//
+// Reported: execution time of Adc_scan_end_isr (distribution and worst-case jitter), execution time of
+// Motor_soft_start_process per motor thread tick and of the whole motor loop iteration.
+// Times are host nanoseconds. They rank code changes against each other, target cycles are measured
+// with the DWT profiles of the firmware.
+
+void Adc_scan_end_isr(void);
+
+#define BENCH_START_TICK    50u  // Motor thread tick of the soft start command, after the current offset calibration
+#define BENCH_TARGET_PWM    80u  // Soft start target [%]
+
+typedef struct
+{
+  uint32_t  pwm_hz;
+  uint32_t  seconds;
+  uint32_t  algorithm;
+  uint32_t  max_isr_ns;   // 0 = no limit
+  uint32_t  max_tick_ns;  // 0 = no limit
+  uint32_t  isr_per_tick;
+  uint32_t  ticks_total;
+  uint32_t  tick;
+  uint32_t *p_isr_ns;
+  uint32_t  isr_num;
+  uint32_t  isr_cap;
+  uint32_t  timer_overhead_ns;
+  uint32_t  noise;
+  uint16_t  pwm_at_stop[4];  // PWM level of each motor when the stop command is sent [%]
+  jmp_buf   done;
+} T_bench;
+
+static T_bench g_bench;
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Noise of the synthetic ADC codes, linear congruential generator
+
+  Parameters:
+
+  Return: Value in the range -8..7
+-----------------------------------------------------------------------------------------------------*/
+static int32_t _Bench_noise(void)
+{
+  g_bench.noise = g_bench.noise * 1664525u + 1013904223u;
+  return (int32_t)(g_bench.noise >> 28) - 8;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Load the ADC result registers with the codes of one scan
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Bench_load_adc_results(void)
+{
+  // Result registers are read only in the device header
+  uint16_t *p_adc0 = (uint16_t *)R_ADC0->ADDR;
+  uint16_t *p_adc1 = (uint16_t *)R_ADC1->ADDR;
+
+  for (uint32_t i = 0; i < 3; i++)
+  {
+    p_adc0[i] = (uint16_t)(2048 + _Bench_noise());  // Phase currents around the zero offset
+    p_adc1[i] = (uint16_t)(2048 + _Bench_noise());
+  }
+  p_adc0[4]  = 2600;                                // Supply 24 V
+  p_adc0[5]  = (uint16_t)(1200 + _Bench_noise());   // Phase voltages
+  p_adc0[6]  = (uint16_t)(1200 + _Bench_noise());
+  p_adc0[16] = 2048;                                // Thermistor, room temperature
+  p_adc1[4]  = 2600;
+  p_adc1[5]  = (uint16_t)(1200 + _Bench_noise());
+  p_adc1[17] = 2048;
+  *(uint16_t *)&R_ADC0->ADTSDR = 1800;            // CPU temperature sensor
+  *(uint16_t *)&R_ADC0->ADOCDR = 2048;            // Internal reference
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Tick hook of the ThreadX shim. Replays the ADC interrupts of one RTOS tick and sends the
+               motor commands of the scenario
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Bench_tick_hook(void)
+{
+  uint32_t stop_tick = g_bench.ticks_total - g_bench.ticks_total / 4;
+
+  for (uint32_t i = 0; i < g_bench.isr_per_tick; i++)
+  {
+    uint64_t t0;
+    uint64_t t1;
+    uint32_t dt;
+
+    _Bench_load_adc_results();
+    t0 = Host_time_ns();
+    Adc_scan_end_isr();
+    t1 = Host_time_ns();
+    dt = (uint32_t)(t1 - t0);
+    dt = (dt > g_bench.timer_overhead_ns) ? (dt - g_bench.timer_overhead_ns) : 0;
+    if (g_bench.isr_num < g_bench.isr_cap)
+    {
+      g_bench.p_isr_ns[g_bench.isr_num++] = dt;
+    }
+  }
+
+  g_bench.tick++;
+  if (g_bench.tick == BENCH_START_TICK)
+  {
+    for (uint8_t m = 1; m <= 4; m++)
+    {
+      Motor_command_soft_start(m, BENCH_TARGET_PWM, MOTOR_DIRECTION_FORWARD);
+    }
+  }
+  else if (g_bench.tick == stop_tick)
+  {
+    for (uint8_t m = 1; m <= 4; m++)
+    {
+      uint8_t enabled;
+      uint8_t direction;
+
+      Motor_get_state(m, &enabled, &g_bench.pwm_at_stop[m - 1], &direction);
+      Motor_command_soft_stop(m);
+    }
+  }
+  else if (g_bench.tick >= g_bench.ticks_total)
+  {
+    longjmp(g_bench.done, 1);
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Cost of one pair of host time reads, subtracted from each ISR measurement
+
+  Parameters:
+
+  Return: Minimum observed cost [ns]
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Bench_timer_overhead(void)
+{
+  uint32_t min_ns = UINT32_MAX;
+
+  for (uint32_t i = 0; i < 10000; i++)
+  {
+    uint64_t t0 = Host_time_ns();
+    uint64_t t1 = Host_time_ns();
+
+    if ((uint32_t)(t1 - t0) < min_ns)
+    {
+      min_ns = (uint32_t)(t1 - t0);
+    }
+  }
+  return min_ns;
+}
+
+static int _Bench_cmp_u32(const void *a, const void *b)
+{
+  uint32_t va = *(const uint32_t *)a;
+  uint32_t vb = *(const uint32_t *)b;
+
+  return (va > vb) - (va < vb);
+}
+
+static uint32_t _Bench_percentile(const uint32_t *p_sorted, uint32_t num, uint32_t per_mille)
+{
+  uint32_t idx = (uint32_t)(((uint64_t)num * per_mille) / 1000u);
+
+  return p_sorted[(idx < num) ? idx : (num - 1)];
+}
+
+static void _Bench_print_profile(const char *name, T_cycle_profile *p_prof)
+{
+  T_cycle_profile_report rep;
+
+  Cycle_profile_get_report(p_prof, &rep);
+  printf("%-26s count %-9u min %-6u avg %-6u max %-7u ns\n", name, rep.count, rep.min_ns, rep.avg_ns, rep.max_ns);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Print usage
+
+  Parameters: prog - program name
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Bench_usage(const char *prog)
+{
+  printf("Usage: %s [--pwm-hz N] [--seconds N] [--alg 0..3] [--max-isr-ns N] [--max-tick-ns N]\n", prog);
+  printf("  --alg: 0 instant, 1 linear, 2 S-curve, 3 jerk limited\n");
+  printf("  --max-isr-ns, --max-tick-ns: fail when the p99.9 ISR time or the average soft start tick exceeds the limit\n");
+}
+
+int main(int argc, char **argv)
+{
+  T_cycle_profile_report soft_rep;
+  TX_THREAD             *p_thread;
+  uint32_t              *p_sorted;
+  uint64_t               sum = 0;
+  int                    res = 0;
+
+  g_bench.pwm_hz    = 16000;
+  g_bench.seconds   = 10;
+  g_bench.algorithm = 2;
+  for (int i = 1; i < argc; i++)
+  {
+    if ((i + 1 < argc) && (strcmp(argv[i], "--pwm-hz") == 0))
+    {
+      g_bench.pwm_hz = (uint32_t)strtoul(argv[++i], NULL, 0);
+    }
+    else if ((i + 1 < argc) && (strcmp(argv[i], "--seconds") == 0))
+    {
+      g_bench.seconds = (uint32_t)strtoul(argv[++i], NULL, 0);
+    }
+    else if ((i + 1 < argc) && (strcmp(argv[i], "--alg") == 0))
+    {
+      g_bench.algorithm = (uint32_t)strtoul(argv[++i], NULL, 0);
+    }
+    else if ((i + 1 < argc) && (strcmp(argv[i], "--max-isr-ns") == 0))
+    {
+      g_bench.max_isr_ns = (uint32_t)strtoul(argv[++i], NULL, 0);
+    }
+    else if ((i + 1 < argc) && (strcmp(argv[i], "--max-tick-ns") == 0))
+    {
+      g_bench.max_tick_ns = (uint32_t)strtoul(argv[++i], NULL, 0);
+    }
+    else
+    {
+      _Bench_usage(argv[0]);
+      return 2;
+    }
+  }
+  if ((g_bench.pwm_hz < TX_TIMER_TICKS_PER_SECOND) || (g_bench.seconds == 0) || (g_bench.algorithm > 3))
+  {
+    _Bench_usage(argv[0]);
+    return 2;
+  }
+
+  g_bench.isr_per_tick = g_bench.pwm_hz / TX_TIMER_TICKS_PER_SECOND;
+  g_bench.ticks_total  = g_bench.seconds * TX_TIMER_TICKS_PER_SECOND;
+  g_bench.isr_cap      = g_bench.isr_per_tick * g_bench.ticks_total;
+  g_bench.p_isr_ns     = malloc(g_bench.isr_cap * sizeof(uint32_t));
+  g_bench.noise        = 1;
+  if (g_bench.p_isr_ns == NULL)
+  {
+    printf("Out of memory\n");
+    return 1;
+  }
+
+  Host_params_load_defaults(&wvar_inst);
+  wvar.pwm_frequency     = g_bench.pwm_hz;
+  wvar.motor_1_algorithm = (uint8_t)g_bench.algorithm;
+  wvar.motor_2_algorithm = (uint8_t)g_bench.algorithm;
+  wvar.motor_3_algorithm = (uint8_t)g_bench.algorithm;
+  wvar.motor_4_algorithm = (uint8_t)g_bench.algorithm;
+
+  Motor_thread_create();
+  p_thread = Host_tx_find_thread("Motor Driver");
+  if (p_thread == NULL)
+  {
+    printf("Motor driver thread not created\n");
+    return 1;
+  }
+
+  g_bench.timer_overhead_ns = _Bench_timer_overhead();
+  Host_tx_set_tick_hook(_Bench_tick_hook);
+  if (setjmp(g_bench.done) == 0)
+  {
+    p_thread->tx_thread_entry(p_thread->tx_thread_entry_parameter);
+  }
+  Host_tx_set_tick_hook(NULL);
+
+  if (g_bench.isr_num == 0)
+  {
+    printf("No ISR executed\n");
+    return 1;
+  }
+  p_sorted = g_bench.p_isr_ns;
+  for (uint32_t i = 0; i < g_bench.isr_num; i++)
+  {
+    sum += p_sorted[i];
+  }
+  qsort(p_sorted, g_bench.isr_num, sizeof(uint32_t), _Bench_cmp_u32);
+
+  uint32_t isr_min   = p_sorted[0];
+  uint32_t isr_max   = p_sorted[g_bench.isr_num - 1];
+  uint32_t isr_p999  = _Bench_percentile(p_sorted, g_bench.isr_num, 999);
+  uint32_t isr_avg   = (uint32_t)(sum / g_bench.isr_num);
+  uint32_t period_ns = 1000000000u / g_bench.pwm_hz;
+
+  printf("ISR replay: PWM %u Hz, %u s, algorithm %u, %u ISR, timer overhead %u ns\n", g_bench.pwm_hz, g_bench.seconds, g_bench.algorithm, g_bench.isr_num, g_bench.timer_overhead_ns);
+  printf("Adc_scan_end_isr           min %u avg %u p50 %u p99 %u p99.9 %u max %u ns\n", isr_min, isr_avg, _Bench_percentile(p_sorted, g_bench.isr_num, 500),
+         _Bench_percentile(p_sorted, g_bench.isr_num, 990), isr_p999, isr_max);
+  printf("ISR jitter (max - min)     %u ns, p99.9 - min %u ns, avg load %.2f %% of the PWM period\n", isr_max - isr_min, isr_p999 - isr_min, 100.0 * isr_avg / period_ns);
+  _Bench_print_profile("Motor_soft_start_process", &g_soft_start_profile);
+  _Bench_print_profile("Motor loop iteration", &g_motor_loop_profile);
+
+  printf("PWM at soft stop            %u %u %u %u %%\n", g_bench.pwm_at_stop[0], g_bench.pwm_at_stop[1], g_bench.pwm_at_stop[2], g_bench.pwm_at_stop[3]);
+
+  for (uint32_t m = 0; m < 4; m++)
+  {
+    if (g_bench.pwm_at_stop[m] == 0)
+    {
+      printf("FAIL: motor %u did not start\n", m + 1);
+      res = 1;
+    }
+  }
+  Cycle_profile_get_report(&g_soft_start_profile, &soft_rep);
+  if ((g_bench.max_isr_ns != 0) && (isr_p999 > g_bench.max_isr_ns))
+  {
+    printf("FAIL: ISR p99.9 %u ns > %u ns\n", isr_p999, g_bench.max_isr_ns);
+    res = 1;
+  }
+  if ((g_bench.max_tick_ns != 0) && (soft_rep.avg_ns > g_bench.max_tick_ns))
+  {
+    printf("FAIL: soft start tick avg %u ns > %u ns\n", soft_rep.avg_ns, g_bench.max_tick_ns);
+    res = 1;
+  }
+  free(g_bench.p_isr_ns);
+  return res;
+}
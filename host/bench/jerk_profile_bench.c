@@ -0,0 +1,194 @@
+#include "App.h"
+
+// Worst-case cost of the jerk limited profile of the soft start (SOFT_START_ALG_JERK) for all four
+// motors. The motors get random targets with changes in the middle of moves and reversals, the
+// profile states of every motor thread tick are recorded. Each recorded tick is then replayed:
+// the four states are restored and Motor_profile_step is called for each motor, repeated so the
+// host clock resolves it. The best of several rounds of a tick is its cost, the worst tick is reported.
+// Retargeting, Motor_profile_set_limits and Motor_profile_set_target as in _Jerk_retarget, is measured
+// separately, it runs on a command and not on every tick.
+
+#define BENCH_MOTORS      4u
+#define BENCH_TICKS       20000u  // Motor thread ticks of the move scenario
+#define BENCH_REPEATS     64u     // Replays of a tick per timed batch
+#define BENCH_ROUNDS      3u      // Timed batches of a tick, the best one counts
+
+typedef struct
+{
+  uint32_t max_accel;  // % per second
+  uint32_t max_decel;  // % per second
+  uint32_t jerk;       // % per second^2
+} T_bench_limits;
+
+// Fast, slow and asymmetric motors
+static const T_bench_limits g_limits[BENCH_MOTORS] = {
+  {400, 400, 4000},
+  {50, 50, 100},
+  {200, 800, 20000},
+  {1000, 100, 500},
+};
+
+static T_motor_profile (*g_states)[BENCH_MOTORS];
+static volatile uint16_t g_sink;
+static uint32_t          g_rnd = 7;
+
+static uint32_t _Bench_rand(void)
+{
+  g_rnd = g_rnd * 1664525u + 1013904223u;
+  return g_rnd >> 8;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Run the move scenario and record the profile states before every tick
+
+  Parameters: ticks - number of motor thread ticks
+
+  Return: Number of target changes
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Bench_record(uint32_t ticks)
+{
+  T_motor_profile prof[BENCH_MOTORS];
+  uint32_t        next_change[BENCH_MOTORS];
+  uint32_t        changes = 0;
+  uint16_t        level;
+
+  for (uint32_t m = 0; m < BENCH_MOTORS; m++)
+  {
+    Motor_profile_set_limits(&prof[m], g_limits[m].max_accel, g_limits[m].max_decel, g_limits[m].jerk, MOTOR_SOFT_START_UPDATE_HZ);
+    Motor_profile_reset(&prof[m], 0);
+    next_change[m] = 0;
+  }
+  for (uint32_t t = 0; t < ticks; t++)
+  {
+    for (uint32_t m = 0; m < BENCH_MOTORS; m++)
+    {
+      if (t == next_change[m])
+      {
+        // Most changes come in the middle of a move, some wait until the target is reached
+        Motor_profile_set_target(&prof[m], (uint16_t)((_Bench_rand() % 101) * 100));
+        next_change[m] = t + 20 + _Bench_rand() % 2000;
+        changes++;
+      }
+      g_states[t][m] = prof[m];
+      Motor_profile_step(&prof[m], &level);
+    }
+  }
+  return changes;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Time one recorded tick of the four motors
+
+  Parameters: t - tick
+
+  Return: Time of one update of all motors [ns], best of BENCH_ROUNDS batches
+-----------------------------------------------------------------------------------------------------*/
+static double _Bench_tick(uint32_t t)
+{
+  T_motor_profile prof[BENCH_MOTORS];
+  double          best = 1e30;
+  uint16_t        level;
+
+  for (uint32_t round = 0; round < BENCH_ROUNDS; round++)
+  {
+    uint64_t t0 = Host_time_ns();
+    double   ns;
+
+    for (uint32_t r = 0; r < BENCH_REPEATS; r++)
+    {
+      memcpy(prof, g_states[t], sizeof(prof));
+      for (uint32_t m = 0; m < BENCH_MOTORS; m++)
+      {
+        Motor_profile_step(&prof[m], &level);
+        g_sink = level;
+      }
+    }
+    ns = (double)(Host_time_ns() - t0) / BENCH_REPEATS;
+    if (ns < best)
+    {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Time a retarget of one motor as done by _Jerk_retarget
+
+  Parameters:
+
+  Return: Time [ns]
+-----------------------------------------------------------------------------------------------------*/
+static double _Bench_retarget(void)
+{
+  T_motor_profile prof;
+  const uint32_t  n    = 100000;
+  double          best = 1e30;
+
+  Motor_profile_reset(&prof, 0);
+  for (uint32_t round = 0; round < BENCH_ROUNDS; round++)
+  {
+    uint64_t t0 = Host_time_ns();
+    double   ns;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+      const T_bench_limits *l = &g_limits[i % BENCH_MOTORS];
+
+      Motor_profile_set_limits(&prof, l->max_accel + (i & 1), l->max_decel, l->jerk, MOTOR_SOFT_START_UPDATE_HZ);
+      Motor_profile_set_target(&prof, (uint16_t)(i % 10000));
+      g_sink = (uint16_t)prof.jerk;
+    }
+    ns = (double)(Host_time_ns() - t0) / n;
+    if (ns < best)
+    {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t ticks   = BENCH_TICKS;
+  uint32_t changes;
+  uint32_t worst_t = 0;
+  double   worst   = 0;
+  double   sum     = 0;
+  double   retarget;
+
+  if (argc > 1)
+  {
+    ticks = (uint32_t)strtoul(argv[1], NULL, 10);
+  }
+  if (ticks == 0)
+  {
+    ticks = 1;
+  }
+  g_states = calloc(ticks, sizeof(*g_states));
+  if (g_states == NULL)
+  {
+    return 1;
+  }
+  changes = _Bench_record(ticks);
+
+  for (uint32_t t = 0; t < ticks; t++)
+  {
+    double ns = _Bench_tick(t);
+
+    sum += ns;
+    if (ns > worst)
+    {
+      worst   = ns;
+      worst_t = t;
+    }
+  }
+  retarget = _Bench_retarget();
+
+  printf("Jerk profile: %u motors, %u ticks at %u Hz, %u target changes\n", BENCH_MOTORS, ticks, (unsigned)MOTOR_SOFT_START_UPDATE_HZ, changes);
+  printf("  Update of all motors  avg %7.1f ns %6.1f cycles\n", sum / ticks, sum / ticks * FRQ_CPUCLK_MHZ / 1000.0);
+  printf("                        max %7.1f ns %6.1f cycles (tick %u)\n", worst, worst * FRQ_CPUCLK_MHZ / 1000.0, worst_t);
+  printf("  Retarget of one motor     %7.1f ns %6.1f cycles\n", retarget, retarget * FRQ_CPUCLK_MHZ / 1000.0);
+  free(g_states);
+  return 0;
+}
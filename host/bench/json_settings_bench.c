@@ -0,0 +1,147 @@
+#include "App.h"
+
+// Settings JSON benchmark of Settings_JSON_benchmark on the host: the jansson tree writer and reader
+// against the streaming writer and reader, the same measurement as the 'J' screen of the performance
+// monitor. The firmware parameters are serialized as they are and copied 4 and 16 times under new names
+// to show how the peak heap grows with the number of parameters. Peak heap is the byte pool use of the
+// target as counted by the host heap (shim/host_stubs.c), time is host time, the best of the rounds counts.
+//
+// Usage: json_settings_bench [rounds]
+
+#define BENCH_ROUNDS_DEF 50u
+#define BENCH_NAME_LEN   48u
+#define BENCH_MIN(a, b)  (((a) < (b)) ? (a) : (b))
+
+static const uint32_t           g_scales[] = {1, 4, 16};
+static T_NV_parameters_instance g_bench_inst;
+static char                    *g_bench_names;  // Names of the copies
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Settings instance under the benchmark, in place of the firmware one
+
+  Parameters: ptype - parameter type
+
+  Return: Pointer to the instance or NULL
+-----------------------------------------------------------------------------------------------------*/
+const T_NV_parameters_instance *Get_settings_instance(uint8_t ptype)
+{
+  return (ptype == APPLICATION_PARAMS) ? &g_bench_inst : NULL;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: jansson allocates from the application heap, as set by App_memory_pools_creation
+
+  Parameters: size - block size
+
+  Return: Pointer to the block or NULL
+-----------------------------------------------------------------------------------------------------*/
+static void *_Bench_json_malloc(size_t size)
+{
+  return App_malloc((uint32_t)size);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Build an instance of the firmware parameters copied scale times, copies share the values
+
+  Parameters: scale - number of copies
+
+  Return: 0 on success
+-----------------------------------------------------------------------------------------------------*/
+static int _Bench_build_inst(uint32_t scale)
+{
+  uint32_t         n     = wvar_inst.items_num;
+  T_NV_parameters *items = calloc((size_t)n * scale, sizeof(T_NV_parameters));
+  char            *names = calloc((size_t)n * scale, BENCH_NAME_LEN);
+
+  if ((items == NULL) || (names == NULL))
+  {
+    return -1;
+  }
+  for (uint32_t k = 0; k < scale; k++)
+  {
+    for (uint32_t i = 0; i < n; i++)
+    {
+      T_NV_parameters *p    = &items[k * n + i];
+      char            *name = &names[(k * n + i) * BENCH_NAME_LEN];
+
+      *p = wvar_inst.items_array[i];
+      if (k > 0)
+      {
+        snprintf(name, BENCH_NAME_LEN, "%s_%u", (const char *)p->var_name, (unsigned)k);
+        p->var_name = (const uint8_t *)name;
+      }
+    }
+  }
+  g_bench_names            = names;
+  g_bench_inst             = wvar_inst;
+  g_bench_inst.items_num   = n * scale;
+  g_bench_inst.items_array = items;
+  g_bench_inst.name_index  = (scale == 1) ? wvar_inst.name_index : NULL;
+  g_bench_inst.alias_index = (scale == 1) ? wvar_inst.alias_index : NULL;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Print one result line
+
+  Parameters: name   - path
+              cycles - best time [cycles]
+              heap   - peak heap [bytes]
+              size   - document size [bytes]
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Bench_print_line(const char *name, uint32_t cycles, uint32_t heap, uint32_t size)
+{
+  double us = (double)CYCLES_TO_NS(cycles) / 1000.0;
+
+  printf("  %-14s %10.1f %10u %10.1f\n", name, us, (unsigned)heap, (us > 0) ? ((double)size / us) : 0.0);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t rounds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_ROUNDS_DEF;
+
+  json_set_alloc_funcs(_Bench_json_malloc, App_free);
+  Host_params_load_defaults(&wvar_inst);
+  printf("Settings JSON benchmark (host), best of %u rounds, compact JSON\n", (unsigned)rounds);
+
+  for (uint32_t s = 0; s < sizeof(g_scales) / sizeof(g_scales[0]); s++)
+  {
+    T_settings_json_bench best;
+
+    if (_Bench_build_inst(g_scales[s]) != 0)
+    {
+      return 1;
+    }
+    memset(&best, 0xFF, sizeof(best));
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+      T_settings_json_bench res;
+
+      if ((Settings_JSON_benchmark(APPLICATION_PARAMS, &res) != RES_OK) || (res.done == 0) || (res.json_size != res.tree_json_size))
+      {
+        printf("Benchmark failed with %u parameters\n", (unsigned)g_bench_inst.items_num);
+        return 1;
+      }
+      best.json_size        = res.json_size;
+      best.tree_wr_cycles   = BENCH_MIN(best.tree_wr_cycles, res.tree_wr_cycles);
+      best.stream_wr_cycles = BENCH_MIN(best.stream_wr_cycles, res.stream_wr_cycles);
+      best.tree_rd_cycles   = BENCH_MIN(best.tree_rd_cycles, res.tree_rd_cycles);
+      best.stream_rd_cycles = BENCH_MIN(best.stream_rd_cycles, res.stream_rd_cycles);
+      best.tree_wr_heap     = res.tree_wr_heap;
+      best.stream_wr_heap   = res.stream_wr_heap;
+      best.tree_rd_heap     = res.tree_rd_heap;
+      best.stream_rd_heap   = res.stream_rd_heap;
+    }
+    printf("\n%u parameters, %u bytes\n", (unsigned)g_bench_inst.items_num, (unsigned)best.json_size);
+    printf("  %-14s %10s %10s %10s\n", "Path", "Time,us", "Heap,B", "MB/s");
+    _Bench_print_line("tree write", best.tree_wr_cycles, best.tree_wr_heap, best.json_size);
+    _Bench_print_line("stream write", best.stream_wr_cycles, best.stream_wr_heap, best.json_size);
+    _Bench_print_line("tree read", best.tree_rd_cycles, best.tree_rd_heap, best.json_size);
+    _Bench_print_line("stream read", best.stream_rd_cycles, best.stream_rd_heap, best.json_size);
+    free((void *)g_bench_inst.items_array);
+    free(g_bench_names);
+  }
+  return 0;
+}
@@ -0,0 +1,121 @@
+#include "App.h"
+#include "littlefs_adapter.h"
+#include "littlefs_bench.h"
+
+// LittleFS benchmark of littlefs_bench.c on the host: the workloads of LittleFS monitor key '5' over the
+// RAM NOR flash model, with and without the page cache of the block device layer, and the geometry
+// profiles of littlefs_adapter.h compared as by monitor key '6'. CPU time is host time, flash time is
+// the modeled MX25UM25645G time and does not depend on the host.
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Run the log append, small file rewrite and directory scan workloads for every geometry
+               profile and print ops/s, bytes programmed per payload byte and erases
+
+  Parameters:
+
+  Return: 0 on success, 1 if a profile failed
+-----------------------------------------------------------------------------------------------------*/
+static int _Bench_profiles(void)
+{
+  T_lfs_bench_geo_report rep;
+  int                    failed = 0;
+
+  printf("\nGeometry profiles, log: %u x %u bytes synced, rewrite: %u files x %u bytes x %u, scan: %u files x %u\n",
+         LFS_BENCH_LOG_RECORDS, LFS_BENCH_LOG_RECORD_SZ, LFS_BENCH_RW_FILES, LFS_BENCH_RW_FILE_SZ, LFS_BENCH_RW_ROUNDS,
+         LFS_BENCH_DIR_FILES, LFS_BENCH_DIR_SCANS);
+  printf("Profile   Workload        ops/s  Prog/byte  Prog,bytes  Progs  Erases   CPU,us   Flash,us\n");
+  for (uint32_t n = 0; n < LITTLEFS_PROFILE_COUNT; n++)
+  {
+    const T_littlefs_geometry *geo    = &g_littlefs_profiles[n];
+    int                        result = Littlefs_bench_profile(geo, &rep);
+
+    if (result != 0)
+    {
+      printf("%-9s benchmark failed: %d\n", geo->name, result);
+      failed = 1;
+      continue;
+    }
+    const T_lfs_bench_result *res[3]  = {&rep.log_append, &rep.rewrite, &rep.dir_scan};
+    const char               *name[3] = {"log append", "rewrite", "dir scan"};
+    for (uint32_t i = 0; i < 3; i++)
+    {
+      uint32_t amp_x100 = (res[i]->bytes != 0) ? (uint32_t)(((uint64_t)res[i]->prog_bytes * 100u) / res[i]->bytes) : 0;
+
+      printf("%-9s %-12s %8u %6u.%02u %11u %6u %7u %8u %10u\n",
+             (i == 0) ? geo->name : "",
+             name[i],
+             res[i]->files_per_s,
+             amp_x100 / 100,
+             amp_x100 % 100,
+             res[i]->prog_bytes,
+             res[i]->dev_progs,
+             res[i]->dev_erases,
+             res[i]->cpu_us,
+             res[i]->dev_us);
+    }
+  }
+  printf("Profiles: read/prog/cache/lookahead/block_cycles");
+  for (uint32_t n = 0; n < LITTLEFS_PROFILE_COUNT; n++)
+  {
+    const T_littlefs_geometry *geo = &g_littlefs_profiles[n];
+
+    printf("%s %s %u/%u/%u/%u/%u", (n == 0) ? "" : ",", geo->name, geo->read_size, geo->prog_size, geo->cache_size, geo->lookahead_size,
+           geo->block_cycles);
+  }
+  printf(", OSPI file system: %s\n", g_littlefs_geometry.name);
+  return failed;
+}
+
+int main(void)
+{
+  static const uint32_t page_cache[2] = {0, LITTLEFS_BD_PAGE_SIZE};
+  T_lfs_bench_report    rep;
+  int                   failed = 0;
+
+  printf("LittleFS benchmark (RAM flash model, %u blocks, profile geometry read %u prog %u cache %u)\n",
+         LFS_BENCH_BLOCK_COUNT, g_littlefs_geometry.read_size, g_littlefs_geometry.prog_size, g_littlefs_geometry.cache_size);
+  printf("Small: %u files x %u bytes, large: 1 file x %u bytes\n", LFS_BENCH_SMALL_FILES, LFS_BENCH_SMALL_FILE_SZ, LFS_BENCH_LARGE_FILE_SZ);
+
+  for (uint32_t n = 0; n < 2; n++)
+  {
+    int result = Littlefs_bench_run(page_cache[n], &rep);
+
+    printf("\nPage cache: %u bytes\n", rep.page_cache);
+    if (result != 0)
+    {
+      printf("Benchmark failed: %d\n", result);
+      failed = 1;
+      continue;
+    }
+    printf("Workload      files/s      MB/s   CPU,us   Flash,us  Progs  Erases  Prog bytes\n");
+    const T_lfs_bench_result *res[4]  = {&rep.small_write, &rep.small_read, &rep.large_write, &rep.large_read};
+    const char               *name[4] = {"small write", "small read", "large write", "large read"};
+    for (uint32_t i = 0; i < 4; i++)
+    {
+      printf("%-12s %8u %5u.%03u %8u %10u %6u %7u %11u\n",
+             name[i],
+             res[i]->files_per_s,
+             res[i]->bytes_per_s / 1000000,
+             (res[i]->bytes_per_s / 1000) % 1000,
+             res[i]->cpu_us,
+             res[i]->dev_us,
+             res[i]->dev_progs,
+             res[i]->dev_erases,
+             res[i]->prog_bytes);
+    }
+  }
+
+  if ((rep.erase_sync.reads != 0) && (rep.erase_async.reads != 0))
+  {
+    printf("\nReads during erase of %u sectors, read every %u us on average:\n", LFS_BENCH_LAT_ERASES, LFS_BENCH_LAT_PERIOD_US);
+    printf("Erase         Reads  Worst,us   Avg,us  Erase total,us  Suspends\n");
+    const T_lfs_bench_latency *lat[2]  = {&rep.erase_sync, &rep.erase_async};
+    const char                *mode[2] = {"blocking", "background"};
+    for (uint32_t i = 0; i < 2; i++)
+    {
+      printf("%-12s %6u %9u %8u %15u %9u\n", mode[i], lat[i]->reads, lat[i]->worst_us, lat[i]->avg_us, lat[i]->erase_us, lat[i]->suspends);
+    }
+  }
+  failed |= _Bench_profiles();
+  return failed;
+}
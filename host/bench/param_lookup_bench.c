@@ -0,0 +1,198 @@
+#include "App.h"
+#include "param_lookup_tables.h"
+
+// Cost of the parameter lookups as the parameter database grows: the firmware parameters and the
+// generated sets of 45 to 2000 parameters (param_lookup_tables.h). Every name, alias and CRC16 of a set
+// is looked up once per pass with the perfect hash indexes, Find_param_by_name, Find_param_by_alias and
+// the generated Find_param_by_hash, and with the searches they replaced: the linear search of an
+// instance without indexes and the binary search over the sorted CRC16 table. The best pass is reported
+// as the average time of one lookup.
+
+#define BENCH_ROUNDS 5u  // Timed passes over all keys of a set, the best one counts
+
+typedef struct
+{
+  const T_NV_parameters_instance *p_pars;
+  const T_param_hash_entry       *hash_sorted;
+  const uint16_t                 *index_to_hash;
+  uint16_t                        (*find_by_hash)(uint16_t hash);
+} T_bench_set;
+
+typedef enum
+{
+  BENCH_NAME_LINEAR,
+  BENCH_NAME_PHF,
+  BENCH_ALIAS_LINEAR,
+  BENCH_ALIAS_PHF,
+  BENCH_HASH_BINARY,
+  BENCH_HASH_PHF,
+  BENCH_KIND_COUNT,
+} T_bench_kind;
+
+static const T_param_hash_entry *g_hash_sorted;
+static uint32_t                  g_hash_num;
+static volatile int32_t          g_sink;
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Binary search of Find_param_by_hash before the perfect hash index
+
+  Parameters: hash - CRC16 of the parameter name
+
+  Return: Parameter index or 0xFFFF if not found
+-----------------------------------------------------------------------------------------------------*/
+static uint16_t _Bench_hash_binary(uint16_t hash)
+{
+  int left  = 0;
+  int right = (int)g_hash_num - 1;
+
+  while (left <= right)
+  {
+    int mid = (left + right) / 2;
+    if (g_hash_sorted[mid].hash == hash)
+    {
+      return g_hash_sorted[mid].index;
+    }
+    if (g_hash_sorted[mid].hash < hash)
+    {
+      left = mid + 1;
+    }
+    else
+    {
+      right = mid - 1;
+    }
+  }
+  return 0xFFFF;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Time one lookup kind over all parameters of a set
+
+  Parameters: b    - set
+              kind - lookup
+
+  Return: Average time of one lookup [ns], best of BENCH_ROUNDS passes
+-----------------------------------------------------------------------------------------------------*/
+static double _Bench_kind(const T_bench_set *b, T_bench_kind kind)
+{
+  T_NV_parameters_instance linear = *b->p_pars;
+  uint32_t                 n      = b->p_pars->items_num;
+  double                   best   = 1e30;
+
+  linear.name_index  = NULL;
+  linear.alias_index = NULL;
+  g_hash_sorted      = b->hash_sorted;
+  g_hash_num         = n;
+  for (uint32_t round = 0; round < BENCH_ROUNDS; round++)
+  {
+    uint64_t t0 = Host_time_ns();
+    double   ns;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+      const T_NV_parameters *p = &b->p_pars->items_array[i];
+
+      switch (kind)
+      {
+        case BENCH_NAME_LINEAR:
+          g_sink = Find_param_by_name(&linear, (char *)p->var_name);
+          break;
+        case BENCH_NAME_PHF:
+          g_sink = Find_param_by_name(b->p_pars, (char *)p->var_name);
+          break;
+        case BENCH_ALIAS_LINEAR:
+          g_sink = Find_param_by_alias(&linear, (char *)p->var_alias);
+          break;
+        case BENCH_ALIAS_PHF:
+          g_sink = Find_param_by_alias(b->p_pars, (char *)p->var_alias);
+          break;
+        case BENCH_HASH_BINARY:
+          g_sink = _Bench_hash_binary(b->index_to_hash[i]);
+          break;
+        default:
+          g_sink = b->find_by_hash(b->index_to_hash[i]);
+          break;
+      }
+    }
+    ns = (double)(Host_time_ns() - t0) / n;
+    if (ns < best)
+    {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Print the lookup times of a set
+
+  Parameters: name - label of the set
+              b    - set
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Bench_set(const char *name, const T_bench_set *b)
+{
+  double ns[BENCH_KIND_COUNT];
+
+  for (uint32_t k = 0; k < BENCH_KIND_COUNT; k++)
+  {
+    ns[k] = _Bench_kind(b, (T_bench_kind)k);
+  }
+  printf("%-9s %6u  %9.1f %9.1f  %9.1f %9.1f  %9.1f %9.1f\n", name, (unsigned)b->p_pars->items_num, ns[BENCH_NAME_LINEAR], ns[BENCH_NAME_PHF],
+         ns[BENCH_ALIAS_LINEAR], ns[BENCH_ALIAS_PHF], ns[BENCH_HASH_BINARY], ns[BENCH_HASH_PHF]);
+}
+
+int main(void)
+{
+  uint32_t            wvar_num    = wvar_inst.items_num;
+  T_param_hash_entry *wvar_sorted = calloc(wvar_num, sizeof(T_param_hash_entry));
+  uint16_t           *wvar_hashes = calloc(wvar_num, sizeof(uint16_t));
+  T_bench_set         b;
+
+  if ((wvar_sorted == NULL) || (wvar_hashes == NULL))
+  {
+    return 1;
+  }
+
+  // Sorted CRC16 table of the firmware parameters for the binary search
+  for (uint32_t i = 0; i < wvar_num; i++)
+  {
+    uint32_t j = i;
+
+    wvar_hashes[i] = Get_param_hash_by_index((uint16_t)i);
+    while ((j > 0) && (wvar_sorted[j - 1].hash > wvar_hashes[i]))
+    {
+      wvar_sorted[j] = wvar_sorted[j - 1];
+      j--;
+    }
+    wvar_sorted[j].hash  = wvar_hashes[i];
+    wvar_sorted[j].index = (uint16_t)i;
+  }
+
+  printf("Parameter lookup, ns per lookup (host)\n");
+  printf("%-9s %6s  %9s %9s  %9s %9s  %9s %9s\n", "Set", "Params", "name lin", "name PHF", "alias lin", "alias PHF", "hash bin", "hash PHF");
+  b.p_pars        = &wvar_inst;
+  b.hash_sorted   = wvar_sorted;
+  b.index_to_hash = wvar_hashes;
+  b.find_by_hash  = Find_param_by_hash;
+  _Bench_set("firmware", &b);
+  free(wvar_sorted);
+  free(wvar_hashes);
+
+  for (uint32_t s = 0; s < PARAM_LOOKUP_SETS_NUM; s++)
+  {
+    const T_param_lookup_set *set  = &g_param_lookup_sets[s];
+    T_NV_parameters_instance  inst = {0};
+
+    inst.items_num   = set->items_num;
+    inst.items_array = set->items_array;
+    inst.name_index  = set->name_index;
+    inst.alias_index = set->alias_index;
+    b.p_pars         = &inst;
+    b.hash_sorted    = set->hash_sorted;
+    b.index_to_hash  = set->index_to_hash;
+    b.find_by_hash   = set->find_by_hash;
+    _Bench_set("generated", &b);
+  }
+  return 0;
+}
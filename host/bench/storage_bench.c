@@ -0,0 +1,39 @@
+#include "App.h"
+#include "littlefs_adapter.h"
+#include "littlefs_bench.h"
+#include "storage_bench.h"
+
+// LittleFS against FileX over LevelX NOR on the host: Storage_bench_run of storage_bench.c for every stack
+// with the seed of LittleFS monitor key '7', printed as the same CSV. The firmware file is built with
+// STORAGE_BENCH_ENABLE, FileX, LevelX and the FSP FileX LevelX NOR driver are the sources of the target.
+// CPU time is host time, flash time is the modeled MX25UM25645G time and does not depend on the host.
+//
+// Usage: storage_bench [seed]
+
+#define BENCH_SEED_DEF 12345u
+
+int main(int argc, char **argv)
+{
+  uint32_t     seed   = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_SEED_DEF;
+  int          failed = 0;
+  T_stb_report rep;
+  char         line[160];
+
+  fx_system_initialize();
+  printf("LittleFS vs LevelX+FileX (RAM flash model, %u blocks), seed %u\n", STB_BLOCK_COUNT, (unsigned)seed);
+  Storage_bench_csv_header(line, sizeof(line));
+  printf("%s\n", line);
+  for (uint32_t n = 0; n < STB_STACK_COUNT; n++)
+  {
+    int result = Storage_bench_run((T_stb_stack)n, seed, &rep);
+
+    for (uint32_t w = 0; w < STB_WORKLOAD_COUNT; w++)
+    {
+      Storage_bench_csv_row(&rep, (T_stb_workload)w, line, sizeof(line));
+      printf("%s\n", line);
+      failed |= (rep.res[w].failures != 0);
+    }
+    failed |= (result != 0);
+  }
+  return failed;
+}
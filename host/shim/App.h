@@ -0,0 +1,57 @@
+#ifndef APP_H_
+#define APP_H_
+
+// Host build replacement of src/App.h. It is included before every translation unit with -include and
+// has the include guard of src/App.h, so the modules keep their #include "App.h" unchanged.
+// The FSP, ThreadX and the core peripherals come from the shims of this directory.
+
+#include <ctype.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+
+// IAR language extensions and intrinsics used by the modules
+#define __packed                 // Headers with packed structures are included under #pragma pack(1) in Host_app.h
+#define __no_init
+static inline void __disable_interrupt(void) {}
+static inline void __enable_interrupt(void) {}
+
+// FSP BSP macros
+#define BSP_PLACE_IN_SECTION(x)
+#define BSP_ALIGN_VARIABLE(x)    __attribute__((aligned(x)))
+#define BSP_STACK_ALIGNMENT      8
+
+#include "host_regs.h"
+#include "bsp_feature.h"
+#include "vector_data.h"
+#include "tx_api.h"
+#include "fx_api.h"
+#include "bsp_api.h"
+
+// FSP and GUIX types of the drivers the host build does not include
+typedef int       flash_id_code_mode_t;
+typedef int       flash_result_t;
+typedef struct tm rtc_time_t;
+typedef struct
+{
+  uint32_t event;
+} rtc_callback_args_t;
+typedef char      GX_CHAR;
+typedef struct UX_SLAVE_CLASS_CDC_ACM_STRUCT UX_SLAVE_CLASS_CDC_ACM;  // Only pointers to it are used
+
+#define APP_PRINT(fn_, ...)      (printf((fn_), ##__VA_ARGS__))
+
+// Cycle profiles of the firmware count host time
+#define CYCLE_PROFILER_NOW()     Host_cycles_now()
+
+#define MC80_HOST_BUILD
+#include "MC80.h"
+#include "host_support.h"
+
+#endif  // APP_H
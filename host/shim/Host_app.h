@@ -0,0 +1,66 @@
+#ifndef HOST_APP_H
+#define HOST_APP_H
+
+// Module headers of the host build, included by MC80.h in place of its own list when MC80_HOST_BUILD is
+// defined. Headers that declare packed structures are included under #pragma pack(1), see App.h.
+
+#include "r_canfd.h"
+#include "r_dmac.h"
+#include "rm_block_media_api.h"
+#include "jansson.h"
+#include "Params_Types.h"
+#include "Parameters_manager.h"
+#include "Parameters_JSON_stream.h"
+#include "Parameters_serializer.h"
+#include "Parameters_deserializer.h"
+#include "Monitor_params_editor.h"
+#include "MC80_Params.h"
+#include "App_utils.h"
+#include "FS_utils.h"
+#include "CRC_utils.h"
+#include "String_utils.h"
+#include "DSP_Filters.h"
+#include "Time_utils.h"
+#include "Cycle_profiler.h"
+#include "NV_store.h"
+#include "NV_journal.h"
+#include "MC80V1_pins.h"
+#include "ADC_driver.h"
+#include "RTC_driver.h"
+#include "Flash_driver.h"
+#include "PWM_timer_driver.h"
+#include "r_spi_flash_api.h"
+#include "rm_levelx_nor_spi.h"
+#include "lx_api.h"
+#include "rm_filex_levelx_nor.h"
+#include "LevelX_config.h"
+#include "Memory_manager.h"
+#include "Logger.h"
+#include "Motion_recorder.h"
+#include "MotDrv_TMC6200.h"
+#pragma pack(push, 1)
+#include "Motor_Driver_task.h"
+#pragma pack(pop)
+#include "TMC6200_Monitoring_task.h"
+#include "Led_blink.h"
+#include "mx25um25645g.h"
+#include "RA8M1_OSPI.h"
+#include "MC80_OSPI_drv.h"
+#include "MC80_OSPI_config.h"
+#include "freemaster.h"
+#include "FreeMaster_recorder.h"
+#include "FreeMaster_USB_drv.h"
+#pragma pack(push, 1)
+#include "CAN_protocol.h"
+#pragma pack(pop)
+#include "System_error_flags.h"
+#include "IO_extender.h"
+#include "IDLE_task.h"
+#include "CAN_task.h"
+#include "CAN_message_handler.h"
+#include "CAN_parameter_exchange.h"
+#include "CAN_afl.h"
+#include "Motor_Ramp.h"
+#include "Motor_Soft_Start.h"
+
+#endif
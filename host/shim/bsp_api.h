@@ -0,0 +1,25 @@
+#ifndef BSP_API_H
+#define BSP_API_H
+
+// Host build replacement of the FSP bsp_api.h: the common FSP types and the clock configuration, so the
+// interface headers of the FSP drivers (r_can_api.h, r_canfd.h, r_ospi_b.h, r_dmac.h) compile on the host.
+// The FSP drivers themselves are not compiled, the tests define the driver functions they call.
+
+#include "fsp_common_api.h"
+#include "bsp_clock_cfg.h"
+#include "bsp_clocks.h"
+#include "bsp_elc.h"
+
+// Module stop control has no effect on the host, delays are not waited
+typedef enum
+{
+  BSP_DELAY_UNITS_SECONDS      = 1000000,
+  BSP_DELAY_UNITS_MILLISECONDS = 1000,
+  BSP_DELAY_UNITS_MICROSECONDS = 1
+} bsp_delay_units_t;
+
+#define R_BSP_MODULE_START(ip, channel)
+#define R_BSP_MODULE_STOP(ip, channel)
+static inline void R_BSP_SoftwareDelay(uint32_t delay, bsp_delay_units_t units) { (void)delay; (void)units; }
+
+#endif  // BSP_API_H
@@ -0,0 +1,79 @@
+#ifndef CORE_CM85_H_GENERIC
+#define CORE_CM85_H_GENERIC
+
+// Cortex-M85 core subset for the host build. Replaces the CMSIS header included by the device header,
+// core peripherals are structures in host memory and intrinsics do nothing.
+
+#include <stdint.h>
+
+#define __I    volatile const
+#define __O    volatile
+#define __IO   volatile
+#define __IM   volatile const
+#define __OM   volatile
+#define __IOM  volatile
+
+#define __STATIC_INLINE        static inline
+#define __STATIC_FORCEINLINE   static inline __attribute__((always_inline))
+#define __INLINE               inline
+#define __WEAK                 __attribute__((weak))
+#define __PACKED               __attribute__((packed))
+#define __PACKED_STRUCT        struct __attribute__((packed))
+#define __ALIGNED(x)           __attribute__((aligned(x)))
+#define __ASM                  __asm__
+#define __USED                 __attribute__((used))
+
+typedef int32_t IRQn_Type;
+
+typedef struct
+{
+  __IOM uint32_t CTRL;
+  __IOM uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+  __IOM uint32_t DHCSR;
+  __OM  uint32_t DCRSR;
+  __IOM uint32_t DCRDR;
+  __IOM uint32_t DEMCR;
+} DCB_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk  (1UL)
+#define DCB_DEMCR_TRCENA_Msk    (1UL << 24)
+
+extern DWT_Type g_host_dwt;
+extern DCB_Type g_host_dcb;
+
+#define DWT                     (&g_host_dwt)
+#define DCB                     (&g_host_dcb)
+
+static inline void     __NOP(void) {}
+static inline void     __DSB(void) {}
+static inline void     __DMB(void) {}
+static inline void     __ISB(void) {}
+static inline void     __WFI(void) {}
+static inline void     __disable_irq(void) {}
+static inline void     __enable_irq(void) {}
+static inline uint32_t __get_PRIMASK(void) { return 0; }
+static inline void     __set_PRIMASK(uint32_t primask) { (void)primask; }
+static inline uint32_t __get_IPSR(void) { return 0; }
+static inline uint32_t __CLZ(uint32_t v) { return (v == 0) ? 32u : (uint32_t)__builtin_clz(v); }
+
+static inline uint32_t __RBIT(uint32_t v)
+{
+  uint32_t r = 0;
+
+  for (uint32_t i = 0; i < 32; i++, v >>= 1)
+  {
+    r = (r << 1) | (v & 1u);
+  }
+  return r;
+}
+
+static inline void     NVIC_SetPriority(IRQn_Type irqn, uint32_t priority) { (void)irqn; (void)priority; }
+static inline void     NVIC_ClearPendingIRQ(IRQn_Type irqn) { (void)irqn; }
+static inline void     NVIC_EnableIRQ(IRQn_Type irqn) { (void)irqn; }
+static inline void     NVIC_DisableIRQ(IRQn_Type irqn) { (void)irqn; }
+
+#endif  // CORE_CM85_H_GENERIC
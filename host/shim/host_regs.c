@@ -0,0 +1,10 @@
+#include "App.h"
+
+// Peripheral registers of the host build, see host_regs.h
+
+#define HOST_REG_DEFINE(name, type) T_host_##name g_host_##name;
+HOST_PERIPHERALS(HOST_REG_DEFINE)
+#undef HOST_REG_DEFINE
+
+DWT_Type g_host_dwt;
+DCB_Type g_host_dcb;
@@ -0,0 +1,129 @@
+#ifndef HOST_REGS_H
+#define HOST_REGS_H
+
+// Peripheral registers of the R7FA8M1AH for the host build. The register layout comes from the device
+// header of the FSP, the peripherals used by the host build are moved from their bus addresses to
+// structures in host memory that the tests and the benchmark drive and inspect.
+
+#include "R7FA8M1AH.h"
+
+// Peripheral instance, register type
+#define HOST_PERIPHERALS(X)                \
+  X(R_ADC0,      R_ADC0_Type)              \
+  X(R_ADC1,      R_ADC0_Type)              \
+  X(R_GPT0,      R_GPT0_Type)              \
+  X(R_GPT1,      R_GPT0_Type)              \
+  X(R_GPT2,      R_GPT0_Type)              \
+  X(R_GPT3,      R_GPT0_Type)              \
+  X(R_GPT4,      R_GPT0_Type)              \
+  X(R_GPT5,      R_GPT0_Type)              \
+  X(R_GPT6,      R_GPT0_Type)              \
+  X(R_GPT7,      R_GPT0_Type)              \
+  X(R_GPT8,      R_GPT0_Type)              \
+  X(R_GPT9,      R_GPT0_Type)              \
+  X(R_GPT_POEG0, R_GPT_POEG0_Type)         \
+  X(R_GPT_POEG1, R_GPT_POEG0_Type)         \
+  X(R_ICU,       R_ICU_Type)               \
+  X(R_MSTP,      R_MSTP_Type)              \
+  X(R_ELC,       R_ELC_Type)               \
+  X(R_SYSTEM,    R_SYSTEM_Type)            \
+  X(R_TSN_CAL,   R_TSN_CAL_Type)           \
+  X(R_TSN_CTRL,  R_TSN_CTRL_Type)          \
+  X(R_PORT0,     R_PORT0_Type)             \
+  X(R_PORT1,     R_PORT0_Type)             \
+  X(R_PORT2,     R_PORT0_Type)             \
+  X(R_PORT3,     R_PORT0_Type)             \
+  X(R_PORT4,     R_PORT0_Type)             \
+  X(R_PORT5,     R_PORT0_Type)             \
+  X(R_PORT6,     R_PORT0_Type)             \
+  X(R_PORT7,     R_PORT0_Type)             \
+  X(R_PORT8,     R_PORT0_Type)             \
+  X(R_PORT9,     R_PORT0_Type)             \
+  X(R_PORT10,    R_PORT0_Type)             \
+  X(R_PFS,       R_PFS_Type)               \
+  X(R_XSPI0,     R_XSPI0_Type)             \
+  X(R_DMAC0,     R_DMAC0_Type)
+
+// The modules access some byte registers with word wide bit field structures, every instance is padded
+// to a whole number of words so these accesses stay inside it
+#define HOST_REG_DECLARE(name, type)                   \
+  typedef union                                        \
+  {                                                    \
+    type     regs;                                     \
+    uint32_t words[(sizeof(type) + 3) / 4];            \
+  } T_host_##name;                                     \
+  extern T_host_##name g_host_##name;
+HOST_PERIPHERALS(HOST_REG_DECLARE)
+#undef HOST_REG_DECLARE
+
+#undef R_ADC0
+#undef R_ADC1
+#undef R_GPT0
+#undef R_GPT1
+#undef R_GPT2
+#undef R_GPT3
+#undef R_GPT4
+#undef R_GPT5
+#undef R_GPT6
+#undef R_GPT7
+#undef R_GPT8
+#undef R_GPT9
+#undef R_GPT_POEG0
+#undef R_GPT_POEG1
+#undef R_ICU
+#undef R_MSTP
+#undef R_ELC
+#undef R_SYSTEM
+#undef R_TSN_CAL
+#undef R_TSN_CTRL
+#undef R_PORT0
+#undef R_PORT1
+#undef R_PORT2
+#undef R_PORT3
+#undef R_PORT4
+#undef R_PORT5
+#undef R_PORT6
+#undef R_PORT7
+#undef R_PORT8
+#undef R_PORT9
+#undef R_PORT10
+#undef R_PFS
+#undef R_XSPI0
+#undef R_DMAC0
+
+#define R_ADC0      (&g_host_R_ADC0.regs)
+#define R_ADC1      (&g_host_R_ADC1.regs)
+#define R_GPT0      (&g_host_R_GPT0.regs)
+#define R_GPT1      (&g_host_R_GPT1.regs)
+#define R_GPT2      (&g_host_R_GPT2.regs)
+#define R_GPT3      (&g_host_R_GPT3.regs)
+#define R_GPT4      (&g_host_R_GPT4.regs)
+#define R_GPT5      (&g_host_R_GPT5.regs)
+#define R_GPT6      (&g_host_R_GPT6.regs)
+#define R_GPT7      (&g_host_R_GPT7.regs)
+#define R_GPT8      (&g_host_R_GPT8.regs)
+#define R_GPT9      (&g_host_R_GPT9.regs)
+#define R_GPT_POEG0 (&g_host_R_GPT_POEG0.regs)
+#define R_GPT_POEG1 (&g_host_R_GPT_POEG1.regs)
+#define R_ICU       (&g_host_R_ICU.regs)
+#define R_MSTP      (&g_host_R_MSTP.regs)
+#define R_ELC       (&g_host_R_ELC.regs)
+#define R_SYSTEM    (&g_host_R_SYSTEM.regs)
+#define R_TSN_CAL   (&g_host_R_TSN_CAL.regs)
+#define R_TSN_CTRL  (&g_host_R_TSN_CTRL.regs)
+#define R_PORT0     (&g_host_R_PORT0.regs)
+#define R_PORT1     (&g_host_R_PORT1.regs)
+#define R_PORT2     (&g_host_R_PORT2.regs)
+#define R_PORT3     (&g_host_R_PORT3.regs)
+#define R_PORT4     (&g_host_R_PORT4.regs)
+#define R_PORT5     (&g_host_R_PORT5.regs)
+#define R_PORT6     (&g_host_R_PORT6.regs)
+#define R_PORT7     (&g_host_R_PORT7.regs)
+#define R_PORT8     (&g_host_R_PORT8.regs)
+#define R_PORT9     (&g_host_R_PORT9.regs)
+#define R_PORT10    (&g_host_R_PORT10.regs)
+#define R_PFS       (&g_host_R_PFS.regs)
+#define R_XSPI0     (&g_host_R_XSPI0.regs)
+#define R_DMAC0     (&g_host_R_DMAC0.regs)
+
+#endif  // HOST_REGS_H
@@ -0,0 +1,347 @@
+#include "App.h"
+
+// Functions of the firmware modules that are not compiled by the host build. All stubs are weak,
+// a test or a benchmark that links the real module gets the real function.
+
+#define HOST_WEAK __attribute__((weak))
+
+uint32_t g_host_log_enabled;  // Print application log records to stdout
+
+HOST_WEAK uint8_t                   g_tmc6200_driver1_error_code;
+HOST_WEAK uint8_t                   g_tmc6200_driver2_error_code;
+HOST_WEAK const T_led_blink_pattern LED_PATTERN_ERROR;
+HOST_WEAK const T_led_blink_pattern LED_PATTERN_OFF;
+HOST_WEAK T_log_bin_ring            motor_log_ring;
+HOST_WEAK FX_MEDIA                  fat_fs_media;
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Application log, printed when g_host_log_enabled is set
+
+  Parameters: name      - function name
+              line_num  - line number
+              severity  - severity level
+              fmt_ptr   - printf format
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+HOST_WEAK void LOGs(const char *name, unsigned int line_num, unsigned int severity, const char *fmt_ptr, ...)
+{
+  va_list ap;
+
+  (void)severity;
+  if (g_host_log_enabled == 0)
+  {
+    return;
+  }
+  printf("[%s:%u] ", name, line_num);
+  va_start(ap, fmt_ptr);
+  vprintf(fmt_ptr, ap);
+  va_end(ap);
+  printf("\n");
+}
+
+HOST_WEAK void ELOGs(const char *name, unsigned int line_num, unsigned int severity, const char *fmt_ptr, ...)
+{
+  va_list ap;
+
+  (void)severity;
+  if (g_host_log_enabled == 0)
+  {
+    return;
+  }
+  printf("[%s:%u] ", name, line_num);
+  va_start(ap, fmt_ptr);
+  vprintf(fmt_ptr, ap);
+  va_end(ap);
+  printf("\n");
+}
+
+HOST_WEAK void Log_bin_write(T_log_bin_ring *p_ring, const char *name, unsigned int line_num, unsigned int severity, uint32_t nargs, const char *fmt_ptr, ...)
+{
+  (void)p_ring;
+  (void)name;
+  (void)line_num;
+  (void)severity;
+  (void)nargs;
+  (void)fmt_ptr;
+}
+
+HOST_WEAK uint32_t Wait_ms(uint32_t ms)
+{
+  tx_thread_sleep(MS_TO_TICKS(ms));
+  return 0;
+}
+
+HOST_WEAK uint32_t ms_to_ticks(uint32_t time_ms)
+{
+  return ((time_ms * TX_TIMER_TICKS_PER_SECOND) / 1000U) + 1U;
+}
+
+HOST_WEAK const char *Get_motor_name(uint8_t motor_num)
+{
+  (void)motor_num;
+  return "Motor";
+}
+
+HOST_WEAK uint32_t Motdrv_tmc6200_Initialize(uint8_t driver_num)
+{
+  (void)driver_num;
+  return RES_OK;
+}
+
+HOST_WEAK const char *Motdrv_tmc6200_GetErrorString(uint8_t error_code)
+{
+  (void)error_code;
+  return "";
+}
+
+HOST_WEAK uint32_t Tmc6200_request_fault_reset(uint8_t driver_num)
+{
+  (void)driver_num;
+  return RES_OK;
+}
+
+HOST_WEAK bool Tmc6200_wait_fault_reset_completion(uint32_t timeout_ms)
+{
+  (void)timeout_ms;
+  return true;
+}
+
+HOST_WEAK void Motdrv_tmc6200_InitMonitoring(void) {}
+HOST_WEAK void Motdrv_tmc6200_UpdateInitErrorCodes(void) {}
+HOST_WEAK void Tmc6200_monitoring_thread_create(void) {}
+
+HOST_WEAK void Led_blink_set_patterns_GR(const T_led_blink_pattern *pattern_green, const T_led_blink_pattern *pattern_red)
+{
+  (void)pattern_green;
+  (void)pattern_red;
+}
+
+// File access of the modules that read and write files by name, the host build has no media
+HOST_WEAK UINT _fxe_file_open(FX_MEDIA *media_ptr, FX_FILE *file_ptr, CHAR *file_name, UINT open_type, UINT file_control_block_size)
+{
+  (void)media_ptr;
+  (void)file_ptr;
+  (void)file_name;
+  (void)open_type;
+  (void)file_control_block_size;
+  return FX_MEDIA_NOT_OPEN;
+}
+
+HOST_WEAK UINT _fxe_file_read(FX_FILE *file_ptr, VOID *buffer_ptr, ULONG request_size, ULONG *actual_size)
+{
+  (void)file_ptr;
+  (void)buffer_ptr;
+  (void)request_size;
+  *actual_size = 0;
+  return FX_MEDIA_NOT_OPEN;
+}
+
+HOST_WEAK UINT _fxe_file_seek(FX_FILE *file_ptr, ULONG byte_offset)
+{
+  (void)file_ptr;
+  (void)byte_offset;
+  return FX_MEDIA_NOT_OPEN;
+}
+
+HOST_WEAK uint32_t Recreate_file_for_write(FX_FILE *f, CHAR *filename)
+{
+  (void)f;
+  (void)filename;
+  return RES_ERROR;
+}
+
+HOST_WEAK UINT _fxe_file_write(FX_FILE *file_ptr, VOID *buffer_ptr, ULONG size)
+{
+  (void)file_ptr;
+  (void)buffer_ptr;
+  (void)size;
+  return FX_MEDIA_NOT_OPEN;
+}
+
+HOST_WEAK UINT _fxe_file_close(FX_FILE *file_ptr)
+{
+  (void)file_ptr;
+  return FX_MEDIA_NOT_OPEN;
+}
+
+// Application heap: blocks come from the C library, the byte pool use is counted as ThreadX does it on
+// the target, so the peak heap of a code section can be measured with App_reset_RAM_pool_min_avail
+#define HOST_RAM_POOL_SIZE    (4096u * 1024u)  // Above the pool of the target, the host build only counts the use
+#define HOST_POOL_BLOCK_OVERH 8u                 // Block header of tx_byte_allocate on the 32-bit target
+#define HOST_BLOCK_HDR_WORDS  4u                 // Charge of the block, the rest keeps the 16 byte alignment
+
+static uint32_t g_host_pool_avail     = HOST_RAM_POOL_SIZE;
+static uint32_t g_host_pool_min_avail = HOST_RAM_POOL_SIZE;
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Allocate a zeroed block and charge the pool with its size on the target
+
+  Parameters: size        - block size
+              wait_option - not used
+
+  Return: Pointer to the block or NULL
+-----------------------------------------------------------------------------------------------------*/
+HOST_WEAK void *App_malloc_pending(ULONG size, ULONG wait_option)
+{
+  uint32_t  charge = ((size + 3u) & ~3u) + HOST_POOL_BLOCK_OVERH;
+  uint32_t *blk;
+
+  (void)wait_option;
+  if (charge > g_host_pool_avail)
+  {
+    return NULL;
+  }
+  blk = calloc(1, size + HOST_BLOCK_HDR_WORDS * sizeof(uint32_t));
+  if (blk == NULL)
+  {
+    return NULL;
+  }
+  blk[0]             = charge;
+  g_host_pool_avail -= charge;
+  if (g_host_pool_avail < g_host_pool_min_avail)
+  {
+    g_host_pool_min_avail = g_host_pool_avail;
+  }
+  return &blk[HOST_BLOCK_HDR_WORDS];
+}
+
+HOST_WEAK void *App_malloc(uint32_t size)
+{
+  return App_malloc_pending(size, TX_NO_WAIT);
+}
+
+HOST_WEAK void App_free(void *block_ptr)
+{
+  uint32_t *blk;
+
+  if (block_ptr == NULL)
+  {
+    return;
+  }
+  blk                = (uint32_t *)block_ptr - HOST_BLOCK_HDR_WORDS;
+  g_host_pool_avail += blk[0];
+  free(blk);
+}
+
+HOST_WEAK uint32_t App_get_RAM_pool_min_avail(void)
+{
+  return g_host_pool_min_avail;
+}
+
+HOST_WEAK uint32_t App_reset_RAM_pool_min_avail(void)
+{
+  g_host_pool_min_avail = g_host_pool_avail;
+  return g_host_pool_min_avail;
+}
+
+HOST_WEAK fsp_err_t RTC_set_system_DateTime(rtc_time_t *time)
+{
+  (void)time;
+  return 0;
+}
+
+HOST_WEAK const T_NV_parameters_instance *Get_settings_instance(uint8_t ptype)
+{
+  return (ptype == APPLICATION_PARAMS) ? &wvar_inst : NULL;
+}
+
+HOST_WEAK void Return_def_params(uint8_t ptype)
+{
+  const T_NV_parameters_instance *p_pars = Get_settings_instance(ptype);
+
+  if (p_pars != NULL)
+  {
+    Host_params_load_defaults(p_pars);
+  }
+}
+
+// Settings save requests of the CAN and terminal modules, nothing is saved by the host build
+HOST_WEAK uint32_t Save_settings(uint8_t ptype, uint8_t media_type, char *file_name)
+{
+  (void)ptype;
+  (void)media_type;
+  (void)file_name;
+  return RES_OK;
+}
+
+HOST_WEAK void Request_save_settings(uint8_t ptype, uint8_t media_type, char *file_name)
+{
+  (void)ptype;
+  (void)media_type;
+  (void)file_name;
+}
+
+HOST_WEAK bool Check_save_operation_status(uint32_t *result, uint32_t timeout_ms)
+{
+  (void)timeout_ms;
+  *result = RES_OK;
+  return true;
+}
+
+HOST_WEAK void Reset_system(void) {}
+
+HOST_WEAK const char *Get_settings_save_error_str(uint32_t err_code)
+{
+  (void)err_code;
+  return "";
+}
+
+HOST_WEAK void Motion_recorder_isr(void) {}
+HOST_WEAK void Motion_recorder_trigger(void) {}
+HOST_WEAK void Fmstr_rec_isr(void) {}
+HOST_WEAK void Fmstr_rec_update_timebase(void) {}
+HOST_WEAK void Fmstr_rec_fault_trigger(void) {}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Load default values of the numeric and string parameters of an instance
+
+  Parameters: p_pars - parameters instance
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void Host_params_load_defaults(const T_NV_parameters_instance *p_pars)
+{
+  for (uint32_t i = 0; i < p_pars->items_num; i++)
+  {
+    const T_NV_parameters *pp = &p_pars->items_array[i];
+
+    if (((pp->attr & VAL_NOINIT) != 0) || (pp->val == NULL))
+    {
+      continue;
+    }
+    switch (pp->vartype)
+    {
+      case tint8u:
+        *(uint8_t *)pp->val = (uint8_t)pp->defval;
+        break;
+      case tint16u:
+        *(uint16_t *)pp->val = (uint16_t)pp->defval;
+        break;
+      case tint32u:
+        *(uint32_t *)pp->val = (uint32_t)pp->defval;
+        break;
+      case tint32s:
+        *(int32_t *)pp->val = (int32_t)pp->defval;
+        break;
+      case tfloat:
+        *(float *)pp->val = (float)pp->defval;
+        break;
+      case tstring:
+        if ((pp->pdefval != NULL) && (pp->varlen != 0))
+        {
+          strncpy((char *)pp->val, (const char *)pp->pdefval, pp->varlen - 1);
+          ((uint8_t *)pp->val)[pp->varlen - 1] = 0;
+        }
+        break;
+      case tarrofbyte:
+        if ((pp->pdefval != NULL) && (pp->varlen != 0))
+        {
+          memcpy(pp->val, pp->pdefval, pp->varlen);
+        }
+        break;
+      default:
+        break;
+    }
+  }
+}
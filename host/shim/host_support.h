@@ -0,0 +1,27 @@
+#ifndef HOST_SUPPORT_H
+#define HOST_SUPPORT_H
+
+// Services of the host build used by the tests and the benchmarks
+
+#include <stdint.h>
+
+typedef void (*T_host_tick_hook)(void);
+
+// Monotonic host time in nanoseconds
+uint64_t   Host_time_ns(void);
+
+// Host time in CPU clock cycles of the target (FRQ_CPUCLK_MHZ), wraps like the DWT counter.
+// Used as CYCLE_PROFILER_NOW so the cycle profiles of the firmware report host nanoseconds.
+uint32_t   Host_cycles_now(void);
+
+// Called on every simulated RTOS tick, before the tick counter is advanced. Waits of the ThreadX shim
+// advance time tick by tick, so the hook is where the benchmarks replay interrupts.
+void       Host_tx_set_tick_hook(T_host_tick_hook hook);
+
+// Thread created with tx_thread_create, the caller runs its entry function
+TX_THREAD *Host_tx_find_thread(const char *name);
+
+// Load default values of all parameters of an instance, the same way Return_def_params does on target
+void       Host_params_load_defaults(const T_NV_parameters_instance *p_pars);
+
+#endif  // HOST_SUPPORT_H
@@ -0,0 +1,42 @@
+#include "App.h"
+#include "littlefs_adapter.h"
+
+// LittleFS callbacks of littlefs_adapter.c for the host build. The adapter is not compiled because it
+// drives the OSPI flash, the file systems of the host programs run over the block device layer and the
+// RAM NOR flash model, c->context is T_lfs_bd_cache as on the target.
+
+int _lfs_read(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size)
+{
+  if (Lfs_bd_read((T_lfs_bd_cache *)c->context, (block * c->block_size) + off, buffer, size) != 0)
+  {
+    return LFS_ERR_IO;
+  }
+  return 0;
+}
+
+int _lfs_prog(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+  if (Lfs_bd_prog((T_lfs_bd_cache *)c->context, (block * c->block_size) + off, buffer, size) != 0)
+  {
+    return LFS_ERR_IO;
+  }
+  return 0;
+}
+
+int _lfs_erase(const struct lfs_config *c, lfs_block_t block)
+{
+  if (Lfs_bd_erase((T_lfs_bd_cache *)c->context, block * c->block_size, c->block_size) != 0)
+  {
+    return LFS_ERR_IO;
+  }
+  return 0;
+}
+
+int _lfs_sync(const struct lfs_config *c)
+{
+  if (Lfs_bd_sync((T_lfs_bd_cache *)c->context) != 0)
+  {
+    return LFS_ERR_IO;
+  }
+  return 0;
+}
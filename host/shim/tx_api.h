@@ -0,0 +1,179 @@
+#ifndef TX_API_H
+#define TX_API_H
+
+// ThreadX API subset for the host build. Objects are used from one host thread: queues and event
+// flags keep their state, waits do not block and time advances only through Host_tx_tick.
+
+#include <stdint.h>
+#include <string.h>
+
+#define VOID                  void  // A macro as in tx_port.h, FSP headers test it before their own typedefs
+typedef char          CHAR;
+typedef unsigned char UCHAR;
+typedef int           INT;
+typedef unsigned int  UINT;
+typedef int           LONG;
+typedef unsigned int  ULONG;  // 32 bit as on the target
+typedef unsigned long long ULONG64;
+typedef short         SHORT;
+typedef unsigned short USHORT;
+typedef uintptr_t     ALIGN_TYPE;
+
+#define TX_SUCCESS                0x00
+#define TX_DELETED                0x01
+#define TX_POOL_ERROR             0x02
+#define TX_PTR_ERROR              0x03
+#define TX_WAIT_ERROR             0x04
+#define TX_SIZE_ERROR             0x05
+#define TX_GROUP_ERROR            0x06
+#define TX_NO_EVENTS              0x07
+#define TX_OPTION_ERROR           0x08
+#define TX_QUEUE_ERROR            0x09
+#define TX_QUEUE_EMPTY            0x0A
+#define TX_QUEUE_FULL             0x0B
+#define TX_SEMAPHORE_ERROR        0x0C
+#define TX_NO_INSTANCE            0x0D
+#define TX_THREAD_ERROR           0x0E
+#define TX_PRIORITY_ERROR         0x0F
+#define TX_NO_MEMORY              0x10
+#define TX_DELETE_ERROR           0x11
+#define TX_RESUME_ERROR           0x12
+#define TX_CALLER_ERROR           0x13
+#define TX_SUSPEND_ERROR          0x14
+#define TX_TIMER_ERROR            0x15
+#define TX_TICK_ERROR             0x16
+#define TX_ACTIVATE_ERROR         0x17
+#define TX_THRESH_ERROR           0x18
+#define TX_SUSPEND_LIFTED         0x19
+#define TX_WAIT_ABORTED           0x1A
+#define TX_WAIT_ABORT_ERROR       0x1B
+#define TX_MUTEX_ERROR            0x1C
+#define TX_NOT_AVAILABLE          0x1D
+#define TX_NOT_OWNED              0x1E
+#define TX_INHERIT_ERROR          0x1F
+#define TX_NOT_DONE               0x20
+#define TX_CEILING_EXCEEDED       0x21
+#define TX_INVALID_CEILING        0x22
+#define TX_FEATURE_NOT_ENABLED    0xFF
+
+#define TX_NO_WAIT                ((ULONG)0)
+#define TX_WAIT_FOREVER           ((ULONG)0xFFFFFFFFUL)
+#define TX_AND                    ((UINT)2)
+#define TX_AND_CLEAR              ((UINT)3)
+#define TX_OR                     ((UINT)0)
+#define TX_OR_CLEAR               ((UINT)1)
+#define TX_NO_TIME_SLICE          ((ULONG)0)
+#define TX_AUTO_START             ((UINT)1)
+#define TX_DONT_START             ((UINT)0)
+#define TX_AUTO_ACTIVATE          ((UINT)1)
+#define TX_NO_ACTIVATE            ((UINT)0)
+#define TX_TRUE                   ((UINT)1)
+#define TX_FALSE                  ((UINT)0)
+#define TX_NULL                   ((void *)0)
+#define TX_INHERIT                ((UINT)1)
+#define TX_NO_INHERIT             ((UINT)0)
+
+#ifndef TX_TIMER_TICKS_PER_SECOND
+  #define TX_TIMER_TICKS_PER_SECOND ((ULONG)1000)
+#endif
+
+#define TX_MEMSET(a, b, c)        memset((a), (b), (c))  // As tx_api.h without TX_MISRA_ENABLE
+
+// Interrupt lock, the host has no interrupts
+#define TX_INTERRUPT_SAVE_AREA    unsigned int interrupt_save;
+#define TX_DISABLE                interrupt_save = 0;
+#define TX_RESTORE                (void)interrupt_save;
+
+typedef struct TX_THREAD_STRUCT
+{
+  const CHAR *tx_thread_name;
+  VOID (*tx_thread_entry)(ULONG id);
+  ULONG       tx_thread_entry_parameter;
+  UINT        tx_thread_priority;
+  VOID       *tx_thread_filex_ptr;  // Local path of FileX
+} TX_THREAD;
+
+typedef struct TX_QUEUE_STRUCT
+{
+  const CHAR *tx_queue_name;
+  UINT        tx_queue_message_size;  // Message size in ULONG words
+  ULONG      *tx_queue_start;
+  UINT        tx_queue_capacity;      // Messages
+  UINT        tx_queue_enqueued;
+  UINT        tx_queue_read;          // Index of the oldest message
+} TX_QUEUE;
+
+typedef struct TX_EVENT_FLAGS_GROUP_STRUCT
+{
+  const CHAR *tx_event_flags_group_name;
+  ULONG       tx_event_flags_group_current;
+} TX_EVENT_FLAGS_GROUP;
+
+typedef struct TX_SEMAPHORE_STRUCT
+{
+  const CHAR *tx_semaphore_name;
+  ULONG       tx_semaphore_count;
+} TX_SEMAPHORE;
+
+typedef struct TX_MUTEX_STRUCT
+{
+  const CHAR *tx_mutex_name;
+  UINT        tx_mutex_ownership_count;
+} TX_MUTEX;
+
+typedef struct TX_TIMER_STRUCT
+{
+  const CHAR *tx_timer_name;
+  VOID (*tx_timer_expiration_function)(ULONG id);
+  ULONG       tx_timer_expiration_input;
+  ULONG       tx_timer_reschedule_ticks;
+} TX_TIMER;
+
+typedef struct TX_BYTE_POOL_STRUCT
+{
+  const CHAR *tx_byte_pool_name;
+} TX_BYTE_POOL;
+
+UINT  tx_thread_create(TX_THREAD *thread_ptr, CHAR *name_ptr, VOID (*entry_function)(ULONG id), ULONG entry_input, VOID *stack_start, ULONG stack_size, UINT priority, UINT preempt_threshold, ULONG time_slice, UINT auto_start);
+UINT  tx_thread_sleep(ULONG timer_ticks);
+UINT  tx_thread_relinquish(VOID);
+TX_THREAD *tx_thread_identify(VOID);
+UINT  tx_thread_preemption_change(TX_THREAD *thread_ptr, UINT new_threshold, UINT *old_threshold);
+
+// The host thread is the current thread of every call, the system state is always thread state
+extern TX_THREAD     *_tx_thread_current_ptr;
+extern TX_THREAD      _tx_timer_thread;
+extern volatile ULONG _tx_thread_system_state;
+#define TX_THREAD_GET_SYSTEM_STATE() _tx_thread_system_state
+
+UINT  tx_queue_create(TX_QUEUE *queue_ptr, CHAR *name_ptr, UINT message_size, VOID *queue_start, ULONG queue_size);
+UINT  tx_queue_send(TX_QUEUE *queue_ptr, VOID *source_ptr, ULONG wait_option);
+UINT  tx_queue_front_send(TX_QUEUE *queue_ptr, VOID *source_ptr, ULONG wait_option);
+UINT  tx_queue_receive(TX_QUEUE *queue_ptr, VOID *destination_ptr, ULONG wait_option);
+UINT  tx_queue_flush(TX_QUEUE *queue_ptr);
+UINT  tx_queue_info_get(TX_QUEUE *queue_ptr, CHAR **name, ULONG *enqueued, ULONG *available_storage, TX_THREAD **first_suspended, ULONG *suspended_count, TX_QUEUE **next_queue);
+
+UINT  tx_event_flags_create(TX_EVENT_FLAGS_GROUP *group_ptr, CHAR *name_ptr);
+UINT  tx_event_flags_delete(TX_EVENT_FLAGS_GROUP *group_ptr);
+UINT  tx_event_flags_set(TX_EVENT_FLAGS_GROUP *group_ptr, ULONG flags_to_set, UINT set_option);
+UINT  tx_event_flags_get(TX_EVENT_FLAGS_GROUP *group_ptr, ULONG requested_flags, UINT get_option, ULONG *actual_flags_ptr, ULONG wait_option);
+
+UINT  tx_semaphore_create(TX_SEMAPHORE *semaphore_ptr, CHAR *name_ptr, ULONG initial_count);
+UINT  tx_semaphore_get(TX_SEMAPHORE *semaphore_ptr, ULONG wait_option);
+UINT  tx_semaphore_put(TX_SEMAPHORE *semaphore_ptr);
+
+UINT  tx_mutex_create(TX_MUTEX *mutex_ptr, CHAR *name_ptr, UINT inherit);
+UINT  tx_mutex_get(TX_MUTEX *mutex_ptr, ULONG wait_option);
+UINT  tx_mutex_put(TX_MUTEX *mutex_ptr);
+UINT  tx_mutex_delete(TX_MUTEX *mutex_ptr);
+
+UINT  tx_timer_create(TX_TIMER *timer_ptr, CHAR *name_ptr, VOID (*expiration_function)(ULONG id), ULONG expiration_input, ULONG initial_ticks, ULONG reschedule_ticks, UINT auto_activate);
+
+ULONG tx_time_get(VOID);
+#define _tx_time_get tx_time_get  // Service name called directly by some modules
+VOID  tx_time_set(ULONG new_time);
+
+// Host control of the simulated time
+void  Host_tx_tick(ULONG ticks);
+
+#endif  // TX_API_H
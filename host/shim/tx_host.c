@@ -0,0 +1,409 @@
+#include "App.h"
+
+// ThreadX shim of the host build. There is one host thread: created threads are not started, a wait
+// that can not be satisfied at once advances the simulated time tick by tick until the object is
+// ready or the wait option expires. The tick hook runs on every tick, it stands for the interrupts and
+// the other threads of the target.
+
+#define HOST_TX_THREADS_MAX 16
+
+static ULONG            g_host_tick;
+static T_host_tick_hook g_host_tick_hook;
+static TX_THREAD       *g_host_threads[HOST_TX_THREADS_MAX];
+static uint32_t         g_host_threads_num;
+static TX_THREAD        g_host_main_thread = {.tx_thread_name = "host"};
+
+TX_THREAD     *_tx_thread_current_ptr = &g_host_main_thread;
+TX_THREAD      _tx_timer_thread;
+volatile ULONG _tx_thread_system_state;
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Monotonic host time
+
+  Parameters:
+
+  Return: Time in nanoseconds
+-----------------------------------------------------------------------------------------------------*/
+uint64_t Host_time_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Host time in CPU clock cycles of the target
+
+  Parameters:
+
+  Return: Cycle count, wraps every 2^32 cycles
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Host_cycles_now(void)
+{
+  return (uint32_t)((Host_time_ns() * FRQ_CPUCLK_MHZ) / 1000u);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Set the function called on every simulated tick
+
+  Parameters: hook - function or NULL
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void Host_tx_set_tick_hook(T_host_tick_hook hook)
+{
+  g_host_tick_hook = hook;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Advance the simulated time
+
+  Parameters: ticks - number of ticks
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void Host_tx_tick(ULONG ticks)
+{
+  while (ticks-- > 0)
+  {
+    if (g_host_tick_hook != NULL)
+    {
+      g_host_tick_hook();
+    }
+    g_host_tick++;
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Advance the time by one tick of a wait
+
+  Parameters: p_wait - remaining wait option, decremented unless it is TX_WAIT_FOREVER
+
+  Return: 1 if the wait may continue, 0 if it has expired
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Host_wait_tick(ULONG *p_wait)
+{
+  if (*p_wait == TX_NO_WAIT)
+  {
+    return 0;
+  }
+  if (*p_wait != TX_WAIT_FOREVER)
+  {
+    (*p_wait)--;
+  }
+  Host_tx_tick(1);
+  return 1;
+}
+
+ULONG tx_time_get(VOID)
+{
+  return g_host_tick;
+}
+
+VOID tx_time_set(ULONG new_time)
+{
+  g_host_tick = new_time;
+}
+
+UINT tx_thread_create(TX_THREAD *thread_ptr, CHAR *name_ptr, VOID (*entry_function)(ULONG id), ULONG entry_input, VOID *stack_start, ULONG stack_size, UINT priority, UINT preempt_threshold, ULONG time_slice, UINT auto_start)
+{
+  (void)stack_start;
+  (void)stack_size;
+  (void)preempt_threshold;
+  (void)time_slice;
+  (void)auto_start;
+  if ((thread_ptr == NULL) || (entry_function == NULL))
+  {
+    return TX_PTR_ERROR;
+  }
+  thread_ptr->tx_thread_name            = name_ptr;
+  thread_ptr->tx_thread_entry           = entry_function;
+  thread_ptr->tx_thread_entry_parameter = entry_input;
+  thread_ptr->tx_thread_priority        = priority;
+  if (g_host_threads_num < HOST_TX_THREADS_MAX)
+  {
+    g_host_threads[g_host_threads_num++] = thread_ptr;
+  }
+  return TX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Find a thread created with tx_thread_create
+
+  Parameters: name - thread name
+
+  Return: Thread or NULL
+-----------------------------------------------------------------------------------------------------*/
+TX_THREAD *Host_tx_find_thread(const char *name)
+{
+  for (uint32_t i = 0; i < g_host_threads_num; i++)
+  {
+    if (strcmp(g_host_threads[i]->tx_thread_name, name) == 0)
+    {
+      return g_host_threads[i];
+    }
+  }
+  return NULL;
+}
+
+UINT tx_thread_sleep(ULONG timer_ticks)
+{
+  Host_tx_tick(timer_ticks);
+  return TX_SUCCESS;
+}
+
+UINT tx_thread_relinquish(VOID)
+{
+  return TX_SUCCESS;
+}
+
+TX_THREAD *tx_thread_identify(VOID)
+{
+  return _tx_thread_current_ptr;
+}
+
+UINT tx_thread_preemption_change(TX_THREAD *thread_ptr, UINT new_threshold, UINT *old_threshold)
+{
+  (void)thread_ptr;
+  *old_threshold = new_threshold;  // No other thread can preempt the host thread
+  return TX_SUCCESS;
+}
+
+UINT tx_queue_create(TX_QUEUE *queue_ptr, CHAR *name_ptr, UINT message_size, VOID *queue_start, ULONG queue_size)
+{
+  if ((queue_ptr == NULL) || (queue_start == NULL) || (message_size == 0))
+  {
+    return TX_PTR_ERROR;
+  }
+  memset(queue_ptr, 0, sizeof(*queue_ptr));
+  queue_ptr->tx_queue_name         = name_ptr;
+  queue_ptr->tx_queue_message_size = message_size;
+  queue_ptr->tx_queue_start        = (ULONG *)queue_start;
+  queue_ptr->tx_queue_capacity     = queue_size / (message_size * sizeof(ULONG));
+  return TX_SUCCESS;
+}
+
+UINT tx_queue_send(TX_QUEUE *queue_ptr, VOID *source_ptr, ULONG wait_option)
+{
+  UINT idx;
+
+  while (queue_ptr->tx_queue_enqueued == queue_ptr->tx_queue_capacity)
+  {
+    if (_Host_wait_tick(&wait_option) == 0)
+    {
+      return TX_QUEUE_FULL;
+    }
+  }
+  idx = (queue_ptr->tx_queue_read + queue_ptr->tx_queue_enqueued) % queue_ptr->tx_queue_capacity;
+  memcpy(&queue_ptr->tx_queue_start[idx * queue_ptr->tx_queue_message_size], source_ptr, queue_ptr->tx_queue_message_size * sizeof(ULONG));
+  queue_ptr->tx_queue_enqueued++;
+  return TX_SUCCESS;
+}
+
+UINT tx_queue_front_send(TX_QUEUE *queue_ptr, VOID *source_ptr, ULONG wait_option)
+{
+  while (queue_ptr->tx_queue_enqueued == queue_ptr->tx_queue_capacity)
+  {
+    if (_Host_wait_tick(&wait_option) == 0)
+    {
+      return TX_QUEUE_FULL;
+    }
+  }
+  queue_ptr->tx_queue_read = (queue_ptr->tx_queue_read + queue_ptr->tx_queue_capacity - 1) % queue_ptr->tx_queue_capacity;
+  memcpy(&queue_ptr->tx_queue_start[queue_ptr->tx_queue_read * queue_ptr->tx_queue_message_size], source_ptr, queue_ptr->tx_queue_message_size * sizeof(ULONG));
+  queue_ptr->tx_queue_enqueued++;
+  return TX_SUCCESS;
+}
+
+UINT tx_queue_receive(TX_QUEUE *queue_ptr, VOID *destination_ptr, ULONG wait_option)
+{
+  while (queue_ptr->tx_queue_enqueued == 0)
+  {
+    if (_Host_wait_tick(&wait_option) == 0)
+    {
+      return TX_QUEUE_EMPTY;
+    }
+  }
+  memcpy(destination_ptr, &queue_ptr->tx_queue_start[queue_ptr->tx_queue_read * queue_ptr->tx_queue_message_size], queue_ptr->tx_queue_message_size * sizeof(ULONG));
+  queue_ptr->tx_queue_read = (queue_ptr->tx_queue_read + 1) % queue_ptr->tx_queue_capacity;
+  queue_ptr->tx_queue_enqueued--;
+  return TX_SUCCESS;
+}
+
+UINT tx_queue_flush(TX_QUEUE *queue_ptr)
+{
+  queue_ptr->tx_queue_enqueued = 0;
+  queue_ptr->tx_queue_read     = 0;
+  return TX_SUCCESS;
+}
+
+UINT tx_queue_info_get(TX_QUEUE *queue_ptr, CHAR **name, ULONG *enqueued, ULONG *available_storage, TX_THREAD **first_suspended, ULONG *suspended_count, TX_QUEUE **next_queue)
+{
+  if (name != NULL)
+  {
+    *name = (CHAR *)queue_ptr->tx_queue_name;
+  }
+  if (enqueued != NULL)
+  {
+    *enqueued = queue_ptr->tx_queue_enqueued;
+  }
+  if (available_storage != NULL)
+  {
+    *available_storage = queue_ptr->tx_queue_capacity - queue_ptr->tx_queue_enqueued;
+  }
+  if (first_suspended != NULL)
+  {
+    *first_suspended = NULL;
+  }
+  if (suspended_count != NULL)
+  {
+    *suspended_count = 0;
+  }
+  if (next_queue != NULL)
+  {
+    *next_queue = NULL;
+  }
+  return TX_SUCCESS;
+}
+
+UINT tx_event_flags_create(TX_EVENT_FLAGS_GROUP *group_ptr, CHAR *name_ptr)
+{
+  if (group_ptr == NULL)
+  {
+    return TX_GROUP_ERROR;
+  }
+  group_ptr->tx_event_flags_group_name    = name_ptr;
+  group_ptr->tx_event_flags_group_current = 0;
+  return TX_SUCCESS;
+}
+
+UINT tx_event_flags_delete(TX_EVENT_FLAGS_GROUP *group_ptr)
+{
+  if (group_ptr == NULL)
+  {
+    return TX_GROUP_ERROR;
+  }
+  group_ptr->tx_event_flags_group_current = 0;
+  return TX_SUCCESS;
+}
+
+UINT tx_event_flags_set(TX_EVENT_FLAGS_GROUP *group_ptr, ULONG flags_to_set, UINT set_option)
+{
+  if (set_option == TX_AND)
+  {
+    group_ptr->tx_event_flags_group_current &= flags_to_set;
+  }
+  else
+  {
+    group_ptr->tx_event_flags_group_current |= flags_to_set;
+  }
+  return TX_SUCCESS;
+}
+
+UINT tx_event_flags_get(TX_EVENT_FLAGS_GROUP *group_ptr, ULONG requested_flags, UINT get_option, ULONG *actual_flags_ptr, ULONG wait_option)
+{
+  for (;;)
+  {
+    ULONG current = group_ptr->tx_event_flags_group_current;
+    bool  ready;
+
+    if ((get_option == TX_AND) || (get_option == TX_AND_CLEAR))
+    {
+      ready = ((current & requested_flags) == requested_flags);
+    }
+    else
+    {
+      ready = ((current & requested_flags) != 0);
+    }
+    if (ready)
+    {
+      *actual_flags_ptr = current;
+      if ((get_option == TX_AND_CLEAR) || (get_option == TX_OR_CLEAR))
+      {
+        group_ptr->tx_event_flags_group_current &= ~requested_flags;
+      }
+      return TX_SUCCESS;
+    }
+    if (_Host_wait_tick(&wait_option) == 0)
+    {
+      return TX_NO_EVENTS;
+    }
+  }
+}
+
+UINT tx_semaphore_create(TX_SEMAPHORE *semaphore_ptr, CHAR *name_ptr, ULONG initial_count)
+{
+  semaphore_ptr->tx_semaphore_name  = name_ptr;
+  semaphore_ptr->tx_semaphore_count = initial_count;
+  return TX_SUCCESS;
+}
+
+UINT tx_semaphore_get(TX_SEMAPHORE *semaphore_ptr, ULONG wait_option)
+{
+  while (semaphore_ptr->tx_semaphore_count == 0)
+  {
+    if (_Host_wait_tick(&wait_option) == 0)
+    {
+      return TX_NO_INSTANCE;
+    }
+  }
+  semaphore_ptr->tx_semaphore_count--;
+  return TX_SUCCESS;
+}
+
+UINT tx_semaphore_put(TX_SEMAPHORE *semaphore_ptr)
+{
+  semaphore_ptr->tx_semaphore_count++;
+  return TX_SUCCESS;
+}
+
+UINT tx_mutex_create(TX_MUTEX *mutex_ptr, CHAR *name_ptr, UINT inherit)
+{
+  (void)inherit;
+  mutex_ptr->tx_mutex_name            = name_ptr;
+  mutex_ptr->tx_mutex_ownership_count = 0;
+  return TX_SUCCESS;
+}
+
+UINT tx_mutex_get(TX_MUTEX *mutex_ptr, ULONG wait_option)
+{
+  (void)wait_option;
+  mutex_ptr->tx_mutex_ownership_count++;  // One thread, the mutex is always available
+  return TX_SUCCESS;
+}
+
+UINT tx_mutex_put(TX_MUTEX *mutex_ptr)
+{
+  if (mutex_ptr->tx_mutex_ownership_count == 0)
+  {
+    return TX_NOT_OWNED;
+  }
+  mutex_ptr->tx_mutex_ownership_count--;
+  return TX_SUCCESS;
+}
+
+UINT tx_mutex_delete(TX_MUTEX *mutex_ptr)
+{
+  mutex_ptr->tx_mutex_ownership_count = 0;
+  return TX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Create an application timer. The timer is kept but never expires: the timers of the
+               modules built on the host only keep statistics such as the FileX date and time.
+
+  Parameters: see ThreadX tx_timer_create
+
+  Return: TX_SUCCESS
+-----------------------------------------------------------------------------------------------------*/
+UINT tx_timer_create(TX_TIMER *timer_ptr, CHAR *name_ptr, VOID (*expiration_function)(ULONG id), ULONG expiration_input, ULONG initial_ticks, ULONG reschedule_ticks, UINT auto_activate)
+{
+  (void)initial_ticks;
+  (void)auto_activate;
+  timer_ptr->tx_timer_name                = name_ptr;
+  timer_ptr->tx_timer_expiration_function = expiration_function;
+  timer_ptr->tx_timer_expiration_input    = expiration_input;
+  timer_ptr->tx_timer_reschedule_ticks    = reschedule_ticks;
+  return TX_SUCCESS;
+}
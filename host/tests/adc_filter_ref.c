@@ -0,0 +1,187 @@
+#include "App.h"
+#include "adc_filter_ref.h"
+
+// Code of ADC_driver.c before the filter bank (adc. replaced by p_ref->), see adc_filter_ref.h
+
+/*-----------------------------------------------------------------------------------------------------
+  Collect ADC sampling data from registers, reference implementation
+
+  Parameters: p_ref - reference driver state
+
+  Return: void
+-----------------------------------------------------------------------------------------------------*/
+void Adc_ref_sampling_data_collection(T_adc_ref *p_ref)
+{
+  // Read direct ADC channels (non-multiplexed)
+  p_ref->smpl_v24v_mon      = R_ADC0->ADDR[4];   // AN004 - System +24V input monitoring
+  p_ref->smpl_v5v_mon       = R_ADC1->ADDR[4];   // AN104 - +5V supply monitoring
+  p_ref->smpl_v3v3_mon      = R_ADC1->ADDR[5];   // AN105 - +3.3V reference/supply monitoring
+  p_ref->smpl_thermistor_m1 = R_ADC0->ADDR[16];  // AN016 - Motor 1 thermistor
+  p_ref->smpl_thermistor_m2 = R_ADC1->ADDR[17];  // AN117 - Motor 2 thermistor
+  // Read multiplexed channels - assign directly to motor-specific variables
+  if (p_ref->active_motor == ADC_MOTOR_1)
+  {
+    p_ref->smpl_i_u_motor1   = R_ADC0->ADDR[0];  // AN000 - Current motor 1 U phase
+    p_ref->smpl_i_v_motor1   = R_ADC0->ADDR[1];  // AN001 - Current motor 1 V phase
+    p_ref->smpl_i_w_motor1   = R_ADC0->ADDR[2];  // AN002 - Current motor 1 W phase
+    p_ref->smpl_ipwr_motor1  = R_ADC1->ADDR[0];  // AN100 - Current motor 1 power
+    p_ref->smpl_speed_motor1 = R_ADC1->ADDR[1];  // AN101 - Current motor 1 speed
+    p_ref->smpl_pos_motor1   = R_ADC1->ADDR[2];  // AN102 - Current motor 1 position
+  }
+  else                                        // ADC_MOTOR_2
+  {
+    p_ref->smpl_i_u_motor2   = R_ADC0->ADDR[0];  // AN000 - Current motor 2 U phase
+    p_ref->smpl_i_v_motor2   = R_ADC0->ADDR[1];  // AN001 - Current motor 2 V phase
+    p_ref->smpl_i_w_motor2   = R_ADC0->ADDR[2];  // AN002 - Current motor 2 W phase
+    p_ref->smpl_ipwr_motor2  = R_ADC1->ADDR[0];  // AN100 - Current motor 2 power
+    p_ref->smpl_speed_motor2 = R_ADC1->ADDR[1];  // AN101 - Current motor 2 speed
+    p_ref->smpl_pos_motor2   = R_ADC1->ADDR[2];  // AN102 - Current motor 2 position
+  }
+
+  // Read CPU internal sensors
+  p_ref->smpl_cpu_temp  = R_ADC0->ADTSDR;  // CPU temperature
+  p_ref->smpl_int_ref_v = R_ADC0->ADOCDR;  // Internal reference
+
+  // Read phase voltages and assign directly to motor-specific variables based on active phase
+  // AN005 and AN006 are always sampled and contain current phase data for both motors
+  switch (p_ref->active_phase)
+  {
+    case ADC_PHASE_U:
+      p_ref->smpl_v_u_motor1 = R_ADC0->ADDR[5];  // AN005 contains U phase voltage for Motor 1
+      p_ref->smpl_v_u_motor2 = R_ADC0->ADDR[6];  // AN006 contains U phase voltage for Motor 2
+      break;
+    case ADC_PHASE_V:
+      p_ref->smpl_v_v_motor1 = R_ADC0->ADDR[5];  // AN005 contains V phase voltage for Motor 1
+      p_ref->smpl_v_v_motor2 = R_ADC0->ADDR[6];  // AN006 contains V phase voltage for Motor 2
+      break;
+    case ADC_PHASE_W:
+      p_ref->smpl_v_w_motor1 = R_ADC0->ADDR[5];  // AN005 contains W phase voltage for Motor 1
+      p_ref->smpl_v_w_motor2 = R_ADC0->ADDR[6];  // AN006 contains W phase voltage for Motor 2
+      break;
+  }
+
+  // Apply EMA filtering to relevant channels
+  Adc_ref_apply_ema_filtering(p_ref);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Apply EMA filtering to relevant ADC channels, reference implementation
+
+  Parameters: p_ref - reference driver state
+
+  Return: void
+-----------------------------------------------------------------------------------------------------*/
+void Adc_ref_apply_ema_filtering(T_adc_ref *p_ref)
+{
+  if (!p_ref->filters_initialized)
+  {
+    // Initialize filtered values with current samples shifted to Q16 format
+    // Note: Optimized EMA formula still uses Q16 format for data storage
+    p_ref->filt_v_u_motor1      = (uint32_t)p_ref->smpl_v_u_motor1 << EMA_FILTER_SHIFT;
+    p_ref->filt_v_v_motor1      = (uint32_t)p_ref->smpl_v_v_motor1 << EMA_FILTER_SHIFT;
+    p_ref->filt_v_w_motor1      = (uint32_t)p_ref->smpl_v_w_motor1 << EMA_FILTER_SHIFT;
+    p_ref->filt_v_u_motor2      = (uint32_t)p_ref->smpl_v_u_motor2 << EMA_FILTER_SHIFT;
+    p_ref->filt_v_v_motor2      = (uint32_t)p_ref->smpl_v_v_motor2 << EMA_FILTER_SHIFT;
+    p_ref->filt_v_w_motor2      = (uint32_t)p_ref->smpl_v_w_motor2 << EMA_FILTER_SHIFT;
+    p_ref->filt_speed_motor1    = (uint32_t)p_ref->smpl_speed_motor1 << EMA_FILTER_SHIFT;
+    p_ref->filt_speed_motor2    = (uint32_t)p_ref->smpl_speed_motor2 << EMA_FILTER_SHIFT;
+    p_ref->filt_pos_motor1      = (uint32_t)p_ref->smpl_pos_motor1 << EMA_FILTER_SHIFT;
+    p_ref->filt_pos_motor2      = (uint32_t)p_ref->smpl_pos_motor2 << EMA_FILTER_SHIFT;
+    p_ref->filt_v24v_mon        = (uint32_t)p_ref->smpl_v24v_mon << EMA_FILTER_SHIFT;
+    p_ref->filt_v5v_mon         = (uint32_t)p_ref->smpl_v5v_mon << EMA_FILTER_SHIFT;
+    p_ref->filt_v3v3_mon        = (uint32_t)p_ref->smpl_v3v3_mon << EMA_FILTER_SHIFT;
+    p_ref->filt_thermistor_m1   = (uint32_t)p_ref->smpl_thermistor_m1 << EMA_FILTER_SHIFT;
+    p_ref->filt_thermistor_m2   = (uint32_t)p_ref->smpl_thermistor_m2 << EMA_FILTER_SHIFT;
+    p_ref->filt_ipwr_motor1     = (uint32_t)p_ref->smpl_ipwr_motor1 << EMA_FILTER_SHIFT;
+    p_ref->filt_ipwr_motor2     = (uint32_t)p_ref->smpl_ipwr_motor2 << EMA_FILTER_SHIFT;
+    p_ref->filt_cpu_temp        = (uint32_t)p_ref->smpl_cpu_temp << EMA_FILTER_SHIFT;
+
+    // Initialize dual-EMA filtered current values (fast and slow)
+    p_ref->filt_i_u_motor1_fast = (uint32_t)p_ref->smpl_i_u_motor1 << EMA_FILTER_SHIFT;
+    p_ref->filt_i_v_motor1_fast = (uint32_t)p_ref->smpl_i_v_motor1 << EMA_FILTER_SHIFT;
+    p_ref->filt_i_w_motor1_fast = (uint32_t)p_ref->smpl_i_w_motor1 << EMA_FILTER_SHIFT;
+    p_ref->filt_i_u_motor2_fast = (uint32_t)p_ref->smpl_i_u_motor2 << EMA_FILTER_SHIFT;
+    p_ref->filt_i_v_motor2_fast = (uint32_t)p_ref->smpl_i_v_motor2 << EMA_FILTER_SHIFT;
+    p_ref->filt_i_w_motor2_fast = (uint32_t)p_ref->smpl_i_w_motor2 << EMA_FILTER_SHIFT;
+
+    p_ref->filt_i_u_motor1_slow = (uint32_t)p_ref->smpl_i_u_motor1 << EMA_FILTER_SHIFT;
+    p_ref->filt_i_v_motor1_slow = (uint32_t)p_ref->smpl_i_v_motor1 << EMA_FILTER_SHIFT;
+    p_ref->filt_i_w_motor1_slow = (uint32_t)p_ref->smpl_i_w_motor1 << EMA_FILTER_SHIFT;
+    p_ref->filt_i_u_motor2_slow = (uint32_t)p_ref->smpl_i_u_motor2 << EMA_FILTER_SHIFT;
+    p_ref->filt_i_v_motor2_slow = (uint32_t)p_ref->smpl_i_v_motor2 << EMA_FILTER_SHIFT;
+    p_ref->filt_i_w_motor2_slow = (uint32_t)p_ref->smpl_i_w_motor2 << EMA_FILTER_SHIFT;
+
+    p_ref->filters_initialized  = true;
+  }
+  else
+  {  // Apply 1 Hz EMA filter to direct channels (sampled every interrupt at PWM frequency)
+    // Using optimized formula to avoid 64-bit arithmetic operations
+    p_ref->filt_v24v_mon      = EMA_FILTER_UPDATE(p_ref->filt_v24v_mon, p_ref->smpl_v24v_mon, g_ema_alpha_1hz_direct);
+    p_ref->filt_v5v_mon       = EMA_FILTER_UPDATE(p_ref->filt_v5v_mon, p_ref->smpl_v5v_mon, g_ema_alpha_1hz_direct);
+    p_ref->filt_v3v3_mon      = EMA_FILTER_UPDATE(p_ref->filt_v3v3_mon, p_ref->smpl_v3v3_mon, g_ema_alpha_1hz_direct);
+    p_ref->filt_thermistor_m1 = EMA_FILTER_UPDATE(p_ref->filt_thermistor_m1, p_ref->smpl_thermistor_m1, g_ema_alpha_1hz_direct);
+    p_ref->filt_thermistor_m2 = EMA_FILTER_UPDATE(p_ref->filt_thermistor_m2, p_ref->smpl_thermistor_m2, g_ema_alpha_1hz_direct);
+    p_ref->filt_cpu_temp      = EMA_FILTER_UPDATE(p_ref->filt_cpu_temp, p_ref->smpl_cpu_temp, g_ema_alpha_1hz_direct);
+
+    // Apply filtering to multiplexed channels only when they are active and updated
+    // Phase voltage filtering: only filter the currently sampled phase for both motors
+    if (p_ref->active_phase == ADC_PHASE_U)
+    {  // Filter U phase voltage for both motors (PWM_freq/3 effective sampling rate)
+      // Using optimized formula to avoid 64-bit arithmetic operations
+      p_ref->filt_v_u_motor1 = EMA_FILTER_UPDATE(p_ref->filt_v_u_motor1, p_ref->smpl_v_u_motor1, g_ema_alpha_10hz_3ch);
+      p_ref->filt_v_u_motor2 = EMA_FILTER_UPDATE(p_ref->filt_v_u_motor2, p_ref->smpl_v_u_motor2, g_ema_alpha_10hz_3ch);
+    }
+    else if (p_ref->active_phase == ADC_PHASE_V)
+    {  // Filter V phase voltage for both motors (PWM_freq/3 effective sampling rate)
+      // Using optimized formula to avoid 64-bit arithmetic operations
+      p_ref->filt_v_v_motor1 = EMA_FILTER_UPDATE(p_ref->filt_v_v_motor1, p_ref->smpl_v_v_motor1, g_ema_alpha_10hz_3ch);
+      p_ref->filt_v_v_motor2 = EMA_FILTER_UPDATE(p_ref->filt_v_v_motor2, p_ref->smpl_v_v_motor2, g_ema_alpha_10hz_3ch);
+    }
+    else if (p_ref->active_phase == ADC_PHASE_W)
+    {  // Filter W phase voltage for both motors (PWM_freq/3 effective sampling rate)
+      // Using optimized formula to avoid 64-bit arithmetic operations
+      p_ref->filt_v_w_motor1 = EMA_FILTER_UPDATE(p_ref->filt_v_w_motor1, p_ref->smpl_v_w_motor1, g_ema_alpha_10hz_3ch);
+      p_ref->filt_v_w_motor2 = EMA_FILTER_UPDATE(p_ref->filt_v_w_motor2, p_ref->smpl_v_w_motor2, g_ema_alpha_10hz_3ch);
+    }
+    // Phase voltage filtering complete: all three phases (U, V, W) processed
+
+    // Motor sensor filtering: only filter sensors for the currently active motor
+    if (p_ref->active_motor == ADC_MOTOR_1)
+    {  // Filter Motor 1 sensors (PWM_freq/2 effective sampling rate)
+      // Using optimized formula to avoid 64-bit arithmetic operations
+      p_ref->filt_speed_motor1    = EMA_FILTER_UPDATE(p_ref->filt_speed_motor1, p_ref->smpl_speed_motor1, g_ema_alpha_10hz_2ch);
+      p_ref->filt_pos_motor1      = EMA_FILTER_UPDATE(p_ref->filt_pos_motor1, p_ref->smpl_pos_motor1, g_ema_alpha_10hz_2ch);
+      p_ref->filt_ipwr_motor1     = EMA_FILTER_UPDATE(p_ref->filt_ipwr_motor1, p_ref->smpl_ipwr_motor1, g_ema_alpha_1hz_2ch);
+
+      // Apply dual-EMA filtering to Motor 1 phase currents (PWM_freq/2 effective sampling rate)
+      // Fast filter for control (~1.5kHz cutoff)
+      p_ref->filt_i_u_motor1_fast = EMA_FILTER_UPDATE(p_ref->filt_i_u_motor1_fast, p_ref->smpl_i_u_motor1, g_ema_alpha_current_fast_2ch);
+      p_ref->filt_i_v_motor1_fast = EMA_FILTER_UPDATE(p_ref->filt_i_v_motor1_fast, p_ref->smpl_i_v_motor1, g_ema_alpha_current_fast_2ch);
+      p_ref->filt_i_w_motor1_fast = EMA_FILTER_UPDATE(p_ref->filt_i_w_motor1_fast, p_ref->smpl_i_w_motor1, g_ema_alpha_current_fast_2ch);
+
+      // Slow filter for monitoring/protection (~300Hz cutoff)
+      p_ref->filt_i_u_motor1_slow = EMA_FILTER_UPDATE(p_ref->filt_i_u_motor1_slow, p_ref->smpl_i_u_motor1, g_ema_alpha_current_slow_2ch);
+      p_ref->filt_i_v_motor1_slow = EMA_FILTER_UPDATE(p_ref->filt_i_v_motor1_slow, p_ref->smpl_i_v_motor1, g_ema_alpha_current_slow_2ch);
+      p_ref->filt_i_w_motor1_slow = EMA_FILTER_UPDATE(p_ref->filt_i_w_motor1_slow, p_ref->smpl_i_w_motor1, g_ema_alpha_current_slow_2ch);
+    }
+    else  // ADC_MOTOR_2
+    {
+      // Filter Motor 2 sensors (PWM_freq/2 effective sampling rate)
+      // Using optimized formula to avoid 64-bit arithmetic operations
+      p_ref->filt_speed_motor2    = EMA_FILTER_UPDATE(p_ref->filt_speed_motor2, p_ref->smpl_speed_motor2, g_ema_alpha_10hz_2ch);
+      p_ref->filt_pos_motor2      = EMA_FILTER_UPDATE(p_ref->filt_pos_motor2, p_ref->smpl_pos_motor2, g_ema_alpha_10hz_2ch);
+      p_ref->filt_ipwr_motor2     = EMA_FILTER_UPDATE(p_ref->filt_ipwr_motor2, p_ref->smpl_ipwr_motor2, g_ema_alpha_1hz_2ch);
+
+      // Apply dual-EMA filtering to Motor 2 phase currents (PWM_freq/2 effective sampling rate)
+      // Fast filter for control (~1.5kHz cutoff)
+      p_ref->filt_i_u_motor2_fast = EMA_FILTER_UPDATE(p_ref->filt_i_u_motor2_fast, p_ref->smpl_i_u_motor2, g_ema_alpha_current_fast_2ch);
+      p_ref->filt_i_v_motor2_fast = EMA_FILTER_UPDATE(p_ref->filt_i_v_motor2_fast, p_ref->smpl_i_v_motor2, g_ema_alpha_current_fast_2ch);
+      p_ref->filt_i_w_motor2_fast = EMA_FILTER_UPDATE(p_ref->filt_i_w_motor2_fast, p_ref->smpl_i_w_motor2, g_ema_alpha_current_fast_2ch);
+
+      // Slow filter for monitoring/protection (~300Hz cutoff)
+      p_ref->filt_i_u_motor2_slow = EMA_FILTER_UPDATE(p_ref->filt_i_u_motor2_slow, p_ref->smpl_i_u_motor2, g_ema_alpha_current_slow_2ch);
+      p_ref->filt_i_v_motor2_slow = EMA_FILTER_UPDATE(p_ref->filt_i_v_motor2_slow, p_ref->smpl_i_v_motor2, g_ema_alpha_current_slow_2ch);
+      p_ref->filt_i_w_motor2_slow = EMA_FILTER_UPDATE(p_ref->filt_i_w_motor2_slow, p_ref->smpl_i_w_motor2, g_ema_alpha_current_slow_2ch);
+    }
+  }
+}
@@ -0,0 +1,73 @@
+#ifndef ADC_FILTER_REF_H
+#define ADC_FILTER_REF_H
+
+// Sample collection and EMA filtering of the ADC driver as they were before the filter bank: one named
+// sample and filter state per channel, unrolled updates. Reference for the bit-exact test and the
+// benchmark of the filter bank.
+
+typedef struct
+{
+  uint16_t smpl_i_u_motor1;       // Motor 1 U phase current
+  uint16_t smpl_i_v_motor1;       // Motor 1 V phase current
+  uint16_t smpl_i_w_motor1;       // Motor 1 W phase current
+  uint16_t smpl_i_u_motor2;       // Motor 2 U phase current
+  uint16_t smpl_i_v_motor2;       // Motor 2 V phase current
+  uint16_t smpl_i_w_motor2;       // Motor 2 W phase current
+  uint16_t smpl_v_u_motor1;       // Motor 1 U phase voltage
+  uint16_t smpl_v_v_motor1;       // Motor 1 V phase voltage
+  uint16_t smpl_v_w_motor1;       // Motor 1 W phase voltage
+  uint16_t smpl_v_u_motor2;       // Motor 2 U phase voltage
+  uint16_t smpl_v_v_motor2;       // Motor 2 V phase voltage
+  uint16_t smpl_v_w_motor2;       // Motor 2 W phase voltage
+  uint16_t smpl_ipwr_motor1;      // Motor 1 power supply current
+  uint16_t smpl_ipwr_motor2;      // Motor 2 power supply current
+  uint16_t smpl_speed_motor1;     // Motor 1 speed sensor
+  uint16_t smpl_speed_motor2;     // Motor 2 speed sensor
+  uint16_t smpl_pos_motor1;       // Motor 1 position sensor
+  uint16_t smpl_pos_motor2;       // Motor 2 position sensor
+  uint16_t smpl_v24v_mon;         // AN004 - System +24V input monitoring
+  uint16_t smpl_v5v_mon;          // AN104 - +5V supply monitoring
+  uint16_t smpl_v3v3_mon;         // AN105 - +3.3V reference/supply monitoring
+  uint16_t smpl_thermistor_m1;    // AN016 - Motor 1 power transistors thermistor
+  uint16_t smpl_thermistor_m2;    // AN117 - Motor 2 power transistors thermistor
+  uint32_t filt_v_u_motor1;       // Motor 1 U phase voltage (filtered)
+  uint32_t filt_v_v_motor1;       // Motor 1 V phase voltage (filtered)
+  uint32_t filt_v_w_motor1;       // Motor 1 W phase voltage (filtered)
+  uint32_t filt_v_u_motor2;       // Motor 2 U phase voltage (filtered)
+  uint32_t filt_v_v_motor2;       // Motor 2 V phase voltage (filtered)
+  uint32_t filt_v_w_motor2;       // Motor 2 W phase voltage (filtered)
+  uint32_t filt_speed_motor1;     // Motor 1 speed sensor (filtered)
+  uint32_t filt_speed_motor2;     // Motor 2 speed sensor (filtered)
+  uint32_t filt_pos_motor1;       // Motor 1 position sensor (filtered)
+  uint32_t filt_pos_motor2;       // Motor 2 position sensor (filtered)
+  uint32_t filt_v24v_mon;         // AN004 - System +24V input monitoring (filtered)
+  uint32_t filt_v5v_mon;          // AN104 - +5V supply monitoring (filtered)
+  uint32_t filt_v3v3_mon;         // AN105 - +3.3V reference/supply monitoring (filtered)
+  uint32_t filt_thermistor_m1;    // AN016 - Motor 1 thermistor (filtered)
+  uint32_t filt_thermistor_m2;    // AN117 - Motor 2 thermistor (filtered)
+  uint32_t filt_ipwr_motor1;      // Motor 1 power supply current (filtered)
+  uint32_t filt_ipwr_motor2;      // Motor 2 power supply current (filtered)
+  uint32_t filt_cpu_temp;         // CPU temperature (filtered)
+  uint32_t filt_i_u_motor1_fast;  // Motor 1 U phase current (fast filtered for control)
+  uint32_t filt_i_v_motor1_fast;  // Motor 1 V phase current (fast filtered for control)
+  uint32_t filt_i_w_motor1_fast;  // Motor 1 W phase current (fast filtered for control)
+  uint32_t filt_i_u_motor2_fast;  // Motor 2 U phase current (fast filtered for control)
+  uint32_t filt_i_v_motor2_fast;  // Motor 2 V phase current (fast filtered for control)
+  uint32_t filt_i_w_motor2_fast;  // Motor 2 W phase current (fast filtered for control)
+  uint32_t filt_i_u_motor1_slow;  // Motor 1 U phase current (slow filtered for monitoring)
+  uint32_t filt_i_v_motor1_slow;  // Motor 1 V phase current (slow filtered for monitoring)
+  uint32_t filt_i_w_motor1_slow;  // Motor 1 W phase current (slow filtered for monitoring)
+  uint32_t filt_i_u_motor2_slow;  // Motor 2 U phase current (slow filtered for monitoring)
+  uint32_t filt_i_v_motor2_slow;  // Motor 2 V phase current (slow filtered for monitoring)
+  uint32_t filt_i_w_motor2_slow;  // Motor 2 W phase current (slow filtered for monitoring)
+  uint16_t smpl_cpu_temp;         // CPU temperature sensor sample
+  uint16_t smpl_int_ref_v;        // Internal reference voltage sample
+  bool     filters_initialized;
+  uint8_t  active_motor;
+  uint8_t  active_phase;
+} T_adc_ref;
+
+void Adc_ref_sampling_data_collection(T_adc_ref *p_ref);
+void Adc_ref_apply_ema_filtering(T_adc_ref *p_ref);
+
+#endif  // ADC_FILTER_REF_H
@@ -0,0 +1,123 @@
+#include "App.h"
+#include "can_bus_model.h"
+
+const can_api_t g_canfd_on_canfd;
+
+T_can_bus_frame g_can_bus_log[CAN_BUS_LOG_MAX];
+uint32_t        g_can_bus_log_cnt;
+uint32_t        g_can_bus_write_errors;
+
+static can_frame_t g_can_bus_mb[CAN_BUS_MB_COUNT];
+static uint32_t    g_can_bus_mb_busy;  // Bit n set - mailbox n holds a frame
+
+fsp_err_t R_CANFD_Open(can_ctrl_t *const p_api_ctrl, can_cfg_t const *const p_cfg)
+{
+  (void)p_api_ctrl;
+  (void)p_cfg;
+  return FSP_SUCCESS;
+}
+
+fsp_err_t R_CANFD_Write(can_ctrl_t *const p_api_ctrl, uint32_t const buffer, can_frame_t *const p_frame)
+{
+  (void)p_api_ctrl;
+  if ((buffer >= CAN_BUS_MB_COUNT) || ((g_can_bus_mb_busy & BIT(buffer)) != 0))
+  {
+    g_can_bus_write_errors++;
+    return FSP_ERR_CAN_TRANSMIT_NOT_READY;
+  }
+  g_can_bus_mb[buffer]  = *p_frame;
+  g_can_bus_mb_busy    |= BIT(buffer);
+  return FSP_SUCCESS;
+}
+
+uint32_t Write_to_IO_extender(uint8_t bit_id, uint8_t val)
+{
+  (void)bit_id;
+  (void)val;
+  return TX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Empty the mailboxes and the log
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void Can_bus_model_reset(void)
+{
+  g_can_bus_mb_busy      = 0;
+  g_can_bus_log_cnt      = 0;
+  g_can_bus_write_errors = 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Send one frame on the bus: lowest CAN ID first, equal IDs in mailbox number order
+
+  Parameters:
+
+  Return: 1 if a frame was sent, 0 if all mailboxes are empty
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Can_bus_model_step(void)
+{
+  can_callback_args_t args;
+  uint32_t            sel = CAN_BUS_MB_COUNT;
+
+  for (uint32_t mb = 0; mb < CAN_BUS_MB_COUNT; mb++)
+  {
+    if (((g_can_bus_mb_busy & BIT(mb)) != 0) && ((sel == CAN_BUS_MB_COUNT) || (g_can_bus_mb[mb].id < g_can_bus_mb[sel].id)))
+    {
+      sel = mb;
+    }
+  }
+  if (sel == CAN_BUS_MB_COUNT)
+  {
+    return 0;
+  }
+  if (g_can_bus_log_cnt < CAN_BUS_LOG_MAX)
+  {
+    T_can_bus_frame *f = &g_can_bus_log[g_can_bus_log_cnt++];
+
+    f->can_id  = g_can_bus_mb[sel].id;
+    f->dlc     = g_can_bus_mb[sel].data_length_code;
+    f->options = g_can_bus_mb[sel].options;
+    memcpy(f->data, g_can_bus_mb[sel].data, f->dlc);
+  }
+  g_can_bus_mb_busy &= ~BIT(sel);
+
+  memset(&args, 0, sizeof(args));
+  args.event  = CAN_EVENT_TX_COMPLETE;
+  args.buffer = sel;
+  CANFD_callback(&args);
+  return 1;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Send frames until the mailboxes stay empty
+
+  Parameters:
+
+  Return: Number of frames sent
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Can_bus_model_run(void)
+{
+  uint32_t n = 0;
+
+  while (Can_bus_model_step() != 0)
+  {
+    n++;
+  }
+  return n;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Occupied mailboxes
+
+  Parameters:
+
+  Return: Bit n set - mailbox n holds a frame
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Can_bus_model_busy(void)
+{
+  return g_can_bus_mb_busy;
+}
@@ -0,0 +1,29 @@
+#ifndef CAN_BUS_MODEL_H
+#define CAN_BUS_MODEL_H
+
+// Model of the CANFD TX mailboxes and the bus for the host tests of the CAN modules. It replaces the
+// FSP driver functions the CAN task calls. A bus step sends the frame the hardware would send next with
+// TPRI set: the lowest CAN ID, equal IDs in mailbox number order. The sent frame is logged and the TX
+// complete interrupt is called for its mailbox.
+
+#define CAN_BUS_MB_COUNT 4
+#define CAN_BUS_LOG_MAX  4096
+
+typedef struct
+{
+  uint32_t can_id;
+  uint8_t  dlc;
+  uint32_t options;
+  uint8_t  data[CAN_FD_MAX_DATA];
+} T_can_bus_frame;
+
+extern T_can_bus_frame g_can_bus_log[CAN_BUS_LOG_MAX];  // Frames in the order they were sent on the bus
+extern uint32_t        g_can_bus_log_cnt;
+extern uint32_t        g_can_bus_write_errors;          // Writes into an occupied mailbox
+
+void     Can_bus_model_reset(void);
+uint32_t Can_bus_model_step(void);
+uint32_t Can_bus_model_run(void);
+uint32_t Can_bus_model_busy(void);
+
+#endif  // CAN_BUS_MODEL_H
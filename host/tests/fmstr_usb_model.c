@@ -0,0 +1,311 @@
+#include "App.h"
+#include "freemaster_protocol.h"
+#include "freemaster_utils.h"
+#include "fmstr_usb_model.h"
+
+static int  _Usb_model_send_buf(const void *buf, unsigned int len);
+static int  _Usb_model_get_rx_block(const uint8_t **pdata, uint32_t *plen, int ticks);
+static void _Usb_model_release_rx_block(uint32_t cnt);
+
+T_freemaster_serial_driver g_fmstr_usb_model =
+{
+  0,
+  0,
+  NULL,
+  _Usb_model_send_buf,
+  NULL,
+  NULL,
+  NULL,
+  _Usb_model_get_rx_block,
+  _Usb_model_release_rx_block,
+  NULL,
+};
+
+uint8_t  g_fmstr_usb_tx[FMSTR_USB_TX_MAX];
+uint32_t g_fmstr_usb_tx_len;
+uint32_t g_fmstr_usb_tx_writes;
+
+static uint8_t  g_rx[FMSTR_USB_RX_MAX];
+static uint32_t g_rx_len;                             // Bytes queued
+static uint32_t g_rx_pack_end[FMSTR_USB_RX_PACKETS];  // End offset of every queued packet
+static uint32_t g_rx_pack_num;
+static uint32_t g_rx_pack;                            // Oldest packet with unread bytes
+static uint32_t g_rx_pos;                             // Read position
+static uint32_t g_rx_starve;                          // Empty block requests in a row
+static uint32_t g_rnd = 29;
+
+static uint32_t _Usb_model_rand(void)
+{
+  g_rnd = g_rnd * 1664525u + 1013904223u;
+  return g_rnd >> 8;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Collect a reply of the transport
+
+  Parameters: buf - data
+              len - number of bytes
+
+  Return: RES_OK
+-----------------------------------------------------------------------------------------------------*/
+static int _Usb_model_send_buf(const void *buf, unsigned int len)
+{
+  if (g_fmstr_usb_tx_len + len > FMSTR_USB_TX_MAX)
+  {
+    len = FMSTR_USB_TX_MAX - g_fmstr_usb_tx_len;
+  }
+  memcpy(&g_fmstr_usb_tx[g_fmstr_usb_tx_len], buf, len);
+  g_fmstr_usb_tx_len += len;
+  g_fmstr_usb_tx_writes++;
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Unread bytes of the oldest packet, as Fm_usbfs_drv_get_rx_block gives them
+
+  Parameters: pdata - first unread byte
+              plen  - number of unread bytes
+              ticks - not used, there is nobody who could send more data during the wait
+
+  Return: RES_OK or RES_ERROR if no packet is queued
+-----------------------------------------------------------------------------------------------------*/
+static int _Usb_model_get_rx_block(const uint8_t **pdata, uint32_t *plen, int ticks)
+{
+  (void)ticks;
+  while ((g_rx_pack < g_rx_pack_num) && (g_rx_pos >= g_rx_pack_end[g_rx_pack]))
+  {
+    g_rx_pack++;
+  }
+  if (g_rx_pack >= g_rx_pack_num)
+  {
+    if (++g_rx_starve >= FMSTR_USB_STARVE_MAX)
+    {
+      printf("FreeMASTER transport waits for bytes after the last packet\n");
+      exit(1);
+    }
+    return RES_ERROR;
+  }
+  g_rx_starve = 0;
+  *pdata      = &g_rx[g_rx_pos];
+  *plen       = g_rx_pack_end[g_rx_pack] - g_rx_pos;
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Mark bytes of the block as read
+
+  Parameters: cnt - number of bytes
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Usb_model_release_rx_block(uint32_t cnt)
+{
+  g_rx_pos += cnt;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Drop all queued bytes and collected replies
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void Fmstr_usb_model_reset(void)
+{
+  g_rx_len              = 0;
+  g_rx_pack_num         = 0;
+  g_rx_pack             = 0;
+  g_rx_pos              = 0;
+  g_rx_starve           = 0;
+  g_fmstr_usb_tx_len    = 0;
+  g_fmstr_usb_tx_writes = 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Queue bytes sent by the PC, split into packets of random size
+
+  Parameters: data       - bytes
+              len        - number of bytes
+              min_packet - smallest packet
+              max_packet - largest packet
+
+  Return: Number of packets
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Fmstr_usb_model_put(const uint8_t *data, uint32_t len, uint32_t min_packet, uint32_t max_packet)
+{
+  uint32_t packets = 0;
+
+  if (g_rx_len + len > FMSTR_USB_RX_MAX)
+  {
+    return 0;
+  }
+  memcpy(&g_rx[g_rx_len], data, len);
+  while ((len > 0) && (g_rx_pack_num < FMSTR_USB_RX_PACKETS))
+  {
+    uint32_t n = min_packet + _Usb_model_rand() % (max_packet - min_packet + 1);
+
+    if (n > len)
+    {
+      n = len;
+    }
+    g_rx_len                      += n;
+    len                           -= n;
+    g_rx_pack_end[g_rx_pack_num++] = g_rx_len;
+    packets++;
+  }
+  return packets;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Number of queued bytes the transport has not read yet
+
+  Parameters:
+
+  Return: Number of bytes
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Fmstr_usb_model_pending(void)
+{
+  return g_rx_len - g_rx_pos;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: CRC8 of the serial protocol computed bit by bit: polynomial 0x07, MSB first
+
+  Parameters: crc  - current checksum
+              data - bytes
+              len  - number of bytes
+
+  Return: Updated checksum
+-----------------------------------------------------------------------------------------------------*/
+uint8_t Fmstr_pc_crc8(uint8_t crc, const uint8_t *data, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i++)
+  {
+    crc ^= data[i];
+    for (uint32_t b = 0; b < 8; b++)
+    {
+      crc = (uint8_t)(((crc & 0x80u) != 0) ? ((crc << 1) ^ 0x07u) : (crc << 1));
+    }
+  }
+  return crc;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Encode an unsigned value in the ULEB128 format of the protocol
+
+  Parameters: dst - output
+              val - value
+
+  Return: Number of bytes
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Fmstr_pc_uleb(uint8_t *dst, uint64_t val)
+{
+  uint32_t n = 0;
+
+  do
+  {
+    dst[n] = (uint8_t)(val & 0x7Fu);
+    val  >>= 7;
+    if (val != 0)
+    {
+      dst[n] |= 0x80u;
+    }
+    n++;
+  } while (val != 0);
+  return n;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Encode a command frame: SOB, command, length, payload and CRC8, every SOB after the
+               first one doubled
+
+  Parameters: cmd     - command code
+              payload - command data
+              len     - number of data bytes, up to 255
+              dst     - output, at least 2 * (len + 3) + 1 bytes
+
+  Return: Number of bytes
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Fmstr_pc_encode(uint8_t cmd, const uint8_t *payload, uint32_t len, uint8_t *dst)
+{
+  uint8_t  hdr[2] = {cmd, (uint8_t)len};
+  uint8_t  crc    = Fmstr_pc_crc8(Fmstr_pc_crc8(FMSTR_CRC8_CCITT_SEED, hdr, 2), payload, len);
+  uint32_t n      = 0;
+
+  dst[n++] = FMSTR_SOB;
+  for (uint32_t i = 0; i < len + 3; i++)
+  {
+    uint8_t b = (i < 2) ? hdr[i] : ((i < len + 2) ? payload[i - 2] : crc);
+
+    dst[n++] = b;
+    if (b == FMSTR_SOB)
+    {
+      dst[n++] = b;
+    }
+  }
+  return n;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Decode a reply frame: SOB, status, length if the status has FMSTR_STSF_VARLEN, data and
+               CRC8, doubled SOB bytes are merged
+
+  Parameters: src      - received bytes
+              len      - number of received bytes
+              data_len - number of data bytes of a reply without length byte and without error
+              p_status - status
+              data     - reply data, at least 255 bytes
+              p_used   - number of bytes of the reply frame
+
+  Return: Number of data bytes, -1 for a broken frame, -2 for a CRC error
+-----------------------------------------------------------------------------------------------------*/
+int32_t Fmstr_pc_decode(const uint8_t *src, uint32_t len, uint32_t data_len, uint8_t *p_status, uint8_t *data, uint32_t *p_used)
+{
+  uint8_t  raw[260];
+  uint32_t raw_len = 0;
+  uint32_t need    = 2;
+  uint32_t i       = 1;
+
+  if ((len == 0) || (src[0] != FMSTR_SOB))
+  {
+    return -1;
+  }
+  while (raw_len < need)
+  {
+    if (i >= len)
+    {
+      return -1;
+    }
+    if (src[i] == FMSTR_SOB)
+    {
+      if ((i + 1 >= len) || (src[i + 1] != FMSTR_SOB))
+      {
+        return -1;
+      }
+      i++;
+    }
+    raw[raw_len++] = src[i++];
+    if (raw_len == 1)
+    {
+      // Status known: error replies have no data, variable length replies have the length byte next
+      need = ((raw[0] & FMSTR_STSF_VARLEN) != 0) ? 2 : (((raw[0] & FMSTR_STSF_ERROR) != 0) ? 2 : data_len + 2);
+    }
+    else if ((raw_len == 2) && ((raw[0] & FMSTR_STSF_VARLEN) != 0))
+    {
+      need = raw[1] + 3u;
+    }
+  }
+  *p_status = raw[0];
+  *p_used   = i;
+  if (Fmstr_pc_crc8(FMSTR_CRC8_CCITT_SEED, raw, raw_len - 1) != raw[raw_len - 1])
+  {
+    return -2;
+  }
+  if ((raw[0] & FMSTR_STSF_VARLEN) != 0)
+  {
+    memcpy(data, &raw[2], raw_len - 3);
+    return (int32_t)(raw_len - 3);
+  }
+  memcpy(data, &raw[1], raw_len - 2);
+  return (int32_t)(raw_len - 2);
+}
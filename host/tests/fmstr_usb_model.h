@@ -0,0 +1,30 @@
+#ifndef FMSTR_USB_MODEL_H
+#define FMSTR_USB_MODEL_H
+
+// Model of the FreeMASTER USB CDC driver for the host tests of the serial transport (freemaster_serial.c)
+// and of the PC side of the serial protocol. Bytes sent by the PC arrive in USB packets of the sizes the
+// test chooses and are handed to the transport through the zero copy block interface of the driver:
+// only the unread part of the oldest packet at a time. Replies of the transport are collected in one
+// buffer, as the PC would read them.
+
+#define FMSTR_USB_RX_MAX      (512u * 1024u)  // Bytes queued for the transport
+#define FMSTR_USB_RX_PACKETS  FMSTR_USB_RX_MAX  // Packets queued for the transport, down to one byte each
+#define FMSTR_USB_TX_MAX      (512u * 1024u)  // Bytes of the collected replies
+#define FMSTR_USB_STARVE_MAX  1000u           // Empty block requests in a row that mean the transport waits forever
+
+extern T_freemaster_serial_driver g_fmstr_usb_model;
+extern uint8_t                    g_fmstr_usb_tx[FMSTR_USB_TX_MAX];
+extern uint32_t                   g_fmstr_usb_tx_len;
+extern uint32_t                   g_fmstr_usb_tx_writes;  // Calls of _send_buf
+
+void     Fmstr_usb_model_reset(void);
+uint32_t Fmstr_usb_model_put(const uint8_t *data, uint32_t len, uint32_t min_packet, uint32_t max_packet);
+uint32_t Fmstr_usb_model_pending(void);
+
+// PC side of the protocol
+uint8_t  Fmstr_pc_crc8(uint8_t crc, const uint8_t *data, uint32_t len);
+uint32_t Fmstr_pc_uleb(uint8_t *dst, uint64_t val);
+uint32_t Fmstr_pc_encode(uint8_t cmd, const uint8_t *payload, uint32_t len, uint8_t *dst);
+int32_t  Fmstr_pc_decode(const uint8_t *src, uint32_t len, uint32_t data_len, uint8_t *p_status, uint8_t *data, uint32_t *p_used);
+
+#endif  // FMSTR_USB_MODEL_H
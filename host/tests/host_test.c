@@ -0,0 +1,18 @@
+#include "App.h"
+#include "host_test.h"
+
+uint32_t g_host_test_checks;
+uint32_t g_host_test_failures;
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Print the result of a test program
+
+  Parameters: name - test name
+
+  Return: Exit code of the program, 0 if all checks passed
+-----------------------------------------------------------------------------------------------------*/
+int Host_test_result(const char *name)
+{
+  printf("%s: %u checks, %u failed\n", name, g_host_test_checks, g_host_test_failures);
+  return (g_host_test_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+// Minimal test support of the host build: checks count failures and print where they happened,
+// the test program returns the result of Host_test_result as its exit code.
+
+extern uint32_t g_host_test_checks;
+extern uint32_t g_host_test_failures;
+
+#define TEST_CHECK(cond)                                                         \
+  do                                                                             \
+  {                                                                              \
+    g_host_test_checks++;                                                        \
+    if (!(cond))                                                                 \
+    {                                                                            \
+      g_host_test_failures++;                                                    \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);            \
+    }                                                                            \
+  } while (0)
+
+#define TEST_CHECK_EQ(actual, expected)                                          \
+  do                                                                             \
+  {                                                                              \
+    long long a_ = (long long)(actual);                                          \
+    long long e_ = (long long)(expected);                                        \
+    g_host_test_checks++;                                                        \
+    if (a_ != e_)                                                                \
+    {                                                                            \
+      g_host_test_failures++;                                                    \
+      printf("%s:%d: %s = %lld, expected %lld\n", __FILE__, __LINE__, #actual, a_, e_); \
+    }                                                                            \
+  } while (0)
+
+int Host_test_result(const char *name);
+
+#endif  // HOST_TEST_H
@@ -0,0 +1,31 @@
+#ifndef PARAM_LOOKUP_TABLES_H
+#define PARAM_LOOKUP_TABLES_H
+
+// Synthetic parameter sets of growing size for the lookup test and benchmark. The file with the sets,
+// param_lookup_tables.c, is generated at build time by
+// Generate_params_c_h_from_ParamsDB_txt.py --bench-tables with the same perfect hash builder and the
+// same Find_param_by_hash code as the parameter files of the firmware. The parameters have only a
+// name and an alias.
+
+#define PARAM_LOOKUP_SETS_NUM 6
+
+typedef struct
+{
+  uint16_t hash;
+  uint16_t index;
+} T_param_hash_entry;
+
+typedef struct
+{
+  uint32_t                  items_num;
+  const T_NV_parameters    *items_array;
+  const uint16_t           *index_to_hash;             // CRC16 of the name of every parameter
+  const T_param_hash_entry *hash_sorted;               // Sorted by hash, for the binary search of the old Find_param_by_hash
+  const T_param_phf        *name_index;
+  const T_param_phf        *alias_index;
+  uint16_t                  (*find_by_hash)(uint16_t hash);  // Generated Find_param_by_hash of the set
+} T_param_lookup_set;
+
+extern const T_param_lookup_set g_param_lookup_sets[PARAM_LOOKUP_SETS_NUM];
+
+#endif  // PARAM_LOOKUP_TABLES_H
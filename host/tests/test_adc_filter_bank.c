@@ -0,0 +1,174 @@
+#include "App.h"
+#include "host_test.h"
+#include "adc_filter_ref.h"
+
+// Bit-exact test of the ADC EMA filter bank. Adc_scan_end_isr of the driver and the unrolled code it
+// replaced (adc_filter_ref.c) process the same register values with the same multiplexer selection,
+// all filter states must be equal after every scan.
+
+void Adc_scan_end_isr(void);
+
+#define TEST_SCANS_PER_FREQ 200000u
+
+typedef struct
+{
+  const char     *name;
+  const uint32_t *p_ref;
+  const uint32_t *p_bank;
+} T_filt_pair;
+
+static T_adc_ref g_ref;
+static uint32_t  g_rnd = 12345;
+
+static uint32_t _Test_rand(void)
+{
+  g_rnd = g_rnd * 1664525u + 1013904223u;
+  return g_rnd >> 8;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: ADC code of one channel: mostly a slow signal with noise, sometimes a full scale step
+               or a rail value so the filters see large differences in both directions
+
+  Parameters: p_level - slow signal of the channel
+
+  Return: 12-bit ADC code
+-----------------------------------------------------------------------------------------------------*/
+static uint16_t _Test_adc_code(uint16_t *p_level)
+{
+  uint32_t r = _Test_rand();
+
+  switch (r % 64)
+  {
+    case 0:
+      *p_level = (uint16_t)((r >> 6) & 0x0FFF);
+      break;
+    case 1:
+      return 0;
+    case 2:
+      return 0x0FFF;
+    default:
+      break;
+  }
+  int32_t code = (int32_t)*p_level + (int32_t)((r >> 6) % 33) - 16;
+  if (code < 0)
+  {
+    code = 0;
+  }
+  if (code > 0x0FFF)
+  {
+    code = 0x0FFF;
+  }
+  return (uint16_t)code;
+}
+
+static void _Test_load_registers(void)
+{
+  static uint16_t levels[32];
+  uint16_t       *p_adc0 = (uint16_t *)R_ADC0->ADDR;
+  uint16_t       *p_adc1 = (uint16_t *)R_ADC1->ADDR;
+  static const uint8_t adc0_ch[] = {0, 1, 2, 4, 5, 6, 16};
+  static const uint8_t adc1_ch[] = {0, 1, 2, 4, 5, 17};
+  uint32_t        n      = 0;
+
+  for (uint32_t i = 0; i < sizeof(adc0_ch); i++)
+  {
+    p_adc0[adc0_ch[i]] = _Test_adc_code(&levels[n++]);
+  }
+  for (uint32_t i = 0; i < sizeof(adc1_ch); i++)
+  {
+    p_adc1[adc1_ch[i]] = _Test_adc_code(&levels[n++]);
+  }
+  *(uint16_t *)&R_ADC0->ADTSDR = _Test_adc_code(&levels[n++]);
+  *(uint16_t *)&R_ADC0->ADOCDR = _Test_adc_code(&levels[n++]);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Run the driver and the reference over a stream of scans at one PWM frequency
+
+  Parameters: pwm_freq - PWM frequency, selects the alpha coefficients
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_run(uint32_t pwm_freq)
+{
+  const T_filt_pair pairs[] = {
+    {"v24v", &g_ref.filt_v24v_mon, &adc.filt_dir[ADC_DIR_V24V]},
+    {"v5v", &g_ref.filt_v5v_mon, &adc.filt_dir[ADC_DIR_V5V]},
+    {"v3v3", &g_ref.filt_v3v3_mon, &adc.filt_dir[ADC_DIR_V3V3]},
+    {"therm_m1", &g_ref.filt_thermistor_m1, &adc.filt_dir[ADC_DIR_THERM_M1]},
+    {"therm_m2", &g_ref.filt_thermistor_m2, &adc.filt_dir[ADC_DIR_THERM_M2]},
+    {"cpu_temp", &g_ref.filt_cpu_temp, &adc.filt_dir[ADC_DIR_CPU_TEMP]},
+    {"v_u_m1", &g_ref.filt_v_u_motor1, &adc.filt_phase[ADC_PHASE_U][ADC_MOTOR_1]},
+    {"v_v_m1", &g_ref.filt_v_v_motor1, &adc.filt_phase[ADC_PHASE_V][ADC_MOTOR_1]},
+    {"v_w_m1", &g_ref.filt_v_w_motor1, &adc.filt_phase[ADC_PHASE_W][ADC_MOTOR_1]},
+    {"v_u_m2", &g_ref.filt_v_u_motor2, &adc.filt_phase[ADC_PHASE_U][ADC_MOTOR_2]},
+    {"v_v_m2", &g_ref.filt_v_v_motor2, &adc.filt_phase[ADC_PHASE_V][ADC_MOTOR_2]},
+    {"v_w_m2", &g_ref.filt_v_w_motor2, &adc.filt_phase[ADC_PHASE_W][ADC_MOTOR_2]},
+    {"i_u_m1_fast", &g_ref.filt_i_u_motor1_fast, &adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_I_U_FAST]},
+    {"i_v_m1_fast", &g_ref.filt_i_v_motor1_fast, &adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_I_V_FAST]},
+    {"i_w_m1_fast", &g_ref.filt_i_w_motor1_fast, &adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_I_W_FAST]},
+    {"i_u_m1_slow", &g_ref.filt_i_u_motor1_slow, &adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_I_U_SLOW]},
+    {"i_v_m1_slow", &g_ref.filt_i_v_motor1_slow, &adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_I_V_SLOW]},
+    {"i_w_m1_slow", &g_ref.filt_i_w_motor1_slow, &adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_I_W_SLOW]},
+    {"speed_m1", &g_ref.filt_speed_motor1, &adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_SPEED]},
+    {"pos_m1", &g_ref.filt_pos_motor1, &adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_POS]},
+    {"ipwr_m1", &g_ref.filt_ipwr_motor1, &adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_IPWR]},
+    {"i_u_m2_fast", &g_ref.filt_i_u_motor2_fast, &adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_I_U_FAST]},
+    {"i_v_m2_fast", &g_ref.filt_i_v_motor2_fast, &adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_I_V_FAST]},
+    {"i_w_m2_fast", &g_ref.filt_i_w_motor2_fast, &adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_I_W_FAST]},
+    {"i_u_m2_slow", &g_ref.filt_i_u_motor2_slow, &adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_I_U_SLOW]},
+    {"i_v_m2_slow", &g_ref.filt_i_v_motor2_slow, &adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_I_V_SLOW]},
+    {"i_w_m2_slow", &g_ref.filt_i_w_motor2_slow, &adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_I_W_SLOW]},
+    {"speed_m2", &g_ref.filt_speed_motor2, &adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_SPEED]},
+    {"pos_m2", &g_ref.filt_pos_motor2, &adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_POS]},
+    {"ipwr_m2", &g_ref.filt_ipwr_motor2, &adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_IPWR]},
+  };
+  uint32_t mismatches = 0;
+
+  Adc_driver_set_pwm_frequency(pwm_freq);
+  memset(&g_ref, 0, sizeof(g_ref));
+  memset(adc.smpl_mot, 0, sizeof(adc.smpl_mot));
+  memset(adc.smpl_phase, 0, sizeof(adc.smpl_phase));
+  memset(adc.smpl_dir, 0, sizeof(adc.smpl_dir));
+  adc.filters_initialized = false;
+  adc.active_motor        = ADC_MOTOR_1;
+  adc.active_phase        = ADC_PHASE_U;
+  adc.scan_cycle_counter  = 0;
+
+  for (uint32_t scan = 0; scan < TEST_SCANS_PER_FREQ; scan++)
+  {
+    _Test_load_registers();
+    g_ref.active_motor = adc.active_motor;
+    g_ref.active_phase = adc.active_phase;
+    Adc_scan_end_isr();
+    Adc_ref_sampling_data_collection(&g_ref);
+
+    for (uint32_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++)
+    {
+      if (*pairs[i].p_ref != *pairs[i].p_bank)
+      {
+        if (mismatches < 10)
+        {
+          printf("PWM %u Hz, scan %u, %s: bank %u, reference %u\n", pwm_freq, scan, pairs[i].name, *pairs[i].p_bank, *pairs[i].p_ref);
+        }
+        mismatches++;
+      }
+    }
+  }
+  TEST_CHECK_EQ(mismatches, 0);
+  // Every row of the bank was exercised: the phase and the motor multiplexers went around
+  TEST_CHECK(g_ref.filt_v_w_motor2 != 0);
+  TEST_CHECK(g_ref.filt_i_w_motor2_slow != 0);
+}
+
+int main(void)
+{
+  static const uint32_t freqs[] = {8000, 16000, 20000, 32000};
+
+  for (uint32_t i = 0; i < sizeof(freqs) / sizeof(freqs[0]); i++)
+  {
+    _Test_run(freqs[i]);
+  }
+  return Host_test_result("test_adc_filter_bank");
+}
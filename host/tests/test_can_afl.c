@@ -0,0 +1,255 @@
+#include "App.h"
+#include "host_test.h"
+#include "can_bus_model.h"
+
+// Test of the CAN acceptance filter list built from the RX handler table. A model of the AFL lookup
+// follows the hardware: rules are checked in list order and the first rule that matches decides, a rule
+// without destination discards the frame. The rule builder is checked for covered and duplicate
+// filters, for the merge it selects and for more filters than rules.
+// CAN_task.c is included so the handler table can be reset and the programmed list inspected.
+
+#include "CAN_task.c"
+
+#define TEST_RANDOM_IDS  100000
+#define TEST_RANDOM_SETS 2000
+
+static uint32_t g_rnd = 17;
+
+static uint32_t _Test_rand(void)
+{
+  g_rnd = g_rnd * 1664525u + 1013904223u;
+  return g_rnd;
+}
+
+static uint32_t _Test_rand_id(void)
+{
+  return (_Test_rand() ^ (_Test_rand() >> 16)) & CAN_RX_MASK_EXACT;
+}
+
+static void _Test_handler(const T_can_msg *rx_msg)
+{
+  (void)rx_msg;
+}
+
+static void _Test_reset(void)
+{
+  memset(g_can_rx_handlers, 0, sizeof(g_can_rx_handlers));
+  g_can_rx_handler_cnt     = 0;
+  g_can_rx_exact_cnt       = 0;
+  g_can_rx_handlers_locked = false;
+  g_can_afl_rule_cnt       = 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: AFL lookup of the CANFD module, the first matching rule decides
+
+  Parameters: id       - received CAN ID
+              extended - true for a 29-bit ID
+
+  Return: true if the frame is stored in a FIFO or a buffer
+-----------------------------------------------------------------------------------------------------*/
+static bool _Test_afl_accept(uint32_t id, bool extended)
+{
+  can_id_mode_t id_mode = extended ? CAN_ID_MODE_EXTENDED : CAN_ID_MODE_STANDARD;
+
+  for (uint32_t i = 0; i < CANFD_CFG_AFL_CH0_RULE_NUM; i++)
+  {
+    const canfd_afl_entry_t *e = &p_CANFD_afl[i];
+
+    if ((e->mask.mask_id_mode != 0) && (e->id.id_mode != id_mode))
+    {
+      continue;
+    }
+    if (((id ^ e->id.id) & e->mask.mask_id) != 0)
+    {
+      continue;
+    }
+    return (e->destination.fifo_select_flags != 0) || (e->destination.rx_buffer != CANFD_RX_MB_NONE);
+  }
+  return false;
+}
+
+static bool _Test_rules_cover_id(const T_can_afl_rule *rules, uint32_t rule_cnt, uint32_t id)
+{
+  for (uint32_t i = 0; i < rule_cnt; i++)
+  {
+    if ((id & rules[i].mask) == rules[i].id)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool _Test_has_rule(const T_can_afl_rule *rules, uint32_t rule_cnt, uint32_t id, uint32_t mask)
+{
+  for (uint32_t i = 0; i < rule_cnt; i++)
+  {
+    if ((rules[i].id == id) && (rules[i].mask == mask))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Handlers of the parameter exchange and a masked handler for the commands of all motors
+static void _Test_setup_first_match(void)
+{
+  static const uint32_t exact_ids[] = {MC80_PARAM_RD, MC80_PARAM_WR, MC80_PARAM_SAVE, MC80_PARAM_TXN, MC80_PARAM_BULK_RD, MC80_RESET};
+  uint32_t              motor_mask  = CAN_RX_MASK_EXACT & ~(0x0Fu << 20);
+  uint32_t              accepted    = 0;
+
+  _Test_reset();
+  for (uint32_t i = 0; i < sizeof(exact_ids) / sizeof(exact_ids[0]); i++)
+  {
+    TEST_CHECK_EQ(Can_rx_register_handler(exact_ids[i], CAN_RX_MASK_EXACT, _Test_handler, NULL), RES_OK);
+  }
+  TEST_CHECK_EQ(Can_rx_register_handler(MOT3_CMD, motor_mask, _Test_handler, NULL), RES_OK);
+  TEST_CHECK_EQ(Can_rx_register_handler(MOT3_CMD, motor_mask, _Test_handler, NULL), RES_ERROR);
+  _Can_afl_setup();
+  TEST_CHECK_EQ(Can_get_afl_rule_count(), sizeof(exact_ids) / sizeof(exact_ids[0]) + 1);
+  TEST_CHECK_EQ(Can_rx_register_handler(MC80_PARAM_ANS, CAN_RX_MASK_EXACT, _Test_handler, NULL), RES_ERROR);
+
+  // Every handler ID passes the rules before the unused entries, which match any frame and discard it
+  for (uint32_t i = 0; i < sizeof(exact_ids) / sizeof(exact_ids[0]); i++)
+  {
+    TEST_CHECK(_Test_afl_accept(exact_ids[i], true));
+    TEST_CHECK(!_Test_afl_accept(exact_ids[i] & 0x7FF, false));
+  }
+  for (uint32_t m = 0; m < 16; m++)
+  {
+    TEST_CHECK(_Test_afl_accept((MOT3_CMD & motor_mask) | (m << 20), true));
+  }
+
+  // Without merged rules exactly the IDs of the handlers are accepted
+  for (uint32_t i = 0; i < TEST_RANDOM_IDS; i++)
+  {
+    uint32_t id = _Test_rand_id();
+
+    if ((i & 1) != 0)
+    {
+      id = (MOT3_CMD & ~0xFFu) | (id & 0xFF);  // Near the handler IDs
+    }
+    TEST_CHECK_EQ(_Test_afl_accept(id, true), _Can_rx_find_handler(id) != NULL);
+    accepted += _Test_afl_accept(id, true);
+  }
+  TEST_CHECK(accepted > 0);
+  TEST_CHECK(!_Test_afl_accept(0x123, false));
+}
+
+// No handlers: one rule accepts every extended ID
+static void _Test_setup_accept_all(void)
+{
+  _Test_reset();
+  _Can_afl_setup();
+  TEST_CHECK_EQ(Can_get_afl_rule_count(), 0);
+  for (uint32_t i = 0; i < 1000; i++)
+  {
+    TEST_CHECK(_Test_afl_accept(_Test_rand_id(), true));
+  }
+  TEST_CHECK(!_Test_afl_accept(0x123, false));
+}
+
+static void _Test_build_merge(void)
+{
+  T_can_afl_rule rules[CAN_RX_HANDLER_MAX];
+  T_can_afl_rule filters[CAN_RX_HANDLER_MAX + 1];
+  uint32_t       cnt;
+
+  // Duplicate and covered filters take no rule
+  filters[0].id   = 0x123;
+  filters[0].mask = CAN_RX_MASK_EXACT;
+  filters[1]      = filters[0];
+  filters[2].id   = 0x12F;
+  filters[2].mask = CAN_RX_MASK_EXACT & ~0x0Fu;
+  cnt             = Can_afl_build(filters, 3, rules, CANFD_CFG_AFL_CH0_RULE_NUM);
+  TEST_CHECK_EQ(cnt, 1);
+  TEST_CHECK(_Test_has_rule(rules, cnt, 0x120, CAN_RX_MASK_EXACT & ~0x0Fu));
+
+  // Merging the pairs that differ in one bit adds 0 IDs, any other pair adds more
+  filters[0].id = 0x100;
+  filters[1].id = 0x101;
+  filters[2].id = 0x200;
+  filters[3].id = 0x202;
+  for (uint32_t i = 0; i < 4; i++)
+  {
+    filters[i].mask = CAN_RX_MASK_EXACT;
+  }
+  cnt = Can_afl_build(filters, 4, rules, 2);
+  TEST_CHECK_EQ(cnt, 2);
+  TEST_CHECK(_Test_has_rule(rules, cnt, 0x100, CAN_RX_MASK_EXACT & ~0x001u));
+  TEST_CHECK(_Test_has_rule(rules, cnt, 0x200, CAN_RX_MASK_EXACT & ~0x002u));
+  cnt = Can_afl_build(filters, 4, rules, 1);
+  TEST_CHECK_EQ(cnt, 1);
+  TEST_CHECK(_Test_has_rule(rules, cnt, 0, CAN_RX_MASK_EXACT & ~0x303u));
+  TEST_CHECK_EQ(Can_afl_check_coverage(filters, 4, rules, cnt), 0);
+
+  // Out of range arguments
+  for (uint32_t i = 0; i <= CAN_RX_HANDLER_MAX; i++)
+  {
+    filters[i].id   = i;
+    filters[i].mask = CAN_RX_MASK_EXACT;
+  }
+  TEST_CHECK_EQ(Can_afl_build(filters, CAN_RX_HANDLER_MAX + 1, rules, CANFD_CFG_AFL_CH0_RULE_NUM), 0);
+  TEST_CHECK_EQ(Can_afl_build(filters, 4, rules, 0), 0);
+  TEST_CHECK_EQ(Can_afl_build(filters, 0, rules, CANFD_CFG_AFL_CH0_RULE_NUM), 0);
+  TEST_CHECK_EQ(Can_afl_build(filters, CAN_RX_HANDLER_MAX, rules, CAN_RX_HANDLER_MAX), CAN_RX_HANDLER_MAX);
+
+  // A full handler table does not accept another handler
+  _Test_reset();
+  for (uint32_t i = 0; i < CAN_RX_HANDLER_MAX; i++)
+  {
+    TEST_CHECK_EQ(Can_rx_register_handler(0x1000 + i, CAN_RX_MASK_EXACT, _Test_handler, NULL), RES_OK);
+  }
+  TEST_CHECK_EQ(Can_rx_register_handler(0x2000, CAN_RX_MASK_EXACT, _Test_handler, NULL), RES_ERROR);
+}
+
+// Random filter sets with fewer rules than filters: the rules always cover every filter
+static void _Test_build_overflow(void)
+{
+  T_can_afl_rule rules[CAN_RX_HANDLER_MAX];
+  T_can_afl_rule filters[CAN_RX_HANDLER_MAX];
+  uint32_t       merged_sets = 0;
+
+  for (uint32_t s = 0; s < TEST_RANDOM_SETS; s++)
+  {
+    uint32_t base       = _Test_rand_id();
+    uint32_t filter_cnt = 1 + _Test_rand() % CAN_RX_HANDLER_MAX;
+    uint32_t max_rules  = 1 + _Test_rand() % CAN_RX_HANDLER_MAX;
+    uint32_t cnt;
+
+    for (uint32_t i = 0; i < filter_cnt; i++)
+    {
+      // IDs of a few nodes and message types, some handlers ignore a few low bits
+      filters[i].id   = base ^ (_Test_rand() & 0x0F0F00F3u & CAN_RX_MASK_EXACT);
+      filters[i].mask = ((_Test_rand() % 4) == 0) ? (CAN_RX_MASK_EXACT & ~(_Test_rand() & 0x0Fu)) : CAN_RX_MASK_EXACT;
+    }
+    cnt = Can_afl_build(filters, filter_cnt, rules, max_rules);
+    TEST_CHECK(cnt >= 1);
+    TEST_CHECK(cnt <= max_rules);
+    TEST_CHECK_EQ(Can_afl_check_coverage(filters, filter_cnt, rules, cnt), 0);
+    for (uint32_t r = 0; r < cnt; r++)
+    {
+      TEST_CHECK_EQ(rules[r].id & ~rules[r].mask, 0);
+      TEST_CHECK_EQ(rules[r].mask & ~CAN_RX_MASK_EXACT, 0);
+    }
+    for (uint32_t i = 0; i < filter_cnt; i++)
+    {
+      uint32_t id = (filters[i].id & filters[i].mask) | (_Test_rand_id() & ~filters[i].mask);
+
+      TEST_CHECK(_Test_rules_cover_id(rules, cnt, id));
+    }
+    merged_sets += (cnt < filter_cnt);
+  }
+  TEST_CHECK(merged_sets > 0);
+}
+
+int main(void)
+{
+  _Test_setup_first_match();
+  _Test_setup_accept_all();
+  _Test_build_merge();
+  _Test_build_overflow();
+  return Host_test_result("test_can_afl");
+}
@@ -0,0 +1,209 @@
+#include "App.h"
+#include "host_test.h"
+#include "can_bus_model.h"
+
+// Test of the CAN parameter exchange over the TX scheduler and a model of the mailboxes and the bus.
+// Answers that span several MC80_PARAM_ANS frames must reach the bus in the order of the request.
+// A bulk read is sent by the CAN TX task pass, the RX handler only hands the request over, and the end
+// marker must be the last frame of the stream on the bus.
+// CAN_task.c and CAN_parameter_exchange.c are included so their state can be reset.
+
+#include "CAN_task.c"
+#include "CAN_parameter_exchange.c"
+
+#define TEST_BULK_MAX 1024
+
+static void _Test_reset(void)
+{
+  Can_bus_model_reset();
+  memset(&g_can_tx_sched, 0, sizeof(g_can_tx_sched));
+  g_can_tx_sched.mb_free = BIT(CAN_TX_MB_COUNT) - 1;
+  memset(&g_can_error_counters, 0, sizeof(g_can_error_counters));
+  g_can_ready = true;
+  tx_event_flags_create(&g_can_tx_events, (CHAR *)"CAN_TX_EVENTS");
+  Can_param_exchange_init();
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Collect the parameter responses of the MC80_PARAM_ANS frames in the bus log
+
+  Parameters: p_resp - destination
+              max    - capacity of the destination
+
+  Return: Number of responses, entries with hash 0 (frame padding) are skipped
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Test_collect_responses(T_can_param_response *p_resp, uint32_t max)
+{
+  uint32_t n = 0;
+
+  for (uint32_t i = 0; i < g_can_bus_log_cnt; i++)
+  {
+    const T_can_bus_frame *f = &g_can_bus_log[i];
+
+    if (f->can_id != MC80_PARAM_ANS)
+    {
+      continue;
+    }
+    for (uint32_t k = 0; (k + sizeof(T_can_param_response)) <= f->dlc; k += sizeof(T_can_param_response))
+    {
+      T_can_param_response r;
+
+      memcpy(&r, &f->data[k], sizeof(r));
+      if ((r.param_hash != 0) && (n < max))
+      {
+        p_resp[n++] = r;
+      }
+    }
+  }
+  return n;
+}
+
+// CAN FD read of CAN_FD_PARAM_RD_MAX parameters while telemetry occupies the bus
+static void _Test_fd_read_order(void)
+{
+  T_can_msg            rx;
+  T_can_param_response resp[CAN_FD_PARAM_RD_MAX];
+  uint16_t             hashes[CAN_FD_PARAM_RD_MAX];
+  uint32_t             n;
+
+  _Test_reset();
+  memset(&rx, 0, sizeof(rx));
+  rx.can_id  = MC80_PARAM_RD;
+  rx.dlc     = CAN_FD_MAX_DATA;
+  rx.options = CANFD_FRAME_OPTION_FD | CANFD_FRAME_OPTION_BRS;
+  for (uint32_t i = 0; i < CAN_FD_PARAM_RD_MAX; i++)
+  {
+    hashes[i] = Get_param_hash_by_index((uint16_t)(CAN_FD_PARAM_RD_MAX - 1 - i));  // Not in index order
+    memcpy(&rx.data[i * sizeof(uint16_t)], &hashes[i], sizeof(uint16_t));
+  }
+
+  // Mailbox 0 holds a frame with a higher ID than the answers, the others are freed first and the
+  // answers are spread over mailboxes in an order the hardware does not send them in
+  TEST_CHECK_EQ(Can_send_extended_data(MC80_PARAM_ANS + 0x60000u, NULL, 8), CAN_SEND_SUCCESS);
+  for (uint32_t i = 1; i < CAN_TX_MB_COUNT; i++)
+  {
+    TEST_CHECK_EQ(Can_send_extended_data(MC80_SENS_INFO, NULL, 8), CAN_SEND_SUCCESS);
+  }
+  TEST_CHECK_EQ(Can_param_process_message(&rx), RES_OK);
+  Can_bus_model_step();
+  TEST_CHECK_EQ(Can_send_extended_data(MC80_ANS, NULL, 8), CAN_SEND_SUCCESS);
+  Can_bus_model_run();
+
+  n = _Test_collect_responses(resp, CAN_FD_PARAM_RD_MAX);
+  TEST_CHECK_EQ(n, CAN_FD_PARAM_RD_MAX);
+  for (uint32_t i = 0; i < n; i++)
+  {
+    TEST_CHECK_EQ(resp[i].param_hash, hashes[i]);
+    TEST_CHECK(resp[i].status != PARAM_STATUS_NOT_FOUND);
+  }
+  TEST_CHECK_EQ(g_can_bus_write_errors, 0);
+}
+
+// Bulk read of all parameters while telemetry keeps being sent
+static void _Test_bulk_read(bool fd)
+{
+  static T_can_param_response resp[TEST_BULK_MAX];
+  T_can_msg                   rx;
+  T_can_param_bulk_read_req   req;
+  T_can_param_response        end;
+  uint32_t                    expected = 0;
+  uint32_t                    end_frame = 0;
+  uint32_t                    end_cnt   = 0;
+  uint32_t                    max_in_flight = 0;
+  uint32_t                    n;
+  ULONG                       t0;
+
+  _Test_reset();
+  memset(&rx, 0, sizeof(rx));
+  memset(&req, 0, sizeof(req));
+  rx.can_id  = MC80_PARAM_BULK_RD;
+  rx.dlc     = sizeof(req);
+  rx.options = fd ? (CANFD_FRAME_OPTION_FD | CANFD_FRAME_OPTION_BRS) : 0;
+  memcpy(rx.data, &req, sizeof(req));
+  for (uint32_t i = 0; i < wvar_inst.items_num; i++)
+  {
+    uint8_t data_type;
+    uint8_t data[4];
+    uint8_t data_length;
+
+    if (_Can_param_convert_to_can_format((uint16_t)i, &data_type, data, &data_length) == RES_OK)
+    {
+      expected++;
+    }
+  }
+
+  // The RX handler returns at once without sending or waiting
+  t0 = tx_time_get();
+  TEST_CHECK_EQ(Can_param_process_message(&rx), RES_OK);
+  TEST_CHECK_EQ(tx_time_get(), t0);
+  TEST_CHECK_EQ(Can_get_tx_id_count(MC80_PARAM_ANS), 0);
+
+  for (uint32_t step = 0; step < CAN_BUS_LOG_MAX; step++)
+  {
+    _Can_tx_task_service(TX_NO_WAIT);
+    if (Can_get_tx_id_count(MC80_PARAM_ANS) > max_in_flight)
+    {
+      max_in_flight = Can_get_tx_id_count(MC80_PARAM_ANS);
+    }
+    if ((step % 3) == 0)
+    {
+      Can_send_extended_data(MC80_SENS_INFO, NULL, 8);
+    }
+    if ((Can_bus_model_step() == 0) && (g_param_bulk.active == false))
+    {
+      break;
+    }
+  }
+  TEST_CHECK(g_param_bulk.active == false);
+  TEST_CHECK(max_in_flight <= CAN_PARAM_BULK_WINDOW);
+  TEST_CHECK(max_in_flight > 1);
+
+  // The end marker is in the last MC80_PARAM_ANS frame and alone in it
+  for (uint32_t i = 0; i < g_can_bus_log_cnt; i++)
+  {
+    const T_can_bus_frame *f = &g_can_bus_log[i];
+
+    if (f->can_id != MC80_PARAM_ANS)
+    {
+      continue;
+    }
+    TEST_CHECK_EQ(f->options != 0, fd);
+    memcpy(&end, f->data, sizeof(end));
+    if (end.status == PARAM_STATUS_BULK_END)
+    {
+      end_cnt++;
+      end_frame = i;
+    }
+  }
+  TEST_CHECK_EQ(end_cnt, 1);
+  for (uint32_t i = end_frame + 1; i < g_can_bus_log_cnt; i++)
+  {
+    TEST_CHECK(g_can_bus_log[i].can_id != MC80_PARAM_ANS);
+  }
+  memcpy(&end, g_can_bus_log[end_frame].data, sizeof(end));
+  TEST_CHECK_EQ(end.param_hash, 0);
+  TEST_CHECK_EQ(end.data[0] | (end.data[1] << 8), expected);
+  TEST_CHECK_EQ(end.data[2] | (end.data[3] << 8), wvar_inst.items_num);
+  for (uint32_t k = sizeof(end); k < g_can_bus_log[end_frame].dlc; k++)
+  {
+    TEST_CHECK_EQ(g_can_bus_log[end_frame].data[k], 0);
+  }
+
+  // All parameters in index order
+  n = _Test_collect_responses(resp, TEST_BULK_MAX);
+  TEST_CHECK_EQ(n, expected);
+  for (uint32_t i = 1; i < n; i++)
+  {
+    TEST_CHECK(Find_param_by_hash(resp[i].param_hash) > Find_param_by_hash(resp[i - 1].param_hash));
+  }
+  TEST_CHECK_EQ(g_can_bus_write_errors, 0);
+  TEST_CHECK_EQ(g_can_error_counters.tx_queue_full_errors, 0);
+}
+
+int main(void)
+{
+  _Test_fd_read_order();
+  _Test_bulk_read(false);
+  _Test_bulk_read(true);
+  return Host_test_result("test_can_param");
+}
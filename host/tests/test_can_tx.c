@@ -0,0 +1,154 @@
+#include "App.h"
+#include "host_test.h"
+#include "can_bus_model.h"
+
+// Test of the CAN TX scheduler: frames with one CAN ID must reach the bus in the order they were
+// queued, also when they wait for mailboxes, and the class priority of the scheduler is kept.
+// CAN_task.c is included so the scheduler state can be reset, the mailboxes and the bus are modeled by
+// can_bus_model.c.
+
+#include "CAN_task.c"
+
+#define TEST_ID_PARAM  MC80_PARAM_ANS
+#define TEST_ID_SENS   MC80_SENS_INFO
+#define TEST_ID_OTHER  0x1A0D0001u
+#define TEST_FRAMES    400
+
+static uint32_t g_rnd = 13;
+
+static uint32_t _Test_rand(void)
+{
+  g_rnd = g_rnd * 1664525u + 1013904223u;
+  return g_rnd >> 8;
+}
+
+static void _Test_reset(void)
+{
+  Can_bus_model_reset();
+  memset(&g_can_tx_sched, 0, sizeof(g_can_tx_sched));
+  g_can_tx_sched.mb_free = BIT(CAN_TX_MB_COUNT) - 1;
+  memset(&g_can_error_counters, 0, sizeof(g_can_error_counters));
+  g_can_ready = true;
+}
+
+static uint32_t _Test_send(uint32_t can_id, uint32_t seq)
+{
+  uint8_t data[8] = {0};
+
+  memcpy(data, &seq, sizeof(seq));
+  return Can_send_extended_data(can_id, data, 8);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Check that the frames of an ID in the bus log carry sequence numbers 0, 1, 2 ...
+
+  Parameters: can_id - CAN ID
+              count  - number of frames queued with this ID
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_check_order(uint32_t can_id, uint32_t count)
+{
+  uint32_t next     = 0;
+  uint32_t reorders = 0;
+
+  for (uint32_t i = 0; i < g_can_bus_log_cnt; i++)
+  {
+    uint32_t seq;
+
+    if (g_can_bus_log[i].can_id != can_id)
+    {
+      continue;
+    }
+    memcpy(&seq, g_can_bus_log[i].data, sizeof(seq));
+    if (seq != next)
+    {
+      reorders++;
+    }
+    next = seq + 1;
+  }
+  TEST_CHECK_EQ(reorders, 0);
+  TEST_CHECK_EQ(next, count);
+}
+
+// Frames of one ID queued back to back, more than there are mailboxes
+static void _Test_same_id_burst(void)
+{
+  _Test_reset();
+  for (uint32_t n = 0; n < 12; n++)
+  {
+    TEST_CHECK_EQ(_Test_send(TEST_ID_PARAM, n), CAN_SEND_SUCCESS);
+  }
+  // Only one of them is in a mailbox, the others wait
+  TEST_CHECK_EQ(Can_bus_model_busy(), 1);
+  TEST_CHECK_EQ(Can_bus_model_run(), 12);
+  _Test_check_order(TEST_ID_PARAM, 12);
+  TEST_CHECK_EQ(g_can_tx_sched.pending_cnt, 0);
+  TEST_CHECK_EQ(g_can_bus_write_errors, 0);
+}
+
+// Several IDs, queued and sent at random times
+static void _Test_mixed_ids(void)
+{
+  static const uint32_t ids[] = {TEST_ID_PARAM, TEST_ID_SENS, MC80_ANS, TEST_ID_OTHER, TEST_ID_OTHER + 1};
+  uint32_t              seq[sizeof(ids) / sizeof(ids[0])] = {0};
+
+  _Test_reset();
+  for (uint32_t n = 0; n < TEST_FRAMES; n++)
+  {
+    uint32_t k = _Test_rand() % (sizeof(ids) / sizeof(ids[0]));
+
+    // Runs of one ID are frequent in the parameter streaming
+    for (uint32_t r = 1 + _Test_rand() % 4; r > 0; r--)
+    {
+      while (g_can_tx_sched.pending_cnt >= CAN_TX_QUEUE_DEPTH)
+      {
+        Can_bus_model_step();
+      }
+      TEST_CHECK_EQ(_Test_send(ids[k], seq[k]), CAN_SEND_SUCCESS);
+      seq[k]++;
+    }
+    for (uint32_t s = _Test_rand() % 4; s > 0; s--)
+    {
+      Can_bus_model_step();
+    }
+  }
+  Can_bus_model_run();
+  for (uint32_t k = 0; k < sizeof(ids) / sizeof(ids[0]); k++)
+  {
+    _Test_check_order(ids[k], seq[k]);
+  }
+  TEST_CHECK_EQ(g_can_tx_sched.pending_cnt, 0);
+  TEST_CHECK_EQ(g_can_bus_write_errors, 0);
+}
+
+// A status frame queued behind parameter responses takes the next free mailbox
+static void _Test_class_priority(void)
+{
+  uint32_t pos = UINT32_MAX;
+
+  _Test_reset();
+  for (uint32_t n = 0; n < 10; n++)
+  {
+    TEST_CHECK_EQ(_Test_send(TEST_ID_OTHER + n, 0), CAN_SEND_SUCCESS);
+  }
+  TEST_CHECK_EQ(_Test_send(MC80_ANS, 0), CAN_SEND_SUCCESS);
+  Can_bus_model_run();
+  for (uint32_t i = 0; i < g_can_bus_log_cnt; i++)
+  {
+    if (g_can_bus_log[i].can_id == MC80_ANS)
+    {
+      pos = i;
+    }
+  }
+  TEST_CHECK(pos <= CAN_TX_MB_COUNT);
+  TEST_CHECK_EQ(g_can_bus_log_cnt, 11);
+}
+
+int main(void)
+{
+  _Test_same_id_burst();
+  _Test_mixed_ids();
+  _Test_class_priority();
+  return Host_test_result("test_can_tx");
+}
@@ -0,0 +1,303 @@
+#include "App.h"
+#include "host_test.h"
+#include "fmstr_usb_model.h"
+#include "../../src/FreeMaster/freemaster_serial.c"
+
+// Test of the FreeMASTER serial transport over the USB driver model (fmstr_usb_model.c) with the
+// protocol decoder of freemaster_protocol.c. Streams of memory write and read commands with SOB bytes
+// in every field are cut into USB packets of random size, so doubled SOB bytes, headers and checksums
+// are split between packets. Every command must be executed once and answered with one write, in
+// order. Frames with a bad checksum must be answered with a checksum error, cut frames and bytes
+// between frames must be skipped, and the next frame must be received. The CRC8 table of the
+// transport must give the checksum of the bitwise algorithm.
+
+#define TEST_MEM_SIZE   1024u
+#define TEST_FRAMES     2000u
+#define TEST_MAX_DATA   200u   // Data bytes of one command, the message fits FMSTR_COMM_BUFFER_SIZE
+#define TEST_STREAM_MAX (TEST_FRAMES * (2u * (TEST_MAX_DATA + 24u) + 1u))
+
+typedef enum
+{
+  TEST_FRAME_WRITE,
+  TEST_FRAME_READ,
+  TEST_FRAME_BAD_CRC,
+  TEST_FRAME_CUT,
+} T_test_frame_kind;
+
+typedef struct
+{
+  T_test_frame_kind kind;
+  uint32_t          offs;
+  uint32_t          len;
+  uint8_t           data[TEST_MAX_DATA];  // Data of a write
+} T_test_frame;
+
+static uint8_t      g_mem[TEST_MEM_SIZE];     // Target memory, in the TSA table
+static uint8_t      g_shadow[TEST_MEM_SIZE];  // Content of the target memory after the commands sent so far
+static uint8_t      g_stream[TEST_STREAM_MAX];
+static T_test_frame g_frames[TEST_FRAMES];
+static uint32_t     g_rnd = 11;
+
+FMSTR_TSA_TABLE_BEGIN(test_vars)
+FMSTR_TSA_RW_MEM(g_mem, FMSTR_TSA_UINT8, g_mem, sizeof(g_mem))
+FMSTR_TSA_TABLE_END();
+
+FMSTR_TSA_TABLE_LIST_BEGIN()
+FMSTR_TSA_TABLE(test_vars)
+FMSTR_TSA_TABLE_LIST_END()
+
+static uint32_t _Test_rand(void)
+{
+  g_rnd = g_rnd * 1664525u + 1013904223u;
+  return g_rnd >> 8;
+}
+
+// Every third byte is SOB
+static uint8_t _Test_rand_byte(void)
+{
+  return ((_Test_rand() % 3u) == 0) ? FMSTR_SOB : (uint8_t)_Test_rand();
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Encode a memory write or read command of a part of the target memory
+
+  Parameters: data - data of a write, NULL for a read
+              offs - offset in the target memory
+              len  - number of bytes
+              dst  - output
+
+  Return: Number of encoded bytes
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Test_mem_cmd(const uint8_t *data, uint32_t offs, uint32_t len, uint8_t *dst)
+{
+  uint8_t  payload[TEST_MAX_DATA + 24];
+  uint32_t n = 0;
+
+  if (data != NULL)
+  {
+    payload[n++] = 0;  // No mask, no flash
+  }
+  n += Fmstr_pc_uleb(&payload[n], (uint64_t)(uintptr_t)&g_mem[offs]);
+  n += Fmstr_pc_uleb(&payload[n], len);
+  if (data != NULL)
+  {
+    memcpy(&payload[n], data, len);
+    n += len;
+  }
+  return Fmstr_pc_encode((data != NULL) ? FMSTR_CMD_WRITEMEM : FMSTR_CMD_READMEM, payload, n, dst);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Build a stream of random frames
+
+  Parameters: damaged - 1 to add frames with a bad checksum, cut frames and bytes between frames
+
+  Return: Number of bytes of the stream
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Test_build_stream(uint32_t damaged)
+{
+  uint32_t len = 0;
+
+  for (uint32_t f = 0; f < TEST_FRAMES; f++)
+  {
+    T_test_frame *p = &g_frames[f];
+    uint32_t      n;
+
+    p->offs = _Test_rand() % TEST_MEM_SIZE;
+    p->len  = 1 + _Test_rand() % TEST_MAX_DATA;
+    if (p->offs + p->len > TEST_MEM_SIZE)
+    {
+      p->len = TEST_MEM_SIZE - p->offs;
+    }
+    p->kind = ((_Test_rand() & 1u) != 0) ? TEST_FRAME_WRITE : TEST_FRAME_READ;
+    if ((damaged != 0) && ((_Test_rand() % 8u) == 0))
+    {
+      p->kind = ((_Test_rand() & 1u) != 0) ? TEST_FRAME_BAD_CRC : TEST_FRAME_CUT;
+    }
+    // The last frame is complete, the transport waits for bytes until a frame ends
+    if (f == TEST_FRAMES - 1)
+    {
+      p->kind = TEST_FRAME_READ;
+    }
+
+    for (uint32_t i = 0; i < p->len; i++)
+    {
+      p->data[i] = _Test_rand_byte();
+    }
+    if (p->kind == TEST_FRAME_READ)
+    {
+      len += _Test_mem_cmd(NULL, p->offs, p->len, &g_stream[len]);
+      continue;
+    }
+    n = _Test_mem_cmd(p->data, p->offs, p->len, &g_stream[len]);
+    if (p->kind == TEST_FRAME_WRITE)
+    {
+      memcpy(&g_shadow[p->offs], p->data, p->len);
+    }
+    else if (p->kind == TEST_FRAME_BAD_CRC)
+    {
+      // The checksum is the last byte, doubled if it is SOB, and must not become SOB
+      if (g_stream[len + n - 1] == FMSTR_SOB)
+      {
+        n--;
+      }
+      g_stream[len + n - 1] ^= (g_stream[len + n - 1] == (FMSTR_SOB ^ 0x01u)) ? 0x03u : 0x01u;
+    }
+    else
+    {
+      // Cut in the data, not between an SOB and its double. The next bytes must start a frame,
+      // any other byte would be taken as data of the cut frame.
+      n = 4 + _Test_rand() % (n - 5);
+      while ((n > 4) && (g_stream[len + n - 1] == FMSTR_SOB))
+      {
+        n--;
+      }
+      len += n;
+      continue;
+    }
+    len += n;
+
+    // Noise between frames: bytes without SOB are not a frame and must be skipped
+    if ((damaged != 0) && (f < TEST_FRAMES - 1) && ((_Test_rand() % 8u) == 0))
+    {
+      for (uint32_t i = _Test_rand() % 16u; i > 0; i--)
+      {
+        uint8_t b = (uint8_t)_Test_rand();
+
+        g_stream[len++] = (b == FMSTR_SOB) ? 0 : b;
+      }
+    }
+  }
+  return len;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Send a stream in random packets, poll the transport and check the replies in order
+
+  Parameters: damaged    - see _Test_build_stream
+              min_packet - smallest USB packet
+              max_packet - largest USB packet
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_stream(uint32_t damaged, uint32_t min_packet, uint32_t max_packet)
+{
+  static uint8_t expect[TEST_MEM_SIZE];
+  uint32_t       len;
+  uint32_t       pos          = 0;
+  uint32_t       polls        = 0;
+  uint32_t       reply_errors = 0;
+  uint32_t       answered     = 0;
+  uint32_t       cut          = 0;
+
+  memset(g_mem, 0, sizeof(g_mem));
+  memset(g_shadow, 0, sizeof(g_shadow));
+  Fmstr_usb_model_reset();
+  len = _Test_build_stream(damaged);
+  Fmstr_usb_model_put(g_stream, len, min_packet, max_packet);
+
+  // The transport processes one frame per poll and answers it, cut frames are not answered
+  for (uint32_t f = 0; f < TEST_FRAMES; f++)
+  {
+    cut += (g_frames[f].kind == TEST_FRAME_CUT);
+  }
+  while (Fmstr_usb_model_pending() > 0)
+  {
+    FMSTR_Poll();
+    polls++;
+  }
+  TEST_CHECK_EQ(polls, TEST_FRAMES - cut);
+  TEST_CHECK_EQ(g_fmstr_usb_tx_writes, TEST_FRAMES - cut);
+
+  // Replies in the order of the frames, reads return the memory as written by the writes before them
+  memset(expect, 0, sizeof(expect));
+  for (uint32_t f = 0; f < TEST_FRAMES; f++)
+  {
+    const T_test_frame *p = &g_frames[f];
+    uint8_t             status;
+    uint8_t             data[256];
+    uint32_t            used;
+    int32_t             n;
+
+    if (p->kind == TEST_FRAME_CUT)
+    {
+      continue;
+    }
+    n = Fmstr_pc_decode(&g_fmstr_usb_tx[pos], g_fmstr_usb_tx_len - pos, (p->kind == TEST_FRAME_READ) ? p->len : 0, &status, data, &used);
+    if (n < 0)
+    {
+      reply_errors++;
+      break;
+    }
+    pos += used;
+    answered++;
+    switch (p->kind)
+    {
+      case TEST_FRAME_WRITE:
+        reply_errors += (status != FMSTR_STS_OK) || (n != 0);
+        memcpy(&expect[p->offs], p->data, p->len);
+        break;
+      case TEST_FRAME_READ:
+        reply_errors += (status != FMSTR_STS_OK) || ((uint32_t)n != p->len) || (memcmp(data, &expect[p->offs], p->len) != 0);
+        break;
+      default:
+        reply_errors += (status != FMSTR_STC_CMDCSERR) || (n != 0);
+        break;
+    }
+  }
+  TEST_CHECK_EQ(reply_errors, 0);
+  TEST_CHECK_EQ(answered, TEST_FRAMES - cut);
+  TEST_CHECK_EQ(pos, g_fmstr_usb_tx_len);
+  TEST_CHECK(memcmp(g_mem, g_shadow, sizeof(g_mem)) == 0);
+  printf("%s stream, packets %u..%u: %u frames, %u bytes, %u cut frames\n", damaged ? "damaged" : "clean", (unsigned)min_packet, (unsigned)max_packet,
+         (unsigned)TEST_FRAMES, (unsigned)len, (unsigned)cut);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: CRC8 table and block checksum of the transport against the bitwise algorithm
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_crc(void)
+{
+  uint8_t  block[300];
+  uint32_t tab_errors   = 0;
+  uint32_t block_errors = 0;
+
+  for (uint32_t i = 0; i < 256; i++)
+  {
+    uint8_t b = (uint8_t)i;
+
+    tab_errors += (fmstr_crc8_tab[i] != Fmstr_pc_crc8(0, &b, 1));
+  }
+  for (uint32_t r = 0; r < 1000; r++)
+  {
+    uint32_t len  = _Test_rand() % sizeof(block);
+    uint8_t  seed = (uint8_t)_Test_rand();
+    uint8_t  crc  = seed;
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+      block[i] = (uint8_t)_Test_rand();
+      FMSTR_Crc8AddByte(&crc, block[i]);
+    }
+    block_errors += (FMSTR_Crc8Block(seed, block, len) != Fmstr_pc_crc8(seed, block, len));
+    block_errors += (crc != Fmstr_pc_crc8(seed, block, len));
+  }
+  TEST_CHECK_EQ(tab_errors, 0);
+  TEST_CHECK_EQ(block_errors, 0);
+}
+
+int main(void)
+{
+  frm_serial_drv = &g_fmstr_usb_model;
+  TEST_CHECK(FMSTR_Init((void *)&FMSTR_SERIAL));
+  _Test_crc();
+  _Test_stream(0, 1, 1);
+  _Test_stream(0, 1, 64);
+  _Test_stream(1, 1, 64);
+  _Test_stream(1, 64, 64);
+  return Host_test_result("test_fmstr_serial");
+}
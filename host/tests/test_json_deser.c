@@ -0,0 +1,156 @@
+#include "App.h"
+#include "host_test.h"
+
+// Test of the settings deserializer: a settings document with an invalid value must be rejected as a
+// whole, from memory and from a file, and a file that can not be read again in the apply pass must not
+// leave a mix of old and new parameters. The file is a text in memory behind fx_file_read and
+// fx_file_seek.
+
+static const char *g_file_text;
+static uint32_t    g_file_pos;
+static uint32_t    g_file_seek_cnt;
+static uint32_t    g_file_seek_fail_at;  // Number of the seek that fails, 0 - none
+
+UINT fx_file_seek(FX_FILE *file_ptr, ULONG byte_offset)
+{
+  (void)file_ptr;
+  g_file_seek_cnt++;
+  if (g_file_seek_cnt == g_file_seek_fail_at)
+  {
+    return FX_IO_ERROR;
+  }
+  g_file_pos = byte_offset;
+  return FX_SUCCESS;
+}
+
+UINT fx_file_read(FX_FILE *file_ptr, VOID *buffer_ptr, ULONG request_size, ULONG *actual_size)
+{
+  uint32_t len = (uint32_t)strlen(g_file_text);
+  uint32_t n   = len - g_file_pos;
+
+  (void)file_ptr;
+  if (n == 0)
+  {
+    *actual_size = 0;
+    return FX_END_OF_FILE;
+  }
+  // Short blocks so that the values cross the chunk boundaries of the reader
+  if (n > request_size)
+  {
+    n = request_size;
+  }
+  if (n > 7)
+  {
+    n = 7;
+  }
+  memcpy(buffer_ptr, g_file_text + g_file_pos, n);
+  g_file_pos  += n;
+  *actual_size = n;
+  return FX_SUCCESS;
+}
+
+static void _Test_file_open(const char *text, uint32_t seek_fail_at)
+{
+  g_file_text         = text;
+  g_file_pos          = 0;
+  g_file_seek_cnt     = 0;
+  g_file_seek_fail_at = seek_fail_at;
+}
+
+static void _Test_set_params(uint32_t pwm_frequency, uint32_t can_ans_period_ms, uint32_t usb_mode)
+{
+  wvar.pwm_frequency     = pwm_frequency;
+  wvar.can_ans_period_ms = can_ans_period_ms;
+  wvar.usb_mode          = usb_mode;
+}
+
+// Valid document
+static const char g_doc_ok[] =
+ "[{\"Device\": {\"Name\": \"MC80\"}}, {\"Parameters\": ["
+ "[\"pwm_frequency\", \"12000\"], [\"can_ans_period_ms\", \"250\"], [\"usb_mode\", \"3\"]]}]";
+
+// The first values are valid, the last one is above the maximum
+static const char g_doc_range[] =
+ "[{\"Parameters\": ["
+ "[\"pwm_frequency\", \"12000\"], [\"can_ans_period_ms\", \"250\"], [\"usb_mode\", \"99\"]]}]";
+
+// The first values are valid, the last one is not a number
+static const char g_doc_syntax[] =
+ "[{\"Parameters\": ["
+ "[\"pwm_frequency\", \"12000\"], [\"can_ans_period_ms\", \"25x\"]]}]";
+
+// The document is cut after the first values
+static const char g_doc_cut[] =
+ "[{\"Parameters\": ["
+ "[\"pwm_frequency\", \"12000\"], [\"can_ans_period_ms\", \"250\"]";
+
+static void _Test_from_memory(void)
+{
+  char text[sizeof(g_doc_ok)];
+
+  memcpy(text, g_doc_ok, sizeof(g_doc_ok));
+  _Test_set_params(8000, 0, 1);
+  TEST_CHECK_EQ(JSON_Deser_settings(APPLICATION_PARAMS, text), RES_OK);
+  TEST_CHECK_EQ(wvar.pwm_frequency, 12000);
+  TEST_CHECK_EQ(wvar.can_ans_period_ms, 250);
+  TEST_CHECK_EQ(wvar.usb_mode, 3);
+
+  const char *bad_docs[] = {g_doc_range, g_doc_syntax, g_doc_cut};
+  for (uint32_t i = 0; i < sizeof(bad_docs) / sizeof(bad_docs[0]); i++)
+  {
+    char buf[512];
+
+    strcpy(buf, bad_docs[i]);
+    _Test_set_params(8000, 0, 1);
+    TEST_CHECK_EQ(JSON_Deser_settings(APPLICATION_PARAMS, buf), RES_ERROR);
+    TEST_CHECK_EQ(wvar.pwm_frequency, 8000);
+    TEST_CHECK_EQ(wvar.can_ans_period_ms, 0);
+    TEST_CHECK_EQ(wvar.usb_mode, 1);
+
+    // The document tree path is validated the same way
+    strcpy(buf, bad_docs[i]);
+    TEST_CHECK_EQ(JSON_Deser_settings_ex(APPLICATION_PARAMS, buf, strlen(buf), JSON_DESER_TREE), RES_ERROR);
+    TEST_CHECK_EQ(wvar.pwm_frequency, 8000);
+    TEST_CHECK_EQ(wvar.can_ans_period_ms, 0);
+  }
+}
+
+static void _Test_from_file(void)
+{
+  FX_FILE file;
+
+  memset(&file, 0, sizeof(file));
+
+  _Test_file_open(g_doc_ok, 0);
+  _Test_set_params(8000, 0, 1);
+  TEST_CHECK_EQ(JSON_Deser_settings_from_file(APPLICATION_PARAMS, &file), RES_OK);
+  TEST_CHECK_EQ(wvar.pwm_frequency, 12000);
+  TEST_CHECK_EQ(wvar.can_ans_period_ms, 250);
+  TEST_CHECK_EQ(wvar.usb_mode, 3);
+
+  const char *bad_docs[] = {g_doc_range, g_doc_syntax, g_doc_cut};
+  for (uint32_t i = 0; i < sizeof(bad_docs) / sizeof(bad_docs[0]); i++)
+  {
+    _Test_file_open(bad_docs[i], 0);
+    _Test_set_params(8000, 0, 1);
+    TEST_CHECK_EQ(JSON_Deser_settings_from_file(APPLICATION_PARAMS, &file), RES_ERROR);
+    TEST_CHECK_EQ(wvar.pwm_frequency, 8000);
+    TEST_CHECK_EQ(wvar.can_ans_period_ms, 0);
+    TEST_CHECK_EQ(wvar.usb_mode, 1);
+  }
+
+  // The file can not be read in the apply pass: defaults are restored, no old values remain
+  _Test_file_open(g_doc_ok, 2);
+  _Test_set_params(4000, 500, 5);
+  TEST_CHECK_EQ(JSON_Deser_settings_from_file(APPLICATION_PARAMS, &file), RES_ERROR);
+  TEST_CHECK_EQ(wvar.pwm_frequency, 8000);
+  TEST_CHECK_EQ(wvar.can_ans_period_ms, 0);
+  TEST_CHECK_EQ(wvar.usb_mode, 1);
+}
+
+int main(void)
+{
+  _Test_from_memory();
+  _Test_from_file();
+  return Host_test_result("test_json_deser");
+}
@@ -0,0 +1,195 @@
+#include "App.h"
+#include "host_test.h"
+#include <float.h>
+
+// Test of the streaming settings serializer: Serialze_settings_to_mem must write the same bytes as the
+// jansson tree reference Settings_JSON_tree_to_mem for a parameter of every type set to its edge values,
+// with every dump flag the firmware uses, and for the parameters of the firmware. A string that is not
+// valid UTF-8 must be refused by both.
+
+#define TEST_STR_LEN  32u    // varlen of the short string parameter
+#define TEST_LONG_LEN 1100u  // varlen of the string parameter longer than MAX_PARAMETER_STRING_LEN
+
+static uint8_t  g_u8;
+static uint16_t g_u16;
+static uint32_t g_u32;
+static int32_t  g_s32;
+static float    g_flt;
+static float    g_flt_e;
+static uint8_t  g_str[TEST_STR_LEN];
+static uint8_t  g_long[TEST_LONG_LEN];
+static uint8_t  g_bytes[8];
+static double   g_doubles[2];
+
+// clang-format off
+static const T_NV_parameters g_items[] =
+{
+  { (const uint8_t *)"p_u8",     (const uint8_t *)"", (const uint8_t *)"PU8",  &g_u8,      tint8u,       0, 0, 255,      0, 1, NULL, "%u",    NULL, 1,             0, 0 },
+  { (const uint8_t *)"p_u16",    (const uint8_t *)"", (const uint8_t *)"PU16", &g_u16,     tint16u,      0, 0, 65535,    0, 1, NULL, "%u",    NULL, 2,             1, 0 },
+  { (const uint8_t *)"p_u32",    (const uint8_t *)"", (const uint8_t *)"PU32", &g_u32,     tint32u,      0, 0, 4.3e9f,   0, 1, NULL, "%u",    NULL, 4,             2, 0 },
+  { (const uint8_t *)"p_s32",    (const uint8_t *)"", (const uint8_t *)"PS32", &g_s32,     tint32s,      0, -2.2e9f, 2.2e9f, 0, 1, NULL, "%d", NULL, 4,         3, 0 },
+  { (const uint8_t *)"p_float",  (const uint8_t *)"", (const uint8_t *)"PFL",  &g_flt,     tfloat,       0, -FLT_MAX, FLT_MAX, 0, 1, NULL, "%0.3f", NULL, 4,      4, 0 },
+  { (const uint8_t *)"p_float_e",(const uint8_t *)"", (const uint8_t *)"PFE",  &g_flt_e,   tfloat,       0, -FLT_MAX, FLT_MAX, 0, 1, NULL, "%e",  NULL, 4,        5, 0 },
+  { (const uint8_t *)"p_str",    (const uint8_t *)"", (const uint8_t *)"PSTR", g_str,      tstring,      0, 0, 0,        0, 1, NULL, "%s",    NULL, TEST_STR_LEN,  6, 0 },
+  { (const uint8_t *)"p_long",   (const uint8_t *)"", (const uint8_t *)"PLNG", g_long,     tstring,      0, 0, 0,        0, 1, NULL, "%s",    NULL, TEST_LONG_LEN, 7, 0 },
+  { (const uint8_t *)"p_nostr",  (const uint8_t *)"", (const uint8_t *)"PNS",  NULL,       tstring,      0, 0, 0,        0, 1, NULL, "%s",    NULL, 0,             8, 0 },
+  { (const uint8_t *)"p_bytes",  (const uint8_t *)"", (const uint8_t *)"PBY",  g_bytes,    tarrofbyte,   0, 0, 0,        0, 1, NULL, "",      NULL, 8,             9, 0 },
+  { (const uint8_t *)"p_dbls",   (const uint8_t *)"", (const uint8_t *)"PDB",  g_doubles,  tarrofdouble, 0, 0, 0,        0, 1, NULL, "",      NULL, 16,           10, 0 },
+};
+// clang-format on
+
+static const T_NV_parameters_instance g_inst = {sizeof(g_items) / sizeof(g_items[0]), g_items};
+
+// Edge values, the parameters take them in turn
+static const uint8_t  g_u8_vals[]  = {0, 1, 127, 128, 255};
+static const uint16_t g_u16_vals[] = {0, 255, 256, 32768, 65535};
+static const uint32_t g_u32_vals[] = {0, 1, 0x7FFFFFFFu, 0x80000000u, 0xFFFFFFFFu};
+static const int32_t  g_s32_vals[] = {0, -1, 1, INT32_MIN, INT32_MAX};
+static const char    *g_str_vals[] =
+{
+  "",
+  "\"quoted\" \\back\\ /slash/",
+  "\x01\x02\b\f\n\r\t\x1F\x7F",
+  "\xC3\xA9t\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80",  // 2, 3 and 4 byte UTF-8
+  "</script>&'<>",
+  "0123456789ABCDEF0123456789ABCDEF",                  // Fills varlen without the terminating zero
+};
+static const uint32_t g_flags[] =
+{
+  0,
+  JSON_COMPACT,
+  JSON_INDENT(2),
+  JSON_INDENT(4) | JSON_ENSURE_ASCII,
+  JSON_COMPACT | JSON_ENSURE_ASCII,
+  JSON_COMPACT | JSON_ESCAPE_SLASH,
+  JSON_INDENT(31) | JSON_ESCAPE_SLASH | JSON_ENSURE_ASCII,
+};
+
+#define ARR_NUM(a) (sizeof(a) / sizeof((a)[0]))
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: jansson allocates from the application heap, as set by App_memory_pools_creation
+
+  Parameters: size - block size
+
+  Return: Pointer to the block or NULL
+-----------------------------------------------------------------------------------------------------*/
+static void *_Test_json_malloc(size_t size)
+{
+  return App_malloc((uint32_t)size);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Set the short string parameter, a value of TEST_STR_LEN characters has no terminating zero
+
+  Parameters: str - value
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_set_str(const char *str)
+{
+  memset(g_str, 0, TEST_STR_LEN);
+  memcpy(g_str, str, strlen(str));
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Serialize an instance with the streaming writer and with the jansson tree, with every flag
+
+  Parameters: p_pars  - parameters
+              refused - 1 if both must refuse the document
+
+  Return: Number of flag sets with a different result
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Test_compare(const T_NV_parameters_instance *p_pars, uint32_t refused)
+{
+  uint32_t diffs = 0;
+
+  for (uint32_t f = 0; f < ARR_NUM(g_flags); f++)
+  {
+    char    *stream    = NULL;
+    char    *tree      = NULL;
+    uint32_t stream_sz = 0;
+    uint32_t tree_sz   = 0;
+    uint32_t res_s     = Serialze_settings_to_mem(p_pars, &stream, &stream_sz, g_flags[f]);
+    uint32_t res_t     = Settings_JSON_tree_to_mem(p_pars, &tree, &tree_sz, g_flags[f]);
+
+    if (refused != 0)
+    {
+      diffs += (res_s != RES_ERROR) || (res_t != RES_ERROR);
+    }
+    else if ((res_s != RES_OK) || (res_t != RES_OK) || (stream_sz != tree_sz) || (memcmp(stream, tree, tree_sz) != 0) || (stream[stream_sz] != 0))
+    {
+      printf("flags 0x%03X:\n  stream: %s\n  tree:   %s\n", (unsigned)g_flags[f], stream ? stream : "(none)", tree ? tree : "(none)");
+      diffs++;
+    }
+    App_free(stream);
+    App_free(tree);
+  }
+  return diffs;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Parameters of every type at their edge values
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_types(void)
+{
+  const float flt_vals[] = {0.0f, -0.0f, 1.0f / 3.0f, -123456.789f, FLT_MAX, -FLT_MAX, FLT_MIN, 1e-45f, NAN, INFINITY, -INFINITY};
+  uint32_t    diffs      = 0;
+  uint32_t    rounds     = ARR_NUM(flt_vals);
+
+  for (uint32_t r = 0; r < rounds; r++)
+  {
+    g_u8    = g_u8_vals[r % ARR_NUM(g_u8_vals)];
+    g_u16   = g_u16_vals[r % ARR_NUM(g_u16_vals)];
+    g_u32   = g_u32_vals[r % ARR_NUM(g_u32_vals)];
+    g_s32   = g_s32_vals[r % ARR_NUM(g_s32_vals)];
+    g_flt   = flt_vals[r];
+    g_flt_e = flt_vals[rounds - 1 - r];
+    _Test_set_str(g_str_vals[r % ARR_NUM(g_str_vals)]);
+    // Longer than MAX_PARAMETER_STRING_LEN, cut by Convert_parameter_to_str
+    memset(g_long, 'a' + (int)r, TEST_LONG_LEN);
+    diffs += _Test_compare(&g_inst, 0);
+  }
+  TEST_CHECK_EQ(diffs, 0);
+
+  // No parameters
+  {
+    T_NV_parameters_instance empty = {0, g_items};
+
+    TEST_CHECK_EQ(_Test_compare(&empty, 0), 0);
+  }
+
+  // Not valid UTF-8: a lone continuation byte, a cut sequence and an overlong encoding
+  const char *bad_vals[] = {"ab\x80", "\xE2\x82", "\xC0\xAF"};
+  for (uint32_t i = 0; i < ARR_NUM(bad_vals); i++)
+  {
+    _Test_set_str(bad_vals[i]);
+    TEST_CHECK_EQ(_Test_compare(&g_inst, 1), 0);
+  }
+  _Test_set_str("");
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Parameters of the firmware at their default values
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_firmware(void)
+{
+  Host_params_load_defaults(&wvar_inst);
+  TEST_CHECK_EQ(_Test_compare(&wvar_inst, 0), 0);
+}
+
+int main(void)
+{
+  json_set_alloc_funcs(_Test_json_malloc, App_free);
+  _Test_types();
+  _Test_firmware();
+  return Host_test_result("test_json_ser");
+}
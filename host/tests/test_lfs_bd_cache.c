@@ -0,0 +1,170 @@
+#include "App.h"
+#include "littlefs_bd_cache.h"
+
+#include "host_test.h"
+
+// Test of the write-back page cache of the LittleFS block device layer over a RAM device that can fail
+// the programs of one address range: reads of cached bytes must come from the device after the cache
+// was programmed, and a failed program must be reported for its own range, never for an unrelated one.
+
+#define TEST_DEV_SIZE  0x4000u
+#define TEST_PAGE_SIZE 256u
+
+typedef struct
+{
+  uint8_t  mem[TEST_DEV_SIZE];
+  uint32_t reads;
+  uint32_t progs;
+  uint32_t fail_addr;  // Programs that touch [fail_addr, fail_end) fail
+  uint32_t fail_end;
+} T_test_dev;
+
+static T_test_dev g_dev;
+
+static int _Test_dev_read(void *ctx, uint32_t addr, void *buf, uint32_t size)
+{
+  T_test_dev *d = (T_test_dev *)ctx;
+
+  d->reads++;
+  memcpy(buf, &d->mem[addr], size);
+  return 0;
+}
+
+static int _Test_dev_prog(void *ctx, uint32_t addr, const void *buf, uint32_t size)
+{
+  T_test_dev *d = (T_test_dev *)ctx;
+
+  d->progs++;
+  if ((addr < d->fail_end) && (d->fail_addr < addr + size))
+  {
+    return -1;
+  }
+  for (uint32_t i = 0; i < size; i++)
+  {
+    d->mem[addr + i] &= ((const uint8_t *)buf)[i];
+  }
+  return 0;
+}
+
+static int _Test_dev_erase(void *ctx, uint32_t addr, uint32_t size)
+{
+  T_test_dev *d = (T_test_dev *)ctx;
+
+  memset(&d->mem[addr], 0xFF, size);
+  return 0;
+}
+
+static const T_lfs_bd_dev g_test_dev = {_Test_dev_read, _Test_dev_prog, _Test_dev_erase, &g_dev};
+
+static T_lfs_bd_cache g_bd;
+static uint8_t        g_page[TEST_PAGE_SIZE];
+
+static void _Test_reset(uint32_t fail_addr, uint32_t fail_end)
+{
+  memset(&g_dev, 0xFF, sizeof(g_dev.mem));
+  g_dev.reads     = 0;
+  g_dev.progs     = 0;
+  g_dev.fail_addr = fail_addr;
+  g_dev.fail_end  = fail_end;
+  Lfs_bd_init(&g_bd, &g_test_dev, g_page, TEST_PAGE_SIZE);
+}
+
+// Reads of a cached range program the page first and read the device
+static void _Test_read_after_prog(void)
+{
+  uint8_t data[32];
+  uint8_t rd[32];
+
+  for (uint32_t i = 0; i < sizeof(data); i++)
+  {
+    data[i] = (uint8_t)(0xA0 + i);
+  }
+  _Test_reset(0, 0);
+  TEST_CHECK_EQ(Lfs_bd_prog(&g_bd, 0x110, data, 16), 0);
+  TEST_CHECK_EQ(Lfs_bd_prog(&g_bd, 0x120, &data[16], 16), 0);
+  TEST_CHECK_EQ(g_dev.progs, 0);
+  TEST_CHECK_EQ(g_bd.stats.merged, 1);
+
+  // A read elsewhere leaves the cache alone
+  TEST_CHECK_EQ(Lfs_bd_read(&g_bd, 0x200, rd, 16), 0);
+  TEST_CHECK_EQ(g_dev.progs, 0);
+
+  // A read that touches the cached bytes programs them and reads them back from the device
+  TEST_CHECK_EQ(Lfs_bd_read(&g_bd, 0x118, rd, 16), 0);
+  TEST_CHECK_EQ(g_dev.progs, 1);
+  TEST_CHECK_EQ(g_dev.reads, 2);
+  TEST_CHECK_EQ(g_bd.stats.read_flushes, 1);
+  TEST_CHECK(memcmp(rd, &data[8], 16) == 0);
+
+  // Bytes the device did not take are seen by the reader
+  g_dev.mem[0x118] = 0x00;
+  TEST_CHECK_EQ(Lfs_bd_read(&g_bd, 0x118, rd, 1), 0);
+  TEST_CHECK_EQ(rd[0], 0x00);
+}
+
+// The failed program is reported by the read of its range that follows it
+static void _Test_fail_on_read(void)
+{
+  uint8_t data[16] = {0};
+  uint8_t rd[16];
+
+  _Test_reset(0x200, 0x300);
+  TEST_CHECK_EQ(Lfs_bd_prog(&g_bd, 0x200, data, 16), 0);
+  TEST_CHECK(Lfs_bd_read(&g_bd, 0x200, rd, 16) != 0);
+  TEST_CHECK_EQ(g_bd.stats.prog_errors, 1);
+  TEST_CHECK_EQ(Lfs_bd_sync(&g_bd), 0);
+}
+
+// The cache is flushed by a program of another page: that program succeeds, the error waits for its range
+static void _Test_fail_deferred(void)
+{
+  uint8_t data[16] = {0};
+  uint8_t rd[16];
+
+  _Test_reset(0x300, 0x400);
+  TEST_CHECK_EQ(Lfs_bd_prog(&g_bd, 0x300, data, 16), 0);
+  TEST_CHECK_EQ(Lfs_bd_prog(&g_bd, 0x1000, data, 16), 0);
+  TEST_CHECK_EQ(g_bd.stats.prog_errors, 1);
+  TEST_CHECK_EQ(Lfs_bd_read(&g_bd, 0x1000, rd, 16), 0);
+  TEST_CHECK_EQ(Lfs_bd_read(&g_bd, 0x280, rd, 16), 0);
+  TEST_CHECK(Lfs_bd_read(&g_bd, 0x308, rd, 8) != 0);
+  TEST_CHECK_EQ(Lfs_bd_read(&g_bd, 0x308, rd, 8), 0);
+  TEST_CHECK_EQ(Lfs_bd_sync(&g_bd), 0);
+
+  // Not read before the sync: the sync reports it once
+  _Test_reset(0x300, 0x400);
+  TEST_CHECK_EQ(Lfs_bd_prog(&g_bd, 0x300, data, 16), 0);
+  TEST_CHECK_EQ(Lfs_bd_prog(&g_bd, 0x1000, data, 16), 0);
+  TEST_CHECK(Lfs_bd_sync(&g_bd) != 0);
+  TEST_CHECK_EQ(Lfs_bd_sync(&g_bd), 0);
+  TEST_CHECK_EQ(Lfs_bd_read(&g_bd, 0x300, rd, 16), 0);
+
+  // The block is erased before anyone asked: the error is dropped with the data
+  _Test_reset(0x300, 0x400);
+  TEST_CHECK_EQ(Lfs_bd_prog(&g_bd, 0x300, data, 16), 0);
+  TEST_CHECK_EQ(Lfs_bd_prog(&g_bd, 0x1000, data, 16), 0);
+  TEST_CHECK_EQ(Lfs_bd_erase(&g_bd, 0, 0x1000), 0);
+  TEST_CHECK_EQ(Lfs_bd_read(&g_bd, 0x300, rd, 16), 0);
+  TEST_CHECK_EQ(Lfs_bd_sync(&g_bd), 0);
+}
+
+// A program that fills the page fails with its own range
+static void _Test_fail_full_page(void)
+{
+  uint8_t data[TEST_PAGE_SIZE] = {0};
+
+  _Test_reset(0x500, 0x600);
+  TEST_CHECK(Lfs_bd_prog(&g_bd, 0x500, data, TEST_PAGE_SIZE) != 0);
+  TEST_CHECK_EQ(Lfs_bd_prog(&g_bd, 0x600, data, 16), 0);
+  TEST_CHECK(Lfs_bd_prog(&g_bd, 0x510, data, TEST_PAGE_SIZE - 0x10) != 0);
+  TEST_CHECK_EQ(Lfs_bd_sync(&g_bd), 0);
+}
+
+int main(void)
+{
+  _Test_read_after_prog();
+  _Test_fail_on_read();
+  _Test_fail_deferred();
+  _Test_fail_full_page();
+  return Host_test_result("test_lfs_bd_cache");
+}
@@ -0,0 +1,299 @@
+#include "App.h"
+#include "littlefs_erase.h"
+#include "nor_flash_model.h"
+
+#include "host_test.h"
+
+// Test of the background erase engine over the NOR flash model with MX25UM25645G timing. Sectors are
+// erased while reads of other sectors arrive at random times of the model clock. With the engine a read
+// waits at most for the spacing of suspends, the suspend latency and its own transfer; with blocking erases
+// it waits for the rest of the erase. The model counts suspends too early after a resume and accesses the
+// device does not accept during an erase. A read of a sector in the queue waits for its erase and reads
+// erased data, a device that can not suspend makes the read wait for the end of the erase.
+
+#define TEST_SECTOR       4096u
+#define TEST_SECTORS      32u
+#define TEST_ERASES       8u       // Sectors erased by a latency run, reads go to the sectors behind them
+#define TEST_READ_SZ      256u
+#define TEST_PERIOD_US    1000u    // Mean interval between reads
+#define TEST_SEEDS        16u
+
+typedef struct
+{
+  uint32_t reads;
+  uint64_t worst_ns;
+  uint64_t sum_ns;
+  uint64_t total_ns;     // Model time until all erases ended
+  uint64_t read_end_ns;  // End of the previous read
+  uint32_t bad_data;     // Reads that did not return the data of the sector
+} T_test_latency;
+
+static uint8_t         g_mem[TEST_SECTORS * TEST_SECTOR];
+static uint8_t         g_buf[TEST_SECTOR];
+static T_nor_model     g_nor;
+static T_lfs_erase     g_erase;
+static T_lfs_erase_dev g_dev;
+static bool            g_suspend_fails;
+
+static int _Test_suspend(void *ctx)
+{
+  if (g_suspend_fails)
+  {
+    return -1;
+  }
+  return Nor_model_erase_suspend(ctx);
+}
+
+static void _Test_init(void)
+{
+  Nor_model_init(&g_nor, g_mem, sizeof(g_mem), 256, TEST_SECTOR, &g_nor_timing_mx25um);
+  for (uint32_t i = 0; i < sizeof(g_mem); i++)
+  {
+    g_mem[i] = (uint8_t)((i / TEST_SECTOR) * 31 + i);
+  }
+  g_dev.start        = Nor_model_erase_start;
+  g_dev.busy         = Nor_model_erase_busy;
+  g_dev.suspend      = _Test_suspend;
+  g_dev.resume       = Nor_model_erase_resume;
+  g_dev.wait         = Nor_model_wait;
+  g_dev.clock        = Nor_model_clock_us;
+  g_dev.done         = NULL;
+  g_dev.clock_per_us = 1;
+  g_dev.ctx          = &g_nor;
+  g_suspend_fails    = false;
+  Lfs_erase_init(&g_erase, &g_dev);
+}
+
+static bool _Test_sector_has_data(uint32_t addr, const uint8_t *p, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; i++)
+  {
+    if (p[i] != (uint8_t)(((addr + i) / TEST_SECTOR) * 31 + addr + i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool _Test_is_erased(const uint8_t *p, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; i++)
+  {
+    if (p[i] != NOR_MODEL_ERASED_VAL)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Read arriving at arrival_ns of the model time. Its latency starts at the arrival, or at
+               the end of the previous read if it arrived during that read, and ends when the data
+               are read.
+
+  Parameters: async      - read through the engine
+              arrival_ns - arrival time
+              addr       - flash address
+              lat        - result, updated
+
+  Return: 0 on success, error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Test_read(bool async, uint64_t arrival_ns, uint32_t addr, T_test_latency *lat)
+{
+  uint64_t start_ns = (lat->read_end_ns > arrival_ns) ? lat->read_end_ns : arrival_ns;
+  uint64_t lat_ns;
+  int      err      = 0;
+
+  if (async)
+  {
+    err = Lfs_erase_read_begin(&g_erase, addr, TEST_READ_SZ);
+  }
+  if (err == 0)
+  {
+    err = Nor_model_read(&g_nor, addr, g_buf, TEST_READ_SZ);
+  }
+  if (async)
+  {
+    int end_err = Lfs_erase_read_end(&g_erase);
+
+    if (err == 0)
+    {
+      err = end_err;
+    }
+  }
+  lat->bad_data    += !_Test_sector_has_data(addr, g_buf, TEST_READ_SZ);
+  lat->read_end_ns  = g_nor.busy_ns;
+  lat_ns            = g_nor.busy_ns - start_ns;
+  lat->sum_ns      += lat_ns;
+  if (lat_ns > lat->worst_ns)
+  {
+    lat->worst_ns = lat_ns;
+  }
+  lat->reads++;
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Erase TEST_ERASES sectors while reads of the other sectors arrive at random intervals
+
+  Parameters: async - 0 - blocking erases, 1 - erase engine
+              seed  - seed of the read arrivals
+              lat   - result
+
+  Return: 0 on success, error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Test_latency_run(bool async, uint32_t seed, T_test_latency *lat)
+{
+  uint32_t issued  = 0;
+  uint64_t next_ns = 0;
+  int      err     = 0;
+
+  _Test_init();
+  memset(lat, 0, sizeof(*lat));
+  while ((err == 0) && ((issued < TEST_ERASES) || (g_erase.count > 0)))
+  {
+    if (g_nor.busy_ns >= next_ns)
+    {
+      uint32_t addr;
+
+      seed     = seed * 1103515245u + 12345u;
+      addr     = (TEST_ERASES + (seed >> 16) % (TEST_SECTORS - TEST_ERASES)) * TEST_SECTOR + ((seed >> 8) % 16) * TEST_READ_SZ;
+      err      = _Test_read(async, next_ns, addr, lat);
+      seed     = seed * 1103515245u + 12345u;
+      next_ns += 1000ull * (10 + (seed >> 16) % (2 * TEST_PERIOD_US - 19));
+    }
+    else if (!async)
+    {
+      err = Nor_model_erase(&g_nor, issued * TEST_SECTOR, TEST_SECTOR);
+      issued++;
+    }
+    else if ((issued < TEST_ERASES) && (g_erase.count < LFS_ERASE_QUEUE_LEN))
+    {
+      err = Lfs_erase_queue(&g_erase, issued * TEST_SECTOR, TEST_SECTOR);
+      issued++;
+    }
+    else
+    {
+      // Idle until the next read or the next status poll
+      err = Lfs_erase_poll(&g_erase);
+      if (next_ns - g_nor.busy_ns < g_nor.timing.wait_ns)
+      {
+        g_nor.busy_ns = next_ns;
+      }
+      else
+      {
+        Nor_model_wait(&g_nor);
+      }
+    }
+  }
+  lat->total_ns = g_nor.busy_ns;
+  return err;
+}
+
+// Read latency with blocking erases and with the engine, several random arrival patterns
+static void _Test_latency(void)
+{
+  const T_nor_timing *t            = &g_nor_timing_mx25um;
+  uint64_t            read_ns      = t->read_cmd_ns + (uint64_t)t->read_byte_ns * TEST_READ_SZ;
+  uint64_t            bound_ns     = (uint64_t)LFS_ERASE_MIN_RUN_US * 1000 + t->suspend_ns + read_ns + 4 * t->status_ns + 2 * t->wait_ns;
+  uint64_t            sync_worst   = 0;
+  uint64_t            async_worst  = 0;
+  uint64_t            async_sum    = 0;
+  uint32_t            async_reads  = 0;
+
+  for (uint32_t s = 0; s < TEST_SEEDS; s++)
+  {
+    T_test_latency sync;
+    T_test_latency async;
+
+    TEST_CHECK_EQ(_Test_latency_run(false, 1000 + s, &sync), 0);
+    TEST_CHECK_EQ(g_nor.violations, 0);
+    TEST_CHECK_EQ(sync.bad_data, 0);
+    TEST_CHECK(_Test_is_erased(g_mem, TEST_ERASES * TEST_SECTOR));
+
+    TEST_CHECK_EQ(_Test_latency_run(true, 1000 + s, &async), 0);
+    TEST_CHECK_EQ(g_nor.violations, 0);
+    TEST_CHECK_EQ(async.bad_data, 0);
+    TEST_CHECK(_Test_is_erased(g_mem, TEST_ERASES * TEST_SECTOR));
+    TEST_CHECK_EQ(g_erase.stats.done, TEST_ERASES);
+    TEST_CHECK_EQ(g_erase.stats.read_waits, 0);
+    TEST_CHECK(g_erase.stats.suspends > 0);
+    TEST_CHECK(_Test_sector_has_data(TEST_ERASES * TEST_SECTOR, &g_mem[TEST_ERASES * TEST_SECTOR], (TEST_SECTORS - TEST_ERASES) * TEST_SECTOR));
+
+    // Every read waits less than the spacing of suspends plus the suspend latency, the erases still end
+    TEST_CHECK(async.worst_ns <= bound_ns);
+    TEST_CHECK(async.total_ns >= (uint64_t)TEST_ERASES * t->erase_ns);
+    TEST_CHECK(async.total_ns <= 2 * (uint64_t)TEST_ERASES * t->erase_ns);
+    TEST_CHECK(sync.worst_ns > (uint64_t)t->erase_ns / 2);
+
+    sync_worst   = (sync.worst_ns > sync_worst) ? sync.worst_ns : sync_worst;
+    async_worst  = (async.worst_ns > async_worst) ? async.worst_ns : async_worst;
+    async_sum   += async.sum_ns;
+    async_reads += async.reads;
+  }
+  printf("read latency during erase: blocking worst %llu us, background worst %llu us avg %llu us (bound %llu us)\n",
+         (unsigned long long)(sync_worst / 1000), (unsigned long long)(async_worst / 1000),
+         (unsigned long long)(async_sum / async_reads / 1000), (unsigned long long)(bound_ns / 1000));
+}
+
+// A read of a sector in the queue waits for its erase and reads erased data
+static void _Test_read_of_queued_sector(void)
+{
+  _Test_init();
+  TEST_CHECK_EQ(Lfs_erase_queue(&g_erase, 0, TEST_SECTOR), 0);
+  TEST_CHECK_EQ(Lfs_erase_queue(&g_erase, 2 * TEST_SECTOR, TEST_SECTOR), 0);
+  TEST_CHECK_EQ(g_erase.count, 2);
+  TEST_CHECK_EQ(Lfs_erase_read_begin(&g_erase, 2 * TEST_SECTOR + 100, 16), 0);
+  TEST_CHECK_EQ(g_erase.stats.read_waits, 1);
+  TEST_CHECK_EQ(g_erase.count, 0);
+  TEST_CHECK_EQ(Nor_model_read(&g_nor, 2 * TEST_SECTOR + 100, g_buf, 16), 0);
+  TEST_CHECK(_Test_is_erased(g_buf, 16));
+  TEST_CHECK_EQ(Lfs_erase_read_end(&g_erase), 0);
+  TEST_CHECK(g_nor.busy_ns >= 2ull * g_nor_timing_mx25um.erase_ns);
+  TEST_CHECK(_Test_sector_has_data(TEST_SECTOR, &g_mem[TEST_SECTOR], TEST_SECTOR));
+  TEST_CHECK_EQ(g_nor.violations, 0);
+}
+
+// A full queue waits for the oldest erase, a sync waits for all of them
+static void _Test_queue_full(void)
+{
+  _Test_init();
+  for (uint32_t i = 0; i < LFS_ERASE_QUEUE_LEN; i++)
+  {
+    TEST_CHECK_EQ(Lfs_erase_queue(&g_erase, i * TEST_SECTOR, TEST_SECTOR), 0);
+  }
+  TEST_CHECK(g_nor.busy_ns < g_nor_timing_mx25um.erase_ns);
+  TEST_CHECK_EQ(Lfs_erase_queue(&g_erase, LFS_ERASE_QUEUE_LEN * TEST_SECTOR, TEST_SECTOR), 0);
+  TEST_CHECK_EQ(g_erase.stats.done, 1);
+  TEST_CHECK_EQ(g_erase.count, LFS_ERASE_QUEUE_LEN);
+  TEST_CHECK_EQ(Lfs_erase_sync(&g_erase), 0);
+  TEST_CHECK_EQ(g_erase.stats.done, LFS_ERASE_QUEUE_LEN + 1);
+  TEST_CHECK(_Test_is_erased(g_mem, (LFS_ERASE_QUEUE_LEN + 1) * TEST_SECTOR));
+  TEST_CHECK_EQ(g_nor.violations, 0);
+}
+
+// A device that does not suspend: the error is reported and the read waits for the end of the erase
+static void _Test_suspend_fails(void)
+{
+  _Test_init();
+  g_suspend_fails = true;
+  TEST_CHECK_EQ(Lfs_erase_queue(&g_erase, 0, TEST_SECTOR), 0);
+  TEST_CHECK(Lfs_erase_read_begin(&g_erase, 8 * TEST_SECTOR, TEST_READ_SZ) != 0);
+  TEST_CHECK_EQ(g_erase.count, 0);
+  TEST_CHECK_EQ(Nor_model_read(&g_nor, 8 * TEST_SECTOR, g_buf, TEST_READ_SZ), 0);
+  TEST_CHECK(_Test_sector_has_data(8 * TEST_SECTOR, g_buf, TEST_READ_SZ));
+  TEST_CHECK_EQ(Lfs_erase_read_end(&g_erase), 0);
+  TEST_CHECK(g_nor.busy_ns >= g_nor_timing_mx25um.erase_ns);
+  TEST_CHECK_EQ(g_nor.violations, 0);
+}
+
+int main(void)
+{
+  _Test_latency();
+  _Test_read_of_queued_sector();
+  _Test_queue_full();
+  _Test_suspend_fails();
+  return Host_test_result("test_lfs_erase");
+}
@@ -0,0 +1,578 @@
+#include "App.h"
+#include "littlefs_adapter.h"
+#include "littlefs_erase.h"
+#include "nor_flash_model.h"
+
+#include "host_test.h"
+
+// LittleFS power loss test over the NOR flash model. Every cycle mounts the image left by the previous
+// cycle, checks that each file holds either its last committed version or the version written when the power
+// was cut, then runs random rewrites and removes until the model cuts the power during a program or erase.
+// The test runs twice: with blocking erases and without timing, and with the background erase engine and
+// MX25UM25645G timing. In the second run an erase progresses while LittleFS reads and programs, so the cut
+// lands anywhere in the erase and leaves a half erased sector behind.
+
+#define LFS_PL_BLOCK_COUNT    32    // Model size is LFS_PL_BLOCK_COUNT * LITTLEFS_BLOCK_SIZE
+#define LFS_PL_FILES          8
+#define LFS_PL_MAX_FILE_SZ    1536
+#define LFS_PL_OPS_PER_CYCLE  16    // File operations of a cycle without a power cut
+#define LFS_PL_CUT_OPS        256   // The power is cut at a random program or erase operation in 1..LFS_PL_CUT_OPS
+#define LFS_PL_BLOCK_CYCLES   64    // Low to make LittleFS relocate blocks during the test
+#define LFS_PL_CYCLES         2000  // Default number of cycles of a run
+#define LFS_PL_NO_VERSION  0xFFFFFFFFu  // No operation of the file was cut
+#define LFS_PL_EMPTY       0xFFFFFFFEu  // Empty file: LittleFS commits a new file at open, its data at close
+#define LFS_PL_HEADER_SZ   8            // File starts with the file number and the version
+
+typedef struct
+{
+  uint32_t cycles;
+  uint32_t power_cuts;       // Cycles ended by a power cut
+  uint32_t erase_cuts;       // Power cuts during a background erase
+  uint32_t mounts;           // Successful mounts of the image left by the previous cycle
+  uint32_t mount_failures;   // The image is formatted again after a failed mount
+  uint32_t verify_failures;  // Files found in a state that was never written
+  uint32_t op_errors;        // File operations that failed without a power cut
+  uint32_t ops;              // File operations completed
+  uint32_t erase_min;        // Erase count of the least and the most erased sector
+  uint32_t erase_max;
+  uint32_t erase_avg;
+} T_lfs_pl_report;
+
+typedef struct
+{
+  lfs_t             lfs;
+  struct lfs_config cfg;
+  T_lfs_bd_dev      dev;
+  T_lfs_bd_cache    bd;
+  T_nor_model       nor;
+  T_lfs_erase_dev   erase_dev;
+  T_lfs_erase       erase;
+  bool              background;               // Erases run in the background erase engine
+  uint32_t          rng;
+  uint32_t          next_version;
+  uint32_t          committed[LFS_PL_FILES];  // Version on the flash, 0 - no file, LFS_PL_EMPTY - empty file
+  uint32_t          pending[LFS_PL_FILES];    // Version of the operation cut by the power, 0 - remove
+  uint32_t          wear[LFS_PL_BLOCK_COUNT];
+  uint8_t           read_buffer[LITTLEFS_CACHE_SIZE];
+  uint8_t           prog_buffer[LITTLEFS_CACHE_SIZE];
+  uint8_t           lookahead_buffer[LITTLEFS_LOOKAHEAD_SIZE];
+  uint8_t           page[LITTLEFS_PAGE_SIZE];
+  uint8_t           io[LFS_PL_MAX_FILE_SZ];
+} T_lfs_pl_ctx;
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Next value of the xorshift generator of the workload
+
+  Parameters: p - test context
+
+  Return: pseudo random value
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Test_rand(T_lfs_pl_ctx *p)
+{
+  p->rng ^= p->rng << 13;
+  p->rng ^= p->rng >> 17;
+  p->rng ^= p->rng << 5;
+  return p->rng;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Size of a file version, the header included
+
+  Parameters: version - file version
+
+  Return: size in bytes
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Test_file_size(uint32_t version)
+{
+  return LFS_PL_HEADER_SZ + ((version * 2654435761u) >> 8) % (LFS_PL_MAX_FILE_SZ - LFS_PL_HEADER_SZ + 1);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Fill the buffer with the content of a file version
+
+  Parameters: p       - test context
+              id      - file number
+              version - file version
+
+  Return: size of the content
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Test_file_content(T_lfs_pl_ctx *p, uint32_t id, uint32_t version)
+{
+  uint32_t size = _Test_file_size(version);
+
+  memcpy(&p->io[0], &id, 4);
+  memcpy(&p->io[4], &version, 4);
+  for (uint32_t i = LFS_PL_HEADER_SZ; i < size; i++)
+  {
+    p->io[i] = (uint8_t)(id * 131u + version * 17u + i);
+  }
+  return size;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Name of a file
+
+  Parameters: name - buffer of at least 16 bytes
+              id   - file number
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_name(char *name, uint32_t id)
+{
+  snprintf(name, 16, "/f%u.bin", (unsigned int)id);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Read the version of a file found on the flash and check its content
+
+  Parameters: p         - test context
+              id        - file number
+              p_version - found version, 0 - no file, LFS_PL_EMPTY - empty file
+
+  Return: 0 if the file is absent, empty or holds a complete version, LFS_ERR_CORRUPT or LittleFS error otherwise
+-----------------------------------------------------------------------------------------------------*/
+static int _Test_read_file(T_lfs_pl_ctx *p, uint32_t id, uint32_t *p_version)
+{
+  lfs_file_t  file;
+  char        name[16];
+  uint8_t     head[LFS_PL_HEADER_SZ];
+  uint32_t    file_id;
+  uint32_t    size;
+  lfs_ssize_t rd;
+  int         err;
+
+  *p_version = 0;
+  _Test_name(name, id);
+  err = lfs_file_open(&p->lfs, &file, name, LFS_O_RDONLY);
+  if (err == LFS_ERR_NOENT)
+  {
+    return 0;
+  }
+  if (err < 0)
+  {
+    return err;
+  }
+
+  rd = lfs_file_read(&p->lfs, &file, head, LFS_PL_HEADER_SZ);
+  if (rd == 0)
+  {
+    *p_version = LFS_PL_EMPTY;
+    err        = 0;
+  }
+  else if (rd == LFS_PL_HEADER_SZ)
+  {
+    memcpy(&file_id, &head[0], 4);
+    memcpy(p_version, &head[4], 4);
+    size = _Test_file_content(p, id, *p_version);
+    err  = LFS_ERR_CORRUPT;
+    if ((file_id == id) && (lfs_file_size(&p->lfs, &file) == (lfs_soff_t)size))
+    {
+      // The expected content is in io, the file is compared by chunks of the header size
+      err = 0;
+      for (uint32_t pos = LFS_PL_HEADER_SZ; (pos < size) && (err == 0); pos += rd)
+      {
+        uint32_t n = size - pos;
+        if (n > LFS_PL_HEADER_SZ)
+        {
+          n = LFS_PL_HEADER_SZ;
+        }
+        rd = lfs_file_read(&p->lfs, &file, head, n);
+        if ((rd != (lfs_ssize_t)n) || (memcmp(head, &p->io[pos], n) != 0))
+        {
+          err = (rd < 0) ? (int)rd : LFS_ERR_CORRUPT;
+        }
+      }
+    }
+  }
+  else
+  {
+    err = (rd < 0) ? (int)rd : LFS_ERR_CORRUPT;
+  }
+  lfs_file_close(&p->lfs, &file);
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Check all files after a mount. A file must hold its committed version or, if an
+               operation of the file was cut by the power, the version of that operation. A file that
+               had no data can also be found empty. The found version becomes the committed one.
+
+  Parameters: p   - test context
+              rep - report
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_verify(T_lfs_pl_ctx *p, T_lfs_pl_report *rep)
+{
+  uint32_t version;
+
+  for (uint32_t id = 0; id < LFS_PL_FILES; id++)
+  {
+    if ((_Test_read_file(p, id, &version) != 0) ||
+        ((version != p->committed[id]) && (version != p->pending[id]) &&
+         !((version == LFS_PL_EMPTY) && (p->committed[id] == 0))))
+    {
+      rep->verify_failures++;
+    }
+    p->committed[id] = version;
+    p->pending[id]   = LFS_PL_NO_VERSION;
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Write a new version of a file or remove it
+
+  Parameters: p       - test context
+              id      - file number
+              version - new version, 0 - remove the file
+
+  Return: 0 on success, LittleFS error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Test_file_op(T_lfs_pl_ctx *p, uint32_t id, uint32_t version)
+{
+  lfs_file_t  file;
+  char        name[16];
+  uint32_t    size;
+  lfs_ssize_t wr;
+  int         err;
+
+  _Test_name(name, id);
+  if (version == 0)
+  {
+    return lfs_remove(&p->lfs, name);
+  }
+
+  size = _Test_file_content(p, id, version);
+  err  = lfs_file_open(&p->lfs, &file, name, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
+  if (err < 0)
+  {
+    return err;
+  }
+  wr  = lfs_file_write(&p->lfs, &file, p->io, size);
+  err = lfs_file_close(&p->lfs, &file);
+  if (wr != (lfs_ssize_t)size)
+  {
+    return (wr < 0) ? (int)wr : LFS_ERR_IO;
+  }
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Format the image and forget all files
+
+  Parameters: p - test context
+
+  Return: 0 on success, LittleFS error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Test_format(T_lfs_pl_ctx *p)
+{
+  for (uint32_t id = 0; id < LFS_PL_FILES; id++)
+  {
+    p->committed[id] = 0;
+    p->pending[id]   = LFS_PL_NO_VERSION;
+  }
+  return lfs_format(&p->lfs, &p->cfg);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Calculate the erase counts of the report from the wear table of the model
+
+  Parameters: p   - test context
+              rep - report
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_wear(T_lfs_pl_ctx *p, T_lfs_pl_report *rep)
+{
+  uint64_t sum = 0;
+
+  rep->erase_min = UINT32_MAX;
+  rep->erase_max = 0;
+  for (uint32_t i = 0; i < LFS_PL_BLOCK_COUNT; i++)
+  {
+    sum += p->wear[i];
+    if (p->wear[i] < rep->erase_min)
+    {
+      rep->erase_min = p->wear[i];
+    }
+    if (p->wear[i] > rep->erase_max)
+    {
+      rep->erase_max = p->wear[i];
+    }
+  }
+  rep->erase_avg = (uint32_t)(sum / LFS_PL_BLOCK_COUNT);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Read for the block device layer when erases run in the background. A running erase is
+               suspended for the read, as Littlefs_flash_read_begin does on the target.
+
+  Parameters: ctx  - test context
+              addr - flash address
+              buf  - destination
+              size - number of bytes
+
+  Return: 0 on success, -1 on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Test_bg_read(void *ctx, uint32_t addr, void *buf, uint32_t size)
+{
+  T_lfs_pl_ctx *p = (T_lfs_pl_ctx *)ctx;
+  int           err;
+
+  if (Lfs_erase_read_begin(&p->erase, addr, size) != 0)
+  {
+    return -1;
+  }
+  err = Nor_model_read(&p->nor, addr, buf, size);
+  if (Lfs_erase_read_end(&p->erase) != 0)
+  {
+    err = -1;
+  }
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Program for the block device layer, the flash does not program while an erase runs
+
+  Parameters: ctx  - test context
+              addr - flash address
+              buf  - source data
+              size - number of bytes
+
+  Return: 0 on success, -1 on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Test_bg_prog(void *ctx, uint32_t addr, const void *buf, uint32_t size)
+{
+  T_lfs_pl_ctx *p = (T_lfs_pl_ctx *)ctx;
+
+  if (Lfs_erase_sync(&p->erase) != 0)
+  {
+    return -1;
+  }
+  return Nor_model_prog(&p->nor, addr, buf, size);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Erase for the block device layer, the erase is queued and runs in the background
+
+  Parameters: ctx  - test context
+              addr - flash address of the block
+              size - block size
+
+  Return: 0 on success, -1 on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Test_bg_erase(void *ctx, uint32_t addr, uint32_t size)
+{
+  return (Lfs_erase_queue(&((T_lfs_pl_ctx *)ctx)->erase, addr, size) != 0) ? -1 : 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Start the block device layer and the erase engine, as after a power on
+
+  Parameters: p - test context
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_bd_init(T_lfs_pl_ctx *p)
+{
+  if (p->background)
+  {
+    Lfs_erase_init(&p->erase, &p->erase_dev);
+  }
+  Lfs_bd_init(&p->bd, &p->dev, p->page, LITTLEFS_BD_PAGE_SIZE);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Run the power loss test
+
+  Parameters: cycles     - number of mount, verify and write cycles
+              seed       - seed of the workload and of the power cut positions, not 0
+              background - erases run in the background erase engine over a model with timing
+              rep        - report
+
+  Return: 0 if every mount succeeded and every file was intact, LFS_ERR_CORRUPT if not,
+          other LittleFS error code if the test could not run
+-----------------------------------------------------------------------------------------------------*/
+static int _Test_powerloss_run(uint32_t cycles, uint32_t seed, bool background, T_lfs_pl_report *rep)
+{
+  static T_lfs_pl_ctx ctx;
+  static uint8_t      mem[LFS_PL_BLOCK_COUNT * LITTLEFS_BLOCK_SIZE];
+  T_lfs_pl_ctx       *p = &ctx;
+  uint32_t            id;
+  int                 err;
+
+  memset(rep, 0, sizeof(*rep));
+  memset(p, 0, sizeof(*p));
+  p->rng          = (seed != 0) ? seed : 1;
+  p->next_version = 1;
+  p->background   = background;
+
+  // Device time matters only when erases run in the background, it decides where the cut lands
+  Nor_model_init(&p->nor, mem, sizeof(mem), LITTLEFS_PAGE_SIZE, LITTLEFS_BLOCK_SIZE, background ? &g_nor_timing_mx25um : NULL);
+  Nor_model_set_wear(&p->nor, p->wear);
+  p->nor.rng = p->rng;
+  if (background)
+  {
+    p->dev.read               = _Test_bg_read;
+    p->dev.prog               = _Test_bg_prog;
+    p->dev.erase              = _Test_bg_erase;
+    p->dev.ctx                = p;
+    p->erase_dev.start        = Nor_model_erase_start;
+    p->erase_dev.busy         = Nor_model_erase_busy;
+    p->erase_dev.suspend      = Nor_model_erase_suspend;
+    p->erase_dev.resume       = Nor_model_erase_resume;
+    p->erase_dev.wait         = Nor_model_wait;
+    p->erase_dev.clock        = Nor_model_clock_us;
+    p->erase_dev.clock_per_us = 1;
+    p->erase_dev.ctx          = &p->nor;
+  }
+  else
+  {
+    p->dev.read  = Nor_model_read;
+    p->dev.prog  = Nor_model_prog;
+    p->dev.erase = Nor_model_erase;
+    p->dev.ctx   = &p->nor;
+  }
+  _Test_bd_init(p);
+
+  p->cfg.context          = &p->bd;
+  p->cfg.read             = _lfs_read;
+  p->cfg.prog             = _lfs_prog;
+  p->cfg.erase            = _lfs_erase;
+  p->cfg.sync             = _lfs_sync;
+  p->cfg.read_size        = LITTLEFS_READ_SIZE;
+  p->cfg.prog_size        = LITTLEFS_PROG_SIZE;
+  p->cfg.block_size       = LITTLEFS_BLOCK_SIZE;
+  p->cfg.block_count      = LFS_PL_BLOCK_COUNT;
+  p->cfg.cache_size       = LITTLEFS_CACHE_SIZE;
+  p->cfg.lookahead_size   = LITTLEFS_LOOKAHEAD_SIZE;
+  p->cfg.block_cycles     = LFS_PL_BLOCK_CYCLES;
+  p->cfg.read_buffer      = p->read_buffer;
+  p->cfg.prog_buffer      = p->prog_buffer;
+  p->cfg.lookahead_buffer = p->lookahead_buffer;
+
+  err = _Test_format(p);
+  for (uint32_t c = 0; (c < cycles) && (err == 0); c++)
+  {
+    rep->cycles++;
+    if (lfs_mount(&p->lfs, &p->cfg) == 0)
+    {
+      rep->mounts++;
+      _Test_verify(p, rep);
+    }
+    else
+    {
+      rep->mount_failures++;
+      err = _Test_format(p);
+      if (err == 0)
+      {
+        err = lfs_mount(&p->lfs, &p->cfg);
+      }
+      if (err != 0)
+      {
+        break;
+      }
+    }
+
+    Nor_model_cut_power(&p->nor, 1 + _Test_rand(p) % LFS_PL_CUT_OPS);
+    for (uint32_t n = 0; n < LFS_PL_OPS_PER_CYCLE; n++)
+    {
+      id = _Test_rand(p) % LFS_PL_FILES;
+      if ((p->committed[id] != 0) && ((_Test_rand(p) % 4) == 0))
+      {
+        p->pending[id] = 0;
+      }
+      else
+      {
+        p->pending[id] = p->next_version++;
+      }
+
+      int op_err = _Test_file_op(p, id, p->pending[id]);
+      if (p->nor.power_off)
+      {
+        break;
+      }
+      if (op_err == 0)
+      {
+        p->committed[id] = p->pending[id];
+        rep->ops++;
+      }
+      else
+      {
+        rep->op_errors++;
+      }
+      p->pending[id] = LFS_PL_NO_VERSION;
+    }
+
+    // Erases still in the queue run to their end, the power can be cut during them
+    if (p->background && !p->nor.power_off && (Lfs_erase_sync(&p->erase) != 0) && !p->nor.power_off)
+    {
+      rep->op_errors++;
+    }
+
+    if (p->nor.power_off)
+    {
+      // RAM state of LittleFS, of the page cache and of the erase queue is lost with the power
+      rep->power_cuts++;
+      rep->erase_cuts += p->nor.erase_cut;
+      Nor_model_power_on(&p->nor);
+      _Test_bd_init(p);
+    }
+    else
+    {
+      Nor_model_cut_power(&p->nor, 0);
+      lfs_unmount(&p->lfs);
+    }
+  }
+
+  _Test_wear(p, rep);
+  if ((err == 0) && ((rep->mount_failures != 0) || (rep->verify_failures != 0)))
+  {
+    err = LFS_ERR_CORRUPT;
+  }
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Run the test in one erase mode and check the report
+
+  Parameters: cycles     - number of cycles
+              background - erases run in the background erase engine
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_mode(uint32_t cycles, bool background)
+{
+  T_lfs_pl_report rep;
+  int             err;
+
+  err = _Test_powerloss_run(cycles, background ? 0x9E3779B9u : 0x2545F491u, background, &rep);
+  printf("%s erases: %u cycles, %u power cuts (%u during a background erase), %u mounts, %u failed\n", background ? "Background" : "Blocking",
+         rep.cycles, rep.power_cuts, rep.erase_cuts, rep.mounts, rep.mount_failures);
+  printf("  %u file operations, %u failed without power cut, %u damaged files, sector erases min %u max %u avg %u\n", rep.ops, rep.op_errors,
+         rep.verify_failures, rep.erase_min, rep.erase_max, rep.erase_avg);
+  TEST_CHECK_EQ(err, 0);
+  TEST_CHECK_EQ(rep.cycles, cycles);
+  TEST_CHECK_EQ(rep.mount_failures, 0);
+  TEST_CHECK_EQ(rep.verify_failures, 0);
+  TEST_CHECK_EQ(rep.op_errors, 0);
+  TEST_CHECK(rep.power_cuts > 0);
+  TEST_CHECK(rep.ops > 0);
+  if (background)
+  {
+    TEST_CHECK(rep.erase_cuts > 0);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t cycles = LFS_PL_CYCLES;
+
+  if (argc > 1)
+  {
+    cycles = (uint32_t)strtoul(argv[1], NULL, 10);
+  }
+  _Test_mode(cycles, false);
+  _Test_mode(cycles, true);
+  return Host_test_result("test_lfs_powerloss");
+}
@@ -0,0 +1,93 @@
+#include "App.h"
+#include "host_test.h"
+
+// Test of emergency stops from an interrupt with a full motor command queue. Motor_emergency_stop_from_isr
+// brakes the motor and puts it into the stopped state at once, but its follow-up command does not fit the
+// queue, so the start commands queued before it are still there. The motor must be marked for
+// Motor_emergency_stop_cleanup, which must drop exactly the queued commands of the marked motors once,
+// although the motor already looks stopped.
+
+extern TX_QUEUE g_motor_command_queue;  // Created by the motor task on the target
+
+static T_motor_command g_queue_buf[MOTOR_COMMAND_QUEUE_SIZE];
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Number of queued commands of one motor
+
+  Parameters: motor_num - motor number (1-4)
+
+  Return: Number of commands
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Test_queued(uint8_t motor_num)
+{
+  T_motor_command cmd;
+  T_motor_command kept[MOTOR_COMMAND_QUEUE_SIZE];
+  uint32_t        n     = 0;
+  uint32_t        found = 0;
+
+  while (tx_queue_receive(&g_motor_command_queue, &cmd, TX_NO_WAIT) == TX_SUCCESS)
+  {
+    found += (cmd.motor_num == motor_num);
+    kept[n++] = cmd;
+  }
+  for (uint32_t i = 0; i < n; i++)
+  {
+    tx_queue_send(&g_motor_command_queue, &kept[i], TX_NO_WAIT);
+  }
+  return found;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Put a motor into the running state as the soft start leaves it
+
+  Parameters: motor_num - motor number (1-4)
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_run_motor(uint8_t motor_num)
+{
+  T_motor_extended_state *st = Motor_get_extended_state(motor_num);
+
+  st->enabled          = 1;
+  st->direction        = MOTOR_DIRECTION_FORWARD;
+  st->pwm_level        = 50;
+  st->soft_start_state = MOTOR_STATE_RUNNING;
+}
+
+int main(void)
+{
+  T_motor_extended_state *st;
+
+  tx_queue_create(&g_motor_command_queue, (CHAR *)"MotorCmdQ", sizeof(T_motor_command) / sizeof(ULONG), g_queue_buf, sizeof(g_queue_buf));
+
+  // Queue with room: the command does the cleanup, nothing is marked
+  _Test_run_motor(MOTOR_1_);
+  TEST_CHECK_EQ(Motor_emergency_stop_from_isr(MOTOR_1_), 0);
+  TEST_CHECK_EQ(Motor_emergency_stop_cleanup(), 0);
+  TEST_CHECK_EQ(_Test_queued(MOTOR_1_), 1);
+  Motor_emergency_stop_direct(MOTOR_1_);
+  TEST_CHECK_EQ(_Test_queued(MOTOR_1_), 0);
+
+  // Full queue of start commands of motors 1 and 3, stops of both from the ISR
+  _Test_run_motor(MOTOR_1_);
+  _Test_run_motor(MOTOR_3_);
+  for (uint32_t i = 0; i < MOTOR_COMMAND_QUEUE_SIZE; i++)
+  {
+    uint8_t motor_num = (i % 4 == 0) ? MOTOR_3_ : ((i % 4 == 1) ? MOTOR_2_ : MOTOR_1_);
+
+    TEST_CHECK_EQ(Motor_command_soft_start(motor_num, 80, MOTOR_DIRECTION_FORWARD), TX_SUCCESS);
+  }
+  TEST_CHECK_EQ(Motor_emergency_stop_from_isr(MOTOR_1_), 2);
+  TEST_CHECK_EQ(Motor_emergency_stop_from_isr(MOTOR_3_), 2);
+  st = Motor_get_extended_state(MOTOR_1_);
+  TEST_CHECK(st->enabled == 0 && st->direction == MOTOR_DIRECTION_STOP && st->soft_start_state == MOTOR_STATE_IDLE);
+  TEST_CHECK_EQ(_Test_queued(MOTOR_1_), MOTOR_COMMAND_QUEUE_SIZE / 2);
+
+  // The task finishes both stops once, the commands of motor 2 stay
+  TEST_CHECK_EQ(Motor_emergency_stop_cleanup(), (1u << (MOTOR_1_ - 1)) | (1u << (MOTOR_3_ - 1)));
+  TEST_CHECK_EQ(_Test_queued(MOTOR_1_), 0);
+  TEST_CHECK_EQ(_Test_queued(MOTOR_3_), 0);
+  TEST_CHECK_EQ(_Test_queued(MOTOR_2_), MOTOR_COMMAND_QUEUE_SIZE / 4);
+  TEST_CHECK_EQ(Motor_emergency_stop_cleanup(), 0);
+  return Host_test_result("test_motor_estop");
+}
@@ -0,0 +1,156 @@
+#include "App.h"
+#include "host_test.h"
+
+// Test of the fixed-point S-curve ramp against the float curve start + delta * (3τ² − 2τ³), τ = k / N.
+// Ramps of 10 s and longer at the 16 kHz PWM rate have more than 2^16 updates, with them a phase
+// increment rounded up passes 2^32 before the last update and the level falls back to the start.
+// The phase must be exactly floor(k * 2^32 / N) after every update, the level must stay within the
+// table resolution of the reference, rise or fall monotonically and end exactly at the end level.
+
+#define TEST_PWM_HZ 16000u
+
+typedef struct
+{
+  uint16_t from_x100;
+  uint16_t to_x100;
+  uint32_t duration_ms;
+  uint32_t update_hz;
+} T_test_ramp;
+
+static const T_test_ramp g_ramps[] = {
+  {0, 10000, 10000, TEST_PWM_HZ},
+  {10000, 0, 10000, TEST_PWM_HZ},
+  {0, 10000, 60000, TEST_PWM_HZ},
+  {2500, 9000, 300000, TEST_PWM_HZ},
+  {9000, 100, 65000, TEST_PWM_HZ},
+  {0, 10000, 10000, 15999},
+  {0, 10000, 4096, TEST_PWM_HZ},  // Exactly 2^16 updates
+  {0, 5000, 2000, 1000},
+  {100, 200, 1, 1000},
+  {100, 200, 0, 1000},
+};
+
+static double _Test_s_curve(double t)
+{
+  return 3.0 * t * t - 2.0 * t * t * t;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Run a ramp to its end and compare every update with the float reference
+
+  Parameters: p - ramp parameters
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_ramp(const T_test_ramp *p)
+{
+  T_motor_ramp ramp;
+  uint64_t     n     = ((uint64_t)p->duration_ms * p->update_hz) / 1000u;
+  int32_t      delta = (int32_t)p->to_x100 - (int32_t)p->from_x100;
+  double       tol   = 1.0 + fabs((double)delta) / 16384.0;
+  double       max_err = 0;
+  uint32_t     phase_errors = 0;
+  uint32_t     level_errors = 0;
+  uint32_t     order_errors = 0;
+  uint16_t     prev  = p->from_x100;
+  uint16_t     level = 0;
+  uint64_t     k;
+  bool         done  = false;
+
+  if (n == 0)
+  {
+    n = 1;
+  }
+  Motor_ramp_s_curve_begin(&ramp, p->from_x100, p->to_x100, p->duration_ms, p->update_hz);
+  for (k = 1; (k <= n) && !done; k++)
+  {
+    double ref;
+    double err;
+
+    done = Motor_ramp_step(&ramp, &level);
+    if (k == n)
+    {
+      break;
+    }
+    if (ramp.phase != (uint32_t)((k << 32) / n))
+    {
+      phase_errors++;
+    }
+    ref = p->from_x100 + delta * _Test_s_curve((double)k / (double)n);
+    err = fabs((double)level - ref);
+    if (err > max_err)
+    {
+      max_err = err;
+    }
+    if (err > tol)
+    {
+      level_errors++;
+    }
+    if ((delta >= 0) ? (level < prev) : (level > prev))
+    {
+      order_errors++;
+    }
+    prev = level;
+  }
+  TEST_CHECK(done);
+  TEST_CHECK_EQ(k, n);
+  TEST_CHECK_EQ(level, p->to_x100);
+  TEST_CHECK_EQ(phase_errors, 0);
+  TEST_CHECK_EQ(level_errors, 0);
+  TEST_CHECK_EQ(order_errors, 0);
+  printf("ramp %5u -> %5u, %6u ms at %5u Hz: %8llu updates, max error %.2f (limit %.2f)\n", p->from_x100, p->to_x100, p->duration_ms, p->update_hz, (unsigned long long)n, max_err, tol);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Ramp of more than 2^31 updates, the remainder accumulation must not overflow. The start
+               and the end of the ramp are run, the state in between is set to the exact phase.
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_long_ramp(void)
+{
+  const uint32_t run = 1000000;
+  T_motor_ramp   ramp;
+  uint64_t       n;
+  uint64_t       k;
+  uint32_t       phase_errors = 0;
+  uint16_t       level = 0;
+  bool           done  = false;
+
+  Motor_ramp_s_curve_begin(&ramp, 0, 10000, 4000000000u, 1000);
+  n = ramp.steps;
+  TEST_CHECK_EQ(n, 4000000000u);
+  for (k = 1; k <= run; k++)
+  {
+    Motor_ramp_step(&ramp, &level);
+    phase_errors += (ramp.phase != (uint32_t)((k << 32) / n));
+  }
+
+  k               = n - run;
+  ramp.phase      = (uint32_t)((k << 32) / n);
+  ramp.phase_acc  = (uint32_t)((k << 32) % n);
+  ramp.steps_left = (uint32_t)(n - k);
+  for (k++; k < n; k++)
+  {
+    done          = Motor_ramp_step(&ramp, &level);
+    phase_errors += (ramp.phase != (uint32_t)((k << 32) / n));
+  }
+  TEST_CHECK(!done);
+  TEST_CHECK(level >= 9999);
+  TEST_CHECK(Motor_ramp_step(&ramp, &level));
+  TEST_CHECK_EQ(level, 10000);
+  TEST_CHECK_EQ(phase_errors, 0);
+}
+
+int main(void)
+{
+  Motor_ramp_init_table();
+  for (uint32_t i = 0; i < sizeof(g_ramps) / sizeof(g_ramps[0]); i++)
+  {
+    _Test_ramp(&g_ramps[i]);
+  }
+  _Test_long_ramp();
+  return Host_test_result("test_motor_ramp");
+}
@@ -0,0 +1,315 @@
+#include "App.h"
+#include "host_test.h"
+
+// Power loss test of the DataFlash settings journal. NV_journal.c is included so every simulated
+// reboot starts from cleared module state. The DataFlash model follows the rules of the RA8M1 data
+// flash: erased cells read undefined values and are recognised only by the blank check, a word may be
+// programmed once after erase and a program cut by power loss leaves the word undefined.
+// Random changes of the application parameters are saved, power is cut at a random program word in some
+// of the saves, and after every reboot the restored parameters must be exactly the old or the new ones.
+
+#include "NV_journal.c"
+
+#define TEST_SAVES_DEFAULT 200000u
+#define TEST_DF_BASE       DATAFLASH_APP_PARAMS_1_ADDR
+#define TEST_DF_SIZE       (2 * DATAFLASH_PARAMS_AREA_SIZE)
+#define TEST_VAL_MAX       256
+
+const uint32_t df_params_addr[PARAMS_TYPES_NUM][2] = {{DATAFLASH_APP_PARAMS_1_ADDR, DATAFLASH_APP_PARAMS_2_ADDR}};
+uint32_t       g_setting_wr_counters[PARAMS_TYPES_NUM][2];
+
+static uint8_t  g_df[TEST_DF_SIZE];
+static uint8_t  g_df_blank[TEST_DF_SIZE];
+static int32_t  g_df_budget = -1;  // Words that may be programmed before the power loss, -1 - no loss
+static uint32_t g_df_powerlost;
+static uint32_t g_df_violations;   // Programming of cells that are not blank, unaligned accesses
+static uint32_t g_rnd = 2024;
+
+typedef struct
+{
+  uint8_t v[NVJ_MAX_PARAMS][TEST_VAL_MAX];
+} T_params_snapshot;
+
+static uint32_t _Test_rand(void)
+{
+  g_rnd = g_rnd * 1664525u + 1013904223u;
+  return g_rnd >> 8;
+}
+
+static uint8_t *_Df(uint32_t addr)
+{
+  return &g_df[addr - TEST_DF_BASE];
+}
+
+static uint32_t _Df_in_range(uint32_t addr, uint32_t size)
+{
+  return (addr >= TEST_DF_BASE) && ((addr - TEST_DF_BASE + size) <= TEST_DF_SIZE);
+}
+
+uint32_t DataFlash_bgo_EraseArea(uint32_t start_addr, uint32_t area_size)
+{
+  if ((g_df_powerlost != 0) || (_Df_in_range(start_addr, area_size) == 0))
+  {
+    return RES_ERROR;
+  }
+  for (uint32_t i = 0; i < area_size; i++)
+  {
+    *_Df(start_addr + i)                      = (uint8_t)_Test_rand();
+    g_df_blank[start_addr - TEST_DF_BASE + i] = 1;
+  }
+  return RES_OK;
+}
+
+uint32_t DataFlash_bgo_WriteArea(uint32_t start_addr, uint8_t *buf, uint32_t buf_size)
+{
+  if (((start_addr % DATA_FLASH_WR_SZ) != 0) || ((buf_size % DATA_FLASH_WR_SZ) != 0) || (_Df_in_range(start_addr, buf_size) == 0))
+  {
+    g_df_violations++;
+    return RES_ERROR;
+  }
+  for (uint32_t i = 0; i < buf_size; i += DATA_FLASH_WR_SZ)
+  {
+    uint32_t offs = start_addr - TEST_DF_BASE + i;
+
+    if (g_df_powerlost != 0)
+    {
+      return RES_ERROR;
+    }
+    if (g_df_budget == 0)
+    {
+      // Torn word
+      for (uint32_t k = 0; k < DATA_FLASH_WR_SZ; k++)
+      {
+        g_df[offs + k]       = (uint8_t)_Test_rand();
+        g_df_blank[offs + k] = 0;
+      }
+      g_df_powerlost = 1;
+      return RES_ERROR;
+    }
+    if (g_df_budget > 0)
+    {
+      g_df_budget--;
+    }
+    for (uint32_t k = 0; k < DATA_FLASH_WR_SZ; k++)
+    {
+      if (g_df_blank[offs + k] == 0)
+      {
+        g_df_violations++;
+      }
+      g_df[offs + k]       = buf[i + k];
+      g_df_blank[offs + k] = 0;
+    }
+  }
+  return RES_OK;
+}
+
+uint32_t DataFlash_bgo_ReadArea(uint32_t start_addr, uint8_t *buf, uint32_t buf_size)
+{
+  if (_Df_in_range(start_addr, buf_size) == 0)
+  {
+    return RES_ERROR;
+  }
+  memcpy(buf, _Df(start_addr), buf_size);
+  return RES_OK;
+}
+
+uint32_t DataFlash_bgo_BlankCheck(uint32_t start_addr, uint32_t num_bytes)
+{
+  if (_Df_in_range(start_addr, num_bytes) == 0)
+  {
+    return RES_ERROR;
+  }
+  for (uint32_t i = 0; i < num_bytes; i++)
+  {
+    if (g_df_blank[start_addr - TEST_DF_BASE + i] == 0)
+    {
+      return RES_ERROR;
+    }
+  }
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Set a random value inside the limits of the parameter
+
+  Parameters: pp - parameter
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_random_value(const T_NV_parameters *pp)
+{
+  double span = (double)pp->maxval - (double)pp->minval;
+  double r    = (double)_Test_rand() / (double)(1u << 24);
+
+  switch (pp->vartype)
+  {
+    case tint8u:
+      *(uint8_t *)pp->val = (uint8_t)(pp->minval + (uint32_t)(r * (span + 1)));
+      break;
+    case tint16u:
+      *(uint16_t *)pp->val = (uint16_t)(pp->minval + (uint32_t)(r * (span + 1)));
+      break;
+    case tint32u:
+      *(uint32_t *)pp->val = (uint32_t)((double)pp->minval + floor(r * span));
+      break;
+    case tint32s:
+      *(int32_t *)pp->val = (int32_t)((double)pp->minval + floor(r * span));
+      break;
+    case tfloat:
+      *(float *)pp->val = (float)((double)pp->minval + r * span);
+      break;
+    case tstring:
+    {
+      uint32_t len = _Test_rand() % pp->varlen;
+
+      for (uint32_t i = 0; i < len; i++)
+      {
+        ((char *)pp->val)[i] = (char)('a' + _Test_rand() % 26);
+      }
+      ((char *)pp->val)[len] = 0;
+      break;
+    }
+    case tarrofbyte:
+      for (uint32_t i = 0; i < pp->varlen; i++)
+      {
+        ((uint8_t *)pp->val)[i] = (uint8_t)_Test_rand();
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Copy the stored part of every parameter value, strings up to the terminating zero
+
+  Parameters: p_snap - snapshot
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_snapshot(T_params_snapshot *p_snap)
+{
+  memset(p_snap, 0, sizeof(*p_snap));
+  for (uint32_t i = 0; i < wvar_inst.items_num; i++)
+  {
+    const T_NV_parameters *pp = &wvar_inst.items_array[i];
+    const uint8_t         *val;
+    uint32_t               len;
+
+    if ((_NVJ_value_ref(pp, &val, &len) == RES_OK) && (len <= TEST_VAL_MAX))
+    {
+      memcpy(p_snap->v[i], val, len);
+    }
+  }
+}
+
+static uint32_t _Test_snapshot_equal(const T_params_snapshot *a, const T_params_snapshot *b)
+{
+  return memcmp(a, b, sizeof(*a)) == 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Simulated reboot: journal state is lost, parameters get their defaults and the journal
+               is replayed
+
+  Parameters:
+
+  Return: Result of NV_journal_restore
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Test_reboot(void)
+{
+  g_df_budget    = -1;
+  g_df_powerlost = 0;
+  memset(g_nvj, 0, sizeof(g_nvj));
+  Host_params_load_defaults(&wvar_inst);
+  return NV_journal_restore(APPLICATION_PARAMS);
+}
+
+int main(int argc, char **argv)
+{
+  static T_params_snapshot saved;
+  static T_params_snapshot before;
+  static T_params_snapshot changed;
+  static T_params_snapshot restored;
+  uint32_t                 saves     = TEST_SAVES_DEFAULT;
+  uint32_t                 losses    = 0;
+  uint32_t                 reboots   = 0;
+  uint32_t                 mixes     = 0;
+  uint32_t                 appends   = 0;
+  uint32_t                 compacts  = 0;
+
+  if (argc > 1)
+  {
+    saves = (uint32_t)strtoul(argv[1], NULL, 10);
+  }
+
+  // Factory state: undefined flash contents, nothing is blank until erased
+  for (uint32_t i = 0; i < TEST_DF_SIZE; i++)
+  {
+    g_df[i] = (uint8_t)_Test_rand();
+  }
+  Host_params_load_defaults(&wvar_inst);
+  TEST_CHECK_EQ(_Test_reboot(), RES_ERROR);
+  TEST_CHECK_EQ(NV_journal_save(APPLICATION_PARAMS), RES_OK);
+  _Test_snapshot(&saved);
+
+  for (uint32_t it = 0; it < saves; it++)
+  {
+    uint32_t lose;
+    uint32_t res;
+
+    before = saved;
+    for (uint32_t n = _Test_rand() % 4; n > 0; n--)
+    {
+      _Test_random_value(&wvar_inst.items_array[_Test_rand() % wvar_inst.items_num]);
+    }
+    _Test_snapshot(&changed);
+
+    lose        = ((_Test_rand() % 10) == 0);
+    g_df_budget = lose ? (int32_t)(_Test_rand() % 200) : -1;
+    res         = NV_journal_save(APPLICATION_PARAMS);
+    appends    += g_nvj[0].appends;
+    compacts   += g_nvj[0].compactions;
+    g_nvj[0].appends     = 0;
+    g_nvj[0].compactions = 0;
+    if (lose == 0)
+    {
+      TEST_CHECK_EQ(res, RES_OK);
+      saved = changed;
+    }
+
+    if ((lose != 0) || ((_Test_rand() % 20) == 0))
+    {
+      reboots++;
+      TEST_CHECK_EQ(_Test_reboot(), RES_OK);
+      _Test_snapshot(&restored);
+      if (lose != 0)
+      {
+        losses++;
+        if (_Test_snapshot_equal(&restored, &changed))
+        {
+          saved = changed;
+        }
+        else if (_Test_snapshot_equal(&restored, &before))
+        {
+          saved = before;
+        }
+        else
+        {
+          mixes++;
+          saved = restored;
+        }
+      }
+      else
+      {
+        TEST_CHECK(_Test_snapshot_equal(&restored, &saved));
+      }
+    }
+  }
+
+  TEST_CHECK_EQ(mixes, 0);
+  TEST_CHECK_EQ(g_df_violations, 0);
+  TEST_CHECK(appends > compacts);
+  printf("test_nv_journal: %u saves, %u power losses, %u reboots, %u appends, %u compactions\n", saves, losses, reboots, appends, compacts);
+  return Host_test_result("test_nv_journal");
+}
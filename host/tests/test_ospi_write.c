@@ -0,0 +1,410 @@
+#include "App.h"
+#include "host_test.h"
+
+// Test of the memory-mapped OSPI write against a model of the controller and the NOR device.
+// The DMA transfer of a block into the memory-mapped window is the program of the device: it needs
+// the write enable latch, may not cross a page and ANDs the data into the array, the device is busy
+// for a few ticks after it. The model answers the manual WREN command in the TRREQ wait loop and the
+// periodic status polling of WEL and WIP on the RTOS ticks of the ThreadX shim.
+// Writes split at page boundaries, blocks of 0xFF take no program and the bytes around an unaligned
+// head or tail keep their content.
+// MC80_OSPI_drv.c is included so the static block functions and the event flags can be reached,
+// __NOP of the TRREQ wait loop runs a step of the controller model.
+
+void _Test_xspi_step(void);
+#define __NOP() _Test_xspi_step()
+#include "MC80_OSPI_drv.c"
+
+#define TEST_WINDOW_BASE  BSP_FEATURE_OSPI_B_DEVICE_0_START_ADDRESS
+#define TEST_NOR_SIZE     (64u * 1024u)
+#define TEST_PROGRAM_TICKS 2u      // Device busy time of a program
+#define TEST_RANDOM_WRITES 2000u
+#define TEST_CMD_WREN     0x06u
+#define TEST_CMD_RDSR     0x05u
+#define TEST_CMD_PP       0x02u
+
+typedef struct
+{
+  uint32_t programs;          // DMA transfers into the window
+  uint32_t wren;              // Manual WREN commands
+  uint32_t polls;             // Periodic status pollings completed
+  uint32_t no_wel;            // Programs without the write enable latch
+  uint32_t busy;              // Programs while the device is busy
+  uint32_t page_cross;        // Programs that cross a page
+  uint32_t unaligned;         // Programs not aligned to a block
+  uint32_t outside;           // Programs outside of the model array
+} T_test_nor_stat;
+
+static uint8_t                g_nor[TEST_NOR_SIZE];
+static T_test_nor_stat        g_stat;
+static bool                   g_wel;
+static uint32_t               g_wip_ticks;
+static bool                   g_stuck_wip;         // Device never finishes a program
+static uint32_t               g_short_transfer;    // Bytes the DMA leaves untransferred
+static transfer_info_t       *g_dma_info;
+static uint32_t               g_rnd = 5;
+
+static fsp_err_t _Test_dma_reconfigure(transfer_ctrl_t *const p_ctrl, transfer_info_t *p_info);
+static fsp_err_t _Test_dma_software_start(transfer_ctrl_t *const p_ctrl, transfer_start_mode_t mode);
+static fsp_err_t _Test_dma_info_get(transfer_ctrl_t *const p_ctrl, transfer_properties_t *const p_properties);
+
+static const transfer_api_t g_test_dma_api = {
+  .reconfigure   = _Test_dma_reconfigure,
+  .softwareStart = _Test_dma_software_start,
+  .infoGet       = _Test_dma_info_get,
+};
+
+static transfer_info_t                     g_test_dma_info;
+static const dmac_extended_cfg_t           g_test_dma_extend = {.channel = 0};
+static const transfer_cfg_t                g_test_dma_cfg    = {.p_info = &g_test_dma_info, .p_extend = &g_test_dma_extend};
+static const transfer_instance_t           g_test_dma        = {.p_ctrl = NULL, .p_cfg = &g_test_dma_cfg, .p_api = &g_test_dma_api};
+static const T_mc80_ospi_extended_cfg      g_test_ospi_extend = {.p_lower_lvl_transfer = &g_test_dma};
+static const T_mc80_ospi_cfg               g_test_ospi_cfg    = {.spi_protocol = MC80_OSPI_PROTOCOL_1S_1S_1S, .page_size_bytes = MC80_OSPI_PRV_PAGE_SIZE_BYTES, .p_extend = &g_test_ospi_extend};
+static const T_mc80_ospi_xspi_command_set  g_test_cmd_set = {
+  .protocol             = MC80_OSPI_PROTOCOL_1S_1S_1S,
+  .command_bytes        = MC80_OSPI_COMMAND_BYTES_1,
+  .program_command      = TEST_CMD_PP,
+  .write_enable_command = TEST_CMD_WREN,
+  .status_command       = TEST_CMD_RDSR,
+};
+static T_mc80_ospi_instance_ctrl g_ctrl;
+
+static uint32_t _Test_rand(void)
+{
+  g_rnd = g_rnd * 1664525u + 1013904223u;
+  return g_rnd >> 8;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Manual command of the controller, runs in the TRREQ wait loop of the direct transfer
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void _Test_xspi_step(void)
+{
+  R_XSPI0_Type *p_reg = R_XSPI0;
+  uint32_t      cdt   = p_reg->CDBUF[0].CDT;
+  uint32_t      command;
+
+  if (((p_reg->CDCTL0 & OSPI_CDCTL0_TRREQ_Msk) == 0) || ((p_reg->CDCTL0 & OSPI_CDCTL0_PERMD_Msk) != 0))
+  {
+    return;
+  }
+  if (((cdt & OSPI_CDTBUFn_CMDSIZE_Msk) >> OSPI_CDTBUFn_CMDSIZE_Pos) == 1)
+  {
+    command = (cdt >> MC80_OSPI_PRV_CDTBUF_CMD_UPPER_OFFSET) & MC80_OSPI_PRV_CDTBUF_CMD_1B_VALUE_MASK;
+  }
+  else
+  {
+    command = (cdt >> MC80_OSPI_PRV_CDTBUF_CMD_OFFSET) & MC80_OSPI_PRV_CDTBUF_CMD_2B_VALUE_MASK;
+  }
+  if (command == TEST_CMD_WREN)
+  {
+    g_wel = true;
+    g_stat.wren++;
+  }
+  p_reg->CDCTL0 &= ~OSPI_CDCTL0_TRREQ_Msk;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: RTOS tick: the device works on its program, the periodic polling of the controller
+               reads the status register and raises the command completion interrupt on a match
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_tick(void)
+{
+  R_XSPI0_Type *p_reg = R_XSPI0;
+  uint32_t      status;
+
+  if ((g_wip_ticks > 0) && !g_stuck_wip)
+  {
+    g_wip_ticks--;
+  }
+  if (((p_reg->CDCTL0 & (OSPI_CDCTL0_PERMD_Msk | OSPI_CDCTL0_TRREQ_Msk)) != (OSPI_CDCTL0_PERMD_Msk | OSPI_CDCTL0_TRREQ_Msk)) || ((p_reg->INTE & OSPI_INTE_CMDCMPE_Msk) == 0))
+  {
+    return;
+  }
+  status = ((g_wip_ticks > 0) ? 0x01u : 0u) | (g_wel ? 0x02u : 0u);
+  if (((status ^ p_reg->CDCTL1) & ~p_reg->CDCTL2) != 0)
+  {
+    return;
+  }
+  p_reg->CDCTL0            &= ~OSPI_CDCTL0_TRREQ_Msk;
+  *(uint32_t *)&p_reg->INTS = OSPI_INTS_CMDCMP_Msk;
+  ospi_cmdcmp_isr();
+  *(uint32_t *)&p_reg->INTS = 0;
+  g_stat.polls++;
+}
+
+static fsp_err_t _Test_dma_reconfigure(transfer_ctrl_t *const p_ctrl, transfer_info_t *p_info)
+{
+  (void)p_ctrl;
+  g_dma_info = p_info;
+  return FSP_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: DMA of a block into the memory-mapped window, programs the NOR array
+
+  Parameters: p_ctrl - transfer control, not used
+              mode   - start mode, not used
+
+  Return: FSP_SUCCESS
+-----------------------------------------------------------------------------------------------------*/
+static fsp_err_t _Test_dma_software_start(transfer_ctrl_t *const p_ctrl, transfer_start_mode_t mode)
+{
+  uint8_t const *p_src  = g_dma_info->p_src;
+  uint32_t       addr   = (uint32_t)(uintptr_t)g_dma_info->p_dest;
+  uint32_t       length = g_dma_info->length;
+  uint32_t       offset = addr - TEST_WINDOW_BASE;
+
+  (void)p_ctrl;
+  (void)mode;
+  g_stat.programs++;
+  g_stat.no_wel     += !g_wel;
+  g_stat.busy       += (g_wip_ticks > 0);
+  g_stat.page_cross += ((offset % MC80_OSPI_PRV_PAGE_SIZE_BYTES) + length > MC80_OSPI_PRV_PAGE_SIZE_BYTES);
+  g_stat.unaligned  += ((offset % MC80_OSPI_BLOCK_WRITE_SIZE) != 0);
+  if ((addr < TEST_WINDOW_BASE) || (offset + length > TEST_NOR_SIZE))
+  {
+    g_stat.outside++;
+  }
+  else
+  {
+    for (uint32_t i = 0; i < length - g_short_transfer; i++)
+    {
+      g_nor[offset + i] &= p_src[i];
+    }
+  }
+  g_wel       = false;
+  g_wip_ticks = TEST_PROGRAM_TICKS;
+  OSPI_dma_callback(NULL);
+  return FSP_SUCCESS;
+}
+
+static fsp_err_t _Test_dma_info_get(transfer_ctrl_t *const p_ctrl, transfer_properties_t *const p_properties)
+{
+  (void)p_ctrl;
+  p_properties->transfer_length_remaining = g_short_transfer;
+  return FSP_SUCCESS;
+}
+
+static void _Test_reset(void)
+{
+  memset(g_nor, 0xFF, sizeof(g_nor));
+  memset(&g_stat, 0, sizeof(g_stat));
+  memset(R_XSPI0, 0, sizeof(*R_XSPI0));
+  memset(R_DMAC0, 0, sizeof(*R_DMAC0));
+  g_wel            = false;
+  g_wip_ticks      = 0;
+  g_stuck_wip      = false;
+  g_short_transfer = 0;
+}
+
+static fsp_err_t _Test_write(uint32_t offset, uint8_t const *p_src, uint32_t len)
+{
+  return Mc80_ospi_memory_mapped_write(&g_ctrl, p_src, (uint8_t *)(uintptr_t)(TEST_WINDOW_BASE + offset), len);
+}
+
+// Blocks of [offset, offset + len) that hold data other than 0xFF
+static uint32_t _Test_expected_programs(uint32_t offset, uint8_t const *p_src, uint32_t len)
+{
+  uint32_t programs = 0;
+
+  for (uint32_t block = offset & ~(MC80_OSPI_BLOCK_WRITE_SIZE - 1); block < offset + len; block += MC80_OSPI_BLOCK_WRITE_SIZE)
+  {
+    for (uint32_t a = block; a < block + MC80_OSPI_BLOCK_WRITE_SIZE; a++)
+    {
+      if ((a >= offset) && (a < offset + len) && (p_src[a - offset] != 0xFF))
+      {
+        programs++;
+        break;
+      }
+    }
+  }
+  return programs;
+}
+
+static void _Test_check_model(void)
+{
+  TEST_CHECK_EQ(g_stat.no_wel, 0);
+  TEST_CHECK_EQ(g_stat.busy, 0);
+  TEST_CHECK_EQ(g_stat.page_cross, 0);
+  TEST_CHECK_EQ(g_stat.unaligned, 0);
+  TEST_CHECK_EQ(g_stat.outside, 0);
+  TEST_CHECK_EQ(g_stat.wren, g_stat.programs);
+  TEST_CHECK_EQ(g_stat.polls, 2 * g_stat.programs);
+  TEST_CHECK_EQ(R_DMAC0->DMBWR, 0);
+  TEST_CHECK_EQ(R_XSPI0->INTE & OSPI_INTE_CMDCMPE_Msk, 0);
+}
+
+// Whole aligned pages are programmed block by block without a copy
+static void _Test_aligned_pages(void)
+{
+  uint8_t data[4 * MC80_OSPI_PRV_PAGE_SIZE_BYTES];
+
+  _Test_reset();
+  for (uint32_t i = 0; i < sizeof(data); i++)
+  {
+    data[i] = (uint8_t)(i * 7 + 1);
+  }
+  TEST_CHECK_EQ(_Test_write(0x1000, data, sizeof(data)), FSP_SUCCESS);
+  TEST_CHECK_EQ(g_stat.programs, sizeof(data) / MC80_OSPI_BLOCK_WRITE_SIZE);
+  TEST_CHECK(memcmp(&g_nor[0x1000], data, sizeof(data)) == 0);
+  TEST_CHECK_EQ(R_XSPI0->BMCTL1, MC80_OSPI_PRV_BMCTL1_CLEAR_PREFETCH_MASK);
+  _Test_check_model();
+}
+
+// Unaligned head and tail: the blocks around them are completed with 0xFF, programmed bytes next to
+// the written range keep their content
+static void _Test_unaligned_head_tail(void)
+{
+  const uint32_t offset = 0x2000 + 37;
+  const uint32_t len    = 700;
+  uint8_t        data[700];
+
+  _Test_reset();
+  for (uint32_t i = 0; i < len; i++)
+  {
+    data[i] = (uint8_t)(0xA0 ^ i);
+  }
+  memset(&g_nor[0x2000], 0x5A, 37);
+  memset(&g_nor[offset + len], 0x3C, 64);
+  TEST_CHECK_EQ(_Test_write(offset, data, len), FSP_SUCCESS);
+  TEST_CHECK(memcmp(&g_nor[offset], data, len) == 0);
+  for (uint32_t i = 0; i < 37; i++)
+  {
+    TEST_CHECK_EQ(g_nor[0x2000 + i], 0x5A);
+  }
+  for (uint32_t i = 0; i < 64; i++)
+  {
+    TEST_CHECK_EQ(g_nor[offset + len + i], 0x3C);
+  }
+  TEST_CHECK_EQ(g_stat.programs, _Test_expected_programs(offset, data, len));
+  TEST_CHECK_EQ(g_stat.programs, (offset + len + 63) / 64 - offset / 64);
+  _Test_check_model();
+}
+
+// A write across a page boundary is split into a program on each page
+static void _Test_page_boundary(void)
+{
+  uint8_t data[2] = {0x12, 0x34};
+  uint8_t one     = 0x00;
+
+  _Test_reset();
+  TEST_CHECK_EQ(_Test_write(0x30FF, data, 2), FSP_SUCCESS);
+  TEST_CHECK_EQ(g_stat.programs, 2);
+  TEST_CHECK_EQ(g_nor[0x30FF], 0x12);
+  TEST_CHECK_EQ(g_nor[0x3100], 0x34);
+  TEST_CHECK_EQ(g_nor[0x30FE], 0xFF);
+  TEST_CHECK_EQ(g_nor[0x3101], 0xFF);
+
+  TEST_CHECK_EQ(_Test_write(0x31FF, &one, 1), FSP_SUCCESS);
+  TEST_CHECK_EQ(g_stat.programs, 3);
+  TEST_CHECK_EQ(g_nor[0x31FF], 0x00);
+  _Test_check_model();
+}
+
+// Blocks that hold only 0xFF take no program, the NOR stays erased there
+static void _Test_erased_blocks_skipped(void)
+{
+  uint8_t data[3 * MC80_OSPI_PRV_PAGE_SIZE_BYTES];
+
+  _Test_reset();
+  memset(data, 0xFF, sizeof(data));
+  TEST_CHECK_EQ(_Test_write(0x4000, data, sizeof(data)), FSP_SUCCESS);
+  TEST_CHECK_EQ(g_stat.programs, 0);
+
+  // One byte in the second block and in the last block, a 0xFF head and tail around them
+  data[100]               = 0x00;
+  data[sizeof(data) - 11] = 0x7E;
+  TEST_CHECK_EQ(_Test_write(0x4000 + 10, data, sizeof(data) - 10), FSP_SUCCESS);
+  TEST_CHECK_EQ(g_stat.programs, 2);
+  TEST_CHECK_EQ(g_nor[0x4000 + 10 + 100], 0x00);
+  TEST_CHECK_EQ(g_nor[0x4000 + sizeof(data) - 1], 0x7E);
+  _Test_check_model();
+}
+
+// A device that never gets ready or a DMA that stops early end the write with an error
+static void _Test_errors(void)
+{
+  uint8_t data[MC80_OSPI_PRV_PAGE_SIZE_BYTES];
+
+  memset(data, 0x11, sizeof(data));
+  _Test_reset();
+  g_stuck_wip = true;
+  TEST_CHECK_EQ(_Test_write(0x5000, data, sizeof(data)), FSP_ERR_TIMEOUT);
+  TEST_CHECK_EQ(g_stat.programs, 1);
+  TEST_CHECK_EQ(R_DMAC0->DMBWR, 0);
+
+  _Test_reset();
+  g_short_transfer = 4;
+  TEST_CHECK_EQ(_Test_write(0x5000, data, sizeof(data)), FSP_ERR_TRANSFER_ABORTED);
+  TEST_CHECK_EQ(g_stat.programs, 1);
+  TEST_CHECK_EQ(R_DMAC0->DMBWR, 0);
+}
+
+// Random offsets and lengths into erased flash, data with runs of 0xFF
+static void _Test_random(void)
+{
+  static uint8_t data[3000];
+  uint32_t       expected = 0;
+
+  _Test_reset();
+  for (uint32_t w = 0; w < TEST_RANDOM_WRITES; w++)
+  {
+    uint32_t len    = 1 + _Test_rand() % sizeof(data);
+    uint32_t offset = _Test_rand() % (TEST_NOR_SIZE - len);
+    uint32_t before = (offset > 0) ? g_nor[offset - 1] : 0;
+    uint32_t after  = (offset + len < TEST_NOR_SIZE) ? g_nor[offset + len] : 0;
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+      data[i] = ((_Test_rand() % 8) < 3) ? 0xFF : (uint8_t)_Test_rand();
+    }
+    if ((w % 4) == 0)
+    {
+      memset(&data[len / 4], 0xFF, len / 2);  // Whole erased blocks in the middle
+    }
+    memset(&g_nor[offset], 0xFF, len);
+    expected += _Test_expected_programs(offset, data, len);
+    TEST_CHECK_EQ(_Test_write(offset, data, len), FSP_SUCCESS);
+    TEST_CHECK(memcmp(&g_nor[offset], data, len) == 0);
+    if (offset > 0)
+    {
+      TEST_CHECK_EQ(g_nor[offset - 1], before);
+    }
+    if (offset + len < TEST_NOR_SIZE)
+    {
+      TEST_CHECK_EQ(g_nor[offset + len], after);
+    }
+  }
+  TEST_CHECK_EQ(g_stat.programs, expected);
+  _Test_check_model();
+  printf("random writes: %u, programs: %u\n", TEST_RANDOM_WRITES, g_stat.programs);
+}
+
+int main(void)
+{
+  g_ctrl.p_cfg        = &g_test_ospi_cfg;
+  g_ctrl.open         = MC80_OSPI_PRV_OPEN;
+  g_ctrl.spi_protocol = MC80_OSPI_PROTOCOL_1S_1S_1S;
+  g_ctrl.channel      = MC80_OSPI_DEVICE_NUMBER_0;
+  g_ctrl.p_cmd_set    = &g_test_cmd_set;
+  g_ctrl.p_reg        = R_XSPI0;
+  _Ospi_dma_event_flags_initialize();
+  Host_tx_set_tick_hook(_Test_tick);
+
+  _Test_aligned_pages();
+  _Test_unaligned_head_tail();
+  _Test_page_boundary();
+  _Test_erased_blocks_skipped();
+  _Test_errors();
+  _Test_random();
+  return Host_test_result("test_ospi_write");
+}
@@ -0,0 +1,135 @@
+#include "App.h"
+#include "host_test.h"
+#include "param_lookup_tables.h"
+
+// Test of the parameter lookups by perfect hash index: Find_param_by_name, Find_param_by_alias and
+// Find_param_by_hash over the parameters of the firmware and over the generated sets of 45 to 2000
+// parameters. Every name, alias and CRC16 must resolve to its own index, an alias used twice to its
+// first owner. Names and aliases that differ in one character and every CRC16 of no parameter must
+// miss. The index lookups must agree with the linear search of an instance without indexes.
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Check the name and alias lookups of an instance against the linear search
+
+  Parameters: p_pars - instance with indexes
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_names(const T_NV_parameters_instance *p_pars)
+{
+  T_NV_parameters_instance linear = *p_pars;
+  char                     key[64];
+  uint32_t                 name_errors  = 0;
+  uint32_t                 alias_errors = 0;
+  uint32_t                 miss_errors  = 0;
+
+  linear.name_index  = NULL;
+  linear.alias_index = NULL;
+  for (uint32_t i = 0; i < p_pars->items_num; i++)
+  {
+    const T_NV_parameters *p = &p_pars->items_array[i];
+    int32_t                first_alias;
+
+    name_errors += (Find_param_by_name(p_pars, (char *)p->var_name) != (int32_t)i);
+    first_alias  = Find_param_by_alias(&linear, (char *)p->var_alias);
+    alias_errors += (first_alias > (int32_t)i) || (Find_param_by_alias(p_pars, (char *)p->var_alias) != first_alias);
+
+    // One character changed, one character appended and the last one removed
+    for (uint32_t v = 0; v < 3; v++)
+    {
+      const char *src = (v < 2) ? (const char *)p->var_name : (const char *)p->var_alias;
+      size_t      len = strlen(src);
+
+      snprintf(key, sizeof(key), "%s", src);
+      if (v == 0)
+      {
+        key[len / 2] ^= 0x20;
+      }
+      else if (v == 1)
+      {
+        snprintf(key, sizeof(key), "%s_", src);
+      }
+      else if (len > 0)
+      {
+        key[len - 1] = 0;
+      }
+      miss_errors += (Find_param_by_name(p_pars, key) != Find_param_by_name(&linear, key));
+      miss_errors += (Find_param_by_alias(p_pars, key) != Find_param_by_alias(&linear, key));
+    }
+  }
+  miss_errors += (Find_param_by_name(p_pars, "") != -1);
+  miss_errors += (Find_param_by_name(p_pars, "no_such_parameter") != -1);
+  miss_errors += (Find_param_by_alias(p_pars, "ZZZZZZZZ") != -1);
+  TEST_CHECK_EQ(name_errors, 0);
+  TEST_CHECK_EQ(alias_errors, 0);
+  TEST_CHECK_EQ(miss_errors, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Check a hash lookup for every CRC16 value
+
+  Parameters: items_num     - number of parameters
+              index_to_hash - CRC16 of every parameter
+              find          - lookup under test
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Test_hashes(uint32_t items_num, const uint16_t *index_to_hash, uint16_t (*find)(uint16_t hash))
+{
+  static int32_t owner[0x10000];
+  uint32_t       errors = 0;
+  uint32_t       misses = 0;
+
+  for (uint32_t h = 0; h < 0x10000; h++)
+  {
+    owner[h] = -1;
+  }
+  for (uint32_t i = 0; i < items_num; i++)
+  {
+    owner[index_to_hash[i]] = (int32_t)i;
+  }
+  for (uint32_t h = 0; h < 0x10000; h++)
+  {
+    uint16_t index = find((uint16_t)h);
+
+    errors += (owner[h] < 0) ? (index != 0xFFFF) : (index != (uint16_t)owner[h]);
+    misses += (owner[h] < 0);
+  }
+  TEST_CHECK_EQ(errors, 0);
+  TEST_CHECK_EQ(misses, 0x10000u - items_num);
+}
+
+int main(void)
+{
+  uint32_t  wvar_num    = wvar_inst.items_num;
+  uint16_t *wvar_hashes = calloc(wvar_num, sizeof(uint16_t));
+
+  // Parameters of the firmware
+  TEST_CHECK(wvar_inst.name_index != NULL);
+  TEST_CHECK(wvar_inst.alias_index != NULL);
+  TEST_CHECK(wvar_hashes != NULL);
+  for (uint32_t i = 0; i < wvar_num; i++)
+  {
+    wvar_hashes[i] = Get_param_hash_by_index((uint16_t)i);
+  }
+  _Test_names(&wvar_inst);
+  _Test_hashes(wvar_num, wvar_hashes, Find_param_by_hash);
+  printf("firmware parameters: %u\n", (unsigned)wvar_num);
+  free(wvar_hashes);
+
+  // Generated sets
+  for (uint32_t s = 0; s < PARAM_LOOKUP_SETS_NUM; s++)
+  {
+    const T_param_lookup_set *set  = &g_param_lookup_sets[s];
+    T_NV_parameters_instance  inst = {0};
+
+    inst.items_num   = set->items_num;
+    inst.items_array = set->items_array;
+    inst.name_index  = set->name_index;
+    inst.alias_index = set->alias_index;
+    _Test_names(&inst);
+    _Test_hashes(set->items_num, set->index_to_hash, set->find_by_hash);
+    printf("generated set: %u parameters\n", (unsigned)set->items_num);
+  }
+  return Host_test_result("test_param_lookup");
+}
@@ -124,6 +124,8 @@ const T_mc80_ospi_xspi_command_set g_OSPI_command_set_table[] = {
    .program_dummy_cycles = 0,                                        // No dummy cycles for write
    .write_enable_command = MX25_CMD_WREN,                            // Write Enable
    .status_command       = MX25_CMD_RDSR,                            // Read Status Register
+   .suspend_command      = MX25_CMD_PGMERS_SUSPEND,                  // Program/Erase Suspend
+   .resume_command       = MX25_CMD_PGMERS_RESUME,                   // Program/Erase Resume
    .status_dummy_cycles  = 0,                                        // No dummy cycles for status
   },
   {
@@ -144,6 +146,8 @@ const T_mc80_ospi_xspi_command_set g_OSPI_command_set_table[] = {
    .program_dummy_cycles = 0,                                           // No dummy cycles for write
    .write_enable_command = MX25_OPI_WREN_DTR,                           // Write Enable
    .status_command       = MX25_OPI_RDSR_DTR,                           // Read Status
+   .suspend_command      = MX25_OPI_PGMERS_SUSPEND_DTR,                 // Program/Erase Suspend
+   .resume_command       = MX25_OPI_PGMERS_RESUME_DTR,                  // Program/Erase Resume
    .status_dummy_cycles  = 4,                                           // 4 dummy cycles for status in DDR
   }
 };
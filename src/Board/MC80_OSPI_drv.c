@@ -217,7 +217,8 @@ static bool                 g_ospi_dma_event_flags_initialized = false;
 
 // Size of 64-byte block for optimized memory-mapped write operations
 // This value is coordinated with MC80_OSPI_CFG_COMBINATION_FUNCTION (64-byte)
-// for optimal hardware performance and combination write functionality
+// for optimal hardware performance and combination write functionality.
+// 64 bytes is the largest combined write, one block is one Page Program command on the bus.
 #define MC80_OSPI_BLOCK_WRITE_SIZE                       (64U)
 
 // Size of block for optimized memory-mapped read operations
@@ -248,6 +249,8 @@ static bool                 g_ospi_dma_event_flags_initialized = false;
 static bool                                _Mc80_ospi_status_sub(T_mc80_ospi_instance_ctrl *p_ctrl, uint8_t bit_pos);
 static fsp_err_t                           _Mc80_ospi_protocol_specific_settings(T_mc80_ospi_instance_ctrl *p_ctrl);
 static fsp_err_t                           _Mc80_ospi_memory_mapped_write_enable(T_mc80_ospi_instance_ctrl *p_ctrl);
+static fsp_err_t                           _Mc80_ospi_program_block(T_mc80_ospi_instance_ctrl *p_ctrl, uint8_t const *write_src, uint8_t *write_dest, uint32_t block_size);
+static bool                                _Mc80_ospi_block_is_erased(uint8_t const *p_data, uint32_t size);
 static void                                _Mc80_ospi_direct_transfer(T_mc80_ospi_instance_ctrl *p_ctrl, T_mc80_ospi_direct_transfer *const p_transfer, T_mc80_ospi_direct_transfer_dir direction);
 static T_mc80_ospi_xspi_command_set const *_Mc80_ospi_command_set_get(T_mc80_ospi_instance_ctrl *p_ctrl);
 static void                                _Mc80_ospi_xip(T_mc80_ospi_instance_ctrl *p_ctrl, bool is_entering);
@@ -855,7 +858,7 @@ fsp_err_t Mc80_ospi_memory_mapped_read(T_mc80_ospi_instance_ctrl *const p_ctrl,
     }
 
     // Configure DMA for current block transfer
-    p_transfer->p_cfg->p_info->p_src                         = (void const *)(memory_mapped_address + offset);
+    p_transfer->p_cfg->p_info->p_src                         = (void const *)(uintptr_t)(memory_mapped_address + offset);
     p_transfer->p_cfg->p_info->p_dest                        = (uint8_t *)p_dest + offset;
     p_transfer->p_cfg->p_info->transfer_settings_word_b.size = TRANSFER_SIZE_1_BYTE;
     p_transfer->p_cfg->p_info->transfer_settings_word_b.mode = TRANSFER_MODE_NORMAL;
@@ -915,27 +918,20 @@ fsp_err_t Mc80_ospi_memory_mapped_read(T_mc80_ospi_instance_ctrl *const p_ctrl,
   combined with DMA (Direct Memory Access) for efficient data transfer. The function automatically
   handles alignment and accepts any size data with any address offset.
 
-  Universal Write Operation Features:
-  - Accepts any destination address (automatic 64-byte alignment handling)
-  - Accepts any data size (no alignment restrictions)
-  - Automatically creates temporary 64-byte buffer for unaligned addresses
-  - Fills non-target bytes with 0xFF (erased flash state) in alignment buffer
-  - All data is written in optimized 64-byte blocks for maximum hardware performance
-  - Each block is written using a separate DMA transfer with write enable sequence
-
-  64-byte Alignment Algorithm:
-  1. For unaligned addresses or partial blocks:
-     - Use temporary buffer aligned to 64-byte boundary
-     - Fill buffer with 0xFF (erased state) and copy user data to correct offset
-     - Write full 64-byte aligned block to flash
-  2. For aligned full blocks:
-     - Write directly from source buffer to flash without temporary buffer
-  3. Continue until all data is written with proper address progression
-
-  Example: Write 100 bytes starting at address 0x800000E0 (32 bytes into 64-byte block)
-  - Block 1: temp_buffer[0-31]=0xFF, temp_buffer[32-63]=data[0-31] → write 64 bytes at 0x800000C0
-  - Block 2: temp_buffer[0-35]=data[32-67], temp_buffer[36-63]=0xFF → write 64 bytes at 0x80000100
-  - Block 3: temp_buffer[0-31]=data[68-99], temp_buffer[32-63]=0xFF → write 64 bytes at 0x80000140
+  Page-aware Write Operation:
+  - Data is processed page by page (MX25UM25645G page: 256 bytes), a program never crosses a page
+  - A page that is only partly written (unaligned head or tail of the write) is assembled in a
+    256-byte temporary buffer filled with 0xFF (erased flash state)
+  - A fully covered aligned page is transferred directly from the source buffer
+  - The controller combines a memory-mapped write into one Page Program command of at most 64 bytes
+    (MC80_OSPI_CFG_COMBINATION_FUNCTION, hardware maximum), and the device clears WEL after every
+    program, so a page is programmed as up to 4 blocks, each with write enable, DMA and WIP polling
+  - Blocks of the page that hold only 0xFF are skipped: they would not change the flash contents
+
+  Example: Write 100 bytes starting at address 0x800000E0 (224 bytes into 256-byte page)
+  - Page 0x80000000: temp_buffer[224-255]=data[0-31], block at 0x800000C0 is programmed,
+    blocks at 0x80000000-0x800000BF hold only 0xFF and are skipped
+  - Page 0x80000100: temp_buffer[0-67]=data[32-99], blocks at 0x80000100 and 0x80000140 are programmed
   Protocol and Operation Method:
   - Uses memory-mapped write mode where flash appears as regular system memory
   - Flash device is accessed via memory-mapped addresses (0x80000000 for Device 0, 0x90000000 for Device 1)
@@ -979,14 +975,10 @@ fsp_err_t Mc80_ospi_memory_mapped_write(T_mc80_ospi_instance_ctrl *p_ctrl, uint8
   dmac_extended_cfg_t const      *p_dmac_extend;
   R_DMAC0_Type                   *p_dma_reg;
   uint32_t                        bytes_remaining;
-  uint32_t                        current_block_size;
-  transfer_properties_t           transfer_properties;
-  uint8_t                         combo_bytes;
-  fsp_err_t                       status_err;
 
-  // 64-byte alignment handling variables
+  // Page alignment handling variables
   uint32_t dest_addr = (uint32_t)p_dest;
-  uint8_t  temp_buffer[MC80_OSPI_BLOCK_WRITE_SIZE];  // 64-byte temporary buffer
+  uint8_t  temp_buffer[MC80_OSPI_PRV_PAGE_SIZE_BYTES];  // Page assembly buffer for partly written pages
   uint32_t src_offset = 0;
 
   if (MC80_OSPI_CFG_PARAM_CHECKING_ENABLE)
@@ -1017,149 +1009,70 @@ fsp_err_t Mc80_ospi_memory_mapped_write(T_mc80_ospi_instance_ctrl *p_ctrl, uint8
   p_dma_reg                  = R_DMAC0 + (sizeof(R_DMAC0_Type) * p_dmac_extend->channel);
   p_dma_reg->DMBWR           = R_DMAC0_DMBWR_BWE_Msk;
 
-  // Process data with 64-byte alignment for optimal performance
   bytes_remaining            = byte_count;
-
-  // Handle data transfer with automatic 64-byte alignment
   uint32_t current_dest_addr = dest_addr;  // Track current destination address
 
   while (bytes_remaining > 0)
   {
-    uint8_t const *write_src;
-    uint8_t       *write_dest;
-
-    // Calculate 64-byte alignment for current address
-    uint32_t current_alignment_offset = current_dest_addr & (MC80_OSPI_BLOCK_WRITE_SIZE - 1);
-    uint32_t current_aligned_addr     = current_dest_addr & ~(MC80_OSPI_BLOCK_WRITE_SIZE - 1);
-
-    // Check if we need to handle alignment or partial block
-    if (current_alignment_offset != 0 || bytes_remaining < MC80_OSPI_BLOCK_WRITE_SIZE)
-    {
-      // Use temporary buffer for alignment or partial block
-      uint32_t available_space_in_block = MC80_OSPI_BLOCK_WRITE_SIZE - current_alignment_offset;
-      uint32_t bytes_to_copy            = (bytes_remaining < available_space_in_block) ? bytes_remaining : available_space_in_block;
-
-      // Always use full 64-byte block for proper alignment
-      current_block_size                = MC80_OSPI_BLOCK_WRITE_SIZE;
-
-      // Fill buffer with 0xFF (erased flash state)
-      memset(temp_buffer, 0xFF, MC80_OSPI_BLOCK_WRITE_SIZE);
-
-      // Copy user data to aligned position in buffer
-      memcpy(&temp_buffer[current_alignment_offset], &p_src[src_offset], bytes_to_copy);
-
-      write_src  = temp_buffer;
-      write_dest = (uint8_t *)current_aligned_addr;
-
-      // Update for next iteration
-      src_offset += bytes_to_copy;
-      bytes_remaining -= bytes_to_copy;
-      current_dest_addr += bytes_to_copy;
-    }
-    else
-    {
-      // Direct transfer for aligned full blocks
-      write_src          = p_src + src_offset;
-      write_dest         = (uint8_t *)current_dest_addr;
-      current_block_size = MC80_OSPI_BLOCK_WRITE_SIZE;
-
-      // Update for next iteration
-      src_offset += MC80_OSPI_BLOCK_WRITE_SIZE;
-      bytes_remaining -= MC80_OSPI_BLOCK_WRITE_SIZE;
-      current_dest_addr += MC80_OSPI_BLOCK_WRITE_SIZE;
-    }
-
-    // Configure DMA for current block transfer
-    p_transfer->p_cfg->p_info->p_src                         = write_src;
-    p_transfer->p_cfg->p_info->p_dest                        = write_dest;
-    p_transfer->p_cfg->p_info->transfer_settings_word_b.size = TRANSFER_SIZE_1_BYTE;
-    p_transfer->p_cfg->p_info->transfer_settings_word_b.mode = TRANSFER_MODE_NORMAL;
-    p_transfer->p_cfg->p_info->length                        = (uint16_t)current_block_size;
-
-    // Reconfigure DMA with current block settings
-    err                                                      = p_transfer->p_api->reconfigure(p_transfer->p_ctrl, p_transfer->p_cfg->p_info);
-    if (FSP_SUCCESS != err)
-    {
-      break;
-    }
-
-    // Enable write for current block
-    err = _Mc80_ospi_memory_mapped_write_enable(p_ctrl);
-    if (FSP_SUCCESS != err)
-    {
-      break;
-    }
-
-    // Clear DMA event flags before starting transfer
-    Mc80_ospi_dma_transfer_reset_flags();
+    uint8_t const *page_src;
 
-    // Start DMA transfer for current block
-    err = p_transfer->p_api->softwareStart(p_transfer->p_ctrl, TRANSFER_START_MODE_REPEAT);
-    if (FSP_SUCCESS != err)
+    // Part of the current page covered by the write
+    uint32_t page_offset = current_dest_addr & (MC80_OSPI_PRV_PAGE_SIZE_BYTES - 1);
+    uint32_t page_addr   = current_dest_addr - page_offset;
+    uint32_t page_bytes  = MC80_OSPI_PRV_PAGE_SIZE_BYTES - page_offset;
+    if (page_bytes > bytes_remaining)
     {
-      break;
+      page_bytes = bytes_remaining;
     }
 
-    // Wait for current block DMA completion
-    err = Mc80_ospi_dma_wait_for_completion(MS_TO_TICKS(OSPI_DMA_COMPLETION_TIMEOUT_MS));
-    if (FSP_SUCCESS != err)
+    if (page_bytes == MC80_OSPI_PRV_PAGE_SIZE_BYTES)
     {
-      break;  // DMA transfer failed or timed out
+      // Direct transfer for aligned full pages
+      page_src = p_src + src_offset;
     }
-
-    // Verify current block transfer completion status using infoGet
-    transfer_properties.transfer_length_remaining = 0U;  // Reset structure
-    err                                           = p_transfer->p_api->infoGet(p_transfer->p_ctrl, &transfer_properties);
-    if (FSP_SUCCESS != err)
-    {
-      break;
-    }
-
-    // Check if current block transfer completed successfully
-    if (transfer_properties.transfer_length_remaining > 0)
+    else
     {
-      err = FSP_ERR_TRANSFER_ABORTED;  // Transfer did not complete properly
-      break;
+      // Assemble a partly written page: 0xFF (erased flash state) around the user data
+      memset(temp_buffer, 0xFF, MC80_OSPI_PRV_PAGE_SIZE_BYTES);
+      memcpy(&temp_buffer[page_offset], &p_src[src_offset], page_bytes);
+      page_src = temp_buffer;
     }
 
-    // Handle combination write function for current block if needed
-    if (MC80_OSPI_COMBINATION_FUNCTION_DISABLE != MC80_OSPI_CFG_COMBINATION_FUNCTION)
+    // Program the blocks of the page that hold data
+    uint32_t block_offset = page_offset & ~(MC80_OSPI_BLOCK_WRITE_SIZE - 1);
+    uint32_t block_end    = page_offset + page_bytes;
+    for (; block_offset < block_end; block_offset += MC80_OSPI_BLOCK_WRITE_SIZE)
     {
-      combo_bytes = (uint8_t)(2U * ((uint8_t)MC80_OSPI_CFG_COMBINATION_FUNCTION + 1U));
-      if (current_block_size < combo_bytes)
+      if (_Mc80_ospi_block_is_erased(&page_src[block_offset], MC80_OSPI_BLOCK_WRITE_SIZE))
       {
-        p_reg->BMCTL1 = MC80_OSPI_PRV_BMCTL1_PUSH_COMBINATION_WRITE_MASK;
+        continue;
       }
-    }
-
-    // Wait for device ready status after completing block write operation
-    // Use hardware periodic polling to check write completion
-    if (_Mc80_ospi_periodic_status_start(p_ctrl, MC80_OSPI_WAIT_WIP_CLEAR_EXPECTED, MC80_OSPI_WAIT_WIP_CLEAR_MASK) == FSP_SUCCESS)
-    {
-      // Wait for periodic polling completion using hardware automation
-      status_err = Mc80_ospi_cmdcmp_wait_for_completion(MS_TO_TICKS(OSPI_PERIODIC_POLLING_TIMEOUT_MS));
-      _Mc80_ospi_periodic_status_stop(p_ctrl);
-
-      if (FSP_SUCCESS != status_err)
+      err = _Mc80_ospi_program_block(p_ctrl, &page_src[block_offset], (uint8_t *)(uintptr_t)(page_addr + block_offset), MC80_OSPI_BLOCK_WRITE_SIZE);
+      if (FSP_SUCCESS != err)
       {
-        err = status_err;  // Timeout or error in periodic polling
         break;
       }
     }
-    else
+    if (FSP_SUCCESS != err)
     {
-      // Failed to start periodic status polling, exit with error
-      err = FSP_ERR_WRITE_FAILED;
       break;
     }
 
-    // Move to next block
-    // Note: offset updates are handled in the alignment logic above
+    // Move to next page
+    src_offset += page_bytes;
+    bytes_remaining -= page_bytes;
+    current_dest_addr += page_bytes;
   }
 
   // Disable Octa-SPI DMA Bufferable Write
   p_dma_reg->DMBWR = 0U;
 
+  // If prefetch is enabled, flush the prefetch caches so that following memory-mapped reads see the new data
+  if (MC80_OSPI_CFG_PREFETCH_FUNCTION && FSP_SUCCESS == err)
+  {
+    p_reg->BMCTL1 = MC80_OSPI_PRV_BMCTL1_CLEAR_PREFETCH_MASK;
+  }
+
   return err;
 }
 
@@ -1384,6 +1297,224 @@ fsp_err_t Mc80_ospi_erase(T_mc80_ospi_instance_ctrl *p_ctrl, uint8_t *const p_de
   return err;
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Start erase of one 4KB sector or 64KB block and return without waiting. The device stays busy until
+  the erase ends, Mc80_ospi_erase_poll reports the end. While the erase runs only status, suspend and
+  resume commands may be sent; reads are possible after Mc80_ospi_erase_suspend.
+
+  Parameters:
+    p_ctrl           - Pointer to the control structure
+    p_device_address - Memory-mapped address aligned to erase_size
+    erase_size       - MX25UM25645G_SECTOR_SIZE or MX25UM25645G_BLOCK_SIZE
+
+  Return:
+    FSP_SUCCESS         - Erase command accepted
+    FSP_ERR_ASSERTION   - Invalid parameters, wrong alignment or no erase command of this size
+    FSP_ERR_NOT_OPEN    - Driver is not opened
+    FSP_ERR_NOT_ENABLED - Write enable failed
+-----------------------------------------------------------------------------------------------------*/
+fsp_err_t Mc80_ospi_erase_start(T_mc80_ospi_instance_ctrl *p_ctrl, uint8_t *const p_device_address, uint32_t erase_size)
+{
+  T_mc80_ospi_xspi_command_set const *p_cmd_set;
+  T_mc80_ospi_erase_command const    *p_erase_list;
+  T_mc80_ospi_direct_transfer         direct_command;
+  uint32_t                            chip_address_base;
+  uint32_t                            address;
+  uint16_t                            erase_command = 0;
+  fsp_err_t                           err;
+
+  if (MC80_OSPI_CFG_PARAM_CHECKING_ENABLE)
+  {
+    if (NULL == p_ctrl || NULL == p_device_address)
+    {
+      return FSP_ERR_ASSERTION;
+    }
+    if (MC80_OSPI_PRV_OPEN != p_ctrl->open)
+    {
+      return FSP_ERR_NOT_OPEN;
+    }
+  }
+
+  p_cmd_set = p_ctrl->p_cmd_set;
+  if ((NULL == p_cmd_set) || ((erase_size != MX25UM25645G_SECTOR_SIZE) && (erase_size != MX25UM25645G_BLOCK_SIZE)))
+  {
+    return FSP_ERR_ASSERTION;
+  }
+
+  chip_address_base = (p_ctrl->channel) ? MC80_OSPI_DEVICE_1_START_ADDRESS : MC80_OSPI_DEVICE_0_START_ADDRESS;
+  address           = (uint32_t)p_device_address - chip_address_base;
+  if ((address & (erase_size - 1)) != 0)
+  {
+    return FSP_ERR_ASSERTION;
+  }
+
+  p_erase_list = p_cmd_set->p_erase_commands->p_table;
+  for (uint32_t index = 0; index < p_cmd_set->p_erase_commands->length; index++)
+  {
+    if (p_erase_list[index].size == erase_size)
+    {
+      erase_command = p_erase_list[index].command;
+    }
+  }
+  if (0 == erase_command)
+  {
+    return FSP_ERR_ASSERTION;
+  }
+
+  err = _Mc80_ospi_memory_mapped_write_enable(p_ctrl);
+  if (FSP_SUCCESS != err)
+  {
+    return err;
+  }
+
+  direct_command.command        = erase_command;
+  direct_command.command_length = (uint8_t)p_cmd_set->command_bytes;
+  direct_command.address        = address;
+  direct_command.address_length = (uint8_t)(p_cmd_set->address_bytes + 1U);
+  direct_command.data_length    = 0;
+  direct_command.dummy_cycles   = 0;
+  _Mc80_ospi_direct_transfer(p_ctrl, &direct_command, MC80_OSPI_DIRECT_TRANSFER_DIR_WRITE);
+
+  return FSP_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Check if an erase started by Mc80_ospi_erase_start is still running. When it has ended the prefetch
+  buffer is flushed, so memory-mapped reads see the erased data.
+
+  Parameters:
+    p_ctrl - Pointer to the control structure
+    p_busy - true while the device is busy
+
+  Return:
+    FSP_SUCCESS       - Status read
+    FSP_ERR_ASSERTION - NULL pointer
+    FSP_ERR_NOT_OPEN  - Driver is not opened
+-----------------------------------------------------------------------------------------------------*/
+fsp_err_t Mc80_ospi_erase_poll(T_mc80_ospi_instance_ctrl *p_ctrl, bool *const p_busy)
+{
+  if (MC80_OSPI_CFG_PARAM_CHECKING_ENABLE)
+  {
+    if (NULL == p_ctrl || NULL == p_busy)
+    {
+      return FSP_ERR_ASSERTION;
+    }
+    if (MC80_OSPI_PRV_OPEN != p_ctrl->open)
+    {
+      return FSP_ERR_NOT_OPEN;
+    }
+  }
+
+  *p_busy = _Mc80_ospi_status_sub(p_ctrl, p_ctrl->p_cfg->write_status_bit);
+  if (!*p_busy && MC80_OSPI_CFG_PREFETCH_FUNCTION)
+  {
+    p_ctrl->p_reg->BMCTL1 = MC80_OSPI_PRV_BMCTL1_CLEAR_PREFETCH_MASK;
+  }
+  return FSP_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Suspend the running erase. Returns when the device is ready, after that reads outside the erased
+  sector or block are possible until Mc80_ospi_erase_resume. The device needs some erase time between
+  a resume and the next suspend, the caller spaces them.
+
+  Parameters:
+    p_ctrl - Pointer to the control structure
+
+  Return:
+    FSP_SUCCESS          - Erase suspended, or no erase was running
+    FSP_ERR_ASSERTION    - NULL pointer
+    FSP_ERR_NOT_OPEN     - Driver is not opened
+    FSP_ERR_UNSUPPORTED  - No suspend command in the command set of the current protocol
+    FSP_ERR_WRITE_FAILED - Status polling could not be started
+    FSP_ERR_TIMEOUT      - Device did not become ready
+-----------------------------------------------------------------------------------------------------*/
+fsp_err_t Mc80_ospi_erase_suspend(T_mc80_ospi_instance_ctrl *p_ctrl)
+{
+  if (MC80_OSPI_CFG_PARAM_CHECKING_ENABLE)
+  {
+    if (NULL == p_ctrl)
+    {
+      return FSP_ERR_ASSERTION;
+    }
+    if (MC80_OSPI_PRV_OPEN != p_ctrl->open)
+    {
+      return FSP_ERR_NOT_OPEN;
+    }
+  }
+  if (0 == p_ctrl->p_cmd_set->suspend_command)
+  {
+    return FSP_ERR_UNSUPPORTED;
+  }
+
+  T_mc80_ospi_direct_transfer direct_command = {
+    .command        = p_ctrl->p_cmd_set->suspend_command,
+    .command_length = (uint8_t)p_ctrl->p_cmd_set->command_bytes,
+    .address_length = 0,
+    .address        = 0,
+    .data_length    = 0,
+    .dummy_cycles   = 0,
+  };
+  _Mc80_ospi_direct_transfer(p_ctrl, &direct_command, MC80_OSPI_DIRECT_TRANSFER_DIR_WRITE);
+
+  // WIP is cleared when the device has suspended the erase (tens of microseconds)
+  if (_Mc80_ospi_periodic_status_start(p_ctrl, MC80_OSPI_WAIT_WIP_CLEAR_EXPECTED, MC80_OSPI_WAIT_WIP_CLEAR_MASK) != FSP_SUCCESS)
+  {
+    return FSP_ERR_WRITE_FAILED;
+  }
+  Mc80_ospi_cmdcmp_wait_for_completion(MS_TO_TICKS(OSPI_PERIODIC_POLLING_TIMEOUT_MS));
+  _Mc80_ospi_periodic_status_stop(p_ctrl);
+
+  if (_Mc80_ospi_status_sub(p_ctrl, p_ctrl->p_cfg->write_status_bit))
+  {
+    return FSP_ERR_TIMEOUT;
+  }
+  return FSP_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Resume an erase suspended by Mc80_ospi_erase_suspend. Returns without waiting for the erase.
+
+  Parameters:
+    p_ctrl - Pointer to the control structure
+
+  Return:
+    FSP_SUCCESS         - Resume command sent
+    FSP_ERR_ASSERTION   - NULL pointer
+    FSP_ERR_NOT_OPEN    - Driver is not opened
+    FSP_ERR_UNSUPPORTED - No resume command in the command set of the current protocol
+-----------------------------------------------------------------------------------------------------*/
+fsp_err_t Mc80_ospi_erase_resume(T_mc80_ospi_instance_ctrl *p_ctrl)
+{
+  if (MC80_OSPI_CFG_PARAM_CHECKING_ENABLE)
+  {
+    if (NULL == p_ctrl)
+    {
+      return FSP_ERR_ASSERTION;
+    }
+    if (MC80_OSPI_PRV_OPEN != p_ctrl->open)
+    {
+      return FSP_ERR_NOT_OPEN;
+    }
+  }
+  if (0 == p_ctrl->p_cmd_set->resume_command)
+  {
+    return FSP_ERR_UNSUPPORTED;
+  }
+
+  T_mc80_ospi_direct_transfer direct_command = {
+    .command        = p_ctrl->p_cmd_set->resume_command,
+    .command_length = (uint8_t)p_ctrl->p_cmd_set->command_bytes,
+    .address_length = 0,
+    .address        = 0,
+    .data_length    = 0,
+    .dummy_cycles   = 0,
+  };
+  _Mc80_ospi_direct_transfer(p_ctrl, &direct_command, MC80_OSPI_DIRECT_TRANSFER_DIR_WRITE);
+
+  return FSP_SUCCESS;
+}
+
 /*-----------------------------------------------------------------------------------------------------
   Gets the write or erase status of the flash.
 
@@ -1902,6 +2033,128 @@ static fsp_err_t _Mc80_ospi_memory_mapped_write_enable(T_mc80_ospi_instance_ctrl
   return FSP_SUCCESS;
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Program one block through the memory-mapped window: write enable, DMA of the block into the window
+  and hardware polling of WIP until the device finishes the Page Program command the controller issued
+  for the combined write.
+
+  Parameters:
+    p_ctrl     - Pointer to the control structure
+    write_src  - Block data
+    write_dest - Memory-mapped address of the block, inside one page
+    block_size - Number of bytes, up to MC80_OSPI_BLOCK_WRITE_SIZE
+
+  Return:
+    FSP_SUCCESS or the error of the failed step
+-----------------------------------------------------------------------------------------------------*/
+static fsp_err_t _Mc80_ospi_program_block(T_mc80_ospi_instance_ctrl *p_ctrl, uint8_t const *write_src, uint8_t *write_dest, uint32_t block_size)
+{
+  fsp_err_t                       err;
+  fsp_err_t                       status_err;
+  T_mc80_ospi_extended_cfg const *p_cfg_extend = p_ctrl->p_cfg->p_extend;
+  transfer_instance_t const      *p_transfer   = p_cfg_extend->p_lower_lvl_transfer;
+  transfer_properties_t           transfer_properties;
+  uint8_t                         combo_bytes;
+
+  // Configure DMA for current block transfer
+  p_transfer->p_cfg->p_info->p_src                         = write_src;
+  p_transfer->p_cfg->p_info->p_dest                        = write_dest;
+  p_transfer->p_cfg->p_info->transfer_settings_word_b.size = TRANSFER_SIZE_1_BYTE;
+  p_transfer->p_cfg->p_info->transfer_settings_word_b.mode = TRANSFER_MODE_NORMAL;
+  p_transfer->p_cfg->p_info->length                        = (uint16_t)block_size;
+
+  // Reconfigure DMA with current block settings
+  err                                                      = p_transfer->p_api->reconfigure(p_transfer->p_ctrl, p_transfer->p_cfg->p_info);
+  if (FSP_SUCCESS != err)
+  {
+    return err;
+  }
+
+  // Enable write for current block
+  err = _Mc80_ospi_memory_mapped_write_enable(p_ctrl);
+  if (FSP_SUCCESS != err)
+  {
+    return err;
+  }
+
+  // Clear DMA event flags before starting transfer
+  Mc80_ospi_dma_transfer_reset_flags();
+
+  // Start DMA transfer for current block
+  err = p_transfer->p_api->softwareStart(p_transfer->p_ctrl, TRANSFER_START_MODE_REPEAT);
+  if (FSP_SUCCESS != err)
+  {
+    return err;
+  }
+
+  // Wait for current block DMA completion
+  err = Mc80_ospi_dma_wait_for_completion(MS_TO_TICKS(OSPI_DMA_COMPLETION_TIMEOUT_MS));
+  if (FSP_SUCCESS != err)
+  {
+    return err;  // DMA transfer failed or timed out
+  }
+
+  // Verify current block transfer completion status using infoGet
+  transfer_properties.transfer_length_remaining = 0U;  // Reset structure
+  err                                           = p_transfer->p_api->infoGet(p_transfer->p_ctrl, &transfer_properties);
+  if (FSP_SUCCESS != err)
+  {
+    return err;
+  }
+
+  // Check if current block transfer completed successfully
+  if (transfer_properties.transfer_length_remaining > 0)
+  {
+    return FSP_ERR_TRANSFER_ABORTED;  // Transfer did not complete properly
+  }
+
+  // Handle combination write function for current block if needed
+  if (MC80_OSPI_COMBINATION_FUNCTION_DISABLE != MC80_OSPI_CFG_COMBINATION_FUNCTION)
+  {
+    combo_bytes = (uint8_t)(2U * ((uint8_t)MC80_OSPI_CFG_COMBINATION_FUNCTION + 1U));
+    if (block_size < combo_bytes)
+    {
+      p_ctrl->p_reg->BMCTL1 = MC80_OSPI_PRV_BMCTL1_PUSH_COMBINATION_WRITE_MASK;
+    }
+  }
+
+  // Wait for device ready status after completing block write operation
+  // Use hardware periodic polling to check write completion
+  if (_Mc80_ospi_periodic_status_start(p_ctrl, MC80_OSPI_WAIT_WIP_CLEAR_EXPECTED, MC80_OSPI_WAIT_WIP_CLEAR_MASK) != FSP_SUCCESS)
+  {
+    return FSP_ERR_WRITE_FAILED;  // Failed to start periodic status polling
+  }
+
+  // Wait for periodic polling completion using hardware automation
+  status_err = Mc80_ospi_cmdcmp_wait_for_completion(MS_TO_TICKS(OSPI_PERIODIC_POLLING_TIMEOUT_MS));
+  _Mc80_ospi_periodic_status_stop(p_ctrl);
+
+  return status_err;  // Timeout or error in periodic polling
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Check if a block holds only 0xFF. Programming 0xFF leaves NOR cells unchanged, such a block
+  needs no program command.
+
+  Parameters:
+    p_data - block data
+    size   - number of bytes
+
+  Return:
+    true if every byte is 0xFF
+-----------------------------------------------------------------------------------------------------*/
+static bool _Mc80_ospi_block_is_erased(uint8_t const *p_data, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; i++)
+  {
+    if (p_data[i] != 0xFFU)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 /*-----------------------------------------------------------------------------------------------------
   Direct transfer implementation - executes manual OSPI commands outside of memory-mapped mode.
 
@@ -2387,7 +2640,6 @@ static void _Mc80_ospi_xip(T_mc80_ospi_instance_ctrl *p_ctrl, bool is_entering)
   R_XSPI0_Type *const    p_reg = p_ctrl->p_reg;
   const T_mc80_ospi_cfg *p_cfg = p_ctrl->p_cfg;
   volatile uint8_t      *p_dummy_read_address;
-  volatile uint8_t       dummy_read = 0;
 
   if (MC80_OSPI_DEVICE_NUMBER_0 == p_ctrl->channel)
   {
@@ -2427,7 +2679,7 @@ static void _Mc80_ospi_xip(T_mc80_ospi_instance_ctrl *p_ctrl, bool is_entering)
     p_reg->CMCTLCH[1] = cmctlch;
 
     // Perform a read to send the enter code. All further reads will use the enter code and will not send a read command code
-    dummy_read        = *p_dummy_read_address;
+    (void)*p_dummy_read_address;
 
     // Wait for the read to complete
     OSPI_DEBUG_LOOP_START(OSPI_DEBUG_LOOP_XIP_ENTER_READ_WAIT);
@@ -2445,7 +2697,7 @@ static void _Mc80_ospi_xip(T_mc80_ospi_instance_ctrl *p_ctrl, bool is_entering)
     p_reg->CMCTLCH[1] &= ~OSPI_CMCTLCHn_XIPEN_Msk;
 
     // Perform a read to send the exit code. All further reads will not send an exit code
-    dummy_read = *p_dummy_read_address;
+    (void)*p_dummy_read_address;
 
     // Wait for the read to complete
     OSPI_DEBUG_LOOP_START(OSPI_DEBUG_LOOP_XIP_EXIT_READ_WAIT);
@@ -2561,7 +2813,7 @@ void Mc80_ospi_dma_transfer_reset_flags(void)
   // Clear RTOS event flags if initialized
   if (g_ospi_dma_event_flags_initialized)
   {
-    tx_event_flags_set(&g_ospi_dma_event_flags, ~OSPI_DMA_EVENT_ALL_EVENTS, TX_AND);
+    tx_event_flags_set(&g_ospi_dma_event_flags, (ULONG)~OSPI_DMA_EVENT_ALL_EVENTS, TX_AND);
   }
 }
 
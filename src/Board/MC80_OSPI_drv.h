@@ -448,6 +448,8 @@ typedef struct st_mc80_ospi_xspi_command_set
   uint16_t                  program_command;       // Memory program/write command
   uint16_t                  write_enable_command;  // Command to enable write or erase, set to 0x00 to ignore
   uint16_t                  status_command;        // Command to read the write status, set to 0x00 to ignore
+  uint16_t                  suspend_command;       // Program/erase suspend command, set to 0x00 if not supported
+  uint16_t                  resume_command;        // Program/erase resume command, set to 0x00 if not supported
   uint8_t                   read_dummy_cycles;     // Dummy cycles to be inserted for read commands
   uint8_t                   program_dummy_cycles;  // Dummy cycles to be inserted for page program commands
   uint8_t                   status_dummy_cycles;   // Dummy cycles to be inserted for status read commands
@@ -546,6 +548,10 @@ fsp_err_t Mc80_ospi_xip_enter(T_mc80_ospi_instance_ctrl* const p_ctrl);
 fsp_err_t Mc80_ospi_xip_exit(T_mc80_ospi_instance_ctrl* const p_ctrl);
 fsp_err_t Mc80_ospi_memory_mapped_write(T_mc80_ospi_instance_ctrl* const p_ctrl, uint8_t const* const p_src, uint8_t* const p_dest, uint32_t byte_count);
 fsp_err_t Mc80_ospi_erase(T_mc80_ospi_instance_ctrl* const p_ctrl, uint8_t* const p_device_address, uint32_t byte_count);
+fsp_err_t Mc80_ospi_erase_start(T_mc80_ospi_instance_ctrl* const p_ctrl, uint8_t* const p_device_address, uint32_t erase_size);
+fsp_err_t Mc80_ospi_erase_poll(T_mc80_ospi_instance_ctrl* const p_ctrl, bool* const p_busy);
+fsp_err_t Mc80_ospi_erase_suspend(T_mc80_ospi_instance_ctrl* const p_ctrl);
+fsp_err_t Mc80_ospi_erase_resume(T_mc80_ospi_instance_ctrl* const p_ctrl);
 fsp_err_t Mc80_ospi_status_get(T_mc80_ospi_instance_ctrl* const p_ctrl, T_mc80_ospi_status* const p_status);
 fsp_err_t Mc80_ospi_read_id(T_mc80_ospi_instance_ctrl* const p_ctrl, uint8_t* const p_id, uint32_t id_length);
 fsp_err_t Mc80_ospi_bank_set(T_mc80_ospi_instance_ctrl* const p_ctrl, uint32_t bank);
@@ -0,0 +1,182 @@
+#include "App.h"
+
+static uint32_t _Can_afl_free_bits(uint32_t mask);
+static void     _Can_afl_add(T_can_afl_rule *rules, uint32_t *p_cnt, T_can_afl_rule rule);
+
+/*-----------------------------------------------------------------------------------------------------
+  Count ID bits a rule does not compare, the rule accepts 2^n IDs
+
+  Parameters:
+    mask - rule mask
+
+  Return:
+    Number of not compared bits of the 29-bit ID
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Can_afl_free_bits(uint32_t mask)
+{
+  uint32_t n = 0;
+
+  mask = ~mask & CAN_RX_MASK_EXACT;
+  while (mask != 0)
+  {
+    mask &= mask - 1;
+    n++;
+  }
+  return n;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Add a rule to the list. Nothing is added if a rule of the list already covers it,
+  rules the new one covers are removed.
+
+  Parameters:
+    rules - rule list with space for one more rule
+    p_cnt - number of rules in the list, updated
+    rule  - rule to add
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Can_afl_add(T_can_afl_rule *rules, uint32_t *p_cnt, T_can_afl_rule rule)
+{
+  uint32_t i;
+  uint32_t n = 0;
+
+  for (i = 0; i < *p_cnt; i++)
+  {
+    if (Can_afl_rule_covers(&rules[i], &rule))
+    {
+      return;
+    }
+  }
+  for (i = 0; i < *p_cnt; i++)
+  {
+    if (!Can_afl_rule_covers(&rule, &rules[i]))
+    {
+      rules[n++] = rules[i];
+    }
+  }
+  rules[n++] = rule;
+  *p_cnt     = n;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Check if every ID accepted by a filter is also accepted by a rule
+
+  Parameters:
+    rule   - acceptance rule
+    filter - ID and mask of a handler
+
+  Return:
+    true if the rule accepts all IDs of the filter
+-----------------------------------------------------------------------------------------------------*/
+bool Can_afl_rule_covers(const T_can_afl_rule *rule, const T_can_afl_rule *filter)
+{
+  return ((filter->mask & rule->mask) == rule->mask) && ((filter->id & rule->mask) == rule->id);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Build acceptance rules for a set of handler filters. Duplicate and covered filters take no rule.
+  While there are more rules than max_rules, the pair whose merged rule accepts the fewest IDs beyond
+  those two rules is replaced by the merged rule: it compares only the bits both rules compare and
+  in which their IDs are equal.
+
+  Parameters:
+    filters    - IDs and masks of the handlers
+    filter_cnt - number of filters, up to CAN_RX_HANDLER_MAX
+    rules      - output rules
+    max_rules  - number of available hardware rules
+
+  Return:
+    Number of rules written, 0 if there are no filters or the arguments are out of range
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Can_afl_build(const T_can_afl_rule *filters, uint32_t filter_cnt, T_can_afl_rule *rules, uint32_t max_rules)
+{
+  T_can_afl_rule work[CAN_RX_HANDLER_MAX];
+  T_can_afl_rule rule;
+  T_can_afl_rule merged;
+  uint32_t       cnt = 0;
+  uint32_t       best_i;
+  uint32_t       best_j;
+  int64_t        best_cost;
+  int64_t        cost;
+
+  if ((filter_cnt > CAN_RX_HANDLER_MAX) || (max_rules == 0))
+  {
+    return 0;
+  }
+
+  for (uint32_t i = 0; i < filter_cnt; i++)
+  {
+    rule.mask = filters[i].mask & CAN_RX_MASK_EXACT;
+    rule.id   = filters[i].id & rule.mask;
+    _Can_afl_add(work, &cnt, rule);
+  }
+
+  while (cnt > max_rules)
+  {
+    best_i    = 0;
+    best_j    = 1;
+    best_cost = INT64_MAX;
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+      for (uint32_t j = i + 1; j < cnt; j++)
+      {
+        merged.mask = work[i].mask & work[j].mask & ~(work[i].id ^ work[j].id);
+        cost        = (int64_t)(1ull << _Can_afl_free_bits(merged.mask)) -
+                      (int64_t)(1ull << _Can_afl_free_bits(work[i].mask)) -
+                      (int64_t)(1ull << _Can_afl_free_bits(work[j].mask));
+        if (cost < best_cost)
+        {
+          best_cost = cost;
+          best_i    = i;
+          best_j    = j;
+        }
+      }
+    }
+
+    merged.mask  = work[best_i].mask & work[best_j].mask & ~(work[best_i].id ^ work[best_j].id);
+    merged.id    = work[best_i].id & merged.mask;
+    // Remove the pair, best_j > best_i so best_j goes first
+    work[best_j] = work[--cnt];
+    work[best_i] = work[--cnt];
+    _Can_afl_add(work, &cnt, merged);
+  }
+
+  memcpy(rules, work, cnt * sizeof(T_can_afl_rule));
+  return cnt;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Verify that the rules accept every ID of every filter
+
+  Parameters:
+    filters    - IDs and masks of the handlers
+    filter_cnt - number of filters
+    rules      - acceptance rules
+    rule_cnt   - number of rules
+
+  Return:
+    Number of filters not covered by a single rule, 0 if the rules accept all handler IDs
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Can_afl_check_coverage(const T_can_afl_rule *filters, uint32_t filter_cnt, const T_can_afl_rule *rules, uint32_t rule_cnt)
+{
+  uint32_t uncovered = 0;
+  uint32_t r;
+
+  for (uint32_t i = 0; i < filter_cnt; i++)
+  {
+    for (r = 0; r < rule_cnt; r++)
+    {
+      if (Can_afl_rule_covers(&rules[r], &filters[i]))
+      {
+        break;
+      }
+    }
+    if (r == rule_cnt)
+    {
+      uncovered++;
+    }
+  }
+  return uncovered;
+}
@@ -0,0 +1,20 @@
+#ifndef CAN_AFL_H
+#define CAN_AFL_H
+
+// Acceptance filter list (AFL) generated from the IDs and masks of the registered RX handlers.
+// A rule accepts a 29-bit ID if (ID & mask) == id. When the handlers need more rules than the hardware has,
+// the two rules whose merge accepts the fewest additional IDs are merged until the list fits.
+
+#define CAN_AFL_ACCEPT_ALL 0  // 1 - accept every extended ID as before, for watching the whole bus in the CAN monitor
+
+typedef struct
+{
+  uint32_t id;    // ID bits compared under the mask
+  uint32_t mask;  // Bit set - ID bit is compared, only bits of CAN_RX_MASK_EXACT are used
+} T_can_afl_rule;
+
+uint32_t Can_afl_build(const T_can_afl_rule *filters, uint32_t filter_cnt, T_can_afl_rule *rules, uint32_t max_rules);
+bool     Can_afl_rule_covers(const T_can_afl_rule *rule, const T_can_afl_rule *filter);
+uint32_t Can_afl_check_coverage(const T_can_afl_rule *filters, uint32_t filter_cnt, const T_can_afl_rule *rules, uint32_t rule_cnt);
+
+#endif  // CAN_AFL_H
@@ -1,16 +1,23 @@
 #include "App.h"
 
-// Global variable for saving CAN callback when disabling command processing
-static T_can_rx_callback g_original_can_callback = NULL;
-
 // Global flag indicating CAN command processing state (1 = enabled, 0 = disabled)
 uint8_t g_can_command_processing_enabled         = 1;
 
 // Forward declarations
-static void     _Can_message_handler_callback(const T_can_msg* rx_msg);
-static void     _Handle_request_state_to_all(void);
+static void     _Handle_request_state_to_all(const T_can_msg* rx_msg);
 static void     _Handle_request_sys_control(const T_can_msg* rx_msg);
-static void     _Send_motor_status_packets(uint8_t motor_id);
+static void     _Handle_hard_stop_isr(const T_can_msg* rx_msg);
+static void     _Handle_param_message(const T_can_msg* rx_msg);
+static bool     _Is_motor_hard_stopped(uint8_t motor_num);
+static void     _Send_motor_status_packets(uint8_t motor_id, bool with_telemetry);
+static void     _Send_fd_telemetry(void);
+static void     _Fill_status_packet(uint8_t motor_id, T_can_status_packet1* status_packet);
+static void     _Fill_sensor_packet(uint8_t motor_id, T_can_status_packet2* sensor_packet);
+static void     _Fill_power_packet(uint8_t motor_id, T_can_status_packet3* power_packet);
+static bool     _Tlm_ans_changed(const T_can_status_packet1* cur, const T_can_status_packet1* last);
+static bool     _Tlm_sens_changed(const T_can_status_packet2* cur, const T_can_status_packet2* last);
+static bool     _Tlm_pwr_changed(const T_can_status_packet3* cur, const T_can_status_packet3* last);
+static bool     _Tlm_exceeds(int32_t cur, int32_t last, int32_t deadband);
 static void     _Control_motor_from_system_command(uint8_t motor_num, uint32_t up_bit, uint32_t down_bit, uint32_t stop_bit, uint32_t hard_stop_bit, const T_sys_control* cmd);
 static uint16_t _Get_movement_info(uint8_t motor_num);
 static uint16_t _Get_position_sensor_value(uint8_t motor_id);
@@ -22,8 +29,65 @@ static int16_t  _Get_motor_current_x10(uint8_t motor_id);
 
 extern T_adc_cbl adc;  // Access to ADC data structure
 
+// CAN IDs of the status packets and the physical motor of each motor controller ID (1-4)
+// clang-format off
+static const struct
+{
+  uint32_t ans_id;
+  uint32_t sens_id;
+  uint32_t pwr_id;
+  uint8_t  motor_num;
+} g_can_motor_map[] =
+{
+  { MOT3_ANS,         MOT3_SENS_INFO,         MOT3_PWR_INFO,         MOTOR_3_ },  // MOT3_ID
+  { MOT4_ANS,         MOT4_SENS_INFO,         MOT4_PWR_INFO,         MOTOR_4_ },  // MOT4_ID
+  { MOT2_ANS,         MOT2_SENS_INFO,         MOT2_PWR_INFO,         MOTOR_2_ },  // MOT2_ID
+  { TRACTION_MOT_ANS, TRACTION_MOT_SENS_INFO, TRACTION_MOT_PWR_INFO, MOTOR_1_ },  // TRACTION_MOT_ID
+};
+// clang-format on
+
+#define CAN_MOTOR_ID_COUNT (sizeof(g_can_motor_map) / sizeof(g_can_motor_map[0]))
+
+// Last published telemetry of one motor controller, only used from the main task
+typedef struct
+{
+  bool                 sent[CAN_TLM_MSG_COUNT];     // A frame was published, the packet below is valid
+  uint32_t             tx_time[CAN_TLM_MSG_COUNT];  // tx_time_get() of the last frame
+  T_can_status_packet1 ans;
+  T_can_status_packet2 sens;
+  T_can_status_packet3 pwr;
+} T_can_tlm_motor;
+
+static T_can_tlm_motor       g_can_tlm[CAN_MOTOR_ID_COUNT];
+static T_can_telemetry_stats g_can_tlm_stats;
+
+// Handlers of the frames this node accepts. Emulates 4 motor controllers responding to central controller commands.
+// clang-format off
+static const struct
+{
+  uint32_t          can_id;
+  T_can_rx_callback task_handler;
+  T_can_rx_callback isr_handler;
+} g_can_msg_handlers[] =
+{
+  { REQUEST_STATE_TO_ALL,    _Handle_request_state_to_all, NULL },
+#if CAN_HARD_STOP_IN_ISR
+  { REQUEST_SYS_CONTROL,     _Handle_request_sys_control,  _Handle_hard_stop_isr },
+#else
+  { REQUEST_SYS_CONTROL,     _Handle_request_sys_control,  NULL },
+#endif
+  { MC80_PARAM_RD,           _Handle_param_message,        NULL },
+  { MC80_PARAM_WR,           _Handle_param_message,        NULL },
+  { MC80_PARAM_SAVE,         _Handle_param_message,        NULL },
+  { MC80_RESET,              _Handle_param_message,        NULL },
+  { MC80_CLEAR_MOTOR_ERRORS, _Handle_param_message,        NULL },
+  { MC80_PARAM_TXN,          _Handle_param_message,        NULL },
+  { MC80_PARAM_BULK_RD,      _Handle_param_message,        NULL },
+};
+// clang-format on
+
 /*-----------------------------------------------------------------------------------------------------
-  Initialize CAN message handler by setting up the callback function
+  Initialize CAN message handler by registering the handlers of all accepted CAN IDs
 
   Parameters:
     None
@@ -33,7 +97,13 @@ extern T_adc_cbl adc;  // Access to ADC data structure
 -----------------------------------------------------------------------------------------------------*/
 void Can_message_handler_init(void)
 {
-  Can_set_rx_callback(_Can_message_handler_callback);
+  for (uint32_t i = 0; i < sizeof(g_can_msg_handlers) / sizeof(g_can_msg_handlers[0]); i++)
+  {
+    if (Can_rx_register_handler(g_can_msg_handlers[i].can_id, CAN_RX_MASK_EXACT, g_can_msg_handlers[i].task_handler, g_can_msg_handlers[i].isr_handler) != RES_OK)
+    {
+      APPLOG("CAN Handler: Failed to register handler for ID 0x%08X", (unsigned int)g_can_msg_handlers[i].can_id);
+    }
+  }
 
   // Initialize parameter exchange module
   Can_param_exchange_init();
@@ -43,61 +113,98 @@ void Can_message_handler_init(void)
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  CAN message reception callback handler. Processes incoming CAN messages.
-  Emulates 4 motor controllers responding to central controller commands.
+  Handle parameter configuration protocol messages
 
   Parameters:
-    rx_msg - Pointer to received CAN message structure
+    rx_msg - Pointer to received CAN message
 
   Return:
     None
 -----------------------------------------------------------------------------------------------------*/
-static void _Can_message_handler_callback(const T_can_msg* rx_msg)
+static void _Handle_param_message(const T_can_msg* rx_msg)
 {
-  if (rx_msg == NULL)
+  Can_param_process_message(rx_msg);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Apply hard stop bits of REQUEST_SYS_CONTROL in the RX interrupt. Braking starts a few microseconds
+  after the frame is received instead of after the RX task and the motor task are scheduled.
+  The same frame is then processed by _Handle_request_sys_control in the RX task, which finds the
+  motors already stopped and handles the remaining bits.
+
+  Parameters:
+    rx_msg - Pointer to received CAN message containing control bits
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Handle_hard_stop_isr(const T_can_msg* rx_msg)
+{
+  // clang-format off
+  static const struct
+  {
+    uint8_t  motor_num;
+    uint32_t hard_stop_bit;
+  } hard_stops[] =
+  {
+    { MOTOR_3_, MOT3_HARD_STOP_BIT },
+    { MOTOR_4_, MOT4_HARD_STOP_BIT },
+    { MOTOR_2_, MOT2_HARD_STOP_BIT },
+    { MOTOR_1_, MOT_HARD_STOP_BIT  },
+  };
+  // clang-format on
+  uint32_t control_word;
+
+  if (rx_msg->dlc < 4)
   {
     return;
   }
-  // Process different message types based on CAN ID
-  switch (rx_msg->can_id)
+  memcpy(&control_word, rx_msg->data, 4);
+
+  for (uint32_t i = 0; i < sizeof(hard_stops) / sizeof(hard_stops[0]); i++)
   {
-    case REQUEST_STATE_TO_ALL:
-      // Central controller requests status from all motor controllers
-      _Handle_request_state_to_all();
-      break;
+    if ((control_word & hard_stops[i].hard_stop_bit) && !_Is_motor_hard_stopped(hard_stops[i].motor_num))
+    {
+      Motor_emergency_stop_from_isr(hard_stops[i].motor_num);
+    }
+  }
+}
 
-    case REQUEST_SYS_CONTROL:
-      // Central controller sends system control commands
-      _Handle_request_sys_control(rx_msg);
-      break;
-    case MC80_PARAM_RD:
-    case MC80_PARAM_WR:
-    case MC80_PARAM_SAVE:
-    case MC80_RESET:
-    case MC80_CLEAR_MOTOR_ERRORS:
-      // Parameter configuration protocol messages
-      Can_param_process_message(rx_msg);
-      break;
+/*-----------------------------------------------------------------------------------------------------
+  Check if a motor is already stopped, a repeated hard stop is ignored
 
-    default:
-      // Log unknown message for debugging
-      APPLOG("CAN Handler: Unknown message ID 0x%08X", rx_msg->can_id);
-      break;
-  }
+  Parameters:
+    motor_num - Physical motor number (1-4)
+
+  Return:
+    true if the motor is disabled and idle or coasting
+-----------------------------------------------------------------------------------------------------*/
+static bool _Is_motor_hard_stopped(uint8_t motor_num)
+{
+  T_motor_extended_state* motor_state = Motor_get_extended_state(motor_num);
+
+  return (motor_state != NULL &&
+          motor_state->enabled == 0 &&
+          motor_state->direction == MOTOR_DIRECTION_STOP &&
+          (motor_state->soft_start_state == MOTOR_STATE_IDLE || motor_state->soft_start_state == MOTOR_STATE_COASTING));
 }
 
 /*-----------------------------------------------------------------------------------------------------
   Handle REQUEST_STATE_TO_ALL command from central controller.
   Updates TMC6200 error status and sends 3 status packets for each of the 4 motor controllers.
+  A request sent as CAN FD frame is answered with the 4 status packets and one CAN FD frame
+  carrying sensor and power data of all motors.
 
   Parameters:
-    None
+    rx_msg - Pointer to received CAN message
 
   Return:
     None
 -----------------------------------------------------------------------------------------------------*/
-static void _Handle_request_state_to_all(void)
+static void _Handle_request_state_to_all(const T_can_msg* rx_msg)
 {
+  bool fd = CAN_MSG_IS_FD(rx_msg);
+
   // Update TMC6200 driver status from monitoring data before sending status packets
   T_tmc6200_driver_status driver1_status;
   T_tmc6200_driver_status driver2_status;
@@ -116,10 +223,15 @@ static void _Handle_request_state_to_all(void)
   }
 
   // Send status packets for all 4 motor controllers
-  _Send_motor_status_packets(MOT3_ID);
-  _Send_motor_status_packets(MOT4_ID);
-  _Send_motor_status_packets(MOT2_ID);
-  _Send_motor_status_packets(TRACTION_MOT_ID);
+  _Send_motor_status_packets(MOT3_ID, !fd);
+  _Send_motor_status_packets(MOT4_ID, !fd);
+  _Send_motor_status_packets(MOT2_ID, !fd);
+  _Send_motor_status_packets(TRACTION_MOT_ID, !fd);
+
+  if (fd)
+  {
+    _Send_fd_telemetry();
+  }
 }
 
 /*-----------------------------------------------------------------------------------------------------
@@ -212,71 +324,318 @@ static void _Handle_request_sys_control(const T_can_msg* rx_msg)
   Packet 3: Power information (8 bytes) - MC80_PWR_INFO
 
   Parameters:
-    motor_id - Motor controller ID (1-4)
+    motor_id       - Motor controller ID (1-4)
+    with_telemetry - false to send only packet 1, packets 2 and 3 go in the CAN FD telemetry frame
 
   Return:
     None
 -----------------------------------------------------------------------------------------------------*/
-static void _Send_motor_status_packets(uint8_t motor_id)
+static void _Send_motor_status_packets(uint8_t motor_id, bool with_telemetry)
 {
-  uint32_t base_ans_id  = 0;
-  uint32_t base_sens_id = 0;
-  uint32_t base_pwr_id  = 0;
-  uint8_t  motor_num    = 0;
-  // Map motor controller IDs to CAN IDs and physical motor numbers
-  switch (motor_id)
+  if ((motor_id < MOT3_ID) || (motor_id > TRACTION_MOT_ID))
   {
-    case MOT3_ID:
-      base_ans_id  = MOT3_ANS;
-      base_sens_id = MOT3_SENS_INFO;
-      base_pwr_id  = MOT3_PWR_INFO;
-      motor_num    = MOTOR_3_;
-      break;
-    case MOT4_ID:
-      base_ans_id  = MOT4_ANS;
-      base_sens_id = MOT4_SENS_INFO;
-      base_pwr_id  = MOT4_PWR_INFO;
-      motor_num    = MOTOR_4_;
-      break;
-    case MOT2_ID:
-      base_ans_id  = MOT2_ANS;
-      base_sens_id = MOT2_SENS_INFO;
-      base_pwr_id  = MOT2_PWR_INFO;
-      motor_num    = MOTOR_2_;
-      break;
-    case TRACTION_MOT_ID:
-      base_ans_id  = TRACTION_MOT_ANS;
-      base_sens_id = TRACTION_MOT_SENS_INFO;
-      base_pwr_id  = TRACTION_MOT_PWR_INFO;
-      motor_num    = MOTOR_1_;
-      break;
-    default:
-      return;  // Invalid motor ID
+    return;  // Invalid motor ID
   }
+
   // Packet 1: Basic status (7 bytes)
-  T_can_status_packet1 status_packet = { 0 };
-  status_packet.command_code         = MC80_REQ_STATUS;
-  status_packet.error_flags          = App_get_error_flags();
-  status_packet.movement_info        = _Get_movement_info(motor_num);
+  T_can_status_packet1 status_packet;
+  _Fill_status_packet(motor_id, &status_packet);
+  Can_send_extended_data(g_can_motor_map[motor_id - 1].ans_id, (uint8_t*)&status_packet, sizeof(status_packet));
 
-  Can_send_extended_data(base_ans_id, (uint8_t*)&status_packet, sizeof(status_packet));
+  if (!with_telemetry)
+  {
+    return;
+  }
 
   // Packet 2: Sensor information (8 bytes)
-  T_can_status_packet2 sensor_packet = { 0 };
-  sensor_packet.position_sensor      = _Get_position_sensor_value(motor_id);
-  sensor_packet.motor_rpm            = 0;  // Always 0 as specified
-  sensor_packet.driver_temp_x10      = _Get_driver_temperature_x10(motor_id);
-
-  Can_send_extended_data(base_sens_id, (uint8_t*)&sensor_packet, sizeof(sensor_packet));
+  T_can_status_packet2 sensor_packet;
+  _Fill_sensor_packet(motor_id, &sensor_packet);
+  Can_send_extended_data(g_can_motor_map[motor_id - 1].sens_id, (uint8_t*)&sensor_packet, sizeof(sensor_packet));
 
   // Packet 3: Power information (8 bytes)
-  T_can_status_packet3 power_packet = { 0 };
-  power_packet.input_voltage_x10    = _Get_input_voltage_x10();
-  power_packet.input_current_x10    = _Get_input_current_x10(motor_id);
-  power_packet.input_power_x10      = _Get_input_power_x10(motor_id);
-  power_packet.motor_current_x10    = _Get_motor_current_x10(motor_id);
+  T_can_status_packet3 power_packet;
+  _Fill_power_packet(motor_id, &power_packet);
+  Can_send_extended_data(g_can_motor_map[motor_id - 1].pwr_id, (uint8_t*)&power_packet, sizeof(power_packet));
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Send sensor and power information of all 4 motor controllers in one 64 byte CAN FD frame.
+  Replaces 8 classic frames (packets 2 and 3 of every motor).
+
+  Parameters:
+    None
 
-  Can_send_extended_data(base_pwr_id, (uint8_t*)&power_packet, sizeof(power_packet));
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Send_fd_telemetry(void)
+{
+  T_can_fd_telemetry telemetry;
+
+  for (uint8_t motor_id = MOT3_ID; motor_id <= TRACTION_MOT_ID; motor_id++)
+  {
+    _Fill_sensor_packet(motor_id, &telemetry.motor[motor_id - 1].sens);
+    _Fill_power_packet(motor_id, &telemetry.motor[motor_id - 1].pwr);
+  }
+  Can_send_fd_data(MC80_SENS_INFO, (const uint8_t*)&telemetry, sizeof(telemetry));
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Fill packet 1 (basic status) for a specific motor controller
+
+  Parameters:
+    motor_id      - Motor controller ID (1-4)
+    status_packet - Packet to fill
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Fill_status_packet(uint8_t motor_id, T_can_status_packet1* status_packet)
+{
+  memset(status_packet, 0, sizeof(T_can_status_packet1));
+  status_packet->command_code  = MC80_REQ_STATUS;
+  status_packet->error_flags   = App_get_error_flags();
+  status_packet->movement_info = _Get_movement_info(g_can_motor_map[motor_id - 1].motor_num);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Fill packet 2 (sensor information) for a specific motor controller
+
+  Parameters:
+    motor_id      - Motor controller ID (1-4)
+    sensor_packet - Packet to fill
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Fill_sensor_packet(uint8_t motor_id, T_can_status_packet2* sensor_packet)
+{
+  sensor_packet->position_sensor = _Get_position_sensor_value(motor_id);
+  sensor_packet->motor_rpm       = 0;  // Always 0 as specified
+  sensor_packet->driver_temp_x10 = _Get_driver_temperature_x10(motor_id);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Fill packet 3 (power information) for a specific motor controller
+
+  Parameters:
+    motor_id     - Motor controller ID (1-4)
+    power_packet - Packet to fill
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Fill_power_packet(uint8_t motor_id, T_can_status_packet3* power_packet)
+{
+  power_packet->input_voltage_x10 = _Get_input_voltage_x10();
+  power_packet->input_current_x10 = _Get_input_current_x10(motor_id);
+  power_packet->input_power_x10   = _Get_input_power_x10(motor_id);
+  power_packet->motor_current_x10 = _Get_motor_current_x10(motor_id);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Check if a value moved from the last published one by the deadband or more
+
+  Parameters:
+    cur      - current value
+    last     - last published value
+    deadband - deadband in the units of the value, 0 - changes of the value do not trigger a frame
+
+  Return:
+    true if a frame has to be sent
+-----------------------------------------------------------------------------------------------------*/
+static bool _Tlm_exceeds(int32_t cur, int32_t last, int32_t deadband)
+{
+  int32_t diff = cur - last;
+
+  if (deadband <= 0)
+  {
+    return false;
+  }
+  if (diff < 0)
+  {
+    diff = -diff;
+  }
+  return diff >= deadband;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Check if the status changed: error flags, motor state or active bit. PWM changes during a ramp
+  do not trigger a frame, they are published with the period.
+
+  Parameters:
+    cur  - current packet
+    last - last published packet
+
+  Return:
+    true if a frame has to be sent
+-----------------------------------------------------------------------------------------------------*/
+static bool _Tlm_ans_changed(const T_can_status_packet1* cur, const T_can_status_packet1* last)
+{
+  return (cur->error_flags != last->error_flags) || ((cur->movement_info & 0xFF) != (last->movement_info & 0xFF));
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Check if the position or the driver temperature moved by their deadbands
+
+  Parameters:
+    cur  - current packet
+    last - last published packet
+
+  Return:
+    true if a frame has to be sent
+-----------------------------------------------------------------------------------------------------*/
+static bool _Tlm_sens_changed(const T_can_status_packet2* cur, const T_can_status_packet2* last)
+{
+  int32_t temp_db = (int32_t)(wvar.can_temp_deadband_c * 10.0f + 0.5f);
+
+  return _Tlm_exceeds(cur->position_sensor, last->position_sensor, (int32_t)wvar.can_position_deadband) ||
+         _Tlm_exceeds(cur->driver_temp_x10, last->driver_temp_x10, temp_db);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Check if the motor or input current moved by the current deadband
+
+  Parameters:
+    cur  - current packet
+    last - last published packet
+
+  Return:
+    true if a frame has to be sent
+-----------------------------------------------------------------------------------------------------*/
+static bool _Tlm_pwr_changed(const T_can_status_packet3* cur, const T_can_status_packet3* last)
+{
+  int32_t current_db = (int32_t)(wvar.can_current_deadband_a * 10.0f + 0.5f);
+
+  return _Tlm_exceeds(cur->motor_current_x10, last->motor_current_x10, current_db) ||
+         _Tlm_exceeds(cur->input_current_x10, last->input_current_x10, current_db);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Publish status, sensor and power packets of all motor controllers without a request.
+  A packet is sent when its period (can_*_period_ms) has passed since it was last sent, or, with
+  can_tlm_on_change set, when it differs from the last sent packet by more than the deadbands and
+  at least can_tlm_min_interval_ms have passed. A change triggered frame restarts the period.
+  Frames the TX queue does not accept are retried on the next call.
+  Called from the main task every 10 ms, the periods are rounded up to this resolution.
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Can_telemetry_tick(void)
+{
+  T_can_status_packet1 ans;
+  T_can_status_packet2 sens;
+  T_can_status_packet3 pwr;
+  uint32_t             period[CAN_TLM_MSG_COUNT];
+  uint32_t             can_id[CAN_TLM_MSG_COUNT];
+  uint8_t*             cur[CAN_TLM_MSG_COUNT];
+  uint8_t*             last[CAN_TLM_MSG_COUNT];
+  uint8_t              len[CAN_TLM_MSG_COUNT];
+  bool                 changed[CAN_TLM_MSG_COUNT];
+  bool                 on_change = (wvar.can_tlm_on_change != 0);
+  uint32_t             now;
+  uint32_t             elapsed;
+
+  period[CAN_TLM_MSG_ANS]  = wvar.can_ans_period_ms;
+  period[CAN_TLM_MSG_SENS] = wvar.can_sens_period_ms;
+  period[CAN_TLM_MSG_PWR]  = wvar.can_pwr_period_ms;
+  if (!on_change && (period[CAN_TLM_MSG_ANS] == 0) && (period[CAN_TLM_MSG_SENS] == 0) && (period[CAN_TLM_MSG_PWR] == 0))
+  {
+    return;  // Broadcasting is off, status is sent on REQUEST_STATE_TO_ALL only
+  }
+  if (!Can_is_ready())
+  {
+    return;
+  }
+
+  now = tx_time_get();
+  for (uint8_t motor_id = MOT3_ID; motor_id <= TRACTION_MOT_ID; motor_id++)
+  {
+    T_can_tlm_motor* st = &g_can_tlm[motor_id - 1];
+
+    _Fill_status_packet(motor_id, &ans);
+    _Fill_sensor_packet(motor_id, &sens);
+    _Fill_power_packet(motor_id, &pwr);
+
+    can_id[CAN_TLM_MSG_ANS]   = g_can_motor_map[motor_id - 1].ans_id;
+    can_id[CAN_TLM_MSG_SENS]  = g_can_motor_map[motor_id - 1].sens_id;
+    can_id[CAN_TLM_MSG_PWR]   = g_can_motor_map[motor_id - 1].pwr_id;
+    cur[CAN_TLM_MSG_ANS]      = (uint8_t*)&ans;
+    cur[CAN_TLM_MSG_SENS]     = (uint8_t*)&sens;
+    cur[CAN_TLM_MSG_PWR]      = (uint8_t*)&pwr;
+    last[CAN_TLM_MSG_ANS]     = (uint8_t*)&st->ans;
+    last[CAN_TLM_MSG_SENS]    = (uint8_t*)&st->sens;
+    last[CAN_TLM_MSG_PWR]     = (uint8_t*)&st->pwr;
+    len[CAN_TLM_MSG_ANS]      = sizeof(ans);
+    len[CAN_TLM_MSG_SENS]     = sizeof(sens);
+    len[CAN_TLM_MSG_PWR]      = sizeof(pwr);
+    changed[CAN_TLM_MSG_ANS]  = _Tlm_ans_changed(&ans, &st->ans);
+    changed[CAN_TLM_MSG_SENS] = _Tlm_sens_changed(&sens, &st->sens);
+    changed[CAN_TLM_MSG_PWR]  = _Tlm_pwr_changed(&pwr, &st->pwr);
+
+    for (uint32_t m = 0; m < CAN_TLM_MSG_COUNT; m++)
+    {
+      bool due_period;
+      bool due_change;
+
+      elapsed    = Time_diff_miliseconds(st->tx_time[m], now);
+      due_period = (period[m] != 0) && (!st->sent[m] || (elapsed >= period[m]));
+      due_change = on_change && (!st->sent[m] || changed[m]) && (elapsed >= wvar.can_tlm_min_interval_ms);
+      if (!due_period && !due_change)
+      {
+        continue;
+      }
+
+      if (Can_send_extended_data(can_id[m], cur[m], len[m]) != CAN_SEND_SUCCESS)
+      {
+        g_can_tlm_stats.msg[m].tx_failed++;
+        continue;
+      }
+      if (due_period)
+      {
+        g_can_tlm_stats.msg[m].periodic++;
+      }
+      else
+      {
+        g_can_tlm_stats.msg[m].on_change++;
+      }
+      memcpy(last[m], cur[m], len[m]);
+      st->sent[m]    = true;
+      st->tx_time[m] = now;
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Get telemetry broadcaster counters
+
+  Parameters:
+    p_stats - destination
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Can_telemetry_stats_get(T_can_telemetry_stats* p_stats)
+{
+  memcpy(p_stats, &g_can_tlm_stats, sizeof(T_can_telemetry_stats));
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Reset telemetry broadcaster counters
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Can_telemetry_stats_reset(void)
+{
+  memset(&g_can_tlm_stats, 0, sizeof(g_can_tlm_stats));
 }
 
 /*-----------------------------------------------------------------------------------------------------
@@ -329,14 +688,12 @@ static void _Control_motor_from_system_command(uint8_t motor_num, uint32_t up_bi
     pwm_percent = 100;
   }
   // Check command bits with priority handling
+  // A stop from the CAN ISR that could not queue its command looks done, finish it before the check below
+  Motor_emergency_stop_cleanup();
   if (control_word & hard_stop_bit)
   {
     // Check if motor is already stopped before executing emergency stop
-    T_motor_extended_state* motor_state = Motor_get_extended_state(motor_num);
-    if (motor_state != NULL &&
-        motor_state->enabled == 0 &&
-        motor_state->direction == MOTOR_DIRECTION_STOP &&
-        (motor_state->soft_start_state == MOTOR_STATE_IDLE || motor_state->soft_start_state == MOTOR_STATE_COASTING))
+    if (_Is_motor_hard_stopped(motor_num))
     {
       // Motor is already stopped - ignore duplicate emergency stop command
       return;
@@ -660,7 +1017,7 @@ const char* Get_motor_name(uint8_t motor_num)
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Disable CAN command processing by setting callback to NULL
+  Disable CAN command processing by stopping dispatch of received frames to the handlers
 
   Parameters:
     None
@@ -670,11 +1027,7 @@ const char* Get_motor_name(uint8_t motor_num)
 -----------------------------------------------------------------------------------------------------*/
 void Disable_can_command_processing(void)
 {
-  // Save current callback
-  g_original_can_callback = Can_get_rx_callback();
-
-  // Disable CAN command processing by setting callback to NULL
-  Can_set_rx_callback(NULL);
+  Can_rx_set_dispatch_enabled(false);
 
   // Update global flag
   g_can_command_processing_enabled = 0;
@@ -683,7 +1036,7 @@ void Disable_can_command_processing(void)
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Restore CAN command processing by restoring original callback
+  Restore CAN command processing by enabling dispatch of received frames to the handlers
 
   Parameters:
     None
@@ -693,11 +1046,9 @@ void Disable_can_command_processing(void)
 -----------------------------------------------------------------------------------------------------*/
 void Restore_can_command_processing(void)
 {
-  // Restore original callback
-  if (g_original_can_callback != NULL)
+  if (!g_can_command_processing_enabled)
   {
-    Can_set_rx_callback(g_original_can_callback);
-    g_original_can_callback          = NULL;
+    Can_rx_set_dispatch_enabled(true);
 
     // Update global flag
     g_can_command_processing_enabled = 1;
@@ -1,9 +1,34 @@
 #ifndef CAN_MESSAGE_HANDLER_H
 #define CAN_MESSAGE_HANDLER_H
 
+#define CAN_HARD_STOP_IN_ISR 1  // Apply REQUEST_SYS_CONTROL hard stop bits in the CAN RX interrupt
+
+// Messages published by the telemetry broadcaster, periods and deadbands are in the MC80_CAN_Telemetry parameters
+#define CAN_TLM_MSG_ANS   0  // MC80_ANS, status
+#define CAN_TLM_MSG_SENS  1  // MC80_SENS_INFO, sensor information
+#define CAN_TLM_MSG_PWR   2  // MC80_PWR_INFO, power information
+#define CAN_TLM_MSG_COUNT 3
+
+typedef struct
+{
+  uint32_t periodic;   // Frames sent because the period expired
+  uint32_t on_change;  // Frames sent because of a state change or deadband excess
+  uint32_t tx_failed;  // Frames not accepted by the TX queue, retried on the next tick
+} T_can_tlm_msg_stats;
+
+typedef struct
+{
+  T_can_tlm_msg_stats msg[CAN_TLM_MSG_COUNT];
+} T_can_telemetry_stats;
+
 void Can_message_handler_init(void);
 const char* Get_motor_name(uint8_t motor_num);
 
+// Periodic and change triggered telemetry
+void Can_telemetry_tick(void);
+void Can_telemetry_stats_get(T_can_telemetry_stats* p_stats);
+void Can_telemetry_stats_reset(void);
+
 // CAN command processing control functions
 void Disable_can_command_processing(void);
 void Restore_can_command_processing(void);
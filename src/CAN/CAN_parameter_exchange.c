@@ -3,17 +3,66 @@
 // Module memory allocation
 #define CAN_PARAM_RESPONSE_BUFFER_SIZE 32
 
+// Value staged by a parameter transaction
+typedef struct
+{
+  uint16_t param_index;
+  uint8_t  data_type;
+  uint8_t  data_length;
+  uint8_t  data[4];
+} T_param_txn_entry;
+
+// Parameter transaction. Accessed only from the CAN RX task.
+typedef struct
+{
+  bool              active;
+  uint16_t          count;       // Staged entries
+  uint32_t          last_time;   // Tick time of the last transaction message, for the timeout
+  T_param_txn_entry entries[CAN_PARAM_TXN_MAX];
+} T_param_txn;
+
+// Bulk read stream. The request is stored by the CAN RX task, the stream is sent by the CAN TX task.
+typedef struct
+{
+  bool                      req_pending;  // Request stored, not yet taken by the CAN TX task
+  bool                      req_fd;       // Request was a CAN FD frame
+  T_can_param_bulk_read_req req;
+  bool                      active;       // Stream is being sent
+  bool                      fd;           // Responses are packed into CAN FD frames
+  uint16_t                  next;         // Index of the next parameter
+  uint16_t                  last;         // Index after the last parameter
+  uint16_t                  sent;         // Parameters queued for transmission
+  uint32_t                  in_flight;    // MC80_PARAM_ANS frames not yet sent at the last pass
+  uint32_t                  last_time;    // Tick time of the last progress, for the stall timeout
+} T_param_bulk;
+
 // Global variables for parameter exchange state
-static bool    g_param_exchange_initialized = false;
-static uint8_t g_response_buffer[CAN_PARAM_RESPONSE_BUFFER_SIZE];
+static bool         g_param_exchange_initialized = false;
+static uint8_t      g_response_buffer[CAN_PARAM_RESPONSE_BUFFER_SIZE];
+static T_param_txn  g_param_txn;
+static T_param_bulk g_param_bulk;
 
 // Static function declarations
+static void     _Param_read(uint16_t param_hash, T_can_param_response *response);
+static void     _Param_write(const T_can_param_write_req *request, T_can_param_response *response);
+static uint32_t _Param_process_fd_read(const T_can_msg *rx_msg);
+static uint32_t _Param_process_fd_write(const T_can_msg *rx_msg);
 static uint32_t _Send_can_response(uint32_t can_id, const uint8_t *data, uint8_t data_length);
+static uint32_t _Send_can_fd_response(uint32_t can_id, const uint8_t *data, uint32_t data_length);
 static uint32_t _Get_parameter_data_type(uint16_t param_index, uint8_t *data_type);
 static uint32_t _Validate_parameter_range(uint16_t param_index, const uint8_t *data_ptr, uint8_t data_length);
 static uint32_t _Perform_controller_reset(uint8_t reset_type, uint8_t delay_ms);
 static uint32_t _Can_param_convert_to_can_format(uint16_t param_index, uint8_t *data_type, uint8_t *data_ptr, uint8_t *data_length);
 static uint32_t _Can_param_convert_from_can_format(uint16_t param_index, uint8_t data_type, const uint8_t *data_ptr, uint8_t data_length);
+static uint32_t _Can_param_check_can_value(uint16_t param_index, uint8_t data_type, const uint8_t *data_ptr, uint8_t data_length);
+static uint8_t  _Param_txn_stage(uint16_t param_index, const T_can_param_write_req *request);
+static void     _Param_txn_check_timeout(void);
+static uint32_t _Param_txn_commit(uint16_t expected_count, T_can_param_response *response);
+static uint32_t _Param_process_txn_request(const uint8_t *can_data);
+static uint32_t _Param_process_bulk_read(const T_can_msg *rx_msg);
+static uint32_t _Send_bulk_response(bool fd, const uint8_t *data, uint32_t data_length);
+static uint32_t _Param_bulk_send_frame(T_param_bulk *p);
+static void     _Param_bulk_service(void);
 
 /*-----------------------------------------------------------------------------------------------------
   Initialize the parameter exchange module for slave device operation
@@ -28,6 +77,9 @@ uint32_t Can_param_exchange_init(void)
 {
   // Clear response buffer
   memset(g_response_buffer, 0, sizeof(g_response_buffer));
+  memset(&g_param_txn, 0, sizeof(g_param_txn));
+  memset(&g_param_bulk, 0, sizeof(g_param_bulk));
+  Can_tx_set_service_hook(_Param_bulk_service);
 
   g_param_exchange_initialized = true;
 
@@ -35,67 +87,134 @@ uint32_t Can_param_exchange_init(void)
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Process parameter read request from central controller
+  Read one parameter and fill the response entry
 
   Parameters:
-    can_data - Pointer to received CAN message data (8 bytes)
+    param_hash - CRC16 hash of the parameter name
+    response - Response entry to fill
 
   Return:
-    RES_OK if request processed successfully, RES_ERROR otherwise
+    None
 -----------------------------------------------------------------------------------------------------*/
-uint32_t Can_param_process_read_request(const uint8_t *can_data)
+static void _Param_read(uint16_t param_hash, T_can_param_response *response)
 {
-  const T_can_param_read_req *request;
-  T_can_param_response        response;
-  uint16_t                    param_index;
-  uint8_t                     data_type;
-  uint8_t                     data_buffer[4];
-  uint8_t                     data_length;
+  uint16_t param_index;
+  uint8_t  data_type;
+  uint8_t  data_buffer[4];
+  uint8_t  data_length;
 
-  if (!g_param_exchange_initialized || can_data == NULL)
+  response->param_hash  = param_hash;
+  response->type_length = ENCODE_TYPE_LENGTH(0, 0);
+  memset(response->data, 0, sizeof(response->data));
+
+  // Find parameter by hash
+  param_index = Find_param_by_hash(param_hash);
+  if (param_index == 0xFFFF)
   {
-    return RES_ERROR;
+    response->status = PARAM_STATUS_NOT_FOUND;
+    return;
+  }
+
+  // Convert parameter to CAN format
+  if (_Can_param_convert_to_can_format(param_index, &data_type, data_buffer, &data_length) != RES_OK)
+  {
+    response->status = PARAM_STATUS_INVALID_DATA_TYPE;
+    return;
   }
+  response->status      = PARAM_STATUS_SUCCESS;
+  // Encode data type and length into single byte: bits 0-3 = type, bits 4-7 = length
+  response->type_length = ENCODE_TYPE_LENGTH(data_type, data_length);
+  memcpy(response->data, data_buffer, (data_length <= 4) ? data_length : 4);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Write one parameter and fill the response entry. On success the written data is echoed back.
+
+  Parameters:
+    request - Write request entry
+    response - Response entry to fill
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Param_write(const T_can_param_write_req *request, T_can_param_response *response)
+{
+  uint16_t param_index;
+
+  response->param_hash  = request->param_hash;
+  response->type_length = ENCODE_TYPE_LENGTH(0, 0);
+  memset(response->data, 0, sizeof(response->data));
 
-  request     = (const T_can_param_read_req *)can_data;
   // Find parameter by hash
   param_index = Find_param_by_hash(request->param_hash);
   if (param_index == 0xFFFF)
   {
-    // Parameter not found - send error response
-    response.param_hash  = request->param_hash;
-    response.status      = PARAM_STATUS_NOT_FOUND;
-    response.type_length = ENCODE_TYPE_LENGTH(0, 0);
-    memset(response.data, 0, sizeof(response.data));
+    response->status = PARAM_STATUS_NOT_FOUND;
+    return;
+  }
 
-    return _Send_can_response(MC80_PARAM_ANS, (const uint8_t *)&response, sizeof(response));
+  // Validate data length
+  if (request->data_length == 0 || request->data_length > 4)
+  {
+    response->status = PARAM_STATUS_INVALID_DATA_LENGTH;
+    return;
   }
 
-  // Convert parameter to CAN format
-  if (_Can_param_convert_to_can_format(param_index, &data_type, data_buffer, &data_length) != RES_OK)
+  // Inside a transaction the value is only validated and staged, it is written on commit
+  if (g_param_txn.active)
   {
-    // Conversion error - send error response
-    response.param_hash  = request->param_hash;
-    response.status      = PARAM_STATUS_INVALID_DATA_TYPE;
-    response.type_length = ENCODE_TYPE_LENGTH(0, 0);
-    memset(response.data, 0, sizeof(response.data));
+    response->status = _Param_txn_stage(param_index, request);
+    if (response->status == PARAM_STATUS_TXN_STAGED)
+    {
+      response->type_length = ENCODE_TYPE_LENGTH(request->data_type, request->data_length);
+      memcpy(response->data, request->data, request->data_length);
+    }
+    return;
+  }
 
-    return _Send_can_response(MC80_PARAM_ANS, (const uint8_t *)&response, sizeof(response));
+  // Convert and validate parameter data
+  if (_Can_param_convert_from_can_format(param_index, request->data_type, request->data, request->data_length) != RES_OK)
+  {
+    // Conversion or validation error
+    uint8_t error_status = PARAM_STATUS_VALUE_OUT_OF_RANGE;  // Default error
+
+    // Try to determine specific error type
+    uint8_t expected_type;
+    if (_Get_parameter_data_type(param_index, &expected_type) == RES_OK && expected_type != request->data_type)
+    {
+      error_status = PARAM_STATUS_INVALID_DATA_TYPE;
+    }
+    response->status = error_status;
+    return;
   }
-  // Send successful response with parameter data
-  response.param_hash  = request->param_hash;
-  response.status      = PARAM_STATUS_SUCCESS;
+  // Parameter written successfully
+  response->status      = PARAM_STATUS_SUCCESS;
   // Encode data type and length into single byte: bits 0-3 = type, bits 4-7 = length
-  response.type_length = ENCODE_TYPE_LENGTH(data_type, data_length);
+  response->type_length = ENCODE_TYPE_LENGTH(request->data_type, request->data_length);
+  memcpy(response->data, request->data, request->data_length);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Process parameter read request from central controller
+
+  Parameters:
+    can_data - Pointer to received CAN message data (8 bytes)
+
+  Return:
+    RES_OK if request processed successfully, RES_ERROR otherwise
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Can_param_process_read_request(const uint8_t *can_data)
+{
+  const T_can_param_read_req *request;
+  T_can_param_response        response;
 
-  // Copy data (can now fit 4 bytes in CAN frame)
-  uint8_t copy_length  = (data_length <= 4) ? data_length : 4;
-  memcpy(response.data, data_buffer, copy_length);
-  if (copy_length < 4)
+  if (!g_param_exchange_initialized || can_data == NULL)
   {
-    memset(&response.data[copy_length], 0, 4 - copy_length);
+    return RES_ERROR;
   }
 
+  request = (const T_can_param_read_req *)can_data;
+  _Param_read(request->param_hash, &response);
   return _Send_can_response(MC80_PARAM_ANS, (const uint8_t *)&response, sizeof(response));
 }
 
@@ -110,77 +229,450 @@ uint32_t Can_param_process_read_request(const uint8_t *can_data)
 -----------------------------------------------------------------------------------------------------*/
 uint32_t Can_param_process_write_request(const uint8_t *can_data)
 {
-  const T_can_param_write_req *request;
-  T_can_param_response         response;
-  uint16_t                     param_index;
+  T_can_param_response response;
 
   if (!g_param_exchange_initialized || can_data == NULL)
   {
     return RES_ERROR;
   }
 
-  request     = (const T_can_param_write_req *)can_data;
-  // Find parameter by hash
-  param_index = Find_param_by_hash(request->param_hash);
-  if (param_index == 0xFFFF)
+  _Param_write((const T_can_param_write_req *)can_data, &response);
+  return _Send_can_response(MC80_PARAM_ANS, (const uint8_t *)&response, sizeof(response));
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Process CAN FD parameter read request. The frame carries a list of parameter hashes terminated by
+  hash 0 or by the end of the frame. Responses are sent in CAN FD frames of up to
+  CAN_FD_PARAM_PER_FRAME entries in the order of the request.
+
+  Parameters:
+    rx_msg - Received CAN FD message
+
+  Return:
+    RES_OK if all responses were queued, RES_ERROR otherwise
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Param_process_fd_read(const T_can_msg *rx_msg)
+{
+  T_can_param_response responses[CAN_FD_PARAM_PER_FRAME];
+  uint32_t             cnt    = rx_msg->dlc / sizeof(uint16_t);
+  uint32_t             n      = 0;
+  uint32_t             result = RES_OK;
+  uint16_t             param_hash;
+
+  for (uint32_t i = 0; i < cnt; i++)
   {
-    // Parameter not found - send error response
-    response.param_hash  = request->param_hash;
-    response.status      = PARAM_STATUS_NOT_FOUND;
-    response.type_length = ENCODE_TYPE_LENGTH(0, 0);
-    memset(response.data, 0, sizeof(response.data));
+    memcpy(&param_hash, &rx_msg->data[i * sizeof(uint16_t)], sizeof(param_hash));
+    if (param_hash == 0)
+    {
+      break;
+    }
+    _Param_read(param_hash, &responses[n++]);
+    if (n == CAN_FD_PARAM_PER_FRAME)
+    {
+      result |= _Send_can_fd_response(MC80_PARAM_ANS, (const uint8_t *)responses, n * sizeof(T_can_param_response));
+      n       = 0;
+    }
+  }
+  if (n > 0)
+  {
+    result |= _Send_can_fd_response(MC80_PARAM_ANS, (const uint8_t *)responses, n * sizeof(T_can_param_response));
+  }
+  return result;
+}
 
-    return _Send_can_response(MC80_PARAM_ANS, (const uint8_t *)&response, sizeof(response));
+/*-----------------------------------------------------------------------------------------------------
+  Process CAN FD parameter write request. The frame carries up to CAN_FD_PARAM_PER_FRAME write requests,
+  an entry with hash 0 terminates the list. Every entry is written independently and the results are
+  returned in one CAN FD frame in the order of the request.
+
+  Parameters:
+    rx_msg - Received CAN FD message
+
+  Return:
+    RES_OK if the response was queued, RES_ERROR otherwise
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Param_process_fd_write(const T_can_msg *rx_msg)
+{
+  T_can_param_response  responses[CAN_FD_PARAM_PER_FRAME];
+  T_can_param_write_req request;
+  uint32_t              cnt = rx_msg->dlc / sizeof(T_can_param_write_req);
+  uint32_t              n   = 0;
+
+  for (uint32_t i = 0; i < cnt; i++)
+  {
+    memcpy(&request, &rx_msg->data[i * sizeof(T_can_param_write_req)], sizeof(request));
+    if (request.param_hash == 0)
+    {
+      break;
+    }
+    _Param_write(&request, &responses[n++]);
   }
+  if (n == 0)
+  {
+    return RES_ERROR;
+  }
+  return _Send_can_fd_response(MC80_PARAM_ANS, (const uint8_t *)responses, n * sizeof(T_can_param_response));
+}
 
-  // Validate data length
-  if (request->data_length == 0 || request->data_length > 4)
+/*-----------------------------------------------------------------------------------------------------
+  Validate a write request and stage it in the open transaction. A parameter written twice keeps
+  the last value.
+
+  Parameters:
+    param_index - Index of the parameter
+    request - Write request entry
+
+  Return:
+    PARAM_STATUS_TXN_STAGED or the reason why the value was rejected
+-----------------------------------------------------------------------------------------------------*/
+static uint8_t _Param_txn_stage(uint16_t param_index, const T_can_param_write_req *request)
+{
+  T_param_txn_entry *e;
+  uint8_t            expected_type;
+  uint32_t           i;
+
+  if (_Can_param_check_can_value(param_index, request->data_type, request->data, request->data_length) != RES_OK)
   {
-    response.param_hash  = request->param_hash;
-    response.status      = PARAM_STATUS_INVALID_DATA_LENGTH;
-    response.type_length = ENCODE_TYPE_LENGTH(0, 0);
-    memset(response.data, 0, sizeof(response.data));
+    if (_Get_parameter_data_type(param_index, &expected_type) == RES_OK && expected_type != request->data_type)
+    {
+      return PARAM_STATUS_INVALID_DATA_TYPE;
+    }
+    return PARAM_STATUS_VALUE_OUT_OF_RANGE;
+  }
 
-    return _Send_can_response(MC80_PARAM_ANS, (const uint8_t *)&response, sizeof(response));
+  for (i = 0; i < g_param_txn.count; i++)
+  {
+    if (g_param_txn.entries[i].param_index == param_index)
+    {
+      break;
+    }
+  }
+  if (i == g_param_txn.count)
+  {
+    if (g_param_txn.count >= CAN_PARAM_TXN_MAX)
+    {
+      return PARAM_STATUS_TXN_FULL;
+    }
+    g_param_txn.count++;
   }
+  e              = &g_param_txn.entries[i];
+  e->param_index = param_index;
+  e->data_type   = request->data_type;
+  e->data_length = request->data_length;
+  memcpy(e->data, request->data, request->data_length);
+  g_param_txn.last_time = tx_time_get();
+  return PARAM_STATUS_TXN_STAGED;
+}
 
-  // Convert and validate parameter data
-  if (_Can_param_convert_from_can_format(param_index, request->data_type, request->data, request->data_length) != RES_OK)
+/*-----------------------------------------------------------------------------------------------------
+  Drop a transaction that was not committed within CAN_PARAM_TXN_TIMEOUT_MS after its last message,
+  so writes of a crashed commissioning tool do not get committed by a later one.
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Param_txn_check_timeout(void)
+{
+  if (g_param_txn.active && ((tx_time_get() - g_param_txn.last_time) >= ms_to_ticks(CAN_PARAM_TXN_TIMEOUT_MS)))
   {
-    // Conversion or validation error
-    uint8_t error_status = PARAM_STATUS_VALUE_OUT_OF_RANGE;  // Default error
+    APPLOG("CAN Parameter Exchange: Transaction timeout, %u staged values dropped", (unsigned int)g_param_txn.count);
+    g_param_txn.active = false;
+    g_param_txn.count  = 0;
+  }
+}
 
-    // Try to determine specific error type
-    uint8_t expected_type;
-    if (_Get_parameter_data_type(param_index, &expected_type) == RES_OK && expected_type != request->data_type)
+/*-----------------------------------------------------------------------------------------------------
+  Commit the open transaction. All staged values are validated again, then written together with
+  interrupts disabled and saved by one settings save. The settings journal appends the changed values
+  as one batch, so after a reset either all or none of them are restored.
+  The transaction is closed whatever the result.
+
+  Parameters:
+    expected_count - Number of values the sender staged, a lost write frame makes the commit fail
+    response - Response to fill, param_hash is the first invalid parameter on validation failure
+
+  Return:
+    RES_OK if the values were written and saved, RES_ERROR otherwise
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Param_txn_commit(uint16_t expected_count, T_can_param_response *response)
+{
+  TX_INTERRUPT_SAVE_AREA
+  T_param_txn_entry *e;
+  uint32_t           save_result = RES_ERROR;
+  uint16_t           count       = g_param_txn.count;
+
+  g_param_txn.active = false;
+  g_param_txn.count  = 0;
+  response->data[0]  = (uint8_t)(count & 0xFF);
+  response->data[1]  = (uint8_t)(count >> 8);
+
+  if (count != expected_count)
+  {
+    response->status = PARAM_STATUS_TXN_COUNT_MISMATCH;
+    return RES_ERROR;
+  }
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    e = &g_param_txn.entries[i];
+    if (_Can_param_check_can_value(e->param_index, e->data_type, e->data, e->data_length) != RES_OK)
     {
-      error_status = PARAM_STATUS_INVALID_DATA_TYPE;
+      response->param_hash = Get_param_hash_by_index(e->param_index);
+      response->status     = PARAM_STATUS_VALUE_OUT_OF_RANGE;
+      return RES_ERROR;
     }
+  }
 
-    response.param_hash  = request->param_hash;
-    response.status      = error_status;
-    response.type_length = ENCODE_TYPE_LENGTH(0, 0);
-    memset(response.data, 0, sizeof(response.data));
+  TX_DISABLE
+  for (uint32_t i = 0; i < count; i++)
+  {
+    e = &g_param_txn.entries[i];
+    memcpy(wvar_inst.items_array[e->param_index].val, e->data, e->data_length);
+  }
+  TX_RESTORE
 
-    return _Send_can_response(MC80_PARAM_ANS, (const uint8_t *)&response, sizeof(response));
+  if (count != 0)
+  {
+    Request_save_settings(APPLICATION_PARAMS, MEDIA_TYPE_DATAFLASH, NULL);
+    if (!Check_save_operation_status(&save_result, PARAM_SAVE_TIMEOUT_MS) || (save_result != RES_OK))
+    {
+      response->status = PARAM_STATUS_SAVE_ERROR;
+      return RES_ERROR;
+    }
   }
-  // Parameter written successfully
-  response.param_hash  = request->param_hash;
-  response.status      = PARAM_STATUS_SUCCESS;
-  // Encode data type and length into single byte: bits 0-3 = type, bits 4-7 = length
-  response.type_length = ENCODE_TYPE_LENGTH(request->data_type, request->data_length);
+  APPLOG("CAN Parameter Exchange: Transaction committed, %u values", (unsigned int)count);
+  response->status = PARAM_STATUS_TXN_COMMITTED;
+  return RES_OK;
+}
 
-  // Echo back the written data (can now fit 4 bytes)
-  uint8_t copy_length  = (request->data_length <= 4) ? request->data_length : 4;
-  memcpy(response.data, request->data, copy_length);
-  if (copy_length < 4)
+/*-----------------------------------------------------------------------------------------------------
+  Process parameter transaction control request: begin, commit or abort.
+  While a transaction is open MC80_PARAM_WR requests (classic or CAN FD) are validated and staged
+  instead of being written.
+
+  Parameters:
+    can_data - Pointer to received CAN message data (8 bytes)
+
+  Return:
+    RES_OK if request processed successfully, RES_ERROR otherwise
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Param_process_txn_request(const uint8_t *can_data)
+{
+  T_can_param_txn_req  request;
+  T_can_param_response response;
+
+  memcpy(&request, can_data, sizeof(request));
+  response.param_hash  = 0x0000;
+  response.type_length = ENCODE_TYPE_LENGTH(0, 0);
+  memset(response.data, 0, sizeof(response.data));
+
+  if (request.magic_word != PARAM_TXN_MAGIC_WORD)
   {
-    memset(&response.data[copy_length], 0, 4 - copy_length);
+    response.status = PARAM_STATUS_INVALID_MAGIC_WORD;
+    return _Send_can_response(MC80_PARAM_ANS, (const uint8_t *)&response, sizeof(response));
   }
 
+  switch (request.operation)
+  {
+    case PARAM_TXN_BEGIN:
+      // A new begin discards values staged by an unfinished transaction
+      g_param_txn.active    = true;
+      g_param_txn.count     = 0;
+      g_param_txn.last_time = tx_time_get();
+      response.status       = PARAM_STATUS_TXN_STARTED;
+      break;
+
+    case PARAM_TXN_COMMIT:
+      if (!g_param_txn.active)
+      {
+        response.status = PARAM_STATUS_TXN_NOT_ACTIVE;
+        break;
+      }
+      _Param_txn_commit(request.value_count, &response);
+      break;
+
+    case PARAM_TXN_ABORT:
+      response.status    = g_param_txn.active ? PARAM_STATUS_TXN_ABORTED : PARAM_STATUS_TXN_NOT_ACTIVE;
+      g_param_txn.active = false;
+      g_param_txn.count  = 0;
+      break;
+
+    default:
+      response.status = PARAM_STATUS_TXN_INVALID_OP;
+      break;
+  }
   return _Send_can_response(MC80_PARAM_ANS, (const uint8_t *)&response, sizeof(response));
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Send one frame of a bulk read stream
+
+  Parameters:
+    fd - true to send a CAN FD frame
+    data - Pointer to message data
+    data_length - Length of message data
+
+  Return:
+    RES_OK if message queued successfully, RES_ERROR otherwise
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Send_bulk_response(bool fd, const uint8_t *data, uint32_t data_length)
+{
+  if (fd)
+  {
+    return _Send_can_fd_response(MC80_PARAM_ANS, data, data_length);
+  }
+  return _Send_can_response(MC80_PARAM_ANS, data, (uint8_t)data_length);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Queue the next data frame of the bulk read stream, one response per classic frame or up to
+  CAN_FD_PARAM_PER_FRAME per CAN FD frame. Parameters that can not be transferred over CAN (strings)
+  are skipped. The stream position advances only if the frame was queued.
+
+  Parameters:
+    p - bulk read stream
+
+  Return:
+    RES_OK if the frame was queued or only skipped parameters were left, RES_ERROR if the TX scheduler
+    is full
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Param_bulk_send_frame(T_param_bulk *p)
+{
+  T_can_param_response responses[CAN_FD_PARAM_PER_FRAME];
+  uint8_t              data_type;
+  uint8_t              data_length;
+  uint32_t             per_frame = p->fd ? CAN_FD_PARAM_PER_FRAME : 1;
+  uint32_t             n         = 0;
+  uint32_t             i;
+
+  for (i = p->next; (i < p->last) && (n < per_frame); i++)
+  {
+    T_can_param_response *r = &responses[n];
+
+    memset(r, 0, sizeof(*r));
+    if (_Can_param_convert_to_can_format((uint16_t)i, &data_type, r->data, &data_length) != RES_OK)
+    {
+      continue;
+    }
+    r->param_hash  = Get_param_hash_by_index((uint16_t)i);
+    r->status      = PARAM_STATUS_SUCCESS;
+    r->type_length = ENCODE_TYPE_LENGTH(data_type, data_length);
+    n++;
+  }
+  if ((n != 0) && (_Send_bulk_response(p->fd, (const uint8_t *)responses, n * sizeof(T_can_param_response)) != RES_OK))
+  {
+    return RES_ERROR;
+  }
+  p->next  = (uint16_t)i;
+  p->sent += (uint16_t)n;
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Advance the bulk read stream. Called by the CAN TX task after frames were sent. At most
+  CAN_PARAM_BULK_WINDOW MC80_PARAM_ANS frames wait in the TX scheduler, the rest of it is left for
+  status frames. The end marker is queued only after all data frames were sent, so it is the last frame
+  of the stream on the bus. A stream that makes no progress for CAN_TX_STALL_MS is dropped.
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Param_bulk_service(void)
+{
+  TX_INTERRUPT_SAVE_AREA
+  T_param_bulk        *p = &g_param_bulk;
+  T_can_param_response end;
+  uint32_t             in_flight;
+
+  TX_DISABLE
+  if (p->req_pending)
+  {
+    p->req_pending = false;
+    p->active      = true;
+    p->fd          = p->req_fd;
+    p->next        = p->req.first_index;
+    p->last        = (p->req.count == 0) ? wvar_inst.items_num : (uint16_t)(p->req.first_index + p->req.count);
+    if ((p->last > wvar_inst.items_num) || (p->last < p->next))
+    {
+      p->last = wvar_inst.items_num;
+    }
+    p->sent      = 0;
+    p->in_flight = 0;
+    p->last_time = tx_time_get();
+  }
+  TX_RESTORE
+  if (!p->active)
+  {
+    return;
+  }
+
+  in_flight = Can_get_tx_id_count(MC80_PARAM_ANS);
+  if (in_flight < p->in_flight)
+  {
+    p->last_time = tx_time_get();
+  }
+  while ((p->next < p->last) && (in_flight < CAN_PARAM_BULK_WINDOW))
+  {
+    if (_Param_bulk_send_frame(p) != RES_OK)
+    {
+      break;
+    }
+    in_flight    = Can_get_tx_id_count(MC80_PARAM_ANS);
+    p->last_time = tx_time_get();
+  }
+  p->in_flight = in_flight;
+
+  if ((p->next >= p->last) && (in_flight == 0))
+  {
+    memset(&end, 0, sizeof(end));
+    end.status  = PARAM_STATUS_BULK_END;
+    end.data[0] = (uint8_t)(p->sent & 0xFF);
+    end.data[1] = (uint8_t)(p->sent >> 8);
+    end.data[2] = (uint8_t)(wvar_inst.items_num & 0xFF);
+    end.data[3] = (uint8_t)(wvar_inst.items_num >> 8);
+    if (_Send_bulk_response(p->fd, (const uint8_t *)&end, sizeof(end)) == RES_OK)
+    {
+      p->active = false;
+      return;
+    }
+  }
+  if ((tx_time_get() - p->last_time) >= ms_to_ticks(CAN_TX_STALL_MS))
+  {
+    p->active = false;
+    APPLOG("CAN Param: Bulk read dropped after %u of %u parameters", p->sent, p->last);
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Process bulk parameter read request. The request is handed over to the CAN TX task, which streams the
+  parameters of the index range as MC80_PARAM_ANS responses while earlier frames leave the mailboxes,
+  see _Param_bulk_service. The stream ends with a response in a frame of its own with hash 0, status
+  PARAM_STATUS_BULK_END and the number of sent parameters in data bytes 0-1, followed by the total number
+  of parameters in bytes 2-3. A request received while a stream is sent restarts it.
+
+  Parameters:
+    rx_msg - Received CAN message
+
+  Return:
+    RES_OK
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Param_process_bulk_read(const T_can_msg *rx_msg)
+{
+  TX_INTERRUPT_SAVE_AREA
+
+  TX_DISABLE
+  memcpy(&g_param_bulk.req, rx_msg->data, sizeof(g_param_bulk.req));
+  g_param_bulk.req_fd      = CAN_MSG_IS_FD(rx_msg);
+  g_param_bulk.req_pending = true;
+  TX_RESTORE
+  Can_tx_request_service();
+  return RES_OK;
+}
+
 /*-----------------------------------------------------------------------------------------------------
   Process parameter save request from central controller
 
@@ -307,18 +799,34 @@ uint32_t Can_param_process_message(const T_can_msg *rx_msg)
     return RES_ERROR;
   }
 
+  _Param_txn_check_timeout();
+
   // Route message based on CAN ID
   switch (rx_msg->can_id)
   {
     case MC80_PARAM_RD:
+      if (CAN_MSG_IS_FD(rx_msg))
+      {
+        return _Param_process_fd_read(rx_msg);
+      }
       return Can_param_process_read_request(rx_msg->data);
 
     case MC80_PARAM_WR:
+      if (CAN_MSG_IS_FD(rx_msg))
+      {
+        return _Param_process_fd_write(rx_msg);
+      }
       return Can_param_process_write_request(rx_msg->data);
 
     case MC80_PARAM_SAVE:
       return Can_param_process_save_request(rx_msg->data);
 
+    case MC80_PARAM_TXN:
+      return _Param_process_txn_request(rx_msg->data);
+
+    case MC80_PARAM_BULK_RD:
+      return _Param_process_bulk_read(rx_msg);
+
     case MC80_RESET:
       return Can_param_process_reset_request(rx_msg->data);
 
@@ -398,7 +906,7 @@ static uint32_t _Can_param_convert_to_can_format(uint16_t param_index, uint8_t *
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Convert parameter value from CAN transmission format to local format
+  Check a parameter value in CAN transmission format: data type, length and range
 
   Parameters:
     param_index - Index of parameter in MC80_Params array
@@ -407,95 +915,52 @@ static uint32_t _Can_param_convert_to_can_format(uint16_t param_index, uint8_t *
     data_length - Length of CAN data
 
   Return:
-    RES_OK if conversion successful, RES_ERROR otherwise
+    RES_OK if the value can be stored, RES_ERROR otherwise
 -----------------------------------------------------------------------------------------------------*/
-static uint32_t _Can_param_convert_from_can_format(uint16_t param_index, uint8_t data_type, const uint8_t *data_ptr, uint8_t data_length)
+static uint32_t _Can_param_check_can_value(uint16_t param_index, uint8_t data_type, const uint8_t *data_ptr, uint8_t data_length)
 {
-  if (param_index >= wvar_inst.items_num || data_ptr == NULL)
-  {
-    return RES_ERROR;
-  }
-
-  const T_NV_parameters *param       = &wvar_inst.items_array[param_index];
-  void                  *param_value = param->val;
+  uint8_t  expected_type;
+  uint32_t value = 0;
 
-  if (param_value == NULL)
+  if (param_index >= wvar_inst.items_num || data_ptr == NULL || wvar_inst.items_array[param_index].val == NULL)
   {
     return RES_ERROR;
   }
 
   // Validate data type compatibility
-  uint8_t expected_type;
   if (_Get_parameter_data_type(param_index, &expected_type) != RES_OK || expected_type != data_type)
   {
     return RES_ERROR;
   }
-
-  // Convert based on data type
-  switch (data_type)
+  if (data_length != ((data_type == PARAM_TYPE_UINT8) ? sizeof(uint8_t) : sizeof(uint32_t)))
   {
-    case PARAM_TYPE_UINT8:
-    {
-      if (data_length != 1)
-      {
-        return RES_ERROR;
-      }
-      uint8_t value = data_ptr[0];
-      if (_Validate_parameter_range(param_index, (const uint8_t *)&value, sizeof(value)) == RES_OK)
-      {
-        *(uint8_t *)param_value = value;
-      }
-      else
-      {
-        return RES_ERROR;
-      }
-      break;
-    }
+    return RES_ERROR;
+  }
 
-    case PARAM_TYPE_UINT32:
-    {
-      if (data_length != 4)
-      {
-        return RES_ERROR;
-      }
-      uint32_t value = ((uint32_t)data_ptr[0]) |
-                       ((uint32_t)data_ptr[1] << 8) |
-                       ((uint32_t)data_ptr[2] << 16) |
-                       ((uint32_t)data_ptr[3] << 24);
-      if (_Validate_parameter_range(param_index, (const uint8_t *)&value, sizeof(value)) == RES_OK)
-      {
-        *(uint32_t *)param_value = value;
-      }
-      else
-      {
-        return RES_ERROR;
-      }
-      break;
-    }
+  // CAN data is little-endian as the local format, copy to an aligned variable for the range check
+  memcpy(&value, data_ptr, data_length);
+  return _Validate_parameter_range(param_index, (const uint8_t *)&value, data_length);
+}
 
-    case PARAM_TYPE_FLOAT:
-    {
-      if (data_length != 4)
-      {
-        return RES_ERROR;
-      }
-      float value;
-      memcpy(&value, data_ptr, sizeof(float));
-      if (_Validate_parameter_range(param_index, (const uint8_t *)&value, sizeof(value)) == RES_OK)
-      {
-        *(float *)param_value = value;
-      }
-      else
-      {
-        return RES_ERROR;
-      }
-      break;
-    }
+/*-----------------------------------------------------------------------------------------------------
+  Convert parameter value from CAN transmission format to local format
 
-    default:
-      return RES_ERROR;
-  }
+  Parameters:
+    param_index - Index of parameter in MC80_Params array
+    data_type - Parameter data type from CAN message
+    data_ptr - Pointer to CAN data
+    data_length - Length of CAN data
 
+  Return:
+    RES_OK if conversion successful, RES_ERROR otherwise
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Can_param_convert_from_can_format(uint16_t param_index, uint8_t data_type, const uint8_t *data_ptr, uint8_t data_length)
+{
+  if (_Can_param_check_can_value(param_index, data_type, data_ptr, data_length) != RES_OK)
+  {
+    return RES_ERROR;
+  }
+  memcpy(wvar_inst.items_array[param_index].val, data_ptr, data_length);
   return RES_OK;
 }
 
@@ -533,6 +998,34 @@ static uint32_t _Send_can_response(uint32_t can_id, const uint8_t *data, uint8_t
   }
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Send CAN FD response message (static helper function)
+
+  Parameters:
+    can_id - CAN message identifier
+    data - Pointer to message data
+    data_length - Length of message data (up to CAN_FD_MAX_DATA)
+
+  Return:
+    RES_OK if message sent successfully, RES_ERROR otherwise
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Send_can_fd_response(uint32_t can_id, const uint8_t *data, uint32_t data_length)
+{
+  uint32_t result;
+
+  if (data_length > CAN_FD_MAX_DATA)
+  {
+    return RES_ERROR;
+  }
+  result = Can_send_fd_data(can_id, data, (uint8_t)data_length);
+  if (result == CAN_SEND_SUCCESS)
+  {
+    return RES_OK;
+  }
+  APPLOG("CAN Parameter Exchange: Failed to send FD response, error code: %u", result);
+  return RES_ERROR;
+}
+
 /*-----------------------------------------------------------------------------------------------------
   Perform controller reset (static helper function)
 
@@ -19,8 +19,28 @@
   - MC80_PARAM_WR: Parameter write request
   - MC80_PARAM_SAVE: Save parameters to NV memory
   - MC80_RESET: Controller reset request
+  - MC80_PARAM_TXN: Parameter transaction begin/commit/abort
+  - MC80_PARAM_BULK_RD: Read a range of parameters
   - MC80_PARAM_ANS: Parameter response (all operations)
 
+  TRANSACTIONS:
+  - MC80_PARAM_TXN begin opens a transaction, following MC80_PARAM_WR values are
+    validated and staged (status PARAM_STATUS_TXN_STAGED), not written
+  - MC80_PARAM_TXN commit with the number of staged values writes all of them
+    and saves the settings once. A count mismatch or an invalid value fails the
+    whole commit and nothing is written
+  - A transaction without messages for CAN_PARAM_TXN_TIMEOUT_MS is dropped
+
+  BULK READ:
+  - Parameters first_index .. first_index + count - 1 (count 0 - up to the last one)
+    are streamed as MC80_PARAM_ANS responses, ended by PARAM_STATUS_BULK_END
+  - The stream is sent by the CAN TX task as earlier frames leave the mailboxes,
+    PARAM_STATUS_BULK_END follows in a frame of its own after all data frames were sent
+
+  CAN FD:
+  - MC80_PARAM_RD/WR received as CAN FD frames carry several parameters,
+    responses are packed into CAN FD frames (see CAN_protocol.h)
+
   PARAMETER ACCESS:
   - All parameters in MC80_Params database are accessible
   - Parameters identified by CRC16 hash values
@@ -53,12 +73,29 @@
 #define PARAM_STATUS_RESET_INVALID_MAGIC 0x0C  // Invalid reset magic word
 #define PARAM_STATUS_CLEAR_ERRORS_SUCCESS 0x0D  // Motor errors cleared successfully
 #define PARAM_STATUS_CLEAR_ERRORS_INVALID_MAGIC 0x0E  // Invalid clear errors magic word
+#define PARAM_STATUS_TXN_STARTED         0x0F  // Transaction opened
+#define PARAM_STATUS_TXN_STAGED          0x10  // Value validated and staged in the transaction
+#define PARAM_STATUS_TXN_COMMITTED       0x11  // Staged values written and saved, data[0-1] - count
+#define PARAM_STATUS_TXN_ABORTED         0x12  // Transaction discarded
+#define PARAM_STATUS_TXN_NOT_ACTIVE      0x13  // Commit or abort without open transaction
+#define PARAM_STATUS_TXN_COUNT_MISMATCH  0x14  // Commit count differs from staged count, data[0-1] - staged count
+#define PARAM_STATUS_TXN_FULL            0x15  // No space for another staged value
+#define PARAM_STATUS_TXN_INVALID_OP      0x16  // Unknown transaction operation
+#define PARAM_STATUS_BULK_END            0x17  // End of bulk read stream, data[0-1] - sent, data[2-3] - total parameters
 
 // Save operation options
 #define SAVE_OPT_ALL_PARAMS              0x01  // Save all parameters in RAM
 #define SAVE_OPT_VERIFY_AFTER            0x02  // Verify after saving
 #define SAVE_OPT_BACKUP_PREVIOUS         0x04  // Create backup of previous
 
+// Transaction operations
+#define PARAM_TXN_BEGIN                  0x01
+#define PARAM_TXN_COMMIT                 0x02
+#define PARAM_TXN_ABORT                  0x03
+
+#define CAN_PARAM_TXN_MAX                64    // Values staged in one transaction
+#define CAN_PARAM_TXN_TIMEOUT_MS         5000  // Transaction is dropped after this time without messages
+
 // Reset types
 #define RESET_TYPE_SOFT                  0x01  // Software reset
 #define RESET_TYPE_HARD                  0x02  // Hardware reset
@@ -70,6 +107,11 @@
 #define DECODE_TYPE(type_length)         ((type_length) & 0x0F)
 #define DECODE_LENGTH(type_length)       (((type_length) >> 4) & 0x0F)
 
+// CAN FD batch limits
+#define CAN_FD_PARAM_PER_FRAME           8     // 8 byte write requests or responses in one 64 byte frame
+#define CAN_FD_PARAM_RD_MAX              32    // 2 byte hashes in one 64 byte read request
+#define CAN_PARAM_BULK_WINDOW            4     // MC80_PARAM_ANS frames of a bulk read waiting for transmission
+
 // Timing constants
 #define PARAM_READ_TIMEOUT_MS            10    // Parameter read timeout
 #define PARAM_WRITE_TIMEOUT_MS           10    // Parameter write timeout
@@ -108,6 +150,23 @@ typedef struct __attribute__((packed))
   uint8_t  reserved[3];   // Reserved for future use
 } T_can_param_save_req;
 
+// Parameter transaction request structure (8 bytes)
+typedef struct __attribute__((packed))
+{
+  uint32_t magic_word;   // Magic word (PARAM_TXN_MAGIC_WORD)
+  uint8_t  operation;    // PARAM_TXN_*
+  uint8_t  reserved;     // Reserved for future use
+  uint16_t value_count;  // Commit: number of values the sender staged
+} T_can_param_txn_req;
+
+// Bulk parameter read request structure (8 bytes)
+typedef struct __attribute__((packed))
+{
+  uint16_t first_index;  // Index of the first parameter
+  uint16_t count;        // Number of parameters, 0 - up to the last one
+  uint8_t  reserved[4];  // Reserved for future use
+} T_can_param_bulk_read_req;
+
 // Controller reset request structure (8 bytes)
 typedef struct __attribute__((packed))
 {
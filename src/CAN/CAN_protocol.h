@@ -38,6 +38,21 @@
   - Current: A × 10 (1.23A → 12)
   - Power: W × 10 (15.7W → 157)
 
+  CAN FD MODE:
+  - Optional, used only towards a controller that sends its requests as CAN FD frames.
+    A request sent as a classic frame is always answered with classic frames, so nodes
+    without CAN FD keep working unchanged (fallback is decided per request).
+  - FD responses are sent with bit rate switching (2 Mbit/s data phase)
+  - REQUEST_STATE_TO_ALL as FD frame: 4 status packets as before, then one 64 byte
+    MC80_SENS_INFO frame (node field 0) with sensor and power data of all 4 motors
+  - MC80_PARAM_RD as FD frame: list of up to CAN_FD_PARAM_RD_MAX parameter hashes,
+    answered with MC80_PARAM_ANS FD frames of up to CAN_FD_PARAM_PER_FRAME responses.
+    The node sends frames of one CAN ID in the order they were queued, so the answer frames
+    arrive in the order of the request list
+  - MC80_PARAM_WR as FD frame: up to CAN_FD_PARAM_PER_FRAME write requests,
+    answered with one MC80_PARAM_ANS FD frame
+  - Hash 0x0000 terminates a list, FD frame padding bytes are zero
+
   MOTOR CONTROL:
   - Soft start/stop with configurable acceleration/deceleration times
   - PWM-based speed control with maximum duty cycle limits
@@ -55,6 +70,7 @@
 #define PARAM_SAVE_MAGIC_WORD         0x53415645  // "SAVE" in ASCII
 #define RESET_MAGIC_WORD              0x52535420  // "RST " in ASCII
 #define CLEAR_MOTOR_ERRORS_MAGIC_WORD 0x434C5253  // "CLRS" in ASCII
+#define PARAM_TXN_MAGIC_WORD          0x54584E20  // "TXN " in ASCII
 
 // Base CAN message type identifiers
 #define MC80_REQ                      0x1A01FFFF  // Request command from central controller
@@ -67,6 +83,8 @@
 #define MC80_PARAM_SAVE               0x1A08FFFF  // Parameter save to NV memory request
 #define MC80_RESET                    0x1A09FFFF  // Controller reset command
 #define MC80_CLEAR_MOTOR_ERRORS       0x1A0AFFFF  // Clear motor overcurrent and emergency stop errors
+#define MC80_PARAM_TXN                0x1A0BFFFF  // Parameter transaction control: begin, commit, abort
+#define MC80_PARAM_BULK_RD            0x1A0CFFFF  // Read a range of parameters in one request
 
 // Complete CAN identifiers for motor (Node 1)
 #define MOT3_CMD                      (MC80_REQ | (MOT3_ID << 20))
@@ -142,8 +160,8 @@ typedef __packed struct
 typedef __packed struct
 {
   uint16_t position_sensor;  // Bytes 0-1: Position sensor ADC counts
-                             // MOT3_ID: adc.filt_pos_motor1
-                             // MOT4_ID: adc.filt_pos_motor2
+                             // MOT3_ID: adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_POS]
+                             // MOT4_ID: adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_POS]
                              // MOT2_ID: 0 (no position sensor)
                              // TRACTION_MOT_ID: 0 (no position sensor)
 
@@ -176,6 +194,20 @@ typedef __packed struct
                               // Same mapping as input_current_x10
 } T_can_status_packet3;
 
+// CAN FD telemetry entry of one motor (16 bytes), packet 2 followed by packet 3
+typedef __packed struct
+{
+  T_can_status_packet2 sens;
+  T_can_status_packet3 pwr;
+} T_can_fd_motor_telemetry;
+
+// CAN FD telemetry frame (64 bytes)
+// CAN ID: MC80_SENS_INFO (node field 0 - all motors)
+typedef __packed struct
+{
+  T_can_fd_motor_telemetry motor[4];  // Index is node ID - 1: MOT3_ID, MOT4_ID, MOT2_ID, TRACTION_MOT_ID
+} T_can_fd_telemetry;
+
 // System control command structure
 // Used with REQUEST_SYS_CONTROL command
 // clang-format off
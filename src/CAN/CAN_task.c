@@ -1,16 +1,65 @@
 #include "App.h"
 
+// Frame waiting for a TX mailbox
+typedef struct
+{
+  T_can_msg msg;
+  uint32_t  key;         // Scheduling key: class in the upper bits, CAN ID below, lower value is sent first
+  uint32_t  enq_cycles;  // DWT counter when the frame was queued
+} T_can_tx_entry;
+
+// TX scheduler. Accessed with interrupts disabled from tasks and from the TX complete interrupt.
+typedef struct
+{
+  T_can_tx_entry pending[CAN_TX_QUEUE_DEPTH];       // Sorted by descending key, the next frame to send is the last one
+  uint32_t       pending_cnt;
+  uint32_t       mb_free;                           // Bit n set - mailbox n is free
+  uint8_t        mb_class[CAN_TX_MB_COUNT];         // Class of the frame in the mailbox
+  uint32_t       mb_can_id[CAN_TX_MB_COUNT];        // CAN ID of the frame in the mailbox
+  uint32_t       mb_enq_cycles[CAN_TX_MB_COUNT];    // Queue time of the frame in the mailbox
+  uint32_t       last_tx_time;                      // Tick time of the last TX complete
+} T_can_tx_sched;
+
+// Entry of the RX dispatch table
+typedef struct
+{
+  uint32_t          can_id;        // ID bits compared under the mask
+  uint32_t          mask;          // CAN_RX_MASK_EXACT for a single ID
+  T_can_rx_callback task_handler;  // Called in the CAN RX task, NULL - none
+  T_can_rx_callback isr_handler;   // Called in the RX interrupt, NULL - none
+} T_can_rx_handler;
+
+// Received frame in the RX ring
+typedef struct
+{
+  T_can_msg         msg;        // Passed to the handlers
+  T_can_rx_callback handler;    // Task handler found by the RX interrupt, NULL - none
+  uint32_t          rx_cycles;  // DWT counter when the RX interrupt took the frame
+} T_can_rx_slot;
+
 static void     _Can_tx_task_func(ULONG thread_input);
 static void     _Can_rx_task_func(ULONG thread_input);
-static uint32_t _Process_can_tx_message(T_can_msg* tx_msg);
+static uint32_t _Can_tx_key(uint32_t can_id);
+static bool     _Can_tx_id_in_mailbox(uint32_t can_id);
+static void     _Can_tx_fill_mailboxes(void);
+static void     _Can_tx_task_service(ULONG wait_option);
+static uint32_t _Can_tx_enqueue(uint32_t can_id, const uint8_t* data, uint8_t len, uint8_t options);
+static const T_can_rx_handler* _Can_rx_find_handler(uint32_t can_id);
+static void     _Can_rx_account_latency(T_can_rx_path_stats* p_stats, uint32_t rx_cycles);
+static void     _Can_afl_setup(void);
 
 TX_THREAD    g_can_tx_task;
 TX_THREAD    g_can_rx_task;
-TX_QUEUE     g_can_tx_queue;
 TX_QUEUE     g_can_rx_queue;
-TX_SEMAPHORE g_can_tx_complete_semaphore;  // Semaphore for TX completion synchronization
 bool         g_can_ready                   = false;
 
+#define CAN_TX_EVT_SERVICE 0x01  // Frames were sent or a stream was requested, the service hook is called
+
+static T_can_tx_sched        g_can_tx_sched;
+static TX_EVENT_FLAGS_GROUP  g_can_tx_events;
+static T_can_tx_service_hook g_can_tx_service_hook;
+T_cycle_profile       g_can_tx_latency[CAN_TX_CLASS_COUNT];
+
 // Global CAN error counters structure
 T_can_error_counters g_can_error_counters  = { 0 };
 
@@ -21,11 +70,27 @@ bool     g_can_communication_active  = false; // Flag indicating if CAN communic
 // Global RX callback function pointer
 static T_can_rx_callback g_can_rx_callback = NULL;
 
+// RX dispatch table. Exact IDs come first sorted by ID for binary search,
+// masked entries follow in registration order and are checked after them.
+static T_can_rx_handler        g_can_rx_handlers[CAN_RX_HANDLER_MAX];
+static uint32_t                g_can_rx_handler_cnt;
+static uint32_t                g_can_rx_exact_cnt;
+static bool                    g_can_rx_handlers_locked;  // AFL is built from the table, no more handlers are accepted
+static uint32_t                g_can_afl_rule_cnt;        // Rules programmed into the AFL, 0 - all extended IDs accepted
+static volatile bool           g_can_rx_dispatch_enabled = true;
+static T_can_rx_dispatch_stats g_can_rx_stats;
+const uint32_t                 g_can_rx_latency_edges_us[CAN_RX_LATENCY_BINS] = { 2, 5, 10, 50, 200, 1000, 5000, UINT32_MAX };
+
 static uint8_t g_can_tx_task_stack[CAN_THREAD_STACK_SIZE] BSP_PLACE_IN_SECTION(".stack.CAN_TX_task") BSP_ALIGN_VARIABLE(BSP_STACK_ALIGNMENT);
 static uint8_t g_can_rx_task_stack[CAN_RX_THREAD_STACK_SIZE] BSP_PLACE_IN_SECTION(".stack.CAN_RX_task") BSP_ALIGN_VARIABLE(BSP_STACK_ALIGNMENT);
-static ULONG   g_can_tx_queue_memory[CAN_TX_QUEUE_DEPTH * CAN_TX_QUEUE_MSG_SIZE];
 static ULONG   g_can_rx_queue_memory[CAN_RX_QUEUE_DEPTH * CAN_RX_QUEUE_MSG_SIZE];
 
+// Received frames. A CAN FD frame does not fit into a ThreadX queue message, so the RX interrupt fills
+// the slots in a ring and queues pointers. The ring has two slots more than the queue, the slot being
+// written is never one the RX task still owns.
+static T_can_rx_slot g_can_rx_buf[CAN_RX_BUF_COUNT];
+static uint32_t      g_can_rx_buf_wr;
+
 // Nominal and Data bit timing configuration
 can_bit_timing_cfg_t g_CANFD_bit_timing_cfg = {
   .baud_rate_prescaler        = 1,  // Actual bitrate: 555556 Hz. Actual sample point: 75 %
@@ -43,23 +108,11 @@ can_bit_timing_cfg_t g_CANFD_data_timing_cfg = {
 };
 #endif
 
-// CAN Acceptance Filter List (AFL) - configured to accept ONLY extended (29-bit) messages
-const canfd_afl_entry_t p_CANFD_afl[CANFD_CFG_AFL_CH0_RULE_NUM] = {
-  // Rule 0: Accept all Extended ID (29-bit) messages (both data and remote frames)
-  {
-   .id.id                         = 0x00000000,            // ID value to match (0 = any)
-   .id.frame_type                 = CAN_FRAME_TYPE_DATA,   // Data frames (but mask will ignore this)
-   .id.id_mode                    = CAN_ID_MODE_EXTENDED,  // Extended ID mode (29-bit) - this is enforced
-   .mask.mask_id                  = 0x00000000,            // ID mask (0 = don't check any ID bits)
-   .mask.mask_frame_type          = 0,                     // Don't check frame type (accept both data and remote)
-   .mask.mask_id_mode             = 1,                     // Check ID mode (only extended)
-   .destination.minimum_dlc       = CANFD_MINIMUM_DLC_0,   // Accept any DLC
-   .destination.rx_buffer         = CANFD_RX_MB_NONE,      // Not used for FIFO
-   .destination.fifo_select_flags = CANFD_RX_FIFO_0,       // Route to RX FIFO 0 (using bit flag, not enum)
-  }
-  // Only one rule needed - remaining entries (1-15) will be automatically zero-initialized (unused)
-  // Standard ID (11-bit) messages will be rejected since they don't match the extended ID mode filter
-};
+// CAN Acceptance Filter List (AFL) - accepts ONLY extended (29-bit) messages the registered handlers consume.
+// Filled by _Can_afl_setup before the channel is opened, R_CANFD_Open writes all entries to the hardware.
+// Unused entries stay zero-initialized: they have no destination, so frames not matched by a
+// previous rule are discarded. Standard ID (11-bit) messages never match the extended ID mode rules.
+static canfd_afl_entry_t p_CANFD_afl[CANFD_CFG_AFL_CH0_RULE_NUM];
 
 #define CANFD_CFG_COMMONFIFO0 (((0) << R_CANFD_CFDCFCC_CFE_Pos) |     \
                                ((1) << R_CANFD_CFDCFCC_CFRXIE_Pos) |  \
@@ -74,7 +127,7 @@ const canfd_afl_entry_t p_CANFD_afl[CANFD_CFG_AFL_CH0_RULE_NUM] = {
                                ((3) << R_CANFD_CFDCFCC_CFDC_Pos) |    \
                                (0 << R_CANFD_CFDCFCC_CFITT_Pos))
 
-// Buffer RAM used: 320 bytes
+// Buffer RAM used: 608 bytes (RX FIFO 0: 8 messages with 64 byte payload)
 canfd_global_cfg_t g_CANFD_global_cfg = {
   .global_interrupts = (R_CANFD_CFDGCTR_DEIE_Msk | R_CANFD_CFDGCTR_MEIE_Msk | R_CANFD_CFDGCTR_CMPOFIE_Msk | 0x3),
   .global_config     = ((R_CANFD_CFDGCFG_TPRI_Msk) | (0) | (BSP_CFG_CANFDCLK_SOURCE == BSP_CLOCKS_SOURCE_CLOCK_MAIN_OSC ? R_CANFD_CFDGCFG_DCS_Msk : 0U) | (0) | ((0) << R_CANFD_CFDGCFG_ITRCP_Pos)),
@@ -83,8 +136,8 @@ canfd_global_cfg_t g_CANFD_global_cfg = {
   .rx_fifo_ipl       = CANFD_CFG_RX_FIFO_IPL,
   // RX FIFO Configuration: CANFD Lite has only 2 RX FIFOs (0 and 1)
   .rx_fifo_config    = {
-   // FIFO 0: Enabled with interrupts - used for receiving extended ID messages
-   ((3U) << R_CANFD_CFDRFCC_RFIGCV_Pos) | ((3) << R_CANFD_CFDRFCC_RFDC_Pos) | ((0) << R_CANFD_CFDRFCC_RFPLS_Pos) | (R_CANFD_CFDRFCC_RFIE_Msk | R_CANFD_CFDRFCC_RFIM_Msk) | (R_CANFD_CFDRFCC_RFE_Msk),
+   // FIFO 0: Enabled with interrupts - used for receiving extended ID messages, classic and FD frames up to 64 bytes
+   ((3U) << R_CANFD_CFDRFCC_RFIGCV_Pos) | ((2) << R_CANFD_CFDRFCC_RFDC_Pos) | ((7) << R_CANFD_CFDRFCC_RFPLS_Pos) | (R_CANFD_CFDRFCC_RFIE_Msk | R_CANFD_CFDRFCC_RFIM_Msk) | (R_CANFD_CFDRFCC_RFE_Msk),
    // FIFO 1: Completely disabled - no configuration needed
    ((0)) },
   .common_fifo_config = { CANFD_CFG_COMMONFIFO0 }
@@ -185,7 +238,9 @@ void Can_rx_thread_create(void)
   This function is invoked from interrupt context when CAN hardware events occur.
 
   Events that trigger this callback:
-  - CAN_EVENT_RX_COMPLETE (0x0400): Message received successfully
+  - CAN_EVENT_RX_COMPLETE (0x0400): Message received successfully. The handler of the frame ID is looked up
+    here, an ISR handler is called right away, the frame goes to the RX task only if it has a task handler
+    or a diagnostic callback is set.
   - CAN_EVENT_TX_COMPLETE (0x0800): Message transmitted successfully
   - CAN_EVENT_TX_FIFO_EMPTY (0x2000): Transmit FIFO became empty
   - CAN_EVENT_ERR_WARNING (0x0002): Error warning threshold exceeded
@@ -213,8 +268,10 @@ void Can_rx_thread_create(void)
 -----------------------------------------------------------------------------------------------------*/
 void CANFD_callback(can_callback_args_t* p_args)
 {
-  T_can_msg rx_msg;
-  UINT      queue_status;
+  T_can_rx_slot*          slot;
+  T_can_msg*              rx_msg;
+  const T_can_rx_handler* h;
+  UINT                    queue_status;
 
   if (p_args == NULL)
   {
@@ -229,24 +286,67 @@ void CANFD_callback(can_callback_args_t* p_args)
     // Update last received message time for communication monitoring
     g_can_last_rx_time = tx_time_get();
 
-    // Prepare RX message structure
-    rx_msg.can_id     = p_args->frame.id;
-    rx_msg.dlc        = p_args->frame.data_length_code;
-    rx_msg.frame_type = (uint8_t)p_args->frame.type;
-    rx_msg.id_mode    = (uint8_t)p_args->frame.id_mode;
-    rx_msg.reserved   = 0;
+    // Prepare RX message in the next ring slot. The driver reports the payload length in bytes.
+    slot               = &g_can_rx_buf[g_can_rx_buf_wr];
+    slot->rx_cycles    = CYCLE_PROFILER_NOW();
+    slot->handler      = NULL;
+    rx_msg             = &slot->msg;
+    rx_msg->can_id     = p_args->frame.id;
+    rx_msg->dlc        = p_args->frame.data_length_code > CAN_FD_MAX_DATA ? CAN_FD_MAX_DATA : p_args->frame.data_length_code;
+    rx_msg->frame_type = (uint8_t)p_args->frame.type;
+    rx_msg->id_mode    = (uint8_t)p_args->frame.id_mode;
+    rx_msg->options    = (uint8_t)p_args->frame.options;
+    if (CAN_MSG_IS_FD(rx_msg))
+    {
+      g_can_error_counters.total_fd_rx_messages++;
+    }
+
+    // Copy only the received bytes, handlers check dlc and the classic frame area stays zero-padded
+    if (rx_msg->dlc < CAN_CLASSIC_MAX_DATA)
+    {
+      memset(&rx_msg->data[rx_msg->dlc], 0, CAN_CLASSIC_MAX_DATA - rx_msg->dlc);
+    }
+    memcpy(rx_msg->data, p_args->frame.data, rx_msg->dlc);
+
+    if (g_can_rx_dispatch_enabled)
+    {
+      h = _Can_rx_find_handler(rx_msg->can_id);
+      if (h == NULL)
+      {
+        g_can_rx_stats.unmatched++;
+      }
+      else
+      {
+        if (h->isr_handler != NULL)
+        {
+          h->isr_handler(rx_msg);
+          _Can_rx_account_latency(&g_can_rx_stats.isr, slot->rx_cycles);
+        }
+        slot->handler = h->task_handler;
+      }
+    }
+    else
+    {
+      g_can_rx_stats.disabled++;
+    }
 
-    // Copy received data using optimized memory function
-    memset(rx_msg.data, 0, 8);
-    if (rx_msg.dlc > 0)
+    // Nothing left to do in the RX task, the slot is reused for the next frame
+    if ((slot->handler == NULL) && (g_can_rx_callback == NULL))
     {
-      memcpy(rx_msg.data, p_args->frame.data, rx_msg.dlc > 8 ? 8 : rx_msg.dlc);
+      return;
     }
 
-    // Send message to RX queue (non-blocking from interrupt context)
-    queue_status = tx_queue_send(&g_can_rx_queue, &rx_msg, TX_NO_WAIT);
+    // Send slot pointer to RX queue (non-blocking from interrupt context)
+    queue_status = tx_queue_send(&g_can_rx_queue, &slot, TX_NO_WAIT);
 
-    if (queue_status == TX_QUEUE_FULL)
+    if (queue_status == TX_SUCCESS)
+    {
+      if (++g_can_rx_buf_wr >= CAN_RX_BUF_COUNT)
+      {
+        g_can_rx_buf_wr = 0;
+      }
+    }
+    else if (queue_status == TX_QUEUE_FULL)
     {
       g_can_error_counters.rx_queue_full_errors++;
     }
@@ -255,11 +355,32 @@ void CANFD_callback(can_callback_args_t* p_args)
       g_can_error_counters.rx_queue_receive_errors++;
     }
   }
-  // Handle TX completion event
-  else if (p_args->event == CAN_EVENT_TX_COMPLETE)
+  // Handle TX completion event: the mailbox is refilled right here with the next waiting frame
+  else if ((p_args->event == CAN_EVENT_TX_COMPLETE) || (p_args->event == CAN_EVENT_TX_ABORTED))
   {
-    // Signal that mailbox is available for next transmission
-    tx_semaphore_put(&g_can_tx_complete_semaphore);
+    uint32_t mb = p_args->buffer;
+
+    if (mb < CAN_TX_MB_COUNT)
+    {
+      TX_INTERRUPT_SAVE_AREA
+      TX_DISABLE
+      if (p_args->event == CAN_EVENT_TX_COMPLETE)
+      {
+        Cycle_profile_update(&g_can_tx_latency[g_can_tx_sched.mb_class[mb]], g_can_tx_sched.mb_enq_cycles[mb], CYCLE_PROFILER_NOW());
+        g_can_tx_sched.last_tx_time = tx_time_get();
+      }
+      else
+      {
+        g_can_error_counters.tx_aborted_count++;
+      }
+      g_can_tx_sched.mb_free |= BIT(mb);
+      _Can_tx_fill_mailboxes();
+      TX_RESTORE
+      if (g_can_tx_service_hook != NULL)
+      {
+        tx_event_flags_set(&g_can_tx_events, CAN_TX_EVT_SERVICE, TX_OR);
+      }
+    }
   }
   // Handle error events and update counters
   else if (p_args->event & CAN_EVENT_ERR_BUS_OFF)
@@ -278,10 +399,6 @@ void CANFD_callback(can_callback_args_t* p_args)
   {
     g_can_error_counters.bus_lock_errors++;
   }
-  else if (p_args->event & CAN_EVENT_TX_ABORTED)
-  {
-    g_can_error_counters.tx_aborted_count++;
-  }
   else if (p_args->event & (CAN_EVENT_MAILBOX_MESSAGE_LOST | CAN_EVENT_FIFO_MESSAGE_LOST))
   {
     g_can_error_counters.message_lost_errors++;
@@ -289,64 +406,189 @@ void CANFD_callback(can_callback_args_t* p_args)
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Process CAN transmission message
+  Find the handler of a received frame. Exact IDs are found by binary search, masked entries are
+  checked after them in registration order. Called from the RX interrupt.
 
   Parameters:
-    tx_msg - pointer to CAN message structure
+    can_id - 29-bit CAN identifier
 
   Return:
-    0 - success
-    error code - failure
+    Pointer to table entry, NULL if no handler is registered for the ID
 -----------------------------------------------------------------------------------------------------*/
-static uint32_t _Process_can_tx_message(T_can_msg* tx_msg)
+static const T_can_rx_handler* _Can_rx_find_handler(uint32_t can_id)
 {
-  fsp_err_t   err;
-  can_frame_t can_frame;
-  UINT        semaphore_status;
+  uint32_t lo = 0;
+  uint32_t hi = g_can_rx_exact_cnt;
+  uint32_t mid;
 
-  if (tx_msg == NULL)
+  while (lo < hi)
   {
-    g_can_error_counters.tx_invalid_param_errors++;
-    return 1;  // Invalid parameter
+    mid = (lo + hi) / 2;
+    if (g_can_rx_handlers[mid].can_id < can_id)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
   }
-  // Wait for mailbox to be available (with timeout)
-  semaphore_status = tx_semaphore_get(&g_can_tx_complete_semaphore, 100);  // 100 ticks timeout
-  if (semaphore_status != TX_SUCCESS)
+  if ((lo < g_can_rx_exact_cnt) && (g_can_rx_handlers[lo].can_id == can_id))
   {
-    g_can_error_counters.tx_semaphore_timeout_errors++;
-    APPLOG("CAN Task: Timeout waiting for TX mailbox, status: %d", semaphore_status);
-    return semaphore_status;
+    return &g_can_rx_handlers[lo];
   }
 
-  // Prepare CAN frame structure
-  can_frame.id               = tx_msg->can_id;
-  can_frame.id_mode          = (can_id_mode_t)tx_msg->id_mode;
-  can_frame.type             = (can_frame_type_t)tx_msg->frame_type;
-  can_frame.data_length_code = tx_msg->dlc;
-  can_frame.options          = 0;  // No special options
-  // Clear all data bytes first
-  memset(can_frame.data, 0, 8);
+  for (uint32_t i = g_can_rx_exact_cnt; i < g_can_rx_handler_cnt; i++)
+  {
+    if ((can_id & g_can_rx_handlers[i].mask) == g_can_rx_handlers[i].can_id)
+    {
+      return &g_can_rx_handlers[i];
+    }
+  }
+  return NULL;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Account the time from the RX interrupt to the return of a handler
+
+  Parameters:
+    p_stats   - statistics of the dispatch path
+    rx_cycles - DWT counter when the RX interrupt took the frame
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Can_rx_account_latency(T_can_rx_path_stats* p_stats, uint32_t rx_cycles)
+{
+  uint32_t latency_us = (CYCLE_PROFILER_NOW() - rx_cycles) / FRQ_CPUCLK_MHZ;
+  uint32_t bin        = 0;
 
-  // Copy data from message to CAN frame (only copy valid data)
-  if (tx_msg->dlc > 0)
+  while ((bin < (CAN_RX_LATENCY_BINS - 1)) && (latency_us > g_can_rx_latency_edges_us[bin]))
+  {
+    bin++;
+  }
+  p_stats->hist[bin]++;
+  p_stats->count++;
+  p_stats->last_us = latency_us;
+  if (latency_us > p_stats->max_us)
   {
-    memcpy(can_frame.data, tx_msg->data, tx_msg->dlc);
+    p_stats->max_us = latency_us;
   }
-  // Try to write the message to CAN
-  err = R_CANFD_Write(&g_CANFD_ctrl, 0, &can_frame);  // Using mailbox 0
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Calculate the scheduling key of a frame. The message type field of the MC80 protocol selects the class,
+  so status frames are not held back by parameter responses of a node with a lower ID.
 
-  if (err != FSP_SUCCESS)
+  Parameters:
+    can_id - 29-bit CAN identifier
+
+  Return:
+    Scheduling key, lower value is sent first
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Can_tx_key(uint32_t can_id)
+{
+  uint32_t cls;
+
+  switch ((can_id >> 16) & 0x0F)
   {
-    // Return semaphore if write failed
-    tx_semaphore_put(&g_can_tx_complete_semaphore);
-    g_can_error_counters.tx_hardware_errors++;
-    APPLOG("CAN Task: Failed to write CAN message, error: 0x%x", err);
-    return err;
+    case (MC80_ANS >> 16) & 0x0F:
+      cls = CAN_TX_CLASS_STATUS;
+      break;
+    case (MC80_SENS_INFO >> 16) & 0x0F:
+    case (MC80_PWR_INFO >> 16) & 0x0F:
+      cls = CAN_TX_CLASS_TELEMETRY;
+      break;
+    default:
+      cls = CAN_TX_CLASS_OTHER;
+      break;
   }
+  return (cls << 29) | can_id;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Check if a frame with the given CAN ID occupies a TX mailbox
+
+  Parameters:
+    can_id - 29-bit CAN identifier
+
+  Return:
+    true if a mailbox holds a frame with this ID
+-----------------------------------------------------------------------------------------------------*/
+static bool _Can_tx_id_in_mailbox(uint32_t can_id)
+{
+  T_can_tx_sched *p = &g_can_tx_sched;
+
+  for (uint32_t mb = 0; mb < CAN_TX_MB_COUNT; mb++)
+  {
+    if (((p->mb_free & BIT(mb)) == 0) && (p->mb_can_id[mb] == can_id))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Move waiting frames into free TX mailboxes, highest priority first.
+  Called with interrupts disabled. The hardware sends frames of occupied mailboxes in CAN ID order (TPRI)
+  and frames with equal IDs in mailbox number order, which is not the order they were queued in.
+  A frame therefore waits while a frame with the same ID is in a mailbox, so frames of one ID leave
+  in queue order. Frames of other IDs behind it may take the free mailboxes meanwhile.
+
+  Parameters:
+    None
 
-  // Note: semaphore will be released in TX_COMPLETE callback
-  g_can_error_counters.total_tx_messages++;
-  return 0;
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Can_tx_fill_mailboxes(void)
+{
+  T_can_tx_sched *p = &g_can_tx_sched;
+  T_can_tx_entry  e;
+  can_frame_t     can_frame;
+  fsp_err_t       err;
+  uint32_t        mb;
+  uint32_t        i = p->pending_cnt;
+
+  while ((p->mb_free != 0) && (i > 0))
+  {
+    // Frames of one ID are adjacent in the pending list, all of them are skipped while one is in a mailbox
+    i--;
+    if (_Can_tx_id_in_mailbox(p->pending[i].msg.can_id))
+    {
+      continue;
+    }
+    e = p->pending[i];
+    p->pending_cnt--;
+    memmove(&p->pending[i], &p->pending[i + 1], (p->pending_cnt - i) * sizeof(T_can_tx_entry));
+
+    mb = __CLZ(__RBIT(p->mb_free));  // Lowest free mailbox
+
+    can_frame.id               = e.msg.can_id;
+    can_frame.id_mode          = (can_id_mode_t)e.msg.id_mode;
+    can_frame.type             = (can_frame_type_t)e.msg.frame_type;
+    can_frame.data_length_code = e.msg.dlc;
+    can_frame.options          = e.msg.options;
+    memcpy(can_frame.data, e.msg.data, e.msg.dlc);
+
+    err = R_CANFD_Write(&g_CANFD_ctrl, mb, &can_frame);
+    if (err != FSP_SUCCESS)
+    {
+      // Frame is dropped, the mailbox stays free for the next one
+      g_can_error_counters.tx_hardware_errors++;
+      continue;
+    }
+    p->mb_free          &= ~BIT(mb);
+    p->mb_class[mb]      = (uint8_t)(e.key >> 29);
+    p->mb_can_id[mb]     = e.msg.can_id;
+    p->mb_enq_cycles[mb] = e.enq_cycles;
+    g_can_error_counters.total_tx_messages++;
+    if (CAN_MSG_IS_FD(&e.msg))
+    {
+      g_can_error_counters.total_fd_tx_messages++;
+    }
+  }
 }
 
 /*-----------------------------------------------------------------------------------------------------
@@ -360,9 +602,7 @@ static uint32_t _Process_can_tx_message(T_can_msg* tx_msg)
 static void _Can_tx_task_func(ULONG thread_input)
 {
   fsp_err_t err;
-  UINT      queue_status;
   UINT      status;
-  T_can_msg tx_msg;
   // Log CAN initialization start
   APPLOG("CAN Task: Starting CAN interface initialization");
 
@@ -375,15 +615,18 @@ static void _Can_tx_task_func(ULONG thread_input)
   }
   APPLOG("CAN Task: CAN_EN signal enabled successfully");
 
-  // Initialize CAN TX queue
-  status = tx_queue_create(&g_can_tx_queue,
-                           (CHAR*)"CAN_TX_QUEUE",
-                           CAN_TX_QUEUE_MSG_SIZE,
-                           g_can_tx_queue_memory,
-                           sizeof(g_can_tx_queue_memory));
+  // Initialize TX scheduler, all mailboxes are free
+  memset(&g_can_tx_sched, 0, sizeof(g_can_tx_sched));
+  g_can_tx_sched.mb_free = BIT(CAN_TX_MB_COUNT) - 1;
+  for (uint32_t i = 0; i < CAN_TX_CLASS_COUNT; i++)
+  {
+    Cycle_profile_reset(&g_can_tx_latency[i]);
+  }
+
+  status = tx_event_flags_create(&g_can_tx_events, (CHAR*)"CAN_TX_EVENTS");
   if (status != TX_SUCCESS)
   {
-    APPLOG("CAN Task: Failed to create CAN TX queue, error: %d", status);
+    APPLOG("CAN Task: Failed to create CAN TX event flags, error: %d", status);
     return;  // Exit task on error
   }
 
@@ -399,15 +642,8 @@ static void _Can_tx_task_func(ULONG thread_input)
     return;  // Exit task on error
   }
 
-  // Initialize CAN TX completion semaphore
-  status = tx_semaphore_create(&g_can_tx_complete_semaphore,
-                               (CHAR*)"CAN_TX_COMPLETE_SEM",
-                               1);  // Start with 1 - mailbox is initially available
-  if (status != TX_SUCCESS)
-  {
-    APPLOG("CAN Task: Failed to create CAN TX completion semaphore, error: %d", status);
-    return;  // Exit task on error
-  }
+  // Acceptance filter from the registered handlers, handlers must be registered before this task starts
+  _Can_afl_setup();
 
   // Open CAN interface
   err = R_CANFD_Open(&g_CANFD_ctrl, &g_CANFD_cfg);
@@ -426,26 +662,112 @@ static void _Can_tx_task_func(ULONG thread_input)
   // Set global ready flag
   g_can_ready = true;
 
-  // Main loop - process messages from queue
+  // Frames are sent by Can_send_extended_data and the TX complete interrupt
   while (1)
   {
-    // Wait for message in queue with timeout
-    queue_status = tx_queue_receive(&g_can_tx_queue, &tx_msg, 100);  // 100 tick timeout
+    _Can_tx_task_service(ms_to_ticks(CAN_TX_STALL_MS / 2));
+  }
+}
 
-    if (queue_status == TX_SUCCESS)
-    {
-      // Process the received message
-      _Process_can_tx_message(&tx_msg);
-    }
-    else if (queue_status != TX_QUEUE_EMPTY)
-    {
-      // Log error if it's not just an empty queue
-      APPLOG("CAN Task: Queue receive error: %d", queue_status);
-    }
-    // If queue is empty, loop continues with next timeout
+/*-----------------------------------------------------------------------------------------------------
+  One pass of the CAN TX task. Waits until frames were sent or a stream was requested, then lets the
+  service hook queue the next frames of its stream. Waiting frames are dropped when the bus does not
+  take any frame for a long time, so that outdated status is not sent after the bus recovers.
+
+  Parameters:
+    wait_option - ticks to wait for the service event
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Can_tx_task_service(ULONG wait_option)
+{
+  TX_INTERRUPT_SAVE_AREA
+  ULONG flags;
+
+  tx_event_flags_get(&g_can_tx_events, CAN_TX_EVT_SERVICE, TX_OR_CLEAR, &flags, wait_option);
+
+  TX_DISABLE
+  if ((g_can_tx_sched.pending_cnt != 0) && (g_can_tx_sched.mb_free == 0) &&
+      ((tx_time_get() - g_can_tx_sched.last_tx_time) >= ms_to_ticks(CAN_TX_STALL_MS)))
+  {
+    g_can_error_counters.tx_stale_dropped += g_can_tx_sched.pending_cnt;
+    g_can_tx_sched.pending_cnt             = 0;
+  }
+  TX_RESTORE
+
+  if (g_can_tx_service_hook != NULL)
+  {
+    g_can_tx_service_hook();
   }
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Fill the acceptance filter list from the RX handler table, so frames for other nodes are dropped by
+  the hardware without an interrupt. The handler table is locked afterwards.
+  Falls back to a single rule accepting every extended ID if no handler is registered, the generated
+  rules do not cover all handlers or CAN_AFL_ACCEPT_ALL is set.
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Can_afl_setup(void)
+{
+  TX_INTERRUPT_SAVE_AREA
+  T_can_afl_rule filters[CAN_RX_HANDLER_MAX];
+  T_can_afl_rule rules[CANFD_CFG_AFL_CH0_RULE_NUM];
+  uint32_t       filter_cnt;
+  uint32_t       rule_cnt = 0;
+  uint32_t       hw_cnt   = 1;
+
+  TX_DISABLE
+  g_can_rx_handlers_locked = true;
+  TX_RESTORE
+
+  filter_cnt = g_can_rx_handler_cnt;
+  for (uint32_t i = 0; i < filter_cnt; i++)
+  {
+    filters[i].id   = g_can_rx_handlers[i].can_id;
+    filters[i].mask = g_can_rx_handlers[i].mask;
+  }
+
+#if !CAN_AFL_ACCEPT_ALL
+  rule_cnt = Can_afl_build(filters, filter_cnt, rules, CANFD_CFG_AFL_CH0_RULE_NUM);
+  if ((rule_cnt != 0) && (Can_afl_check_coverage(filters, filter_cnt, rules, rule_cnt) != 0))
+  {
+    APPLOG("CAN Task: AFL rules do not cover all handlers, accepting all extended IDs");
+    rule_cnt = 0;
+  }
+#endif
+  if (rule_cnt != 0)
+  {
+    hw_cnt = rule_cnt;
+  }
+  else
+  {
+    rules[0].id   = 0;  // ID mask 0, any extended ID matches
+    rules[0].mask = 0;
+  }
+
+  memset(p_CANFD_afl, 0, sizeof(p_CANFD_afl));
+  for (uint32_t i = 0; i < hw_cnt; i++)
+  {
+    p_CANFD_afl[i].id.id                         = rules[i].id;
+    p_CANFD_afl[i].id.frame_type                 = CAN_FRAME_TYPE_DATA;   // Data frames (but mask will ignore this)
+    p_CANFD_afl[i].id.id_mode                    = CAN_ID_MODE_EXTENDED;  // Extended ID mode (29-bit) - this is enforced
+    p_CANFD_afl[i].mask.mask_id                  = rules[i].mask;
+    p_CANFD_afl[i].mask.mask_frame_type          = 0;                     // Don't check frame type (accept both data and remote)
+    p_CANFD_afl[i].mask.mask_id_mode             = 1;                     // Check ID mode (only extended)
+    p_CANFD_afl[i].destination.minimum_dlc       = CANFD_MINIMUM_DLC_0;   // Accept any DLC
+    p_CANFD_afl[i].destination.rx_buffer         = CANFD_RX_MB_NONE;      // Not used for FIFO
+    p_CANFD_afl[i].destination.fifo_select_flags = CANFD_RX_FIFO_0;       // Route to RX FIFO 0 (using bit flag, not enum)
+  }
+  g_can_afl_rule_cnt = rule_cnt;
+  APPLOG("CAN Task: AFL programmed with %u rules for %u handlers", (unsigned int)hw_cnt, (unsigned int)filter_cnt);
+}
+
 /*-----------------------------------------------------------------------------------------------------
   CAN RX task function
 
@@ -456,23 +778,30 @@ static void _Can_tx_task_func(ULONG thread_input)
 -----------------------------------------------------------------------------------------------------*/
 static void _Can_rx_task_func(ULONG thread_input)
 {
-  UINT      queue_status;
-  T_can_msg rx_msg;
-  uint32_t  message_count = 0;
+  UINT           queue_status;
+  T_can_rx_slot* slot;
+  uint32_t       message_count = 0;
 
   APPLOG("CAN Task: CAN RX task started");
   while (1)
   {
     // Wait for message in RX queue with timeout
-    queue_status = tx_queue_receive(&g_can_rx_queue, &rx_msg, 50);  // 50 tick timeout
+    queue_status = tx_queue_receive(&g_can_rx_queue, &slot, 50);  // 50 tick timeout
 
     if (queue_status == TX_SUCCESS)
     {
-      // Call user callback if registered
+      // Call diagnostic callback if registered
       if (g_can_rx_callback != NULL)
       {
-        g_can_rx_callback(&rx_msg);
-      }      message_count++;
+        g_can_rx_callback(&slot->msg);
+      }
+      // Handler was found by the RX interrupt, dispatch could be disabled since then
+      if ((slot->handler != NULL) && g_can_rx_dispatch_enabled)
+      {
+        slot->handler(&slot->msg);
+        _Can_rx_account_latency(&g_can_rx_stats.task, slot->rx_cycles);
+      }
+      message_count++;
 
       // Log message count every 10 messages (for monitoring)
       // if ((message_count % 10) == 0)
@@ -494,7 +823,8 @@ static void _Can_rx_task_func(ULONG thread_input)
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Send CAN extended data frame to transmission queue
+  Send CAN extended data frame. The frame goes directly into a free TX mailbox, or waits in the
+  scheduler ordered by class and CAN ID until the TX complete interrupt frees a mailbox.
 
   Parameters:
     can_id - CAN identifier (29-bit extended ID)
@@ -505,27 +835,107 @@ static void _Can_rx_task_func(ULONG thread_input)
     CAN_SEND_SUCCESS - success
     CAN_SEND_INVALID_PARAM - invalid parameter
     CAN_SEND_QUEUE_FULL - queue full
-    CAN_SEND_QUEUE_ERROR - queue send error
     CAN_SEND_NOT_READY - CAN not ready
 -----------------------------------------------------------------------------------------------------*/
 uint32_t Can_send_extended_data(uint32_t can_id, uint8_t* data, uint8_t dlc)
 {
-  UINT      queue_status;
-  T_can_msg tx_msg;
-
-  // Check if CAN is ready
-  if (!g_can_ready)
+  // Validate parameters
+  if (dlc > CAN_CLASSIC_MAX_DATA)
   {
-    g_can_error_counters.tx_not_ready_errors++;
-    return CAN_SEND_NOT_READY;
+    g_can_error_counters.tx_invalid_param_errors++;
+    return CAN_SEND_INVALID_PARAM;
   }
+  return _Can_tx_enqueue(can_id, data, dlc, 0);
+}
 
-  // Validate parameters
-  if (dlc > 8)
+/*-----------------------------------------------------------------------------------------------------
+  Send CAN FD extended data frame with bit rate switching. The payload is zero-padded to the next
+  length a CAN FD DLC can encode. Only used towards nodes that talk CAN FD themselves,
+  see Can_fd_frame_length() for the padding rule.
+
+  Parameters:
+    can_id - CAN identifier (29-bit extended ID)
+    data - pointer to data bytes (can be NULL)
+    len - number of data bytes (0-64)
+
+  Return:
+    CAN_SEND_SUCCESS - success
+    CAN_SEND_INVALID_PARAM - invalid parameter
+    CAN_SEND_QUEUE_FULL - queue full
+    CAN_SEND_NOT_READY - CAN not ready
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Can_send_fd_data(uint32_t can_id, const uint8_t* data, uint8_t len)
+{
+#if BSP_FEATURE_CANFD_FD_SUPPORT
+  if (len > CAN_FD_MAX_DATA)
   {
     g_can_error_counters.tx_invalid_param_errors++;
     return CAN_SEND_INVALID_PARAM;
   }
+  return _Can_tx_enqueue(can_id, data, len, CANFD_FRAME_OPTION_FD | CANFD_FRAME_OPTION_BRS);
+#else
+  g_can_error_counters.tx_invalid_param_errors++;
+  return CAN_SEND_INVALID_PARAM;
+#endif
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Get the length of a CAN FD frame carrying the given number of bytes. Above 8 bytes the DLC only
+  encodes 12, 16, 20, 24, 32, 48 and 64.
+
+  Parameters:
+    len - number of payload bytes (0-64)
+
+  Return:
+    Frame length in bytes
+-----------------------------------------------------------------------------------------------------*/
+uint8_t Can_fd_frame_length(uint8_t len)
+{
+  if (len <= 8)
+  {
+    return len;
+  }
+  if (len <= 24)
+  {
+    return (uint8_t)((len + 3) & ~3u);
+  }
+  if (len <= 32)
+  {
+    return 32;
+  }
+  if (len <= 48)
+  {
+    return 48;
+  }
+  return CAN_FD_MAX_DATA;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Put a frame into the TX scheduler and start transmission if a mailbox is free
+
+  Parameters:
+    can_id - CAN identifier (29-bit extended ID)
+    data - pointer to data bytes (can be NULL)
+    len - number of data bytes, checked by the caller
+    options - CANFD_FRAME_OPTION_* flags, 0 for classic CAN
+
+  Return:
+    CAN_SEND_* code
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Can_tx_enqueue(uint32_t can_id, const uint8_t* data, uint8_t len, uint8_t options)
+{
+  TX_INTERRUPT_SAVE_AREA
+  T_can_tx_entry  entry;
+  T_can_tx_sched *p = &g_can_tx_sched;
+  uint32_t        i;
+  uint8_t         frame_len;
+
+  // Check if CAN is ready
+  if (!g_can_ready)
+  {
+    g_can_error_counters.tx_not_ready_errors++;
+    return CAN_SEND_NOT_READY;
+  }
 
   // For extended CAN, ID must be 29 bits max
   if (can_id > 0x1FFFFFFF)
@@ -534,40 +944,130 @@ uint32_t Can_send_extended_data(uint32_t can_id, uint8_t* data, uint8_t dlc)
     return CAN_SEND_INVALID_PARAM;
   }
 
+  frame_len = (options & CANFD_FRAME_OPTION_FD) ? Can_fd_frame_length(len) : len;
+
   // Prepare message structure
-  tx_msg.can_id     = can_id;
-  tx_msg.dlc        = dlc;
-  tx_msg.frame_type = CAN_FRAME_TYPE_DATA;
-  tx_msg.id_mode    = CAN_ID_MODE_EXTENDED;
-  tx_msg.reserved   = 0;
+  entry.msg.can_id     = can_id;
+  entry.msg.dlc        = frame_len;
+  entry.msg.frame_type = CAN_FRAME_TYPE_DATA;
+  entry.msg.id_mode    = CAN_ID_MODE_EXTENDED;
+  entry.msg.options    = options;
+
+  // Copy data to message structure if provided, the rest of the frame is zero
+  if (data != NULL && len > 0)
+  {
+    memcpy(entry.msg.data, data, len);
+  }
+  else
+  {
+    len = 0;
+  }
+  memset(&entry.msg.data[len], 0, frame_len - len);
+  entry.key        = _Can_tx_key(can_id);
+  entry.enq_cycles = CYCLE_PROFILER_NOW();
 
-  // Initialize data array to zero
-  memset(tx_msg.data, 0, 8);
+  TX_DISABLE
+  if (p->pending_cnt >= CAN_TX_QUEUE_DEPTH)
+  {
+    TX_RESTORE
+    g_can_error_counters.tx_queue_full_errors++;
+    APPLOG("CAN Task: TX queue full, message dropped");
+    return CAN_SEND_QUEUE_FULL;
+  }
 
-  // Copy data to message structure if provided
-  if (data != NULL && dlc > 0)
+  // Insert below all frames with the same or lower key, so equal keys keep the queue order
+  i = p->pending_cnt;
+  while ((i > 0) && (p->pending[i - 1].key <= entry.key))
   {
-    memcpy(tx_msg.data, data, dlc);
+    p->pending[i] = p->pending[i - 1];
+    i--;
   }
+  p->pending[i] = entry;
+  p->pending_cnt++;
+  if (p->pending_cnt > g_can_error_counters.tx_peak_pending)
+  {
+    g_can_error_counters.tx_peak_pending = p->pending_cnt;
+  }
+
+  _Can_tx_fill_mailboxes();
+  TX_RESTORE
 
-  // Send message to queue (non-blocking)
-  queue_status = tx_queue_send(&g_can_tx_queue, &tx_msg, TX_NO_WAIT);
+  return CAN_SEND_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Get number of frames waiting for a free TX mailbox
 
-  if (queue_status == TX_SUCCESS)
+  Parameters:
+
+  Return:
+    Number of waiting frames
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Can_get_tx_pending_count(void)
+{
+  return g_can_tx_sched.pending_cnt;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Get number of frames with the given CAN ID that wait for a mailbox or are being sent
+
+  Parameters:
+    can_id - 29-bit CAN identifier
+
+  Return:
+    Number of frames not yet sent
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Can_get_tx_id_count(uint32_t can_id)
+{
+  TX_INTERRUPT_SAVE_AREA
+  T_can_tx_sched *p   = &g_can_tx_sched;
+  uint32_t        cnt = 0;
+
+  TX_DISABLE
+  for (uint32_t i = 0; i < p->pending_cnt; i++)
   {
-    return CAN_SEND_SUCCESS;
+    if (p->pending[i].msg.can_id == can_id)
+    {
+      cnt++;
+    }
   }
-  else if (queue_status == TX_QUEUE_FULL)
+  for (uint32_t mb = 0; mb < CAN_TX_MB_COUNT; mb++)
   {
-    g_can_error_counters.tx_queue_full_errors++;
-    APPLOG("CAN Task: TX queue full, message dropped");
-    return CAN_SEND_QUEUE_FULL;
+    if (((p->mb_free & BIT(mb)) == 0) && (p->mb_can_id[mb] == can_id))
+    {
+      cnt++;
+    }
   }
-  else
+  TX_RESTORE
+  return cnt;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Set the function the CAN TX task calls after frames were sent. A module that streams more frames than
+  the TX scheduler holds queues the next ones from this hook instead of waiting in its own task.
+
+  Parameters:
+    hook - function or NULL
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void Can_tx_set_service_hook(T_can_tx_service_hook hook)
+{
+  g_can_tx_service_hook = hook;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Wake the CAN TX task to call the service hook, used to start a stream
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void Can_tx_request_service(void)
+{
+  if (g_can_ready)
   {
-    g_can_error_counters.tx_queue_send_errors++;
-    APPLOG("CAN Task: Queue send error: %d", queue_status);
-    return CAN_SEND_QUEUE_ERROR;
+    tx_event_flags_set(&g_can_tx_events, CAN_TX_EVT_SERVICE, TX_OR);
   }
 }
 
@@ -595,6 +1095,11 @@ bool Can_is_ready(void)
 void Can_reset_error_counters(void)
 {
   memset(&g_can_error_counters, 0, sizeof(T_can_error_counters));
+  for (uint32_t i = 0; i < CAN_TX_CLASS_COUNT; i++)
+  {
+    Cycle_profile_reset(&g_can_tx_latency[i]);
+  }
+  Can_rx_dispatch_stats_reset();
 }
 
 /*-----------------------------------------------------------------------------------------------------
@@ -640,7 +1145,8 @@ uint32_t Can_get_rx_queue_count(void)
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Set user callback function for received CAN messages
+  Set callback called in the CAN RX task for every received frame before its registered handler.
+  Used by diagnostics to watch the bus, frames are dispatched to the handlers regardless of it.
 
   Parameters:
     callback - pointer to callback function (NULL to disable)
@@ -710,3 +1216,147 @@ void Can_check_communication_timeout(void)
     }
   }
 }
+
+/*-----------------------------------------------------------------------------------------------------
+  Register a handler for received frames with an extended ID. A frame is passed to the first entry
+  it matches, exact IDs are checked before masked entries.
+  The ISR handler is called in the RX interrupt before the frame is queued, it must be short and
+  must not block or log. The task handler is called in the CAN RX task afterwards.
+  Handlers must be registered before Can_thread_create, the acceptance filter is built from them
+  when the channel is opened.
+
+  Parameters:
+    can_id       - 29-bit CAN identifier
+    mask         - ID bits to compare, CAN_RX_MASK_EXACT for a single ID
+    task_handler - handler called in the CAN RX task (can be NULL)
+    isr_handler  - handler called in the RX interrupt (can be NULL)
+
+  Return:
+    RES_OK on success, RES_ERROR if the table is full or locked, the ID is already registered or no handler is given
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Can_rx_register_handler(uint32_t can_id, uint32_t mask, T_can_rx_callback task_handler, T_can_rx_callback isr_handler)
+{
+  TX_INTERRUPT_SAVE_AREA
+  T_can_rx_handler  entry;
+  T_can_rx_handler* h = g_can_rx_handlers;
+  uint32_t          i;
+
+  if (((task_handler == NULL) && (isr_handler == NULL)) || ((mask & ~CAN_RX_MASK_EXACT) != 0))
+  {
+    return RES_ERROR;
+  }
+  entry.can_id       = can_id & mask;
+  entry.mask         = mask;
+  entry.task_handler = task_handler;
+  entry.isr_handler  = isr_handler;
+
+  // The RX interrupt searches the table, it is changed with interrupts disabled
+  TX_DISABLE
+  if (g_can_rx_handlers_locked)
+  {
+    TX_RESTORE
+    return RES_ERROR;
+  }
+  for (i = 0; i < g_can_rx_handler_cnt; i++)
+  {
+    if ((h[i].can_id == entry.can_id) && (h[i].mask == entry.mask))
+    {
+      TX_RESTORE
+      return RES_ERROR;
+    }
+  }
+  if (g_can_rx_handler_cnt >= CAN_RX_HANDLER_MAX)
+  {
+    TX_RESTORE
+    return RES_ERROR;
+  }
+
+  if (mask == CAN_RX_MASK_EXACT)
+  {
+    // Shift masked entries and greater IDs up by one to keep the exact part sorted
+    i = g_can_rx_handler_cnt;
+    while (i > g_can_rx_exact_cnt)
+    {
+      h[i] = h[i - 1];
+      i--;
+    }
+    while ((i > 0) && (h[i - 1].can_id > entry.can_id))
+    {
+      h[i] = h[i - 1];
+      i--;
+    }
+    h[i] = entry;
+    g_can_rx_exact_cnt++;
+  }
+  else
+  {
+    h[g_can_rx_handler_cnt] = entry;
+  }
+  g_can_rx_handler_cnt++;
+  TX_RESTORE
+
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Enable or disable dispatch of received frames to the registered handlers.
+  The diagnostic callback still gets all frames while dispatch is disabled.
+
+  Parameters:
+    enabled - false to stop calling ISR and task handlers
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Can_rx_set_dispatch_enabled(bool enabled)
+{
+  g_can_rx_dispatch_enabled = enabled;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Get snapshot of RX dispatch statistics
+
+  Parameters:
+    p_stats - pointer to structure to fill
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Can_rx_dispatch_stats_get(T_can_rx_dispatch_stats* p_stats)
+{
+  TX_INTERRUPT_SAVE_AREA
+  TX_DISABLE
+  *p_stats = g_can_rx_stats;
+  TX_RESTORE
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Reset RX dispatch statistics
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Can_rx_dispatch_stats_reset(void)
+{
+  TX_INTERRUPT_SAVE_AREA
+  TX_DISABLE
+  memset(&g_can_rx_stats, 0, sizeof(g_can_rx_stats));
+  TX_RESTORE
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Get number of acceptance filter rules generated from the RX handlers
+
+  Parameters:
+    None
+
+  Return:
+    Number of rules, 0 if the filter accepts all extended IDs
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Can_get_afl_rule_count(void)
+{
+  return g_can_afl_rule_cnt;
+}
@@ -1,10 +1,19 @@
 #ifndef CAN_TASK_H
 #define CAN_TASK_H
 
-#define CAN_TX_QUEUE_DEPTH     20
-#define CAN_TX_QUEUE_MSG_SIZE  4  // Size in ULONG units (16 bytes)
+#define CAN_TX_QUEUE_DEPTH     20 // Frames waiting for a free TX mailbox
+#define CAN_TX_MB_COUNT        4  // TX mailboxes 0..3, TX interrupts are enabled in txmb_txi_enable
+#define CAN_TX_STALL_MS        200  // Waiting frames are dropped if no frame was sent for this time
 #define CAN_RX_QUEUE_DEPTH     20
-#define CAN_RX_QUEUE_MSG_SIZE  4  // Size in ULONG units (16 bytes)
+#define CAN_RX_QUEUE_MSG_SIZE  1  // Size in ULONG units, the queue carries pointers to frames in the RX buffer ring
+#define CAN_RX_BUF_COUNT       (CAN_RX_QUEUE_DEPTH + 2)  // Queued frames, the frame being processed and the one being written
+
+#define CAN_RX_HANDLER_MAX     16  // Entries of the RX dispatch table
+#define CAN_RX_MASK_EXACT      0x1FFFFFFF  // Mask of a handler registered for one extended ID
+#define CAN_RX_LATENCY_BINS    8   // Number of RX-to-handled latency histogram bins
+
+#define CAN_CLASSIC_MAX_DATA   8
+#define CAN_FD_MAX_DATA        64  // Payload of a CAN FD frame, sent with bit rate switching to the data phase rate
 
 // CAN send message return codes
 #define CAN_SEND_SUCCESS       0  // Success
@@ -13,6 +22,13 @@
 #define CAN_SEND_QUEUE_ERROR   3  // Queue send error
 #define CAN_SEND_NOT_READY     4  // CAN not ready
 
+// TX scheduling classes. Frames of a lower class are placed into mailboxes first,
+// inside a class the lower CAN ID (higher bus priority) goes first.
+#define CAN_TX_CLASS_STATUS    0  // Status responses, carry error and emergency flags
+#define CAN_TX_CLASS_TELEMETRY 1  // Sensor and power responses
+#define CAN_TX_CLASS_OTHER     2  // Parameter responses and everything else
+#define CAN_TX_CLASS_COUNT     3
+
 // CAN communication monitoring constants
 #define CAN_COMMUNICATION_TIMEOUT_MS    500   // 0.5 second timeout for CAN communication monitoring
 #define CAN_COMMUNICATION_CHECK_PERIOD  50    // Check communication status every 50ms
@@ -25,7 +41,7 @@ typedef struct
   uint32_t tx_hardware_errors;           // CAN hardware TX errors
   uint32_t tx_invalid_param_errors;      // TX invalid parameter errors
   uint32_t tx_not_ready_errors;          // TX not ready errors
-  uint32_t tx_semaphore_timeout_errors;  // TX semaphore timeout errors
+  uint32_t tx_stale_dropped;             // Waiting frames dropped after CAN_TX_STALL_MS without transmission
 
   // Reception errors
   uint32_t rx_queue_full_errors;     // RX queue full errors (from interrupt)
@@ -46,22 +62,48 @@ typedef struct
   uint32_t total_tx_messages;      // Total transmitted messages
   uint32_t total_rx_messages;      // Total received messages
   uint32_t callback_null_pointer;  // Callback called with NULL pointer
+  uint32_t tx_peak_pending;        // Maximum number of frames waiting for a mailbox
+  uint32_t total_fd_tx_messages;   // Transmitted CAN FD frames, included in total_tx_messages
+  uint32_t total_fd_rx_messages;   // Received CAN FD frames, included in total_rx_messages
 } T_can_error_counters;
 
 // CAN message structure for queue transmission/reception
 typedef __packed struct
 {
-  uint32_t can_id;      // CAN ID
-  uint8_t  dlc;         // Data length code (0-8)
-  uint8_t  frame_type;  // CAN_FRAME_TYPE_DATA or CAN_FRAME_TYPE_REMOTE
-  uint8_t  id_mode;     // CAN_ID_MODE_STANDARD or CAN_ID_MODE_EXTENDED
-  uint8_t  reserved;    // Reserved byte for alignment
-  uint8_t  data[8];     // CAN data bytes (up to 8 bytes)
+  uint32_t can_id;                 // CAN ID
+  uint8_t  dlc;                    // Number of data bytes (0-8 for classic CAN, up to 64 for CAN FD)
+  uint8_t  frame_type;             // CAN_FRAME_TYPE_DATA or CAN_FRAME_TYPE_REMOTE
+  uint8_t  id_mode;                // CAN_ID_MODE_STANDARD or CAN_ID_MODE_EXTENDED
+  uint8_t  options;                // CANFD_FRAME_OPTION_FD / CANFD_FRAME_OPTION_BRS, 0 for classic CAN
+  uint8_t  data[CAN_FD_MAX_DATA];  // CAN data bytes
 } T_can_msg;
 
+#define CAN_MSG_IS_FD(msg) (((msg)->options & CANFD_FRAME_OPTION_FD) != 0)
+
 // Callback function type for received CAN messages
 typedef void (*T_can_rx_callback)(const T_can_msg* rx_msg);
 
+// Function called by the CAN TX task after frames were sent, to queue the next frames of a stream
+typedef void (*T_can_tx_service_hook)(void);
+
+// Latency from the RX interrupt to the return of the handler
+typedef struct
+{
+  uint32_t count;                      // Frames passed to handlers of this path
+  uint32_t last_us;                    // Latency of the last frame [us]
+  uint32_t max_us;                     // Maximum latency [us]
+  uint32_t hist[CAN_RX_LATENCY_BINS];  // Latency histogram, upper bin edges in g_can_rx_latency_edges_us
+} T_can_rx_path_stats;
+
+// RX dispatch statistics
+typedef struct
+{
+  T_can_rx_path_stats isr;        // Handlers called in the RX interrupt
+  T_can_rx_path_stats task;       // Handlers called in the CAN RX task
+  uint32_t            unmatched;  // Frames without a registered handler
+  uint32_t            disabled;   // Frames not dispatched because dispatch was disabled
+} T_can_rx_dispatch_stats;
+
 extern const can_instance_t       g_CANFD;
 extern canfd_instance_ctrl_t      g_CANFD_ctrl;
 extern const can_cfg_t            g_CANFD_cfg;
@@ -71,17 +113,30 @@ extern bool                       g_can_ready;
 extern T_can_error_counters       g_can_error_counters;
 extern uint32_t                  g_can_last_rx_time;          // Time of last received CAN message
 extern bool                      g_can_communication_active;  // Flag indicating if CAN communication is active
+extern T_cycle_profile           g_can_tx_latency[CAN_TX_CLASS_COUNT];  // Time from Can_send_extended_data to TX complete
+extern const uint32_t            g_can_rx_latency_edges_us[CAN_RX_LATENCY_BINS];  // Upper edges of RX latency histogram bins [us]
 
 void                  Can_thread_create(void);
 void                  Can_rx_thread_create(void);
 void                  CANFD_callback(can_callback_args_t* p_args);
 uint32_t              Can_send_extended_data(uint32_t can_id, uint8_t* data, uint8_t dlc);
+uint32_t              Can_send_fd_data(uint32_t can_id, const uint8_t* data, uint8_t len);
+uint8_t               Can_fd_frame_length(uint8_t len);
 bool                  Can_is_ready(void);
+uint32_t              Can_get_tx_pending_count(void);
+uint32_t              Can_get_tx_id_count(uint32_t can_id);
+void                  Can_tx_set_service_hook(T_can_tx_service_hook hook);
+void                  Can_tx_request_service(void);
 uint32_t              Can_get_rx_queue_count(void);
 void                  Can_reset_error_counters(void);
 T_can_error_counters* Can_get_error_counters(void);
 void                  Can_set_rx_callback(T_can_rx_callback callback);
 T_can_rx_callback     Can_get_rx_callback(void);
+uint32_t              Can_rx_register_handler(uint32_t can_id, uint32_t mask, T_can_rx_callback task_handler, T_can_rx_callback isr_handler);
+void                  Can_rx_set_dispatch_enabled(bool enabled);
+void                  Can_rx_dispatch_stats_get(T_can_rx_dispatch_stats* p_stats);
+void                  Can_rx_dispatch_stats_reset(void);
+uint32_t              Can_get_afl_rule_count(void);
 void                  Can_check_communication_timeout(void);
 
 #endif  // CAN_TASK_H
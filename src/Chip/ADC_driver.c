@@ -60,6 +60,8 @@ void Adc_scan_end_isr(void);
 
 T_adc_cbl adc;
 
+T_cycle_profile g_adc_isr_profile;
+
 // Static function declarations
 static void            _Adc_init_registers(void);
 static void            _Adc_configure_channels(void);
@@ -67,6 +69,7 @@ static void            _Adc_configure_interrupts(void);
 FORCE_INLINE_ATTR void _Adc_sampling_data_collection(void);
 FORCE_INLINE_ATTR void _Adc_multiplexer_control(void);
 FORCE_INLINE_ATTR void _Adc_apply_ema_filtering(void);
+static uint16_t        _Adc_ema_tier_alpha(uint8_t tier);
 
 // Global PWM frequency and dynamic EMA coefficients
 uint32_t g_adc_pwm_frequency          = 16000;  // Default PWM frequency in Hz
@@ -79,6 +82,65 @@ uint16_t g_ema_alpha_1hz_3ch          = 0;      // Dynamic coefficient for 3-ch
 uint16_t g_ema_alpha_current_fast_2ch = 0;      // Dynamic coefficient for fast current filtering, 2-ch mux
 uint16_t g_ema_alpha_current_slow_2ch = 0;      // Dynamic coefficient for slow current filtering, 2-ch mux
 
+// EMA cutoff tiers referenced by filter bank rows
+#define ADC_EMA_TIER_1HZ_DIRECT          0
+#define ADC_EMA_TIER_10HZ_2CH            1
+#define ADC_EMA_TIER_1HZ_2CH             2
+#define ADC_EMA_TIER_10HZ_3CH            3
+#define ADC_EMA_TIER_CURRENT_FAST_2CH    4
+#define ADC_EMA_TIER_CURRENT_SLOW_2CH    5
+
+// Filter bank rows. Each row is one filter state; adding a channel or a filter tier means adding a row.
+// clang-format off
+static const uint8_t g_adc_dir_filt_tier[ADC_DIR_CH_COUNT] =
+{
+  [ADC_DIR_V24V]     = ADC_EMA_TIER_1HZ_DIRECT,
+  [ADC_DIR_V5V]      = ADC_EMA_TIER_1HZ_DIRECT,
+  [ADC_DIR_V3V3]     = ADC_EMA_TIER_1HZ_DIRECT,
+  [ADC_DIR_THERM_M1] = ADC_EMA_TIER_1HZ_DIRECT,
+  [ADC_DIR_THERM_M2] = ADC_EMA_TIER_1HZ_DIRECT,
+  [ADC_DIR_CPU_TEMP] = ADC_EMA_TIER_1HZ_DIRECT,
+};
+
+static const uint8_t g_adc_phase_filt_tier[ADC_MOTOR_COUNT] =
+{
+  [ADC_MOTOR_1] = ADC_EMA_TIER_10HZ_3CH,
+  [ADC_MOTOR_2] = ADC_EMA_TIER_10HZ_3CH,
+};
+
+// Source sample of each per-motor filter, one sample may feed several filter tiers
+static const uint8_t g_adc_mot_filt_src[ADC_MOT_FILT_COUNT] =
+{
+  [ADC_MOT_FILT_I_U_FAST] = ADC_MOT_I_U,
+  [ADC_MOT_FILT_I_V_FAST] = ADC_MOT_I_V,
+  [ADC_MOT_FILT_I_W_FAST] = ADC_MOT_I_W,
+  [ADC_MOT_FILT_I_U_SLOW] = ADC_MOT_I_U,
+  [ADC_MOT_FILT_I_V_SLOW] = ADC_MOT_I_V,
+  [ADC_MOT_FILT_I_W_SLOW] = ADC_MOT_I_W,
+  [ADC_MOT_FILT_SPEED]    = ADC_MOT_SPEED,
+  [ADC_MOT_FILT_POS]      = ADC_MOT_POS,
+  [ADC_MOT_FILT_IPWR]     = ADC_MOT_IPWR,
+};
+
+static const uint8_t g_adc_mot_filt_tier[ADC_MOT_FILT_COUNT] =
+{
+  [ADC_MOT_FILT_I_U_FAST] = ADC_EMA_TIER_CURRENT_FAST_2CH,
+  [ADC_MOT_FILT_I_V_FAST] = ADC_EMA_TIER_CURRENT_FAST_2CH,
+  [ADC_MOT_FILT_I_W_FAST] = ADC_EMA_TIER_CURRENT_FAST_2CH,
+  [ADC_MOT_FILT_I_U_SLOW] = ADC_EMA_TIER_CURRENT_SLOW_2CH,
+  [ADC_MOT_FILT_I_V_SLOW] = ADC_EMA_TIER_CURRENT_SLOW_2CH,
+  [ADC_MOT_FILT_I_W_SLOW] = ADC_EMA_TIER_CURRENT_SLOW_2CH,
+  [ADC_MOT_FILT_SPEED]    = ADC_EMA_TIER_10HZ_2CH,
+  [ADC_MOT_FILT_POS]      = ADC_EMA_TIER_10HZ_2CH,
+  [ADC_MOT_FILT_IPWR]     = ADC_EMA_TIER_1HZ_2CH,
+};
+// clang-format on
+
+// Per-row alpha coefficients resolved from tiers when the PWM frequency changes
+static uint16_t g_adc_dir_filt_alpha[ADC_DIR_CH_COUNT];
+static uint16_t g_adc_phase_filt_alpha[ADC_MOTOR_COUNT];
+static uint16_t g_adc_mot_filt_alpha[ADC_MOT_FILT_COUNT];
+
 /*-----------------------------------------------------------------------------------------------------
   ADC scan end interrupt service routine
   Called at PWM frequency for synchronized sampling
@@ -89,6 +151,8 @@ uint16_t g_ema_alpha_current_slow_2ch = 0;      // Dynamic coefficient for slow
 -----------------------------------------------------------------------------------------------------*/
 void Adc_scan_end_isr(void)
 {
+  uint32_t start_cycles = CYCLE_PROFILER_NOW();
+
   _Adc_sampling_data_collection();
 
   if (adc.isr_callback)
@@ -96,7 +160,55 @@ void Adc_scan_end_isr(void)
     adc.isr_callback();
   }
 
+  Motion_recorder_isr();  // After the callback so that recorded PWM levels belong to this cycle
+  Fmstr_rec_isr();
+
   R_ICU->IELSR_b[ADC0_SCAN_END_IRQn].IR = 0;  // Clear interrupt flag in ICU
+
+  Cycle_profile_update(&g_adc_isr_profile, start_cycles, CYCLE_PROFILER_NOW());
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Update a group of EMA filters where filter state i is fed from sample i.
+  Plain loop over contiguous arrays so the compiler can vectorize it with Helium (MVE).
+
+  Parameters:
+    p_filt  - filter states in Q16 format
+    p_smpl  - raw samples
+    p_alpha - alpha coefficient of each filter in Q16 format
+    rows    - number of filters in the group
+
+  Return: void
+-----------------------------------------------------------------------------------------------------*/
+FORCE_INLINE_PRAGMA
+FORCE_INLINE_ATTR void _Adc_ema_bank_update(uint32_t *p_filt, const uint16_t *p_smpl, const uint16_t *p_alpha, uint32_t rows)
+{
+  for (uint32_t i = 0; i < rows; i++)
+  {
+    p_filt[i] = EMA_FILTER_UPDATE(p_filt[i], p_smpl[i], p_alpha[i]);
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Update a group of EMA filters where each filter state takes its sample through a source index table.
+  Used when one sample feeds several filter tiers (fast and slow phase current filters).
+
+  Parameters:
+    p_filt  - filter states in Q16 format
+    p_smpl  - raw samples
+    p_src   - index of the source sample of each filter
+    p_alpha - alpha coefficient of each filter in Q16 format
+    rows    - number of filters in the group
+
+  Return: void
+-----------------------------------------------------------------------------------------------------*/
+FORCE_INLINE_PRAGMA
+FORCE_INLINE_ATTR void _Adc_ema_bank_update_mapped(uint32_t *p_filt, const uint16_t *p_smpl, const uint8_t *p_src, const uint16_t *p_alpha, uint32_t rows)
+{
+  for (uint32_t i = 0; i < rows; i++)
+  {
+    p_filt[i] = EMA_FILTER_UPDATE(p_filt[i], p_smpl[p_src[i]], p_alpha[i]);
+  }
 }
 
 /*-----------------------------------------------------------------------------------------------------
@@ -108,6 +220,9 @@ void Adc_scan_end_isr(void)
     * Phase voltages (5.33 kHz): U→V→W cycle, filtered when each phase is sampled
     * Motor sensors (8 kHz): speed/position/power, filtered when specific motor is active
 
+  Filters are organized as a bank of rows per group (see g_adc_mot_filt_src/g_adc_*_filt_tier),
+  a new channel or filter tier is added as a table row.
+
   Parameters: void
   Return: void
 -----------------------------------------------------------------------------------------------------*/
@@ -118,112 +233,36 @@ FORCE_INLINE_ATTR void _Adc_apply_ema_filtering(void)
   {
     // Initialize filtered values with current samples shifted to Q16 format
     // Note: Optimized EMA formula still uses Q16 format for data storage
-    adc.filt_v_u_motor1      = (uint32_t)adc.smpl_v_u_motor1 << EMA_FILTER_SHIFT;
-    adc.filt_v_v_motor1      = (uint32_t)adc.smpl_v_v_motor1 << EMA_FILTER_SHIFT;
-    adc.filt_v_w_motor1      = (uint32_t)adc.smpl_v_w_motor1 << EMA_FILTER_SHIFT;
-    adc.filt_v_u_motor2      = (uint32_t)adc.smpl_v_u_motor2 << EMA_FILTER_SHIFT;
-    adc.filt_v_v_motor2      = (uint32_t)adc.smpl_v_v_motor2 << EMA_FILTER_SHIFT;
-    adc.filt_v_w_motor2      = (uint32_t)adc.smpl_v_w_motor2 << EMA_FILTER_SHIFT;
-    adc.filt_speed_motor1    = (uint32_t)adc.smpl_speed_motor1 << EMA_FILTER_SHIFT;
-    adc.filt_speed_motor2    = (uint32_t)adc.smpl_speed_motor2 << EMA_FILTER_SHIFT;
-    adc.filt_pos_motor1      = (uint32_t)adc.smpl_pos_motor1 << EMA_FILTER_SHIFT;
-    adc.filt_pos_motor2      = (uint32_t)adc.smpl_pos_motor2 << EMA_FILTER_SHIFT;
-    adc.filt_v24v_mon        = (uint32_t)adc.smpl_v24v_mon << EMA_FILTER_SHIFT;
-    adc.filt_v5v_mon         = (uint32_t)adc.smpl_v5v_mon << EMA_FILTER_SHIFT;
-    adc.filt_v3v3_mon        = (uint32_t)adc.smpl_v3v3_mon << EMA_FILTER_SHIFT;
-    adc.filt_thermistor_m1   = (uint32_t)adc.smpl_thermistor_m1 << EMA_FILTER_SHIFT;
-    adc.filt_thermistor_m2   = (uint32_t)adc.smpl_thermistor_m2 << EMA_FILTER_SHIFT;
-    adc.filt_ipwr_motor1     = (uint32_t)adc.smpl_ipwr_motor1 << EMA_FILTER_SHIFT;
-    adc.filt_ipwr_motor2     = (uint32_t)adc.smpl_ipwr_motor2 << EMA_FILTER_SHIFT;
-    adc.filt_cpu_temp        = (uint32_t)adc.smpl_cpu_temp << EMA_FILTER_SHIFT;
-
-    // Initialize dual-EMA filtered current values (fast and slow)
-    adc.filt_i_u_motor1_fast = (uint32_t)adc.smpl_i_u_motor1 << EMA_FILTER_SHIFT;
-    adc.filt_i_v_motor1_fast = (uint32_t)adc.smpl_i_v_motor1 << EMA_FILTER_SHIFT;
-    adc.filt_i_w_motor1_fast = (uint32_t)adc.smpl_i_w_motor1 << EMA_FILTER_SHIFT;
-    adc.filt_i_u_motor2_fast = (uint32_t)adc.smpl_i_u_motor2 << EMA_FILTER_SHIFT;
-    adc.filt_i_v_motor2_fast = (uint32_t)adc.smpl_i_v_motor2 << EMA_FILTER_SHIFT;
-    adc.filt_i_w_motor2_fast = (uint32_t)adc.smpl_i_w_motor2 << EMA_FILTER_SHIFT;
-
-    adc.filt_i_u_motor1_slow = (uint32_t)adc.smpl_i_u_motor1 << EMA_FILTER_SHIFT;
-    adc.filt_i_v_motor1_slow = (uint32_t)adc.smpl_i_v_motor1 << EMA_FILTER_SHIFT;
-    adc.filt_i_w_motor1_slow = (uint32_t)adc.smpl_i_w_motor1 << EMA_FILTER_SHIFT;
-    adc.filt_i_u_motor2_slow = (uint32_t)adc.smpl_i_u_motor2 << EMA_FILTER_SHIFT;
-    adc.filt_i_v_motor2_slow = (uint32_t)adc.smpl_i_v_motor2 << EMA_FILTER_SHIFT;
-    adc.filt_i_w_motor2_slow = (uint32_t)adc.smpl_i_w_motor2 << EMA_FILTER_SHIFT;
-
-    adc.filters_initialized  = true;
-  }
-  else
-  {  // Apply 1 Hz EMA filter to direct channels (sampled every interrupt at PWM frequency)
-    // Using optimized formula to avoid 64-bit arithmetic operations
-    adc.filt_v24v_mon      = EMA_FILTER_UPDATE(adc.filt_v24v_mon, adc.smpl_v24v_mon, g_ema_alpha_1hz_direct);
-    adc.filt_v5v_mon       = EMA_FILTER_UPDATE(adc.filt_v5v_mon, adc.smpl_v5v_mon, g_ema_alpha_1hz_direct);
-    adc.filt_v3v3_mon      = EMA_FILTER_UPDATE(adc.filt_v3v3_mon, adc.smpl_v3v3_mon, g_ema_alpha_1hz_direct);
-    adc.filt_thermistor_m1 = EMA_FILTER_UPDATE(adc.filt_thermistor_m1, adc.smpl_thermistor_m1, g_ema_alpha_1hz_direct);
-    adc.filt_thermistor_m2 = EMA_FILTER_UPDATE(adc.filt_thermistor_m2, adc.smpl_thermistor_m2, g_ema_alpha_1hz_direct);
-    adc.filt_cpu_temp      = EMA_FILTER_UPDATE(adc.filt_cpu_temp, adc.smpl_cpu_temp, g_ema_alpha_1hz_direct);
-
-    // Apply filtering to multiplexed channels only when they are active and updated
-    // Phase voltage filtering: only filter the currently sampled phase for both motors
-    if (adc.active_phase == ADC_PHASE_U)
-    {  // Filter U phase voltage for both motors (PWM_freq/3 effective sampling rate)
-      // Using optimized formula to avoid 64-bit arithmetic operations
-      adc.filt_v_u_motor1 = EMA_FILTER_UPDATE(adc.filt_v_u_motor1, adc.smpl_v_u_motor1, g_ema_alpha_10hz_3ch);
-      adc.filt_v_u_motor2 = EMA_FILTER_UPDATE(adc.filt_v_u_motor2, adc.smpl_v_u_motor2, g_ema_alpha_10hz_3ch);
-    }
-    else if (adc.active_phase == ADC_PHASE_V)
-    {  // Filter V phase voltage for both motors (PWM_freq/3 effective sampling rate)
-      // Using optimized formula to avoid 64-bit arithmetic operations
-      adc.filt_v_v_motor1 = EMA_FILTER_UPDATE(adc.filt_v_v_motor1, adc.smpl_v_v_motor1, g_ema_alpha_10hz_3ch);
-      adc.filt_v_v_motor2 = EMA_FILTER_UPDATE(adc.filt_v_v_motor2, adc.smpl_v_v_motor2, g_ema_alpha_10hz_3ch);
-    }
-    else if (adc.active_phase == ADC_PHASE_W)
-    {  // Filter W phase voltage for both motors (PWM_freq/3 effective sampling rate)
-      // Using optimized formula to avoid 64-bit arithmetic operations
-      adc.filt_v_w_motor1 = EMA_FILTER_UPDATE(adc.filt_v_w_motor1, adc.smpl_v_w_motor1, g_ema_alpha_10hz_3ch);
-      adc.filt_v_w_motor2 = EMA_FILTER_UPDATE(adc.filt_v_w_motor2, adc.smpl_v_w_motor2, g_ema_alpha_10hz_3ch);
+    for (uint32_t i = 0; i < ADC_DIR_CH_COUNT; i++)
+    {
+      adc.filt_dir[i] = (uint32_t)adc.smpl_dir[i] << EMA_FILTER_SHIFT;
     }
-    // Phase voltage filtering complete: all three phases (U, V, W) processed
-
-    // Motor sensor filtering: only filter sensors for the currently active motor
-    if (adc.active_motor == ADC_MOTOR_1)
-    {  // Filter Motor 1 sensors (PWM_freq/2 effective sampling rate)
-      // Using optimized formula to avoid 64-bit arithmetic operations
-      adc.filt_speed_motor1    = EMA_FILTER_UPDATE(adc.filt_speed_motor1, adc.smpl_speed_motor1, g_ema_alpha_10hz_2ch);
-      adc.filt_pos_motor1      = EMA_FILTER_UPDATE(adc.filt_pos_motor1, adc.smpl_pos_motor1, g_ema_alpha_10hz_2ch);
-      adc.filt_ipwr_motor1     = EMA_FILTER_UPDATE(adc.filt_ipwr_motor1, adc.smpl_ipwr_motor1, g_ema_alpha_1hz_2ch);
-
-      // Apply dual-EMA filtering to Motor 1 phase currents (PWM_freq/2 effective sampling rate)
-      // Fast filter for control (~1.5kHz cutoff)
-      adc.filt_i_u_motor1_fast = EMA_FILTER_UPDATE(adc.filt_i_u_motor1_fast, adc.smpl_i_u_motor1, g_ema_alpha_current_fast_2ch);
-      adc.filt_i_v_motor1_fast = EMA_FILTER_UPDATE(adc.filt_i_v_motor1_fast, adc.smpl_i_v_motor1, g_ema_alpha_current_fast_2ch);
-      adc.filt_i_w_motor1_fast = EMA_FILTER_UPDATE(adc.filt_i_w_motor1_fast, adc.smpl_i_w_motor1, g_ema_alpha_current_fast_2ch);
-
-      // Slow filter for monitoring/protection (~300Hz cutoff)
-      adc.filt_i_u_motor1_slow = EMA_FILTER_UPDATE(adc.filt_i_u_motor1_slow, adc.smpl_i_u_motor1, g_ema_alpha_current_slow_2ch);
-      adc.filt_i_v_motor1_slow = EMA_FILTER_UPDATE(adc.filt_i_v_motor1_slow, adc.smpl_i_v_motor1, g_ema_alpha_current_slow_2ch);
-      adc.filt_i_w_motor1_slow = EMA_FILTER_UPDATE(adc.filt_i_w_motor1_slow, adc.smpl_i_w_motor1, g_ema_alpha_current_slow_2ch);
+    for (uint32_t m = 0; m < ADC_MOTOR_COUNT; m++)
+    {
+      for (uint32_t i = 0; i < ADC_MOT_FILT_COUNT; i++)
+      {
+        adc.filt_mot[m][i] = (uint32_t)adc.smpl_mot[m][g_adc_mot_filt_src[i]] << EMA_FILTER_SHIFT;
+      }
     }
-    else  // ADC_MOTOR_2
+    for (uint32_t ph = 0; ph < ADC_PHASE_COUNT; ph++)
     {
-      // Filter Motor 2 sensors (PWM_freq/2 effective sampling rate)
-      // Using optimized formula to avoid 64-bit arithmetic operations
-      adc.filt_speed_motor2    = EMA_FILTER_UPDATE(adc.filt_speed_motor2, adc.smpl_speed_motor2, g_ema_alpha_10hz_2ch);
-      adc.filt_pos_motor2      = EMA_FILTER_UPDATE(adc.filt_pos_motor2, adc.smpl_pos_motor2, g_ema_alpha_10hz_2ch);
-      adc.filt_ipwr_motor2     = EMA_FILTER_UPDATE(adc.filt_ipwr_motor2, adc.smpl_ipwr_motor2, g_ema_alpha_1hz_2ch);
-
-      // Apply dual-EMA filtering to Motor 2 phase currents (PWM_freq/2 effective sampling rate)
-      // Fast filter for control (~1.5kHz cutoff)
-      adc.filt_i_u_motor2_fast = EMA_FILTER_UPDATE(adc.filt_i_u_motor2_fast, adc.smpl_i_u_motor2, g_ema_alpha_current_fast_2ch);
-      adc.filt_i_v_motor2_fast = EMA_FILTER_UPDATE(adc.filt_i_v_motor2_fast, adc.smpl_i_v_motor2, g_ema_alpha_current_fast_2ch);
-      adc.filt_i_w_motor2_fast = EMA_FILTER_UPDATE(adc.filt_i_w_motor2_fast, adc.smpl_i_w_motor2, g_ema_alpha_current_fast_2ch);
-
-      // Slow filter for monitoring/protection (~300Hz cutoff)
-      adc.filt_i_u_motor2_slow = EMA_FILTER_UPDATE(adc.filt_i_u_motor2_slow, adc.smpl_i_u_motor2, g_ema_alpha_current_slow_2ch);
-      adc.filt_i_v_motor2_slow = EMA_FILTER_UPDATE(adc.filt_i_v_motor2_slow, adc.smpl_i_v_motor2, g_ema_alpha_current_slow_2ch);
-      adc.filt_i_w_motor2_slow = EMA_FILTER_UPDATE(adc.filt_i_w_motor2_slow, adc.smpl_i_w_motor2, g_ema_alpha_current_slow_2ch);
+      for (uint32_t m = 0; m < ADC_MOTOR_COUNT; m++)
+      {
+        adc.filt_phase[ph][m] = (uint32_t)adc.smpl_phase[ph][m] << EMA_FILTER_SHIFT;
+      }
     }
+    adc.filters_initialized = true;
+  }
+  else
+  {
+    // Direct channels are sampled every interrupt at PWM frequency
+    _Adc_ema_bank_update(adc.filt_dir, adc.smpl_dir, g_adc_dir_filt_alpha, ADC_DIR_CH_COUNT);
+
+    // Phase voltages: only the currently sampled phase for both motors (PWM_freq/3 effective sampling rate)
+    _Adc_ema_bank_update(adc.filt_phase[adc.active_phase], adc.smpl_phase[adc.active_phase], g_adc_phase_filt_alpha, ADC_MOTOR_COUNT);
+
+    // Motor sensors and dual-EMA phase currents: only the currently active motor (PWM_freq/2 effective sampling rate)
+    _Adc_ema_bank_update_mapped(adc.filt_mot[adc.active_motor], adc.smpl_mot[adc.active_motor], g_adc_mot_filt_src, g_adc_mot_filt_alpha, ADC_MOT_FILT_COUNT);
   }
 }
 /*-----------------------------------------------------------------------------------------------------
@@ -236,53 +275,31 @@ FORCE_INLINE_ATTR void _Adc_apply_ema_filtering(void)
 FORCE_INLINE_PRAGMA
 FORCE_INLINE_ATTR void _Adc_sampling_data_collection(void)
 {
+  uint16_t *p_mot = adc.smpl_mot[adc.active_motor];
+
   // Read direct ADC channels (non-multiplexed)
   adc.smpl_v24v_mon      = R_ADC0->ADDR[4];   // AN004 - System +24V input monitoring
   adc.smpl_v5v_mon       = R_ADC1->ADDR[4];   // AN104 - +5V supply monitoring
   adc.smpl_v3v3_mon      = R_ADC1->ADDR[5];   // AN105 - +3.3V reference/supply monitoring
   adc.smpl_thermistor_m1 = R_ADC0->ADDR[16];  // AN016 - Motor 1 thermistor
   adc.smpl_thermistor_m2 = R_ADC1->ADDR[17];  // AN117 - Motor 2 thermistor
-  // Read multiplexed channels - assign directly to motor-specific variables
-  if (adc.active_motor == ADC_MOTOR_1)
-  {
-    adc.smpl_i_u_motor1   = R_ADC0->ADDR[0];  // AN000 - Current motor 1 U phase
-    adc.smpl_i_v_motor1   = R_ADC0->ADDR[1];  // AN001 - Current motor 1 V phase
-    adc.smpl_i_w_motor1   = R_ADC0->ADDR[2];  // AN002 - Current motor 1 W phase
-    adc.smpl_ipwr_motor1  = R_ADC1->ADDR[0];  // AN100 - Current motor 1 power
-    adc.smpl_speed_motor1 = R_ADC1->ADDR[1];  // AN101 - Current motor 1 speed
-    adc.smpl_pos_motor1   = R_ADC1->ADDR[2];  // AN102 - Current motor 1 position
-  }
-  else                                        // ADC_MOTOR_2
-  {
-    adc.smpl_i_u_motor2   = R_ADC0->ADDR[0];  // AN000 - Current motor 2 U phase
-    adc.smpl_i_v_motor2   = R_ADC0->ADDR[1];  // AN001 - Current motor 2 V phase
-    adc.smpl_i_w_motor2   = R_ADC0->ADDR[2];  // AN002 - Current motor 2 W phase
-    adc.smpl_ipwr_motor2  = R_ADC1->ADDR[0];  // AN100 - Current motor 2 power
-    adc.smpl_speed_motor2 = R_ADC1->ADDR[1];  // AN101 - Current motor 2 speed
-    adc.smpl_pos_motor2   = R_ADC1->ADDR[2];  // AN102 - Current motor 2 position
-  }
+
+  // Read multiplexed channels into the sample row of the currently selected motor
+  p_mot[ADC_MOT_I_U]     = R_ADC0->ADDR[0];   // AN000 - U phase current
+  p_mot[ADC_MOT_I_V]     = R_ADC0->ADDR[1];   // AN001 - V phase current
+  p_mot[ADC_MOT_I_W]     = R_ADC0->ADDR[2];   // AN002 - W phase current
+  p_mot[ADC_MOT_IPWR]    = R_ADC1->ADDR[0];   // AN100 - Power supply current
+  p_mot[ADC_MOT_SPEED]   = R_ADC1->ADDR[1];   // AN101 - Speed sensor
+  p_mot[ADC_MOT_POS]     = R_ADC1->ADDR[2];   // AN102 - Position sensor
 
   // Read CPU internal sensors
-  adc.smpl_cpu_temp  = R_ADC0->ADTSDR;  // CPU temperature
-  adc.smpl_int_ref_v = R_ADC0->ADOCDR;  // Internal reference
+  adc.smpl_cpu_temp      = R_ADC0->ADTSDR;  // CPU temperature
+  adc.smpl_int_ref_v     = R_ADC0->ADOCDR;  // Internal reference
 
-  // Read phase voltages and assign directly to motor-specific variables based on active phase
+  // Read phase voltages of the currently selected phase
   // AN005 and AN006 are always sampled and contain current phase data for both motors
-  switch (adc.active_phase)
-  {
-    case ADC_PHASE_U:
-      adc.smpl_v_u_motor1 = R_ADC0->ADDR[5];  // AN005 contains U phase voltage for Motor 1
-      adc.smpl_v_u_motor2 = R_ADC0->ADDR[6];  // AN006 contains U phase voltage for Motor 2
-      break;
-    case ADC_PHASE_V:
-      adc.smpl_v_v_motor1 = R_ADC0->ADDR[5];  // AN005 contains V phase voltage for Motor 1
-      adc.smpl_v_v_motor2 = R_ADC0->ADDR[6];  // AN006 contains V phase voltage for Motor 2
-      break;
-    case ADC_PHASE_W:
-      adc.smpl_v_w_motor1 = R_ADC0->ADDR[5];  // AN005 contains W phase voltage for Motor 1
-      adc.smpl_v_w_motor2 = R_ADC0->ADDR[6];  // AN006 contains W phase voltage for Motor 2
-      break;
-  }
+  adc.smpl_phase[adc.active_phase][ADC_MOTOR_1] = R_ADC0->ADDR[5];  // AN005 - Motor 1 phase voltage
+  adc.smpl_phase[adc.active_phase][ADC_MOTOR_2] = R_ADC0->ADDR[6];  // AN006 - Motor 2 phase voltage
 
   // Apply EMA filtering to relevant channels
   _Adc_apply_ema_filtering();
@@ -708,48 +725,48 @@ void Adc_driver_cancel_calibration(void)
 void Adc_driver_process_samples(void)
 {  // Process monitoring channels using filtered values and appropriate combined scale factors
   // Convert filtered values from Q16 format back to standard ADC counts
-  adc.v24v_supply           = (float)(adc.filt_v24v_mon >> EMA_FILTER_SHIFT) * adc.monitor_24v_scale;  // AN004 - 24V input monitoring (filtered)
-  adc.v5v_supply            = (float)(adc.filt_v5v_mon >> EMA_FILTER_SHIFT) * adc.monitor_5v_scale;    // AN104 - 5V supply monitoring (filtered)
-  adc.v3v3_supply           = (float)(adc.filt_v3v3_mon >> EMA_FILTER_SHIFT) * adc.monitor_3v3_scale;  // AN105 - +3.3V reference/supply monitoring (filtered)
+  adc.v24v_supply           = (float)(adc.filt_dir[ADC_DIR_V24V] >> EMA_FILTER_SHIFT) * adc.monitor_24v_scale;  // AN004 - 24V input monitoring (filtered)
+  adc.v5v_supply            = (float)(adc.filt_dir[ADC_DIR_V5V] >> EMA_FILTER_SHIFT) * adc.monitor_5v_scale;    // AN104 - 5V supply monitoring (filtered)
+  adc.v3v3_supply           = (float)(adc.filt_dir[ADC_DIR_V3V3] >> EMA_FILTER_SHIFT) * adc.monitor_3v3_scale;  // AN105 - +3.3V reference/supply monitoring (filtered)
   // Process phase current measurements with offset correction using combined scale factors
 
   // Process dual-EMA filtered phase currents for control and monitoring
   // Fast filtered currents (for control applications)
-  adc.i_u_motor1_fast       = ((float)(adc.filt_i_u_motor1_fast >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_u_offs_m1) * adc.phase_current_scale;
-  adc.i_v_motor1_fast       = ((float)(adc.filt_i_v_motor1_fast >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_v_offs_m1) * adc.phase_current_scale;
-  adc.i_w_motor1_fast       = ((float)(adc.filt_i_w_motor1_fast >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_w_offs_m1) * adc.phase_current_scale;
-  adc.i_u_motor2_fast       = ((float)(adc.filt_i_u_motor2_fast >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_u_offs_m2) * adc.phase_current_scale;
-  adc.i_v_motor2_fast       = ((float)(adc.filt_i_v_motor2_fast >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_v_offs_m2) * adc.phase_current_scale;
-  adc.i_w_motor2_fast       = ((float)(adc.filt_i_w_motor2_fast >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_w_offs_m2) * adc.phase_current_scale;
+  adc.i_u_motor1_fast       = ((float)(adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_I_U_FAST] >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_u_offs_m1) * adc.phase_current_scale;
+  adc.i_v_motor1_fast       = ((float)(adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_I_V_FAST] >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_v_offs_m1) * adc.phase_current_scale;
+  adc.i_w_motor1_fast       = ((float)(adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_I_W_FAST] >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_w_offs_m1) * adc.phase_current_scale;
+  adc.i_u_motor2_fast       = ((float)(adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_I_U_FAST] >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_u_offs_m2) * adc.phase_current_scale;
+  adc.i_v_motor2_fast       = ((float)(adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_I_V_FAST] >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_v_offs_m2) * adc.phase_current_scale;
+  adc.i_w_motor2_fast       = ((float)(adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_I_W_FAST] >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_w_offs_m2) * adc.phase_current_scale;
 
   // Slow filtered currents (for monitoring/protection applications)
-  adc.i_u_motor1_slow       = ((float)(adc.filt_i_u_motor1_slow >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_u_offs_m1) * adc.phase_current_scale;
-  adc.i_v_motor1_slow       = ((float)(adc.filt_i_v_motor1_slow >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_v_offs_m1) * adc.phase_current_scale;
-  adc.i_w_motor1_slow       = ((float)(adc.filt_i_w_motor1_slow >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_w_offs_m1) * adc.phase_current_scale;
-  adc.i_u_motor2_slow       = ((float)(adc.filt_i_u_motor2_slow >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_u_offs_m2) * adc.phase_current_scale;
-  adc.i_v_motor2_slow       = ((float)(adc.filt_i_v_motor2_slow >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_v_offs_m2) * adc.phase_current_scale;
-  adc.i_w_motor2_slow       = ((float)(adc.filt_i_w_motor2_slow >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_w_offs_m2) * adc.phase_current_scale;
+  adc.i_u_motor1_slow       = ((float)(adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_I_U_SLOW] >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_u_offs_m1) * adc.phase_current_scale;
+  adc.i_v_motor1_slow       = ((float)(adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_I_V_SLOW] >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_v_offs_m1) * adc.phase_current_scale;
+  adc.i_w_motor1_slow       = ((float)(adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_I_W_SLOW] >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_w_offs_m1) * adc.phase_current_scale;
+  adc.i_u_motor2_slow       = ((float)(adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_I_U_SLOW] >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_u_offs_m2) * adc.phase_current_scale;
+  adc.i_v_motor2_slow       = ((float)(adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_I_V_SLOW] >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_v_offs_m2) * adc.phase_current_scale;
+  adc.i_w_motor2_slow       = ((float)(adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_I_W_SLOW] >> EMA_FILTER_SHIFT) - (float)adc.smpl_i_w_offs_m2) * adc.phase_current_scale;
   // Process phase voltage measurements using filtered values and combined scale factors
   // Convert filtered values from Q16 format back to standard ADC counts
-  adc.v_u_motor1            = (float)(adc.filt_v_u_motor1 >> EMA_FILTER_SHIFT) * adc.phase_voltage_scale;
-  adc.v_v_motor1            = (float)(adc.filt_v_v_motor1 >> EMA_FILTER_SHIFT) * adc.phase_voltage_scale;
-  adc.v_w_motor1            = (float)(adc.filt_v_w_motor1 >> EMA_FILTER_SHIFT) * adc.phase_voltage_scale;
+  adc.v_u_motor1            = (float)(adc.filt_phase[ADC_PHASE_U][ADC_MOTOR_1] >> EMA_FILTER_SHIFT) * adc.phase_voltage_scale;
+  adc.v_v_motor1            = (float)(adc.filt_phase[ADC_PHASE_V][ADC_MOTOR_1] >> EMA_FILTER_SHIFT) * adc.phase_voltage_scale;
+  adc.v_w_motor1            = (float)(adc.filt_phase[ADC_PHASE_W][ADC_MOTOR_1] >> EMA_FILTER_SHIFT) * adc.phase_voltage_scale;
 
-  adc.v_u_motor2            = (float)(adc.filt_v_u_motor2 >> EMA_FILTER_SHIFT) * adc.phase_voltage_scale;
-  adc.v_v_motor2            = (float)(adc.filt_v_v_motor2 >> EMA_FILTER_SHIFT) * adc.phase_voltage_scale;
-  adc.v_w_motor2            = (float)(adc.filt_v_w_motor2 >> EMA_FILTER_SHIFT) * adc.phase_voltage_scale;
+  adc.v_u_motor2            = (float)(adc.filt_phase[ADC_PHASE_U][ADC_MOTOR_2] >> EMA_FILTER_SHIFT) * adc.phase_voltage_scale;
+  adc.v_v_motor2            = (float)(adc.filt_phase[ADC_PHASE_V][ADC_MOTOR_2] >> EMA_FILTER_SHIFT) * adc.phase_voltage_scale;
+  adc.v_w_motor2            = (float)(adc.filt_phase[ADC_PHASE_W][ADC_MOTOR_2] >> EMA_FILTER_SHIFT) * adc.phase_voltage_scale;
   // Process power supply current measurements using filtered values and combined scale factors
   // Convert filtered values from Q16 format and apply offset correction
   // Use signed arithmetic to handle negative currents properly (prevents uint16_t underflow)
-  int32_t filtered_v3v3_ref = (int32_t)(adc.filt_v3v3_mon >> EMA_FILTER_SHIFT);
-  adc.ipwr_motor1           = (float)((int32_t)(adc.filt_ipwr_motor1 >> EMA_FILTER_SHIFT) - filtered_v3v3_ref) * adc.power_current_scale;
-  adc.ipwr_motor2           = (float)((int32_t)(adc.filt_ipwr_motor2 >> EMA_FILTER_SHIFT) - filtered_v3v3_ref) * adc.power_current_scale;
+  int32_t filtered_v3v3_ref = (int32_t)(adc.filt_dir[ADC_DIR_V3V3] >> EMA_FILTER_SHIFT);
+  adc.ipwr_motor1           = (float)((int32_t)(adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_IPWR] >> EMA_FILTER_SHIFT) - filtered_v3v3_ref) * adc.power_current_scale;
+  adc.ipwr_motor2           = (float)((int32_t)(adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_IPWR] >> EMA_FILTER_SHIFT) - filtered_v3v3_ref) * adc.power_current_scale;
   // Process sensor measurements using filtered values
   // Convert filtered values from Q16 format back to standard ADC counts
-  adc.speed_motor1          = (float)(adc.filt_speed_motor1 >> EMA_FILTER_SHIFT) * adc.adc_scale;
-  adc.speed_motor2          = (float)(adc.filt_speed_motor2 >> EMA_FILTER_SHIFT) * adc.adc_scale;
-  adc.pos_motor1            = (float)(adc.filt_pos_motor1 >> EMA_FILTER_SHIFT) * adc.adc_scale;
-  adc.pos_motor2            = (float)(adc.filt_pos_motor2 >> EMA_FILTER_SHIFT) * adc.adc_scale;
+  adc.speed_motor1          = (float)(adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_SPEED] >> EMA_FILTER_SHIFT) * adc.adc_scale;
+  adc.speed_motor2          = (float)(adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_SPEED] >> EMA_FILTER_SHIFT) * adc.adc_scale;
+  adc.pos_motor1            = (float)(adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_POS] >> EMA_FILTER_SHIFT) * adc.adc_scale;
+  adc.pos_motor2            = (float)(adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_POS] >> EMA_FILTER_SHIFT) * adc.adc_scale;
 
 /* 1 count → volts  */
 #define TSN_K_V_PER_CNT    (ADC_REF_VOLTAGE / ADC_RESOLUTION) /* ≈ 0.00081103 V */
@@ -761,14 +778,14 @@ void Adc_driver_process_samples(void)
 /* Combined gain: counts → °C (≈ 0.00081103 / −0.004 = −0.2027575) */
 #define TSN_GAIN_C_PER_CNT (TSN_K_V_PER_CNT / TSN_SLOPE_V_PER_C)
 
-  uint16_t vs_code                = (uint16_t)(adc.filt_cpu_temp >> EMA_FILTER_SHIFT);  // live 12-bit sample
+  uint16_t vs_code                = (uint16_t)(adc.filt_dir[ADC_DIR_CPU_TEMP] >> EMA_FILTER_SHIFT);  // live 12-bit sample
   uint16_t cal125                 = R_TSN_CAL->TSCDR_b.TSCDR;                           // factory code @ 125 °C
   adc.cpu_temp                    = ((float)vs_code - (float)cal125) * TSN_GAIN_C_PER_CNT - 45.0f;  // Установил опытным путем. Формуле из даташита не соответствеут
 
   // Process thermistor temperatures using filtered values for improved stability
   // Convert filtered values from Q16 format back to standard ADC counts
-  uint16_t filtered_thermistor_m1 = (uint16_t)(adc.filt_thermistor_m1 >> EMA_FILTER_SHIFT);
-  uint16_t filtered_thermistor_m2 = (uint16_t)(adc.filt_thermistor_m2 >> EMA_FILTER_SHIFT);
+  uint16_t filtered_thermistor_m1 = (uint16_t)(adc.filt_dir[ADC_DIR_THERM_M1] >> EMA_FILTER_SHIFT);
+  uint16_t filtered_thermistor_m2 = (uint16_t)(adc.filt_dir[ADC_DIR_THERM_M2] >> EMA_FILTER_SHIFT);
   adc.temp_motor1                 = Adc_driver_calculate_thermistor_temperature(filtered_thermistor_m1);
   adc.temp_motor2                 = Adc_driver_calculate_thermistor_temperature(filtered_thermistor_m2);
 }
@@ -959,9 +976,9 @@ uint16_t Adc_driver_get_position_sensor_value(uint8_t motor_id)
   switch (motor_id)
   {
     case 1:      // Motor 1 position sensor
-      return (uint16_t)(adc.filt_pos_motor1 >> EMA_FILTER_SHIFT);
+      return (uint16_t)(adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_POS] >> EMA_FILTER_SHIFT);
     case 2:      // Motor 2 position sensor
-      return (uint16_t)(adc.filt_pos_motor2 >> EMA_FILTER_SHIFT);
+      return (uint16_t)(adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_POS] >> EMA_FILTER_SHIFT);
     default:
       return 0;  // Invalid motor ID or no position sensor
   }
@@ -1022,6 +1039,36 @@ float Adc_driver_get_dc_motor_current(uint8_t motor_id)
   return motor_current;
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Get current alpha coefficient of an EMA cutoff tier
+
+  Parameters:
+    tier - ADC_EMA_TIER_* identifier
+
+  Return:
+    Alpha coefficient in Q16 format, 0 for unknown tier
+-----------------------------------------------------------------------------------------------------*/
+static uint16_t _Adc_ema_tier_alpha(uint8_t tier)
+{
+  switch (tier)
+  {
+    case ADC_EMA_TIER_1HZ_DIRECT:
+      return g_ema_alpha_1hz_direct;
+    case ADC_EMA_TIER_10HZ_2CH:
+      return g_ema_alpha_10hz_2ch;
+    case ADC_EMA_TIER_1HZ_2CH:
+      return g_ema_alpha_1hz_2ch;
+    case ADC_EMA_TIER_10HZ_3CH:
+      return g_ema_alpha_10hz_3ch;
+    case ADC_EMA_TIER_CURRENT_FAST_2CH:
+      return g_ema_alpha_current_fast_2ch;
+    case ADC_EMA_TIER_CURRENT_SLOW_2CH:
+      return g_ema_alpha_current_slow_2ch;
+    default:
+      return 0;
+  }
+}
+
 /*-----------------------------------------------------------------------------------------------------
   Set PWM frequency for dynamic EMA coefficient calculation
   Must be called after PWM frequency is determined to synchronize ADC sampling rates
@@ -1057,6 +1104,25 @@ void Adc_driver_set_pwm_frequency(uint32_t pwm_freq)
   // Calculate dual-EMA coefficients for current filtering (2-channel multiplexed rate)
   g_ema_alpha_current_fast_2ch = (uint16_t)((6283UL * FC_CURRENT_FAST * EMA_FILTER_SCALE) / (1000UL * fs_2ch));
   g_ema_alpha_current_slow_2ch = (uint16_t)((6283UL * FC_CURRENT_SLOW * EMA_FILTER_SCALE) / (1000UL * fs_2ch));
+
+  // Resolve alpha of every filter bank row from its cutoff tier
+  for (uint32_t i = 0; i < ADC_DIR_CH_COUNT; i++)
+  {
+    g_adc_dir_filt_alpha[i] = _Adc_ema_tier_alpha(g_adc_dir_filt_tier[i]);
+  }
+  for (uint32_t i = 0; i < ADC_MOTOR_COUNT; i++)
+  {
+    g_adc_phase_filt_alpha[i] = _Adc_ema_tier_alpha(g_adc_phase_filt_tier[i]);
+  }
+  for (uint32_t i = 0; i < ADC_MOT_FILT_COUNT; i++)
+  {
+    g_adc_mot_filt_alpha[i] = _Adc_ema_tier_alpha(g_adc_mot_filt_tier[i]);
+  }
+
+  // ISR is expected once per PWM period and must fit into a fraction of it
+  uint32_t isr_period          = CYCLE_PROFILER_PERIOD(g_adc_pwm_frequency);
+  Cycle_profile_set_period(&g_adc_isr_profile, isr_period, (isr_period / 100) * ADC_ISR_BUDGET_PERCENT);
+  Fmstr_rec_update_timebase();
 }
 
 /*-----------------------------------------------------------------------------------------------------
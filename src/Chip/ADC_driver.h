@@ -24,10 +24,43 @@
 #define ADC_MOTOR_1                  0
 #define ADC_MOTOR_2                  1
 
+#define ADC_MOTOR_COUNT              2
+
 // Phase selection for voltage measurement
 #define ADC_PHASE_U                  0
 #define ADC_PHASE_V                  1
 #define ADC_PHASE_W                  2
+#define ADC_PHASE_COUNT              3
+
+// Direct (non-multiplexed) channel indexes in smpl_dir[] and filt_dir[]
+#define ADC_DIR_V24V                 0  // AN004 - System +24V input monitoring
+#define ADC_DIR_V5V                  1  // AN104 - +5V supply monitoring
+#define ADC_DIR_V3V3                 2  // AN105 - +3.3V reference/supply monitoring
+#define ADC_DIR_THERM_M1             3  // AN016 - Motor 1 thermistor
+#define ADC_DIR_THERM_M2             4  // AN117 - Motor 2 thermistor
+#define ADC_DIR_CPU_TEMP             5  // CPU temperature sensor
+#define ADC_DIR_CH_COUNT             6
+
+// Per-motor multiplexed channel indexes in smpl_mot[motor][]
+#define ADC_MOT_I_U                  0  // AN000 - U phase current
+#define ADC_MOT_I_V                  1  // AN001 - V phase current
+#define ADC_MOT_I_W                  2  // AN002 - W phase current
+#define ADC_MOT_IPWR                 3  // AN100 - Power supply current
+#define ADC_MOT_SPEED                4  // AN101 - Speed sensor
+#define ADC_MOT_POS                  5  // AN102 - Position sensor
+#define ADC_MOT_CH_COUNT             6
+
+// Per-motor filter indexes in filt_mot[motor][]
+#define ADC_MOT_FILT_I_U_FAST        0  // U phase current, fast filter for control
+#define ADC_MOT_FILT_I_V_FAST        1  // V phase current, fast filter for control
+#define ADC_MOT_FILT_I_W_FAST        2  // W phase current, fast filter for control
+#define ADC_MOT_FILT_I_U_SLOW        3  // U phase current, slow filter for monitoring
+#define ADC_MOT_FILT_I_V_SLOW        4  // V phase current, slow filter for monitoring
+#define ADC_MOT_FILT_I_W_SLOW        5  // W phase current, slow filter for monitoring
+#define ADC_MOT_FILT_SPEED           6  // Speed sensor
+#define ADC_MOT_FILT_POS             7  // Position sensor
+#define ADC_MOT_FILT_IPWR            8  // Power supply current
+#define ADC_MOT_FILT_COUNT           9
 
 // Thermistor NCP21XV103J03RA calculation constants
 #define THERMISTOR_R25               10000.0f  // Resistance at 25°C (Ohm)
@@ -245,76 +278,62 @@ typedef void (*T_adc_isr_callback)(void);
 
 typedef struct
 {
-  // Raw ADC samples - current measurements (multiplexed)
-  uint16_t smpl_i_u_motor1;  // Motor 1 U phase current
-  uint16_t smpl_i_v_motor1;  // Motor 1 V phase current
-  uint16_t smpl_i_w_motor1;  // Motor 1 W phase current
-  uint16_t smpl_i_u_motor2;  // Motor 2 U phase current
-  uint16_t smpl_i_v_motor2;  // Motor 2 V phase current
-  uint16_t smpl_i_w_motor2;  // Motor 2 W phase current
-
-  // Raw ADC samples - voltage measurements (multiplexed)
-  uint16_t smpl_v_u_motor1;  // Motor 1 U phase voltage
-  uint16_t smpl_v_v_motor1;  // Motor 1 V phase voltage
-  uint16_t smpl_v_w_motor1;  // Motor 1 W phase voltage
-  uint16_t smpl_v_u_motor2;  // Motor 2 U phase voltage
-  uint16_t smpl_v_v_motor2;  // Motor 2 V phase voltage
-  uint16_t smpl_v_w_motor2;  // Motor 2 W phase voltage
-
-  // Raw ADC samples - power and sensors (multiplexed)
-  uint16_t smpl_ipwr_motor1;   // Motor 1 power supply current
-  uint16_t smpl_ipwr_motor2;   // Motor 2 power supply current
-  uint16_t smpl_speed_motor1;  // Motor 1 speed sensor
-  uint16_t smpl_speed_motor2;  // Motor 2 speed sensor
-  uint16_t smpl_pos_motor1;    // Motor 1 position sensor
-  uint16_t smpl_pos_motor2;    // Motor 2 position sensor
-  // Raw ADC samples - direct channels
-  uint16_t smpl_v24v_mon;       // AN004 - System +24V input monitoring
-  uint16_t smpl_v5v_mon;        // AN104 - +5V supply monitoring
-  uint16_t smpl_v3v3_mon;       // AN105 - +3.3V reference/supply monitoring
-  uint16_t smpl_thermistor_m1;  // AN016 - Motor 1 power transistors thermistor
-  uint16_t smpl_thermistor_m2;  // AN117 - Motor 2 power transistors thermistor
-
-  // EMA filtered values (32-bit for fixed-point arithmetic)
-  // 10 Hz filtered channels
-  uint32_t filt_v_u_motor1;    // Motor 1 U phase voltage (filtered)
-  uint32_t filt_v_v_motor1;    // Motor 1 V phase voltage (filtered)
-  uint32_t filt_v_w_motor1;    // Motor 1 W phase voltage (filtered)
-  uint32_t filt_v_u_motor2;    // Motor 2 U phase voltage (filtered)
-  uint32_t filt_v_v_motor2;    // Motor 2 V phase voltage (filtered)
-  uint32_t filt_v_w_motor2;    // Motor 2 W phase voltage (filtered)
-  uint32_t filt_speed_motor1;  // Motor 1 speed sensor (filtered)
-  uint32_t filt_speed_motor2;  // Motor 2 speed sensor (filtered)
-  uint32_t filt_pos_motor1;    // Motor 1 position sensor (filtered)
-  uint32_t filt_pos_motor2;    // Motor 2 position sensor (filtered)
-
-  // 1 Hz filtered channels
-  uint32_t filt_v24v_mon;        // AN004 - System +24V input monitoring (filtered)
-  uint32_t filt_v5v_mon;         // AN104 - +5V supply monitoring (filtered)
-  uint32_t filt_v3v3_mon;        // AN105 - +3.3V reference/supply monitoring (filtered)
-  uint32_t filt_thermistor_m1;   // AN016 - Motor 1 thermistor (filtered)
-  uint32_t filt_thermistor_m2;   // AN117 - Motor 2 thermistor (filtered)
-  uint32_t filt_ipwr_motor1;     // Motor 1 power supply current (filtered)
-  uint32_t filt_ipwr_motor2;     // Motor 2 power supply current (filtered)
-  uint32_t filt_cpu_temp;        // CPU temperature (filtered)
-  bool     filters_initialized;  // Flag to indicate if EMA filters have been initialized
-
-  // Motor current filtering for real-time control - dual EMA approach
-  // Fast EMA filters for control (1.5 kHz cutoff frequency)
-  uint32_t filt_i_u_motor1_fast;  // Motor 1 U phase current (fast filtered for control)
-  uint32_t filt_i_v_motor1_fast;  // Motor 1 V phase current (fast filtered for control)
-  uint32_t filt_i_w_motor1_fast;  // Motor 1 W phase current (fast filtered for control)
-  uint32_t filt_i_u_motor2_fast;  // Motor 2 U phase current (fast filtered for control)
-  uint32_t filt_i_v_motor2_fast;  // Motor 2 V phase current (fast filtered for control)
-  uint32_t filt_i_w_motor2_fast;  // Motor 2 W phase current (fast filtered for control)
-
-  // Slow EMA filters for monitoring and protection (300 Hz cutoff frequency)
-  uint32_t filt_i_u_motor1_slow;  // Motor 1 U phase current (slow filtered for monitoring)
-  uint32_t filt_i_v_motor1_slow;  // Motor 1 V phase current (slow filtered for monitoring)
-  uint32_t filt_i_w_motor1_slow;  // Motor 1 W phase current (slow filtered for monitoring)
-  uint32_t filt_i_u_motor2_slow;  // Motor 2 U phase current (slow filtered for monitoring)
-  uint32_t filt_i_v_motor2_slow;  // Motor 2 V phase current (slow filtered for monitoring)
-  uint32_t filt_i_w_motor2_slow;  // Motor 2 W phase current (slow filtered for monitoring)
+  // Raw ADC samples - per-motor multiplexed channels (U9/U11), indexed [motor][ADC_MOT_*]
+  union
+  {
+    uint16_t smpl_mot[ADC_MOTOR_COUNT][ADC_MOT_CH_COUNT];
+    struct
+    {
+      uint16_t smpl_i_u_motor1;    // Motor 1 U phase current
+      uint16_t smpl_i_v_motor1;    // Motor 1 V phase current
+      uint16_t smpl_i_w_motor1;    // Motor 1 W phase current
+      uint16_t smpl_ipwr_motor1;   // Motor 1 power supply current
+      uint16_t smpl_speed_motor1;  // Motor 1 speed sensor
+      uint16_t smpl_pos_motor1;    // Motor 1 position sensor
+      uint16_t smpl_i_u_motor2;    // Motor 2 U phase current
+      uint16_t smpl_i_v_motor2;    // Motor 2 V phase current
+      uint16_t smpl_i_w_motor2;    // Motor 2 W phase current
+      uint16_t smpl_ipwr_motor2;   // Motor 2 power supply current
+      uint16_t smpl_speed_motor2;  // Motor 2 speed sensor
+      uint16_t smpl_pos_motor2;    // Motor 2 position sensor
+    };
+  };
+
+  // Raw ADC samples - phase voltages (U12 mux), indexed [phase][motor]
+  union
+  {
+    uint16_t smpl_phase[ADC_PHASE_COUNT][ADC_MOTOR_COUNT];
+    struct
+    {
+      uint16_t smpl_v_u_motor1;  // Motor 1 U phase voltage
+      uint16_t smpl_v_u_motor2;  // Motor 2 U phase voltage
+      uint16_t smpl_v_v_motor1;  // Motor 1 V phase voltage
+      uint16_t smpl_v_v_motor2;  // Motor 2 V phase voltage
+      uint16_t smpl_v_w_motor1;  // Motor 1 W phase voltage
+      uint16_t smpl_v_w_motor2;  // Motor 2 W phase voltage
+    };
+  };
+
+  // Raw ADC samples - direct channels, indexed [ADC_DIR_*]
+  union
+  {
+    uint16_t smpl_dir[ADC_DIR_CH_COUNT];
+    struct
+    {
+      uint16_t smpl_v24v_mon;       // AN004 - System +24V input monitoring
+      uint16_t smpl_v5v_mon;        // AN104 - +5V supply monitoring
+      uint16_t smpl_v3v3_mon;       // AN105 - +3.3V reference/supply monitoring
+      uint16_t smpl_thermistor_m1;  // AN016 - Motor 1 power transistors thermistor
+      uint16_t smpl_thermistor_m2;  // AN117 - Motor 2 power transistors thermistor
+      uint16_t smpl_cpu_temp;       // CPU temperature sensor sample
+    };
+  };
+
+  // EMA filter bank states in Q16 format, grouped by update rate
+  uint32_t filt_dir[ADC_DIR_CH_COUNT];                     // Direct channels, updated every scan
+  uint32_t filt_mot[ADC_MOTOR_COUNT][ADC_MOT_FILT_COUNT];  // Per-motor filters, updated while the motor is selected
+  uint32_t filt_phase[ADC_PHASE_COUNT][ADC_MOTOR_COUNT];   // Phase voltages, updated while the phase is selected
+  bool     filters_initialized;                            // Flag to indicate if EMA filters have been initialized
 
   // Calibration and offset values
   uint16_t smpl_i_u_offs_m1;  // Motor 1 U-phase current offset
@@ -343,7 +362,6 @@ typedef struct
   uint32_t scan_cycle_counter;  // Counter for multiplexer cycling
 
   // CPU internal sensor samples
-  uint16_t smpl_cpu_temp;   // CPU temperature sensor sample
   uint16_t smpl_int_ref_v;  // Internal reference voltage sample
 
   // Processed ADC values (engineering units)
@@ -419,6 +437,11 @@ typedef struct
 
 extern T_adc_cbl adc;
 
+// ADC scan end ISR execution budget as a percentage of the PWM period
+#define ADC_ISR_BUDGET_PERCENT 50
+
+extern T_cycle_profile g_adc_isr_profile;  // Execution time and period jitter of Adc_scan_end_isr
+
 // Function prototypes
 void     Adc_driver_init(T_adc_isr_callback isr_callback);
 void     Adc_driver_set_pwm_frequency(uint32_t pwm_freq);
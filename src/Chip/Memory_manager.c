@@ -11,6 +11,7 @@ uint8_t *ram_memory_pool;
 uint32_t ram_memory_pool_size;
 
 TX_BYTE_POOL g_app_pool;
+uint32_t     g_app_pool_min_avail;  // Наименьший объем свободной памяти пула после выделения блока
 
 /*-----------------------------------------------------------------------------------------------------
 
@@ -23,6 +24,7 @@ static uint32_t RAM_pool_create(void *first_unused_memory)
 {
   ram_memory_pool      = (uint8_t *)first_unused_memory;
   ram_memory_pool_size = RAM_END - (uint32_t)ram_memory_pool;
+  g_app_pool_min_avail = ram_memory_pool_size;
   return tx_byte_pool_create(&g_app_pool, "app_pool_mem", ram_memory_pool, ram_memory_pool_size);
 }
 
@@ -41,6 +43,19 @@ void App_memory_pools_creation(void *first_unused_memory)
   json_set_alloc_funcs(App_malloc, App_free);  // Назначаем парсеру JSON функции работы с динамической памятью
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Обновить минимальный объем свободной памяти пула (пиковое использование кучи)
+  Значение читается без блокировки, при одновременных выделениях из разных задач возможна погрешность
+-----------------------------------------------------------------------------------------------------*/
+static void _App_pool_track_min_avail(void)
+{
+  uint32_t avail = g_app_pool.tx_byte_pool_available;
+  if (avail < g_app_pool_min_avail)
+  {
+    g_app_pool_min_avail = avail;
+  }
+}
+
 /*-----------------------------------------------------------------------------------------------------
 
 
@@ -53,6 +68,7 @@ void *App_malloc_pending(ULONG size, ULONG wait_option)
 {
   void *ptr;
   if (tx_byte_allocate(&g_app_pool, &ptr, size, wait_option) != TX_SUCCESS) return NULL;
+  _App_pool_track_min_avail();
   memset(ptr, 0, size);
   return ptr;
 }
@@ -95,6 +111,7 @@ void *App_calloc(size_t num, size_t size)
   uint32_t res;
   res = tx_byte_allocate(&g_app_pool, &ptr, num * size, TX_NO_WAIT);
   if (res != TX_SUCCESS) return NULL;
+  _App_pool_track_min_avail();
   return ptr;
 }
 
@@ -150,3 +167,25 @@ void App_get_RAM_pool_statistic(uint32_t *avail_bytes, uint32_t *fragments)
 
   tx_byte_pool_info_get(&g_app_pool, &pool_name, (ULONG *)avail_bytes, (ULONG *)fragments, &first_suspended, &suspended_count, &next_pool);
 }
+
+/*-----------------------------------------------------------------------------------------------------
+  Минимальный объем свободной памяти пула с момента старта или последнего сброса
+
+  \return uint32_t
+-----------------------------------------------------------------------------------------------------*/
+uint32_t App_get_RAM_pool_min_avail(void)
+{
+  return g_app_pool_min_avail;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Сбросить минимальный объем свободной памяти пула к текущему значению.
+  Используется для измерения пикового расхода кучи участком кода.
+
+  \return uint32_t - текущий объем свободной памяти
+-----------------------------------------------------------------------------------------------------*/
+uint32_t App_reset_RAM_pool_min_avail(void)
+{
+  g_app_pool_min_avail = g_app_pool.tx_byte_pool_available;
+  return g_app_pool_min_avail;
+}
@@ -13,5 +13,7 @@ void     App_free(void* block_ptr);
 void     App_memory_pools_creation(void* first_unused_memory);
 void     App_get_RAM_pool_statistic(uint32_t* avail_bytes, uint32_t* fragments);
 uint32_t App_get_pool_size(void);
+uint32_t App_get_RAM_pool_min_avail(void);
+uint32_t App_reset_RAM_pool_min_avail(void);
 
 #endif  // APP_MEM_MAN_H
@@ -6,6 +6,8 @@ static int Fm_usbfs_drv_send_buf(const void *buf, unsigned int len);
 static int Fm_usbfs_drv_wait_ch(unsigned char *b, int timeout);
 static int Fm_usbfs_drv_printf(const char  *fmt_ptr, ...);
 static int Fm_usbfs_drv_deinit(void **pcbl);
+static int Fm_usbfs_drv_get_rx_block(const uint8_t **pdata, uint32_t *plen, int timeout);
+static void Fm_usbfs_drv_release_rx_block(uint32_t cnt);
 
 
 T_freemaster_serial_driver mon_usbfs_vcom0_drv_driver =
@@ -17,6 +19,8 @@ T_freemaster_serial_driver mon_usbfs_vcom0_drv_driver =
   Fm_usbfs_drv_wait_ch,
   Fm_usbfs_drv_printf,
   Fm_usbfs_drv_deinit,
+  Fm_usbfs_drv_get_rx_block,
+  Fm_usbfs_drv_release_rx_block,
   0,
 };
 
@@ -29,6 +33,8 @@ T_freemaster_serial_driver mon_usbfs_vcom1_drv_driver =
   Fm_usbfs_drv_wait_ch,
   Fm_usbfs_drv_printf,
   Fm_usbfs_drv_deinit,
+  Fm_usbfs_drv_get_rx_block,
+  Fm_usbfs_drv_release_rx_block,
   0,
 };
 
@@ -252,93 +258,137 @@ static int Fm_usbfs_drv_send_buf(const void *buf, unsigned int len)
 
 
 /*-----------------------------------------------------------------------------------------------------
-  Чтение одного символа из USB буфера с таймаутом
+  Получить управляющую структуру драйвера текущей задачи
 
-  \param b - указатель на переменную для сохранения прочитанного символа
-  \param timeout - таймаут ожидания в миллисекундах
-
-  \return RES_OK - символ прочитан успешно, RES_ERROR - ошибка или таймаут
+  \return указатель на управляющую структуру или NULL если драйвер не инициализирован
 -----------------------------------------------------------------------------------------------------*/
-static int Fm_usbfs_drv_wait_ch(unsigned char *b, int timeout)
+static T_fm_usb_drv_cbl *Fm_usbfs_drv_get_cbl(void)
 {
-  ULONG        actual_flags = 0;
-  int32_t      n;
-  int32_t      h;
-
-  UX_THREAD   *thread = tx_thread_identify();
+  T_freemaster_serial_driver *mdrv = (T_freemaster_serial_driver *)(tx_thread_identify()->driver);
+  T_fm_usb_drv_cbl           *p;
 
-  T_freemaster_serial_driver *mdrv = (T_freemaster_serial_driver *)(thread->driver);
   if (mdrv == NULL)
   {
-    Wait_ms(timeout);
-    return RES_ERROR;
+    return NULL;
   }
+  p = (T_fm_usb_drv_cbl *)(mdrv->drv_cbl_ptr);
 
-  T_fm_usb_drv_cbl  *p    = (T_fm_usb_drv_cbl *)(mdrv->drv_cbl_ptr);
-  if (p == NULL)
+  // Проверяем, что задача приема создана (это означает, что флаги тоже созданы)
+  if ((p == NULL) || (p->recv_thread.tx_thread_id == 0))
   {
-    Wait_ms(timeout);
-    return RES_ERROR;
+    return NULL;
   }
+  return p;
+}
 
-  // Проверяем, что задача приема создана (это означает, что флаги тоже созданы)
-  if (p->recv_thread.tx_thread_id == 0)
+/*-----------------------------------------------------------------------------------------------------
+  Получить непрочитанные данные хвостового приемного буфера без копирования.
+  Данные остаются в буфере до вызова Fm_usbfs_drv_release_rx_block
+
+  \param pdata   - сюда записывается указатель на первый непрочитанный байт
+  \param plen    - сюда записывается количество непрочитанных байт в пакете (может быть 0 для пустого пакета)
+  \param timeout - таймаут ожидания пакета в миллисекундах
+
+  \return RES_OK - данные есть, RES_ERROR - ошибка или таймаут
+-----------------------------------------------------------------------------------------------------*/
+static int Fm_usbfs_drv_get_rx_block(const uint8_t **pdata, uint32_t *plen, int timeout)
+{
+  ULONG             actual_flags = 0;
+  int32_t           n;
+  int32_t           h;
+  T_fm_usb_drv_cbl *p            = Fm_usbfs_drv_get_cbl();
+
+  if ((p == NULL) || (p->active == 0))
   {
     Wait_ms(timeout);
     return RES_ERROR;
   }
 
-  if (p->active)
+  // Если индексы буферов равны то это значит отсутствие принятых пакетов
+  h = p->head_buf_indx;
+  if (p->tail_buf_indx == h)
   {
-    // Если индексы буферов равны то это значит отсутствие принятых пакетов
+    if (tx_event_flags_get(&(p->event_flags), MB_USBFS_READ_DONE, TX_OR_CLEAR, &actual_flags, ms_to_ticks(timeout)) != TX_SUCCESS)
+    {
+      return RES_ERROR;
+    }
+    // Еще раз проверяем наличие данных поскольку флаг мог остаться от предыдущего чтения, когда данные били приняты без проверки флага и соответственно без его сброса
     h = p->head_buf_indx;
     if (p->tail_buf_indx == h)
     {
-      if (tx_event_flags_get(&(p->event_flags), MB_USBFS_READ_DONE, TX_OR_CLEAR,&actual_flags, ms_to_ticks(timeout)) != TX_SUCCESS)
-      {
-        return RES_ERROR;
-      }
-      // Еще раз проверяем наличие данных поскольку флаг мог остаться от предыдущего чтения, когда данные били приняты без проверки флага и соответственно без его сброса
-      h = p->head_buf_indx;
-      if (p->tail_buf_indx == h)
-      {
-        return RES_ERROR;
-      }
+      return RES_ERROR;
     }
+  }
 
-    n = p->tail_buf_indx;                      // Получаем индекс хвостового буфера
-    *b = p->in_bufs_ring[n].buff[p->tail_buf_rd_pos]; // Читаем байт данных из хвостового буфера
-    p->tail_buf_rd_pos++;                        // Смещаем указатель на следующий байт данных
+  n      = p->tail_buf_indx;
+  *pdata = &p->in_bufs_ring[n].buff[p->tail_buf_rd_pos];
+  *plen  = p->in_bufs_ring[n].len - p->tail_buf_rd_pos;
+  return RES_OK;
+}
 
-    // Если позиция достигла конца данных в текущем буфере, то буфер освобождается для приема
-    if (p->tail_buf_rd_pos >= p->in_bufs_ring[n].len)
-    {
-      p->tail_buf_rd_pos = 0;
-      // Смещаем указатель хвоста очереди приемных буфферов
-      // Появляется место для движения головы очереди приемных буфферов
+/*-----------------------------------------------------------------------------------------------------
+  Отметить байты полученные через Fm_usbfs_drv_get_rx_block как прочитанные.
+  Когда пакет прочитан полностью буфер освобождается для приема
 
-      n++;
-      if (n >= FMUSBDRV_IN_BUF_QUANTITY) n = 0;
-      p->tail_buf_indx = n;
+  \param cnt - количество прочитанных байт
+-----------------------------------------------------------------------------------------------------*/
+static void Fm_usbfs_drv_release_rx_block(uint32_t cnt)
+{
+  int32_t           n;
+  T_fm_usb_drv_cbl *p = Fm_usbfs_drv_get_cbl();
 
-      // Если очередь пакетов была заполнена, то сообщить задаче о продолжении приема
-      if (p->all_buffers_full == 1)
-      {
-        p->all_buffers_full = 0;
-        if (tx_event_flags_set(&(p->event_flags), MB_USBFS_READ_REQUEST, TX_OR) != TX_SUCCESS)
-        {
-          Wait_ms(timeout); // Задержка после ошибки нужна для того чтобы задача не захватила все ресурсы в случает постоянного появления ошибки
-          return RES_ERROR;
-        }
-      }
+  if (p == NULL)
+  {
+    return;
+  }
+
+  n                   = p->tail_buf_indx;
+  p->tail_buf_rd_pos += cnt;
+
+  // Если позиция достигла конца данных в текущем буфере, то буфер освобождается для приема
+  if (p->tail_buf_rd_pos >= p->in_bufs_ring[n].len)
+  {
+    p->tail_buf_rd_pos = 0;
+    // Смещаем указатель хвоста очереди приемных буфферов
+    // Появляется место для движения головы очереди приемных буфферов
+    n++;
+    if (n >= FMUSBDRV_IN_BUF_QUANTITY) n = 0;
+    p->tail_buf_indx = n;
+
+    // Если очередь пакетов была заполнена, то сообщить задаче о продолжении приема
+    if (p->all_buffers_full == 1)
+    {
+      p->all_buffers_full = 0;
+      tx_event_flags_set(&(p->event_flags), MB_USBFS_READ_REQUEST, TX_OR);
     }
-    return RES_OK;
   }
-  else
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Чтение одного символа из USB буфера с таймаутом
+
+  \param b - указатель на переменную для сохранения прочитанного символа
+  \param timeout - таймаут ожидания в миллисекундах
+
+  \return RES_OK - символ прочитан успешно, RES_ERROR - ошибка или таймаут
+-----------------------------------------------------------------------------------------------------*/
+static int Fm_usbfs_drv_wait_ch(unsigned char *b, int timeout)
+{
+  const uint8_t *data;
+  uint32_t       len;
+
+  if (Fm_usbfs_drv_get_rx_block(&data, &len, timeout) != RES_OK)
   {
-    Wait_ms(timeout);
+    return RES_ERROR;
   }
-  return RES_ERROR;
+  if (len == 0)
+  {
+    Fm_usbfs_drv_release_rx_block(0);  // Пустой пакет просто освобождаем
+    return RES_ERROR;
+  }
+  *b = data[0];
+  Fm_usbfs_drv_release_rx_block(1);
+  return RES_OK;
 }
 
 
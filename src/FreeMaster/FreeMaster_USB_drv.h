@@ -17,6 +17,8 @@ typedef struct
     int              (*_wait_char)(unsigned char *b,  int ticks); // ticks - время ожидания выражается в тиках (если 0 то без ожидания)
     int              (*_printf)(const char *, ...);               // Возвращает неопределенный результат
     int              (*_deinit)(void **pcbl);
+    int              (*_get_rx_block)(const uint8_t **pdata, uint32_t *plen, int ticks); // Непрочитанные байты текущего принятого пакета без копирования
+    void             (*_release_rx_block)(uint32_t cnt);                                 // Отметить cnt байт блока как прочитанные
     void              *drv_cbl_ptr;                               // Указатель на управляющую структуру необходимую для работы драйвера
 } T_freemaster_serial_driver;
 
@@ -0,0 +1,204 @@
+#include "App.h"
+
+// Recorder control block. Fields marked (ISR) are modified in the ADC ISR.
+typedef struct
+{
+  volatile uint32_t active;          // FMSTR_Init is done, the ISR may call the recorder
+  volatile uint32_t decimation;
+  uint32_t          decim_cnt;       // (ISR) PWM cycles since the last sample
+  volatile uint32_t trigger_req;     // Fault trigger requested, serviced in the ISR
+  uint32_t          fault_armed;
+  volatile uint32_t fault_triggers;  // (ISR)
+} T_fmrec_cbl;
+
+static T_fmrec_cbl g_fmrec = { .decimation = 1 };
+
+T_cycle_profile g_fmrec_isr_profile;
+
+// Phase currents of both motors recorded by the fault capture
+// clang-format off
+static const volatile uint16_t *const g_fmrec_fault_src[] =
+{
+  &adc.smpl_mot[ADC_MOTOR_1][ADC_MOT_I_U],
+  &adc.smpl_mot[ADC_MOTOR_1][ADC_MOT_I_V],
+  &adc.smpl_mot[ADC_MOTOR_1][ADC_MOT_I_W],
+  &adc.smpl_mot[ADC_MOTOR_2][ADC_MOT_I_U],
+  &adc.smpl_mot[ADC_MOTOR_2][ADC_MOT_I_V],
+  &adc.smpl_mot[ADC_MOTOR_2][ADC_MOT_I_W],
+};
+// clang-format on
+
+#define FMREC_FAULT_VAR_COUNT (sizeof(g_fmrec_fault_src) / sizeof(g_fmrec_fault_src[0]))
+
+/*-----------------------------------------------------------------------------------------------------
+  Enable sampling of the recorder from the ADC ISR. Called by the FreeMASTER thread after FMSTR_Init.
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Fmstr_rec_init(void)
+{
+  g_fmrec.active = 1;
+  Fmstr_rec_update_timebase();
+
+#if FMREC_FAULT_CAPTURE_AT_START
+  if (Fmstr_rec_fault_capture_arm() == RES_OK)
+  {
+    APPLOG("FreeMaster: Fault capture armed, %u samples at %u Hz", (unsigned int)FMREC_FAULT_SAMPLES, (unsigned int)(g_adc_pwm_frequency / g_fmrec.decimation));
+  }
+#endif
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Take a recorder sample. Called from Adc_scan_end_isr once per PWM cycle.
+  The cost is bounded: the recorder rejects configurations exceeding FMSTR_REC_MAX_COPY_RUNS copy runs
+  or FMSTR_REC_MAX_TRG_VARS trigger variables, and a sample follows the copy plan built at configure time.
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Fmstr_rec_isr(void)
+{
+  uint32_t start_cycles;
+
+  if (g_fmrec.active == 0) return;
+
+  // A fault is passed to the recorder without waiting for the next decimated sample
+  if (g_fmrec.trigger_req != 0)
+  {
+    g_fmrec.trigger_req = 0;
+    if (FMSTR_RecorderTrigger(FMREC_INDEX))
+    {
+      g_fmrec.fault_triggers++;
+    }
+  }
+
+  if (++g_fmrec.decim_cnt < g_fmrec.decimation) return;
+  g_fmrec.decim_cnt = 0;
+
+  // Only the samples are profiled, the PWM cycles skipped by the decimation cost a compare
+  start_cycles = CYCLE_PROFILER_NOW();
+  FMSTR_Recorder(FMREC_INDEX);
+
+  Cycle_profile_update(&g_fmrec_isr_profile, start_cycles, CYCLE_PROFILER_NOW());
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Set the number of PWM cycles per recorder sample. The recorder time base is updated so that
+  FreeMASTER shows the correct time axis.
+
+  Parameters:
+    decimation - 1 to sample every PWM cycle, up to FMREC_MAX_DECIMATION
+
+  Return:
+    RES_OK on success, RES_ERROR if the value is out of range
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Fmstr_rec_set_decimation(uint32_t decimation)
+{
+  if ((decimation == 0) || (decimation > FMREC_MAX_DECIMATION)) return RES_ERROR;
+
+  g_fmrec.decimation = decimation;
+  g_fmrec.decim_cnt  = 0;
+  Fmstr_rec_update_timebase();
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Recalculate the recorder time base and the profile period from the PWM frequency and decimation.
+  Called after the PWM frequency is changed.
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Fmstr_rec_update_timebase(void)
+{
+  uint32_t pwm_period = CYCLE_PROFILER_PERIOD(g_adc_pwm_frequency);
+
+  // Entries are decimated, jitter is not tracked
+  Cycle_profile_set_period(&g_fmrec_isr_profile, 0, (pwm_period / 100) * FMREC_ISR_BUDGET_PERCENT);
+  if (g_fmrec.active == 0) return;
+  FMSTR_RecorderSetTimeBase(FMREC_INDEX, (FMSTR_U32)((1000000000ull * g_fmrec.decimation) / g_adc_pwm_frequency));
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Configure the recorder for the fault capture and start it. The recorder samples phase currents of both
+  motors into its circular buffer until Fmstr_rec_fault_trigger() is called, then takes
+  FMREC_FAULT_POST_SAMPLES more samples and stops. The capture stays in the target until FreeMASTER
+  connects and reads it. A configuration loaded later from FreeMASTER replaces the fault capture.
+
+  Parameters:
+    None
+
+  Return:
+    RES_OK on success, RES_ERROR if the recorder is not initialized or rejects the configuration
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Fmstr_rec_fault_capture_arm(void)
+{
+  FMSTR_REC_CFG cfg;
+  FMSTR_REC_VAR var;
+
+  if (g_fmrec.active == 0) return RES_ERROR;
+
+  g_fmrec.fault_armed = 0;
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.totalSmps  = FMREC_FAULT_SAMPLES;
+  cfg.preTrigger = FMREC_FAULT_SAMPLES - FMREC_FAULT_POST_SAMPLES;
+  cfg.timeDiv    = 0;
+  cfg.varCount   = (FMSTR_SIZE8)FMREC_FAULT_VAR_COUNT;
+  if (!FMSTR_RecorderConfigure(FMREC_INDEX, &cfg)) return RES_ERROR;
+
+  for (uint32_t i = 0; i < FMREC_FAULT_VAR_COUNT; i++)
+  {
+    memset(&var, 0, sizeof(var));
+    var.addr        = (FMSTR_ADDR)g_fmrec_fault_src[i];
+    var.size        = sizeof(uint16_t);
+    var.triggerMode = FMSTR_REC_TRG_TYPE_NO_TRIGGER;
+    if (!FMSTR_RecorderAddVariable(FMREC_INDEX, (FMSTR_INDEX)i, &var)) return RES_ERROR;
+  }
+
+  if (!FMSTR_RecorderStart(FMREC_INDEX)) return RES_ERROR;
+  g_fmrec.fault_armed = 1;
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Request the recorder trigger on a fault. Safe to call from any context, the trigger itself is
+  executed in the ADC ISR so that the recorder state is only changed in one place.
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Fmstr_rec_fault_trigger(void)
+{
+  g_fmrec.trigger_req = 1;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Get recorder status for display
+
+  Parameters:
+    p_status - destination
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Fmstr_rec_get_status(T_fmrec_status *p_status)
+{
+  p_status->active         = g_fmrec.active;
+  p_status->decimation     = g_fmrec.decimation;
+  p_status->sample_rate_hz = g_adc_pwm_frequency / g_fmrec.decimation;
+  p_status->fault_armed    = g_fmrec.fault_armed;
+  p_status->fault_triggers = g_fmrec.fault_triggers;
+}
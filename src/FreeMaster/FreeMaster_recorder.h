@@ -0,0 +1,34 @@
+#ifndef FREEMASTER_RECORDER_H
+#define FREEMASTER_RECORDER_H
+
+// FreeMASTER recorder sampled in the ADC scan end ISR once per PWM cycle (or every N-th cycle with decimation)
+
+#define FMREC_INDEX                  0     // Recorder instance sampled from the ADC ISR
+#define FMREC_MAX_DECIMATION         1000
+#define FMREC_ISR_BUDGET_PERCENT     5     // Recorder share of the PWM period, exceeding it is counted as overrun
+
+// Fault capture: phase currents of both motors, the recorder stops FMREC_FAULT_POST_SAMPLES after a fault
+#define FMREC_FAULT_CAPTURE_AT_START 1     // Arm the fault capture when the FreeMASTER thread starts
+#define FMREC_FAULT_SAMPLES          4096
+#define FMREC_FAULT_POST_SAMPLES     1024
+
+typedef struct
+{
+  uint32_t active;          // Recorder is initialized and called from the ISR
+  uint32_t decimation;
+  uint32_t sample_rate_hz;  // PWM frequency divided by decimation
+  uint32_t fault_armed;     // Recorder holds the application fault capture configuration
+  uint32_t fault_triggers;  // Number of fault triggers passed to the recorder
+} T_fmrec_status;
+
+extern T_cycle_profile g_fmrec_isr_profile;  // Time of one recorder sample in the ADC ISR
+
+void     Fmstr_rec_init(void);
+void     Fmstr_rec_isr(void);
+uint32_t Fmstr_rec_set_decimation(uint32_t decimation);
+void     Fmstr_rec_update_timebase(void);
+uint32_t Fmstr_rec_fault_capture_arm(void);
+void     Fmstr_rec_fault_trigger(void);
+void     Fmstr_rec_get_status(T_fmrec_status *p_status);
+
+#endif  // FREEMASTER_RECORDER_H
@@ -175,6 +175,9 @@ static void Thread_FreeMaster(ULONG initial_data)
   // Create FreeMaster pipe
   _Create_freemaster_pipe();
 
+  // Start sampling the recorder in the ADC ISR
+  Fmstr_rec_init();
+
   while (1)
   {
     app_command = FMSTR_GetAppCmd();
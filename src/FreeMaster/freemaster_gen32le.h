@@ -24,6 +24,7 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 /******************************************************************************
  * platform-specific default configuration
@@ -56,12 +57,12 @@ typedef unsigned int FMSTR_BOOL;    /* general boolean type  */
 
 typedef unsigned char FMSTR_U8;       /* smallest memory entity */
 typedef unsigned short FMSTR_U16;     /* 16bit value */
-typedef unsigned long FMSTR_U32;      /* 32bit value */
+typedef uint32_t FMSTR_U32;           /* 32bit value, long has 64 bits on the host */
 typedef unsigned long long FMSTR_U64; /* 64bit value */
 
 typedef signed char FMSTR_S8;       /* signed 8bit value */
 typedef signed short FMSTR_S16;     /* signed 16bit value */
-typedef signed long FMSTR_S32;      /* signed 32bit value */
+typedef int32_t FMSTR_S32;          /* signed 32bit value */
 typedef signed long long FMSTR_S64; /* signed 64bit value */
 
 typedef float FMSTR_FLOAT;   /* float value */
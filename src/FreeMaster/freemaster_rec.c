@@ -48,6 +48,13 @@
 #define FMSTR_REC_STRUCT_ALIGN sizeof(void *)
 #endif
 
+/* Copy run kinds, fixed sizes are used for naturally aligned sources */
+#define FMSTR_REC_RUN_BYTES 0U
+#define FMSTR_REC_RUN_U8    1U
+#define FMSTR_REC_RUN_U16   2U
+#define FMSTR_REC_RUN_U32   3U
+#define FMSTR_REC_RUN_U64   4U
+
 /********************************************************
  *  local types definition
  ********************************************************/
@@ -101,6 +108,14 @@ typedef struct FMSTR_REC_VAR_DATA_S
     FMSTR_BOOL trgLastState;          /* last trigger comparison state for edge detection if used */
 } FMSTR_REC_VAR_DATA;
 
+/* One step of the sample copy plan: variables adjacent in memory and in the sample point are copied together */
+typedef struct
+{
+    FMSTR_ADDR src; /* address of the first variable of the run */
+    FMSTR_SIZE len; /* run length in bytes */
+    FMSTR_U8 kind;  /* FMSTR_REC_RUN_xxx */
+} FMSTR_REC_COPY_RUN;
+
 /* runtime variables  */
 typedef struct
 {
@@ -117,6 +132,10 @@ typedef struct
     FMSTR_SIZE pointVarCount;     /* number of variables recorded (trigger-only vars excluded) */
     FMSTR_REC_FLAGS flags;        /* recorder flags */
     FMSTR_REC_CFG config;         /* original recorder configuration */
+    FMSTR_SIZE copyRunCount;      /* number of used entries in copyRuns */
+    FMSTR_SIZE trgVarCount;       /* number of used entries in trgVarIx */
+    FMSTR_REC_COPY_RUN copyRuns[FMSTR_REC_MAX_COPY_RUNS]; /* sample copy plan built with the configuration */
+    FMSTR_U8 trgVarIx[FMSTR_REC_MAX_TRG_VARS];            /* indexes of variables with trigger compare function */
 } FMSTR_REC;
 
 /* Map of FreeMASTER recorder instance in memory */
@@ -182,6 +201,7 @@ static FMSTR_BOOL _FMSTR_CompareDouble(FMSTR_REC_VAR_DATA *varData);
 #endif
 
 static void _FMSTR_Recorder2(FMSTR_REC *recorder);
+static FMSTR_U8 _FMSTR_BuildCopyPlan(FMSTR_REC *recorder);
 
 /********************************************************
  *  static variables
@@ -1188,6 +1208,12 @@ static FMSTR_U8 _FMSTR_CheckConfiguration(FMSTR_REC *recorder)
             return FMSTR_STC_INVSIZE;
         }
 
+        /* prepare the per-sample work, fails when it would exceed the sampling cost limits */
+        if (_FMSTR_BuildCopyPlan(recorder) != FMSTR_STS_OK)
+        {
+            return FMSTR_STC_INVSIZE;
+        }
+
         /* user wants to use less sample points than maximum available */
         if (recorder->config.totalSmps != 0U)
         {
@@ -1242,6 +1268,81 @@ static FMSTR_U8 _FMSTR_CheckConfiguration(FMSTR_REC *recorder)
     return FMSTR_STS_OK;
 }
 
+/******************************************************************************
+ *
+ * @brief    Build the sample copy plan and the list of trigger variables
+ *
+ * @param    recorder - recorder structure with configured variables
+ *
+ * @return   FMSTR_STS_OK or FMSTR_STC_INVSIZE when the plan does not fit the limits
+ *
+ * Recorded variables that follow each other in memory are merged into one copy run.
+ * Each run gets its copy kind here, so the sampling does not dispatch on the
+ * variable type and size for every sample.
+ *
+ ******************************************************************************/
+
+static FMSTR_U8 _FMSTR_BuildCopyPlan(FMSTR_REC *recorder)
+{
+    FMSTR_REC_VAR_DATA *varData;
+    FMSTR_REC_COPY_RUN *run = NULL;
+    FMSTR_SIZE runCount     = 0U;
+    FMSTR_SIZE trgCount     = 0U;
+    FMSTR_SIZE8 i;
+
+    for (i = 0; i < recorder->config.varCount; i++)
+    {
+        varData = &recorder->varDescr[i];
+
+        if (varData->compareFunc != NULL)
+        {
+            if (trgCount >= (FMSTR_SIZE)FMSTR_REC_MAX_TRG_VARS)
+            {
+                return FMSTR_STC_INVSIZE;
+            }
+            recorder->trgVarIx[trgCount++] = (FMSTR_U8)i;
+        }
+
+        if ((varData->cfg.triggerMode & FMSTR_REC_TRG_F_TRGONLY) != 0U)
+        {
+            continue;
+        }
+
+        /* continue the previous run when the variable directly follows it in memory */
+        if (run != NULL && varData->cfg.addr == (run->src + (run->len / FMSTR_CFG_BUS_WIDTH)))
+        {
+            run->len += varData->cfg.size;
+            continue;
+        }
+
+        if (runCount >= (FMSTR_SIZE)FMSTR_REC_MAX_COPY_RUNS)
+        {
+            return FMSTR_STC_INVSIZE;
+        }
+        run      = &recorder->copyRuns[runCount++];
+        run->src = varData->cfg.addr;
+        run->len = varData->cfg.size;
+    }
+
+    /* select the copy kind of every run */
+    for (i = 0; i < runCount; i++)
+    {
+        FMSTR_SIZE len = recorder->copyRuns[i].len;
+        FMSTR_U8 kind  = FMSTR_REC_RUN_BYTES;
+
+        if ((len == 1U || len == 2U || len == 4U || len == 8U) &&
+            ((FMSTR_SIZE)recorder->copyRuns[i].src & (len - 1U)) == 0U)
+        {
+            kind = (len == 1U) ? FMSTR_REC_RUN_U8 : (len == 2U) ? FMSTR_REC_RUN_U16 : (len == 4U) ? FMSTR_REC_RUN_U32 : FMSTR_REC_RUN_U64;
+        }
+        recorder->copyRuns[i].kind = kind;
+    }
+
+    recorder->copyRunCount = runCount;
+    recorder->trgVarCount  = trgCount;
+    return FMSTR_STS_OK;
+}
+
 /******************************************************************************
  *
  * @brief    Compare macro used in trigger detection
@@ -1393,12 +1494,12 @@ void FMSTR_Recorder(FMSTR_INDEX recIndex)
 static void _FMSTR_Recorder2(FMSTR_REC *recorder)
 {
     FMSTR_REC_VAR_DATA *recVarData;
+    FMSTR_REC_COPY_RUN *run;
     FMSTR_PCOMPAREFUNC compareFunc;
+    FMSTR_ADDR dst;
     FMSTR_U8 triggerMode;
-    FMSTR_SIZE8 sz;
     FMSTR_SIZE i;
     FMSTR_BOOL cmp;
-    FMSTR_U8 triggerResult;
 
     /* skip this call ? */
     if (recorder->timeDivCtr > 0U)
@@ -1411,56 +1512,71 @@ static void _FMSTR_Recorder2(FMSTR_REC *recorder)
     /* re-initialize divider */
     recorder->timeDivCtr = recorder->config.timeDiv;
 
-    /* take snapshot of variable values */
-    for (i = 0U; i < recorder->config.varCount; i++)
+    /* test trigger conditions if still running, only variables with compare function are visited */
+    for (i = 0U; i < recorder->trgVarCount && recorder->flags.flg.isStopping == 0U; i++)
     {
-        recVarData  = &recorder->varDescr[i];
+        recVarData  = &recorder->varDescr[recorder->trgVarIx[i]];
         triggerMode = recVarData->cfg.triggerMode;
 
-        /* test trigger condition if still running */
-        if (recVarData->compareFunc != NULL && recorder->flags.flg.isStopping == 0U)
-        {
-            /* compare trigger threshold */
-            compareFunc = recVarData->compareFunc;
-            cmp         = compareFunc(recVarData);
+        /* compare trigger threshold */
+        compareFunc = recVarData->compareFunc;
+        cmp         = compareFunc(recVarData);
 
-            /* No trigger checking in virgin cycle */
-            if (recorder->flags.flg.isVirginCycle == 0U)
+        /* No trigger checking in virgin cycle */
+        if (recorder->flags.flg.isVirginCycle == 0U)
+        {
+            /* Check the Above trigger */
+            if (cmp != FMSTR_FALSE && (triggerMode & FMSTR_REC_TRG_F_ABOVE) != 0U)
             {
-                /* Check the Above trigger */
-                if (cmp != FMSTR_FALSE && (triggerMode & FMSTR_REC_TRG_F_ABOVE) != 0U)
+                /* Solve as Edge or Level trigger */
+                if ((triggerMode & FMSTR_REC_TRG_F_LEVEL) != 0U || (recVarData->trgLastState == FMSTR_FALSE))
                 {
-                    /* Solve as Edge or Level trigger */
-                    if ((triggerMode & FMSTR_REC_TRG_F_LEVEL) != 0U || (recVarData->trgLastState == FMSTR_FALSE))
-                    {
-                        triggerResult = _FMSTR_TriggerRec(recorder);
-                    }
+                    (void)_FMSTR_TriggerRec(recorder);
                 }
+            }
 
-                /* Check the Below trigger */
-                if (cmp == FMSTR_FALSE && (triggerMode & FMSTR_REC_TRG_F_BELOW) != 0U)
+            /* Check the Below trigger */
+            if (cmp == FMSTR_FALSE && (triggerMode & FMSTR_REC_TRG_F_BELOW) != 0U)
+            {
+                /* Solve as Edge or Level trigger */
+                if ((triggerMode & FMSTR_REC_TRG_F_LEVEL) != 0U || recVarData->trgLastState != FMSTR_FALSE)
                 {
-                    /* Solve as Edge or Level trigger */
-                    if ((triggerMode & FMSTR_REC_TRG_F_LEVEL) != 0U || recVarData->trgLastState != FMSTR_FALSE)
-                    {
-                        triggerResult = _FMSTR_TriggerRec(recorder);
-                    }
+                    (void)_FMSTR_TriggerRec(recorder);
                 }
             }
-
-            /* Store the last comparision */
-            recVarData->trgLastState = cmp;
         }
 
-        /* Store the recorder variable to buffer */
-        if ((triggerMode & FMSTR_REC_TRG_F_TRGONLY) == 0U)
+        /* Store the last comparision */
+        recVarData->trgLastState = cmp;
+    }
+
+    /* take snapshot of variable values following the copy plan,
+       fixed size copies of aligned runs compile to plain loads and stores */
+    dst = recorder->writePtr;
+    for (i = 0U; i < recorder->copyRunCount; i++)
+    {
+        run = &recorder->copyRuns[i];
+        switch (run->kind)
         {
-            sz = recVarData->cfg.size;
-            FMSTR_MemCpyFrom(recorder->writePtr, recVarData->cfg.addr, sz);
-            sz /= FMSTR_CFG_BUS_WIDTH;
-            recorder->writePtr += sz;
+            case FMSTR_REC_RUN_U8:
+                *dst = *run->src;
+                break;
+            case FMSTR_REC_RUN_U16:
+                memcpy(dst, run->src, 2U);
+                break;
+            case FMSTR_REC_RUN_U32:
+                memcpy(dst, run->src, 4U);
+                break;
+            case FMSTR_REC_RUN_U64:
+                memcpy(dst, run->src, 8U);
+                break;
+            default:
+                FMSTR_MemCpyFrom(dst, run->src, run->len);
+                break;
         }
+        dst += run->len / FMSTR_CFG_BUS_WIDTH;
     }
+    recorder->writePtr = dst;
 
     /* We now have at least some data*/
     recorder->flags.flg.hasData = 1U;
@@ -1487,7 +1603,6 @@ static void _FMSTR_Recorder2(FMSTR_REC *recorder)
         recorder->stopRecCountDown--;
     }
 
-    FMSTR_UNUSED(triggerResult);
 }
 
 
@@ -42,6 +42,15 @@
 #define FMSTR_REC_TRG_F_LEVEL           0x40U    /* Recorder trigger configuration - trigger is level active, otherwise edge */
 #define FMSTR_REC_TRG_F_VARTHR          0x80U    /* Recorder trigger configuration - trigger has fixed threshold value */
 
+/* Sampling cost limits. A configuration with more copy runs or trigger variables is rejected,
+   so the time spent in FMSTR_Recorder is bounded. */
+#ifndef FMSTR_REC_MAX_COPY_RUNS
+#define FMSTR_REC_MAX_COPY_RUNS 32
+#endif
+#ifndef FMSTR_REC_MAX_TRG_VARS
+#define FMSTR_REC_MAX_TRG_VARS 8
+#endif
+
 #ifdef __cplusplus
   extern "C" {
 #endif
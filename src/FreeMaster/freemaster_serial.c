@@ -41,6 +41,8 @@ static void    FMSTR_Process_OS_IO(void);
 
 static int32_t FMSTR_Tx(uint8_t *pTxChar);
 static int32_t FMSTR_Rx(uint8_t rx_char);
+static uint32_t FMSTR_RxBlock(const uint8_t *pData, uint32_t nLen, int32_t *pDone);
+static uint8_t  FMSTR_Crc8Block(uint8_t nCrc, const uint8_t *pData, uint32_t nLen);
 
 static FMSTR_BOOL _FMSTR_SerialInit(void);
 static void       _FMSTR_SerialPoll(void);
@@ -54,8 +56,12 @@ const FMSTR_TRANSPORT_INTF FMSTR_SERIAL =
     FMSTR_C99_INIT(SendResponse) _FMSTR_SerialSendResponse,
 };
 
-#define FREEM_TX_BUFF_SZ 64
+/* Whole encoded response: leading SOB and every byte of the message doubled in the worst case */
+#define FREEM_TX_BUFF_SZ (1 + 2 * sizeof(fmstr_pCommBuffer))
 static uint8_t out_buff[FREEM_TX_BUFF_SZ];
+
+/* CRC8 lookup table, filled from FMSTR_Crc8AddByte at init */
+static uint8_t fmstr_crc8_tab[256];
 /*******************************************************************************
 *
 * @brief    Handle OS IO serial communication (both TX and RX)
@@ -72,17 +78,20 @@ static uint8_t out_buff[FREEM_TX_BUFF_SZ];
 
 static void FMSTR_Process_OS_IO(void)
 {
-
-  int status;
   if (!_fmstr_wFlags.flg.bTxActive)
   {
-    uint8_t rx_char;
+    const uint8_t *data;
+    uint32_t       len;
+    uint32_t       used;
+    int32_t        done;
     do
     {
-      status = frm_serial_drv->_wait_char(&rx_char, 2);
-      if (status == RES_OK)
+      // Разбираем принятый USB пакет прямо в буфере драйвера, пока не будет принят целый кадр
+      if (frm_serial_drv->_get_rx_block(&data, &len, 2) == RES_OK)
       {
-       if (FMSTR_Rx(rx_char))
+        used = FMSTR_RxBlock(data, len, &done);
+        frm_serial_drv->_release_rx_block(used);
+        if (done)
           break;
       }
     } while (1);
@@ -91,34 +100,100 @@ static void FMSTR_Process_OS_IO(void)
 
   if (_fmstr_wFlags.flg.bTxActive)
   {
-    uint8_t tx_char;
+    uint8_t  tx_char;
     uint32_t cnt = 0;
-    // Набираем в промежуточный буфер данные посылаемые движком FreeMaster
-    while (1)
+    // Кодируем весь ответ в промежуточный буфер и отправляем его одной операцией записи
+    while (FMSTR_Tx((uint8_t *)&tx_char) == FMSTR_FALSE)
+    {
+      out_buff[cnt++] = tx_char;
+    }
+    if (cnt > 0)
     {
-      // Извлекаем очередной байт из буффера данных предназначенных для отправки
-      if (FMSTR_Tx((uint8_t *)&tx_char) == FMSTR_TRUE)
+      frm_serial_drv->_send_buf(out_buff, cnt);
+    }
+  }
+}
+
+/**************************************************************************/ /*!
+*
+* @brief    Add a block of bytes to the CRC8 checksum
+*
+* @param    nCrc  - current checksum
+* @param    pData - data
+* @param    nLen  - number of bytes
+*
+* @return   Updated checksum, same as FMSTR_Crc8AddByte called for every byte
+*
+******************************************************************************/
+
+static uint8_t FMSTR_Crc8Block(uint8_t nCrc, const uint8_t *pData, uint32_t nLen)
+{
+  while (nLen--)
+  {
+    nCrc = fmstr_crc8_tab[nCrc ^ *pData++];
+  }
+  return nCrc;
+}
+
+/**************************************************************************/ /*!
+*
+* @brief    Handle a block of received characters
+*
+* @param    pData - received data
+* @param    nLen  - number of bytes
+* @param    pDone - set to FMSTR_TRUE when a message was completed and processed
+*
+* @return   Number of bytes consumed. Processing stops after a complete message,
+*           the rest of the block is left for the next call.
+*
+* Message payload bytes are copied to the communication buffer in runs up to the
+* next SOB character. Start of message, length, replicated SOB and the checksum
+* go through the per-character FMSTR_Rx.
+*
+******************************************************************************/
+
+static uint32_t FMSTR_RxBlock(const uint8_t *pData, uint32_t nLen, int32_t *pDone)
+{
+  uint32_t i = 0;
+  uint32_t n;
+  uint32_t k;
+
+  *pDone = FMSTR_FALSE;
+  while (i < nLen)
+  {
+    if (fmstr_nRxTodo > 1U && fmstr_pRxBuff != NULL && !_fmstr_wFlags.flg.bRxLastCharSOB && !_fmstr_wFlags.flg.bRxMsgLengthNext)
+    {
+      /* payload bytes left in the message (without checksum), in the block and in the buffer */
+      n = fmstr_nRxTodo - 1U;
+      if (n > nLen - i)
       {
-        // Здесь если больше нет данных для оправки в буфере движка FreeMaster
-        if (cnt > 0)
-        {
-          // Отсылаем накопленные данные из промежуточного буфера
-          frm_serial_drv->_send_buf(out_buff, cnt);
-        }
-        break;
+        n = nLen - i;
       }
-
-      // Накапливаем данные в промежуточный буффер, чтобы не заставлять драйвер отправлять данные по одному байту
-      out_buff[cnt] = tx_char;
-      cnt++;
-      if (cnt >= FREEM_TX_BUFF_SZ)
+      if (n > (uint32_t)((fmstr_pCommBuffer + FMSTR_COMM_BUFFER_SIZE) - fmstr_pRxBuff))
+      {
+        n = (uint32_t)((fmstr_pCommBuffer + FMSTR_COMM_BUFFER_SIZE) - fmstr_pRxBuff);
+      }
+      for (k = 0; k < n && pData[i + k] != FMSTR_SOB; k++)
       {
-        // Отправляем то, что накопили в промежуточный буффер
-        frm_serial_drv->_send_buf(out_buff, cnt);
-        cnt = 0;
       }
+      if (k > 0U)
+      {
+        memcpy(fmstr_pRxBuff, &pData[i], k);
+        fmstr_nRxCrc8  = FMSTR_Crc8Block(fmstr_nRxCrc8, &pData[i], k);
+        fmstr_pRxBuff += k;
+        fmstr_nRxTodo  = (uint8_t)(fmstr_nRxTodo - k);
+        i             += k;
+        continue;
+      }
+    }
+
+    if (FMSTR_Rx(pData[i++]))
+    {
+      *pDone = FMSTR_TRUE;
+      break;
     }
   }
+  return i;
 }
 
 /**************************************************************************/ /*!
@@ -164,9 +239,6 @@ static void _FMSTR_SendError(uint8_t nErrCode)
 
 static void  _FMSTR_SerialSendResponse(FMSTR_BPTR pResponse, FMSTR_SIZE nLength, FMSTR_U8 statusCode, void *identification)
 {
-  uint8_t i;
-  uint8_t c;
-
   if (nLength > 254 || pResponse != &fmstr_pCommBuffer[2])
   {
     /* The Serial driver doesn't support bigger responses than 254 bytes, change the response to status error */
@@ -195,16 +267,10 @@ static void  _FMSTR_SerialSendResponse(FMSTR_BPTR pResponse, FMSTR_SIZE nLength,
   FMSTR_Crc8Init(&fmstr_nRxCrc8);
 
   /* status byte and data are already there, compute checksum only     */
-  pResponse = fmstr_pTxBuff;
-  for (i = 0U; i < (fmstr_nTxTodo - 1); i++)
-  {
-    pResponse = FMSTR_ValueFromBuffer8(&c, pResponse);
-    /* add character to checksum */
-    FMSTR_Crc8AddByte(&fmstr_nRxCrc8, c);
-  }
+  fmstr_nRxCrc8 = FMSTR_Crc8Block(fmstr_nRxCrc8, fmstr_pTxBuff, (uint32_t)(fmstr_nTxTodo - 1));
 
   /* store checksum after the message */
-  pResponse = FMSTR_ValueToBuffer8(pResponse, fmstr_nRxCrc8);
+  (void)FMSTR_ValueToBuffer8(fmstr_pTxBuff + (fmstr_nTxTodo - 1), fmstr_nRxCrc8);
 
   /* now transmitting the response */
   _fmstr_wFlags.flg.bTxActive = 1U;
@@ -397,6 +463,15 @@ static int32_t FMSTR_Rx(uint8_t rxChar)
 ******************************************************************************/
 static FMSTR_BOOL _FMSTR_SerialInit(void)
 {
+  uint32_t i;
+
+  /* CRC8 of a single byte starting from zero gives the table entry */
+  for (i = 0; i < 256U; i++)
+  {
+    fmstr_crc8_tab[i] = 0U;
+    FMSTR_Crc8AddByte(&fmstr_crc8_tab[i], (FMSTR_U8)i);
+  }
+
   /* initialize all state variables */
   _fmstr_wFlags.all = 0U;
   fmstr_nTxTodo = 0U;
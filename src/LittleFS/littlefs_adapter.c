@@ -9,6 +9,7 @@
 
 #include "App.h"
 #include "littlefs_adapter.h"
+#include "littlefs_erase.h"
 
 // Global LittleFS context
 T_littlefs_context g_littlefs_context;
@@ -16,9 +17,57 @@ T_littlefs_context g_littlefs_context;
 // Global flag to track XIP mode status
 static bool g_xip_mode_active = false;
 
+#if LITTLEFS_PROG_SPI
+// Protocol used for reads, restored after program and erase done in 1S-1S-1S
+static T_mc80_ospi_protocol g_read_protocol;
+#endif
+
 // External references to OSPI driver
 extern const T_mc80_ospi_instance g_mc80_ospi;
 
+#if LITTLEFS_DEBUG_LOG
+  #define LFS_LOG(...) RTT_printf(0, __VA_ARGS__)
+#else
+  #define LFS_LOG(...)
+#endif
+
+static int _Ospi_dev_read(void *ctx, uint32_t addr, void *buf, uint32_t size);
+static int _Ospi_dev_prog(void *ctx, uint32_t addr, const void *buf, uint32_t size);
+static int _Ospi_dev_erase(void *ctx, uint32_t addr, uint32_t size);
+
+// OSPI flash as the lower level of the block device cache, ctx is set in Littlefs_initialize
+static T_lfs_bd_dev g_ospi_bd_dev = {
+  _Ospi_dev_read,
+  _Ospi_dev_prog,
+  _Ospi_dev_erase,
+  NULL
+};
+
+#if LITTLEFS_ASYNC_ERASE
+static int      _Ospi_erase_start(void *ctx, uint32_t addr, uint32_t size);
+static int      _Ospi_erase_busy(void *ctx);
+static int      _Ospi_erase_suspend(void *ctx);
+static int      _Ospi_erase_resume(void *ctx);
+static void     _Ospi_erase_wait(void *ctx);
+static uint32_t _Ospi_erase_clock(void *ctx);
+static void     _Ospi_erase_done(void *ctx, uint32_t addr, uint32_t size, int err);
+
+static T_lfs_erase g_ospi_erase;
+
+// Background erase of the OSPI flash, ctx is set in Littlefs_initialize
+static T_lfs_erase_dev g_ospi_erase_dev = {
+  _Ospi_erase_start,
+  _Ospi_erase_busy,
+  _Ospi_erase_suspend,
+  _Ospi_erase_resume,
+  _Ospi_erase_wait,
+  _Ospi_erase_clock,
+  _Ospi_erase_done,
+  FRQ_CPUCLK_MHZ,
+  NULL
+};
+#endif
+
 /*-----------------------------------------------------------------------------------------------------
   Description: Enter XIP mode for direct memory access
 
@@ -37,7 +86,7 @@ static int _enter_xip_mode(void)
   if (FSP_SUCCESS == err)
   {
     g_xip_mode_active = true;
-    RTT_printf(0, "XIP mode entered successfully\n");
+    LFS_LOG("XIP mode entered successfully\n");
     return 0;
   }
   else
@@ -65,7 +114,7 @@ static int _exit_xip_mode(void)
   if (FSP_SUCCESS == err)
   {
     g_xip_mode_active = false;
-    RTT_printf(0, "XIP mode exited for write operation\n");
+    LFS_LOG("XIP mode exited for write operation\n");
     return 0;
   }
   else
@@ -76,43 +125,323 @@ static int _exit_xip_mode(void)
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Description: Wait for flash operation to complete
+  Description: Bring the flash into the state for memory-mapped reads.
+               Nothing is done while the state is unchanged since the previous read.
 
-  Parameters: p_spi_flash - SPI flash instance
-              timeout_ms - timeout in milliseconds
+  Parameters: p_ctrl - OSPI instance control
 
   Return: 0 on success, error code on failure
 -----------------------------------------------------------------------------------------------------*/
-static int _wait_flash_ready(T_mc80_ospi_instance_ctrl *p_ctrl, uint32_t timeout_ms)
+static int _Ospi_prepare_read(T_mc80_ospi_instance_ctrl *p_ctrl)
 {
-  T_mc80_ospi_status status;
-  fsp_err_t err;
-  uint32_t wait_count = 0;
-  const uint32_t max_wait_count = timeout_ms; // 1ms per iteration
-
-  do
+#if LITTLEFS_PROG_SPI
+  if (p_ctrl->spi_protocol != g_read_protocol)
   {
-    err = Mc80_ospi_status_get(p_ctrl, &status);
+    if (_exit_xip_mode() != 0)
+    {
+      return -1;
+    }
+    fsp_err_t err = Mc80_ospi_spi_protocol_switch_safe(p_ctrl, g_read_protocol);
     if (err != FSP_SUCCESS)
     {
-      RTT_err_printf(0, "Failed to get flash status during wait: %u\n", (unsigned int)err);
+      RTT_err_printf(0, "Failed to restore read protocol: %u\n", (unsigned int)err);
       return -1;
     }
+    LFS_LOG("LFS read protocol 0x%03X restored\n", (unsigned int)g_read_protocol);
+  }
+#else
+  (void)p_ctrl;
+#endif
+
+#if LITTLEFS_READ_XIP
+  // Entering XIP also clears the prefetch buffer after a program or erase
+  if (_enter_xip_mode() != 0)
+  {
+    return -1;
+  }
+#endif
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Bring the flash into the state for program and erase.
+               The driver waits for the end of each operation, so the device is never busy here.
+
+  Parameters: p_ctrl - OSPI instance control
 
-    if (!status.write_in_progress)
+  Return: 0 on success, error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Ospi_prepare_write(T_mc80_ospi_instance_ctrl *p_ctrl)
+{
+  if (_exit_xip_mode() != 0)
+  {
+    return -1;
+  }
+
+#if LITTLEFS_PROG_SPI
+  if (p_ctrl->spi_protocol != MC80_OSPI_PROTOCOL_1S_1S_1S)
+  {
+    fsp_err_t err = Mc80_ospi_spi_protocol_switch_safe(p_ctrl, MC80_OSPI_PROTOCOL_1S_1S_1S);
+    if (err != FSP_SUCCESS)
     {
-      return 0; // Flash is ready
+      RTT_err_printf(0, "Failed to switch to SPI protocol for write: %u\n", (unsigned int)err);
+      return -1;
     }
+    LFS_LOG("LFS switched to 1S-1S-1S for write\n");
+  }
+#else
+  (void)p_ctrl;
+#endif
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Read from the OSPI flash through the memory-mapped window
+
+  Parameters: ctx  - OSPI instance control
+              addr - flash address
+              buf  - destination
+              size - number of bytes
+
+  Return: 0 on success, error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Ospi_dev_read(void *ctx, uint32_t addr, void *buf, uint32_t size)
+{
+  if (Littlefs_flash_read_begin(addr, size) != 0)
+  {
+    return -1;
+  }
+  if (_Ospi_prepare_read((T_mc80_ospi_instance_ctrl *)ctx) != 0)
+  {
+    RTT_err_printf(0, "Failed to prepare flash for read operation\n");
+    Littlefs_flash_read_end();
+    return -1;
+  }
+  memcpy(buf, (uint8_t *)(MC80_OSPI_DEVICE_0_START_ADDRESS + addr), size);
+  return Littlefs_flash_read_end();
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Program the OSPI flash
+
+  Parameters: ctx  - OSPI instance control
+              addr - flash address
+              buf  - source data
+              size - number of bytes
+
+  Return: 0 on success, error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Ospi_dev_prog(void *ctx, uint32_t addr, const void *buf, uint32_t size)
+{
+  T_mc80_ospi_instance_ctrl *p_ctrl = (T_mc80_ospi_instance_ctrl *)ctx;
+  fsp_err_t                  err;
+
+#if LITTLEFS_ASYNC_ERASE
+  // The flash does not program while an erase runs
+  if (Lfs_erase_sync(&g_ospi_erase) != 0)
+  {
+    return -1;
+  }
+#endif
+  if (_Ospi_prepare_write(p_ctrl) != 0)
+  {
+    RTT_err_printf(0, "Failed to prepare flash for write operation\n");
+    return -1;
+  }
+
+  err = Mc80_ospi_memory_mapped_write(p_ctrl, (uint8_t const *)buf, (uint8_t *)(MC80_OSPI_DEVICE_0_START_ADDRESS + addr), size);
+  if (err != FSP_SUCCESS)
+  {
+    RTT_err_printf(0, "OSPI write fail addr=0x%08X size=%u err=%u (0x%X)\n",
+                  (unsigned int)addr, (unsigned int)size, (unsigned int)err, (unsigned int)err);
+    return -1;
+  }
+  LFS_LOG("OSPI write addr=0x%08X size=%u\n", (unsigned int)addr, (unsigned int)size);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Erase the OSPI flash. With LITTLEFS_ASYNC_ERASE the erase is queued and the function
+               returns before the erase ends.
+
+  Parameters: ctx  - OSPI instance control
+              addr - flash address of the block
+              size - block size
+
+  Return: 0 on success, error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Ospi_dev_erase(void *ctx, uint32_t addr, uint32_t size)
+{
+#if LITTLEFS_ASYNC_ERASE
+  (void)ctx;
+  LFS_LOG("OSPI erase queued addr=0x%08X size=%u\n", (unsigned int)addr, (unsigned int)size);
+  return (Lfs_erase_queue(&g_ospi_erase, addr, size) != 0) ? -1 : 0;
+#else
+  T_mc80_ospi_instance_ctrl *p_ctrl = (T_mc80_ospi_instance_ctrl *)ctx;
+  fsp_err_t                  err;
+
+  if (_Ospi_prepare_write(p_ctrl) != 0)
+  {
+    RTT_err_printf(0, "Failed to prepare flash for erase operation\n");
+    return -1;
+  }
+
+  err = Mc80_ospi_erase(p_ctrl, (uint8_t *)(MC80_OSPI_DEVICE_0_START_ADDRESS + addr), size);
+  if (err != FSP_SUCCESS)
+  {
+    RTT_err_printf(0, "OSPI erase fail addr=0x%08X size=%u err=%u\n\r", (unsigned int)addr, (unsigned int)size, (unsigned int)err);
+    return -1;
+  }
+  LFS_LOG("OSPI erase addr=0x%08X size=%u\n", (unsigned int)addr, (unsigned int)size);
+  return 0;
+#endif
+}
+
+#if LITTLEFS_ASYNC_ERASE
+/*-----------------------------------------------------------------------------------------------------
+  Description: Start an erase for the erase engine
+
+  Parameters: ctx  - OSPI instance control
+              addr - flash address of the block
+              size - block size
+
+  Return: 0 on success, error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Ospi_erase_start(void *ctx, uint32_t addr, uint32_t size)
+{
+  fsp_err_t err;
+
+  if (_exit_xip_mode() != 0)
+  {
+    return -1;
+  }
+  err = Mc80_ospi_erase_start((T_mc80_ospi_instance_ctrl *)ctx, (uint8_t *)(MC80_OSPI_DEVICE_0_START_ADDRESS + addr), size);
+  if (err != FSP_SUCCESS)
+  {
+    RTT_err_printf(0, "OSPI erase start fail addr=0x%08X size=%u err=%u\n", (unsigned int)addr, (unsigned int)size, (unsigned int)err);
+    return -1;
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Read the busy status for the erase engine
+
+  Parameters: ctx - OSPI instance control
+
+  Return: 1 while the erase runs, 0 when it has ended, -1 on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Ospi_erase_busy(void *ctx)
+{
+  bool busy;
+
+  if (_exit_xip_mode() != 0)
+  {
+    return -1;
+  }
+  if (Mc80_ospi_erase_poll((T_mc80_ospi_instance_ctrl *)ctx, &busy) != FSP_SUCCESS)
+  {
+    return -1;
+  }
+  return busy ? 1 : 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Suspend the erase for a read
+
+  Parameters: ctx - OSPI instance control
+
+  Return: 0 on success, error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Ospi_erase_suspend(void *ctx)
+{
+  fsp_err_t err;
+
+  if (_exit_xip_mode() != 0)
+  {
+    return -1;
+  }
+  err = Mc80_ospi_erase_suspend((T_mc80_ospi_instance_ctrl *)ctx);
+  if (err != FSP_SUCCESS)
+  {
+    RTT_err_printf(0, "OSPI erase suspend fail err=%u\n", (unsigned int)err);
+    return -1;
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Resume the erase after a read
+
+  Parameters: ctx - OSPI instance control
+
+  Return: 0 on success, error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Ospi_erase_resume(void *ctx)
+{
+  fsp_err_t err;
+
+  if (_exit_xip_mode() != 0)
+  {
+    return -1;
+  }
+  err = Mc80_ospi_erase_resume((T_mc80_ospi_instance_ctrl *)ctx);
+  if (err != FSP_SUCCESS)
+  {
+    RTT_err_printf(0, "OSPI erase resume fail err=%u\n", (unsigned int)err);
+    return -1;
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Give the CPU to other threads while the engine waits for the end of an erase
+
+  Parameters: ctx - OSPI instance control
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Ospi_erase_wait(void *ctx)
+{
+  (void)ctx;
+  tx_thread_sleep(1);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Clock of the erase engine
+
+  Parameters: ctx - OSPI instance control
+
+  Return: DWT cycle counter
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Ospi_erase_clock(void *ctx)
+{
+  (void)ctx;
+  return CYCLE_PROFILER_NOW();
+}
 
-    // Wait 1ms
-    R_BSP_SoftwareDelay(1, BSP_DELAY_UNITS_MILLISECONDS);
-    wait_count++;
+/*-----------------------------------------------------------------------------------------------------
+  Description: End of a background erase. A failed erase is also returned by the next engine call
+               of the block device.
 
-  } while (wait_count < max_wait_count);
+  Parameters: ctx  - OSPI instance control
+              addr - flash address of the block
+              size - block size
+              err  - result of the erase
 
-  RTT_err_printf(0, "Timeout waiting for flash ready (waited %u ms)\n", wait_count);
-  return -1; // Timeout
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Ospi_erase_done(void *ctx, uint32_t addr, uint32_t size, int err)
+{
+  (void)ctx;
+  if (err != 0)
+  {
+    RTT_err_printf(0, "OSPI erase fail addr=0x%08X size=%u\n", (unsigned int)addr, (unsigned int)size);
+    return;
+  }
+  LFS_LOG("OSPI erase done addr=0x%08X size=%u\n", (unsigned int)addr, (unsigned int)size);
 }
+#endif
 
 /*-----------------------------------------------------------------------------------------------------
   Description: Initialize LittleFS configuration
@@ -182,8 +511,25 @@ int Littlefs_initialize(void)
   if (filesystem_was_mounted)
   {
     g_littlefs_context.filesystem_mounted = true;
-  }  // Configure LittleFS
-  g_littlefs_context.cfg.context = (void *)g_mc80_ospi.p_ctrl;
+  }
+
+  // Block device cache in front of the OSPI flash
+  g_ospi_bd_dev.ctx = (void *)g_mc80_ospi.p_ctrl;
+#if LITTLEFS_BD_PAGE_SIZE > 0
+  Lfs_bd_init(&g_littlefs_context.bd, &g_ospi_bd_dev, g_littlefs_context.bd_page, LITTLEFS_BD_PAGE_SIZE);
+#else
+  Lfs_bd_init(&g_littlefs_context.bd, &g_ospi_bd_dev, NULL, 0);
+#endif
+#if LITTLEFS_PROG_SPI
+  g_read_protocol = g_mc80_ospi.p_ctrl->spi_protocol;
+#endif
+#if LITTLEFS_ASYNC_ERASE
+  g_ospi_erase_dev.ctx = (void *)g_mc80_ospi.p_ctrl;
+  Lfs_erase_init(&g_ospi_erase, &g_ospi_erase_dev);
+#endif
+
+  // Configure LittleFS
+  g_littlefs_context.cfg.context = (void *)&g_littlefs_context.bd;
 
   // Block device operations
   g_littlefs_context.cfg.read = _lfs_read;
@@ -192,8 +538,8 @@ int Littlefs_initialize(void)
   g_littlefs_context.cfg.sync = _lfs_sync;
 
   // Block device configuration
-  g_littlefs_context.cfg.read_size = 1;                       // Minimum read size
-  g_littlefs_context.cfg.prog_size = 1;                       // Minimum program size (start with 1 for testing)
+  g_littlefs_context.cfg.read_size = LITTLEFS_READ_SIZE;      // Read unit of the profile
+  g_littlefs_context.cfg.prog_size = LITTLEFS_PROG_SIZE;      // Commits are padded to it
   g_littlefs_context.cfg.block_size = LITTLEFS_BLOCK_SIZE;    // Block size (4KB)
   g_littlefs_context.cfg.block_count = LITTLEFS_BLOCK_COUNT;  // Number of blocks
   g_littlefs_context.cfg.cache_size = LITTLEFS_CACHE_SIZE;    // Cache size
@@ -303,6 +649,13 @@ int Littlefs_unmount(void)
   // Check if driver is initialized and close it
   if (g_littlefs_context.driver_initialized)
   {
+#if LITTLEFS_ASYNC_ERASE
+    // Erases still running are finished before the driver is closed
+    if (Lfs_erase_sync(&g_ospi_erase) != 0)
+    {
+      APP_ERR_PRINT("LittleFS background erase failed\n\r");
+    }
+#endif
     fsp_err = Mc80_ospi_close(g_mc80_ospi.p_ctrl);
     if (fsp_err != FSP_SUCCESS)
     {
@@ -321,7 +674,7 @@ int Littlefs_unmount(void)
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Description: Read data from flash using XIP mode (direct memory access)
+  Description: Read data from flash through the block device cache
 
   Parameters: c - LFS configuration
               block - block number to read from
@@ -333,50 +686,18 @@ int Littlefs_unmount(void)
 -----------------------------------------------------------------------------------------------------*/
 int _lfs_read(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size)
 {
-  // Calculate absolute address
   uint32_t address = (block * c->block_size) + off;
 
-  // Debug info for first few reads
-  static int debug_count = 0;
-  if (debug_count < 5)
-  {
-    RTT_printf(0, "LFS XIP read: blk=%u off=%u sz=%u addr=0x%08X\n",
-              (unsigned int)block, (unsigned int)off, (unsigned int)size, (unsigned int)address);
-    debug_count++;
-  }
-
-  // Check buffer validity
-  if (buffer == NULL || size == 0)
-  {
-    RTT_err_printf(0, "Invalid read parameters: buffer=%p size=%u\n", buffer, size);
-    return -1;
-  }
-
-  // Ensure XIP mode is active
-  if (_enter_xip_mode() != 0)
-  {
-    RTT_err_printf(0, "Failed to enter XIP mode for read operation\n");
-    return -1;
-  }
-
-  // Calculate XIP address by adding flash offset to XIP base
-  uint8_t *xip_address = (uint8_t *)(MC80_OSPI_DEVICE_0_START_ADDRESS + address);
-
-  // Perform direct memory copy from XIP space
-  memcpy(buffer, xip_address, size);
-
-  // Debug for first read
-  if (debug_count <= 1)
+  LFS_LOG("LFS read: blk=%u off=%u sz=%u\n", (unsigned int)block, (unsigned int)off, (unsigned int)size);
+  if (Lfs_bd_read((T_lfs_bd_cache *)c->context, address, buffer, size) != 0)
   {
-    RTT_printf(0, "XIP read success: copied %u bytes from 0x%08X\n",
-              (unsigned int)size, (unsigned int)xip_address);
+    return LFS_ERR_IO;
   }
-
-  return 0; // Success
+  return 0;
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Description: Program (write) data to flash memory through OSPI driver
+  Description: Program (write) data to flash through the block device cache
 
   Parameters: c - LFS configuration
               block - block number to write to
@@ -388,79 +709,18 @@ int _lfs_read(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, void
 -----------------------------------------------------------------------------------------------------*/
 int _lfs_prog(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size)
 {
-  fsp_err_t err;
-  T_mc80_ospi_instance_ctrl *p_ctrl = (T_mc80_ospi_instance_ctrl *)c->context;
-  T_mc80_ospi_status status;
-
-  // Calculate absolute address
   uint32_t address = (block * c->block_size) + off;
 
-  RTT_printf(0, "LFS write: blk=%u off=%u sz=%u addr=0x%08X\n",
-            (unsigned int)block, (unsigned int)off, (unsigned int)size, (unsigned int)address);
-
-  // Show first few bytes of data for debugging
-  if (size > 0 && buffer != NULL)
-  {
-    const uint8_t *data = (const uint8_t *)buffer;
-    RTT_printf(0, "Write data: %02X %02X %02X %02X...\n",
-              data[0],
-              size > 1 ? data[1] : 0,
-              size > 2 ? data[2] : 0,
-              size > 3 ? data[3] : 0);
-  }
-
-  // Exit XIP mode before write operation
-  if (_exit_xip_mode() != 0)
-  {
-    RTT_err_printf(0, "Failed to exit XIP mode for write operation\n");
-    return -1;
-  }
-
-  // Set SPI protocol for write operations
-  err = Mc80_ospi_spi_protocol_set(p_ctrl, MC80_OSPI_PROTOCOL_1S_1S_1S);
-  if (err != FSP_SUCCESS)
-  {
-    RTT_printf(0, "Warning: Failed to set SPI protocol: %u\n", (unsigned int)err);
-    // Continue anyway, might not be critical
-  }
-
-  // Check flash status before write
-  err = Mc80_ospi_status_get(p_ctrl, &status);
-  if (err != FSP_SUCCESS)
-  {
-    RTT_err_printf(0, "Failed to get flash status before write: %u\n", (unsigned int)err);
-    return -1;
-  }
-
-  if (status.write_in_progress)
-  {
-    RTT_err_printf(0, "Flash is busy, write in progress\n");
-    return -1;
-  }
-
-  // Write data using OSPI driver with correct base address
-  err = Mc80_ospi_memory_mapped_write(p_ctrl, (uint8_t *)buffer, (uint8_t *)(MC80_OSPI_DEVICE_0_START_ADDRESS + address), size);
-
-  if (err != FSP_SUCCESS)
+  LFS_LOG("LFS write: blk=%u off=%u sz=%u\n", (unsigned int)block, (unsigned int)off, (unsigned int)size);
+  if (Lfs_bd_prog((T_lfs_bd_cache *)c->context, address, buffer, size) != 0)
   {
-    RTT_err_printf(0, "OSPI write fail addr=0x%08X size=%u err=%u (0x%X)\n",
-                  (unsigned int)address, size, (unsigned int)err, (unsigned int)err);
-    return -1; // Return LFS error
+    return LFS_ERR_IO;
   }
-
-  // Wait for write operation to complete
-  if (_wait_flash_ready(p_ctrl, 1000) != 0) // 1 second timeout for write
-  {
-    RTT_err_printf(0, "Timeout waiting for write completion\n");
-    return -1;
-  }
-
-  RTT_printf(0, "OSPI write success addr=0x%08X size=%u\n", (unsigned int)address, size);
-  return 0; // Success
+  return 0;
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Description: Erase a block of flash memory through OSPI driver
+  Description: Erase a block of flash memory through the block device cache
 
   Parameters: c - LFS configuration
               block - block number to erase
@@ -469,67 +729,16 @@ int _lfs_prog(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, cons
 -----------------------------------------------------------------------------------------------------*/
 int _lfs_erase(const struct lfs_config *c, lfs_block_t block)
 {
-  fsp_err_t err;
-  T_mc80_ospi_instance_ctrl *p_ctrl = (T_mc80_ospi_instance_ctrl *)c->context;
-  T_mc80_ospi_status status;
-
-  // Calculate absolute address
-  uint32_t address = block * c->block_size;
-
-  RTT_printf(0, "LFS erase: blk=%u addr=0x%08X size=%u\n",
-            (unsigned int)block, (unsigned int)address, c->block_size);
-
-  // Exit XIP mode before erase operation
-  if (_exit_xip_mode() != 0)
-  {
-    RTT_err_printf(0, "Failed to exit XIP mode for erase operation\n");
-    return -1;
-  }
-
-  // Set SPI protocol for erase operations
-  err = Mc80_ospi_spi_protocol_set(p_ctrl, MC80_OSPI_PROTOCOL_1S_1S_1S);
-  if (err != FSP_SUCCESS)
-  {
-    RTT_printf(0, "Warning: Failed to set SPI protocol for erase: %u\n", (unsigned int)err);
-    // Continue anyway, might not be critical
-  }
-
-  // Check flash status before erase
-  err = Mc80_ospi_status_get(p_ctrl, &status);
-  if (err != FSP_SUCCESS)
-  {
-    RTT_err_printf(0, "Failed to get flash status before erase: %u\n", (unsigned int)err);
-    return -1;
-  }
-
-  if (status.write_in_progress)
-  {
-    RTT_err_printf(0, "Flash is busy, cannot erase\n");
-    return -1;
-  }
-
-  // Erase block using OSPI driver with correct base address
-  err = Mc80_ospi_erase(p_ctrl, (uint8_t *)(MC80_OSPI_DEVICE_0_START_ADDRESS + address), c->block_size);
-
-  if (err != FSP_SUCCESS)
+  LFS_LOG("LFS erase: blk=%u\n", (unsigned int)block);
+  if (Lfs_bd_erase((T_lfs_bd_cache *)c->context, block * c->block_size, c->block_size) != 0)
   {
-    RTT_err_printf(0, "OSPI erase fail addr=0x%08X size=%u err=%u\n\r", (unsigned int)address, c->block_size, (unsigned int)err);
-    return -1; // Return LFS error
-  }
-
-  // Wait for erase operation to complete (erase can take several milliseconds)
-  if (_wait_flash_ready(p_ctrl, 5000) != 0) // 5 second timeout
-  {
-    RTT_err_printf(0, "Timeout waiting for erase completion\n");
-    return -1;
+    return LFS_ERR_IO;
   }
-
-  RTT_printf(0, "OSPI erase success addr=0x%08X size=%u\n", (unsigned int)address, c->block_size);
-  return 0; // Success
+  return 0;
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Description: Synchronize flash memory operations
+  Description: Write the cached page to flash. LittleFS calls it at the end of every commit.
 
   Parameters: c - LFS configuration
 
@@ -537,10 +746,11 @@ int _lfs_erase(const struct lfs_config *c, lfs_block_t block)
 -----------------------------------------------------------------------------------------------------*/
 int _lfs_sync(const struct lfs_config *c)
 {
-  // For this implementation, sync is not needed as writes are synchronous
-  // But we can add status checking if needed
-  (void)c;
-  return 0; // Success
+  if (Lfs_bd_sync((T_lfs_bd_cache *)c->context) != 0)
+  {
+    return LFS_ERR_IO;
+  }
+  return 0;
 }
 
 /*-----------------------------------------------------------------------------------------------------
@@ -566,3 +776,48 @@ bool Littlefs_is_mounted(void)
 {
   return g_littlefs_context.filesystem_mounted;
 }
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Make a range of the OSPI flash readable through the memory-mapped window.
+               A running background erase is suspended, a pending erase of the range is waited for.
+               Every memory-mapped read of the file system area must be enclosed in
+               Littlefs_flash_read_begin / Littlefs_flash_read_end.
+
+  Parameters: addr - flash address
+              size - number of bytes
+
+  Return: 0 on success, -1 on failure
+-----------------------------------------------------------------------------------------------------*/
+int Littlefs_flash_read_begin(uint32_t addr, uint32_t size)
+{
+#if LITTLEFS_ASYNC_ERASE
+  if (Lfs_erase_read_begin(&g_ospi_erase, addr, size) != 0)
+  {
+    RTT_err_printf(0, "Background erase failed before read addr=0x%08X\n", (unsigned int)addr);
+    return -1;
+  }
+#else
+  (void)addr;
+  (void)size;
+#endif
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: End of a memory-mapped read, the suspended erase is resumed
+
+  Parameters:
+
+  Return: 0 on success, -1 on failure
+-----------------------------------------------------------------------------------------------------*/
+int Littlefs_flash_read_end(void)
+{
+#if LITTLEFS_ASYNC_ERASE
+  if (Lfs_erase_read_end(&g_ospi_erase) != 0)
+  {
+    RTT_err_printf(0, "Failed to resume erase after read\n");
+    return -1;
+  }
+#endif
+  return 0;
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define LITTLEFS_ADAPTER_H
 
 #include "lfs.h"
+#include "littlefs_bd_cache.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -10,10 +11,81 @@ extern "C" {
 // Maximum size for LittleFS configuration based on MX25UM25645G datasheet
 #define LITTLEFS_BLOCK_SIZE        4096    // 4KB sectors (matches flash erase sector size)
 #define LITTLEFS_BLOCK_COUNT       64      // Use 256KB (64 * 4KB) for minimal testing
-#define LITTLEFS_CACHE_SIZE        256     // Cache size (matches 256-byte page buffer)
-#define LITTLEFS_LOOKAHEAD_SIZE    16      // Lookahead buffer size (64/8 = 8, use 16 for safety, must be multiple of 8)
-#define LITTLEFS_BLOCK_CYCLES      100000  // 100,000 erase/program cycles (per datasheet)
-#define LITTLEFS_PROG_SIZE         256     // 256-byte page buffer (per datasheet)
+#define LITTLEFS_PAGE_SIZE         256     // 256-byte program page (per datasheet)
+
+// Geometry profiles. prog_size is the unit LittleFS pads every commit to, read_size the unit of reads,
+// cache_size the size of the read and program caches. A block is moved to another place after
+// block_cycles erases, 100000 leaves wear leveling of metadata pairs practically off. A lookahead of 16 bytes
+// covers 128 blocks, more than the file system has, so all profiles use it.
+#define LITTLEFS_BYTE_READ_SIZE          1       // Byte granular commits, the original configuration
+#define LITTLEFS_BYTE_PROG_SIZE          1
+#define LITTLEFS_BYTE_CACHE_SIZE         256
+#define LITTLEFS_BYTE_LOOKAHEAD_SIZE     16
+#define LITTLEFS_BYTE_BLOCK_CYCLES       100000
+
+#define LITTLEFS_SMALL_READ_SIZE         16      // Commits padded to 16 bytes, joined into pages by the page cache
+#define LITTLEFS_SMALL_PROG_SIZE         16
+#define LITTLEFS_SMALL_CACHE_SIZE        256
+#define LITTLEFS_SMALL_LOOKAHEAD_SIZE    16
+#define LITTLEFS_SMALL_BLOCK_CYCLES      500
+
+#define LITTLEFS_PAGE_READ_SIZE          16      // Commits padded to the program page
+#define LITTLEFS_PAGE_PROG_SIZE          LITTLEFS_PAGE_SIZE
+#define LITTLEFS_PAGE_CACHE_SIZE         256
+#define LITTLEFS_PAGE_LOOKAHEAD_SIZE     16
+#define LITTLEFS_PAGE_BLOCK_CYCLES       500
+
+#define LITTLEFS_PAGE_1K_READ_SIZE       16      // As PAGE with 1 KB caches
+#define LITTLEFS_PAGE_1K_PROG_SIZE       LITTLEFS_PAGE_SIZE
+#define LITTLEFS_PAGE_1K_CACHE_SIZE      1024
+#define LITTLEFS_PAGE_1K_LOOKAHEAD_SIZE  16
+#define LITTLEFS_PAGE_1K_BLOCK_CYCLES    500
+
+#define LITTLEFS_PROFILE_COUNT           4
+#define LITTLEFS_MAX_CACHE_SIZE          1024    // Largest cache_size of the profiles
+#define LITTLEFS_MAX_LOOKAHEAD_SIZE      16
+
+// Profile of the OSPI file system: BYTE, SMALL, PAGE or PAGE_1K. Compared by Littlefs_bench_profile:
+// SMALL programs as few bytes as BYTE and lists directories faster. PAGE pads every metadata commit
+// to a full page, rewrites of small files program about 1.6 times more bytes and erase more blocks.
+#ifndef LITTLEFS_PROFILE
+#define LITTLEFS_PROFILE                 SMALL
+#endif
+
+#define LITTLEFS_GEO_(profile, field)    LITTLEFS_##profile##_##field
+#define LITTLEFS_GEO(profile, field)     LITTLEFS_GEO_(profile, field)
+#define LITTLEFS_READ_SIZE               LITTLEFS_GEO(LITTLEFS_PROFILE, READ_SIZE)
+#define LITTLEFS_PROG_SIZE               LITTLEFS_GEO(LITTLEFS_PROFILE, PROG_SIZE)
+#define LITTLEFS_CACHE_SIZE              LITTLEFS_GEO(LITTLEFS_PROFILE, CACHE_SIZE)
+#define LITTLEFS_LOOKAHEAD_SIZE          LITTLEFS_GEO(LITTLEFS_PROFILE, LOOKAHEAD_SIZE)
+#define LITTLEFS_BLOCK_CYCLES            LITTLEFS_GEO(LITTLEFS_PROFILE, BLOCK_CYCLES)
+
+// 1 - read through XIP, 0 - plain memory-mapped reads. XIP is not required by MX25UM25645G.
+#ifndef LITTLEFS_READ_XIP
+#define LITTLEFS_READ_XIP          1
+#endif
+
+// 0 - program and erase in the protocol the flash is currently in (8D-8D-8D stays active).
+// 1 - switch to 1S-1S-1S for program and erase, the previous protocol is restored before the next read.
+#ifndef LITTLEFS_PROG_SPI
+#define LITTLEFS_PROG_SPI          0
+#endif
+
+// 1 - erase runs in the background and is suspended for reads (littlefs_erase.h), 0 - erase waits for its end.
+// Program and erase must stay in the read protocol: the configuration register can not be written while an erase is suspended.
+// Off until erase suspend and resume are verified on the board.
+#ifndef LITTLEFS_ASYNC_ERASE
+#define LITTLEFS_ASYNC_ERASE       0
+#endif
+
+#if LITTLEFS_ASYNC_ERASE && LITTLEFS_PROG_SPI
+#error "LITTLEFS_ASYNC_ERASE requires LITTLEFS_PROG_SPI 0"
+#endif
+
+// Trace of every block device operation to RTT
+#ifndef LITTLEFS_DEBUG_LOG
+#define LITTLEFS_DEBUG_LOG         0
+#endif
 
 // LittleFS instance structure
 typedef struct
@@ -23,6 +95,10 @@ typedef struct
   uint8_t read_buffer[LITTLEFS_CACHE_SIZE];
   uint8_t prog_buffer[LITTLEFS_CACHE_SIZE];
   uint8_t lookahead_buffer[LITTLEFS_LOOKAHEAD_SIZE];
+  T_lfs_bd_cache bd;             // Page cache in front of the OSPI driver, cfg.context points to it
+#if LITTLEFS_BD_PAGE_SIZE > 0
+  uint8_t bd_page[LITTLEFS_BD_PAGE_SIZE];
+#endif
   bool driver_initialized;       // Flag to track OSPI driver state
   bool filesystem_mounted;       // Flag to track filesystem mount state
 } T_littlefs_context;
@@ -37,8 +113,10 @@ int  Littlefs_format(void);
 int  Littlefs_unmount(void);
 bool Littlefs_is_initialized(void);
 bool Littlefs_is_mounted(void);
+int  Littlefs_flash_read_begin(uint32_t addr, uint32_t size);
+int  Littlefs_flash_read_end(void);
 
-// LFS driver functions - these are called by LittleFS
+// LFS driver functions - these are called by LittleFS, c->context is T_lfs_bd_cache
 int  _lfs_read(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size);
 int  _lfs_prog(const struct lfs_config *c, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size);
 int  _lfs_erase(const struct lfs_config *c, lfs_block_t block);
@@ -0,0 +1,290 @@
+/*-----------------------------------------------------------------------------------------------------
+  Description: Write-back page cache between LittleFS and the flash driver
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+
+#include "App.h"
+#include "littlefs_bd_cache.h"
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Initialize the block device layer
+
+  Parameters: bd        - block device instance
+              dev       - lower level device
+              page      - page buffer of page_size bytes, NULL - cache is disabled
+              page_size - device program page size
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void Lfs_bd_init(T_lfs_bd_cache *bd, const T_lfs_bd_dev *dev, uint8_t *page, uint32_t page_size)
+{
+  memset(bd, 0, sizeof(*bd));
+  bd->dev       = dev;
+  bd->page      = (page_size != 0) ? page : NULL;
+  bd->page_size = page_size;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Check whether a device range overlaps another one
+
+  Parameters: addr  - start of the first range
+              size  - size of the first range
+              start - start of the second range
+              end   - end of the second range, exclusive
+
+  Return: true if the ranges overlap
+-----------------------------------------------------------------------------------------------------*/
+static bool _Lfs_bd_overlap(uint32_t addr, uint32_t size, uint32_t start, uint32_t end)
+{
+  return (addr < end) && (start < addr + size);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Program the cached bytes to the device and empty the cache
+
+  Parameters: bd - block device instance
+
+  Return: 0 on success, error code of the device on failure
+-----------------------------------------------------------------------------------------------------*/
+int Lfs_bd_flush(T_lfs_bd_cache *bd)
+{
+  int err;
+
+  if (bd->lo == bd->hi)
+  {
+    return 0;
+  }
+  err = bd->dev->prog(bd->dev->ctx, bd->page_addr + bd->lo, &bd->page[bd->lo], bd->hi - bd->lo);
+  bd->stats.dev_progs++;
+  if (err != 0)
+  {
+    bd->stats.prog_errors++;
+  }
+  // The cache is emptied even on error, the data can not be programmed again without an erase
+  bd->lo = 0;
+  bd->hi = 0;
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Flush the cache before an operation on another range. An error of the program belongs to
+               the cached range, it is kept until a read of that range or a sync reports it.
+
+  Parameters: bd - block device instance
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Lfs_bd_flush_for_other(T_lfs_bd_cache *bd)
+{
+  uint32_t start = bd->page_addr + bd->lo;
+  uint32_t end   = bd->page_addr + bd->hi;
+  int      err   = Lfs_bd_flush(bd);
+
+  if (err == 0)
+  {
+    return;
+  }
+  if (bd->err == 0)
+  {
+    bd->err      = err;
+    bd->err_addr = start;
+    bd->err_end  = end;
+    return;
+  }
+  // Keep the first error, its range grows to cover both failed programs
+  if (start < bd->err_addr)
+  {
+    bd->err_addr = start;
+  }
+  if (end > bd->err_end)
+  {
+    bd->err_end = end;
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Take the kept program error if it belongs to a range
+
+  Parameters: bd   - block device instance
+              addr - device address
+              size - number of bytes
+
+  Return: Kept error code or 0
+-----------------------------------------------------------------------------------------------------*/
+static int _Lfs_bd_take_error(T_lfs_bd_cache *bd, uint32_t addr, uint32_t size)
+{
+  int err = bd->err;
+
+  if ((err == 0) || !_Lfs_bd_overlap(addr, size, bd->err_addr, bd->err_end))
+  {
+    return 0;
+  }
+  bd->err = 0;
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Flush the cache on request of LittleFS. A kept program error is reported here if no read
+               of its range reported it before.
+
+  Parameters: bd - block device instance
+
+  Return: 0 on success, error code of the device on failure
+-----------------------------------------------------------------------------------------------------*/
+int Lfs_bd_sync(T_lfs_bd_cache *bd)
+{
+  int err;
+
+  bd->stats.syncs++;
+  err = Lfs_bd_flush(bd);
+  if (err == 0)
+  {
+    err = bd->err;
+  }
+  bd->err = 0;
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Read data from the device. Cached bytes in the range are programmed first, so the data
+               read back are the data the device holds.
+
+  Parameters: bd   - block device instance
+              addr - device address
+              buf  - destination
+              size - number of bytes
+
+  Return: 0 on success, error code of the device or of a failed program of the range on failure
+-----------------------------------------------------------------------------------------------------*/
+int Lfs_bd_read(T_lfs_bd_cache *bd, uint32_t addr, void *buf, uint32_t size)
+{
+  int err;
+
+  bd->stats.reads++;
+  if ((bd->lo != bd->hi) && _Lfs_bd_overlap(addr, size, bd->page_addr + bd->lo, bd->page_addr + bd->hi))
+  {
+    bd->stats.read_flushes++;
+    err = Lfs_bd_flush(bd);
+    if (err != 0)
+    {
+      return err;
+    }
+  }
+  err = _Lfs_bd_take_error(bd, addr, size);
+  if (err != 0)
+  {
+    return err;
+  }
+  return bd->dev->read(bd->dev->ctx, addr, buf, size);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Program data. The range is split at page boundaries, each part is appended to the cached
+               page if it continues it, otherwise the cache is flushed and the part starts a new one.
+               Whole aligned pages are programmed directly when the cache is empty.
+
+  Parameters: bd   - block device instance
+              addr - device address
+              buf  - source data
+              size - number of bytes
+
+  Return: 0 on success, error code of the device on failure
+-----------------------------------------------------------------------------------------------------*/
+int Lfs_bd_prog(T_lfs_bd_cache *bd, uint32_t addr, const void *buf, uint32_t size)
+{
+  const uint8_t *src = (const uint8_t *)buf;
+  int            err;
+
+  bd->stats.progs++;
+  if (bd->page == NULL)
+  {
+    bd->stats.dev_progs++;
+    err = bd->dev->prog(bd->dev->ctx, addr, buf, size);
+    if (err != 0)
+    {
+      bd->stats.prog_errors++;
+    }
+    return err;
+  }
+
+  while (size > 0)
+  {
+    uint32_t off       = addr % bd->page_size;
+    uint32_t page_addr = addr - off;
+    uint32_t n         = bd->page_size - off;
+    if (n > size)
+    {
+      n = size;
+    }
+
+    if ((bd->lo != bd->hi) && (page_addr == bd->page_addr) && (off == bd->hi))
+    {
+      bd->stats.merged++;
+    }
+    else
+    {
+      _Lfs_bd_flush_for_other(bd);
+      if (n == bd->page_size)
+      {
+        err = bd->dev->prog(bd->dev->ctx, addr, src, n);
+        bd->stats.dev_progs++;
+        if (err != 0)
+        {
+          bd->stats.prog_errors++;
+          return err;
+        }
+        addr += n;
+        src  += n;
+        size -= n;
+        continue;
+      }
+      bd->page_addr = page_addr;
+      bd->lo        = off;
+      bd->hi        = off;
+    }
+
+    memcpy(&bd->page[off], src, n);
+    bd->hi += n;
+    addr   += n;
+    src    += n;
+    size   -= n;
+
+    if (bd->hi == bd->page_size)
+    {
+      err = Lfs_bd_flush(bd);
+      if (err != 0)
+      {
+        return err;
+      }
+    }
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Erase a range. A cached page and a kept program error inside the range are dropped,
+               the content of the range is no longer needed.
+
+  Parameters: bd   - block device instance
+              addr - device address of the block
+              size - block size
+
+  Return: 0 on success, error code of the device on failure
+-----------------------------------------------------------------------------------------------------*/
+int Lfs_bd_erase(T_lfs_bd_cache *bd, uint32_t addr, uint32_t size)
+{
+  bd->stats.erases++;
+  if ((bd->lo != bd->hi) && (bd->page_addr >= addr) && (bd->page_addr < addr + size))
+  {
+    bd->lo = 0;
+    bd->hi = 0;
+  }
+  if ((bd->err != 0) && (bd->err_addr >= addr) && (bd->err_end <= addr + size))
+  {
+    bd->err = 0;
+  }
+  return bd->dev->erase(bd->dev->ctx, addr, size);
+}
@@ -0,0 +1,71 @@
+#ifndef LITTLEFS_BD_CACHE_H
+#define LITTLEFS_BD_CACHE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Block device layer between LittleFS and the flash driver with a one page write-back cache.
+//
+// A program that continues the data already held in the cache is appended to it. The page is sent
+// to the device with one program command when it becomes full, when a program to another place
+// arrives, on a read of the cached range, on erase of its sector and on sync. Reads always come from
+// the device, so the LittleFS prog-then-read validation checks what the device really holds.
+//
+// A failed program is reported on the address range it was written to: if it fails while the cache is
+// flushed for a program or a read elsewhere, the error is kept and returned by the next read of that
+// range or by the next sync, the unrelated operation succeeds.
+
+#ifndef LITTLEFS_BD_PAGE_SIZE
+#define LITTLEFS_BD_PAGE_SIZE  256  // Program page of MX25UM25645G, 0 disables the cache
+#endif
+
+// Lower level device, the functions return 0 on success
+typedef struct
+{
+  int (*read)(void *ctx, uint32_t addr, void *buf, uint32_t size);
+  int (*prog)(void *ctx, uint32_t addr, const void *buf, uint32_t size);
+  int (*erase)(void *ctx, uint32_t addr, uint32_t size);
+  void *ctx;
+} T_lfs_bd_dev;
+
+typedef struct
+{
+  uint32_t progs;         // Program requests from LittleFS
+  uint32_t merged;        // Program requests appended to the cached page
+  uint32_t dev_progs;     // Program operations passed to the device
+  uint32_t reads;         // Read requests from LittleFS
+  uint32_t read_flushes;  // Read requests that flushed the cache before reading the device
+  uint32_t prog_errors;   // Failed program operations of the device
+  uint32_t erases;
+  uint32_t syncs;
+} T_lfs_bd_stats;
+
+typedef struct
+{
+  const T_lfs_bd_dev *dev;
+  uint8_t            *page;        // Page buffer, NULL - programs go to the device directly
+  uint32_t            page_size;
+  uint32_t            page_addr;   // Device address of the cached page
+  uint32_t            lo;          // Cached bytes are [lo, hi) of the page, lo == hi - cache is empty
+  uint32_t            hi;
+  int                 err;         // Error of a program flushed on behalf of another operation, 0 - none
+  uint32_t            err_addr;    // Device range [err_addr, err_end) of that program
+  uint32_t            err_end;
+  T_lfs_bd_stats      stats;
+} T_lfs_bd_cache;
+
+void Lfs_bd_init(T_lfs_bd_cache *bd, const T_lfs_bd_dev *dev, uint8_t *page, uint32_t page_size);
+int  Lfs_bd_read(T_lfs_bd_cache *bd, uint32_t addr, void *buf, uint32_t size);
+int  Lfs_bd_prog(T_lfs_bd_cache *bd, uint32_t addr, const void *buf, uint32_t size);
+int  Lfs_bd_erase(T_lfs_bd_cache *bd, uint32_t addr, uint32_t size);
+int  Lfs_bd_flush(T_lfs_bd_cache *bd);
+int  Lfs_bd_sync(T_lfs_bd_cache *bd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LITTLEFS_BD_CACHE_H
@@ -0,0 +1,815 @@
+/*-----------------------------------------------------------------------------------------------------
+  Description: LittleFS throughput benchmark over the RAM NOR flash model
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+
+#include "App.h"
+#include "littlefs_adapter.h"
+#include "nor_flash_model.h"
+#include "littlefs_erase.h"
+#include "littlefs_bench.h"
+
+typedef struct
+{
+  lfs_t             lfs;
+  struct lfs_config cfg;
+  T_lfs_bd_dev      dev;
+  T_lfs_bd_cache    bd;
+  T_nor_model       nor;
+  T_lfs_erase_dev   erase_dev;
+  T_lfs_erase       erase;
+  uint32_t          last_cycles;  // DWT value at the previous lap
+  uint64_t          cpu_cycles;   // CPU time accumulated by laps
+  uint8_t           read_buffer[LITTLEFS_MAX_CACHE_SIZE];
+  uint8_t           prog_buffer[LITTLEFS_MAX_CACHE_SIZE];
+  uint8_t           lookahead_buffer[LITTLEFS_MAX_LOOKAHEAD_SIZE];
+  uint8_t           page[LITTLEFS_PAGE_SIZE];
+  uint8_t           io[LFS_BENCH_IO_CHUNK];
+} T_lfs_bench_ctx;
+
+#define LITTLEFS_GEOMETRY_(p)  { #p, LITTLEFS_##p##_READ_SIZE, LITTLEFS_##p##_PROG_SIZE, LITTLEFS_##p##_CACHE_SIZE, LITTLEFS_##p##_LOOKAHEAD_SIZE, LITTLEFS_##p##_BLOCK_CYCLES }
+#define LITTLEFS_GEOMETRY(p)   LITTLEFS_GEOMETRY_(p)
+
+const T_littlefs_geometry g_littlefs_profiles[LITTLEFS_PROFILE_COUNT] =
+{
+  LITTLEFS_GEOMETRY(BYTE),
+  LITTLEFS_GEOMETRY(SMALL),
+  LITTLEFS_GEOMETRY(PAGE),
+  LITTLEFS_GEOMETRY(PAGE_1K),
+};
+
+// Geometry of the OSPI file system
+const T_littlefs_geometry g_littlefs_geometry = LITTLEFS_GEOMETRY(LITTLEFS_PROFILE);
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Add CPU time since the previous lap. Laps are taken after every file system call,
+               so the cycle counter can not wrap between them.
+
+  Parameters: b - benchmark context
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Bench_lap(T_lfs_bench_ctx *b)
+{
+  uint32_t now    = LFS_BENCH_CYCLES();
+  b->cpu_cycles  += (uint32_t)(now - b->last_cycles);
+  b->last_cycles  = now;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Start measurement of a workload
+
+  Parameters: b - benchmark context
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Bench_start(T_lfs_bench_ctx *b)
+{
+  Nor_model_reset_stats(&b->nor);
+  b->cpu_cycles  = 0;
+  b->last_cycles = LFS_BENCH_CYCLES();
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Finish measurement of a workload and calculate the rates
+
+  Parameters: b     - benchmark context
+              res   - result
+              files - number of processed files
+              bytes - number of processed payload bytes
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Bench_stop(T_lfs_bench_ctx *b, T_lfs_bench_result *res, uint32_t files, uint32_t bytes)
+{
+  uint64_t total_us;
+
+  _Bench_lap(b);
+  res->files      = files;
+  res->bytes      = bytes;
+  res->cpu_us     = (uint32_t)(b->cpu_cycles / LFS_BENCH_CYCLES_PER_US);
+  res->dev_us     = (uint32_t)(b->nor.busy_ns / 1000);
+  res->dev_progs  = b->nor.progs;
+  res->dev_erases = b->nor.erases;
+  res->prog_bytes = (uint32_t)b->nor.prog_bytes;
+
+  total_us = (uint64_t)res->cpu_us + res->dev_us;
+  if (total_us == 0)
+  {
+    total_us = 1;
+  }
+  res->files_per_s = (uint32_t)(((uint64_t)files * 1000000ull) / total_us);
+  res->bytes_per_s = (uint32_t)(((uint64_t)bytes * 1000000ull) / total_us);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Test pattern byte
+
+  Parameters: file - file number
+              pos  - position in the file
+
+  Return: pattern value
+-----------------------------------------------------------------------------------------------------*/
+static uint8_t _Bench_pattern(uint32_t file, uint32_t pos)
+{
+  return (uint8_t)(file * 31u + pos * 7u + (pos >> 8));
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Name of a small file
+
+  Parameters: name - buffer of at least 16 bytes
+              n    - file number
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Bench_small_name(char *name, uint32_t n)
+{
+  snprintf(name, 16, "/s%03u.bin", (unsigned int)n);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Create LFS_BENCH_SMALL_FILES files of LFS_BENCH_SMALL_FILE_SZ bytes
+
+  Parameters: b   - benchmark context
+              res - result
+
+  Return: 0 on success, LittleFS error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Bench_small_write(T_lfs_bench_ctx *b, T_lfs_bench_result *res)
+{
+  lfs_file_t  file;
+  char        name[16];
+  lfs_ssize_t wr;
+  int         err;
+
+  _Bench_start(b);
+  for (uint32_t n = 0; n < LFS_BENCH_SMALL_FILES; n++)
+  {
+    for (uint32_t i = 0; i < LFS_BENCH_SMALL_FILE_SZ; i++)
+    {
+      b->io[i] = _Bench_pattern(n, i);
+    }
+    _Bench_small_name(name, n);
+    err = lfs_file_open(&b->lfs, &file, name, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
+    if (err < 0)
+    {
+      return err;
+    }
+    wr  = lfs_file_write(&b->lfs, &file, b->io, LFS_BENCH_SMALL_FILE_SZ);
+    err = lfs_file_close(&b->lfs, &file);
+    if (wr != LFS_BENCH_SMALL_FILE_SZ)
+    {
+      return (wr < 0) ? (int)wr : LFS_ERR_IO;
+    }
+    if (err < 0)
+    {
+      return err;
+    }
+    _Bench_lap(b);
+  }
+  _Bench_stop(b, res, LFS_BENCH_SMALL_FILES, LFS_BENCH_SMALL_FILES * LFS_BENCH_SMALL_FILE_SZ);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Read back and verify the small files
+
+  Parameters: b   - benchmark context
+              res - result
+
+  Return: 0 on success, LittleFS error code on failure, LFS_ERR_CORRUPT on data mismatch
+-----------------------------------------------------------------------------------------------------*/
+static int _Bench_small_read(T_lfs_bench_ctx *b, T_lfs_bench_result *res)
+{
+  lfs_file_t  file;
+  char        name[16];
+  lfs_ssize_t rd;
+  int         err;
+
+  _Bench_start(b);
+  for (uint32_t n = 0; n < LFS_BENCH_SMALL_FILES; n++)
+  {
+    _Bench_small_name(name, n);
+    err = lfs_file_open(&b->lfs, &file, name, LFS_O_RDONLY);
+    if (err < 0)
+    {
+      return err;
+    }
+    rd  = lfs_file_read(&b->lfs, &file, b->io, LFS_BENCH_SMALL_FILE_SZ);
+    err = lfs_file_close(&b->lfs, &file);
+    if (rd != LFS_BENCH_SMALL_FILE_SZ)
+    {
+      return (rd < 0) ? (int)rd : LFS_ERR_IO;
+    }
+    if (err < 0)
+    {
+      return err;
+    }
+    for (uint32_t i = 0; i < LFS_BENCH_SMALL_FILE_SZ; i++)
+    {
+      if (b->io[i] != _Bench_pattern(n, i))
+      {
+        return LFS_ERR_CORRUPT;
+      }
+    }
+    _Bench_lap(b);
+  }
+  _Bench_stop(b, res, LFS_BENCH_SMALL_FILES, LFS_BENCH_SMALL_FILES * LFS_BENCH_SMALL_FILE_SZ);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Write one file of LFS_BENCH_LARGE_FILE_SZ bytes by LFS_BENCH_IO_CHUNK
+
+  Parameters: b   - benchmark context
+              res - result
+
+  Return: 0 on success, LittleFS error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Bench_large_write(T_lfs_bench_ctx *b, T_lfs_bench_result *res)
+{
+  lfs_file_t  file;
+  lfs_ssize_t wr;
+  int         err;
+
+  _Bench_start(b);
+  err = lfs_file_open(&b->lfs, &file, "/large.bin", LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
+  if (err < 0)
+  {
+    return err;
+  }
+  for (uint32_t pos = 0; pos < LFS_BENCH_LARGE_FILE_SZ; pos += LFS_BENCH_IO_CHUNK)
+  {
+    for (uint32_t i = 0; i < LFS_BENCH_IO_CHUNK; i++)
+    {
+      b->io[i] = _Bench_pattern(LFS_BENCH_SMALL_FILES, pos + i);
+    }
+    wr = lfs_file_write(&b->lfs, &file, b->io, LFS_BENCH_IO_CHUNK);
+    if (wr != LFS_BENCH_IO_CHUNK)
+    {
+      lfs_file_close(&b->lfs, &file);
+      return (wr < 0) ? (int)wr : LFS_ERR_IO;
+    }
+    _Bench_lap(b);
+  }
+  err = lfs_file_close(&b->lfs, &file);
+  if (err < 0)
+  {
+    return err;
+  }
+  _Bench_stop(b, res, 1, LFS_BENCH_LARGE_FILE_SZ);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Read back and verify the large file
+
+  Parameters: b   - benchmark context
+              res - result
+
+  Return: 0 on success, LittleFS error code on failure, LFS_ERR_CORRUPT on data mismatch
+-----------------------------------------------------------------------------------------------------*/
+static int _Bench_large_read(T_lfs_bench_ctx *b, T_lfs_bench_result *res)
+{
+  lfs_file_t  file;
+  lfs_ssize_t rd;
+  int         err;
+
+  _Bench_start(b);
+  err = lfs_file_open(&b->lfs, &file, "/large.bin", LFS_O_RDONLY);
+  if (err < 0)
+  {
+    return err;
+  }
+  for (uint32_t pos = 0; pos < LFS_BENCH_LARGE_FILE_SZ; pos += LFS_BENCH_IO_CHUNK)
+  {
+    rd = lfs_file_read(&b->lfs, &file, b->io, LFS_BENCH_IO_CHUNK);
+    if (rd != LFS_BENCH_IO_CHUNK)
+    {
+      lfs_file_close(&b->lfs, &file);
+      return (rd < 0) ? (int)rd : LFS_ERR_IO;
+    }
+    for (uint32_t i = 0; i < LFS_BENCH_IO_CHUNK; i++)
+    {
+      if (b->io[i] != _Bench_pattern(LFS_BENCH_SMALL_FILES, pos + i))
+      {
+        lfs_file_close(&b->lfs, &file);
+        return LFS_ERR_CORRUPT;
+      }
+    }
+    _Bench_lap(b);
+  }
+  err = lfs_file_close(&b->lfs, &file);
+  if (err < 0)
+  {
+    return err;
+  }
+  _Bench_stop(b, res, 1, LFS_BENCH_LARGE_FILE_SZ);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Read of the latency workload. The read arrives at arrival_ns of model time, its latency
+               ends when the data are read.
+
+  Parameters: b          - benchmark context
+              res        - result
+              async      - erases run in the erase engine
+              arrival_ns - arrival time of the read
+              addr       - flash address
+              p_sum_ns   - sum of latencies, updated
+
+  Return: 0 on success, error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Bench_latency_read(T_lfs_bench_ctx *b, T_lfs_bench_latency *res, bool async, uint64_t arrival_ns, uint32_t addr, uint64_t *p_sum_ns)
+{
+  uint64_t lat_ns;
+  int      err = 0;
+
+  if (async)
+  {
+    err = Lfs_erase_read_begin(&b->erase, addr, LFS_BENCH_LAT_READ_SZ);
+  }
+  if (err == 0)
+  {
+    err = Nor_model_read(&b->nor, addr, b->io, LFS_BENCH_LAT_READ_SZ);
+  }
+  if (async)
+  {
+    int end_err = Lfs_erase_read_end(&b->erase);
+    if (err == 0)
+    {
+      err = end_err;
+    }
+  }
+
+  lat_ns     = b->nor.busy_ns - arrival_ns;
+  *p_sum_ns += lat_ns;
+  if (lat_ns / 1000 > res->worst_us)
+  {
+    res->worst_us = (uint32_t)(lat_ns / 1000);
+  }
+  res->reads++;
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Erase LFS_BENCH_LAT_ERASES sectors while reads of the other sectors arrive at random
+               intervals, the time is the model time. Blocking erases hold every read that arrives
+               during them until their end. With the erase engine a read waits for the spacing of
+               suspends and the suspend latency only. The workload runs on the unmounted model.
+
+  Parameters: b     - benchmark context
+              async - 0 - blocking erases, 1 - erase engine
+              res   - result
+
+  Return: 0 on success, error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Bench_read_latency(T_lfs_bench_ctx *b, bool async, T_lfs_bench_latency *res)
+{
+  uint32_t seed   = 12345;
+  uint32_t issued = 0;
+  uint64_t sum_ns = 0;
+  uint64_t next_ns;
+  uint32_t addr;
+  int      err    = 0;
+
+  b->erase_dev.start        = Nor_model_erase_start;
+  b->erase_dev.busy         = Nor_model_erase_busy;
+  b->erase_dev.suspend      = Nor_model_erase_suspend;
+  b->erase_dev.resume       = Nor_model_erase_resume;
+  b->erase_dev.wait         = Nor_model_wait;
+  b->erase_dev.clock        = Nor_model_clock_us;
+  b->erase_dev.done         = NULL;
+  b->erase_dev.clock_per_us = 1;
+  b->erase_dev.ctx          = &b->nor;
+  Lfs_erase_init(&b->erase, &b->erase_dev);
+  Nor_model_reset_stats(&b->nor);
+  memset(res, 0, sizeof(*res));
+
+  next_ns = 0;
+  while ((err == 0) && ((issued < LFS_BENCH_LAT_ERASES) || (b->erase.count > 0) || (b->nor.busy_ns >= next_ns)))
+  {
+    if (b->nor.busy_ns >= next_ns)
+    {
+      // Reads go to the sectors behind the erased ones
+      seed     = seed * 1103515245u + 12345u;
+      addr     = (LFS_BENCH_LAT_ERASES + (seed >> 16) % (LFS_BENCH_BLOCK_COUNT - LFS_BENCH_LAT_ERASES)) * LITTLEFS_BLOCK_SIZE;
+      err      = _Bench_latency_read(b, res, async, next_ns, addr, &sum_ns);
+      seed     = seed * 1103515245u + 12345u;
+      next_ns += 1000ull * (10 + (seed >> 16) % (2 * LFS_BENCH_LAT_PERIOD_US - 19));
+    }
+    else if (!async)
+    {
+      if (issued < LFS_BENCH_LAT_ERASES)
+      {
+        err = Nor_model_erase(&b->nor, issued * LITTLEFS_BLOCK_SIZE, LITTLEFS_BLOCK_SIZE);
+        issued++;
+      }
+    }
+    else if ((issued < LFS_BENCH_LAT_ERASES) && (b->erase.count < LFS_ERASE_QUEUE_LEN))
+    {
+      err = Lfs_erase_queue(&b->erase, issued * LITTLEFS_BLOCK_SIZE, LITTLEFS_BLOCK_SIZE);
+      issued++;
+    }
+    else
+    {
+      // Idle until the next read or the next status poll
+      err = Lfs_erase_poll(&b->erase);
+      if (next_ns - b->nor.busy_ns < b->nor.timing.wait_ns)
+      {
+        b->nor.busy_ns = next_ns;
+      }
+      else
+      {
+        Nor_model_wait(&b->nor);
+      }
+    }
+  }
+
+  res->erase_us = (uint32_t)(b->nor.busy_ns / 1000);
+  res->suspends = b->nor.suspends;
+  if (res->reads != 0)
+  {
+    res->avg_us = (uint32_t)(sum_ns / res->reads / 1000);
+  }
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Append LFS_BENCH_LOG_RECORDS records of LFS_BENCH_LOG_RECORD_SZ bytes to a log file,
+               every record is synced like a log entry that must survive a reset
+
+  Parameters: b   - benchmark context
+              res - result, files is the number of records
+
+  Return: 0 on success, LittleFS error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Bench_log_append(T_lfs_bench_ctx *b, T_lfs_bench_result *res)
+{
+  lfs_file_t  file;
+  lfs_ssize_t wr;
+  int         err;
+
+  _Bench_start(b);
+  err = lfs_file_open(&b->lfs, &file, "/log.txt", LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND);
+  if (err < 0)
+  {
+    return err;
+  }
+  for (uint32_t n = 0; n < LFS_BENCH_LOG_RECORDS; n++)
+  {
+    for (uint32_t i = 0; i < LFS_BENCH_LOG_RECORD_SZ; i++)
+    {
+      b->io[i] = _Bench_pattern(n, i);
+    }
+    wr  = lfs_file_write(&b->lfs, &file, b->io, LFS_BENCH_LOG_RECORD_SZ);
+    err = lfs_file_sync(&b->lfs, &file);
+    if ((wr != LFS_BENCH_LOG_RECORD_SZ) || (err < 0))
+    {
+      lfs_file_close(&b->lfs, &file);
+      return (wr < 0) ? (int)wr : ((err < 0) ? err : LFS_ERR_IO);
+    }
+    _Bench_lap(b);
+  }
+  err = lfs_file_close(&b->lfs, &file);
+  if (err < 0)
+  {
+    return err;
+  }
+  _Bench_stop(b, res, LFS_BENCH_LOG_RECORDS, LFS_BENCH_LOG_RECORDS * LFS_BENCH_LOG_RECORD_SZ);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Rewrite LFS_BENCH_RW_FILES files of LFS_BENCH_RW_FILE_SZ bytes LFS_BENCH_RW_ROUNDS times,
+               like parameter files saved on every change. The last version is verified.
+
+  Parameters: b   - benchmark context
+              res - result, files is the number of rewrites
+
+  Return: 0 on success, LittleFS error code on failure, LFS_ERR_CORRUPT on data mismatch
+-----------------------------------------------------------------------------------------------------*/
+static int _Bench_rewrite(T_lfs_bench_ctx *b, T_lfs_bench_result *res)
+{
+  lfs_file_t  file;
+  char        name[16];
+  lfs_ssize_t sz;
+  int         err;
+
+  _Bench_start(b);
+  for (uint32_t r = 0; r < LFS_BENCH_RW_ROUNDS; r++)
+  {
+    for (uint32_t n = 0; n < LFS_BENCH_RW_FILES; n++)
+    {
+      for (uint32_t i = 0; i < LFS_BENCH_RW_FILE_SZ; i++)
+      {
+        b->io[i] = _Bench_pattern(n + r, i);
+      }
+      snprintf(name, sizeof(name), "/p%02u.cfg", (unsigned int)n);
+      err = lfs_file_open(&b->lfs, &file, name, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
+      if (err < 0)
+      {
+        return err;
+      }
+      sz  = lfs_file_write(&b->lfs, &file, b->io, LFS_BENCH_RW_FILE_SZ);
+      err = lfs_file_close(&b->lfs, &file);
+      if (sz != LFS_BENCH_RW_FILE_SZ)
+      {
+        return (sz < 0) ? (int)sz : LFS_ERR_IO;
+      }
+      if (err < 0)
+      {
+        return err;
+      }
+      _Bench_lap(b);
+    }
+  }
+  _Bench_stop(b, res, LFS_BENCH_RW_ROUNDS * LFS_BENCH_RW_FILES, LFS_BENCH_RW_ROUNDS * LFS_BENCH_RW_FILES * LFS_BENCH_RW_FILE_SZ);
+
+  for (uint32_t n = 0; n < LFS_BENCH_RW_FILES; n++)
+  {
+    snprintf(name, sizeof(name), "/p%02u.cfg", (unsigned int)n);
+    err = lfs_file_open(&b->lfs, &file, name, LFS_O_RDONLY);
+    if (err < 0)
+    {
+      return err;
+    }
+    sz  = lfs_file_read(&b->lfs, &file, b->io, LFS_BENCH_IO_CHUNK);
+    err = lfs_file_close(&b->lfs, &file);
+    if (sz != LFS_BENCH_RW_FILE_SZ)
+    {
+      return (sz < 0) ? (int)sz : LFS_ERR_CORRUPT;
+    }
+    if (err < 0)
+    {
+      return err;
+    }
+    for (uint32_t i = 0; i < LFS_BENCH_RW_FILE_SZ; i++)
+    {
+      if (b->io[i] != _Bench_pattern(n + LFS_BENCH_RW_ROUNDS - 1, i))
+      {
+        return LFS_ERR_CORRUPT;
+      }
+    }
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Create LFS_BENCH_DIR_FILES empty files in a directory, then list the directory
+               LFS_BENCH_DIR_SCANS times. Only the listing is measured.
+
+  Parameters: b   - benchmark context
+              res - result, files is the number of directory entries read
+
+  Return: 0 on success, LittleFS error code on failure, LFS_ERR_CORRUPT if an entry is missing
+-----------------------------------------------------------------------------------------------------*/
+static int _Bench_dir_scan(T_lfs_bench_ctx *b, T_lfs_bench_result *res)
+{
+  lfs_file_t      file;
+  lfs_dir_t       dir;
+  struct lfs_info info;
+  char            name[24];
+  uint32_t        entries = 0;
+  uint32_t        found;
+  int             err;
+
+  err = lfs_mkdir(&b->lfs, "/dir");
+  if (err < 0)
+  {
+    return err;
+  }
+  for (uint32_t n = 0; n < LFS_BENCH_DIR_FILES; n++)
+  {
+    snprintf(name, sizeof(name), "/dir/f%03u.dat", (unsigned int)n);
+    err = lfs_file_open(&b->lfs, &file, name, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
+    if (err < 0)
+    {
+      return err;
+    }
+    err = lfs_file_close(&b->lfs, &file);
+    if (err < 0)
+    {
+      return err;
+    }
+  }
+
+  _Bench_start(b);
+  for (uint32_t s = 0; s < LFS_BENCH_DIR_SCANS; s++)
+  {
+    err = lfs_dir_open(&b->lfs, &dir, "/dir");
+    if (err < 0)
+    {
+      return err;
+    }
+    found = 0;
+    while ((err = lfs_dir_read(&b->lfs, &dir, &info)) > 0)
+    {
+      if (info.type == LFS_TYPE_REG)
+      {
+        found++;
+      }
+      entries++;
+    }
+    lfs_dir_close(&b->lfs, &dir);
+    if (err < 0)
+    {
+      return err;
+    }
+    if (found != LFS_BENCH_DIR_FILES)
+    {
+      return LFS_ERR_CORRUPT;
+    }
+    _Bench_lap(b);
+  }
+  _Bench_stop(b, res, entries, 0);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Allocate the benchmark context and the RAM flash model, set up the block device and the
+               LittleFS configuration for a geometry
+
+  Parameters: p_b        - allocated context
+              p_mem      - allocated model memory
+              page_cache - page size of the block device cache, 0 - cache is disabled
+              geo        - LittleFS geometry
+
+  Return: 0 on success, LFS_ERR_NOMEM if the memory pool is exhausted
+-----------------------------------------------------------------------------------------------------*/
+static int _Bench_setup(T_lfs_bench_ctx **p_b, uint8_t **p_mem, uint32_t page_cache, const T_littlefs_geometry *geo)
+{
+  T_lfs_bench_ctx *b;
+  uint8_t         *mem;
+
+  b   = App_malloc_pending(sizeof(T_lfs_bench_ctx), 10);
+  mem = App_malloc_pending(LFS_BENCH_BLOCK_COUNT * LITTLEFS_BLOCK_SIZE, 10);
+  if ((b == NULL) || (mem == NULL))
+  {
+    App_free(b);
+    App_free(mem);
+    return LFS_ERR_NOMEM;
+  }
+  memset(b, 0, sizeof(*b));
+
+  // Sector erase of the flash matches the LittleFS block, page program covers LITTLEFS_PAGE_SIZE bytes
+  Nor_model_init(&b->nor, mem, LFS_BENCH_BLOCK_COUNT * LITTLEFS_BLOCK_SIZE, LITTLEFS_PAGE_SIZE, LITTLEFS_BLOCK_SIZE, &g_nor_timing_mx25um);
+  b->dev.read  = Nor_model_read;
+  b->dev.prog  = Nor_model_prog;
+  b->dev.erase = Nor_model_erase;
+  b->dev.ctx   = &b->nor;
+  Lfs_bd_init(&b->bd, &b->dev, b->page, page_cache);
+
+  // Only the number of blocks differs from the OSPI file system
+  b->cfg.context          = &b->bd;
+  b->cfg.read             = _lfs_read;
+  b->cfg.prog             = _lfs_prog;
+  b->cfg.erase            = _lfs_erase;
+  b->cfg.sync             = _lfs_sync;
+  b->cfg.read_size        = geo->read_size;
+  b->cfg.prog_size        = geo->prog_size;
+  b->cfg.block_size       = LITTLEFS_BLOCK_SIZE;
+  b->cfg.block_count      = LFS_BENCH_BLOCK_COUNT;
+  b->cfg.cache_size       = geo->cache_size;
+  b->cfg.lookahead_size   = geo->lookahead_size;
+  b->cfg.block_cycles     = (int32_t)geo->block_cycles;
+  b->cfg.read_buffer      = b->read_buffer;
+  b->cfg.prog_buffer      = b->prog_buffer;
+  b->cfg.lookahead_buffer = b->lookahead_buffer;
+
+  *p_b   = b;
+  *p_mem = mem;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Format a RAM flash model and run the small-file and large-file workloads on it with the
+               geometry of the OSPI file system. The memory for the model is taken from the application
+               pool and released at the end.
+
+  Parameters: page_cache - page size of the block device cache, 0 - cache is disabled
+              rep        - report
+
+  Return: 0 on success, LittleFS error code on failure
+-----------------------------------------------------------------------------------------------------*/
+int Littlefs_bench_run(uint32_t page_cache, T_lfs_bench_report *rep)
+{
+  T_lfs_bench_ctx *b;
+  uint8_t         *mem;
+  int              err;
+
+  memset(rep, 0, sizeof(*rep));
+  if (page_cache > LITTLEFS_PAGE_SIZE)
+  {
+    page_cache = LITTLEFS_PAGE_SIZE;
+  }
+  rep->page_cache = page_cache;
+
+  err = _Bench_setup(&b, &mem, page_cache, &g_littlefs_geometry);
+  if (err != 0)
+  {
+    return err;
+  }
+
+  err = lfs_format(&b->lfs, &b->cfg);
+  if (err == 0)
+  {
+    err = lfs_mount(&b->lfs, &b->cfg);
+    if (err == 0)
+    {
+      err = _Bench_small_write(b, &rep->small_write);
+      if (err == 0)
+      {
+        err = _Bench_small_read(b, &rep->small_read);
+      }
+      if (err == 0)
+      {
+        err = _Bench_large_write(b, &rep->large_write);
+      }
+      if (err == 0)
+      {
+        err = _Bench_large_read(b, &rep->large_read);
+      }
+      lfs_unmount(&b->lfs);
+    }
+  }
+  if (err == 0)
+  {
+    err = _Bench_read_latency(b, false, &rep->erase_sync);
+  }
+  if (err == 0)
+  {
+    err = _Bench_read_latency(b, true, &rep->erase_async);
+  }
+
+  if ((err == 0) && (b->nor.violations != 0))
+  {
+    err = LFS_ERR_CORRUPT;
+  }
+
+  App_free(mem);
+  App_free(b);
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Format a RAM flash model with a geometry profile and run the log append, small-file
+               rewrite and directory scan workloads on it. The block device cache is enabled.
+
+  Parameters: geo - LittleFS geometry
+              rep - report
+
+  Return: 0 on success, LittleFS error code on failure
+-----------------------------------------------------------------------------------------------------*/
+int Littlefs_bench_profile(const T_littlefs_geometry *geo, T_lfs_bench_geo_report *rep)
+{
+  T_lfs_bench_ctx *b;
+  uint8_t         *mem;
+  int              err;
+
+  memset(rep, 0, sizeof(*rep));
+  rep->geo = geo;
+  if ((geo->cache_size > LITTLEFS_MAX_CACHE_SIZE) || (geo->lookahead_size > LITTLEFS_MAX_LOOKAHEAD_SIZE))
+  {
+    return LFS_ERR_INVAL;
+  }
+
+  err = _Bench_setup(&b, &mem, LITTLEFS_PAGE_SIZE, geo);
+  if (err != 0)
+  {
+    return err;
+  }
+
+  err = lfs_format(&b->lfs, &b->cfg);
+  if (err == 0)
+  {
+    err = lfs_mount(&b->lfs, &b->cfg);
+    if (err == 0)
+    {
+      err = _Bench_log_append(b, &rep->log_append);
+      if (err == 0)
+      {
+        err = _Bench_rewrite(b, &rep->rewrite);
+      }
+      if (err == 0)
+      {
+        err = _Bench_dir_scan(b, &rep->dir_scan);
+      }
+      lfs_unmount(&b->lfs);
+    }
+  }
+
+  if ((err == 0) && (b->nor.violations != 0))
+  {
+    err = LFS_ERR_CORRUPT;
+  }
+
+  App_free(mem);
+  App_free(b);
+  return err;
+}
@@ -0,0 +1,101 @@
+#ifndef LITTLEFS_BENCH_H
+#define LITTLEFS_BENCH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// LittleFS benchmark over a RAM NOR flash model with MX25UM25645G program/erase timing.
+// The real OSPI flash is not touched. Time of a workload is the measured CPU time of LittleFS and the
+// block device layer plus the modeled device time.
+// The read latency workload erases sectors while reads of other sectors arrive at random intervals,
+// once with blocking erases and once with the background erase engine that suspends the erase for a read.
+// The profile workloads compare the geometry profiles of littlefs_adapter.h on log appends, rewrites of
+// small files and directory listings.
+
+// Cycle counter that times the CPU part of the workloads
+#ifndef LFS_BENCH_CYCLES
+  #define LFS_BENCH_CYCLES()       CYCLE_PROFILER_NOW()
+  #define LFS_BENCH_CYCLES_PER_US  FRQ_CPUCLK_MHZ
+#endif
+
+#define LFS_BENCH_BLOCK_COUNT      32            // Model size is LFS_BENCH_BLOCK_COUNT * LITTLEFS_BLOCK_SIZE
+#define LFS_BENCH_SMALL_FILES      64
+#define LFS_BENCH_SMALL_FILE_SZ    256
+#define LFS_BENCH_LARGE_FILE_SZ    (48 * 1024)
+#define LFS_BENCH_IO_CHUNK         1024          // Size of one read or write call for the large file
+#define LFS_BENCH_LAT_ERASES       8             // Sectors erased by the read latency workload
+#define LFS_BENCH_LAT_READ_SZ      256
+#define LFS_BENCH_LAT_PERIOD_US    1000          // Mean interval between reads, the interval is random in 10..1990 us
+#define LFS_BENCH_LOG_RECORDS      256           // Records appended and synced one by one
+#define LFS_BENCH_LOG_RECORD_SZ    64
+#define LFS_BENCH_RW_FILES         8             // Files rewritten LFS_BENCH_RW_ROUNDS times each
+#define LFS_BENCH_RW_FILE_SZ       128
+#define LFS_BENCH_RW_ROUNDS        32
+#define LFS_BENCH_DIR_FILES        32            // Files in the listed directory
+#define LFS_BENCH_DIR_SCANS        16
+
+typedef struct
+{
+  const char *name;
+  uint32_t    read_size;
+  uint32_t    prog_size;
+  uint32_t    cache_size;
+  uint32_t    lookahead_size;
+  uint32_t    block_cycles;
+} T_littlefs_geometry;
+
+typedef struct
+{
+  uint32_t files;         // Files or operations processed
+  uint32_t bytes;         // Payload bytes
+  uint32_t cpu_us;        // CPU time of LittleFS and block device layer
+  uint32_t dev_us;        // Modeled flash time
+  uint32_t files_per_s;
+  uint32_t bytes_per_s;
+  uint32_t dev_progs;     // Program commands sent to the flash
+  uint32_t dev_erases;    // Erased sectors
+  uint32_t prog_bytes;    // Bytes programmed to the flash
+} T_lfs_bench_result;
+
+typedef struct
+{
+  uint32_t reads;         // Reads made while the erases ran
+  uint32_t worst_us;      // Longest time from the arrival of a read until its data are read, modeled
+  uint32_t avg_us;
+  uint32_t erase_us;      // Time until all erases ended, modeled
+  uint32_t suspends;      // Erase suspends for reads
+} T_lfs_bench_latency;
+
+typedef struct
+{
+  uint32_t            page_cache;   // Page size of the block device cache, 0 - programs go to the flash directly
+  T_lfs_bench_result  small_write;
+  T_lfs_bench_result  small_read;
+  T_lfs_bench_result  large_write;
+  T_lfs_bench_result  large_read;
+  T_lfs_bench_latency erase_sync;   // Reads wait for the end of the erase
+  T_lfs_bench_latency erase_async;  // Reads suspend the erase
+} T_lfs_bench_report;
+
+typedef struct
+{
+  const T_littlefs_geometry *geo;
+  T_lfs_bench_result         log_append;  // files - records appended
+  T_lfs_bench_result         rewrite;     // files - files rewritten
+  T_lfs_bench_result         dir_scan;    // files - directory entries read
+} T_lfs_bench_geo_report;
+
+extern const T_littlefs_geometry g_littlefs_profiles[LITTLEFS_PROFILE_COUNT];
+extern const T_littlefs_geometry g_littlefs_geometry;
+
+int Littlefs_bench_run(uint32_t page_cache, T_lfs_bench_report *rep);
+int Littlefs_bench_profile(const T_littlefs_geometry *geo, T_lfs_bench_geo_report *rep);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LITTLEFS_BENCH_H
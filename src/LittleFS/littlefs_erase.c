@@ -0,0 +1,319 @@
+/*-----------------------------------------------------------------------------------------------------
+  Description: Background flash erase with erase suspend for reads
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+
+#include "App.h"
+#include "littlefs_erase.h"
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Keep the first error until it is returned by an API call
+
+  Parameters: e   - engine instance
+              err - error code
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Lfs_erase_fail(T_lfs_erase *e, int err)
+{
+  if ((e->err == 0) && (err != 0))
+  {
+    e->err = err;
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Return the kept error and clear it
+
+  Parameters: e - engine instance
+
+  Return: 0 or the first error since the previous call
+-----------------------------------------------------------------------------------------------------*/
+static int _Lfs_erase_take_err(T_lfs_erase *e)
+{
+  int err = e->err;
+
+  e->err  = 0;
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Remove the erase at the head of the queue and report its end
+
+  Parameters: e   - engine instance
+              err - result of the erase
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Lfs_erase_complete(T_lfs_erase *e, int err)
+{
+  T_lfs_erase_req req = e->queue[e->head];
+
+  e->head  = (e->head + 1) % LFS_ERASE_QUEUE_LEN;
+  e->count--;
+  e->state = LFS_ERASE_IDLE;
+  e->stats.done++;
+  _Lfs_erase_fail(e, err);
+  if (e->dev->done != NULL)
+  {
+    e->dev->done(e->dev->ctx, req.addr, req.size, err);
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Poll the running erase and complete it when the flash is ready
+
+  Parameters: e - engine instance
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Lfs_erase_check(T_lfs_erase *e)
+{
+  int busy;
+
+  if (e->state != LFS_ERASE_RUNNING)
+  {
+    return;
+  }
+  busy = e->dev->busy(e->dev->ctx);
+  if (busy <= 0)
+  {
+    _Lfs_erase_complete(e, busy);
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Start the erase at the head of the queue if the flash is idle
+
+  Parameters: e - engine instance
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Lfs_erase_start_next(T_lfs_erase *e)
+{
+  int err;
+
+  while ((e->state == LFS_ERASE_IDLE) && (e->count > 0))
+  {
+    err = e->dev->start(e->dev->ctx, e->queue[e->head].addr, e->queue[e->head].size);
+    if (err != 0)
+    {
+      _Lfs_erase_complete(e, err);
+      continue;
+    }
+    e->state     = LFS_ERASE_RUNNING;
+    e->run_clock = e->dev->clock(e->dev->ctx);
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Resume the suspended erase
+
+  Parameters: e - engine instance
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Lfs_erase_resume(T_lfs_erase *e)
+{
+  _Lfs_erase_fail(e, e->dev->resume(e->dev->ctx));
+  e->state     = LFS_ERASE_RUNNING;
+  e->run_clock = e->dev->clock(e->dev->ctx);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Wait for the end of the erase at the head of the queue
+
+  Parameters: e - engine instance
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Lfs_erase_wait_head(T_lfs_erase *e)
+{
+  uint32_t done = e->stats.done;
+
+  if (e->state == LFS_ERASE_SUSPENDED)
+  {
+    _Lfs_erase_resume(e);
+  }
+  _Lfs_erase_start_next(e);
+  _Lfs_erase_check(e);
+  while ((e->count > 0) && (e->stats.done == done))
+  {
+    e->dev->wait(e->dev->ctx);
+    _Lfs_erase_check(e);
+  }
+  _Lfs_erase_start_next(e);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Check if a range overlaps an erase in the queue
+
+  Parameters: e    - engine instance
+              addr - flash address
+              size - number of bytes
+
+  Return: true if a part of the range is waiting for erase or being erased
+-----------------------------------------------------------------------------------------------------*/
+static bool _Lfs_erase_overlaps(const T_lfs_erase *e, uint32_t addr, uint32_t size)
+{
+  for (uint32_t i = 0; i < e->count; i++)
+  {
+    const T_lfs_erase_req *req = &e->queue[(e->head + i) % LFS_ERASE_QUEUE_LEN];
+    if ((addr < req->addr + req->size) && (req->addr < addr + size))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Initialize the engine
+
+  Parameters: e   - engine instance
+              dev - flash device operations
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void Lfs_erase_init(T_lfs_erase *e, const T_lfs_erase_dev *dev)
+{
+  memset(e, 0, sizeof(*e));
+  e->dev = dev;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Queue an erase. It is started at once if the flash is idle, otherwise when the erases
+               queued before it have ended. When the queue is full the oldest erase is waited for.
+
+  Parameters: e    - engine instance
+              addr - flash address, aligned to the erase size
+              size - erase size supported by the device
+
+  Return: 0 on success, first error of the engine since the previous call
+-----------------------------------------------------------------------------------------------------*/
+int Lfs_erase_queue(T_lfs_erase *e, uint32_t addr, uint32_t size)
+{
+  T_lfs_erase_req *req;
+
+  _Lfs_erase_check(e);
+  while (e->count == LFS_ERASE_QUEUE_LEN)
+  {
+    _Lfs_erase_wait_head(e);
+  }
+  req       = &e->queue[(e->head + e->count) % LFS_ERASE_QUEUE_LEN];
+  req->addr = addr;
+  req->size = size;
+  e->count++;
+  e->stats.queued++;
+  _Lfs_erase_start_next(e);
+  return _Lfs_erase_take_err(e);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Complete an ended erase and start the next one. Called by the engine on every access,
+               a thread can call it periodically to get the end of erases reported without accesses.
+
+  Parameters: e - engine instance
+
+  Return: 0 on success, first error of the engine since the previous call
+-----------------------------------------------------------------------------------------------------*/
+int Lfs_erase_poll(T_lfs_erase *e)
+{
+  _Lfs_erase_check(e);
+  _Lfs_erase_start_next(e);
+  return _Lfs_erase_take_err(e);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Make the flash readable for a range. A running erase is suspended, the suspend waits
+               until LFS_ERASE_MIN_RUN_US have passed since the erase was started or resumed.
+               The next erase in the queue is not started before Lfs_erase_read_end.
+
+  Parameters: e    - engine instance
+              addr - flash address of the read
+              size - number of bytes
+
+  Return: 0 on success, first error of the engine since the previous call
+-----------------------------------------------------------------------------------------------------*/
+int Lfs_erase_read_begin(T_lfs_erase *e, uint32_t addr, uint32_t size)
+{
+  uint32_t min_run = LFS_ERASE_MIN_RUN_US * e->dev->clock_per_us;
+  int      err;
+
+  _Lfs_erase_check(e);
+  if (_Lfs_erase_overlaps(e, addr, size))
+  {
+    e->stats.read_waits++;
+    while (_Lfs_erase_overlaps(e, addr, size))
+    {
+      _Lfs_erase_wait_head(e);
+    }
+  }
+
+  if ((e->state == LFS_ERASE_RUNNING) && ((uint32_t)(e->dev->clock(e->dev->ctx) - e->run_clock) <= min_run))
+  {
+    e->stats.spacing_waits++;
+    while ((e->state == LFS_ERASE_RUNNING) && ((uint32_t)(e->dev->clock(e->dev->ctx) - e->run_clock) <= min_run))
+    {
+      _Lfs_erase_check(e);
+    }
+  }
+
+  if (e->state == LFS_ERASE_RUNNING)
+  {
+    err = e->dev->suspend(e->dev->ctx);
+    if (err != 0)
+    {
+      // The flash can not be read during the erase, wait for its end
+      _Lfs_erase_fail(e, err);
+      while ((e->state == LFS_ERASE_RUNNING) && (e->count > 0))
+      {
+        e->dev->wait(e->dev->ctx);
+        _Lfs_erase_check(e);
+      }
+    }
+    else
+    {
+      e->state = LFS_ERASE_SUSPENDED;
+      e->stats.suspends++;
+    }
+  }
+  return _Lfs_erase_take_err(e);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: End of a read started by Lfs_erase_read_begin. The suspended erase is resumed.
+
+  Parameters: e - engine instance
+
+  Return: 0 on success, first error of the engine since the previous call
+-----------------------------------------------------------------------------------------------------*/
+int Lfs_erase_read_end(T_lfs_erase *e)
+{
+  if (e->state == LFS_ERASE_SUSPENDED)
+  {
+    _Lfs_erase_resume(e);
+  }
+  _Lfs_erase_start_next(e);
+  return _Lfs_erase_take_err(e);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Wait until all queued erases have ended. Called before a program and before the flash
+               is used by anything that does not go through the engine.
+
+  Parameters: e - engine instance
+
+  Return: 0 on success, first error of the engine since the previous call
+-----------------------------------------------------------------------------------------------------*/
+int Lfs_erase_sync(T_lfs_erase *e)
+{
+  while (e->count > 0)
+  {
+    _Lfs_erase_wait_head(e);
+  }
+  return _Lfs_erase_take_err(e);
+}
@@ -0,0 +1,79 @@
+#ifndef LITTLEFS_ERASE_H
+#define LITTLEFS_ERASE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Background erase engine. An erase is queued and started on the flash without waiting for its end.
+// A read brackets its access with Lfs_erase_read_begin/Lfs_erase_read_end: the running erase is suspended
+// for the read and resumed after it, so the read waits for the suspend latency instead of the whole erase.
+// A read that touches a sector in the queue waits until this sector is erased.
+// The end of an erase is found by polling the device status, every call of the engine polls it.
+// The engine is not thread safe, all calls are made from the thread that owns the flash.
+
+#define LFS_ERASE_QUEUE_LEN   4
+#define LFS_ERASE_MIN_RUN_US  400  // Erase time the flash needs between a resume and the next suspend
+
+// Flash device operations. The functions return 0 on success.
+typedef struct
+{
+  int      (*start)(void *ctx, uint32_t addr, uint32_t size);  // Send the erase command, do not wait
+  int      (*busy)(void *ctx);                                 // 1 - erase is running, 0 - ended, < 0 - error
+  int      (*suspend)(void *ctx);                              // Suspend the erase, return when reads are possible
+  int      (*resume)(void *ctx);
+  void     (*wait)(void *ctx);                                 // Let time pass while the engine waits for the end of an erase
+  uint32_t (*clock)(void *ctx);                                // Free running counter for the spacing of suspends
+  void     (*done)(void *ctx, uint32_t addr, uint32_t size, int err);  // End of an erase, can be NULL
+  uint32_t clock_per_us;
+  void    *ctx;
+} T_lfs_erase_dev;
+
+typedef enum
+{
+  LFS_ERASE_IDLE,
+  LFS_ERASE_RUNNING,
+  LFS_ERASE_SUSPENDED,
+} T_lfs_erase_state;
+
+typedef struct
+{
+  uint32_t queued;
+  uint32_t done;
+  uint32_t suspends;
+  uint32_t spacing_waits;  // Suspends delayed by LFS_ERASE_MIN_RUN_US after a resume
+  uint32_t read_waits;     // Reads that waited for the end of an erase of their range
+} T_lfs_erase_stats;
+
+typedef struct
+{
+  uint32_t addr;
+  uint32_t size;
+} T_lfs_erase_req;
+
+typedef struct
+{
+  const T_lfs_erase_dev *dev;
+  T_lfs_erase_req        queue[LFS_ERASE_QUEUE_LEN];
+  uint32_t               head;       // queue[head] is the erase on the flash unless state is LFS_ERASE_IDLE
+  uint32_t               count;
+  T_lfs_erase_state      state;
+  uint32_t               run_clock;  // Clock at the last start or resume
+  int                    err;        // First error, returned by the next call
+  T_lfs_erase_stats      stats;
+} T_lfs_erase;
+
+void Lfs_erase_init(T_lfs_erase *e, const T_lfs_erase_dev *dev);
+int  Lfs_erase_queue(T_lfs_erase *e, uint32_t addr, uint32_t size);
+int  Lfs_erase_poll(T_lfs_erase *e);
+int  Lfs_erase_read_begin(T_lfs_erase *e, uint32_t addr, uint32_t size);
+int  Lfs_erase_read_end(T_lfs_erase *e);
+int  Lfs_erase_sync(T_lfs_erase *e);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LITTLEFS_ERASE_H
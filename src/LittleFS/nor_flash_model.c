@@ -0,0 +1,562 @@
+/*-----------------------------------------------------------------------------------------------------
+  Description: RAM-backed NOR flash model with program/erase timing
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+
+#include "App.h"
+#include "nor_flash_model.h"
+
+// Typical values of MX25UM25645G in 8D-8D-8D mode at 200 MHz
+const T_nor_timing g_nor_timing_mx25um = {
+  .prog_cmd_ns  = 20000,     // 256 byte page is programmed in about 150 us
+  .prog_byte_ns = 500,
+  .erase_ns     = 25000000,  // 4 KB sector erase
+  .read_cmd_ns  = 200,
+  .read_byte_ns = 3,         // 400 MB/s
+  .status_ns    = 500,
+  .suspend_ns   = 20000,     // Erase suspend latency
+  .min_run_ns   = 400000,    // Resume to next suspend
+  .wait_ns      = 10000,
+};
+
+static void     _Nor_model_erase_update(T_nor_model *m);
+static void     _Nor_model_check_access(T_nor_model *m, uint32_t addr, uint32_t size, bool is_read);
+static uint32_t _Nor_model_rand(T_nor_model *m);
+static int      _Nor_model_power_step(T_nor_model *m);
+static uint32_t _Nor_model_erase_count(T_nor_model *m, uint32_t addr, uint32_t size);
+static void     _Nor_model_erase_torn(T_nor_model *m, uint32_t addr, uint8_t level);
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Initialize the flash model. The memory is filled with the erased value.
+
+  Parameters: m           - model instance
+              mem         - memory for the flash image
+              size        - size of the flash image, multiple of sector_size
+              page_size   - program page size
+              sector_size - erase sector size
+              timing      - timing table, NULL - operations take no device time
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void Nor_model_init(T_nor_model *m, uint8_t *mem, uint32_t size, uint32_t page_size, uint32_t sector_size, const T_nor_timing *timing)
+{
+  memset(m, 0, sizeof(*m));
+  m->mem         = mem;
+  m->size        = size;
+  m->page_size   = page_size;
+  m->sector_size = sector_size;
+  m->rng         = 0x2545F491u;
+  if (timing != NULL)
+  {
+    m->timing = *timing;
+  }
+  memset(mem, NOR_MODEL_ERASED_VAL, size);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Clear operation counters and accumulated device time. Violations are kept.
+
+  Parameters: m - model instance
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void Nor_model_reset_stats(T_nor_model *m)
+{
+  // The background erase keeps its remaining time when the clock is restarted
+  if ((m->erase_size != 0) && !m->erase_suspended)
+  {
+    _Nor_model_erase_update(m);
+    if (m->erase_size != 0)
+    {
+      m->erase_left_ns -= m->busy_ns - m->erase_run_ns;
+    }
+  }
+  m->erase_run_ns = 0;
+  m->busy_ns      = 0;
+  m->reads        = 0;
+  m->progs        = 0;
+  m->erases       = 0;
+  m->suspends     = 0;
+  m->read_bytes   = 0;
+  m->prog_bytes   = 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Read from the flash image
+
+  Parameters: ctx  - model instance
+              addr - flash address
+              buf  - destination
+              size - number of bytes
+
+  Return: 0 on success, -1 if the range is outside the device
+-----------------------------------------------------------------------------------------------------*/
+int Nor_model_read(void *ctx, uint32_t addr, void *buf, uint32_t size)
+{
+  T_nor_model *m = (T_nor_model *)ctx;
+
+  if ((addr > m->size) || (size > m->size - addr) || m->power_off)
+  {
+    return -1;
+  }
+  _Nor_model_check_access(m, addr, size, true);
+  memcpy(buf, &m->mem[addr], size);
+  m->reads++;
+  m->read_bytes += size;
+  m->busy_ns    += m->timing.read_cmd_ns + (uint64_t)m->timing.read_byte_ns * size;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Program data. Every page touched by the range costs one program command.
+               Bits can only be cleared, an attempt to set a bit is counted in violations.
+
+  Parameters: ctx  - model instance
+              addr - flash address
+              buf  - source data
+              size - number of bytes
+
+  Return: 0 on success, -1 if the range is outside the device
+-----------------------------------------------------------------------------------------------------*/
+int Nor_model_prog(void *ctx, uint32_t addr, const void *buf, uint32_t size)
+{
+  T_nor_model   *m   = (T_nor_model *)ctx;
+  const uint8_t *src = (const uint8_t *)buf;
+
+  if ((addr > m->size) || (size > m->size - addr) || m->power_off)
+  {
+    return -1;
+  }
+  _Nor_model_check_access(m, addr, size, false);
+
+  while (size > 0)
+  {
+    uint32_t n = m->page_size - (addr % m->page_size);
+    if (n > size)
+    {
+      n = size;
+    }
+    if (_Nor_model_power_step(m) != 0)
+    {
+      // Bytes before the cut are programmed, the byte at the cut is programmed partly
+      uint32_t k = _Nor_model_rand(m) % n;
+      for (uint32_t i = 0; i < k; i++)
+      {
+        m->mem[addr + i] &= src[i];
+      }
+      m->mem[addr + k] &= src[k] | (uint8_t)_Nor_model_rand(m);
+      m->progs++;
+      return -1;
+    }
+    for (uint32_t i = 0; i < n; i++)
+    {
+      if ((src[i] & ~m->mem[addr + i]) != 0)
+      {
+        m->violations++;
+      }
+      m->mem[addr + i] &= src[i];
+    }
+    m->progs++;
+    m->prog_bytes += n;
+    m->busy_ns    += m->timing.prog_cmd_ns + (uint64_t)m->timing.prog_byte_ns * n;
+    addr          += n;
+    src           += n;
+    size          -= n;
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Erase whole sectors
+
+  Parameters: ctx  - model instance
+              addr - flash address, aligned to the sector size
+              size - number of bytes, multiple of the sector size
+
+  Return: 0 on success, -1 on wrong range or alignment or if the power is cut
+-----------------------------------------------------------------------------------------------------*/
+int Nor_model_erase(void *ctx, uint32_t addr, uint32_t size)
+{
+  T_nor_model *m = (T_nor_model *)ctx;
+  uint32_t     n;
+
+  if ((addr > m->size) || (size > m->size - addr) || (addr % m->sector_size) || (size % m->sector_size))
+  {
+    m->violations++;
+    return -1;
+  }
+  if (m->power_off)
+  {
+    return -1;
+  }
+  _Nor_model_check_access(m, addr, size, false);
+  n = _Nor_model_erase_count(m, addr, size);
+  memset(&m->mem[addr], NOR_MODEL_ERASED_VAL, n * m->sector_size);
+  if (n < size / m->sector_size)
+  {
+    // The cut sector is erased for a random part of its time
+    uint8_t level = (uint8_t)_Nor_model_rand(m);
+
+    m->busy_ns += (uint64_t)m->timing.erase_ns * n + ((uint64_t)m->timing.erase_ns * level) / 256;
+    _Nor_model_erase_torn(m, addr + n * m->sector_size, level);
+    return -1;
+  }
+  m->busy_ns += (uint64_t)m->timing.erase_ns * n;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Count the wear of the sectors an erase of a checked range reaches and find the sector
+               during which the power is cut
+
+  Parameters: m    - model instance
+              addr - flash address, aligned to the sector size
+              size - number of bytes, multiple of the sector size
+
+  Return: Number of sectors erased completely, less than size / sector_size if the power is cut
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Nor_model_erase_count(T_nor_model *m, uint32_t addr, uint32_t size)
+{
+  uint32_t n = size / m->sector_size;
+
+  for (uint32_t i = 0; i < n; i++)
+  {
+    if (m->wear != NULL)
+    {
+      m->wear[addr / m->sector_size + i]++;
+    }
+    m->erases++;
+    if ((m->cut_after != 0) && (--m->cut_after == 0))
+    {
+      return i;
+    }
+  }
+  return n;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Cut the power during the erase of a sector. The erase has moved part of the bits towards
+               the erased value, each bit is set with the probability level / 256.
+
+  Parameters: m     - model instance
+              addr  - flash address of the sector
+              level - progress of the sector erase, 0..255
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Nor_model_erase_torn(T_nor_model *m, uint32_t addr, uint8_t level)
+{
+  for (uint32_t i = 0; i < m->sector_size; i++)
+  {
+    uint8_t bits = 0;
+
+    for (uint32_t b = 0; b < 8; b++)
+    {
+      if ((_Nor_model_rand(m) & 0xFF) < level)
+      {
+        bits |= (uint8_t)(1u << b);
+      }
+    }
+    m->mem[addr + i] |= bits;
+  }
+  m->power_off = 1;
+  m->power_cuts++;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Next value of the xorshift generator for torn data
+
+  Parameters: m - model instance
+
+  Return: pseudo random value
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Nor_model_rand(T_nor_model *m)
+{
+  m->rng ^= m->rng << 13;
+  m->rng ^= m->rng >> 17;
+  m->rng ^= m->rng << 5;
+  return m->rng;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Count a page program towards the power cut
+
+  Parameters: m - model instance
+
+  Return: 0 - operation runs normally, 1 - the power is cut during this operation
+-----------------------------------------------------------------------------------------------------*/
+static int _Nor_model_power_step(T_nor_model *m)
+{
+  if ((m->cut_after == 0) || (--m->cut_after != 0))
+  {
+    return 0;
+  }
+  m->power_off = 1;
+  m->power_cuts++;
+  return 1;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Advance the background erase to the device time. Sectors whose share of the erase time
+               has passed are erased, the erase ends with the last one or with the power cut.
+
+  Parameters: m - model instance
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Nor_model_erase_update(T_nor_model *m)
+{
+  uint64_t done_ns;
+
+  if (m->erase_size == 0)
+  {
+    return;
+  }
+  done_ns = m->erase_total_ns - m->erase_left_ns;
+  if (!m->erase_suspended)
+  {
+    done_ns += m->busy_ns - m->erase_run_ns;
+  }
+  while ((m->erase_done < m->erase_size) && ((uint64_t)m->timing.erase_ns * (m->erase_done / m->sector_size + 1) <= done_ns) &&
+         (!m->erase_cut || (m->erase_addr + m->erase_done < m->erase_cut_addr)))
+  {
+    memset(&m->mem[m->erase_addr + m->erase_done], NOR_MODEL_ERASED_VAL, m->sector_size);
+    m->erase_done += m->sector_size;
+  }
+  if (m->erase_cut && (done_ns >= m->erase_cut_ns))
+  {
+    _Nor_model_erase_torn(m, m->erase_cut_addr, m->erase_cut_level);
+    m->erase_size      = 0;
+    m->erase_suspended = 0;
+  }
+  else if (m->erase_done == m->erase_size)
+  {
+    m->erase_size = 0;
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Count an access the device does not accept during the background erase.
+               Only a read outside the erased range while the erase is suspended is allowed.
+
+  Parameters: m       - model instance
+              addr    - flash address
+              size    - number of bytes
+              is_read - access is a read
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Nor_model_check_access(T_nor_model *m, uint32_t addr, uint32_t size, bool is_read)
+{
+  _Nor_model_erase_update(m);
+  if (m->erase_size == 0)
+  {
+    return;
+  }
+  if (!m->erase_suspended || !is_read || ((addr < m->erase_addr + m->erase_size) && (m->erase_addr < addr + size)))
+  {
+    m->violations++;
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Start an erase of whole sectors in the background. The sectors keep their data until
+               their part of the erase time has passed, a read of them before the end of the erase is
+               a violation.
+
+  Parameters: ctx  - model instance
+              addr - flash address, aligned to the sector size
+              size - number of bytes, multiple of the sector size
+
+  Return: 0 on success, -1 on wrong range or alignment or if an erase is already running
+-----------------------------------------------------------------------------------------------------*/
+int Nor_model_erase_start(void *ctx, uint32_t addr, uint32_t size)
+{
+  T_nor_model *m = (T_nor_model *)ctx;
+  uint32_t     n;
+
+  _Nor_model_erase_update(m);
+  if ((addr > m->size) || (size > m->size - addr) || (addr % m->sector_size) || (size % m->sector_size) || (size == 0) ||
+      (m->erase_size != 0))
+  {
+    m->violations++;
+    return -1;
+  }
+  if (m->power_off)
+  {
+    return -1;
+  }
+  n            = _Nor_model_erase_count(m, addr, size);
+  m->erase_cut = (n < size / m->sector_size);
+  if (m->erase_cut)
+  {
+    // The power is cut at a random point of the erase of sector n
+    m->erase_cut_addr  = addr + n * m->sector_size;
+    m->erase_cut_level = (uint8_t)_Nor_model_rand(m);
+    m->erase_cut_ns    = (uint64_t)m->timing.erase_ns * n + ((uint64_t)m->timing.erase_ns * m->erase_cut_level) / 256;
+  }
+  m->busy_ns        += m->timing.status_ns;
+  m->erase_addr      = addr;
+  m->erase_size      = size;
+  m->erase_done      = 0;
+  m->erase_total_ns  = (uint64_t)m->timing.erase_ns * (size / m->sector_size);
+  m->erase_left_ns   = m->erase_total_ns;
+  m->erase_run_ns    = m->busy_ns;
+  m->erase_suspended = 0;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Read the busy status of the device
+
+  Parameters: ctx - model instance
+
+  Return: 1 while the background erase is running, 0 if it has ended or is suspended, -1 if the power is cut
+-----------------------------------------------------------------------------------------------------*/
+int Nor_model_erase_busy(void *ctx)
+{
+  T_nor_model *m = (T_nor_model *)ctx;
+
+  m->busy_ns += m->timing.status_ns;
+  _Nor_model_erase_update(m);
+  if (m->power_off)
+  {
+    return -1;
+  }
+  return ((m->erase_size != 0) && !m->erase_suspended) ? 1 : 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Suspend the background erase, returns when reads are possible.
+               A suspend earlier than min_run_ns after the start or resume is a violation.
+
+  Parameters: ctx - model instance
+
+  Return: 0 on success, -1 if the power is cut
+-----------------------------------------------------------------------------------------------------*/
+int Nor_model_erase_suspend(void *ctx)
+{
+  T_nor_model *m = (T_nor_model *)ctx;
+  uint64_t     run_ns;
+
+  m->busy_ns += m->timing.status_ns;
+  _Nor_model_erase_update(m);
+  if (m->power_off)
+  {
+    return -1;
+  }
+  if ((m->erase_size == 0) || m->erase_suspended)
+  {
+    return 0;
+  }
+  run_ns = m->busy_ns - m->erase_run_ns;
+  if (run_ns < m->timing.min_run_ns)
+  {
+    m->violations++;
+  }
+  m->erase_left_ns   -= run_ns;
+  m->erase_suspended  = 1;
+  m->suspends++;
+  m->busy_ns         += m->timing.suspend_ns;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Resume the suspended background erase
+
+  Parameters: ctx - model instance
+
+  Return: 0 on success, -1 if the power is cut
+-----------------------------------------------------------------------------------------------------*/
+int Nor_model_erase_resume(void *ctx)
+{
+  T_nor_model *m = (T_nor_model *)ctx;
+
+  if (m->power_off)
+  {
+    return -1;
+  }
+  m->busy_ns += m->timing.status_ns;
+  if ((m->erase_size != 0) && m->erase_suspended)
+  {
+    m->erase_suspended = 0;
+    m->erase_run_ns    = m->busy_ns;
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Let wait_ns of device time pass
+
+  Parameters: ctx - model instance
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void Nor_model_wait(void *ctx)
+{
+  T_nor_model *m = (T_nor_model *)ctx;
+
+  m->busy_ns += (m->timing.wait_ns != 0) ? m->timing.wait_ns : 1;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Model clock for the spacing of suspends
+
+  Parameters: ctx - model instance
+
+  Return: busy_ns in microseconds, wraps around
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Nor_model_clock_us(void *ctx)
+{
+  return (uint32_t)(((T_nor_model *)ctx)->busy_ns / 1000);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Attach a table of erase counts per sector, the table is cleared
+
+  Parameters: m    - model instance
+              wear - size / sector_size counters, NULL - erase counts are not kept
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void Nor_model_set_wear(T_nor_model *m, uint32_t *wear)
+{
+  m->wear = wear;
+  if (wear != NULL)
+  {
+    memset(wear, 0, (m->size / m->sector_size) * sizeof(uint32_t));
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Arm the power cut. The power is cut during the ops-th program or erase operation from now,
+               a page program and a sector erase are one operation each.
+
+  Parameters: m   - model instance
+              ops - operation number, 0 - the power is not cut
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void Nor_model_cut_power(T_nor_model *m, uint32_t ops)
+{
+  m->cut_after = ops;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Restore the power after a cut. The image keeps the torn data, a background erase is lost.
+
+  Parameters: m - model instance
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+void Nor_model_power_on(T_nor_model *m)
+{
+  m->power_off       = 0;
+  m->cut_after       = 0;
+  m->erase_size      = 0;
+  m->erase_suspended = 0;
+  m->erase_cut       = 0;
+}
@@ -0,0 +1,95 @@
+#ifndef NOR_FLASH_MODEL_H
+#define NOR_FLASH_MODEL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// RAM-backed model of a NOR flash device used to benchmark file system layers without touching the real OSPI flash.
+// Program operations can only clear bits and do not cross page boundaries, erase works on whole sectors.
+// Device time is not spent, it is accumulated in busy_ns from the timing table.
+// An erase can also run in the background: Nor_model_erase_start returns at once and the erase progresses
+// as busy_ns, advanced by other operations and by Nor_model_wait, passes. A sector reads as erased when
+// its share of the erase time has passed, the erase ends with the last sector. While it runs the device
+// accepts only status, suspend and resume; a read is allowed during a suspend outside the erased range.
+// Any other access is counted in violations.
+// For power loss tests the power can be cut during the Nth program or erase operation: the page program
+// is torn after a random number of bytes, the sector erase is cut at a random point of its time and leaves
+// the sector half erased, more bits set the longer it ran. A background erase is cut when its progress
+// reaches that point, so the cut can come during later operations or waits. After the cut every operation
+// fails until Nor_model_power_on. Erases are counted per sector when a wear table is attached.
+
+#define NOR_MODEL_ERASED_VAL  0xFF
+
+typedef struct
+{
+  uint32_t prog_cmd_ns;   // Fixed cost of a page program command: write enable, command, status polling
+  uint32_t prog_byte_ns;  // Program time per byte
+  uint32_t erase_ns;      // Sector erase time
+  uint32_t read_cmd_ns;   // Fixed cost of a read command
+  uint32_t read_byte_ns;  // Read time per byte
+  uint32_t status_ns;     // Status read, suspend and resume command
+  uint32_t suspend_ns;    // Suspend latency, time from the suspend command until reads are possible
+  uint32_t min_run_ns;    // Erase time needed between a resume and the next suspend
+  uint32_t wait_ns;       // Time passed by one Nor_model_wait
+} T_nor_timing;
+
+typedef struct
+{
+  uint8_t     *mem;
+  uint32_t     size;
+  uint32_t     page_size;        // Program operation is split at page boundaries
+  uint32_t     sector_size;      // Erase granularity
+  T_nor_timing timing;
+  uint64_t     busy_ns;          // Accumulated modeled device time
+  uint32_t     reads;
+  uint32_t     progs;            // Page program commands
+  uint32_t     erases;           // Erased sectors
+  uint32_t     violations;       // Programs that tried to change a bit from 0 to 1 or had wrong alignment, accesses during an erase
+  uint64_t     read_bytes;
+  uint64_t     prog_bytes;
+  uint32_t     erase_addr;       // Range of the background erase, erase_size == 0 - no erase
+  uint32_t     erase_size;
+  uint32_t     erase_done;       // Bytes of the range already erased
+  uint64_t     erase_total_ns;   // Erase time of the whole range
+  uint64_t     erase_left_ns;    // Erase time still needed at erase_run_ns
+  uint64_t     erase_run_ns;     // busy_ns when the erase was started or resumed
+  uint8_t      erase_suspended;
+  uint8_t      erase_cut;        // The power is cut when the erase progress reaches erase_cut_ns, kept until Nor_model_power_on
+  uint8_t      erase_cut_level;  // Progress of the cut sector, 0..255
+  uint32_t     erase_cut_addr;   // Sector being erased at the cut
+  uint64_t     erase_cut_ns;
+  uint32_t     suspends;
+  uint32_t    *wear;             // Erase count per sector, NULL - not kept
+  uint32_t     cut_after;        // Program and erase operations until the power is cut, 0 - no cut
+  uint8_t      power_off;        // All operations fail until Nor_model_power_on
+  uint32_t     power_cuts;
+  uint32_t     rng;              // State of the generator for torn data
+} T_nor_model;
+
+extern const T_nor_timing g_nor_timing_mx25um;
+
+void     Nor_model_init(T_nor_model *m, uint8_t *mem, uint32_t size, uint32_t page_size, uint32_t sector_size, const T_nor_timing *timing);
+void     Nor_model_reset_stats(T_nor_model *m);
+int      Nor_model_read(void *ctx, uint32_t addr, void *buf, uint32_t size);
+int      Nor_model_prog(void *ctx, uint32_t addr, const void *buf, uint32_t size);
+int      Nor_model_erase(void *ctx, uint32_t addr, uint32_t size);
+
+int      Nor_model_erase_start(void *ctx, uint32_t addr, uint32_t size);
+int      Nor_model_erase_busy(void *ctx);
+int      Nor_model_erase_suspend(void *ctx);
+int      Nor_model_erase_resume(void *ctx);
+void     Nor_model_wait(void *ctx);
+uint32_t Nor_model_clock_us(void *ctx);
+
+void     Nor_model_set_wear(T_nor_model *m, uint32_t *wear);
+void     Nor_model_cut_power(T_nor_model *m, uint32_t ops);
+void     Nor_model_power_on(T_nor_model *m);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NOR_FLASH_MODEL_H
@@ -0,0 +1,1224 @@
+/*-----------------------------------------------------------------------------------------------------
+  Description: Comparison of LittleFS and FileX over LevelX NOR on the RAM NOR flash model
+
+  Parameters:
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+
+#include "App.h"
+#include "littlefs_adapter.h"
+#include "nor_flash_model.h"
+#include "littlefs_bench.h"
+#include "storage_bench.h"
+
+#if STORAGE_BENCH_ENABLE
+
+#ifdef FX_ENABLE_FAULT_TOLERANT
+  #include "fx_fault_tolerant.h"
+#endif
+
+#define STB_NO_CHUNK  0xFFFFFFFFu  // No rewrite was cut by the power
+#define STB_HEADER_SZ 8            // Chunk starts with the chunk number and the version
+
+typedef struct T_stb_ctx T_stb_ctx;
+
+// File system operations of a stack. One file is open at a time. The functions return 0 on success
+// or the native error code of the stack.
+typedef struct
+{
+  int  (*format)(T_stb_ctx *s);
+  int  (*mount)(T_stb_ctx *s);
+  int  (*unmount)(T_stb_ctx *s);
+  void (*drop)(T_stb_ctx *s);  // Forget the mounted file system after a power cut without writing to the flash
+  int  (*open)(T_stb_ctx *s, const char *name, bool create);
+  int  (*write)(T_stb_ctx *s, uint32_t pos, const void *buf, uint32_t size);
+  int  (*read)(T_stb_ctx *s, uint32_t pos, void *buf, uint32_t size);
+  int  (*sync)(T_stb_ctx *s);
+  int  (*close)(T_stb_ctx *s);
+} T_stb_ops;
+
+struct T_stb_ctx
+{
+  const T_stb_ops                    *ops;
+  T_nor_model                         nor;
+  uint32_t                            rng;
+  uint32_t                            last_cycles;  // DWT value at the previous lap
+  uint64_t                            cpu_cycles;   // CPU time accumulated by laps
+  uint64_t                            start_ns;     // Model state at the start of a measurement
+  uint64_t                            start_prog_bytes;
+  uint32_t                            start_erases;
+  bool                                file_open;
+  uint32_t                            next_version;
+  uint32_t                            committed[STB_RW_CHUNKS];  // Version of every chunk on the flash
+  uint32_t                            pending_chunk;             // Chunk of the rewrite cut by the power
+  uint32_t                            pending_version;
+  uint8_t                             io[STB_RW_CHUNK];
+
+  // LittleFS
+  lfs_t                               lfs;
+  struct lfs_config                   cfg;
+  T_lfs_bd_dev                        dev;
+  T_lfs_bd_cache                      bd;
+  lfs_file_t                          file;
+  struct lfs_file_config              file_cfg;
+  uint8_t                             read_buffer[LITTLEFS_CACHE_SIZE];
+  uint8_t                             prog_buffer[LITTLEFS_CACHE_SIZE];
+  uint8_t                             lookahead_buffer[LITTLEFS_LOOKAHEAD_SIZE];
+  uint8_t                             page[LITTLEFS_PAGE_SIZE];
+  uint8_t                             file_buffer[LITTLEFS_CACHE_SIZE];
+
+  // FileX over LevelX NOR
+  bool                                fault_tolerant;
+  LX_NOR_FLASH                        lx;
+  FX_MEDIA                            media;
+  FX_FILE                             fx_file;
+  rm_filex_levelx_nor_instance_ctrl_t fx_ctrl;
+  rm_filex_levelx_nor_cfg_t           fx_cfg;
+  rm_filex_levelx_nor_instance_t      fx_inst;
+  ULONG                               media_memory[STB_FX_MEDIA_MEMORY / sizeof(ULONG)];
+#ifdef FX_ENABLE_FAULT_TOLERANT
+  ULONG                               ft_memory[FX_FAULT_TOLERANT_MINIMAL_BUFFER_SIZE / sizeof(ULONG)];
+#endif
+#ifndef LX_DIRECT_READ
+  ULONG                               lx_sector_buffer[LX_NOR_SECTOR_SIZE];
+#endif
+};
+
+// LevelX calls the driver functions without a context
+static T_stb_ctx *g_stb;
+
+static const char *const g_stb_stack_names[STB_STACK_COUNT] = { "littlefs", "levelx_filex", "levelx_filex_ft" };
+static const char *const g_stb_workload_names[STB_WORKLOAD_COUNT] = { "append", "rewrite", "small_files", "mount", "mount_after_cut" };
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Next value of the xorshift generator of the workloads
+
+  Parameters: s - benchmark context
+
+  Return: pseudo random value
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Stb_rand(T_stb_ctx *s)
+{
+  s->rng ^= s->rng << 13;
+  s->rng ^= s->rng >> 17;
+  s->rng ^= s->rng << 5;
+  return s->rng;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Add CPU time since the previous lap. Laps are taken after every file system call,
+               so the cycle counter can not wrap between them.
+
+  Parameters: s - benchmark context
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Stb_lap(T_stb_ctx *s)
+{
+  uint32_t now    = LFS_BENCH_CYCLES();
+  s->cpu_cycles  += (uint32_t)(now - s->last_cycles);
+  s->last_cycles  = now;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Start a measurement. Measurements of a workload can be interrupted by unmeasured steps,
+               every measurement adds to the result.
+
+  Parameters: s - benchmark context
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Stb_begin(T_stb_ctx *s)
+{
+  s->start_ns         = s->nor.busy_ns;
+  s->start_prog_bytes = s->nor.prog_bytes;
+  s->start_erases     = s->nor.erases;
+  s->cpu_cycles       = 0;
+  s->last_cycles      = LFS_BENCH_CYCLES();
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: End a measurement and add it to the result
+
+  Parameters: s   - benchmark context
+              res - result
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Stb_end(T_stb_ctx *s, T_stb_result *res)
+{
+  _Stb_lap(s);
+  res->cpu_us     += (uint32_t)(s->cpu_cycles / LFS_BENCH_CYCLES_PER_US);
+  res->dev_us     += (uint32_t)((s->nor.busy_ns - s->start_ns) / 1000);
+  res->prog_bytes += (uint32_t)(s->nor.prog_bytes - s->start_prog_bytes);
+  res->erases     += s->nor.erases - s->start_erases;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Close the open file, if any
+
+  Parameters: s - benchmark context
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Stb_close_file(T_stb_ctx *s)
+{
+  if (s->file_open)
+  {
+    s->ops->close(s);
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Format the model with LittleFS
+
+  Parameters: s - benchmark context
+
+  Return: 0 on success, LittleFS error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_lfs_format(T_stb_ctx *s)
+{
+  return lfs_format(&s->lfs, &s->cfg);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Mount LittleFS
+
+  Parameters: s - benchmark context
+
+  Return: 0 on success, LittleFS error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_lfs_mount(T_stb_ctx *s)
+{
+  return lfs_mount(&s->lfs, &s->cfg);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Unmount LittleFS
+
+  Parameters: s - benchmark context
+
+  Return: 0 on success, LittleFS error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_lfs_unmount(T_stb_ctx *s)
+{
+  return lfs_unmount(&s->lfs);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Release LittleFS after a power cut. Writes fail while the power is off, the file and
+               the mount are released in RAM only and the page cache is emptied.
+
+  Parameters: s - benchmark context
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Stb_lfs_drop(T_stb_ctx *s)
+{
+  if (s->file_open)
+  {
+    lfs_file_close(&s->lfs, &s->file);
+    s->file_open = false;
+  }
+  lfs_unmount(&s->lfs);
+  Lfs_bd_init(&s->bd, &s->dev, s->page, LITTLEFS_BD_PAGE_SIZE);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Open a file for reading and writing
+
+  Parameters: s - benchmark context
+              name   - file name
+              create - create the file or truncate it
+
+  Return: 0 on success, LittleFS error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_lfs_open(T_stb_ctx *s, const char *name, bool create)
+{
+  int err;
+
+  s->file_cfg.buffer = s->file_buffer;
+  err                = lfs_file_opencfg(&s->lfs, &s->file, name, LFS_O_RDWR | (create ? (LFS_O_CREAT | LFS_O_TRUNC) : 0), &s->file_cfg);
+  s->file_open       = (err == 0);
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Write to the open file
+
+  Parameters: s - benchmark context
+              pos  - position in the file
+              buf  - data
+              size - number of bytes
+
+  Return: 0 on success, LittleFS error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_lfs_write(T_stb_ctx *s, uint32_t pos, const void *buf, uint32_t size)
+{
+  lfs_soff_t  off = lfs_file_seek(&s->lfs, &s->file, (lfs_soff_t)pos, LFS_SEEK_SET);
+  lfs_ssize_t wr;
+
+  if (off < 0)
+  {
+    return (int)off;
+  }
+  wr = lfs_file_write(&s->lfs, &s->file, buf, size);
+  return (wr == (lfs_ssize_t)size) ? 0 : ((wr < 0) ? (int)wr : LFS_ERR_IO);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Read from the open file
+
+  Parameters: s - benchmark context
+              pos  - position in the file
+              buf  - buffer
+              size - number of bytes
+
+  Return: 0 on success, LittleFS error code on failure, LFS_ERR_CORRUPT on a short read
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_lfs_read(T_stb_ctx *s, uint32_t pos, void *buf, uint32_t size)
+{
+  lfs_soff_t  off = lfs_file_seek(&s->lfs, &s->file, (lfs_soff_t)pos, LFS_SEEK_SET);
+  lfs_ssize_t rd;
+
+  if (off < 0)
+  {
+    return (int)off;
+  }
+  rd = lfs_file_read(&s->lfs, &s->file, buf, size);
+  return (rd == (lfs_ssize_t)size) ? 0 : ((rd < 0) ? (int)rd : LFS_ERR_CORRUPT);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Commit the open file
+
+  Parameters: s - benchmark context
+
+  Return: 0 on success, LittleFS error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_lfs_sync(T_stb_ctx *s)
+{
+  return lfs_file_sync(&s->lfs, &s->file);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Close the open file
+
+  Parameters: s - benchmark context
+
+  Return: 0 on success, LittleFS error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_lfs_close(T_stb_ctx *s)
+{
+  s->file_open = false;
+  return lfs_file_close(&s->lfs, &s->file);
+}
+
+static const T_stb_ops g_stb_lfs_ops = {
+  _Stb_lfs_format,
+  _Stb_lfs_mount,
+  _Stb_lfs_unmount,
+  _Stb_lfs_drop,
+  _Stb_lfs_open,
+  _Stb_lfs_write,
+  _Stb_lfs_read,
+  _Stb_lfs_sync,
+  _Stb_lfs_close,
+};
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Set up LittleFS with the geometry of the OSPI file system on the model
+
+  Parameters: s - benchmark context
+
+  Return: RAM of a mounted file system with one open file
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Stb_lfs_setup(T_stb_ctx *s)
+{
+  s->dev.read  = Nor_model_read;
+  s->dev.prog  = Nor_model_prog;
+  s->dev.erase = Nor_model_erase;
+  s->dev.ctx   = &s->nor;
+  Lfs_bd_init(&s->bd, &s->dev, s->page, LITTLEFS_BD_PAGE_SIZE);
+
+  s->cfg.context          = &s->bd;
+  s->cfg.read             = _lfs_read;
+  s->cfg.prog             = _lfs_prog;
+  s->cfg.erase            = _lfs_erase;
+  s->cfg.sync             = _lfs_sync;
+  s->cfg.read_size        = LITTLEFS_READ_SIZE;
+  s->cfg.prog_size        = LITTLEFS_PROG_SIZE;
+  s->cfg.block_size       = LITTLEFS_BLOCK_SIZE;
+  s->cfg.block_count      = STB_BLOCK_COUNT;
+  s->cfg.cache_size       = LITTLEFS_CACHE_SIZE;
+  s->cfg.lookahead_size   = LITTLEFS_LOOKAHEAD_SIZE;
+  s->cfg.block_cycles     = LITTLEFS_BLOCK_CYCLES;
+  s->cfg.read_buffer      = s->read_buffer;
+  s->cfg.prog_buffer      = s->prog_buffer;
+  s->cfg.lookahead_buffer = s->lookahead_buffer;
+  s->ops                  = &g_stb_lfs_ops;
+
+  return sizeof(s->lfs) + sizeof(s->cfg) + sizeof(s->bd) + sizeof(s->dev) + sizeof(s->file) + sizeof(s->file_cfg) +
+         sizeof(s->read_buffer) + sizeof(s->prog_buffer) + sizeof(s->lookahead_buffer) + sizeof(s->page) + sizeof(s->file_buffer);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Offset in the model of a LevelX flash address
+
+  Parameters: flash_address - address inside the model memory
+
+  Return: offset in bytes
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Stb_lx_offset(ULONG *flash_address)
+{
+  return (uint32_t)((uint8_t *)flash_address - g_stb->nor.mem);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: LevelX NOR read service on the model
+
+  Parameters: flash_address - flash address
+              destination   - buffer
+              words         - number of words
+
+  Return: LX_SUCCESS on success, LX_ERROR on failure
+-----------------------------------------------------------------------------------------------------*/
+static UINT _Stb_lx_read(ULONG *flash_address, ULONG *destination, ULONG words)
+{
+  return (Nor_model_read(&g_stb->nor, _Stb_lx_offset(flash_address), destination, words * sizeof(ULONG)) == 0) ? LX_SUCCESS : LX_ERROR;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: LevelX NOR write service on the model
+
+  Parameters: flash_address - flash address
+              source        - data
+              words         - number of words
+
+  Return: LX_SUCCESS on success, LX_ERROR on failure
+-----------------------------------------------------------------------------------------------------*/
+static UINT _Stb_lx_write(ULONG *flash_address, ULONG *source, ULONG words)
+{
+  return (Nor_model_prog(&g_stb->nor, _Stb_lx_offset(flash_address), source, words * sizeof(ULONG)) == 0) ? LX_SUCCESS : LX_ERROR;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: LevelX NOR block erase service on the model, a LevelX block is a flash sector
+
+  Parameters: block             - block number
+              block_erase_count - erase count kept by LevelX
+
+  Return: LX_SUCCESS on success, LX_ERROR on failure
+-----------------------------------------------------------------------------------------------------*/
+static UINT _Stb_lx_block_erase(ULONG block, ULONG block_erase_count)
+{
+  FSP_PARAMETER_NOT_USED(block_erase_count);
+  return (Nor_model_erase(&g_stb->nor, block * LITTLEFS_BLOCK_SIZE, LITTLEFS_BLOCK_SIZE) == 0) ? LX_SUCCESS : LX_ERROR;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: LevelX NOR erased block check on the model
+
+  Parameters: block - block number
+
+  Return: LX_SUCCESS if the block is erased, LX_ERROR otherwise
+-----------------------------------------------------------------------------------------------------*/
+static UINT _Stb_lx_block_erased_verify(ULONG block)
+{
+  for (uint32_t off = 0; off < LITTLEFS_BLOCK_SIZE; off += sizeof(g_stb->io))
+  {
+    if (Nor_model_read(&g_stb->nor, block * LITTLEFS_BLOCK_SIZE + off, g_stb->io, sizeof(g_stb->io)) != 0)
+    {
+      return LX_ERROR;
+    }
+    for (uint32_t i = 0; i < sizeof(g_stb->io); i++)
+    {
+      if (g_stb->io[i] != NOR_MODEL_ERASED_VAL)
+      {
+        return LX_ERROR;
+      }
+    }
+  }
+  return LX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: LevelX NOR system error service. A power cut is an expected error, the operation
+               fails without stopping the system.
+
+  Parameters: error_code - LevelX error code
+
+  Return: LX_ERROR
+-----------------------------------------------------------------------------------------------------*/
+static UINT _Stb_lx_system_error(UINT error_code)
+{
+  FSP_PARAMETER_NOT_USED(error_code);
+  return LX_ERROR;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: LevelX NOR driver initialization: geometry of the model and the driver services
+
+  Parameters: p_nor_flash - LevelX NOR flash instance
+
+  Return: LX_SUCCESS
+-----------------------------------------------------------------------------------------------------*/
+static UINT _Stb_lx_initialize(LX_NOR_FLASH *p_nor_flash)
+{
+  p_nor_flash->lx_nor_flash_base_address               = (ULONG *)g_stb->nor.mem;
+  p_nor_flash->lx_nor_flash_total_blocks               = STB_BLOCK_COUNT;
+  p_nor_flash->lx_nor_flash_words_per_block            = LITTLEFS_BLOCK_SIZE / sizeof(ULONG);
+#ifndef LX_DIRECT_READ
+  p_nor_flash->lx_nor_flash_sector_buffer              = g_stb->lx_sector_buffer;
+#endif
+  p_nor_flash->lx_nor_flash_driver_read                = _Stb_lx_read;
+  p_nor_flash->lx_nor_flash_driver_write               = _Stb_lx_write;
+  p_nor_flash->lx_nor_flash_driver_block_erase         = _Stb_lx_block_erase;
+  p_nor_flash->lx_nor_flash_driver_block_erased_verify = _Stb_lx_block_erased_verify;
+  p_nor_flash->lx_nor_flash_driver_system_error        = _Stb_lx_system_error;
+  return LX_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Close of the lower driver called by the FileX LevelX NOR driver, nothing to close on the model
+
+  Parameters:
+
+  Return: FSP_SUCCESS
+-----------------------------------------------------------------------------------------------------*/
+static fsp_err_t _Stb_lx_close(void)
+{
+  return FSP_SUCCESS;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Format the model with FileX over LevelX NOR. FileX sectors are LevelX logical sectors:
+               all physical sectors except one block kept free for reclaim.
+
+  Parameters: s - benchmark context
+
+  Return: 0 on success, LevelX or FileX error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_fx_format(T_stb_ctx *s)
+{
+  ULONG sectors;
+  UINT  err;
+
+  err = lx_nor_flash_open(&s->lx, (CHAR *)"stb", _Stb_lx_initialize);
+  if (err != LX_SUCCESS)
+  {
+    return (int)err;
+  }
+  sectors = s->lx.lx_nor_flash_total_physical_sectors - s->lx.lx_nor_flash_physical_sectors_per_block;
+  lx_nor_flash_close(&s->lx);
+
+  return (int)fx_media_format(&s->media, RM_FILEX_LEVELX_NOR_DeviceDriver, &s->fx_inst, (UCHAR *)s->media_memory, sizeof(s->media_memory),
+                              (CHAR *)"STB", G_FX_MEDIA_OSPI_NOR_NUMBER_OF_FATS, G_FX_MEDIA_OSPI_NOR_DIRECTORY_ENTRIES, 0, sectors,
+                              G_FX_MEDIA_OSPI_NOR_BYTES_PER_SECTOR, G_FX_MEDIA_OSPI_NOR_SECTORS_PER_CLUSTER, 1, 1);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Open the FileX media. In the fault tolerant mode the log left by an interrupted
+               operation is applied or discarded.
+
+  Parameters: s - benchmark context
+
+  Return: 0 on success, FileX error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_fx_mount(T_stb_ctx *s)
+{
+  UINT err;
+
+  err = fx_media_open(&s->media, (CHAR *)"stb", RM_FILEX_LEVELX_NOR_DeviceDriver, &s->fx_inst, s->media_memory, sizeof(s->media_memory));
+#ifdef FX_ENABLE_FAULT_TOLERANT
+  if ((err == FX_SUCCESS) && s->fault_tolerant)
+  {
+    err = fx_fault_tolerant_enable(&s->media, s->ft_memory, sizeof(s->ft_memory));
+  }
+#endif
+  return (int)err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Close the FileX media
+
+  Parameters: s - benchmark context
+
+  Return: 0 on success, FileX error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_fx_unmount(T_stb_ctx *s)
+{
+  return (int)fx_media_close(&s->media);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Release FileX and LevelX after a power cut without writing to the flash. An abort does
+               not close LevelX, a failed open may have left it open too.
+
+  Parameters: s - benchmark context
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Stb_fx_drop(T_stb_ctx *s)
+{
+  s->file_open = false;
+  if (s->media.fx_media_id == FX_MEDIA_ID)
+  {
+    fx_media_abort(&s->media);
+  }
+  if (s->lx.lx_nor_flash_state == LX_NOR_FLASH_OPENED)
+  {
+    lx_nor_flash_close(&s->lx);
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Open a file for reading and writing
+
+  Parameters: s - benchmark context
+              name   - file name
+              create - create the file or truncate it
+
+  Return: 0 on success, FileX error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_fx_open(T_stb_ctx *s, const char *name, bool create)
+{
+  UINT err;
+
+  if (create)
+  {
+    fx_file_delete(&s->media, (CHAR *)name);
+    err = fx_file_create(&s->media, (CHAR *)name);
+    if (err != FX_SUCCESS)
+    {
+      return (int)err;
+    }
+  }
+  err          = fx_file_open(&s->media, &s->fx_file, (CHAR *)name, FX_OPEN_FOR_WRITE);
+  s->file_open = (err == FX_SUCCESS);
+  return (int)err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Write to the open file
+
+  Parameters: s - benchmark context
+              pos  - position in the file
+              buf  - data
+              size - number of bytes
+
+  Return: 0 on success, FileX error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_fx_write(T_stb_ctx *s, uint32_t pos, const void *buf, uint32_t size)
+{
+  UINT err = fx_file_seek(&s->fx_file, pos);
+
+  if (err == FX_SUCCESS)
+  {
+    err = fx_file_write(&s->fx_file, (VOID *)buf, size);
+  }
+  return (int)err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Read from the open file
+
+  Parameters: s - benchmark context
+              pos  - position in the file
+              buf  - buffer
+              size - number of bytes
+
+  Return: 0 on success, FileX error code on failure, FX_END_OF_FILE on a short read
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_fx_read(T_stb_ctx *s, uint32_t pos, void *buf, uint32_t size)
+{
+  ULONG actual = 0;
+  UINT  err    = fx_file_seek(&s->fx_file, pos);
+
+  if (err == FX_SUCCESS)
+  {
+    err = fx_file_read(&s->fx_file, buf, size, &actual);
+  }
+  if ((err == FX_SUCCESS) && (actual != size))
+  {
+    err = FX_END_OF_FILE;
+  }
+  return (int)err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Write the cached FAT and directory sectors of the media
+
+  Parameters: s - benchmark context
+
+  Return: 0 on success, FileX error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_fx_sync(T_stb_ctx *s)
+{
+  return (int)fx_media_flush(&s->media);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Close the open file
+
+  Parameters: s - benchmark context
+
+  Return: 0 on success, FileX error code on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_fx_close(T_stb_ctx *s)
+{
+  s->file_open = false;
+  return (int)fx_file_close(&s->fx_file);
+}
+
+static const T_stb_ops g_stb_fx_ops = {
+  _Stb_fx_format,
+  _Stb_fx_mount,
+  _Stb_fx_unmount,
+  _Stb_fx_drop,
+  _Stb_fx_open,
+  _Stb_fx_write,
+  _Stb_fx_read,
+  _Stb_fx_sync,
+  _Stb_fx_close,
+};
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Set up FileX over LevelX NOR on the model with the media settings of the OSPI volume
+
+  Parameters: s              - benchmark context
+              fault_tolerant - enable the FileX fault tolerant mode at mount
+
+  Return: RAM of a mounted file system with one open file
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Stb_fx_setup(T_stb_ctx *s, bool fault_tolerant)
+{
+  uint32_t ram;
+
+  s->fx_cfg.nor_driver_initialize = _Stb_lx_initialize;
+  s->fx_cfg.p_nor_flash           = &s->lx;
+  s->fx_cfg.p_nor_flash_name      = (CHAR *)"stb";
+  s->fx_cfg.close                 = _Stb_lx_close;
+  s->fx_cfg.p_callback            = NULL;
+  s->fx_cfg.p_context             = NULL;
+  s->fx_inst.p_ctrl               = &s->fx_ctrl;
+  s->fx_inst.p_cfg                = &s->fx_cfg;
+  s->fault_tolerant               = fault_tolerant;
+  s->ops                          = &g_stb_fx_ops;
+
+  ram = sizeof(s->lx) + sizeof(s->media) + sizeof(s->fx_file) + sizeof(s->fx_ctrl) + sizeof(s->fx_cfg) + sizeof(s->fx_inst) + sizeof(s->media_memory);
+#ifdef FX_ENABLE_FAULT_TOLERANT
+  if (fault_tolerant)
+  {
+    ram += sizeof(s->ft_memory);
+  }
+#endif
+#ifndef LX_DIRECT_READ
+  ram += sizeof(s->lx_sector_buffer);
+#endif
+  return ram;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Fill the I/O buffer with the content of a chunk version
+
+  Parameters: s       - benchmark context
+              chunk   - chunk number
+              version - chunk version
+              size    - chunk size
+
+  Return:
+-----------------------------------------------------------------------------------------------------*/
+static void _Stb_fill(T_stb_ctx *s, uint32_t chunk, uint32_t version, uint32_t size)
+{
+  memcpy(&s->io[0], &chunk, 4);
+  memcpy(&s->io[4], &version, 4);
+  for (uint32_t i = STB_HEADER_SZ; i < size; i++)
+  {
+    s->io[i] = (uint8_t)(chunk * 131u + version * 17u + i);
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Check that the I/O buffer holds a complete version of a chunk
+
+  Parameters: s         - benchmark context
+              chunk     - chunk number
+              size      - chunk size
+              p_version - found version
+
+  Return: true if the chunk is complete
+-----------------------------------------------------------------------------------------------------*/
+static bool _Stb_check(T_stb_ctx *s, uint32_t chunk, uint32_t size, uint32_t *p_version)
+{
+  uint32_t id;
+
+  memcpy(&id, &s->io[0], 4);
+  memcpy(p_version, &s->io[4], 4);
+  if (id != chunk)
+  {
+    return false;
+  }
+  for (uint32_t i = STB_HEADER_SZ; i < size; i++)
+  {
+    if (s->io[i] != (uint8_t)(chunk * 131u + *p_version * 17u + i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Append STB_LOG_RECORDS records to a new file, every record is synced
+
+  Parameters: s   - benchmark context
+              res - result
+
+  Return: 0 on success, error code of the stack on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_append(T_stb_ctx *s, T_stb_result *res)
+{
+  int err;
+
+  _Stb_begin(s);
+  err = s->ops->open(s, "log.bin", true);
+  for (uint32_t n = 0; (n < STB_LOG_RECORDS) && (err == 0); n++)
+  {
+    _Stb_fill(s, n, 1, STB_LOG_RECORD_SZ);
+    err = s->ops->write(s, n * STB_LOG_RECORD_SZ, s->io, STB_LOG_RECORD_SZ);
+    if (err == 0)
+    {
+      err = s->ops->sync(s);
+    }
+    _Stb_lap(s);
+    res->ops++;
+  }
+  if (err == 0)
+  {
+    err = s->ops->close(s);
+  }
+  _Stb_end(s, res);
+  res->bytes = res->ops * STB_LOG_RECORD_SZ;
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Write all chunks of the rewrite file with new versions, not measured
+
+  Parameters: s - benchmark context
+
+  Return: 0 on success, error code of the stack on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_rw_create(T_stb_ctx *s)
+{
+  int err;
+
+  _Stb_close_file(s);
+  err = s->ops->open(s, "data.bin", true);
+  for (uint32_t c = 0; (c < STB_RW_CHUNKS) && (err == 0); c++)
+  {
+    s->committed[c] = s->next_version++;
+    _Stb_fill(s, c, s->committed[c], STB_RW_CHUNK);
+    err = s->ops->write(s, c * STB_RW_CHUNK, s->io, STB_RW_CHUNK);
+  }
+  if (err == 0)
+  {
+    err = s->ops->close(s);
+  }
+  s->pending_chunk = STB_NO_CHUNK;
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Rewrite a random chunk of the open rewrite file and sync it
+
+  Parameters: s - benchmark context
+
+  Return: 0 on success, error code of the stack on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_rw_one(T_stb_ctx *s)
+{
+  uint32_t chunk = _Stb_rand(s) % STB_RW_CHUNKS;
+  int      err;
+
+  s->pending_chunk   = chunk;
+  s->pending_version = s->next_version++;
+  _Stb_fill(s, chunk, s->pending_version, STB_RW_CHUNK);
+  err = s->ops->write(s, chunk * STB_RW_CHUNK, s->io, STB_RW_CHUNK);
+  if (err == 0)
+  {
+    err = s->ops->sync(s);
+  }
+  if (err == 0)
+  {
+    s->committed[chunk] = s->pending_version;
+    s->pending_chunk    = STB_NO_CHUNK;
+  }
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Read the rewrite file and check every chunk. A chunk must hold its committed version,
+               the chunk of a rewrite cut by the power can also hold the new version.
+
+  Parameters: s - benchmark context
+
+  Return: number of damaged chunks, STB_RW_CHUNKS if the file can not be read
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Stb_rw_verify(T_stb_ctx *s)
+{
+  uint32_t damaged = 0;
+  uint32_t version;
+
+  _Stb_close_file(s);
+  if (s->ops->open(s, "data.bin", false) != 0)
+  {
+    return STB_RW_CHUNKS;
+  }
+  for (uint32_t c = 0; c < STB_RW_CHUNKS; c++)
+  {
+    if ((s->ops->read(s, c * STB_RW_CHUNK, s->io, STB_RW_CHUNK) != 0) || !_Stb_check(s, c, STB_RW_CHUNK, &version))
+    {
+      damaged++;
+    }
+    else if (version != s->committed[c])
+    {
+      if ((c == s->pending_chunk) && (version == s->pending_version))
+      {
+        s->committed[c] = version;
+      }
+      else
+      {
+        damaged++;
+      }
+    }
+  }
+  s->ops->close(s);
+  s->pending_chunk = STB_NO_CHUNK;
+  return damaged;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Create a file of STB_RW_FILE_SZ bytes and rewrite STB_RW_OPS random chunks of STB_RW_CHUNK
+               bytes, every rewrite is synced. Only the rewrites are measured.
+
+  Parameters: s   - benchmark context
+              res - result
+
+  Return: 0 on success, error code of the stack on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_rewrite(T_stb_ctx *s, T_stb_result *res)
+{
+  int err;
+
+  err = _Stb_rw_create(s);
+  if (err == 0)
+  {
+    err = s->ops->open(s, "data.bin", false);
+  }
+  if (err != 0)
+  {
+    return err;
+  }
+  _Stb_begin(s);
+  for (uint32_t n = 0; (n < STB_RW_OPS) && (err == 0); n++)
+  {
+    err = _Stb_rw_one(s);
+    _Stb_lap(s);
+    res->ops++;
+  }
+  _Stb_end(s, res);
+  res->bytes = res->ops * STB_RW_CHUNK;
+  if (err == 0)
+  {
+    err = s->ops->close(s);
+  }
+  if (err == 0)
+  {
+    res->failures = _Stb_rw_verify(s);
+  }
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Create STB_SMALL_FILES files of STB_SMALL_FILE_SZ bytes, then read them back
+
+  Parameters: s   - benchmark context
+              res - result
+
+  Return: 0 on success, error code of the stack on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_small(T_stb_ctx *s, T_stb_result *res)
+{
+  char     name[16];
+  uint32_t version;
+  int      err = 0;
+
+  _Stb_begin(s);
+  for (uint32_t n = 0; (n < STB_SMALL_FILES) && (err == 0); n++)
+  {
+    snprintf(name, sizeof(name), "s%02u.bin", (unsigned int)n);
+    _Stb_fill(s, n, 1, STB_SMALL_FILE_SZ);
+    err = s->ops->open(s, name, true);
+    if (err == 0)
+    {
+      err = s->ops->write(s, 0, s->io, STB_SMALL_FILE_SZ);
+    }
+    if (err == 0)
+    {
+      err = s->ops->close(s);
+    }
+    _Stb_lap(s);
+    res->ops++;
+  }
+  _Stb_end(s, res);
+  res->bytes = res->ops * STB_SMALL_FILE_SZ;
+
+  for (uint32_t n = 0; (n < STB_SMALL_FILES) && (err == 0); n++)
+  {
+    snprintf(name, sizeof(name), "s%02u.bin", (unsigned int)n);
+    err = s->ops->open(s, name, false);
+    if (err == 0)
+    {
+      err = s->ops->read(s, 0, s->io, STB_SMALL_FILE_SZ);
+      s->ops->close(s);
+    }
+    if ((err == 0) && (!_Stb_check(s, n, STB_SMALL_FILE_SZ, &version) || (version != 1)))
+    {
+      res->failures++;
+    }
+  }
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Unmount and mount the file system left by the workloads STB_MOUNTS times.
+               Only the mounts are measured.
+
+  Parameters: s   - benchmark context
+              res - result
+
+  Return: 0 on success, error code of the stack on failure
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_mount(T_stb_ctx *s, T_stb_result *res)
+{
+  int err = 0;
+
+  _Stb_close_file(s);
+  for (uint32_t n = 0; (n < STB_MOUNTS) && (err == 0); n++)
+  {
+    err = s->ops->unmount(s);
+    if (err == 0)
+    {
+      _Stb_begin(s);
+      err = s->ops->mount(s);
+      _Stb_end(s, res);
+      res->ops++;
+    }
+  }
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Cut the power during random rewrites STB_CUT_CYCLES times. Every cycle mounts the image
+               left by the power cut and checks the rewrite file. A failed mount or a damaged file is
+               a failure, the file system is formatted or the file is written again for the next cycle.
+               Only the mounts are measured.
+
+  Parameters: s   - benchmark context
+              res - result
+
+  Return: 0 on success, error code of the stack if the file system can not be restored
+-----------------------------------------------------------------------------------------------------*/
+static int _Stb_mount_cut(T_stb_ctx *s, T_stb_result *res)
+{
+  int err = 0;
+
+  for (uint32_t c = 0; (c < STB_CUT_CYCLES) && (err == 0); c++)
+  {
+    err = s->ops->open(s, "data.bin", false);
+    if (err != 0)
+    {
+      break;
+    }
+    Nor_model_cut_power(&s->nor, 1 + _Stb_rand(s) % STB_CUT_OPS);
+    while (_Stb_rw_one(s) == 0)
+    {
+    }
+    s->ops->drop(s);
+    Nor_model_power_on(&s->nor);
+
+    _Stb_begin(s);
+    err = s->ops->mount(s);
+    _Stb_end(s, res);
+    res->ops++;
+
+    if (err != 0)
+    {
+      res->failures++;
+      s->ops->drop(s);
+      err = s->ops->format(s);
+      if (err == 0)
+      {
+        err = s->ops->mount(s);
+      }
+      if (err == 0)
+      {
+        err = _Stb_rw_create(s);
+      }
+    }
+    else if (_Stb_rw_verify(s) != 0)
+    {
+      res->failures++;
+      err = _Stb_rw_create(s);
+    }
+  }
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Format a RAM flash model with a file system stack and run the workloads on it.
+               The memory for the model is taken from the application pool and released at the end.
+
+  Parameters: stack - file system stack
+              seed  - seed of the random rewrites and power cuts
+              rep   - report
+
+  Return: 0 on success, error code of the stack on failure
+-----------------------------------------------------------------------------------------------------*/
+int Storage_bench_run(T_stb_stack stack, uint32_t seed, T_stb_report *rep)
+{
+  T_stb_ctx *s;
+  uint8_t   *mem;
+  int        err;
+
+  memset(rep, 0, sizeof(*rep));
+  if (stack >= STB_STACK_COUNT)
+  {
+    return LFS_ERR_INVAL;
+  }
+  rep->name = g_stb_stack_names[stack];
+#ifndef FX_ENABLE_FAULT_TOLERANT
+  if (stack == STB_LEVELX_FILEX_FT)
+  {
+    rep->err = FX_NOT_IMPLEMENTED;
+    return rep->err;
+  }
+#endif
+
+  s   = App_malloc_pending(sizeof(T_stb_ctx), 10);
+  mem = App_malloc_pending(STB_BLOCK_COUNT * LITTLEFS_BLOCK_SIZE, 10);
+  if ((s == NULL) || (mem == NULL))
+  {
+    App_free(s);
+    App_free(mem);
+    rep->err = LFS_ERR_NOMEM;
+    return rep->err;
+  }
+  memset(s, 0, sizeof(*s));
+  s->rng          = (seed != 0) ? seed : 1;
+  s->next_version = 1;
+  g_stb           = s;
+
+  Nor_model_init(&s->nor, mem, STB_BLOCK_COUNT * LITTLEFS_BLOCK_SIZE, LITTLEFS_PAGE_SIZE, LITTLEFS_BLOCK_SIZE, &g_nor_timing_mx25um);
+  if (stack == STB_LITTLEFS)
+  {
+    rep->ram_bytes = _Stb_lfs_setup(s);
+  }
+  else
+  {
+    rep->ram_bytes = _Stb_fx_setup(s, stack == STB_LEVELX_FILEX_FT);
+  }
+
+  err = s->ops->format(s);
+  if (err == 0)
+  {
+    err = s->ops->mount(s);
+  }
+  if (err == 0)
+  {
+    err = _Stb_append(s, &rep->res[STB_APPEND]);
+  }
+  if (err == 0)
+  {
+    err = _Stb_rewrite(s, &rep->res[STB_REWRITE]);
+  }
+  if (err == 0)
+  {
+    err = _Stb_small(s, &rep->res[STB_SMALL]);
+  }
+  if (err == 0)
+  {
+    err = _Stb_mount(s, &rep->res[STB_MOUNT]);
+  }
+  if (err == 0)
+  {
+    err = _Stb_mount_cut(s, &rep->res[STB_MOUNT_CUT]);
+  }
+  if (err == 0)
+  {
+    _Stb_close_file(s);
+    err = s->ops->unmount(s);
+  }
+  else
+  {
+    s->ops->drop(s);
+  }
+  if ((err == 0) && (s->nor.violations != 0))
+  {
+    err = LFS_ERR_CORRUPT;
+  }
+
+  g_stb    = NULL;
+  rep->err = err;
+  App_free(mem);
+  App_free(s);
+  return err;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: Header line of the CSV table of the results
+
+  Parameters: buf  - output buffer
+              size - buffer size
+
+  Return: length of the line
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Storage_bench_csv_header(char *buf, uint32_t size)
+{
+  int n = snprintf(buf, size, "stack,workload,ops,bytes,time_us,us_per_op,bytes_per_s,prog_bytes,write_amp_x100,erases,failures,ram_bytes,err");
+
+  return (n < 0) ? 0 : (((uint32_t)n < size) ? (uint32_t)n : size - 1);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Description: CSV line of a workload result. Time is the CPU time plus the modeled flash time,
+               write amplification is programmed bytes per payload byte, 0 if no payload was written.
+
+  Parameters: rep  - report of a stack
+              w    - workload
+              buf  - output buffer
+              size - buffer size
+
+  Return: length of the line
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Storage_bench_csv_row(const T_stb_report *rep, T_stb_workload w, char *buf, uint32_t size)
+{
+  const T_stb_result *r        = &rep->res[w];
+  uint64_t            total_us = (uint64_t)r->cpu_us + r->dev_us;
+  uint32_t            per_op   = (r->ops != 0) ? (uint32_t)(total_us / r->ops) : 0;
+  uint32_t            rate     = (total_us != 0) ? (uint32_t)(((uint64_t)r->bytes * 1000000ull) / total_us) : 0;
+  uint32_t            amp_x100 = (r->bytes != 0) ? (uint32_t)(((uint64_t)r->prog_bytes * 100u) / r->bytes) : 0;
+  int                 n;
+
+  n = snprintf(buf, size, "%s,%s,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%d",
+               rep->name, g_stb_workload_names[w],
+               (unsigned int)r->ops, (unsigned int)r->bytes, (unsigned int)total_us, (unsigned int)per_op, (unsigned int)rate,
+               (unsigned int)r->prog_bytes, (unsigned int)amp_x100, (unsigned int)r->erases, (unsigned int)r->failures,
+               (unsigned int)rep->ram_bytes, rep->err);
+  return (n < 0) ? 0 : (((uint32_t)n < size) ? (uint32_t)n : size - 1);
+}
+
+#endif  // STORAGE_BENCH_ENABLE
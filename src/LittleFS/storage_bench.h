@@ -0,0 +1,81 @@
+#ifndef STORAGE_BENCH_H
+#define STORAGE_BENCH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Comparison of the two file system stacks of the OSPI flash on the RAM NOR flash model: LittleFS with the
+// block device page cache and FileX over LevelX NOR through the FSP FileX LevelX NOR driver. Every stack
+// formats a model of the same size and runs the same workloads. Time of a workload is the measured CPU time
+// plus the modeled device time. LevelX is built with LX_DIRECT_READ and reads the flash through pointers,
+// these reads are not counted in the device time. The real OSPI flash is not touched.
+
+// 1 - the benchmark and its monitor item are built. It pulls the FileX and LevelX NOR stack into the image and
+// takes the flash model from the heap, so it is only enabled in builds made for the comparison.
+#ifndef STORAGE_BENCH_ENABLE
+#define STORAGE_BENCH_ENABLE 0
+#endif
+
+#define STB_BLOCK_COUNT      64            // Model size is STB_BLOCK_COUNT * LITTLEFS_BLOCK_SIZE
+#define STB_LOG_RECORDS      256           // Sequential log append: records appended and synced one by one
+#define STB_LOG_RECORD_SZ    128
+#define STB_RW_FILE_SZ       (32 * 1024)   // Random rewrites: file rewritten by STB_RW_CHUNK at random chunks
+#define STB_RW_CHUNK         512
+#define STB_RW_CHUNKS        (STB_RW_FILE_SZ / STB_RW_CHUNK)
+#define STB_RW_OPS           128
+#define STB_SMALL_FILES      32            // Small files: files created, written and closed
+#define STB_SMALL_FILE_SZ    256
+#define STB_MOUNTS           8             // Mounts of the image left by the workloads
+#define STB_CUT_CYCLES       32            // Mounts after a power cut during random rewrites
+#define STB_CUT_OPS          64            // The power is cut at a random program or erase in 1..STB_CUT_OPS
+#define STB_FX_MEDIA_MEMORY  G_FX_MEDIA_OSPI_NOR_MEDIA_MEMORY_SIZE
+
+typedef enum
+{
+  STB_LITTLEFS,
+  STB_LEVELX_FILEX,
+  STB_LEVELX_FILEX_FT,  // FileX fault tolerant mode, requires FX_ENABLE_FAULT_TOLERANT
+  STB_STACK_COUNT,
+} T_stb_stack;
+
+typedef enum
+{
+  STB_APPEND,
+  STB_REWRITE,
+  STB_SMALL,
+  STB_MOUNT,
+  STB_MOUNT_CUT,
+  STB_WORKLOAD_COUNT,
+} T_stb_workload;
+
+typedef struct
+{
+  uint32_t ops;         // Records, rewrites, files or mounts
+  uint32_t bytes;       // Payload bytes
+  uint32_t cpu_us;      // CPU time of the stack and the block device layer
+  uint32_t dev_us;      // Modeled flash time
+  uint32_t prog_bytes;  // Bytes programmed to the flash
+  uint32_t erases;      // Erased sectors
+  uint32_t failures;    // Data found damaged, failed mounts after a power cut
+} T_stb_result;
+
+typedef struct
+{
+  const char  *name;
+  int          err;        // First error of the stack, native error code of the stack
+  uint32_t     ram_bytes;  // Control blocks, caches and buffers of a mounted file system with one open file
+  T_stb_result res[STB_WORKLOAD_COUNT];
+} T_stb_report;
+
+int      Storage_bench_run(T_stb_stack stack, uint32_t seed, T_stb_report *rep);
+uint32_t Storage_bench_csv_header(char *buf, uint32_t size);
+uint32_t Storage_bench_csv_row(const T_stb_report *rep, T_stb_workload w, char *buf, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // STORAGE_BENCH_H
@@ -14,17 +14,28 @@ const char *log_file_prev_names[NUM_OF_LOGS]   = { APP_LOG_PREV_FILE_PATH, NET_L
 #ifdef LOG_TO_ONBOARD_SDRAM
 T_logger_record app_log[APP_LOG_CAPACITY] @ ".sdram";
 T_logger_record net_log[NET_LOG_CAPACITY] @ ".sdram";
+static uint32_t log_file_wbufs[NUM_OF_LOGS][LOG_FILE_WBUF_SZ / sizeof(uint32_t)] @ ".sdram";
 #else
 T_logger_record app_log[APP_LOG_CAPACITY];
 T_logger_record net_log[NET_LOG_CAPACITY];
+static uint32_t log_file_wbufs[NUM_OF_LOGS][LOG_FILE_WBUF_SZ / sizeof(uint32_t)];
 #endif
 
-#define TIME_DELAY_BEFORE_SAVE       100  // Time in ms before remaining records are saved
-#define LOG_RECS_BEFORE_SAVE_TO_FILE 20   // Number of records that triggers immediate save
+static T_log_bin_record motor_log_bin_records[LOG_BIN_MOTOR_CAPACITY];
 
-char        file_log_str[LOG_STR_MAX_SZ];
+T_log_bin_ring motor_log_ring = { "Motor", motor_log_bin_records, LOG_BIN_MOTOR_CAPACITY };
+
+static T_log_bin_ring *log_bin_rings[LOG_BIN_MAX_RINGS];
+static uint32_t        log_bin_rings_count;
+
+char        file_log_str[LOG_FILE_LINE_MAX_SZ];
 static char rtt_log_str[RTT_LOG_STR_SZ];
-static void Log_write(T_log_cbl *log_cbl_ptr, char *str, const char *func_name, unsigned int line_num, unsigned int severity);
+static void Log_write(T_log_cbl *log_cbl_ptr, char *str, const char *func_name, unsigned int line_num, unsigned int severity, T_sys_timestump *p_ts);
+static void Log_bin_drain(void);
+static void LogFile_Rotate(uint32_t indx);
+static void LogFile_buf_rearm(T_log_cbl *log_cbl_ptr);
+static void LogFile_buf_write(uint32_t indx, uint32_t flush);
+static void LogFile_buf_append(uint32_t indx, const char *data, uint32_t len);
 
 /*-----------------------------------------------------------------------------------------------------
   Initialize log control block
@@ -50,6 +61,7 @@ static uint32_t Log_init(T_log_cbl *log_cbl_ptr, uint32_t log_capacity, T_logger
   log_cbl_ptr->log_capacity = log_capacity;
   log_cbl_ptr->head_indx    = 0;
   log_cbl_ptr->tail_indx    = 0;
+  Cycle_profile_reset(&log_cbl_ptr->file_stats.write_profile);
   log_cbl_ptr->logger_ready = 1;
   return RES_OK;
 }
@@ -68,6 +80,7 @@ uint32_t Logger_init(void)
   wvar.enable_log = 1;
   Log_init(&app_log_cbl, APP_LOG_CAPACITY, app_log, "App log");
   Log_init(&net_log_cbl, NET_LOG_CAPACITY, net_log, "Net log");
+  Log_bin_ring_register(&motor_log_ring);
   return RES_OK;
 }
 
@@ -127,7 +140,7 @@ void LOGs(const char *name, unsigned int line_num, unsigned int severity, const
   va_list ap;
   va_start(ap, fmt_ptr);
   vsnprintf(log_str, LOG_STR_MAX_SZ, (const char *)fmt_ptr, ap);
-  Log_write(&app_log_cbl, log_str, name, line_num, severity);
+  Log_write(&app_log_cbl, log_str, name, line_num, severity, NULL);
   va_end(ap);
 }
 
@@ -151,7 +164,7 @@ void ELOGs(const char *name, unsigned int line_num, unsigned int severity, const
   va_list ap;
   va_start(ap, fmt_ptr);
   vsnprintf(log_str, LOG_STR_MAX_SZ, (const char *)fmt_ptr, ap);
-  Log_write(&app_log_cbl, log_str, name, line_num, severity);
+  Log_write(&app_log_cbl, log_str, name, line_num, severity, NULL);
   va_end(ap);
 }
 
@@ -175,10 +188,127 @@ void Net_LOGs(const char *name, unsigned int line_num, unsigned int severity, co
   // if (wvar.en_net_log == 0) return;
   va_start(ap, fmt_ptr);
   vsnprintf(log_str, LOG_STR_MAX_SZ, (const char *)fmt_ptr, ap);
-  Log_write(&net_log_cbl, log_str, name, line_num, severity);
+  Log_write(&net_log_cbl, log_str, name, line_num, severity, NULL);
   va_end(ap);
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Register binary log ring to be drained by Logger_Task
+
+  Parameters:
+    p_ring - pointer to ring with records array and power of 2 capacity
+
+  Return:
+    RES_OK on success, RES_ERROR if no free slot or invalid capacity
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Log_bin_ring_register(T_log_bin_ring *p_ring)
+{
+  if (log_bin_rings_count >= LOG_BIN_MAX_RINGS) return RES_ERROR;
+  if ((p_ring->capacity == 0) || ((p_ring->capacity & (p_ring->capacity - 1)) != 0)) return RES_ERROR;
+  p_ring->head                       = 0;
+  p_ring->tail                       = 0;
+  p_ring->dropped                    = 0;
+  p_ring->dropped_shown              = 0;
+  log_bin_rings[log_bin_rings_count] = p_ring;
+  log_bin_rings_count++;
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Write binary record to producer ring. No formatting, no locks and no waiting,
+  so it can be called from the motor control loop and from interrupt handlers.
+  Only one context may write to a given ring. Text is expanded later in Logger_Task.
+
+  Parameters:
+    p_ring - producer ring
+    name - function name
+    line_num - line number
+    severity - message severity level
+    nargs - number of arguments after format string (up to LOG_BIN_MAX_ARGS)
+    fmt_ptr - format string with static storage duration
+    ... - 32-bit integer arguments or pointers to static strings, checked by BINLOG at compile time
+
+  Return:
+    void
+-----------------------------------------------------------------------------------------------------*/
+void Log_bin_write(T_log_bin_ring *p_ring, const char *name, unsigned int line_num, unsigned int severity, uint32_t nargs, const char *fmt_ptr, ...)
+{
+  uint32_t          head;
+  T_log_bin_record *rec;
+  va_list           ap;
+
+  if ((app_log_cbl.logger_ready != 1) || (wvar.enable_log == 0)) return;
+
+  head = p_ring->head;
+  if ((head - p_ring->tail) >= p_ring->capacity)
+  {
+    p_ring->dropped++;
+    return;
+  }
+
+  rec = &p_ring->records[head & (p_ring->capacity - 1)];
+  Get_hw_timestump(&rec->timestump);
+  rec->fmt       = fmt_ptr;
+  rec->func_name = name;
+  rec->line_num  = (uint16_t)line_num;
+  rec->severity  = (uint8_t)severity;
+  if (nargs > LOG_BIN_MAX_ARGS) nargs = LOG_BIN_MAX_ARGS;
+  rec->nargs = (uint8_t)nargs;
+  va_start(ap, fmt_ptr);
+  for (uint32_t i = 0; i < nargs; i++)
+  {
+    rec->args[i] = va_arg(ap, uint32_t);
+  }
+  va_end(ap);
+
+  __DMB();  // Record must be visible before the consumer sees the new head
+  p_ring->head = head + 1;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Expand records of all registered binary log rings into the application log
+
+  Parameters:
+    void
+
+  Return:
+    void
+-----------------------------------------------------------------------------------------------------*/
+static void Log_bin_drain(void)
+{
+  char log_str[LOG_STR_MAX_SZ + 1];
+
+  for (uint32_t r = 0; r < log_bin_rings_count; r++)
+  {
+    T_log_bin_ring *p_ring = log_bin_rings[r];
+    uint32_t        tail   = p_ring->tail;
+
+    while (tail != p_ring->head)
+    {
+      __DMB();  // Read record only after head was observed
+      T_log_bin_record *rec = &p_ring->records[tail & (p_ring->capacity - 1)];
+      uint32_t          a[LOG_BIN_MAX_ARGS];
+
+      for (uint32_t i = 0; i < LOG_BIN_MAX_ARGS; i++)
+      {
+        a[i] = (i < rec->nargs) ? rec->args[i] : 0;
+      }
+      snprintf(log_str, LOG_STR_MAX_SZ, rec->fmt, a[0], a[1], a[2], a[3]);
+      Log_write(&app_log_cbl, log_str, rec->func_name, rec->line_num, rec->severity, &rec->timestump);
+      tail++;
+      p_ring->tail = tail;
+    }
+
+    uint32_t dropped = p_ring->dropped;
+    if (dropped != p_ring->dropped_shown)
+    {
+      snprintf(log_str, LOG_STR_MAX_SZ, "Binary log ring %s: %u records dropped", p_ring->name, (unsigned int)(dropped - p_ring->dropped_shown));
+      Log_write(&app_log_cbl, log_str, __FUNCTION__, __LINE__, SEVERITY_RED, NULL);
+      p_ring->dropped_shown = dropped;
+    }
+  }
+}
+
 /*-----------------------------------------------------------------------------------------------------
   Get log control block by ID
 
@@ -231,11 +361,12 @@ void Req_to_reset_netlog_file(void)
     func_name - function name
     line_num - line number
     severity - message severity level
+    p_ts - time of the event, NULL to use current time
 
   Return:
     void
 -----------------------------------------------------------------------------------------------------*/
-static void Log_write(T_log_cbl *log_cbl_ptr, char *str, const char *func_name, unsigned int line_num, unsigned int severity)
+static void Log_write(T_log_cbl *log_cbl_ptr, char *str, const char *func_name, unsigned int line_num, unsigned int severity, T_sys_timestump *p_ts)
 {
   int             head;
   int             tail;
@@ -248,7 +379,14 @@ static void Log_write(T_log_cbl *log_cbl_ptr, char *str, const char *func_name,
     // so mutexes and other synchronization services cannot be used here
     if (tx_mutex_get(&log_cbl_ptr->log_mutex, MS_TO_TICKS(LOGGER_WR_TIMEOUT_MS)) == TX_SUCCESS)
     {
-      Get_hw_timestump(&ntime);
+      if (p_ts != NULL)
+      {
+        ntime = *p_ts;
+      }
+      else
+      {
+        Get_hw_timestump(&ntime);
+      }
       RTC_get_system_DateTime(&date_time);
       date_time.tm_mon++;
       date_time.tm_year += 1900;
@@ -447,6 +585,8 @@ static void LogFile_Open(uint32_t indx)
     res = fx_file_open(&fat_fs_media, &log_cbls[indx]->log_file, (char *)log_file_names[indx], FX_OPEN_FOR_WRITE);
     if (res == FX_SUCCESS)
     {
+      log_cbls[indx]->wbuf            = (uint8_t *)log_file_wbufs[indx];
+      LogFile_buf_rearm(log_cbls[indx]);
       log_cbls[indx]->log_file_opened = 1;
       APPLOG("Log: file %s opened successfully for writing", log_file_names[indx]);
     }
@@ -485,6 +625,7 @@ static void LogFile_Reset(uint32_t indx)
       {
         if (fx_file_open(&fat_fs_media, &log_cbl_ptr->log_file, (char *)log_file_names[indx], FX_OPEN_FOR_WRITE) == FX_SUCCESS)
         {
+          LogFile_buf_rearm(log_cbl_ptr);  // Text staged for the deleted file is discarded
           flag = 1;
           EAPPLOG("Log file %s successfully reset.", log_file_names[indx]);
         }
@@ -500,7 +641,142 @@ static void LogFile_Reset(uint32_t indx)
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Save log records to file
+  Rename full log file to the previous log name and start a new one
+
+  Parameters:
+    indx - log file index
+
+  Return:
+    void
+-----------------------------------------------------------------------------------------------------*/
+static void LogFile_Rotate(uint32_t indx)
+{
+  T_log_cbl *log_cbl_ptr = log_cbls[indx];
+
+  log_cbl_ptr->log_file_opened = 0;
+  if (fx_file_close(&log_cbl_ptr->log_file) == FX_SUCCESS)
+  {
+    fx_file_delete(&fat_fs_media, (char *)log_file_prev_names[indx]);
+    if (fx_file_rename(&fat_fs_media, (char *)log_file_names[indx], (char *)log_file_prev_names[indx]) == FX_SUCCESS)
+    {
+      if (fx_file_create(&fat_fs_media, (char *)log_file_names[indx]) == FX_SUCCESS)
+      {
+        if (fx_file_open(&fat_fs_media, &log_cbl_ptr->log_file, (char *)log_file_names[indx], FX_OPEN_FOR_WRITE) == FX_SUCCESS)
+        {
+          log_cbl_ptr->log_file_opened = 1;
+        }
+      }
+    }
+  }
+  fx_media_flush(&fat_fs_media);
+  log_cbl_ptr->file_stats.flush_count++;
+  log_cbl_ptr->unflushed = 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Empty the staging buffer and set the fill limit so that the next buffer write
+  ends on a LOG_FILE_WBUF_SZ aligned file offset. Full buffer writes then cover whole sectors and clusters.
+
+  Parameters:
+    log_cbl_ptr - pointer to log control block
+
+  Return:
+    void
+-----------------------------------------------------------------------------------------------------*/
+static void LogFile_buf_rearm(T_log_cbl *log_cbl_ptr)
+{
+  log_cbl_ptr->wbuf_fill  = 0;
+  log_cbl_ptr->wbuf_limit = LOG_FILE_WBUF_SZ - (uint32_t)(log_cbl_ptr->log_file.fx_file_current_file_offset % LOG_FILE_WBUF_SZ);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Write the staging buffer to the log file, rotate the file if it became too large
+
+  Parameters:
+    indx  - log file index
+    flush - 1 to flush FileX cache to the media after writing
+
+  Return:
+    void
+-----------------------------------------------------------------------------------------------------*/
+static void LogFile_buf_write(uint32_t indx, uint32_t flush)
+{
+  T_log_cbl        *log_cbl_ptr = log_cbls[indx];
+  T_log_file_stats *st          = &log_cbl_ptr->file_stats;
+  uint32_t          t_start;
+
+  if (log_cbl_ptr->log_file_opened == 0)
+  {
+    log_cbl_ptr->wbuf_fill = 0;
+    return;
+  }
+
+  t_start = CYCLE_PROFILER_NOW();
+  if (log_cbl_ptr->wbuf_fill > 0)
+  {
+    if (fx_file_write(&log_cbl_ptr->log_file, log_cbl_ptr->wbuf, log_cbl_ptr->wbuf_fill) == FX_SUCCESS)
+    {
+      st->bytes_written      += log_cbl_ptr->wbuf_fill;
+      st->rate_bytes         += log_cbl_ptr->wbuf_fill;
+      log_cbl_ptr->unflushed += log_cbl_ptr->wbuf_fill;
+    }
+    else
+    {
+      st->write_err++;
+    }
+    st->write_count++;
+  }
+
+  if (log_cbl_ptr->log_file.fx_file_current_file_size > MAX_LOG_FILE_SIZE)
+  {
+    LogFile_Rotate(indx);
+  }
+  else if ((flush != 0) && (log_cbl_ptr->unflushed != 0))
+  {
+    fx_media_flush(&fat_fs_media);
+    st->flush_count++;
+    log_cbl_ptr->unflushed = 0;
+  }
+  Cycle_profile_update(&st->write_profile, t_start, CYCLE_PROFILER_NOW());
+
+  LogFile_buf_rearm(log_cbl_ptr);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Append text to the staging buffer of a log file. The buffer is written to the file each time it is full.
+
+  Parameters:
+    indx - log file index
+    data - text to append
+    len  - text length
+
+  Return:
+    void
+-----------------------------------------------------------------------------------------------------*/
+static void LogFile_buf_append(uint32_t indx, const char *data, uint32_t len)
+{
+  T_log_cbl *log_cbl_ptr = log_cbls[indx];
+  uint32_t   chunk;
+
+  while (len > 0)
+  {
+    chunk = log_cbl_ptr->wbuf_limit - log_cbl_ptr->wbuf_fill;
+    if (chunk > len) chunk = len;
+    memcpy(&log_cbl_ptr->wbuf[log_cbl_ptr->wbuf_fill], data, chunk);
+    log_cbl_ptr->wbuf_fill += chunk;
+    data                   += chunk;
+    len                    -= chunk;
+    if (log_cbl_ptr->wbuf_fill >= log_cbl_ptr->wbuf_limit)
+    {
+      LogFile_buf_write(indx, 0);
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Save log records to file.
+  All pending records are formatted into the staging buffer on every call. The file is written only
+  when the buffer is full and flushed to the media when LOG_FILE_FLUSH_PERIOD_MS has elapsed.
 
   Parameters:
     indx - log file index
@@ -514,87 +790,116 @@ static void LogFile_SaveRecords(uint32_t indx)
   int32_t n;
   int32_t str_len;
 
-  T_log_cbl *log_cbl_ptr = log_cbls[indx];
+  T_log_cbl        *log_cbl_ptr = log_cbls[indx];
+  T_log_file_stats *st          = &log_cbl_ptr->file_stats;
 
   // Check if file logging is enabled
   if (wvar.en_log_to_file == 0) return;
 
   if (log_cbl_ptr->log_file_opened == 0) return;
-  n                  = log_cbl_ptr->file_entries_count;
+  n = log_cbl_ptr->file_entries_count;
 
-  // Write if number of records exceeded threshold or timeout elapsed with unsaved records
-  log_cbl_ptr->t_now = tx_time_get();
-  if ((n > LOG_RECS_BEFORE_SAVE_TO_FILE) || ((n > 0) && ((log_cbl_ptr->t_now - log_cbl_ptr->t_prev) > ms_to_ticks(TIME_DELAY_BEFORE_SAVE))))
+  for (uint32_t i = 0; i < n; i++)
   {
-    for (uint32_t i = 0; i < n; i++)
+    // Save records to file
+    if (log_cbl_ptr->file_log_overfl_f != 0)
     {
-      // Save records to file
-      if (log_cbl_ptr->file_log_overfl_f != 0)
-      {
-        log_cbl_ptr->file_log_overfl_f = 0;
-        str_len                        = snprintf(file_log_str, LOG_STR_MAX_SZ, "... Overflow ...\r\n");
-        fx_file_write(&log_cbl_ptr->log_file, file_log_str, str_len);
-      }
-      if (log_cbl_ptr->log_miss_f != 0)
-      {
-        log_cbl_ptr->log_miss_f = 0;
-        str_len                 = snprintf(file_log_str, LOG_STR_MAX_SZ, "... Missed records ....\r\n");
-        fx_file_write(&log_cbl_ptr->log_file, file_log_str, str_len);
-      }
+      log_cbl_ptr->file_log_overfl_f = 0;
+      str_len                        = snprintf(file_log_str, LOG_FILE_LINE_MAX_SZ, "... Overflow ...\r\n");
+      LogFile_buf_append(indx, file_log_str, str_len);
+    }
+    if (log_cbl_ptr->log_miss_f != 0)
+    {
+      log_cbl_ptr->log_miss_f = 0;
+      str_len                 = snprintf(file_log_str, LOG_FILE_LINE_MAX_SZ, "... Missed records ....\r\n");
+      LogFile_buf_append(indx, file_log_str, str_len);
+    }
 
-      if (tx_mutex_get(&log_cbl_ptr->log_mutex, MS_TO_TICKS(100)) != TX_SUCCESS) return;
+    if (tx_mutex_get(&log_cbl_ptr->log_mutex, MS_TO_TICKS(100)) != TX_SUCCESS) break;
 
-      str_len        = 0;
-      tail           = log_cbl_ptr->file_tail_indx;
+    str_len        = 0;
+    tail           = log_cbl_ptr->file_tail_indx;
 
-      rtc_time_t *pt = &log_cbl_ptr->log_records[tail].date_time;
-      str_len += snprintf(&file_log_str[str_len], LOG_STR_MAX_SZ, "%04d.%02d.%02d %02d:%02d:%02d |", pt->tm_year, pt->tm_mon, pt->tm_mday, pt->tm_hour, pt->tm_min, pt->tm_sec);
+    rtc_time_t *pt = &log_cbl_ptr->log_records[tail].date_time;
+    str_len += snprintf(&file_log_str[str_len], LOG_FILE_LINE_MAX_SZ, "%04d.%02d.%02d %02d:%02d:%02d |", pt->tm_year, pt->tm_mon, pt->tm_mday, pt->tm_hour, pt->tm_min, pt->tm_sec);
 
-      uint64_t t64 = log_cbl_ptr->log_records[tail].delta_time;
-      uint32_t t32;
-      uint32_t time_msec = t64 % 1000000ull;
-      t32                = (uint32_t)(t64 / 1000000ull);
-      uint32_t time_sec  = t32 % 60;
-      uint32_t time_min  = (t32 / 60) % 60;
-      uint32_t time_hour = (t32 / (60 * 60)) % 24;
-      uint32_t time_day  = t32 / (60 * 60 * 24);
+    uint64_t t64 = log_cbl_ptr->log_records[tail].delta_time;
+    uint32_t t32;
+    uint32_t time_msec = t64 % 1000000ull;
+    t32                = (uint32_t)(t64 / 1000000ull);
+    uint32_t time_sec  = t32 % 60;
+    uint32_t time_min  = (t32 / 60) % 60;
+    uint32_t time_hour = (t32 / (60 * 60)) % 24;
+    uint32_t time_day  = t32 / (60 * 60 * 24);
 
-      str_len += snprintf(&file_log_str[str_len], LOG_STR_MAX_SZ - str_len, "%03d d %02d h %02d m %02d s %06d us |", time_day, time_hour, time_min, time_sec, time_msec);
-      str_len += snprintf(&file_log_str[str_len], LOG_STR_MAX_SZ - str_len, "%02d | %-36s | %5d |", log_cbl_ptr->log_records[tail].severity, log_cbl_ptr->log_records[tail].func_name, log_cbl_ptr->log_records[tail].line_num);
-      str_len += snprintf(&file_log_str[str_len], LOG_STR_MAX_SZ - str_len, " %s\r\n", log_cbl_ptr->log_records[tail].msg);
+    str_len += snprintf(&file_log_str[str_len], LOG_FILE_LINE_MAX_SZ - str_len, "%03d d %02d h %02d m %02d s %06d us |", time_day, time_hour, time_min, time_sec, time_msec);
+    str_len += snprintf(&file_log_str[str_len], LOG_FILE_LINE_MAX_SZ - str_len, "%02d | %-36s | %5d |", log_cbl_ptr->log_records[tail].severity, log_cbl_ptr->log_records[tail].func_name, log_cbl_ptr->log_records[tail].line_num);
+    str_len += snprintf(&file_log_str[str_len], LOG_FILE_LINE_MAX_SZ - str_len, " %s\r\n", log_cbl_ptr->log_records[tail].msg);
 
-      log_cbl_ptr->file_tail_indx++;
-      if (log_cbl_ptr->file_tail_indx >= log_cbl_ptr->log_capacity) log_cbl_ptr->file_tail_indx = 0;
-      log_cbl_ptr->file_entries_count--;
+    log_cbl_ptr->file_tail_indx++;
+    if (log_cbl_ptr->file_tail_indx >= log_cbl_ptr->log_capacity) log_cbl_ptr->file_tail_indx = 0;
+    log_cbl_ptr->file_entries_count--;
 
-      tx_mutex_put(&log_cbl_ptr->log_mutex);
+    tx_mutex_put(&log_cbl_ptr->log_mutex);
 
-      fx_file_write(&log_cbl_ptr->log_file, file_log_str, str_len);
+    if (str_len >= LOG_FILE_LINE_MAX_SZ) str_len = LOG_FILE_LINE_MAX_SZ - 1;  // snprintf returns untruncated length
+    LogFile_buf_append(indx, file_log_str, str_len);
+  }
 
-      if (log_cbl_ptr->log_file.fx_file_current_file_size > MAX_LOG_FILE_SIZE)
-      {
-        log_cbl_ptr->log_file_opened = 0;
-        if (fx_file_close(&log_cbl_ptr->log_file) == FX_SUCCESS)
-        {
-          fx_file_delete(&fat_fs_media, (char *)log_file_prev_names[indx]);
-          if (fx_file_rename(&fat_fs_media, (char *)log_file_names[indx], (char *)log_file_prev_names[indx]) == FX_SUCCESS)
-          {
-            if (fx_file_create(&fat_fs_media, (char *)log_file_names[indx]) == FX_SUCCESS)
-            {
-              if (fx_file_open(&fat_fs_media, &log_cbl_ptr->log_file, (char *)log_file_names[indx], FX_OPEN_FOR_WRITE) == FX_SUCCESS)
-              {
-                log_cbl_ptr->log_file_opened = 1;
-              }
-            }
-          }
-        }
-      }
-      fx_media_flush(&fat_fs_media);  // Clear write cache
-      log_cbl_ptr->t_prev = log_cbl_ptr->t_now;
-    }
+  // Write the partial buffer and flush FileX cache no more often than once per flush period
+  log_cbl_ptr->t_now = tx_time_get();
+  if (((log_cbl_ptr->wbuf_fill != 0) || (log_cbl_ptr->unflushed != 0)) && ((log_cbl_ptr->t_now - log_cbl_ptr->t_prev) >= ms_to_ticks(LOG_FILE_FLUSH_PERIOD_MS)))
+  {
+    LogFile_buf_write(indx, 1);
+    log_cbl_ptr->t_prev = log_cbl_ptr->t_now;
+  }
+
+  if ((log_cbl_ptr->t_now - st->rate_t0) >= ms_to_ticks(LOG_FILE_RATE_WINDOW_MS))
+  {
+    st->bytes_per_s = (uint32_t)(((uint64_t)st->rate_bytes * TX_TIMER_TICKS_PER_SECOND) / (log_cbl_ptr->t_now - st->rate_t0));
+    st->rate_bytes  = 0;
+    st->rate_t0     = log_cbl_ptr->t_now;
   }
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Get log file writer statistics
+
+  Parameters:
+    log_id  - log identifier (APP_LOG_ID or NET_LOG_ID)
+    p_stats - pointer to statistics structure to fill
+
+  Return:
+    void
+-----------------------------------------------------------------------------------------------------*/
+void LogFile_get_stats(uint32_t log_id, T_log_file_stats *p_stats)
+{
+  if (log_id >= NUM_OF_LOGS) return;
+  *p_stats = log_cbls[log_id]->file_stats;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Reset log file writer statistics
+
+  Parameters:
+    log_id - log identifier (APP_LOG_ID or NET_LOG_ID)
+
+  Return:
+    void
+-----------------------------------------------------------------------------------------------------*/
+void LogFile_reset_stats(uint32_t log_id)
+{
+  T_log_file_stats *st;
+
+  if (log_id >= NUM_OF_LOGS) return;
+  st                = &log_cbls[log_id]->file_stats;
+  st->bytes_written = 0;
+  st->write_count   = 0;
+  st->write_err     = 0;
+  st->flush_count   = 0;
+  Cycle_profile_reset(&st->write_profile);
+}
+
 /*-----------------------------------------------------------------------------------------------------
   Save motion buffer to file (weak function)
 
@@ -666,11 +971,12 @@ void Logger_Task(ULONG arg)
   {
     if (tx_event_flags_get(&file_logger_flags, 0xFFFFFFFF, TX_OR_CLEAR, &flags, MS_TO_TICKS(10)) == TX_SUCCESS)
     {
+      // Both halves may be ready when Logger_Task was delayed
       if (flags & EVT_MOTION_BUF_READY_FIRST_HALF)
       {
         Save_motion_buffer(0);
       }
-      else if (flags & EVT_MOTION_BUF_READY_SECOND_HALF)
+      if (flags & EVT_MOTION_BUF_READY_SECOND_HALF)
       {
         Save_motion_buffer(1);
       }
@@ -684,6 +990,8 @@ void Logger_Task(ULONG arg)
       }
     }
 
+    Log_bin_drain();
+
     for (uint32_t i = 0; i < NUM_OF_LOGS; i++) LogFile_SaveRecords(i);
 
     if (Time_elapsed_msec(&ts) > 1000)
@@ -30,11 +30,20 @@
 #define EVNT_LOG_FNAME_SZ                (64)
 #define SSP_LOG_MODULE_NAME_SZ           (42)
 #define RTT_LOG_STR_SZ                   (128)
+#define LOG_FILE_LINE_MAX_SZ             (LOG_STR_MAX_SZ + EVNT_LOG_FNAME_SZ + 96)  // Record line in the log file: time stamps, function name and message
 
 #define EVENT_LOG_DISPLAY_ROW            22  // Количество строк лога выводимых на экран при автообновлении
 
 #define LOGGER_WR_TIMEOUT_MS             100
 
+#define LOG_FILE_WBUF_SZ                 (8192)  // Staging buffer of a log file, multiple of the SD card sector size
+#define LOG_FILE_FLUSH_PERIOD_MS         1000    // Maximum time written log text may stay in the staging buffer or FileX cache
+#define LOG_FILE_RATE_WINDOW_MS          1000    // Averaging window of the file write rate
+
+#define LOG_BIN_MAX_ARGS                 4   // Maximum number of 32-bit arguments of a binary log record
+#define LOG_BIN_MAX_RINGS                4   // Maximum number of registered binary log producer rings
+#define LOG_BIN_MOTOR_CAPACITY           64  // Должно быть степенью 2
+
 #define EVT_RESET_APP_FILE_LOG           BIT(0)
 #define EVT_RESET_NET_FILE_LOG           BIT(1)
 #define EVT_FILE_LOG_CMD_OK              BIT(2)
@@ -53,6 +62,44 @@ typedef struct
   unsigned int severity;
 } T_logger_record;
 
+// Compact binary log record. Text is expanded from the format string later in Logger_Task.
+typedef struct
+{
+  const char     *fmt;                     // Format string, must have static storage duration
+  const char     *func_name;               // Function name
+  T_sys_timestump timestump;               // Time of the log call
+  uint16_t        line_num;
+  uint8_t         severity;
+  uint8_t         nargs;                   // Number of used arguments
+  uint32_t        args[LOG_BIN_MAX_ARGS];  // Raw 32-bit arguments (integers, chars or pointers to static strings)
+} T_log_bin_record;
+
+// Single producer / single consumer ring of binary log records.
+// Each producer context (one thread or ISRs of one priority level) owns its ring, Logger_Task is the consumer.
+typedef struct
+{
+  const char       *name;
+  T_log_bin_record *records;
+  uint32_t          capacity;       // Number of records, power of 2
+  volatile uint32_t head;           // Free running write index, modified only by the producer
+  volatile uint32_t tail;           // Free running read index, modified only by the consumer
+  volatile uint32_t dropped;        // Records lost because the ring was full, modified only by the producer
+  uint32_t          dropped_shown;  // Dropped counter already reported to the log, modified only by the consumer
+} T_log_bin_ring;
+
+// Log file writer statistics
+typedef struct
+{
+  uint32_t        bytes_written;  // Bytes passed to fx_file_write
+  uint32_t        write_count;    // Number of fx_file_write calls
+  uint32_t        write_err;      // Number of failed fx_file_write calls
+  uint32_t        flush_count;    // Number of fx_media_flush calls
+  uint32_t        bytes_per_s;    // Write rate over the last LOG_FILE_RATE_WINDOW_MS
+  uint32_t        rate_bytes;     // Bytes written in the current rate window
+  uint32_t        rate_t0;        // Start of the current rate window [ticks]
+  T_cycle_profile write_profile;  // Time Logger_Task is blocked in file writes and flushes
+} T_log_file_stats;
+
 typedef struct
 {
   T_sys_timestump timestump;
@@ -85,18 +132,44 @@ typedef struct
 
   TX_MUTEX log_mutex;
   FX_FILE  log_file;
-  uint32_t t_prev;
+  uint32_t t_prev;                // Time of the last log file flush
   uint32_t t_now;
   uint8_t  log_file_opened;
+
+  uint8_t         *wbuf;          // Staging buffer of the log file
+  uint32_t         wbuf_fill;     // Number of bytes in the staging buffer
+  uint32_t         wbuf_limit;    // Fill level at which the buffer is written, ends on a LOG_FILE_WBUF_SZ aligned file offset
+  uint32_t         unflushed;     // Bytes written to the file since the last fx_media_flush
+  T_log_file_stats file_stats;
 } T_log_cbl;
 
 extern T_log_cbl app_log_cbl;
 extern T_log_cbl ssp_log_cbl;
 
+extern T_log_bin_ring motor_log_ring;  // Binary log ring of the motor driver thread
+
 #define APPLOG(...)  LOGs(__FUNCTION__, __LINE__, SEVERITY_RED, ##__VA_ARGS__);
 #define EAPPLOG(...) ELOGs(__FUNCTION__, __LINE__, SEVERITY_RED, ##__VA_ARGS__);
 #define NET_LOG(...) Net_LOGs(__FUNCTION__, __LINE__, SEVERITY_RED, ##__VA_ARGS__);
 
+// Binary logging into a producer ring without formatting at the call site.
+// Up to LOG_BIN_MAX_ARGS arguments, more arguments produce a compile error.
+// Log_bin_write stores every argument as 32 bits. Arguments must be integers of at most 32 bits or
+// pointers to static strings; 64-bit integers, float and double arguments produce a compile error
+// (negative array size in LOG_BIN_ARG_CHECK).
+#define LOG_BIN_NARGS_(fmt, a1, a2, a3, a4, a5, n, ...) n
+#define LOG_BIN_NARGS(...)                              LOG_BIN_NARGS_(__VA_ARGS__, LOG_BIN_TOO_MANY_ARGS, 4, 3, 2, 1, 0, 0)
+#define LOG_BIN_ARG_FITS(a)                             _Generic((a), float: 0, double: 0, long double: 0, char *: 1, const char *: 1, default: (sizeof(a) <= sizeof(uint32_t)))
+#define LOG_BIN_ARG_CHECK(a)                            (void)sizeof(char[LOG_BIN_ARG_FITS(a) ? 1 : -1]),
+#define LOG_BIN_CHECK_0(fmt)
+#define LOG_BIN_CHECK_1(fmt, a1)                        LOG_BIN_ARG_CHECK(a1)
+#define LOG_BIN_CHECK_2(fmt, a1, a2)                    LOG_BIN_ARG_CHECK(a1) LOG_BIN_ARG_CHECK(a2)
+#define LOG_BIN_CHECK_3(fmt, a1, a2, a3)                LOG_BIN_ARG_CHECK(a1) LOG_BIN_ARG_CHECK(a2) LOG_BIN_ARG_CHECK(a3)
+#define LOG_BIN_CHECK_4(fmt, a1, a2, a3, a4)            LOG_BIN_ARG_CHECK(a1) LOG_BIN_ARG_CHECK(a2) LOG_BIN_ARG_CHECK(a3) LOG_BIN_ARG_CHECK(a4)
+#define LOG_BIN_CHECK__(n, ...)                         LOG_BIN_CHECK_##n(__VA_ARGS__)
+#define LOG_BIN_CHECK_(n, ...)                          LOG_BIN_CHECK__(n, __VA_ARGS__)
+#define BINLOG(p_ring, ...)                             (LOG_BIN_CHECK_(LOG_BIN_NARGS(__VA_ARGS__), __VA_ARGS__) Log_bin_write(p_ring, __FUNCTION__, __LINE__, SEVERITY_RED, LOG_BIN_NARGS(__VA_ARGS__), __VA_ARGS__));
+
 void     App_log_disable(void);
 uint32_t Init_app_logger(void);
 
@@ -106,6 +179,9 @@ void LOGs(const char *name, unsigned int line_num, unsigned int severity, const
 void ELOGs(const char *name, unsigned int line_num, unsigned int severity, const char *fmt_ptr, ...);
 
 void Net_LOGs(const char *name, unsigned int line_num, unsigned int severity, const char *fmt_ptr, ...);
+void Log_bin_write(T_log_bin_ring *p_ring, const char *name, unsigned int line_num, unsigned int severity, uint32_t nargs, const char *fmt_ptr, ...);
+
+uint32_t Log_bin_ring_register(T_log_bin_ring *p_ring);
 void RTT_LOGs(const char *fmt_ptr, ...);
 
 uint32_t Logger_init(void);
@@ -116,6 +192,9 @@ int32_t  AppLog_get_tail_record(T_logger_record *rec);
 void     Req_to_reset_log_file(void);
 void     Req_to_reset_netlog_file(void);
 void     Set_file_logger_event(uint32_t events_mask);
+void     LogFile_get_stats(uint32_t log_id, T_log_file_stats *p_stats);
+void     LogFile_reset_stats(uint32_t log_id);
 uint32_t FreeMaster_get_app_log_string(char *str, uint32_t max_str_len);
+uint32_t Save_motion_buffer(uint32_t buf_indx);
 
 #endif
@@ -0,0 +1,514 @@
+#include "App.h"
+
+// Recorder control block. Fields marked (ISR) are modified in the ADC ISR while the recorder is running.
+typedef struct
+{
+  volatile uint32_t        state;                          // MREC_STATE_*
+  uint32_t                 channel_mask;
+  uint32_t                 channel_count;
+  uint32_t                 decimation;
+  uint32_t                 decim_cnt;                      // (ISR) PWM cycles since the last frame
+  uint32_t                 frame_rate_hz;
+  uint32_t                 half_words;                     // Samples in one buffer half, multiple of channel_count
+  uint32_t                 frames_per_half;
+  uint32_t                 wr_pos;                         // (ISR) Write position in the whole buffer [samples]
+  uint32_t                 frame_index;                    // (ISR) Index of the next frame from the recording start
+  uint32_t                 max_frames;                     // Frame index at which the recording stops, 0 - no limit
+  volatile uint32_t        half_frames[2];                 // Frames in a half waiting for Logger_Task, 0 - half is free
+  uint32_t                 half_first_frame[2];            // Index of the first frame stored in a half
+  volatile uint32_t        frames_captured;                // (ISR)
+  volatile uint32_t        frames_lost;                    // (ISR)
+  const volatile uint16_t *src[MREC_MAX_CHANNELS];         // Sample source of each recorded channel in frame order
+  rtc_time_t               start_time;
+
+  // Owned by Logger_Task
+  FX_FILE  file;
+  uint8_t  file_opened;
+  uint32_t frames_written;
+  uint32_t blocks_written;
+  uint32_t write_err;
+  char     file_name[MREC_FILE_PATH_SZ];
+} T_mrec_cbl;
+
+static T_mrec_cbl g_mrec;
+
+#ifdef LOG_TO_ONBOARD_SDRAM
+static uint16_t g_mrec_buf[MREC_BUF_WORDS] @ ".sdram";
+#else
+static uint16_t g_mrec_buf[MREC_BUF_WORDS];
+#endif
+
+T_cycle_profile g_mrec_write_profile;
+
+// Source of each channel. 32-bit Q16 filter states are read by their upper half, PWM levels by their lower half.
+// clang-format off
+static const volatile uint16_t *const g_mrec_ch_src[MREC_CH_COUNT] =
+{
+  [MREC_CH_I_U_M1]      = &adc.smpl_mot[ADC_MOTOR_1][ADC_MOT_I_U],
+  [MREC_CH_I_V_M1]      = &adc.smpl_mot[ADC_MOTOR_1][ADC_MOT_I_V],
+  [MREC_CH_I_W_M1]      = &adc.smpl_mot[ADC_MOTOR_1][ADC_MOT_I_W],
+  [MREC_CH_IPWR_M1]     = &adc.smpl_mot[ADC_MOTOR_1][ADC_MOT_IPWR],
+  [MREC_CH_SPEED_M1]    = &adc.smpl_mot[ADC_MOTOR_1][ADC_MOT_SPEED],
+  [MREC_CH_POS_M1]      = &adc.smpl_mot[ADC_MOTOR_1][ADC_MOT_POS],
+  [MREC_CH_I_U_M2]      = &adc.smpl_mot[ADC_MOTOR_2][ADC_MOT_I_U],
+  [MREC_CH_I_V_M2]      = &adc.smpl_mot[ADC_MOTOR_2][ADC_MOT_I_V],
+  [MREC_CH_I_W_M2]      = &adc.smpl_mot[ADC_MOTOR_2][ADC_MOT_I_W],
+  [MREC_CH_IPWR_M2]     = &adc.smpl_mot[ADC_MOTOR_2][ADC_MOT_IPWR],
+  [MREC_CH_SPEED_M2]    = &adc.smpl_mot[ADC_MOTOR_2][ADC_MOT_SPEED],
+  [MREC_CH_POS_M2]      = &adc.smpl_mot[ADC_MOTOR_2][ADC_MOT_POS],
+  [MREC_CH_V_U_M1]      = &adc.smpl_phase[ADC_PHASE_U][ADC_MOTOR_1],
+  [MREC_CH_V_U_M2]      = &adc.smpl_phase[ADC_PHASE_U][ADC_MOTOR_2],
+  [MREC_CH_V_V_M1]      = &adc.smpl_phase[ADC_PHASE_V][ADC_MOTOR_1],
+  [MREC_CH_V_V_M2]      = &adc.smpl_phase[ADC_PHASE_V][ADC_MOTOR_2],
+  [MREC_CH_V_W_M1]      = &adc.smpl_phase[ADC_PHASE_W][ADC_MOTOR_1],
+  [MREC_CH_V_W_M2]      = &adc.smpl_phase[ADC_PHASE_W][ADC_MOTOR_2],
+  [MREC_CH_I_U_FAST_M1] = (const volatile uint16_t *)&adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_I_U_FAST] + 1,
+  [MREC_CH_I_V_FAST_M1] = (const volatile uint16_t *)&adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_I_V_FAST] + 1,
+  [MREC_CH_I_W_FAST_M1] = (const volatile uint16_t *)&adc.filt_mot[ADC_MOTOR_1][ADC_MOT_FILT_I_W_FAST] + 1,
+  [MREC_CH_I_U_FAST_M2] = (const volatile uint16_t *)&adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_I_U_FAST] + 1,
+  [MREC_CH_I_V_FAST_M2] = (const volatile uint16_t *)&adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_I_V_FAST] + 1,
+  [MREC_CH_I_W_FAST_M2] = (const volatile uint16_t *)&adc.filt_mot[ADC_MOTOR_2][ADC_MOT_FILT_I_W_FAST] + 1,
+  [MREC_CH_PWM_U_M1]    = (const volatile uint16_t *)&g_pwm_phase_control.pwm_level[0][0],
+  [MREC_CH_PWM_V_M1]    = (const volatile uint16_t *)&g_pwm_phase_control.pwm_level[0][1],
+  [MREC_CH_PWM_W_M1]    = (const volatile uint16_t *)&g_pwm_phase_control.pwm_level[0][2],
+  [MREC_CH_PWM_U_M2]    = (const volatile uint16_t *)&g_pwm_phase_control.pwm_level[1][0],
+  [MREC_CH_PWM_V_M2]    = (const volatile uint16_t *)&g_pwm_phase_control.pwm_level[1][1],
+  [MREC_CH_PWM_W_M2]    = (const volatile uint16_t *)&g_pwm_phase_control.pwm_level[1][2],
+  [MREC_CH_V24V]        = &adc.smpl_dir[ADC_DIR_V24V],
+};
+
+static const char *const g_mrec_ch_names[MREC_CH_COUNT] =
+{
+  [MREC_CH_I_U_M1]      = "I_U_M1",
+  [MREC_CH_I_V_M1]      = "I_V_M1",
+  [MREC_CH_I_W_M1]      = "I_W_M1",
+  [MREC_CH_IPWR_M1]     = "IPWR_M1",
+  [MREC_CH_SPEED_M1]    = "SPEED_M1",
+  [MREC_CH_POS_M1]      = "POS_M1",
+  [MREC_CH_I_U_M2]      = "I_U_M2",
+  [MREC_CH_I_V_M2]      = "I_V_M2",
+  [MREC_CH_I_W_M2]      = "I_W_M2",
+  [MREC_CH_IPWR_M2]     = "IPWR_M2",
+  [MREC_CH_SPEED_M2]    = "SPEED_M2",
+  [MREC_CH_POS_M2]      = "POS_M2",
+  [MREC_CH_V_U_M1]      = "V_U_M1",
+  [MREC_CH_V_U_M2]      = "V_U_M2",
+  [MREC_CH_V_V_M1]      = "V_V_M1",
+  [MREC_CH_V_V_M2]      = "V_V_M2",
+  [MREC_CH_V_W_M1]      = "V_W_M1",
+  [MREC_CH_V_W_M2]      = "V_W_M2",
+  [MREC_CH_I_U_FAST_M1] = "I_U_FAST_M1",
+  [MREC_CH_I_V_FAST_M1] = "I_V_FAST_M1",
+  [MREC_CH_I_W_FAST_M1] = "I_W_FAST_M1",
+  [MREC_CH_I_U_FAST_M2] = "I_U_FAST_M2",
+  [MREC_CH_I_V_FAST_M2] = "I_V_FAST_M2",
+  [MREC_CH_I_W_FAST_M2] = "I_W_FAST_M2",
+  [MREC_CH_PWM_U_M1]    = "PWM_U_M1",
+  [MREC_CH_PWM_V_M1]    = "PWM_V_M1",
+  [MREC_CH_PWM_W_M1]    = "PWM_W_M1",
+  [MREC_CH_PWM_U_M2]    = "PWM_U_M2",
+  [MREC_CH_PWM_V_M2]    = "PWM_V_M2",
+  [MREC_CH_PWM_W_M2]    = "PWM_W_M2",
+  [MREC_CH_V24V]        = "V24V",
+};
+// clang-format on
+
+static void     _Mrec_finish(void);
+static uint32_t _Mrec_file_open(void);
+static void     _Mrec_file_close(void);
+static void     _Mrec_write_half(uint32_t half);
+
+/*-----------------------------------------------------------------------------------------------------
+  Configure and start a motion recording.
+  The file is created by Logger_Task when the first buffer half is ready.
+
+  Parameters:
+    channel_mask - recorded channels, bit n selects MREC_CH_n
+    decimation   - number of PWM cycles per recorded frame (1 - every PWM cycle)
+    duration_ms  - recording duration from start or trigger, 0 - until Motion_recorder_stop()
+    armed        - 1 to wait for Motion_recorder_trigger() before capturing, 0 to capture immediately
+
+  Return:
+    RES_OK on success, RES_ERROR if the recorder is busy or the parameters are invalid
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Motion_recorder_start(uint32_t channel_mask, uint32_t decimation, uint32_t duration_ms, uint32_t armed)
+{
+  uint32_t n = 0;
+
+  channel_mask &= (BIT(MREC_CH_COUNT) - 1);
+  if ((channel_mask == 0) || (decimation == 0) || (decimation > MREC_MAX_DECIMATION)) return RES_ERROR;
+  if (g_mrec.state != MREC_STATE_IDLE) return RES_ERROR;
+
+  for (uint32_t ch = 0; ch < MREC_CH_COUNT; ch++)
+  {
+    if (channel_mask & BIT(ch))
+    {
+      g_mrec.src[n++] = g_mrec_ch_src[ch];
+    }
+  }
+
+  g_mrec.channel_mask    = channel_mask;
+  g_mrec.channel_count   = n;
+  g_mrec.decimation      = decimation;
+  g_mrec.decim_cnt       = 0;
+  g_mrec.frame_rate_hz   = g_adc_pwm_frequency / decimation;
+  g_mrec.frames_per_half = (MREC_BUF_WORDS / 2) / n;
+  g_mrec.half_words      = g_mrec.frames_per_half * n;
+  g_mrec.wr_pos          = 0;
+  g_mrec.frame_index     = 0;
+  g_mrec.max_frames      = (uint32_t)(((uint64_t)duration_ms * g_mrec.frame_rate_hz) / 1000u);
+  g_mrec.half_frames[0]  = 0;
+  g_mrec.half_frames[1]  = 0;
+  g_mrec.frames_captured = 0;
+  g_mrec.frames_lost     = 0;
+  g_mrec.frames_written  = 0;
+  g_mrec.blocks_written  = 0;
+  g_mrec.write_err       = 0;
+  g_mrec.file_name[0]    = 0;
+  if ((duration_ms != 0) && (g_mrec.max_frames == 0)) g_mrec.max_frames = 1;
+
+  RTC_get_system_DateTime(&g_mrec.start_time);
+  g_mrec.start_time.tm_mon++;
+  g_mrec.start_time.tm_year += 1900;
+  Cycle_profile_reset(&g_mrec_write_profile);
+
+  __DMB();  // Configuration must be visible before the ISR sees the new state
+  g_mrec.state = (armed != 0) ? MREC_STATE_ARMED : MREC_STATE_RUNNING;
+  APPLOG("Motion recorder started: mask 0x%08X, %u channels, %u Hz, duration %u ms%s", (unsigned int)channel_mask, (unsigned int)n, (unsigned int)g_mrec.frame_rate_hz, (unsigned int)duration_ms, (armed != 0) ? ", armed" : "");
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Start capturing if the recorder is armed. Called on motion start events.
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Motion_recorder_trigger(void)
+{
+  TX_INTERRUPT_SAVE_AREA
+  TX_DISABLE
+  if (g_mrec.state == MREC_STATE_ARMED)
+  {
+    g_mrec.state = MREC_STATE_RUNNING;
+  }
+  TX_RESTORE
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Stop the recording. Captured data are written and the file is closed by Logger_Task.
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Motion_recorder_stop(void)
+{
+  TX_INTERRUPT_SAVE_AREA
+  TX_DISABLE
+  if ((g_mrec.state == MREC_STATE_ARMED) || (g_mrec.state == MREC_STATE_RUNNING))
+  {
+    _Mrec_finish();
+  }
+  TX_RESTORE
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  End the capture: hand the partially filled half to Logger_Task and let it close the file.
+  Called from the ADC ISR or with interrupts disabled.
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Mrec_finish(void)
+{
+  uint32_t half  = (g_mrec.wr_pos >= g_mrec.half_words) ? 1 : 0;
+  uint32_t words = g_mrec.wr_pos - half * g_mrec.half_words;
+
+  if (g_mrec.frame_index == 0)
+  {
+    g_mrec.state = MREC_STATE_IDLE;  // Nothing was captured, no file is created
+    return;
+  }
+  if (words != 0)
+  {
+    g_mrec.half_frames[half] = words / g_mrec.channel_count;
+  }
+  g_mrec.state = MREC_STATE_FLUSHING;
+  Set_file_logger_event((half == 0) ? EVT_MOTION_BUF_READY_FIRST_HALF : EVT_MOTION_BUF_READY_SECOND_HALF);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Capture one frame. Called from Adc_scan_end_isr once per PWM cycle after PWM levels are updated.
+  When a half of the buffer is full Logger_Task is signaled to write it. If Logger_Task has not yet
+  written the half that is to be filled next, frames are dropped and counted instead of overwriting data.
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Motion_recorder_isr(void)
+{
+  uint32_t  pos;
+  uint32_t  half;
+  uint16_t *p_dst;
+
+  if (g_mrec.state != MREC_STATE_RUNNING) return;
+  if (++g_mrec.decim_cnt < g_mrec.decimation) return;
+  g_mrec.decim_cnt = 0;
+
+  pos  = g_mrec.wr_pos;
+  half = (pos >= g_mrec.half_words) ? 1 : 0;
+
+  if (g_mrec.half_frames[half] != 0)
+  {
+    g_mrec.frames_lost++;  // The half is still waiting for Logger_Task
+  }
+  else
+  {
+    if (pos == half * g_mrec.half_words)
+    {
+      g_mrec.half_first_frame[half] = g_mrec.frame_index;
+    }
+    p_dst = &g_mrec_buf[pos];
+    for (uint32_t i = 0; i < g_mrec.channel_count; i++)
+    {
+      p_dst[i] = *g_mrec.src[i];
+    }
+    pos += g_mrec.channel_count;
+    g_mrec.frames_captured++;
+
+    if (pos == (half + 1) * g_mrec.half_words)
+    {
+      g_mrec.half_frames[half] = g_mrec.frames_per_half;
+      Set_file_logger_event((half == 0) ? EVT_MOTION_BUF_READY_FIRST_HALF : EVT_MOTION_BUF_READY_SECOND_HALF);
+      if (half != 0) pos = 0;
+    }
+    g_mrec.wr_pos = pos;
+  }
+  g_mrec.frame_index++;
+
+  if ((g_mrec.max_frames != 0) && (g_mrec.frame_index >= g_mrec.max_frames))
+  {
+    _Mrec_finish();
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Create the recording file and write the header with channel names
+
+  Parameters:
+    None
+
+  Return:
+    RES_OK on success, RES_ERROR on failure
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Mrec_file_open(void)
+{
+  T_mrec_file_header hdr;
+  char               name[MREC_CH_NAME_SZ];
+  rtc_time_t        *pt = &g_mrec.start_time;
+
+  // A non-empty file name marks that the file was already attempted for this recording
+  snprintf(g_mrec.file_name, MREC_FILE_PATH_SZ, MREC_FILE_PATH_FMT, pt->tm_year, pt->tm_mon, pt->tm_mday, pt->tm_hour, pt->tm_min, pt->tm_sec);
+  if (fx_file_create(&fat_fs_media, g_mrec.file_name) != FX_SUCCESS) return RES_ERROR;
+  if (fx_file_open(&fat_fs_media, &g_mrec.file, g_mrec.file_name, FX_OPEN_FOR_WRITE) != FX_SUCCESS) return RES_ERROR;
+  g_mrec.file_opened = 1;
+
+  memset(&hdr, 0, sizeof(hdr));
+  hdr.magic         = MREC_FILE_MAGIC;
+  hdr.version       = MREC_FILE_VERSION;
+  hdr.header_size   = (uint16_t)(sizeof(hdr) + g_mrec.channel_count * MREC_CH_NAME_SZ);
+  hdr.frame_rate_hz = g_mrec.frame_rate_hz;
+  hdr.pwm_frequency = g_adc_pwm_frequency;
+  hdr.decimation    = (uint16_t)g_mrec.decimation;
+  hdr.channel_count = (uint16_t)g_mrec.channel_count;
+  hdr.channel_mask  = g_mrec.channel_mask;
+  hdr.year          = (uint16_t)pt->tm_year;
+  hdr.month         = (uint8_t)pt->tm_mon;
+  hdr.day           = (uint8_t)pt->tm_mday;
+  hdr.hour          = (uint8_t)pt->tm_hour;
+  hdr.minute        = (uint8_t)pt->tm_min;
+  hdr.second        = (uint8_t)pt->tm_sec;
+  if (fx_file_write(&g_mrec.file, &hdr, sizeof(hdr)) != FX_SUCCESS) return RES_ERROR;
+
+  for (uint32_t ch = 0; ch < MREC_CH_COUNT; ch++)
+  {
+    if (g_mrec.channel_mask & BIT(ch))
+    {
+      memset(name, 0, sizeof(name));
+      strncpy(name, g_mrec_ch_names[ch], MREC_CH_NAME_SZ - 1);
+      if (fx_file_write(&g_mrec.file, name, MREC_CH_NAME_SZ) != FX_SUCCESS) return RES_ERROR;
+    }
+  }
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Update final frame counters in the file header and close the recording file
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Mrec_file_close(void)
+{
+  T_mrec_file_header hdr;
+  ULONG              actual;
+
+  if (g_mrec.file_opened == 0) return;
+
+  if ((fx_file_seek(&g_mrec.file, 0) == FX_SUCCESS) && (fx_file_read(&g_mrec.file, &hdr, sizeof(hdr), &actual) == FX_SUCCESS) && (actual == sizeof(hdr)))
+  {
+    hdr.frames_total = g_mrec.frame_index;
+    hdr.frames_lost  = g_mrec.frames_lost;
+    if ((fx_file_seek(&g_mrec.file, 0) != FX_SUCCESS) || (fx_file_write(&g_mrec.file, &hdr, sizeof(hdr)) != FX_SUCCESS))
+    {
+      g_mrec.write_err++;
+    }
+  }
+  else
+  {
+    g_mrec.write_err++;
+  }
+  fx_file_close(&g_mrec.file);
+  fx_media_flush(&fat_fs_media);
+  g_mrec.file_opened = 0;
+  APPLOG("Motion recorder: file %s closed, %u frames written, %u lost", g_mrec.file_name, (unsigned int)g_mrec.frames_written, (unsigned int)g_mrec.frames_lost);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Write one buffer half as a data block and release it for the ISR
+
+  Parameters:
+    half - buffer half index (0 or 1)
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Mrec_write_half(uint32_t half)
+{
+  T_mrec_block_header blk;
+  uint32_t            t_start = CYCLE_PROFILER_NOW();
+
+  blk.magic       = MREC_BLOCK_MAGIC;
+  blk.first_frame = g_mrec.half_first_frame[half];
+  blk.frame_count = g_mrec.half_frames[half];
+
+  if (g_mrec.file_opened != 0)
+  {
+    if ((fx_file_write(&g_mrec.file, &blk, sizeof(blk)) == FX_SUCCESS) &&
+        (fx_file_write(&g_mrec.file, &g_mrec_buf[half * g_mrec.half_words], blk.frame_count * g_mrec.channel_count * sizeof(uint16_t)) == FX_SUCCESS))
+    {
+      g_mrec.frames_written += blk.frame_count;
+      g_mrec.blocks_written++;
+    }
+    else
+    {
+      g_mrec.write_err++;
+    }
+  }
+  Cycle_profile_update(&g_mrec_write_profile, t_start, CYCLE_PROFILER_NOW());
+
+  __DMB();  // Data must be read before the half is released
+  g_mrec.half_frames[half] = 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Write ready halves of the motion buffer to the recording file. Called by Logger_Task on
+  EVT_MOTION_BUF_READY_FIRST_HALF / EVT_MOTION_BUF_READY_SECOND_HALF events.
+  Halves are written in capture order regardless of which event was received.
+
+  Parameters:
+    buf_indx - index of the half that raised the event
+
+  Return:
+    RES_OK on success, RES_ERROR if the file could not be created
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Save_motion_buffer(uint32_t buf_indx)
+{
+  uint32_t res   = RES_OK;
+  uint32_t state = g_mrec.state;  // Read before the halves so that a finish in the ISR is not missed
+  uint32_t half;
+
+  if ((g_mrec.file_name[0] == 0) && (state != MREC_STATE_IDLE))
+  {
+    if (_Mrec_file_open() != RES_OK)
+    {
+      g_mrec.write_err++;
+      res = RES_ERROR;
+      APPLOG("Motion recorder: failed to create file %s", g_mrec.file_name);
+    }
+  }
+
+  while ((g_mrec.half_frames[0] != 0) || (g_mrec.half_frames[1] != 0))
+  {
+    if ((g_mrec.half_frames[0] != 0) && (g_mrec.half_frames[1] != 0))
+    {
+      half = (g_mrec.half_first_frame[0] < g_mrec.half_first_frame[1]) ? 0 : 1;
+    }
+    else
+    {
+      half = (g_mrec.half_frames[0] != 0) ? 0 : 1;
+    }
+    _Mrec_write_half(half);
+  }
+
+  if (state == MREC_STATE_FLUSHING)
+  {
+    _Mrec_file_close();
+    g_mrec.state = MREC_STATE_IDLE;
+  }
+  return res;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Get recorder status
+
+  Parameters:
+    p_status - pointer to status structure to fill
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Motion_recorder_get_status(T_mrec_status *p_status)
+{
+  p_status->state           = g_mrec.state;
+  p_status->channel_mask    = g_mrec.channel_mask;
+  p_status->channel_count   = g_mrec.channel_count;
+  p_status->decimation      = g_mrec.decimation;
+  p_status->frame_rate_hz   = g_mrec.frame_rate_hz;
+  p_status->frames_captured = g_mrec.frames_captured;
+  p_status->frames_lost     = g_mrec.frames_lost;
+  p_status->frames_written  = g_mrec.frames_written;
+  p_status->blocks_written  = g_mrec.blocks_written;
+  p_status->write_err       = g_mrec.write_err;
+  memcpy(p_status->file_name, g_mrec.file_name, MREC_FILE_PATH_SZ);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Get name of a recorder channel
+
+  Parameters:
+    ch - channel index MREC_CH_*
+
+  Return:
+    Channel name, empty string for invalid index
+-----------------------------------------------------------------------------------------------------*/
+const char *Motion_recorder_channel_name(uint32_t ch)
+{
+  if (ch >= MREC_CH_COUNT) return "";
+  return g_mrec_ch_names[ch];
+}
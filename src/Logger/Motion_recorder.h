@@ -0,0 +1,117 @@
+#ifndef MOTION_RECORDER_H
+#define MOTION_RECORDER_H
+
+#define MREC_FILE_MAGIC          0x4345524Du  // "MREC" in little endian byte order
+#define MREC_BLOCK_MAGIC         0x4B4C424Du  // "MBLK" in little endian byte order
+#define MREC_FILE_VERSION        1
+#define MREC_FILE_PATH_FMT       "\\mrec_%04u%02u%02u_%02u%02u%02u.bin"
+#define MREC_FILE_PATH_SZ        32
+
+#define MREC_BUF_WORDS           (32768)  // Ping-pong buffer size in 16-bit samples, both halves together
+#define MREC_MAX_CHANNELS        32       // Number of bits in the channel mask
+#define MREC_CH_NAME_SZ          12       // Channel name field size in the file header
+#define MREC_MAX_DECIMATION      1000
+
+// Recorder channels. Bit n of the channel mask selects channel n. Every channel is stored as 16-bit sample.
+#define MREC_CH_I_U_M1           0   // Motor 1 U phase current, raw ADC
+#define MREC_CH_I_V_M1           1   // Motor 1 V phase current, raw ADC
+#define MREC_CH_I_W_M1           2   // Motor 1 W phase current, raw ADC
+#define MREC_CH_IPWR_M1          3   // Motor 1 power supply current, raw ADC
+#define MREC_CH_SPEED_M1         4   // Motor 1 speed sensor, raw ADC
+#define MREC_CH_POS_M1           5   // Motor 1 position sensor, raw ADC
+#define MREC_CH_I_U_M2           6   // Motor 2 U phase current, raw ADC
+#define MREC_CH_I_V_M2           7   // Motor 2 V phase current, raw ADC
+#define MREC_CH_I_W_M2           8   // Motor 2 W phase current, raw ADC
+#define MREC_CH_IPWR_M2          9   // Motor 2 power supply current, raw ADC
+#define MREC_CH_SPEED_M2         10  // Motor 2 speed sensor, raw ADC
+#define MREC_CH_POS_M2           11  // Motor 2 position sensor, raw ADC
+#define MREC_CH_V_U_M1           12  // Motor 1 U phase voltage, raw ADC
+#define MREC_CH_V_U_M2           13  // Motor 2 U phase voltage, raw ADC
+#define MREC_CH_V_V_M1           14  // Motor 1 V phase voltage, raw ADC
+#define MREC_CH_V_V_M2           15  // Motor 2 V phase voltage, raw ADC
+#define MREC_CH_V_W_M1           16  // Motor 1 W phase voltage, raw ADC
+#define MREC_CH_V_W_M2           17  // Motor 2 W phase voltage, raw ADC
+#define MREC_CH_I_U_FAST_M1      18  // Motor 1 U phase current, fast EMA filter (integer part of Q16)
+#define MREC_CH_I_V_FAST_M1      19  // Motor 1 V phase current, fast EMA filter (integer part of Q16)
+#define MREC_CH_I_W_FAST_M1      20  // Motor 1 W phase current, fast EMA filter (integer part of Q16)
+#define MREC_CH_I_U_FAST_M2      21  // Motor 2 U phase current, fast EMA filter (integer part of Q16)
+#define MREC_CH_I_V_FAST_M2      22  // Motor 2 V phase current, fast EMA filter (integer part of Q16)
+#define MREC_CH_I_W_FAST_M2      23  // Motor 2 W phase current, fast EMA filter (integer part of Q16)
+#define MREC_CH_PWM_U_M1         24  // Motor 1 U phase PWM level in steps
+#define MREC_CH_PWM_V_M1         25  // Motor 1 V phase PWM level in steps
+#define MREC_CH_PWM_W_M1         26  // Motor 1 W phase PWM level in steps
+#define MREC_CH_PWM_U_M2         27  // Motor 2 U phase PWM level in steps
+#define MREC_CH_PWM_V_M2         28  // Motor 2 V phase PWM level in steps
+#define MREC_CH_PWM_W_M2         29  // Motor 2 W phase PWM level in steps
+#define MREC_CH_V24V             30  // System +24V input, raw ADC
+#define MREC_CH_COUNT            31
+
+// Default channel set: phase currents and PWM levels of both motors
+#define MREC_DEFAULT_CHANNELS    (BIT(MREC_CH_I_U_M1) | BIT(MREC_CH_I_V_M1) | BIT(MREC_CH_I_W_M1) | \
+                                  BIT(MREC_CH_I_U_M2) | BIT(MREC_CH_I_V_M2) | BIT(MREC_CH_I_W_M2) | \
+                                  BIT(MREC_CH_PWM_U_M1) | BIT(MREC_CH_PWM_V_M1) | BIT(MREC_CH_PWM_W_M1) | \
+                                  BIT(MREC_CH_PWM_U_M2) | BIT(MREC_CH_PWM_V_M2) | BIT(MREC_CH_PWM_W_M2))
+
+// Recorder states
+#define MREC_STATE_IDLE          0  // Not recording
+#define MREC_STATE_ARMED         1  // Waiting for Motion_recorder_trigger()
+#define MREC_STATE_RUNNING       2  // Capturing frames in the ADC ISR
+#define MREC_STATE_FLUSHING      3  // Capture finished, Logger_Task writes remaining data and closes the file
+
+// File header. Followed by channel_count channel names of MREC_CH_NAME_SZ bytes each and then by data blocks.
+typedef struct
+{
+  uint32_t magic;           // MREC_FILE_MAGIC
+  uint16_t version;         // MREC_FILE_VERSION
+  uint16_t header_size;     // Size of this header plus channel names, offset of the first data block
+  uint32_t frame_rate_hz;   // Frame rate: PWM frequency divided by decimation
+  uint32_t pwm_frequency;   // PWM frequency [Hz]
+  uint16_t decimation;      // Number of PWM cycles per frame
+  uint16_t channel_count;   // Number of 16-bit samples in one frame
+  uint32_t channel_mask;    // Recorded channels, bit n = MREC_CH_n, samples in a frame follow bit order
+  uint32_t frames_total;    // Number of frame indexes covered by the recording, updated when the file is closed
+  uint32_t frames_lost;     // Frames dropped because Logger_Task did not keep up, updated when the file is closed
+  uint16_t year;            // Start date and time
+  uint8_t  month;
+  uint8_t  day;
+  uint8_t  hour;
+  uint8_t  minute;
+  uint8_t  second;
+  uint8_t  reserved;
+} T_mrec_file_header;
+
+// Header of a data block. Followed by frame_count frames of channel_count 16-bit samples.
+// A gap between first_frame of a block and the end of the previous block marks lost frames.
+typedef struct
+{
+  uint32_t magic;        // MREC_BLOCK_MAGIC
+  uint32_t first_frame;  // Index of the first frame of the block from the recording start
+  uint32_t frame_count;  // Number of frames in the block
+} T_mrec_block_header;
+
+// Recorder status for display
+typedef struct
+{
+  uint32_t state;             // MREC_STATE_*
+  uint32_t channel_mask;
+  uint32_t channel_count;
+  uint32_t decimation;
+  uint32_t frame_rate_hz;
+  uint32_t frames_captured;   // Frames stored into the ping-pong buffer
+  uint32_t frames_lost;       // Frames dropped because both halves were waiting for Logger_Task
+  uint32_t frames_written;    // Frames written to the file
+  uint32_t blocks_written;    // Number of data blocks written to the file
+  uint32_t write_err;         // Number of file operation errors
+  char     file_name[MREC_FILE_PATH_SZ];
+} T_mrec_status;
+
+extern T_cycle_profile g_mrec_write_profile;  // Time Logger_Task spends writing one data block
+
+uint32_t    Motion_recorder_start(uint32_t channel_mask, uint32_t decimation, uint32_t duration_ms, uint32_t armed);
+void        Motion_recorder_trigger(void);
+void        Motion_recorder_stop(void);
+void        Motion_recorder_isr(void);
+void        Motion_recorder_get_status(T_mrec_status *p_status);
+const char *Motion_recorder_channel_name(uint32_t ch);
+
+#endif  // MOTION_RECORDER_H
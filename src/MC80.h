@@ -269,9 +269,11 @@ typedef struct
 
 } T_sys_timestump;
 
+#ifndef MC80_HOST_BUILD
 #include "jansson.h"
 #include "Params_Types.h"
 #include "Parameters_manager.h"
+#include "Parameters_JSON_stream.h"
 #include "Parameters_serializer.h"
 #include "Parameters_deserializer.h"
 #include "MC80_Params.h"
@@ -280,8 +282,10 @@ typedef struct
 #include "String_utils.h"
 #include "DSP_Filters.h"
 #include "Time_utils.h"
+#include "Cycle_profiler.h"
 #include "compress.h"
 #include "NV_store.h"
+#include "NV_journal.h"
 
 #include "MC80V1_pins.h"
 #include "ADC_driver.h"
@@ -297,6 +301,7 @@ typedef struct
 
 #include "Memory_manager.h"
 #include "Logger.h"
+#include "Motion_recorder.h"
 
 #include "FS_init.h"
 #include "FS_utils.h"
@@ -319,6 +324,7 @@ typedef struct
 #include "freemaster.h"
 #include "FreeMaster_thread.h"
 #include "FreeMaster_command_handler.h"
+#include "FreeMaster_recorder.h"
 #include "Monitor_VT100_manager.h"
 #include "Monitor_utilites.h"
 #include "Monitor_access_control.h"
@@ -331,6 +337,8 @@ typedef struct
 #include "Led_blink.h"
 #include "Monitor_Motor.h"
 #include "Monitor_CAN.h"
+#include "Monitor_Perf.h"
+#include "Monitor_Recorder.h"
 #include "Monitor_LittleFS.h"
 #include "Monitor_OSPI.h"
 #include "Monitor_RTT.h"
@@ -338,7 +346,13 @@ typedef struct
 #include "System_error_flags.h"
 #include "CAN_message_handler.h"
 #include "CAN_parameter_exchange.h"
+#include "CAN_afl.h"
+#include "Motor_Ramp.h"
 #include "Motor_Soft_Start.h"
+#else
+#include "Host_app.h"  // Headers of the modules compiled by the host build, see host/README.md
+#endif
+
 
 
 extern uint8_t g_file_system_ready;
@@ -129,11 +129,10 @@ static void Main_thread_func(ULONG thread_input)
   // Normal mode: start GUI
   GUI_start();
 #endif
-  Can_thread_create();
-
   Motor_thread_create();
-  // Initialize CAN message handler
+  // Initialize CAN message handler, the CAN acceptance filter is built from its handlers when the CAN task opens the channel
   Can_message_handler_init();
+  Can_thread_create();
 
 
   while (1)
@@ -170,6 +169,9 @@ static void Main_thread_func(ULONG thread_input)
 
     Led_blink_func();
 
+    // Publish periodic and change triggered CAN telemetry
+    Can_telemetry_tick();
+
     // Check CAN communication status every 50ms (5 x 10ms)
     can_check_counter++;
     if (can_check_counter >= 5)
@@ -10,6 +10,10 @@ uint8_t g_drv2_en_state                       = 0;  // Driver 2 enable state (0
 // Global structure for maximum phase current tracking for all 4 motors
 T_max_current_tracking g_max_current_tracking = { 0 };
 
+// Execution time profiles of the motor driver main loop (accessible from diagnostic terminal)
+T_cycle_profile g_motor_loop_profile;
+T_cycle_profile g_soft_start_profile;
+
 // Individual maximum current variables for easy FreeMaster access
 // Motor 1  max currents
 float g_max_current_motor1_accel              = 0.0f;  // Motor 1 maximum current during acceleration [A]
@@ -53,6 +57,15 @@ T_pwm_phase_control g_pwm_phase_control;
 
 TX_QUEUE g_motor_command_queue;
 
+// Motor command drain state and latency statistics
+#define MOTOR_CMD_MASK(motor_num) (((motor_num) == 0) ? 0x0Fu : (((motor_num) <= 4) ? (1u << ((motor_num) - 1)) : 0u))
+
+static T_motor_command           g_pending_cmd;            // Command received while waiting for the next tick
+static uint8_t                   g_pending_cmd_valid = 0;  // g_pending_cmd holds a command not yet executed
+static T_motor_cmd_latency_stats g_motor_cmd_latency;      // Enqueue-to-apply latency statistics
+static volatile uint8_t          g_estop_cleanup_pending;  // MOTOR_CMD_MASK of motors stopped from an ISR whose command was not queued
+const uint32_t                   g_motor_cmd_latency_edges_us[MOTOR_CMD_LATENCY_BINS] = { 50, 100, 250, 500, 1000, 2000, 5000, UINT32_MAX };
+
 // Motor calibration event flag group for inter-thread communication
 TX_EVENT_FLAGS_GROUP g_motor_calibration_events;
 
@@ -64,6 +77,10 @@ static volatile uint8_t g_motor_driver_ready = 0;
 
 static void     Motor_driver_func(ULONG thread_input);
 static void     _Process_motor_commands(void);
+static void     _Execute_motor_command(const T_motor_command *p_cmd, uint32_t skip_mask);
+static uint32_t _Coalesce_motor_commands(const T_motor_command *p_cmds, uint32_t count, uint8_t *p_keep);
+static void     _Account_motor_command_latency(const T_motor_command *p_cmd);
+static void     _Wait_next_tick_with_commands(void);
 static void     _Init_motor_command_queue(void);
 static void     _Set_motor_pwm(uint8_t motor_num, uint8_t direction, uint16_t pwm_percent);
 static void     _Clear_motor_phases(uint8_t motor_num);
@@ -79,7 +96,9 @@ static uint32_t _Clear_motor_commands_from_queue(uint8_t motor_num);
 static uint8_t  _Get_paired_motor(uint8_t motor_num);
 static uint8_t  _Check_direction_change_for_running_motor(uint8_t motor_num, uint8_t new_direction);
 static uint8_t  _Is_motor_in_emergency_stop(uint8_t motor_num);
+static bool     _Apply_motor_dynamic_braking(uint8_t motor_num);
 static void     _Set_motor_dynamic_braking(uint8_t motor_num);
+static void     _Apply_emergency_stop_state(uint8_t motor_num);
 static void     _Update_emergency_stop_motor_shared_phase(uint8_t motor_num, uint32_t new_shared_phase_level);
 static uint8_t  _Is_motor_already_executing_command(uint8_t motor_num, uint8_t cmd_type, uint8_t direction);
 static void     _Check_overcurrent_overtemperature_protection(void);
@@ -584,7 +603,7 @@ static void _Set_motor_pwm(uint8_t motor_num, uint8_t direction, uint16_t pwm_pe
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Process motor commands from the command queue.
+  Execute a single motor command.
   4 DC motors are connected to 6 PWM phases on the board:
 
   Motor 1: Connected between U1-V1
@@ -609,128 +628,315 @@ static void _Set_motor_pwm(uint8_t motor_num, uint8_t direction, uint16_t pwm_pe
   - This ensures proper motor rotation according to shared phase control logic and user inversion preferences
 
   Parameters:
-    None
+    p_cmd     - command to execute
+    skip_mask - motors (MOTOR_CMD_MASK bits) excluded from "all motors" COAST command
 
   Return:
     None
 -----------------------------------------------------------------------------------------------------*/
-static void _Process_motor_commands(void)
+static void _Execute_motor_command(const T_motor_command *p_cmd, uint32_t skip_mask)
 {
-  T_motor_command cmd;
-  UINT            queue_status;
-
-  // Process motor commands from queue
-  queue_status = tx_queue_receive(&g_motor_command_queue, &cmd, TX_NO_WAIT);
-  if (queue_status == TX_SUCCESS)
+  switch (p_cmd->cmd_type)
   {
-    switch (cmd.cmd_type)
-    {
-      case MOTOR_CMD_COAST:
-        if (cmd.motor_num >= 1 && cmd.motor_num <= 4)
+    case MOTOR_CMD_COAST:
+      if (p_cmd->motor_num >= 1 && p_cmd->motor_num <= 4)
+      {
+        // Check if motor is already executing the same command - ignore duplicate
+        if (_Is_motor_already_executing_command(p_cmd->motor_num, p_cmd->cmd_type, MOTOR_DIRECTION_STOP))
         {
-          // Check if motor is already executing the same command - ignore duplicate
-          if (_Is_motor_already_executing_command(cmd.motor_num, cmd.cmd_type, MOTOR_DIRECTION_STOP))
-          {
-            APPLOG("Motor %u (%s) COAST command ignored - motor already coasting", (unsigned int)cmd.motor_num, Get_motor_name(cmd.motor_num));
-            break;                     // Ignore duplicate command
-          }
-
-          _Stop_motor(cmd.motor_num);  // Motor driver EN signals are controlled from terminal
-          APPLOG("Motor %u (%s) COAST command executed", (unsigned int)cmd.motor_num, Get_motor_name(cmd.motor_num));
+          MOTLOG("Motor %u (%s) COAST command ignored - motor already coasting", (unsigned int)p_cmd->motor_num, Get_motor_name(p_cmd->motor_num));
+          break;                     // Ignore duplicate command
         }
-        else if (cmd.motor_num == 0)
+
+        _Stop_motor(p_cmd->motor_num);  // Motor driver EN signals are controlled from terminal
+        MOTLOG("Motor %u (%s) COAST command executed", (unsigned int)p_cmd->motor_num, Get_motor_name(p_cmd->motor_num));
+      }
+      else if (p_cmd->motor_num == 0)
+      {
+        // Stop all motors except those already in emergency stop within the same batch
+        for (uint8_t i = 1; i <= 4; i++)
         {
-          // Stop all motors
-          for (uint8_t i = 1; i <= 4; i++)
+          if ((skip_mask & MOTOR_CMD_MASK(i)) == 0)
           {
             _Stop_motor(i);
-          }  // Motor driver EN signals are controlled from terminal
-          APPLOG("All motors COAST command executed");
-        }
-        break;
-      case MOTOR_CMD_SOFT_START:
-        if (cmd.motor_num >= 1 && cmd.motor_num <= 4)
+          }
+        }  // Motor driver EN signals are controlled from terminal
+        MOTLOG("All motors COAST command executed");
+      }
+      break;
+    case MOTOR_CMD_SOFT_START:
+      if (p_cmd->motor_num >= 1 && p_cmd->motor_num <= 4)
+      {
+        // Get actual direction considering inversion flag
+        uint8_t actual_direction = _Get_actual_motor_direction(p_cmd->motor_num, p_cmd->direction);
+
+        // A jerk limited profile continues to the new PWM from its current level and acceleration
+        if (Motor_soft_start_retarget(p_cmd->motor_num, p_cmd->pwm_level, p_cmd->direction) == 0)
         {
-          // Get actual direction considering inversion flag
-          uint8_t actual_direction = _Get_actual_motor_direction(cmd.motor_num, cmd.direction);
+          MOTLOG("Motor %u (%s) soft start target changed to %u%%", (unsigned int)p_cmd->motor_num, Get_motor_name(p_cmd->motor_num), (unsigned int)p_cmd->pwm_level);
+          break;
+        }
 
-          // Check if motor is already executing the same command - ignore duplicate
-          if (_Is_motor_already_executing_command(cmd.motor_num, cmd.cmd_type, actual_direction))
-          {
-            APPLOG("Motor %u (%s) SOFT_START command ignored - motor already doing soft start to %u%% in direction %u",
-                   (unsigned int)cmd.motor_num, Get_motor_name(cmd.motor_num),
-                   (unsigned int)cmd.pwm_level, (unsigned int)actual_direction);
-            break;  // Ignore duplicate command
-          }
+        // Check if motor is already executing the same command - ignore duplicate
+        if (_Is_motor_already_executing_command(p_cmd->motor_num, p_cmd->cmd_type, actual_direction))
+        {
+          MOTLOG("Motor %u (%s) SOFT_START command ignored - motor already doing soft start to %u%% in direction %u",
+                 (unsigned int)p_cmd->motor_num, Get_motor_name(p_cmd->motor_num),
+                 (unsigned int)p_cmd->pwm_level, (unsigned int)actual_direction);
+          break;  // Ignore duplicate command
+        }
 
-          // Check if running motor is receiving direction change command - if so, initiate soft stop instead
-          if (_Check_direction_change_for_running_motor(cmd.motor_num, actual_direction))
-          {
-            APPLOG("Motor %u (%s) SOFT_START command with direction change detected - initiating soft stop instead (current: %u, requested: %u)",
-                   (unsigned int)cmd.motor_num, Get_motor_name(cmd.motor_num),
-                   (unsigned int)g_motor_states[cmd.motor_num - 1].direction, (unsigned int)actual_direction);
-            Motor_command_soft_stop(cmd.motor_num);  // Initiate soft stop instead of direction change
-            break;
-          }
+        // Check if running motor is receiving direction change command - if so, initiate soft stop instead
+        if (_Check_direction_change_for_running_motor(p_cmd->motor_num, actual_direction))
+        {
+          MOTLOG("Motor %u (%s) SOFT_START command with direction change detected - initiating soft stop instead (current: %u, requested: %u)",
+                 (unsigned int)p_cmd->motor_num, Get_motor_name(p_cmd->motor_num),
+                 (unsigned int)g_motor_states[p_cmd->motor_num - 1].direction, (unsigned int)actual_direction);
+          Motor_command_soft_stop(p_cmd->motor_num);  // Initiate soft stop instead of direction change
+          break;
+        }
 
-          // Start soft start with specified parameters
-          uint32_t result = Motor_soft_start_begin(cmd.motor_num, cmd.pwm_level, cmd.direction);
+        // Start soft start with specified parameters
+        uint32_t result = Motor_soft_start_begin(p_cmd->motor_num, p_cmd->pwm_level, p_cmd->direction);
 
-          if (result == 0)
-          {
-            // Reset maximum currents at the start of motor movement
-            _Reset_motor_max_currents_on_start(cmd.motor_num);
+        if (result == 0)
+        {
+          // Reset maximum currents at the start of motor movement
+          _Reset_motor_max_currents_on_start(p_cmd->motor_num);
+          Motion_recorder_trigger();  // Start an armed motion recording
 
-            APPLOG("Motor %u (%s) soft start command executed: target PWM %u%%, direction %u",
-                   (unsigned int)cmd.motor_num, Get_motor_name(cmd.motor_num), (unsigned int)cmd.pwm_level, (unsigned int)cmd.direction);
-          }
-          else
-          {
-            APPLOG("Motor %u (%s) soft start command failed with error %u", (unsigned int)cmd.motor_num, Get_motor_name(cmd.motor_num), (unsigned int)result);
-          }
+          MOTLOG("Motor %u (%s) soft start command executed: target PWM %u%%, direction %u",
+                 (unsigned int)p_cmd->motor_num, Get_motor_name(p_cmd->motor_num), (unsigned int)p_cmd->pwm_level, (unsigned int)p_cmd->direction);
         }
-        break;
-      case MOTOR_CMD_SOFT_STOP:
-        if (cmd.motor_num >= 1 && cmd.motor_num <= 4)
+        else
         {
-          // Check if motor is already executing the same command - ignore duplicate
-          if (_Is_motor_already_executing_command(cmd.motor_num, cmd.cmd_type, MOTOR_DIRECTION_STOP))
-          {
-            APPLOG("Motor %u (%s) SOFT_STOP command ignored - motor already stopping or stopped", (unsigned int)cmd.motor_num, Get_motor_name(cmd.motor_num));
-            break;  // Ignore duplicate command
-          }
+          MOTLOG("Motor %u (%s) soft start command failed with error %u", (unsigned int)p_cmd->motor_num, Get_motor_name(p_cmd->motor_num), (unsigned int)result);
+        }
+      }
+      break;
+    case MOTOR_CMD_SOFT_STOP:
+      if (p_cmd->motor_num >= 1 && p_cmd->motor_num <= 4)
+      {
+        // Check if motor is already executing the same command - ignore duplicate
+        if (_Is_motor_already_executing_command(p_cmd->motor_num, p_cmd->cmd_type, MOTOR_DIRECTION_STOP))
+        {
+          MOTLOG("Motor %u (%s) SOFT_STOP command ignored - motor already stopping or stopped", (unsigned int)p_cmd->motor_num, Get_motor_name(p_cmd->motor_num));
+          break;  // Ignore duplicate command
+        }
 
-          // Start soft stop
-          uint32_t result = Motor_soft_start_stop(cmd.motor_num);
+        // Start soft stop
+        uint32_t result = Motor_soft_start_stop(p_cmd->motor_num);
 
-          if (result == 0)
-          {
-            APPLOG("Motor %u (%s) soft stop command executed", (unsigned int)cmd.motor_num, Get_motor_name(cmd.motor_num));
-          }
-          else
-          {
-            APPLOG("Motor %u (%s) soft stop command failed with error %u", (unsigned int)cmd.motor_num, Get_motor_name(cmd.motor_num), (unsigned int)result);
-          }
-        }
-        break;
-      case MOTOR_CMD_EMERGENCY_STOP:
-        if (cmd.motor_num >= 1 && cmd.motor_num <= 4)
+        if (result == 0)
         {
-          // Emergency stop without ramping (direct call for consistency)
-          Motor_emergency_stop_direct(cmd.motor_num);
-          APPLOG("Motor %u (%s) emergency stop command executed (direct)", (unsigned int)cmd.motor_num, Get_motor_name(cmd.motor_num));
+          MOTLOG("Motor %u (%s) soft stop command executed", (unsigned int)p_cmd->motor_num, Get_motor_name(p_cmd->motor_num));
         }
-        else if (cmd.motor_num == 0)
+        else
         {
-          // Emergency stop all motors (direct call for consistency)
-          Motor_emergency_stop_direct(0);
-          APPLOG("All motors emergency stop command executed (direct)");
+          MOTLOG("Motor %u (%s) soft stop command failed with error %u", (unsigned int)p_cmd->motor_num, Get_motor_name(p_cmd->motor_num), (unsigned int)result);
         }
-        break;
+      }
+      break;
+    case MOTOR_CMD_EMERGENCY_STOP:
+      if (p_cmd->motor_num >= 1 && p_cmd->motor_num <= 4)
+      {
+        // Emergency stop without ramping (direct call for consistency)
+        Motor_emergency_stop_direct(p_cmd->motor_num);
+        MOTLOG("Motor %u (%s) emergency stop command executed (direct)", (unsigned int)p_cmd->motor_num, Get_motor_name(p_cmd->motor_num));
+      }
+      else if (p_cmd->motor_num == 0)
+      {
+        // Emergency stop all motors (direct call for consistency)
+        Motor_emergency_stop_direct(0);
+        MOTLOG("All motors emergency stop command executed (direct)");
+      }
+      break;
 
-      default:
-        APPLOG("Unknown motor command type: %u", (unsigned int)cmd.cmd_type);
-        break;
+    default:
+      MOTLOG("Unknown motor command type: %u", (unsigned int)p_cmd->cmd_type);
+      break;
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Mark commands of a drained batch that must be executed.
+  Only the newest command for each motor survives, emergency stop always wins over
+  other commands for the same motor regardless of their order in the batch.
+
+  Parameters:
+    p_cmds - drained commands in arrival order
+    count  - number of commands
+    p_keep - output flags, 1 = execute command
+
+  Return:
+    Mask of motors (MOTOR_CMD_MASK bits) with emergency stop in the batch
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Coalesce_motor_commands(const T_motor_command *p_cmds, uint32_t count, uint8_t *p_keep)
+{
+  uint32_t estop_mask    = 0;
+  uint32_t estop_claimed = 0;
+  uint32_t cmd_claimed   = 0;
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (p_cmds[i].cmd_type == MOTOR_CMD_EMERGENCY_STOP)
+    {
+      estop_mask |= MOTOR_CMD_MASK(p_cmds[i].motor_num);
+    }
+  }
+
+  // Walk from the newest command, a command survives if it still controls at least one motor
+  for (uint32_t i = count; i-- > 0;)
+  {
+    uint32_t mask = MOTOR_CMD_MASK(p_cmds[i].motor_num);
+
+    p_keep[i]     = 0;
+    if (mask == 0)
+    {
+      p_keep[i] = 1;  // Invalid motor number, pass through for error reporting
+    }
+    else if (p_cmds[i].cmd_type == MOTOR_CMD_EMERGENCY_STOP)
+    {
+      if ((mask & ~estop_claimed) != 0)
+      {
+        p_keep[i] = 1;
+      }
+      estop_claimed |= mask;
+    }
+    else
+    {
+      if ((mask & ~(cmd_claimed | estop_mask)) != 0)
+      {
+        p_keep[i] = 1;
+      }
+      cmd_claimed |= mask;
+    }
+  }
+  return estop_mask;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Account enqueue-to-apply latency of an executed command
+
+  Parameters:
+    p_cmd - executed command
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Account_motor_command_latency(const T_motor_command *p_cmd)
+{
+  uint32_t latency_us = (CYCLE_PROFILER_NOW() - p_cmd->enqueue_cycles) / FRQ_CPUCLK_MHZ;
+  uint32_t bin        = 0;
+
+  while ((bin < (MOTOR_CMD_LATENCY_BINS - 1)) && (latency_us > g_motor_cmd_latency_edges_us[bin]))
+  {
+    bin++;
+  }
+  g_motor_cmd_latency.hist[bin]++;
+  g_motor_cmd_latency.applied_count++;
+  g_motor_cmd_latency.last_us = latency_us;
+  if (latency_us > g_motor_cmd_latency.max_us)
+  {
+    g_motor_cmd_latency.max_us = latency_us;
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Drain pending motor commands from the queue and execute them as one batch.
+  Up to MOTOR_CMD_DRAIN_MAX_PER_TICK commands are taken at once. Commands superseded within the batch
+  are dropped (see _Coalesce_motor_commands), emergency stops are executed first, remaining commands
+  in arrival order.
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Process_motor_commands(void)
+{
+  static T_motor_command batch[MOTOR_CMD_DRAIN_MAX_PER_TICK];
+  static uint8_t         keep[MOTOR_CMD_DRAIN_MAX_PER_TICK];
+  uint32_t               count = 0;
+  uint32_t               estop_mask;
+
+  Motor_emergency_stop_cleanup();
+  if (g_pending_cmd_valid)
+  {
+    batch[count++]      = g_pending_cmd;  // Command received while waiting for the next tick
+    g_pending_cmd_valid = 0;
+  }
+  while ((count < MOTOR_CMD_DRAIN_MAX_PER_TICK) && (tx_queue_receive(&g_motor_command_queue, &batch[count], TX_NO_WAIT) == TX_SUCCESS))
+  {
+    count++;
+  }
+  if (count == 0)
+  {
+    return;
+  }
+  if (count > g_motor_cmd_latency.max_batch)
+  {
+    g_motor_cmd_latency.max_batch = count;
+  }
+
+  estop_mask = _Coalesce_motor_commands(batch, count, keep);
+
+  // Emergency stops first
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (keep[i] && (batch[i].cmd_type == MOTOR_CMD_EMERGENCY_STOP))
+    {
+      _Execute_motor_command(&batch[i], 0);
+      _Account_motor_command_latency(&batch[i]);
+    }
+  }
+
+  // Remaining commands in arrival order
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (batch[i].cmd_type == MOTOR_CMD_EMERGENCY_STOP)
+    {
+      if (!keep[i])
+      {
+        g_motor_cmd_latency.coalesced_count++;
+      }
+      continue;
+    }
+    if (keep[i])
+    {
+      _Execute_motor_command(&batch[i], estop_mask);
+      _Account_motor_command_latency(&batch[i]);
+    }
+    else
+    {
+      g_motor_cmd_latency.coalesced_count++;
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Wait for the next RTOS tick while applying motor commands as soon as they arrive.
+  Replaces a plain one tick sleep so command latency does not depend on the loop period,
+  the main loop itself still runs once per tick.
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Wait_next_tick_with_commands(void)
+{
+  ULONG start_tick = tx_time_get();
+
+  while (tx_queue_receive(&g_motor_command_queue, &g_pending_cmd, 1) == TX_SUCCESS)
+  {
+    g_pending_cmd_valid = 1;
+    _Process_motor_commands();
+    if (tx_time_get() != start_tick)
+    {
+      break;
     }
   }
 }
@@ -761,11 +967,12 @@ uint8_t Get_motor_driver_ready(void)
 uint32_t Motor_command_coast(uint8_t motor_num)
 {
   T_motor_command cmd = {
-    .cmd_type  = MOTOR_CMD_COAST,
-    .motor_num = motor_num,
-    .pwm_level = 0,                     // Not used for COAST command
-    .direction = MOTOR_DIRECTION_STOP,  // Not used for COAST command
-    .ramp_time = 0                      // Not used for COAST command
+    .cmd_type       = MOTOR_CMD_COAST,
+    .motor_num      = motor_num,
+    .pwm_level      = 0,                     // Not used for COAST command
+    .direction      = MOTOR_DIRECTION_STOP,  // Not used for COAST command
+    .ramp_time      = 0,                     // Not used for COAST command
+    .enqueue_cycles = CYCLE_PROFILER_NOW()
   };
 
   return tx_queue_send(&g_motor_command_queue, &cmd, TX_NO_WAIT);
@@ -910,6 +1117,9 @@ void Get_motor_parameters(uint8_t motor_num, T_motor_parameters *params)
       params->accel_time_ms    = wvar.motor_1_accel_time_ms;
       params->decel_time_ms    = wvar.motor_1_decel_time_ms;
       params->algorithm        = wvar.motor_1_algorithm;
+      params->max_accel        = wvar.motor_1_max_accel;
+      params->max_decel        = wvar.motor_1_max_decel;
+      params->jerk             = wvar.motor_1_jerk;
       break;
 
     case 2:
@@ -918,6 +1128,9 @@ void Get_motor_parameters(uint8_t motor_num, T_motor_parameters *params)
       params->accel_time_ms    = wvar.motor_2_accel_time_ms;
       params->decel_time_ms    = wvar.motor_2_decel_time_ms;
       params->algorithm        = wvar.motor_2_algorithm;
+      params->max_accel        = wvar.motor_2_max_accel;
+      params->max_decel        = wvar.motor_2_max_decel;
+      params->jerk             = wvar.motor_2_jerk;
       break;
 
     case 3:
@@ -926,6 +1139,9 @@ void Get_motor_parameters(uint8_t motor_num, T_motor_parameters *params)
       params->accel_time_ms    = wvar.motor_3_accel_time_ms;
       params->decel_time_ms    = wvar.motor_3_decel_time_ms;
       params->algorithm        = wvar.motor_3_algorithm;
+      params->max_accel        = wvar.motor_3_max_accel;
+      params->max_decel        = wvar.motor_3_max_decel;
+      params->jerk             = wvar.motor_3_jerk;
       break;
 
     case 4:
@@ -934,6 +1150,9 @@ void Get_motor_parameters(uint8_t motor_num, T_motor_parameters *params)
       params->accel_time_ms    = wvar.motor_4_accel_time_ms;
       params->decel_time_ms    = wvar.motor_4_decel_time_ms;
       params->algorithm        = wvar.motor_4_algorithm;
+      params->max_accel        = wvar.motor_4_max_accel;
+      params->max_decel        = wvar.motor_4_max_decel;
+      params->jerk             = wvar.motor_4_jerk;
       break;
   }
 }
@@ -976,11 +1195,12 @@ void Motor_soft_start_pwm_setter(uint8_t motor_num, uint8_t direction, uint16_t
 uint32_t Motor_command_soft_start(uint8_t motor_num, uint16_t target_pwm, uint8_t direction)
 {
   T_motor_command cmd = {
-    .cmd_type  = MOTOR_CMD_SOFT_START,
-    .motor_num = motor_num,
-    .pwm_level = target_pwm,
-    .direction = direction,
-    .ramp_time = 0  // Not used (times come from motor parameters)
+    .cmd_type       = MOTOR_CMD_SOFT_START,
+    .motor_num      = motor_num,
+    .pwm_level      = target_pwm,
+    .direction      = direction,
+    .ramp_time      = 0,  // Not used (times come from motor parameters)
+    .enqueue_cycles = CYCLE_PROFILER_NOW()
   };
 
   return tx_queue_send(&g_motor_command_queue, &cmd, TX_NO_WAIT);
@@ -998,11 +1218,12 @@ uint32_t Motor_command_soft_start(uint8_t motor_num, uint16_t target_pwm, uint8_
 uint32_t Motor_command_soft_stop(uint8_t motor_num)
 {
   T_motor_command cmd = {
-    .cmd_type  = MOTOR_CMD_SOFT_STOP,
-    .motor_num = motor_num,
-    .pwm_level = 0,                     // Not used for SOFT_STOP command
-    .direction = MOTOR_DIRECTION_STOP,  // Not used for SOFT_STOP command
-    .ramp_time = 0                      // Not used for SOFT_STOP command
+    .cmd_type       = MOTOR_CMD_SOFT_STOP,
+    .motor_num      = motor_num,
+    .pwm_level      = 0,                     // Not used for SOFT_STOP command
+    .direction      = MOTOR_DIRECTION_STOP,  // Not used for SOFT_STOP command
+    .ramp_time      = 0,                     // Not used for SOFT_STOP command
+    .enqueue_cycles = CYCLE_PROFILER_NOW()
   };
 
   return tx_queue_send(&g_motor_command_queue, &cmd, TX_NO_WAIT);
@@ -1020,33 +1241,69 @@ uint32_t Motor_command_soft_stop(uint8_t motor_num)
 uint32_t Motor_command_emergency_stop(uint8_t motor_num)
 {
   T_motor_command cmd = {
-    .cmd_type  = MOTOR_CMD_EMERGENCY_STOP,
-    .motor_num = motor_num,
-    .pwm_level = 0,                     // Not used for EMERGENCY_STOP command
-    .direction = MOTOR_DIRECTION_STOP,  // Not used for EMERGENCY_STOP command
-    .ramp_time = 0                      // Not used for EMERGENCY_STOP command
+    .cmd_type       = MOTOR_CMD_EMERGENCY_STOP,
+    .motor_num      = motor_num,
+    .pwm_level      = 0,                     // Not used for EMERGENCY_STOP command
+    .direction      = MOTOR_DIRECTION_STOP,  // Not used for EMERGENCY_STOP command
+    .ramp_time      = 0,                     // Not used for EMERGENCY_STOP command
+    .enqueue_cycles = CYCLE_PROFILER_NOW()
   };
   return tx_queue_send(&g_motor_command_queue, &cmd, TX_NO_WAIT);
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Get snapshot of motor command enqueue-to-apply latency statistics
+
+  Parameters:
+    p_stats - pointer to structure to fill
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Motor_cmd_latency_get(T_motor_cmd_latency_stats *p_stats)
+{
+  TX_INTERRUPT_SAVE_AREA
+  TX_DISABLE
+  *p_stats = g_motor_cmd_latency;
+  TX_RESTORE
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Reset motor command latency statistics
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Motor_cmd_latency_reset(void)
+{
+  TX_INTERRUPT_SAVE_AREA
+  TX_DISABLE
+  memset(&g_motor_cmd_latency, 0, sizeof(g_motor_cmd_latency));
+  TX_RESTORE
+}
+
 /*-----------------------------------------------------------------------------------------------------
   Set motor to dynamic braking state for emergency stop.
   During emergency stop, both motor phases must be connected to the same potential
   (either both to ground or both to 24V) to short circuit the motor winding.
 
   The potential choice depends on the paired motor state to avoid conflicts on shared phases.
+  Does not log, safe to call from an interrupt.
 
   Parameters:
     motor_num - motor number (1-4)
 
   Return:
-    None
+    true if the phases are set to 24V, false if set to 0V
 -----------------------------------------------------------------------------------------------------*/
-static void _Set_motor_dynamic_braking(uint8_t motor_num)
+static bool _Apply_motor_dynamic_braking(uint8_t motor_num)
 {
   if (motor_num < 1 || motor_num > 4)
   {
-    return;
+    return false;
   }
 
   uint8_t paired_motor        = _Get_paired_motor(motor_num);
@@ -1122,6 +1379,26 @@ static void _Set_motor_dynamic_braking(uint8_t motor_num)
       break;
   }
   TX_RESTORE
+  return shared_phase_to_24v;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Set motor to dynamic braking state for emergency stop and log the chosen potential
+
+  Parameters:
+    motor_num - motor number (1-4)
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Set_motor_dynamic_braking(uint8_t motor_num)
+{
+  if (motor_num < 1 || motor_num > 4)
+  {
+    return;
+  }
+
+  bool shared_phase_to_24v = _Apply_motor_dynamic_braking(motor_num);
   APPLOG("Motor %u (%s) dynamic braking: both phases set to %s for emergency stop", (unsigned int)motor_num, Get_motor_name(motor_num),
          shared_phase_to_24v ? "24V" : "0V");
 }
@@ -1229,23 +1506,8 @@ uint32_t Motor_emergency_stop_direct(uint8_t motor_num)
                           (g_motor_states[paired_motor - 1].soft_start_state != MOTOR_STATE_IDLE);
   }  // Emergency dynamic braking motor for fast stop instead of just stopping PWM
   _Set_motor_dynamic_braking(motor_num);
+  _Apply_emergency_stop_state(motor_num);
 
-  // Update unified motor state
-  g_motor_states[motor_num - 1].enabled                = 0;
-  g_motor_states[motor_num - 1].pwm_level              = 0;
-  g_motor_states[motor_num - 1].direction              = MOTOR_DIRECTION_STOP;
-
-  // Update soft start state directly (Motor_soft_start_emergency_stop removed - all logic now in Motor_emergency_stop_direct)
-  g_motor_states[motor_num - 1].soft_start_state       = MOTOR_STATE_IDLE;
-  g_motor_states[motor_num - 1].target_pwm             = 0;
-  g_motor_states[motor_num - 1].original_target_pwm    = 0;
-  g_motor_states[motor_num - 1].current_pwm_x100       = 0;
-  g_motor_states[motor_num - 1].step_counter           = 0;
-  g_motor_states[motor_num - 1].target_direction       = MOTOR_DIRECTION_STOP;
-  g_motor_states[motor_num - 1].soft_start_initialized = false;
-  g_motor_states[motor_num - 1].conflict_detected      = false;
-  g_motor_states[motor_num - 1].run_phase_start_time   = 0;  // Reset RUN phase start time
-  // Note: max_current_logged flag is NOT reset here - it will be checked in main loop for logging
   // Update paired motor emergency stop state if it exists and is stopped
   // This ensures that when shared phase changes due to emergency stop,
   // the paired stopped motor maintains correct emergency stop configuration
@@ -1277,6 +1539,107 @@ uint32_t Motor_emergency_stop_direct(uint8_t motor_num)
   return 0;
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Reset motor state after emergency stop braking was applied
+
+  Parameters:
+    motor_num - motor number (1-4)
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Apply_emergency_stop_state(uint8_t motor_num)
+{
+  // Update unified motor state
+  g_motor_states[motor_num - 1].enabled                = 0;
+  g_motor_states[motor_num - 1].pwm_level              = 0;
+  g_motor_states[motor_num - 1].direction              = MOTOR_DIRECTION_STOP;
+
+  // Update soft start state directly (Motor_soft_start_emergency_stop removed - all logic now in Motor_emergency_stop_direct)
+  g_motor_states[motor_num - 1].soft_start_state       = MOTOR_STATE_IDLE;
+  g_motor_states[motor_num - 1].target_pwm             = 0;
+  g_motor_states[motor_num - 1].original_target_pwm    = 0;
+  g_motor_states[motor_num - 1].current_pwm_x100       = 0;
+  g_motor_states[motor_num - 1].step_counter           = 0;
+  g_motor_states[motor_num - 1].target_direction       = MOTOR_DIRECTION_STOP;
+  g_motor_states[motor_num - 1].soft_start_initialized = false;
+  g_motor_states[motor_num - 1].conflict_detected      = false;
+  g_motor_states[motor_num - 1].run_phase_start_time   = 0;  // Reset RUN phase start time
+  // Note: max_current_logged flag is NOT reset here - it will be checked in main loop for logging
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Emergency stop motor from interrupt context. Braking and motor state are applied right away,
+  an emergency stop command is queued so that the motor task clears pending commands of the motor,
+  repeats the stop with logging and overrides anything its loop wrote in between.
+
+  Parameters:
+    motor_num - motor number (1-4)
+
+  Return:
+    0 - success, 1 - invalid motor number, 2 - braking applied but the follow-up command was not queued,
+    the motor is marked for Motor_emergency_stop_cleanup
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Motor_emergency_stop_from_isr(uint8_t motor_num)
+{
+  if (motor_num < 1 || motor_num > 4)
+  {
+    return 1;
+  }
+
+  uint8_t paired_motor = _Get_paired_motor(motor_num);
+
+  _Apply_motor_dynamic_braking(motor_num);
+  _Apply_emergency_stop_state(motor_num);
+  if (paired_motor > 0 && _Is_motor_in_emergency_stop(paired_motor))
+  {
+    _Apply_motor_dynamic_braking(paired_motor);
+  }
+
+  if (Motor_command_emergency_stop(motor_num) != TX_SUCCESS)
+  {
+    g_estop_cleanup_pending |= (uint8_t)MOTOR_CMD_MASK(motor_num);
+    return 2;
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Finish emergency stops made by Motor_emergency_stop_from_isr while the command queue was full:
+  Motor_emergency_stop_direct clears the pending commands of each marked motor. The ISR has already
+  put the motor into the stopped state, so callers must not skip this for a motor that looks stopped.
+  Called from the motor task and from the CAN command handler.
+
+  Parameters:
+    None
+
+  Return:
+    MOTOR_CMD_MASK of the motors stopped
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Motor_emergency_stop_cleanup(void)
+{
+  TX_INTERRUPT_SAVE_AREA
+  uint32_t mask;
+
+  if (g_estop_cleanup_pending == 0)
+  {
+    return 0;
+  }
+  TX_DISABLE
+  mask                    = g_estop_cleanup_pending;
+  g_estop_cleanup_pending = 0;
+  TX_RESTORE
+
+  for (uint8_t motor_num = 1; motor_num <= 4; motor_num++)
+  {
+    if (mask & MOTOR_CMD_MASK(motor_num))
+    {
+      Motor_emergency_stop_direct(motor_num);
+    }
+  }
+  return mask;
+}
+
 /*-----------------------------------------------------------------------------------------------------
   Clear all commands for specific motor from command queue
 
@@ -2200,6 +2563,9 @@ static void _Emergency_stop_all_motors(void)
 
   // Set emergency stop flag to block all motor control commands
   App_set_emergency_stop_flag();
+
+  // Freeze the phase current capture around the fault for later reading in FreeMASTER
+  Fmstr_rec_fault_trigger();
 }
 
 /*-----------------------------------------------------------------------------------------------------
@@ -2384,6 +2750,9 @@ static void Motor_driver_func(ULONG thread_input)
   // Update monitoring structure with successful initialization error codes
   Motdrv_tmc6200_UpdateInitErrorCodes();
 
+  // Start DWT cycle counter before the ADC ISR profile is used
+  Cycle_profiler_init();
+
   // Initialize PWM phase control structure for all motors and phases
   _Init_pwm_phase_control();
   Init_PWM_triangle_buffered(wvar.pwm_frequency);
@@ -2423,12 +2792,22 @@ static void Motor_driver_func(ULONG thread_input)
   // Perform motor current offset calibration before starting PWM
   _Perform_motor_current_offset_calibration();
 
+  // Main loop is expected once per RTOS tick, soft start processing must fit into a fraction of it
+  uint32_t tick_period = CYCLE_PROFILER_PERIOD(TX_TIMER_TICKS_PER_SECOND);
+  Cycle_profile_set_period(&g_motor_loop_profile, tick_period, tick_period / 2);
+  Cycle_profile_set_period(&g_soft_start_profile, 0, tick_period / 10);
+
   // Main motor driver loop
   while (1)
   {
+    uint32_t loop_start = CYCLE_PROFILER_NOW();
+    uint32_t t;
+
     _Process_motor_commands();
     Adc_driver_process_samples();
-    Motor_soft_start_process();                       // Process soft start/stop for all motors
+    t = CYCLE_PROFILER_NOW();
+    Motor_soft_start_process();  // Process soft start/stop for all motors
+    Cycle_profile_update(&g_soft_start_profile, t, CYCLE_PROFILER_NOW());
     _Check_overcurrent_overtemperature_protection();  // Check overcurrent and overtemperature protection
 
     // Check each motor for stop condition and log max currents if needed
@@ -2441,6 +2820,7 @@ static void Motor_driver_func(ULONG thread_input)
     // Handle periodic calibration
     _Handle_periodic_calibration();
 
-    tx_thread_sleep(1);
+    Cycle_profile_update(&g_motor_loop_profile, loop_start, CYCLE_PROFILER_NOW());
+    _Wait_next_tick_with_commands();
   }
 }
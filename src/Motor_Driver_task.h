@@ -23,6 +23,11 @@
 #define MOTORS_3_4_MUTUALLY_EXCLUSIVE     0  // 0 = Motors 3&4 can work together, 1 = mutually exclusive
 
 #define MOTOR_COMMAND_QUEUE_SIZE          16
+#define MOTOR_CMD_DRAIN_MAX_PER_TICK      MOTOR_COMMAND_QUEUE_SIZE  // Commands taken from the queue per drain, 1 = one command per loop iteration
+#define MOTOR_CMD_LATENCY_BINS            8                         // Number of enqueue-to-apply latency histogram bins
+
+// Binary log from the motor driver thread (integer and static string arguments only, up to LOG_BIN_MAX_ARGS)
+#define MOTLOG(...)                       BINLOG(&motor_log_ring, __VA_ARGS__)
 
 // Maximum current tracking constants
 #define MAX_CURRENT_RUN_PHASE_DELAY_TICKS (TX_TIMER_TICKS_PER_SECOND / 2)  // 0.5 second delay for RUN phase current tracking
@@ -79,6 +84,9 @@ typedef struct
   uint16_t max_pwm_percent;   // Maximum PWM percentage (0-100%)
   uint8_t  direction_invert;  // Direction inversion flag
   uint8_t  algorithm;         // Acceleration/deceleration algorithm
+  uint32_t max_accel;         // Jerk limited profile: maximum acceleration (%/s)
+  uint32_t max_decel;         // Jerk limited profile: maximum deceleration (%/s)
+  uint32_t jerk;              // Jerk limited profile: jerk (%/s^2)
 } T_motor_parameters;
 
 // Extended motor state structure that combines both regular and soft start states
@@ -110,11 +118,23 @@ typedef __packed struct
   uint8_t  motor_num;   // Motor number (1-4 for specific motor, 0=all)
   uint16_t pwm_level;   // PWM level (0-100 percent)
   uint8_t  direction;   // Motor direction (MOTOR_DIRECTION_*)
-  uint16_t ramp_time;   // Ramp time in milliseconds (for soft start/stop commands)
-  uint8_t  padding[1];  // 1 byte to make total 8 bytes (aligned to ULONG boundary)
-                        // Required for proper ThreadX queue operation
+  uint16_t ramp_time;       // Ramp time in milliseconds (for soft start/stop commands)
+  uint8_t  padding[1];      // 1 byte to align enqueue_cycles
+  uint32_t enqueue_cycles;  // DWT cycle counter when the command was queued (for latency statistics)
+                            // Total 12 bytes (3 ULONG) required for proper ThreadX queue operation
 } T_motor_command;
 
+// Motor command enqueue-to-apply latency statistics
+typedef struct
+{
+  uint32_t applied_count;                 // Number of applied commands
+  uint32_t coalesced_count;               // Commands dropped in favor of a newer command or an emergency stop for the same motor
+  uint32_t max_batch;                     // Maximum number of commands drained at once
+  uint32_t last_us;                       // Latency of the last applied command [us]
+  uint32_t max_us;                        // Maximum latency [us]
+  uint32_t hist[MOTOR_CMD_LATENCY_BINS];  // Latency histogram, upper bin edges in g_motor_cmd_latency_edges_us
+} T_motor_cmd_latency_stats;
+
 // Maximum current tracking structure for all 4 motors and 3 operation phases
 typedef struct
 {
@@ -145,7 +165,13 @@ uint32_t Motor_command_soft_stop(uint8_t motor_num);
 uint32_t Motor_command_emergency_stop(uint8_t motor_num);                                      // Emergency stop without ramping (via queue)
 
 // Direct motor control functions (bypass queue)
-uint32_t Motor_emergency_stop_direct(uint8_t motor_num);  // Direct emergency stop (immediate, bypasses queue)
+uint32_t Motor_emergency_stop_direct(uint8_t motor_num);    // Direct emergency stop (immediate, bypasses queue)
+uint32_t Motor_emergency_stop_from_isr(uint8_t motor_num);  // Braking applied in the caller's interrupt, cleanup done by the motor task
+uint32_t Motor_emergency_stop_cleanup(void);                // Cleanup of ISR stops whose command did not fit the queue
+
+// Motor command latency statistics
+void Motor_cmd_latency_get(T_motor_cmd_latency_stats *p_stats);  // Get snapshot of command latency statistics
+void Motor_cmd_latency_reset(void);                              // Reset command latency statistics
 
 // Motor parameter access function
 uint32_t Motor_get_parameters(uint8_t motor_num, T_motor_parameters *params);  // Get motor timing and configuration parameters
@@ -169,6 +195,12 @@ extern uint8_t g_drv2_en_state;  // Driver 2 enable state (0 = disabled, 1 = ena
 // Global structure for maximum current tracking (accessible from FreeMaster)
 extern T_max_current_tracking g_max_current_tracking;
 
+// Execution time profiles of the main loop (accessible from diagnostic terminal)
+extern T_cycle_profile g_motor_loop_profile;  // Whole loop iteration without sleep, jitter against RTOS tick
+extern T_cycle_profile g_soft_start_profile;  // Motor_soft_start_process call
+
+extern const uint32_t g_motor_cmd_latency_edges_us[MOTOR_CMD_LATENCY_BINS];  // Upper edges of latency histogram bins [us]
+
 // Global motor states array (accessible from FreeMaster for monitoring all motor fields)
 extern T_motor_extended_state g_motor_states[4];  // Motor states for all 4 motors (MOT_1 to MOT_4)
 
@@ -0,0 +1,274 @@
+#include "App.h"
+
+// 3τ² − 2τ³ at τ = i / MOTOR_RAMP_TABLE_SIZE in Q15, the last entry is τ = 1
+static uint16_t g_s_curve_q15[MOTOR_RAMP_TABLE_SIZE + 1];
+
+/*-----------------------------------------------------------------------------------------------------
+  Fill the S-curve table. With N segments 3τ² − 2τ³ = (3·i²·N − 2·i³) / N³, the table is built in
+  integer arithmetic and is the same on every target.
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Motor_ramp_init_table(void)
+{
+  const uint64_t n  = MOTOR_RAMP_TABLE_SIZE;
+  const uint64_t n3 = n * n * n;
+
+  for (uint64_t i = 0; i <= n; i++)
+  {
+    uint64_t p       = 3u * i * i * n - 2u * i * i * i;
+    g_s_curve_q15[i] =(uint16_t)((p * MOTOR_RAMP_Q15_ONE + n3 / 2) / n3);
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Evaluate the S-curve with linear interpolation between table entries.
+  The interpolation error is below 2^-16 of the span, less than the Q15 resolution.
+
+  Parameters:
+    phase - normalized time τ in Q32
+
+  Return:
+    3τ² − 2τ³ in Q15
+-----------------------------------------------------------------------------------------------------*/
+uint16_t Motor_ramp_s_curve_q15(uint32_t phase)
+{
+  uint32_t idx  = phase >> (32 - MOTOR_RAMP_TABLE_BITS);
+  uint32_t frac = (phase >> (16 - MOTOR_RAMP_TABLE_BITS)) & 0xFFFF;
+  uint32_t s0   = g_s_curve_q15[idx];
+  uint32_t s1   = g_s_curve_q15[idx + 1];
+
+  return (uint16_t)(s0 + (((s1 - s0) * frac) >> 16));
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Start an S-curve ramp. The number of updates is duration_ms * update_hz / 1000, the last update
+  returns the end level exactly. A zero duration ends the ramp on the first update.
+
+  Parameters:
+    ramp        - ramp to start
+    from_x100   - start level, PWM % * 100
+    to_x100     - end level, PWM % * 100
+    duration_ms - ramp duration
+    update_hz   - rate at which Motor_ramp_step is called
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Motor_ramp_s_curve_begin(T_motor_ramp *ramp, uint16_t from_x100, uint16_t to_x100, uint32_t duration_ms, uint32_t update_hz)
+{
+  uint64_t steps = ((uint64_t)duration_ms * update_hz) / 1000u;
+
+  if (steps == 0)
+  {
+    steps = 1;
+  }
+  if (steps > UINT32_MAX)
+  {
+    steps = UINT32_MAX;
+  }
+
+  ramp->phase      = 0;
+  ramp->phase_acc  = 0;
+  ramp->steps      = (uint32_t)steps;
+  ramp->steps_left = (uint32_t)steps;
+  ramp->start_x100 = from_x100;
+  ramp->delta_x100 = (int32_t)to_x100 - (int32_t)from_x100;
+  // The phase is exact, a rounded increment would pass 2^32 before the last update of long ramps.
+  // A single update ramp does not advance the phase.
+  ramp->phase_inc  = (steps > 1) ? (uint32_t)(0x100000000ull / steps) : 0;
+  ramp->phase_rem  = (steps > 1) ? (uint32_t)(0x100000000ull % steps) : 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Advance a ramp by one update
+
+  Parameters:
+    ramp         - started ramp
+    p_level_x100 - level after the update, PWM % * 100
+
+  Return:
+    true if the ramp reached the end level
+-----------------------------------------------------------------------------------------------------*/
+bool Motor_ramp_step(T_motor_ramp *ramp, uint16_t *p_level_x100)
+{
+  int32_t s;
+
+  if (ramp->steps_left <= 1)
+  {
+    ramp->steps_left = 0;
+    *p_level_x100    = (uint16_t)(ramp->start_x100 + ramp->delta_x100);
+    return true;
+  }
+  ramp->steps_left--;
+  ramp->phase += ramp->phase_inc;
+  // phase_acc + phase_rem >= N without the sum, it can pass 2^32 for ramps of more than 2^31 updates
+  if (ramp->phase_acc >= (ramp->steps - ramp->phase_rem))
+  {
+    ramp->phase_acc -= ramp->steps - ramp->phase_rem;
+    ramp->phase++;
+  }
+  else
+  {
+    ramp->phase_acc += ramp->phase_rem;
+  }
+
+  // Arithmetic shift: a falling ramp is rounded down like the rising one
+  s             = (int32_t)Motor_ramp_s_curve_q15(ramp->phase);
+  *p_level_x100 = (uint16_t)(ramp->start_x100 + ((ramp->delta_x100 * s) >> 15));
+  return false;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Convert the profile limits to Q16 level units per update. Called when a move starts,
+  a step does not read parameters.
+
+  Parameters:
+    prof      - profile
+    max_accel - maximum acceleration while the level rises, % per second
+    max_decel - maximum acceleration while the level falls, % per second
+    jerk      - maximum acceleration change, % per second^2
+    update_hz - rate at which Motor_profile_step is called
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Motor_profile_set_limits(T_motor_profile *prof, uint32_t max_accel, uint32_t max_decel, uint32_t jerk, uint32_t update_hz)
+{
+  const uint64_t scale = 100ull << 16;  // % to PWM % * 100 in Q16
+  uint64_t       v;
+
+  if (update_hz == 0)
+  {
+    update_hz = 1;
+  }
+  // Limited to keep level + acceleration inside int32
+  v            = (max_accel * scale) / update_hz;
+  prof->a_up   = (int32_t)((v == 0) ? 1 : ((v > INT32_MAX / 4) ? INT32_MAX / 4 : v));
+  v            = (max_decel * scale) / update_hz;
+  prof->a_down = (int32_t)((v == 0) ? 1 : ((v > INT32_MAX / 4) ? INT32_MAX / 4 : v));
+  v            = (jerk * scale) / ((uint64_t)update_hz * update_hz);
+  prof->jerk   = (int32_t)((v == 0) ? 1 : ((v > INT32_MAX / 4) ? INT32_MAX / 4 : v));
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Place the profile at rest at a level
+
+  Parameters:
+    prof       - profile
+    level_x100 - level, PWM % * 100
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Motor_profile_reset(T_motor_profile *prof, uint16_t level_x100)
+{
+  prof->level  = (int32_t)level_x100 << 16;
+  prof->target = prof->level;
+  prof->accel  = 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Set a new target level, the current level and acceleration are kept
+
+  Parameters:
+    prof        - profile
+    target_x100 - target level, PWM % * 100
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Motor_profile_set_target(T_motor_profile *prof, uint16_t target_x100)
+{
+  prof->target = (int32_t)target_x100 << 16;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Get the current level of the profile
+
+  Parameters:
+    prof - profile
+
+  Return:
+    Level, PWM % * 100
+-----------------------------------------------------------------------------------------------------*/
+uint16_t Motor_profile_level(const T_motor_profile *prof)
+{
+  return (uint16_t)(prof->level >> 16);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Advance the profile by one update. The acceleration is brought to zero at the target: when the level
+  change needed to stop accelerating, a(a + j) / 2j, reaches the remaining distance, the acceleration
+  is reduced by the jerk each update. Before that it grows by the jerk up to the limit of the direction
+  of travel. An acceleration pointing away from the target, left by a change of the target, is reduced
+  first. The level is placed on the target when it is reached or passed within one jerk step.
+
+  Parameters:
+    prof         - profile
+    p_level_x100 - level after the update, PWM % * 100
+
+  Return:
+    true if the profile is at rest at the target
+-----------------------------------------------------------------------------------------------------*/
+bool Motor_profile_step(T_motor_profile *prof, uint16_t *p_level_x100)
+{
+  int32_t err = prof->target - prof->level;
+  int32_t dir;
+  int32_t a_dir;
+  int32_t err_dir;
+  int32_t a_lim;
+  int32_t j = prof->jerk;
+
+  if ((err == 0) && (prof->accel == 0))
+  {
+    *p_level_x100 = (uint16_t)(prof->level >> 16);
+    return true;
+  }
+
+  // Direction of travel towards the target, at the target the acceleration left is reduced
+  if (err != 0)
+  {
+    dir = (err > 0) ? 1 : -1;
+  }
+  else
+  {
+    dir = (prof->accel > 0) ? -1 : 1;
+  }
+  a_dir   = prof->accel * dir;
+  err_dir = err * dir;
+  a_lim   = (dir > 0) ? prof->a_up : prof->a_down;
+
+  if (a_dir < 0)
+  {
+    a_dir += j;
+  }
+  else if ((int64_t)a_dir * (a_dir + j) >= (int64_t)2 * j * err_dir)
+  {
+    a_dir = (a_dir > j) ? (a_dir - j) : 0;
+  }
+  else
+  {
+    a_dir += j;
+  }
+  if (a_dir > a_lim)
+  {
+    a_dir = a_lim;
+  }
+  prof->accel  = a_dir * dir;
+  prof->level += prof->accel;
+
+  err_dir      = (prof->target - prof->level) * dir;
+  if ((err_dir <= 0) || ((err_dir < j) && (a_dir <= j)))
+  {
+    prof->level = prof->target;
+    prof->accel = 0;
+  }
+
+  *p_level_x100 = (uint16_t)(prof->level >> 16);
+  return (prof->level == prof->target) && (prof->accel == 0);
+}
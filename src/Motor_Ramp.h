@@ -0,0 +1,51 @@
+#ifndef MOTOR_RAMP_H
+#define MOTOR_RAMP_H
+
+// Fixed-point S-curve ramp. The normalized curve 3τ² − 2τ³ is tabulated once in Q15, a ramp stores
+// its start level, span and phase increment computed at start and advances with one addition with carry,
+// one table interpolation and one multiplication per update. No float and no division per update,
+// so a ramp can be advanced from an ISR at any update rate.
+
+#define MOTOR_RAMP_TABLE_BITS 8
+#define MOTOR_RAMP_TABLE_SIZE (1u << MOTOR_RAMP_TABLE_BITS)  // Segments of the table, it has one more entry for τ = 1
+#define MOTOR_RAMP_Q15_ONE    32768u
+
+typedef struct
+{
+  uint32_t phase;       // Normalized time τ in Q32, floor(k * 2^32 / N) after k of N updates
+  uint32_t phase_inc;   // floor(2^32 / N)
+  uint32_t phase_rem;   // 2^32 mod N, accumulated in phase_acc
+  uint32_t phase_acc;   // Remainder of k * 2^32 / N, carries into phase when it reaches N
+  uint32_t steps;       // Number of updates of the ramp N
+  uint32_t steps_left;  // Updates until the ramp reaches the end level
+  int32_t  start_x100;  // Level at τ = 0, PWM % * 100
+  int32_t  delta_x100;  // End level minus start level
+} T_motor_ramp;
+
+// Jerk limited level profile. Level rises and falls with acceleration up to the limits, the acceleration
+// changes by at most the jerk per update and is zero when the target is reached: a move between two levels
+// has up to 7 segments (jerk, constant acceleration, jerk, constant level, jerk, constant deceleration, jerk).
+// The target can be changed at any time, the profile continues from its current level and acceleration.
+// An update costs a constant number of operations, no division and no loop.
+typedef struct
+{
+  int32_t level;   // PWM % * 100 in Q16
+  int32_t accel;   // Level change per update, Q16
+  int32_t target;  // Target level, Q16
+  int32_t a_up;    // Maximum acceleration while the level rises, Q16 per update
+  int32_t a_down;  // Maximum acceleration while the level falls, Q16 per update
+  int32_t jerk;    // Maximum acceleration change per update, Q16
+} T_motor_profile;
+
+void     Motor_ramp_init_table(void);
+void     Motor_ramp_s_curve_begin(T_motor_ramp *ramp, uint16_t from_x100, uint16_t to_x100, uint32_t duration_ms, uint32_t update_hz);
+bool     Motor_ramp_step(T_motor_ramp *ramp, uint16_t *p_level_x100);
+uint16_t Motor_ramp_s_curve_q15(uint32_t phase);
+
+void     Motor_profile_set_limits(T_motor_profile *prof, uint32_t max_accel, uint32_t max_decel, uint32_t jerk, uint32_t update_hz);
+void     Motor_profile_reset(T_motor_profile *prof, uint16_t level_x100);
+void     Motor_profile_set_target(T_motor_profile *prof, uint16_t target_x100);
+uint16_t Motor_profile_level(const T_motor_profile *prof);
+bool     Motor_profile_step(T_motor_profile *prof, uint16_t *p_level_x100);
+
+#endif  // MOTOR_RAMP_H
@@ -6,14 +6,16 @@
 // Algorithm function pointer types
 typedef void (*Alg_init_func)(uint8_t motor_index, T_motor_extended_state *motor);
 typedef bool (*Alg_process_func)(uint8_t motor_index, T_motor_extended_state *motor);
+typedef void (*Alg_retarget_func)(uint8_t motor_index, T_motor_extended_state *motor);
 
 // Algorithm implementation structure
 typedef struct
 {
-  Alg_init_func    init_ramp_up;       // Initialize ramp up
-  Alg_init_func    init_ramp_down;     // Initialize ramp down
-  Alg_process_func process_ramp_up;    // Process ramp up step
-  Alg_process_func process_ramp_down;  // Process ramp down step
+  Alg_init_func     init_ramp_up;       // Initialize ramp up
+  Alg_init_func     init_ramp_down;     // Initialize ramp down
+  Alg_process_func  process_ramp_up;    // Process ramp up step
+  Alg_process_func  process_ramp_down;  // Process ramp down step
+  Alg_retarget_func retarget;           // Continue to a new target_pwm, NULL if not supported
 } T_algorithm_impl;
 
 // Global variables
@@ -27,10 +29,17 @@ static T_soft_start_algorithm g_motor_algorithms[MOTOR_SOFT_START_MAX_MOTORS] =
 // Algorithm implementations
 static T_algorithm_impl g_algorithms[SOFT_START_ALG_COUNT];
 
+// S-curve ramps, coefficients are set when a ramp starts
+static T_motor_ramp g_s_curve_ramps[MOTOR_SOFT_START_MAX_MOTORS];
+
+// Jerk limited profiles, limits are loaded from the motor parameters when a move starts
+static T_motor_profile g_jerk_profiles[MOTOR_SOFT_START_MAX_MOTORS];
+
 // Static function declarations
 static void    _Init_instant_algorithm(void);
 static void    _Init_linear_algorithm(void);
 static void    _Init_s_curve_algorithm(void);
+static void    _Init_jerk_algorithm(void);
 static uint8_t _Check_direction_conflict(uint8_t motor_num, uint8_t new_direction);
 static uint8_t _Get_actual_direction(uint8_t motor_num, uint8_t direction);
 static uint8_t _Get_conflicting_motor(uint8_t motor_num);
@@ -53,9 +62,13 @@ static void _S_curve_init_ramp_down(uint8_t motor_index, T_motor_extended_state
 static bool _S_curve_process_ramp_up(uint8_t motor_index, T_motor_extended_state *motor);
 static bool _S_curve_process_ramp_down(uint8_t motor_index, T_motor_extended_state *motor);
 
-// S-curve mathematical functions (3-2 polynomial variant)
-static float _S_curve_accel(float t, float T);
-static float _S_curve_decel(float t, float T);
+// Jerk limited algorithm implementation
+static void _Jerk_load_limits(uint8_t motor_index);
+static void _Jerk_init_ramp_up(uint8_t motor_index, T_motor_extended_state *motor);
+static void _Jerk_init_ramp_down(uint8_t motor_index, T_motor_extended_state *motor);
+static bool _Jerk_process_ramp_up(uint8_t motor_index, T_motor_extended_state *motor);
+static bool _Jerk_process_ramp_down(uint8_t motor_index, T_motor_extended_state *motor);
+static void _Jerk_retarget(uint8_t motor_index, T_motor_extended_state *motor);
 
 /*-----------------------------------------------------------------------------------------------------
   Initialize soft start system
@@ -72,6 +85,8 @@ uint32_t Motor_soft_start_init(void)
   _Init_instant_algorithm();
   _Init_linear_algorithm();
   _Init_s_curve_algorithm();
+  _Init_jerk_algorithm();
+  Motor_ramp_init_table();
 
   return 0;
 }
@@ -239,6 +254,66 @@ uint32_t Motor_soft_start_stop(uint8_t motor_num)
   return 0;
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Move a running motor to a new target PWM without restarting the ramp. Only algorithms that can
+  continue from the current level and acceleration accept a new target.
+
+  Parameters:
+    motor_num - motor number (1-4)
+    target_pwm - new target PWM level (0-100%), 0 starts a soft stop
+    direction - motor direction (MOTOR_DIRECTION_FORWARD/REVERSE), must be the current one
+
+  Return:
+    0 - new target accepted
+    1 - not accepted: motor idle, other direction or the algorithm does not support it
+    2 - invalid parameters
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Motor_soft_start_retarget(uint8_t motor_num, uint16_t target_pwm, uint8_t direction)
+{
+  if (motor_num < 1 || motor_num > MOTOR_SOFT_START_MAX_MOTORS || target_pwm > 100)
+  {
+    return 2;  // Invalid parameters
+  }
+  uint8_t                 motor_index = motor_num - 1;
+  T_motor_extended_state *motor       = Motor_get_extended_state(motor_num);
+  T_algorithm_impl       *alg         = &g_algorithms[g_motor_algorithms[motor_index]];
+
+  if (motor == NULL)
+  {
+    return 2;  // Invalid motor number
+  }
+  if ((alg->retarget == NULL) || !motor->soft_start_initialized || (motor->soft_start_state == MOTOR_STATE_IDLE))
+  {
+    return 1;  // Nothing to continue from
+  }
+  if (_Get_actual_direction(motor_num, direction) != motor->target_direction)
+  {
+    return 1;  // Reversal goes through a stop
+  }
+  if (target_pwm == 0)
+  {
+    return Motor_soft_start_stop(motor_num) == 0 ? 0 : 2;
+  }
+
+  T_motor_parameters motor_params;
+  Get_motor_parameters(motor_num, &motor_params);
+  if (target_pwm > motor_params.max_pwm_percent)
+  {
+    target_pwm = motor_params.max_pwm_percent;
+  }
+  if ((motor->soft_start_state != MOTOR_STATE_SOFT_RAMPING_DOWN) && (motor->target_pwm == target_pwm))
+  {
+    return 0;  // Already moving to this target
+  }
+
+  motor->target_pwm          = target_pwm;
+  motor->original_target_pwm = target_pwm;
+  motor->soft_start_state    = MOTOR_STATE_SOFT_RAMPING_UP;  // Ramping towards target_pwm, then RUNNING
+  motor->enabled             = 1;
+  alg->retarget(motor_index, motor);
+  return 0;
+}
+
 /*-----------------------------------------------------------------------------------------------------
   Process soft start/stop for all motors (call every millisecond)
 
@@ -298,11 +373,11 @@ void Motor_soft_start_process(void)
     {
       if (motor->soft_start_state == MOTOR_STATE_RUNNING)
       {
-        APPLOG("Motor %u (%s) soft start completed (PWM: %u%%)", (unsigned int)(i + 1), Get_motor_name(i + 1), (unsigned int)(motor->current_pwm_x100 / 100));
+        MOTLOG("Motor %u (%s) soft start completed (PWM: %u%%)", (unsigned int)(i + 1), Get_motor_name(i + 1), (unsigned int)(motor->current_pwm_x100 / 100));
       }
       else if (motor->soft_start_state == MOTOR_STATE_IDLE)
       {
-        APPLOG("Motor %u (%s) soft stop completed", (unsigned int)(i + 1), Get_motor_name(i + 1));
+        MOTLOG("Motor %u (%s) soft stop completed", (unsigned int)(i + 1), Get_motor_name(i + 1));
       }
     }
   }
@@ -473,6 +548,24 @@ static void _Init_s_curve_algorithm(void)
   g_algorithms[SOFT_START_ALG_S_CURVE].process_ramp_down = _S_curve_process_ramp_down;
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Initialize jerk limited algorithm implementation
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Init_jerk_algorithm(void)
+{
+  g_algorithms[SOFT_START_ALG_JERK].init_ramp_up      = _Jerk_init_ramp_up;
+  g_algorithms[SOFT_START_ALG_JERK].init_ramp_down    = _Jerk_init_ramp_down;
+  g_algorithms[SOFT_START_ALG_JERK].process_ramp_up   = _Jerk_process_ramp_up;
+  g_algorithms[SOFT_START_ALG_JERK].process_ramp_down = _Jerk_process_ramp_down;
+  g_algorithms[SOFT_START_ALG_JERK].retarget          = _Jerk_retarget;
+}
+
 /*-----------------------------------------------------------------------------------------------------
   Check if motor direction conflicts with currently running motors
 
@@ -826,7 +919,8 @@ static bool _Instant_process_ramp_down(uint8_t motor_index, T_motor_extended_sta
 // ================================================================================================
 
 /*-----------------------------------------------------------------------------------------------------
-  Initialize S-curve ramp up
+  Initialize S-curve ramp up. The ramp from 0 to the target PWM over the acceleration time
+  is set up here, processing does not read the motor parameters.
 
   Parameters:
     motor_index - motor index (0-3)
@@ -840,16 +934,15 @@ static void _S_curve_init_ramp_up(uint8_t motor_index, T_motor_extended_state *m
   T_motor_parameters motor_params;
   Get_motor_parameters(motor_index + 1, &motor_params);
 
-  // Initialize S-curve acceleration parameters
+  // step_counter tracks elapsed time in milliseconds
   motor->step_counter       = 0;
-
-  // For S-curve, step_counter tracks elapsed time in milliseconds
-  // pwm_step_size_x100 stores target PWM * 100 for direct calculation
   motor->pwm_step_size_x100 = motor->target_pwm * 100;
+  Motor_ramp_s_curve_begin(&g_s_curve_ramps[motor_index], 0, motor->pwm_step_size_x100, motor_params.accel_time_ms, MOTOR_SOFT_START_UPDATE_HZ);
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Initialize S-curve ramp down
+  Initialize S-curve ramp down from the current PWM. The deceleration time is proportional
+  to the current PWM relative to the original target, at least 100 ms.
 
   Parameters:
     motor_index - motor index (0-3)
@@ -863,12 +956,21 @@ static void _S_curve_init_ramp_down(uint8_t motor_index, T_motor_extended_state
   T_motor_parameters motor_params;
   Get_motor_parameters(motor_index + 1, &motor_params);
 
-  // Initialize S-curve deceleration parameters
   motor->step_counter       = 0;
+  motor->pwm_step_size_x100 = motor->current_pwm_x100;
 
-  // Store current PWM level for deceleration calculation
-  uint16_t initial_pwm_x100 = motor->current_pwm_x100;
-  motor->pwm_step_size_x100 = initial_pwm_x100;
+  uint32_t decel_time_ms    = motor_params.decel_time_ms;
+  uint16_t initial_pwm      = motor->pwm_step_size_x100 / 100;
+  // Use original_target_pwm since target_pwm is set to 0 during soft stop
+  if ((decel_time_ms > 0) && (motor->original_target_pwm > 0) && (initial_pwm > 0))
+  {
+    decel_time_ms = (initial_pwm * motor_params.decel_time_ms) / motor->original_target_pwm;
+    if (decel_time_ms < 100)
+    {
+      decel_time_ms = 100;  // Minimum 100ms for safety
+    }
+  }
+  Motor_ramp_s_curve_begin(&g_s_curve_ramps[motor_index], motor->pwm_step_size_x100, 0, decel_time_ms, MOTOR_SOFT_START_UPDATE_HZ);
 }
 
 /*-----------------------------------------------------------------------------------------------------
@@ -882,38 +984,15 @@ static void _S_curve_init_ramp_down(uint8_t motor_index, T_motor_extended_state
     true - state changed, false - no state change
 -----------------------------------------------------------------------------------------------------*/
 static bool _S_curve_process_ramp_up(uint8_t motor_index, T_motor_extended_state *motor)
-{  // Get acceleration time for S-curve calculation
-  T_motor_parameters motor_params;
-  Get_motor_parameters(motor_index + 1, &motor_params);
-
+{
   motor->step_counter++;  // Increment elapsed time (milliseconds)
-  if (motor_params.accel_time_ms == 0)
+  if (Motor_ramp_step(&g_s_curve_ramps[motor_index], &motor->current_pwm_x100))
   {
-    // Instant acceleration
-    motor->current_pwm_x100 = motor->pwm_step_size_x100;
     motor->soft_start_state = MOTOR_STATE_RUNNING;
     Motor_set_run_phase_start_time(motor_index + 1);  // Set RUN phase start time for current tracking
     // Update main motor state for display
     motor->pwm_level        = motor->target_pwm;
     motor->direction        = motor->target_direction;
-    return true;  // State changed
-  }
-
-  // Calculate S-curve coefficient using polynomial function
-  float t                 = (float)motor->step_counter / 1000.0f;         // Current time in seconds
-  float T                 = (float)motor_params.accel_time_ms / 1000.0f;  // Total time in seconds
-  float s_coeff           = _S_curve_accel(t, T);
-
-  // Apply S-curve coefficient to target PWM
-  motor->current_pwm_x100 = (uint16_t)(motor->pwm_step_size_x100 * s_coeff);
-  if (s_coeff >= 1.0f)
-  {
-    motor->current_pwm_x100 = motor->pwm_step_size_x100;  // Ensure exact target
-    motor->soft_start_state = MOTOR_STATE_RUNNING;
-    Motor_set_run_phase_start_time(motor_index + 1);     // Set RUN phase start time for current tracking
-    // Update main motor state for display
-    motor->pwm_level        = motor->target_pwm;
-    motor->direction        = motor->target_direction;
     return true;  // Target reached
   }
   return false;   // Still ramping up
@@ -931,47 +1010,8 @@ static bool _S_curve_process_ramp_up(uint8_t motor_index, T_motor_extended_state
 -----------------------------------------------------------------------------------------------------*/
 static bool _S_curve_process_ramp_down(uint8_t motor_index, T_motor_extended_state *motor)
 {
-  // Get deceleration time for S-curve calculation
-  T_motor_parameters motor_params;
-  Get_motor_parameters(motor_index + 1, &motor_params);
-
   motor->step_counter++;  // Increment elapsed time (milliseconds)
-
-  if (motor_params.decel_time_ms == 0)
-  {
-    // Instant deceleration
-    motor->current_pwm_x100       = 0;
-    motor->soft_start_state       = MOTOR_STATE_IDLE;
-    motor->target_direction       = MOTOR_DIRECTION_STOP;
-    motor->soft_start_initialized = false;
-    return true;  // State changed
-  }
-  // Calculate S-curve coefficient using polynomial function
-  float t = (float)motor->step_counter / 1000.0f;         // Current time in seconds
-  float T = (float)motor_params.decel_time_ms / 1000.0f;  // Total time in seconds
-  // Calculate proportional deceleration time based on current PWM level
-  // Use original_target_pwm since target_pwm is set to 0 during soft stop
-  if (motor->original_target_pwm > 0)
-  {
-    uint16_t initial_pwm = motor->pwm_step_size_x100 / 100;
-    if (initial_pwm > 0)
-    {
-      uint32_t effective_decel_time_ms = (initial_pwm * motor_params.decel_time_ms) / motor->original_target_pwm;
-
-      // Ensure minimum deceleration time for safety
-      if (effective_decel_time_ms < 100)
-      {
-        effective_decel_time_ms = 100;               // Minimum 100ms
-      }
-
-      T = (float)effective_decel_time_ms / 1000.0f;  // Use proportional time
-    }
-  }
-  float s_coeff           = _S_curve_decel(t, T);
-
-  // Apply S-curve coefficient (deceleration from initial PWM level)
-  motor->current_pwm_x100 = (uint16_t)(motor->pwm_step_size_x100 * s_coeff);
-  if (s_coeff <= 0.0f)
+  if (Motor_ramp_step(&g_s_curve_ramps[motor_index], &motor->current_pwm_x100))
   {
     motor->current_pwm_x100       = 0;
     motor->soft_start_state       = MOTOR_STATE_IDLE;
@@ -983,54 +1023,144 @@ static bool _S_curve_process_ramp_down(uint8_t motor_index, T_motor_extended_sta
     motor->direction              = MOTOR_DIRECTION_STOP;
     return true;  // Stopped
   }
-
   return false;   // Still ramping down
 }
 
 // ================================================================================================
-// S-CURVE MATHEMATICAL FUNCTIONS (3-2 POLYNOMIAL VARIANT)
+// JERK LIMITED ALGORITHM IMPLEMENTATION
 // ================================================================================================
 
 /*-----------------------------------------------------------------------------------------------------
-  S-curve acceleration function (smooth acceleration 0 → 1)
+  Load acceleration, deceleration and jerk limits of the motor into its profile
+
+  Parameters:
+    motor_index - motor index (0-3)
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Jerk_load_limits(uint8_t motor_index)
+{
+  T_motor_parameters motor_params;
+  Get_motor_parameters(motor_index + 1, &motor_params);
+
+  Motor_profile_set_limits(&g_jerk_profiles[motor_index], motor_params.max_accel, motor_params.max_decel, motor_params.jerk, MOTOR_SOFT_START_UPDATE_HZ);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Initialize jerk limited ramp up from standstill to the target PWM
 
-  Uses 3τ² - 2τ³ polynomial for smooth acceleration curve with zero derivative at endpoints
+  Parameters:
+    motor_index - motor index (0-3)
+    motor - pointer to motor structure
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Jerk_init_ramp_up(uint8_t motor_index, T_motor_extended_state *motor)
+{
+  motor->step_counter = 0;
+  _Jerk_load_limits(motor_index);
+  Motor_profile_reset(&g_jerk_profiles[motor_index], 0);
+  Motor_profile_set_target(&g_jerk_profiles[motor_index], motor->target_pwm * 100);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Initialize jerk limited ramp down. The profile continues from its current level and acceleration,
+  it is restarted at the current PWM only if the motor was started by another algorithm.
 
   Parameters:
-    t - current time from start of acceleration phase (seconds)
-    T - total duration of acceleration phase (seconds)
+    motor_index - motor index (0-3)
+    motor - pointer to motor structure
 
   Return:
-    Acceleration coefficient [0.0 ; 1.0]
+    None
 -----------------------------------------------------------------------------------------------------*/
-static float _S_curve_accel(float t, float T)
+static void _Jerk_init_ramp_down(uint8_t motor_index, T_motor_extended_state *motor)
 {
-  if (t <= 0.0f)
+  T_motor_profile *prof = &g_jerk_profiles[motor_index];
+
+  motor->step_counter   = 0;
+  _Jerk_load_limits(motor_index);
+  if (Motor_profile_level(prof) != motor->current_pwm_x100)
   {
-    return 0.0f;
+    Motor_profile_reset(prof, motor->current_pwm_x100);
   }
-  if (t >= T)
+  Motor_profile_set_target(prof, 0);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Continue a running profile to the new target_pwm
+
+  Parameters:
+    motor_index - motor index (0-3)
+    motor - pointer to motor structure
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Jerk_retarget(uint8_t motor_index, T_motor_extended_state *motor)
+{
+  T_motor_profile *prof = &g_jerk_profiles[motor_index];
+
+  motor->step_counter   = 0;
+  _Jerk_load_limits(motor_index);
+  if (Motor_profile_level(prof) != motor->current_pwm_x100)
   {
-    return 1.0f;
+    Motor_profile_reset(prof, motor->current_pwm_x100);
   }
-
-  float tau = t / T;                       // Normalized time 0‥1
-  return tau * tau * (3.0f - 2.0f * tau);  // Formula 3τ² − 2τ³ = τ²·(3 − 2τ)
+  Motor_profile_set_target(prof, motor->target_pwm * 100);
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  S-curve deceleration function (smooth deceleration 1 → 0)
+  Process jerk limited ramp up step
 
-  Symmetric to acceleration: 1 - s_curve_accel
+  Parameters:
+    motor_index - motor index (0-3)
+    motor - pointer to motor structure
+
+  Return:
+    true - state changed, false - no state change
+-----------------------------------------------------------------------------------------------------*/
+static bool _Jerk_process_ramp_up(uint8_t motor_index, T_motor_extended_state *motor)
+{
+  motor->step_counter++;  // Increment elapsed time (milliseconds)
+  if (Motor_profile_step(&g_jerk_profiles[motor_index], &motor->current_pwm_x100))
+  {
+    motor->soft_start_state = MOTOR_STATE_RUNNING;
+    Motor_set_run_phase_start_time(motor_index + 1);  // Set RUN phase start time for current tracking
+    // Update main motor state for display
+    motor->pwm_level        = motor->target_pwm;
+    motor->direction        = motor->target_direction;
+    return true;  // Target reached
+  }
+  return false;   // Still moving to the target
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Process jerk limited ramp down step
 
   Parameters:
-    t - current time from start of deceleration phase (seconds)
-    T - total duration of deceleration phase (seconds)
+    motor_index - motor index (0-3)
+    motor - pointer to motor structure
 
   Return:
-    Deceleration coefficient [0.0 ; 1.0]
+    true - state changed, false - no state change
 -----------------------------------------------------------------------------------------------------*/
-static float _S_curve_decel(float t, float T)
+static bool _Jerk_process_ramp_down(uint8_t motor_index, T_motor_extended_state *motor)
 {
-  return 1.0f - _S_curve_accel(t, T);
+  motor->step_counter++;  // Increment elapsed time (milliseconds)
+  if (Motor_profile_step(&g_jerk_profiles[motor_index], &motor->current_pwm_x100))
+  {
+    motor->current_pwm_x100       = 0;
+    motor->soft_start_state       = MOTOR_STATE_IDLE;
+    motor->target_direction       = MOTOR_DIRECTION_STOP;
+    motor->soft_start_initialized = false;
+    // Update main motor state for display
+    motor->enabled                = 0;
+    motor->pwm_level              = 0;
+    motor->direction              = MOTOR_DIRECTION_STOP;
+    return true;  // Stopped
+  }
+  return false;   // Still ramping down
 }
@@ -7,12 +7,16 @@
 // Maximum number of motors supported
 #define MOTOR_SOFT_START_MAX_MOTORS 4
 
+// Rate of Motor_soft_start_process calls, the motor task calls it once per RTOS tick
+#define MOTOR_SOFT_START_UPDATE_HZ  TX_TIMER_TICKS_PER_SECOND
+
 // Soft start algorithm types
 typedef enum
 {
   SOFT_START_ALG_INSTANT = 0,  // Instant start/stop (no ramping)
   SOFT_START_ALG_LINEAR  = 1,  // Linear ramp up/down
   SOFT_START_ALG_S_CURVE = 2,  // S-curve (smooth acceleration/deceleration)
+  SOFT_START_ALG_JERK    = 3,  // Jerk limited profile of the PWM level with acceleration and jerk limits, accepts new targets while moving
   SOFT_START_ALG_COUNT         // Number of available algorithms
 } T_soft_start_algorithm;
 
@@ -76,6 +80,22 @@ uint32_t Motor_soft_start_begin(uint8_t motor_num, uint16_t target_pwm, uint8_t
 -----------------------------------------------------------------------------------------------------*/
 uint32_t Motor_soft_start_stop(uint8_t motor_num);
 
+/*-----------------------------------------------------------------------------------------------------
+  Move a running motor to a new target PWM without restarting the ramp. Only algorithms that can
+  continue from the current level and acceleration accept a new target (SOFT_START_ALG_JERK).
+
+  Parameters:
+    motor_num - motor number (1-4)
+    target_pwm - new target PWM level (0-100%), 0 starts a soft stop
+    direction - motor direction (MOTOR_DIRECTION_FORWARD/REVERSE), must be the current one
+
+  Return:
+    0 - new target accepted
+    1 - not accepted: motor idle, other direction or the algorithm does not support it
+    2 - invalid parameters
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Motor_soft_start_retarget(uint8_t motor_num, uint16_t target_pwm, uint8_t direction);
+
 /*-----------------------------------------------------------------------------------------------------
   Process soft start/stop for all motors (call every millisecond)
 
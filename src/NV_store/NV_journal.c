@@ -0,0 +1,625 @@
+#include "App.h"
+
+extern const uint32_t df_params_addr[PARAMS_TYPES_NUM][2];
+extern uint32_t       g_setting_wr_counters[PARAMS_TYPES_NUM][2];
+
+static T_nvj_state g_nvj[PARAMS_TYPES_NUM];
+
+static uint32_t _NVJ_value_ref(const T_NV_parameters *pp, const uint8_t **val, uint32_t *len);
+static uint32_t _NVJ_apply_value(const T_NV_parameters *pp, uint8_t type, const uint8_t *val, uint32_t len);
+static void     _NVJ_seal_record(uint8_t *rec);
+static uint32_t _NVJ_build_record(uint8_t *rec, uint16_t hash, uint8_t type, const uint8_t *val, uint32_t len);
+static uint32_t _NVJ_check_record(const uint8_t *rec, uint32_t avail);
+static uint32_t _NVJ_check_header(const T_nvj_header *hdr);
+static uint32_t _NVJ_flash_record_equal(uint32_t addr, uint8_t type, const uint8_t *val, uint32_t len);
+static uint32_t _NVJ_index_records(T_nvj_state *st, const uint8_t *buf, uint32_t sz, uint32_t base);
+static uint32_t _NVJ_scan(uint8_t ptype, uint32_t apply, uint32_t *applied, uint32_t *rejected);
+
+/*-----------------------------------------------------------------------------------------------------
+  Get location and size of the parameter value as it is stored in a record.
+  Numeric values are stored in the native little-endian representation, strings without terminating zero.
+
+  Parameters:
+    pp  - parameter descriptor
+    val - returned pointer to the value in RAM
+    len - returned value length
+
+  Return:
+    RES_OK, RES_ERROR if the parameter type can not be stored
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _NVJ_value_ref(const T_NV_parameters *pp, const uint8_t **val, uint32_t *len)
+{
+  if (pp->val == NULL) return RES_ERROR;
+  *val = (const uint8_t *)pp->val;
+
+  switch (pp->vartype)
+  {
+    case tint8u:
+      *len = 1;
+      break;
+    case tint16u:
+      *len = 2;
+      break;
+    case tint32u:
+    case tint32s:
+    case tfloat:
+      *len = 4;
+      break;
+    case tstring:
+      if (pp->varlen == 0) return RES_ERROR;
+      *len = strnlen((const char *)pp->val, pp->varlen - 1);
+      break;
+    case tarrofbyte:
+      *len = pp->varlen;
+      break;
+    default:
+      return RES_ERROR;
+  }
+  if (*len > NVJ_MAX_VAL_LEN) return RES_ERROR;
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Write the value of a record to the parameter. Value limits are checked as in Convert_str_to_parameter,
+  so a value outside the current limits does not pass and the parameter keeps its default.
+
+  Parameters:
+    pp   - parameter descriptor
+    type - type of the record value
+    val  - record value
+    len  - record value length
+
+  Return:
+    RES_OK, RES_ERROR if the record does not match the current parameter definition
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _NVJ_apply_value(const T_NV_parameters *pp, uint8_t type, const uint8_t *val, uint32_t len)
+{
+  uint8_t  u8;
+  uint16_t u16;
+  uint32_t u32;
+  int32_t  s32;
+  float    f;
+
+  if ((pp->val == NULL) || (type != pp->vartype)) return RES_ERROR;
+
+  switch (pp->vartype)
+  {
+    case tint8u:
+      if (len != 1) return RES_ERROR;
+      u8 = val[0];
+      if ((u8 > (uint32_t)pp->maxval) || (u8 < (uint32_t)pp->minval)) return RES_ERROR;
+      *(uint8_t *)pp->val = u8;
+      break;
+    case tint16u:
+      if (len != 2) return RES_ERROR;
+      memcpy(&u16, val, 2);
+      if ((u16 > (uint32_t)pp->maxval) || (u16 < (uint32_t)pp->minval)) return RES_ERROR;
+      *(uint16_t *)pp->val = u16;
+      break;
+    case tint32u:
+      if (len != 4) return RES_ERROR;
+      memcpy(&u32, val, 4);
+      if ((u32 > (uint32_t)pp->maxval) || (u32 < (uint32_t)pp->minval)) return RES_ERROR;
+      *(uint32_t *)pp->val = u32;
+      break;
+    case tint32s:
+      if (len != 4) return RES_ERROR;
+      memcpy(&s32, val, 4);
+      if ((s32 > (int32_t)pp->maxval) || (s32 < (int32_t)pp->minval)) return RES_ERROR;
+      *(int32_t *)pp->val = s32;
+      break;
+    case tfloat:
+      if (len != 4) return RES_ERROR;
+      memcpy(&f, val, 4);
+      if (f != f) return RES_ERROR;  // NaN
+      if (f > (float)pp->maxval) f = (float)pp->maxval;
+      if (f < (float)pp->minval) f = (float)pp->minval;
+      *(float *)pp->val = f;
+      break;
+    case tstring:
+      if (pp->varlen == 0) return RES_ERROR;
+      if (len > (uint32_t)(pp->varlen - 1)) len = pp->varlen - 1;
+      memcpy(pp->val, val, len);
+      ((uint8_t *)pp->val)[len] = 0;
+      break;
+    case tarrofbyte:
+      if (len != pp->varlen) return RES_ERROR;
+      memcpy(pp->val, val, len);
+      break;
+    default:
+      return RES_ERROR;
+  }
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Calculate and place the CRC of a record whose header and value are already filled
+
+  Parameters:
+    rec - record
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _NVJ_seal_record(uint8_t *rec)
+{
+  uint32_t sz  = NVJ_REC_SZ(rec[3]);
+  uint16_t crc = Get_CRC16_of_block(rec, sz - NVJ_REC_CRC_SZ, 0xFFFF);
+
+  memcpy(&rec[sz - NVJ_REC_CRC_SZ], &crc, NVJ_REC_CRC_SZ);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Build a record
+
+  Parameters:
+    rec  - destination, must have room for NVJ_REC_SZ(len) bytes
+    hash - parameter hash
+    type - parameter type, optionally with NVJ_REC_COMMIT
+    val  - value
+    len  - value length
+
+  Return:
+    Record size
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _NVJ_build_record(uint8_t *rec, uint16_t hash, uint8_t type, const uint8_t *val, uint32_t len)
+{
+  uint32_t sz = NVJ_REC_SZ(len);
+
+  memcpy(&rec[0], &hash, 2);
+  rec[2] = type;
+  rec[3] = (uint8_t)len;
+  memcpy(&rec[NVJ_REC_HDR_SZ], val, len);
+  memset(&rec[NVJ_REC_HDR_SZ + len], 0, sz - NVJ_REC_HDR_SZ - len);
+  _NVJ_seal_record(rec);
+  return sz;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Check a record read from DataFlash
+
+  Parameters:
+    rec   - record
+    avail - bytes available from the record start to the end of the area
+
+  Return:
+    Record size, 0 if there is no valid record
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _NVJ_check_record(const uint8_t *rec, uint32_t avail)
+{
+  uint32_t sz;
+  uint8_t  type;
+  uint16_t crc;
+
+  if (avail < NVJ_REC_SZ(0)) return 0;
+  type = rec[2] & NVJ_REC_TYPE_MASK;
+  if ((type < tint8u) || (type > tint32s)) return 0;
+  sz = NVJ_REC_SZ(rec[3]);
+  if (sz > avail) return 0;
+  memcpy(&crc, &rec[sz - NVJ_REC_CRC_SZ], NVJ_REC_CRC_SZ);
+  if (crc != Get_CRC16_of_block((void *)rec, sz - NVJ_REC_CRC_SZ, 0xFFFF)) return 0;
+  return sz;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Check an area header
+
+  Parameters:
+    hdr - header read from DataFlash
+
+  Return:
+    RES_OK if the header is valid
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _NVJ_check_header(const T_nvj_header *hdr)
+{
+  uint16_t crc;
+
+  if ((hdr->magic != NVJ_MAGIC) || (hdr->version != NVJ_FORMAT_VERSION)) return RES_ERROR;
+  crc = Get_CRC16_of_block((void *)hdr, NVJ_HEADER_CRC_OFFS, 0xFFFF);
+  if ((hdr->crc != crc) || (hdr->crc_copy != crc)) return RES_ERROR;
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Compare a record stored in DataFlash with the current value
+
+  Parameters:
+    addr - record address in DataFlash
+    type - parameter type
+    val  - value
+    len  - value length
+
+  Return:
+    1 if the stored record holds the same value
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _NVJ_flash_record_equal(uint32_t addr, uint8_t type, const uint8_t *val, uint32_t len)
+{
+  uint8_t  chunk[16];
+  uint32_t n;
+
+  DataFlash_bgo_ReadArea(addr, chunk, NVJ_REC_HDR_SZ);
+  if (((chunk[2] & NVJ_REC_TYPE_MASK) != type) || (chunk[3] != len)) return 0;
+  for (uint32_t pos = 0; pos < len; pos += n)
+  {
+    n = ((len - pos) > sizeof(chunk)) ? sizeof(chunk) : (len - pos);
+    DataFlash_bgo_ReadArea(addr + NVJ_REC_HDR_SZ + pos, chunk, n);
+    if (memcmp(chunk, &val[pos], n) != 0) return 0;
+  }
+  return 1;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Remember location of the records of a written batch
+
+  Parameters:
+    st   - journal state
+    buf  - records as written
+    sz   - size of the records
+    base - offset of the first record in the area
+
+  Return:
+    Number of records
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _NVJ_index_records(T_nvj_state *st, const uint8_t *buf, uint32_t sz, uint32_t base)
+{
+  uint32_t pos = 0;
+  uint32_t cnt = 0;
+  uint16_t hash;
+  uint16_t indx;
+
+  while (pos < sz)
+  {
+    memcpy(&hash, &buf[pos], 2);
+    indx = Find_param_by_hash(hash);
+    if (indx < NVJ_MAX_PARAMS) st->rec_offs[indx] = (uint16_t)(base + pos);
+    pos += NVJ_REC_SZ(buf[pos + 3]);
+    cnt++;
+  }
+  return cnt;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Find the active area, replay its committed batches and find the position for appending.
+  Records of a batch are applied only when its commit record is reached.
+
+  Parameters:
+    ptype    - parameters type
+    apply    - 1 to write the values to the parameters, 0 to only rebuild the journal state
+    applied  - returned number of applied values, may be NULL
+    rejected - returned number of records not matching the current parameter definitions, may be NULL
+
+  Return:
+    RES_OK if a valid journal was found
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _NVJ_scan(uint8_t ptype, uint32_t apply, uint32_t *applied, uint32_t *rejected)
+{
+  T_nvj_state                    *st     = &g_nvj[ptype];
+  const T_NV_parameters_instance *p_pars = Get_settings_instance(ptype);
+  T_nvj_header                    hdr;
+  uint8_t                        *buf;
+  uint16_t                       *pend;
+  uint32_t                        pend_cnt = 0;
+  uint32_t                        pos;
+  uint32_t                        sz;
+  uint32_t                        ok_cnt  = 0;
+  uint32_t                        bad_cnt = 0;
+  uint16_t                        hash;
+  uint16_t                        indx;
+  uint8_t                        *rec;
+
+  st->scanned = 1;
+  st->active  = NVJ_AREA_NONE;
+  st->dirty   = 0;
+  st->tail    = 0;
+  st->records = 0;
+  memset(st->rec_offs, 0, sizeof(st->rec_offs));
+
+  for (uint32_t i = 0; i < 2; i++)
+  {
+    DataFlash_bgo_ReadArea(df_params_addr[ptype][i], (uint8_t *)&hdr, sizeof(hdr));
+    st->area_valid[i] = (_NVJ_check_header(&hdr) == RES_OK) ? 1 : 0;
+    st->area_seq[i]   = st->area_valid[i] ? hdr.seq : 0;
+    if (st->area_valid[i]) g_setting_wr_counters[ptype][i] = hdr.seq;
+  }
+  if (st->area_valid[0] && st->area_valid[1])
+  {
+    st->active = ((int32_t)(st->area_seq[1] - st->area_seq[0]) > 0) ? 1 : 0;
+  }
+  else if (st->area_valid[0])
+  {
+    st->active = 0;
+  }
+  else if (st->area_valid[1])
+  {
+    st->active = 1;
+  }
+  else
+  {
+    return RES_ERROR;
+  }
+
+  // The whole area is read at once, the pending list keeps offsets of the records of an uncommitted batch
+  buf = NV_MALLOC_PENDING(DATAFLASH_PARAMS_AREA_SIZE + NVJ_MAX_PARAMS * sizeof(uint16_t), 10);
+  if (buf == NULL)
+  {
+    st->scanned = 0;
+    st->active  = NVJ_AREA_NONE;
+    return RES_ERROR;
+  }
+  pend = (uint16_t *)&buf[DATAFLASH_PARAMS_AREA_SIZE];
+  DataFlash_bgo_ReadArea(df_params_addr[ptype][st->active], buf, DATAFLASH_PARAMS_AREA_SIZE);
+
+  pos      = NVJ_HEADER_SZ;
+  st->tail = NVJ_HEADER_SZ;
+  while (pos < DATAFLASH_PARAMS_AREA_SIZE)
+  {
+    rec = &buf[pos];
+    sz  = _NVJ_check_record(rec, DATAFLASH_PARAMS_AREA_SIZE - pos);
+    if ((sz == 0) || (pend_cnt >= NVJ_MAX_PARAMS)) break;
+
+    pend[pend_cnt++] = (uint16_t)pos;
+    pos += sz;
+    if ((rec[2] & NVJ_REC_COMMIT) == 0) continue;
+
+    // Commit record reached, apply the batch
+    for (uint32_t k = 0; k < pend_cnt; k++)
+    {
+      rec = &buf[pend[k]];
+      memcpy(&hash, &rec[0], 2);
+      indx = Find_param_by_hash(hash);
+      if ((indx >= p_pars->items_num) || (indx >= NVJ_MAX_PARAMS))
+      {
+        bad_cnt++;  // Parameter removed from the current firmware
+        continue;
+      }
+      st->rec_offs[indx] = pend[k];
+      if (apply)
+      {
+        if (_NVJ_apply_value(&p_pars->items_array[indx], rec[2] & NVJ_REC_TYPE_MASK, &rec[NVJ_REC_HDR_SZ], rec[3]) == RES_OK)
+        {
+          ok_cnt++;
+        }
+        else
+        {
+          bad_cnt++;
+        }
+      }
+    }
+    st->records += pend_cnt;
+    pend_cnt = 0;
+    st->tail = pos;
+  }
+
+  // Records of an interrupted batch or a torn record occupy the space after the last commit
+  if (st->tail < DATAFLASH_PARAMS_AREA_SIZE)
+  {
+    if (DataFlash_bgo_BlankCheck(df_params_addr[ptype][st->active] + st->tail, DATAFLASH_PARAMS_AREA_SIZE - st->tail) != RES_OK)
+    {
+      st->dirty = 1;
+    }
+  }
+
+  NV_MEM_FREE(buf);
+  if (applied != NULL) *applied = ok_cnt;
+  if (rejected != NULL) *rejected = bad_cnt;
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Write all parameter values to the inactive area and make it active.
+  The header is programmed after the records, so a reset during compaction leaves the previous area active.
+
+  Parameters:
+    ptype - parameters type
+
+  Return:
+    RES_OK or NV_ERR_* code
+-----------------------------------------------------------------------------------------------------*/
+uint32_t NV_journal_compact(uint8_t ptype)
+{
+  const T_NV_parameters_instance *p_pars;
+  T_nvj_state                    *st;
+  T_nvj_header                   *hdr;
+  uint8_t                        *buf;
+  const uint8_t                  *val;
+  uint32_t                        len;
+  uint32_t                        pos;
+  uint32_t                        last = 0;
+  uint32_t                        addr;
+  uint8_t                         target;
+  uint32_t                        err_code;
+
+  if (ptype >= PARAMS_TYPES_NUM) return NV_ERR_INVALID_TYPE;
+  p_pars = Get_settings_instance(ptype);
+  if ((p_pars == NULL) || (p_pars->items_num > NVJ_MAX_PARAMS)) return NV_ERR_INVALID_TYPE;
+  st = &g_nvj[ptype];
+  if (st->scanned == 0) _NVJ_scan(ptype, 0, NULL, NULL);
+  if (st->scanned == 0) return NV_ERR_MEMORY_ALLOCATION;  // Area state unknown, nothing may be erased
+
+  target = (st->active == NVJ_AREA_NONE) ? 0 : (st->active ^ 1);
+  addr   = df_params_addr[ptype][target];
+
+  buf    = NV_MALLOC_PENDING(DATAFLASH_PARAMS_AREA_SIZE, 10);
+  if (buf == NULL) return NV_ERR_MEMORY_ALLOCATION;
+
+  pos = NVJ_HEADER_SZ;
+  for (uint32_t i = 0; i < p_pars->items_num; i++)
+  {
+    if (_NVJ_value_ref(&p_pars->items_array[i], &val, &len) != RES_OK) continue;
+    if ((pos + NVJ_REC_SZ(len)) > DATAFLASH_PARAMS_AREA_SIZE)
+    {
+      err_code = NV_ERR_BUFFER_TOO_LARGE;
+      goto EXIT_ON_ERROR;
+    }
+    last = pos;
+    pos += _NVJ_build_record(&buf[pos], Get_param_hash_by_index(i), p_pars->items_array[i].vartype, val, len);
+  }
+  if (pos == NVJ_HEADER_SZ)
+  {
+    err_code = NV_ERR_BUFFER_TOO_SMALL;
+    goto EXIT_ON_ERROR;
+  }
+  buf[last + 2] |= NVJ_REC_COMMIT;
+  _NVJ_seal_record(&buf[last]);
+
+  hdr           = (T_nvj_header *)buf;
+  hdr->magic    = NVJ_MAGIC;
+  hdr->version  = NVJ_FORMAT_VERSION;
+  hdr->reserved = 0;
+  hdr->seq      = (st->active == NVJ_AREA_NONE) ? 1 : (st->area_seq[st->active] + 1);
+  hdr->crc      = Get_CRC16_of_block(hdr, NVJ_HEADER_CRC_OFFS, 0xFFFF);
+  hdr->crc_copy = hdr->crc;
+
+  st->area_valid[target] = 0;
+  if (DataFlash_bgo_EraseArea(addr, DATAFLASH_PARAMS_AREA_SIZE) != RES_OK)
+  {
+    err_code = (target == 0) ? NV_ERR_ERASE_AREA1 : NV_ERR_ERASE_AREA2;
+    goto EXIT_ON_ERROR;
+  }
+  if ((DataFlash_bgo_WriteArea(addr + NVJ_HEADER_SZ, &buf[NVJ_HEADER_SZ], pos - NVJ_HEADER_SZ) != RES_OK) ||
+      (DataFlash_bgo_WriteArea(addr, buf, NVJ_HEADER_SZ) != RES_OK))
+  {
+    err_code = (target == 0) ? NV_ERR_WRITE_AREA1 : NV_ERR_WRITE_AREA2;
+    goto EXIT_ON_ERROR;
+  }
+
+  st->area_valid[target]               = 1;
+  st->area_seq[target]                 = hdr->seq;
+  g_setting_wr_counters[ptype][target] = hdr->seq;
+  st->active                           = target;
+  st->dirty                            = 0;
+  st->tail                             = pos;
+  memset(st->rec_offs, 0, sizeof(st->rec_offs));
+  st->records         = _NVJ_index_records(st, &buf[NVJ_HEADER_SZ], pos - NVJ_HEADER_SZ, NVJ_HEADER_SZ);
+  st->last_save_bytes = pos;
+  st->compactions++;
+  NV_MEM_FREE(buf);
+
+  APPLOG("Settings journal compacted to area %d: %d records, %d bytes, seq=%d", target + 1, st->records, pos, st->area_seq[target]);
+  return RES_OK;
+
+EXIT_ON_ERROR:
+  NV_MEM_FREE(buf);
+  APPLOG("Settings journal compaction failed: %s (code: %d)", Get_settings_save_error_str(err_code), err_code);
+  return err_code;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Save parameters to DataFlash. Only values that differ from the last stored records are appended
+  as one batch. Compaction is done when the batch does not fit in the active area or there is no valid journal.
+
+  Parameters:
+    ptype - parameters type
+
+  Return:
+    RES_OK or NV_ERR_* code
+-----------------------------------------------------------------------------------------------------*/
+uint32_t NV_journal_save(uint8_t ptype)
+{
+  const T_NV_parameters_instance *p_pars;
+  T_nvj_state                    *st;
+  uint8_t                        *buf;
+  const uint8_t                  *val;
+  uint32_t                        len;
+  uint32_t                        free_sz;
+  uint32_t                        pos  = 0;
+  uint32_t                        last = 0;
+  uint32_t                        addr;
+  uint32_t                        cnt;
+
+  if (ptype >= PARAMS_TYPES_NUM) return NV_ERR_INVALID_TYPE;
+  p_pars = Get_settings_instance(ptype);
+  if ((p_pars == NULL) || (p_pars->items_num > NVJ_MAX_PARAMS)) return NV_ERR_INVALID_TYPE;
+  st = &g_nvj[ptype];
+  if (st->scanned == 0) _NVJ_scan(ptype, 0, NULL, NULL);
+  if (st->scanned == 0) return NV_ERR_MEMORY_ALLOCATION;  // Area state unknown, nothing may be erased
+  if ((st->active == NVJ_AREA_NONE) || st->dirty || (st->tail >= DATAFLASH_PARAMS_AREA_SIZE)) return NV_journal_compact(ptype);
+
+  addr    = df_params_addr[ptype][st->active];
+  free_sz = DATAFLASH_PARAMS_AREA_SIZE - st->tail;
+  buf     = NV_MALLOC_PENDING(free_sz, 10);
+  if (buf == NULL) return NV_ERR_MEMORY_ALLOCATION;
+
+  for (uint32_t i = 0; i < p_pars->items_num; i++)
+  {
+    if (_NVJ_value_ref(&p_pars->items_array[i], &val, &len) != RES_OK) continue;
+    if ((st->rec_offs[i] != 0) && _NVJ_flash_record_equal(addr + st->rec_offs[i], p_pars->items_array[i].vartype, val, len)) continue;
+    if ((pos + NVJ_REC_SZ(len)) > free_sz)
+    {
+      NV_MEM_FREE(buf);
+      return NV_journal_compact(ptype);
+    }
+    last = pos;
+    pos += _NVJ_build_record(&buf[pos], Get_param_hash_by_index(i), p_pars->items_array[i].vartype, val, len);
+  }
+
+  if (pos == 0)
+  {
+    NV_MEM_FREE(buf);
+    st->last_save_bytes = 0;
+    return RES_OK;  // Nothing changed
+  }
+  buf[last + 2] |= NVJ_REC_COMMIT;
+  _NVJ_seal_record(&buf[last]);
+
+  if ((DataFlash_bgo_BlankCheck(addr + st->tail, pos) != RES_OK) || (DataFlash_bgo_WriteArea(addr + st->tail, buf, pos) != RES_OK))
+  {
+    // Space after the tail is not usable any more, write everything to the other area
+    NV_MEM_FREE(buf);
+    st->dirty = 1;
+    return NV_journal_compact(ptype);
+  }
+
+  cnt = _NVJ_index_records(st, buf, pos, st->tail);
+  st->records += cnt;
+  st->tail += pos;
+  st->last_save_bytes = pos;
+  st->appends++;
+  NV_MEM_FREE(buf);
+
+  APPLOG("Settings journal: %d changed values appended to area %d, %d bytes, %d bytes free", cnt, st->active + 1, pos, DATAFLASH_PARAMS_AREA_SIZE - st->tail);
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Restore parameters by replaying the journal of the active DataFlash area
+
+  Parameters:
+    ptype - parameters type
+
+  Return:
+    RES_OK if a valid journal was found and replayed
+-----------------------------------------------------------------------------------------------------*/
+uint32_t NV_journal_restore(uint8_t ptype)
+{
+  uint32_t applied  = 0;
+  uint32_t rejected = 0;
+  uint32_t t;
+
+  if (ptype >= PARAMS_TYPES_NUM) return RES_ERROR;
+  if (Get_settings_instance(ptype) == NULL) return RES_ERROR;
+
+  t = CYCLE_PROFILER_NOW();
+  if (_NVJ_scan(ptype, 1, &applied, &rejected) != RES_OK) return RES_ERROR;
+  t = CYCLES_TO_NS(CYCLE_PROFILER_NOW() - t) / 1000;
+
+  APPLOG("Settings journal replayed from area %d: %d values applied, %d rejected, %d records, %d us%s",
+         g_nvj[ptype].active + 1, applied, rejected, g_nvj[ptype].records, t, g_nvj[ptype].dirty ? ", tail damaged" : "");
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Get journal state for diagnostics
+
+  Parameters:
+    ptype - parameters type
+
+  Return:
+    Pointer to the state or NULL
+-----------------------------------------------------------------------------------------------------*/
+const T_nvj_state *NV_journal_get_state(uint8_t ptype)
+{
+  if (ptype >= PARAMS_TYPES_NUM) return NULL;
+  if (g_nvj[ptype].scanned == 0) _NVJ_scan(ptype, 0, NULL, NULL);
+  return &g_nvj[ptype];
+}
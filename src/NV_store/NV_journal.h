@@ -0,0 +1,65 @@
+#ifndef NV_JOURNAL_H
+#define NV_JOURNAL_H
+
+// Binary settings journal in the two DataFlash settings areas.
+//
+// Area layout:
+//   +--------+----------------------------------------------------------------+
+//   | 0x00   | Header: magic, format version, compaction sequence, CRC16 x2    |
+//   | 0x10   | Records, each aligned to DATA_FLASH_WR_SZ                        |
+//   | ...    | Erased space, new records are appended here                      |
+//   +--------+----------------------------------------------------------------+
+//
+// Record: parameter hash (2), type (1), value length (1), value, padding, CRC16 (2).
+// Records of one save form a batch, the last record of a batch carries NVJ_REC_COMMIT.
+// A batch that was not completed because of a reset is ignored on replay.
+// Only one area is active. When it is full, all values are written to the other area
+// and its header is programmed last, so the previous area stays valid until then.
+
+#define NVJ_MAGIC            0x314A564Eu  // "NVJ1"
+#define NVJ_FORMAT_VERSION   1
+#define NVJ_HEADER_SZ        16
+#define NVJ_HEADER_CRC_OFFS  12           // Header CRC covers the fields before it
+#define NVJ_REC_HDR_SZ       4
+#define NVJ_REC_CRC_SZ       2
+#define NVJ_MAX_VAL_LEN      255
+#define NVJ_MAX_PARAMS       128          // Maximal number of parameters in one parameters instance
+#define NVJ_REC_TYPE_MASK    0x7F
+#define NVJ_REC_COMMIT       0x80         // Last record of a batch
+
+#define NVJ_AREA_NONE        0xFF
+
+// Record size including header, padding and CRC
+#define NVJ_REC_SZ(len)      (((NVJ_REC_HDR_SZ + (len) + NVJ_REC_CRC_SZ) + (DATA_FLASH_WR_SZ - 1)) & ~(DATA_FLASH_WR_SZ - 1))
+
+typedef struct
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t reserved;
+  uint32_t seq;       // Incremented on every compaction, the area with the greater value is active
+  uint16_t crc;       // CRC16 of the previous fields
+  uint16_t crc_copy;
+} T_nvj_header;
+
+typedef struct
+{
+  uint8_t  scanned;                      // Areas were scanned after reset
+  uint8_t  active;                       // Active area index or NVJ_AREA_NONE
+  uint8_t  dirty;                        // Active area tail can not be appended, compaction is required
+  uint8_t  area_valid[2];                // Area has a valid header
+  uint32_t area_seq[2];                  // Compaction sequence of each area
+  uint32_t tail;                         // Offset of the next record in the active area
+  uint32_t records;                      // Committed records in the active area
+  uint32_t appends;                      // Saves done by appending since reset
+  uint32_t compactions;                  // Saves done by compaction since reset
+  uint32_t last_save_bytes;              // Bytes programmed by the last save
+  uint16_t rec_offs[NVJ_MAX_PARAMS];     // Offset of the last committed record of each parameter, 0 - none
+} T_nvj_state;
+
+uint32_t           NV_journal_save(uint8_t ptype);
+uint32_t           NV_journal_restore(uint8_t ptype);
+uint32_t           NV_journal_compact(uint8_t ptype);
+const T_nvj_state *NV_journal_get_state(uint8_t ptype);
+
+#endif  // NV_JOURNAL_H
@@ -222,6 +222,9 @@ int32_t Restore_settings(uint8_t ptype)
   2. Опционально сжимает данные, если это требуется.
   3. Сохраняет данные в файл или DataFlash в зависимости от media_type.
 
+  В DataFlash настройки сохраняются в двоичном журнале (NV_journal.c): дописываются только измененные
+  параметры, полная перезапись области выполняется только при ее заполнении.
+
   \param ptype      Тип параметров (например, APPLICATION_PARAMS).
   \param media_type Тип носителя: MEDIA_TYPE_FILE (файл) или MEDIA_TYPE_DATAFLASH (энергонезависимая память).
   \param file_name  Имя файла для сохранения (NULL — использовать имя по умолчанию).
@@ -246,11 +249,13 @@ uint32_t Save_settings(uint8_t ptype, uint8_t media_type, char *file_name)
   const T_NV_parameters_instance *p_pars = Get_settings_instance(ptype);
   if (p_pars == 0) return RES_ERROR;
 
+  // В DataFlash дописываются только измененные параметры
   if (media_type == MEDIA_TYPE_DATAFLASH)
   {
-    flags = JSON_COMPACT;
+    return NV_journal_save(ptype);
   }
-  else if (en_formated_settings)
+
+  if (en_formated_settings)
   {
     flags = JSON_INDENT(1) | JSON_ENSURE_ASCII;
   }
@@ -259,9 +264,15 @@ uint32_t Save_settings(uint8_t ptype, uint8_t media_type, char *file_name)
     flags = JSON_COMPACT;
   }
 
+  // Несжатый JSON записывается в файл потоком, без промежуточной строки в памяти
+  if ((media_type == MEDIA_TYPE_FILE) && (en_compress_settins == 0))
+  {
+    return Save_settings_to_JSON_file_stream(file_name, p_pars, flags, ptype);
+  }
+
   if (Serialze_settings_to_mem(p_pars, &json_str, &json_str_sz, flags) != RES_OK) goto EXIT_ON_ERROR;
 
-  if (en_compress_settins || (media_type == MEDIA_TYPE_DATAFLASH))
+  if (en_compress_settins)
   {
     // Выделить память для сжатого файла
     compessed_data_ptr = NV_MALLOC_PENDING(json_str_sz, 10);
@@ -284,16 +295,7 @@ uint32_t Save_settings(uint8_t ptype, uint8_t media_type, char *file_name)
     buf_sz = json_str_sz;
   }
 
-  res = RES_OK;
-  switch (media_type)
-  {
-    case MEDIA_TYPE_FILE:
-      res = Save_settings_to_file(file_name, buf, buf_sz, ptype, en_compress_settins);
-      break;
-    case MEDIA_TYPE_DATAFLASH:
-      res = Save_settings_to_DataFlash(buf, buf_sz, ptype);
-      break;
-  }
+  res = Save_settings_to_file(file_name, buf, buf_sz, ptype, en_compress_settins);
 
   NV_MEM_FREE(compessed_data_ptr);
   if (json_str != 0) NV_MEM_FREE(json_str);
@@ -494,100 +496,38 @@ error:
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Сохраняет настройки в две идентичные области памяти DataFlash для обеспечения надежности хранения.
-
-  Структура данных в DataFlash:
-  +-------------+--------------------------------------------------------------+
-  | Смещение    | Описание                                                     |
-  +-------------+--------------------------------------------------------------+
-  | 0x00-0x03   | Размер сжатых данных JSON (N байт)                           |
-  | 0x04-0x07   | Счетчик модификаций данных (g_setting_wr_counters[ptype][i]) |
-  | 0x08-0x07+N | Сжатые данные JSON                                           |
-  | 0x08+N-0x0B+N | Контрольная сумма CRC16 (дублируется в двух 16-битных словах)|
-  +-------------+--------------------------------------------------------------+
+  Сериализует настройки потоком прямо в файл JSON.
+  Расход памяти не зависит от количества параметров.
+  Если имя файла не задано, используется имя по умолчанию для типа параметров.
 
-  \param buf    - Указатель на буфер с сжатыми данными JSON
-  \param buf_sz - Размер сжатых данных в байтах
-  \param ptype  - Тип параметров (APPLICATION_PARAMS)
+  \param file_name  Имя файла для сохранения (или NULL для имени по умолчанию)
+  \param p_pars     Указатель на набор параметров
+  \param flags      Флаги форматирования JSON
+  \param ptype      Тип параметров (APPLICATION_PARAMS и др.)
 
-  \return RES_OK при успешном выполнении, или код ошибки (см. коды NV_ERR_*)
+  \return RES_OK при успехе, RES_ERROR при ошибке
 -----------------------------------------------------------------------------------------------------*/
-uint32_t Save_settings_to_DataFlash(uint8_t *buf, uint32_t buf_sz, uint8_t ptype)
+uint32_t Save_settings_to_JSON_file_stream(char *file_name, const T_NV_parameters_instance *p_pars, uint32_t flags, uint8_t ptype)
 {
-  uint8_t *tmp_buf = 0;
-  uint32_t tmp_buf_sz;
-  uint16_t crc;
-  uint32_t csz;
-  uint32_t i;
-  uint32_t err_code = 0;
-
-  // Проверка входных параметров
-  if (ptype >= PARAMS_TYPES_NUM) return NV_ERR_INVALID_TYPE;
-  if (buf_sz > (DATAFLASH_PARAMS_AREA_SIZE - DATAFLASH_SUPLIMENT_AREA_SIZE)) return NV_ERR_BUFFER_TOO_LARGE;
-  if (buf_sz < 8) return NV_ERR_BUFFER_TOO_SMALL;
-
-  // Выравнивание размера буфера по границе 4 байт
-  csz = buf_sz;
-  if ((csz & 0x3) != 0) csz = (csz & 0xFFFFFFFC) + 4;
-
-  // Размер буфера с учетом заголовка и CRC
-  tmp_buf_sz = csz + DATAFLASH_SUPLIMENT_AREA_SIZE;
-
-  // Выделение временного буфера
-  tmp_buf    = NV_MALLOC_PENDING(tmp_buf_sz, 10);
-  if (tmp_buf == NULL)
-  {
-    err_code = NV_ERR_MEMORY_ALLOCATION;
-    goto EXIT_WITH_LOG;
-  }
-
-  // Инициализация буфера нулями (для неиспользуемой области)
-  memset(tmp_buf, 0, tmp_buf_sz);
-
-  // Записываем размер данных
-  memcpy(&tmp_buf[0], &csz, 4);
-
-  // Копируем данные
-  memcpy(&tmp_buf[8], buf, buf_sz);
-
-  // Записываем в обе области памяти
-  for (i = 0; i < 2; i++)
-  {
-    // Стираем область памяти
-    if (DataFlash_bgo_EraseArea(df_params_addr[ptype][i], DATAFLASH_PARAMS_AREA_SIZE) != RES_OK)
-    {
-      err_code = (i == 0) ? NV_ERR_ERASE_AREA1 : NV_ERR_ERASE_AREA2;
-      goto EXIT_WITH_LOG;
-    }
-
-    // Обновляем счетчик записей и записываем его в буфер
-    g_setting_wr_counters[ptype][i]++;
-    memcpy(&tmp_buf[4], &g_setting_wr_counters[ptype][i], 4);
-
-    // Вычисляем CRC16 для буфера (исключая поле CRC)
-    crc = Get_CRC16_of_block(tmp_buf, tmp_buf_sz - 4, 0xFFFF);
+  FX_FILE  f;
+  uint32_t res;
 
-    // Сохраняем CRC в конце буфера (дублируем для надежности)
-    memcpy(&tmp_buf[8 + csz], &crc, 2);
-    memcpy(&tmp_buf[10 + csz], &crc, 2);
+  if (g_file_system_ready == 0) return RES_ERROR;
+  if (ptype >= PARAMS_TYPES_NUM) return RES_ERROR;
 
-    // Записываем буфер в DataFlash
-    if (DataFlash_bgo_WriteArea(df_params_addr[ptype][i], tmp_buf, tmp_buf_sz) != RES_OK)
-    {
-      err_code = (i == 0) ? NV_ERR_WRITE_AREA1 : NV_ERR_WRITE_AREA2;
-      goto EXIT_WITH_LOG;
-    }
-  }
+  f.fx_file_id = 0;
+  if (file_name == NULL) file_name = json_fname[ptype];
 
-  NV_MEM_FREE(tmp_buf);
-  APPLOG("Settings saved to DataFlash: size=%d bytes, write counters=[%d, %d]",
-         buf_sz, g_setting_wr_counters[ptype][0], g_setting_wr_counters[ptype][1]);
-  return RES_OK;
+  if (Recreate_file_for_write(&f, file_name) != RES_OK) goto error;
+  res = Serialze_settings_to_file(p_pars, &f, flags);
+  fx_file_close(&f);
+  fx_media_flush(&fat_fs_media);
+  return res;
 
-EXIT_WITH_LOG:
-  NV_MEM_FREE(tmp_buf);
-  APPLOG("Failed to save settings to DataFlash: %s (code: %d)", Get_settings_save_error_str(err_code), err_code);
-  return err_code;
+error:
+  if (f.fx_file_id == FX_FILE_ID) fx_file_close(&f);
+  fx_media_flush(&fat_fs_media);
+  return RES_ERROR;
 }
 
 /*-----------------------------------------------------------------------------------------------------
@@ -639,6 +579,19 @@ uint32_t Restore_settings_from_JSON_file(uint8_t ptype, char *file_name)
     if (res != FX_SUCCESS) goto EXIT_ON_ERROR;
   }
 
+  if (compressed == 0)
+  {
+    // Несжатый JSON разбирается потоком блоками фиксированного размера, без загрузки всего файла
+    res = JSON_Deser_settings_from_file(ptype, pf);
+    fx_file_close(pf);
+    if (res == RES_OK)
+    {
+      fx_file_delete(&fat_fs_media, file_name);
+    }
+    NV_MEM_FREE(pf);
+    return res;
+  }
+
   data_buf_sz = pf->fx_file_current_file_size;
   data_buf    = NV_MALLOC_PENDING(data_buf_sz + 1, 10);
   if (data_buf == NULL) goto EXIT_ON_ERROR;
@@ -763,6 +716,15 @@ static uint32_t Restore_settings_from_DataFlash(uint8_t ptype)
     goto EXIT_WITH_LOG;
   }
 
+  // Основной формат - двоичный журнал параметров
+  if (NV_journal_restore(ptype) == RES_OK)
+  {
+    g_settings_area_error_codes[ptype][0] = DF_AREA_ERR_NONE;
+    g_settings_area_error_codes[ptype][1] = DF_AREA_ERR_NONE;
+    return RES_OK;
+  }
+
+  // Журнала нет, пробуем сжатый JSON предыдущих версий. Он будет заменен журналом при первом сохранении.
   // Проходим по двум областям DataFlash в поисках валидных данных
   for (uint32_t i = 0; i < 2; i++)
   {
@@ -908,13 +870,22 @@ uint32_t Check_settings_in_DataFlash(uint8_t ptype, T_settings_state *sstate)
   if (ptype >= PARAMS_TYPES_NUM) return RES_ERROR;
   if (sstate == NULL) return RES_ERROR;
 
+  const T_nvj_state *p_nvj = NV_journal_get_state(ptype);
+
   for (uint32_t i = 0; i < 2; i++)
   {
     sstate->area_start_condition[i] = g_settings_area_error_codes[ptype][i];
 
     uint32_t flash_addr             = df_params_addr[ptype][i];
 
-    if (DataFlash_bgo_BlankCheck(flash_addr, 8) == RES_OK)
+    if ((p_nvj != NULL) && p_nvj->area_valid[i])
+    {
+      // Область с журналом параметров
+      sstate->area_sz[i]     = (i == p_nvj->active) ? p_nvj->tail : NVJ_HEADER_SZ;
+      sstate->area_wr_cnt[i] = p_nvj->area_seq[i];
+      sstate->area_state[i]  = ((i == p_nvj->active) && p_nvj->dirty) ? SETT_WRONG_CRC : SETT_OK;
+    }
+    else if (DataFlash_bgo_BlankCheck(flash_addr, 8) == RES_OK)
     {
       sstate->area_sz[i]     = 0;
       sstate->area_state[i]  = SETT_IS_BLANK;
@@ -122,7 +122,7 @@ void    Return_def_params(uint8_t ptype);
 uint32_t Restore_settings_from_INI_file(uint8_t ptype);
 uint32_t Save_settings_to_INI_file(uint8_t ptype);
 uint32_t Save_settings_to_file(char *file_name, uint8_t *buf, ULONG buf_sz, uint8_t ptype, uint8_t compressed);
-uint32_t Save_settings_to_DataFlash(uint8_t *buf, uint32_t buf_sz, uint8_t ptype);
+uint32_t Save_settings_to_JSON_file_stream(char *file_name, const T_NV_parameters_instance *p_pars, uint32_t flags, uint8_t ptype);
 
 uint32_t Save_settings(uint8_t ptype, uint8_t media_type, char *file_name);
 uint32_t Restore_settings_from_JSON_file(uint8_t ptype, char *file_name);
@@ -2,12 +2,12 @@
 #include "App.h"
 #include "MC80_Params.h"
 
-#define WVAR_SIZE 45
+#define WVAR_SIZE 65
 #define SELECTORS_NUM 5
 
 WVAR_TYPE wvar;
 
-static const T_parmenu parmenu[11] =
+static const T_parmenu parmenu[12] =
 {
   { MC80_0                      , MC80_main                   , "Parameters and settings                 ", "Основная категория  ",   1 }, // Parameters and settings
   { MC80_main                   , MC80_General                , "Device general settings                 ", "                    ",   1 }, // Device general settings
@@ -15,96 +15,14 @@ static const T_parmenu parmenu[11] =
   { MC80_main                   , MC80_Motor_Control          , "Motor control settings                  ", "                    ",   1 }, // Motor control settings
   { MC80_main                   , MC80_Display                , "Display settings                        ", "                    ",   1 }, // Display settings
   { MC80_main                   , MC80_FreeMaster             , "FreeMaster communication settings       ", "                    ",   1 }, // FreeMaster communication settings
+  { MC80_main                   , MC80_CAN_Telemetry          , "CAN telemetry broadcast settings        ", "                    ",   1 }, // CAN telemetry broadcast settings
   { MC80_main                   , MC80_USB_Interface          , "USB Interface settings                  ", "                    ",   1 }, // USB Interface settings
   { MC80_Motor_Control          , MC80_Motor_1                , "Traction motor settings                 ", "                    ",   1 }, // Traction motor settings
-  { MC80_Motor_Control          , MC80_Motor_2                , "Motor 2  settings               ", "                    ",   1 }, //  Motor 2ing settings
-  { MC80_Motor_Control          , MC80_Motor_3                , " settings                   ", "                    ",   1 }, //  settings
-  { MC80_Motor_Control          , MC80_Motor_4                , " settings                  ", "                    ",   1 }, //  settings
+  { MC80_Motor_Control          , MC80_Motor_2                , "Motor 2 settings                        ", "                    ",   1 }, // Motor 2 settings
+  { MC80_Motor_Control          , MC80_Motor_3                , "Motor 3 settings                        ", "                    ",   1 }, // Motor 3 settings
+  { MC80_Motor_Control          , MC80_Motor_4                , "Motor 4 settings                        ", "                    ",   1 }, // Motor 4 settings
 };
 
-// Parameter hash table for fast parameter lookup by CRC16 hash
-// Table is sorted by hash values for binary search
-typedef struct
-{
-  uint16_t hash;     // CRC16 hash of parameter name
-  uint16_t index;    // Index in parameter array
-} T_param_hash_entry;
-
-static const T_param_hash_entry param_hash_table[WVAR_SIZE] =
-{
-  {0x0624, 42},  // motor_4_decel_time_ms
-  {0x0D84, 10},  // pwm_frequency
-  {0x1002, 14},  // short_det_spike_filter
-  {0x1473, 32},  // motor_2_max_current_a
-  {0x1D1F, 11},  // usb_mode
-  {0x1E01, 34},  // motor_3_direction_invert
-  {0x1F32, 39},  // motor_4_max_pwm_percent
-  {0x21D2, 31},  // motor_2_algorithm
-  {0x31C5, 16},  // enable_short_to_gnd_prot
-  {0x336A, 24},  // motor_1_decel_time_ms
-  {0x3543, 35},  // motor_3_accel_time_ms
-  {0x36CC,  0},  // display_orientation
-  {0x4C58, 21},  // motor_1_max_pwm_percent
-  {0x4DD4, 41},  // motor_4_accel_time_ms
-  {0x502C,  5},  // hardware_version
-  {0x5161, 18},  // gate_driver_current_param
-  {0x5626,  4},  // software_version
-  {0x5928, 25},  // motor_1_algorithm
-  {0x6040, 20},  // input_shunt_resistor
-  {0x646B,  9},  // en_formated_settings
-  {0x6D9C, 33},  // motor_3_max_pwm_percent
-  {0x6ECE,  7},  // en_log_to_file
-  {0x7714, 17},  // enable_short_to_vs_prot
-  {0x789A, 23},  // motor_1_accel_time_ms
-  {0x7D7E, 27},  // motor_2_max_pwm_percent
-  {0x7EB3, 36},  // motor_3_decel_time_ms
-  {0x9416, 12},  // short_vs_det_level
-  {0x9BBF, 29},  // motor_2_accel_time_ms
-  {0xA7E8, 13},  // short_gnd_det_level
-  {0xA9C5,  1},  // en_freemaster
-  {0xAEC4, 19},  // shunt_resistor
-  {0xB8EB,  8},  // en_compress_settins
-  {0xBA8F, 38},  // motor_3_max_current_a
-  {0xC218, 44},  // motor_4_max_current_a
-  {0xD026, 43},  // motor_4_algorithm
-  {0xD04F, 30},  // motor_2_decel_time_ms
-  {0xD47E,  3},  // product_name
-  {0xDC64,  6},  // enable_log
-  {0xEE30, 28},  // motor_2_direction_invert
-  {0xEE42, 22},  // motor_1_direction_invert
-  {0xEED4, 40},  // motor_4_direction_invert
-  {0xF40E, 15},  // short_det_delay_param
-  {0xF756, 26},  // motor_1_max_current_a
-  {0xF85A,  2},  // en_log_to_freemaster
-  {0xF99B, 37}  // motor_3_algorithm
-};
-
-// Binary search function to find parameter index by CRC16 hash
-// Returns parameter index or 0xFFFF if not found
-uint16_t Find_param_by_hash(uint16_t hash)
-{
-  int left = 0;
-  int right = WVAR_SIZE - 1;
-
-  while (left <= right)
-  {
-    int mid = (left + right) / 2;
-    if (param_hash_table[mid].hash == hash)
-    {
-      return param_hash_table[mid].index;
-    }
-    if (param_hash_table[mid].hash < hash)
-    {
-      left = mid + 1;
-    }
-    else
-    {
-      right = mid - 1;
-    }
-  }
-  return 0xFFFF; // Parameter not found
-}
-
 // Parameter index-to-hash table for CAN command transmission
 // Array index corresponds to parameter index, value is CRC16 hash
 static const uint16_t param_index_to_hash_table[WVAR_SIZE] =
@@ -121,39 +39,59 @@ static const uint16_t param_index_to_hash_table[WVAR_SIZE] =
   0x646B,  // [ 9] en_formated_settings
   0x0D84,  // [10] pwm_frequency
   0x1D1F,  // [11] usb_mode
-  0x9416,  // [12] short_vs_det_level
-  0xA7E8,  // [13] short_gnd_det_level
-  0x1002,  // [14] short_det_spike_filter
-  0xF40E,  // [15] short_det_delay_param
-  0x31C5,  // [16] enable_short_to_gnd_prot
-  0x7714,  // [17] enable_short_to_vs_prot
-  0x5161,  // [18] gate_driver_current_param
-  0xAEC4,  // [19] shunt_resistor
-  0x6040,  // [20] input_shunt_resistor
-  0x4C58,  // [21] motor_1_max_pwm_percent
-  0xEE42,  // [22] motor_1_direction_invert
-  0x789A,  // [23] motor_1_accel_time_ms
-  0x336A,  // [24] motor_1_decel_time_ms
-  0x5928,  // [25] motor_1_algorithm
-  0xF756,  // [26] motor_1_max_current_a
-  0x7D7E,  // [27] motor_2_max_pwm_percent
-  0xEE30,  // [28] motor_2_direction_invert
-  0x9BBF,  // [29] motor_2_accel_time_ms
-  0xD04F,  // [30] motor_2_decel_time_ms
-  0x21D2,  // [31] motor_2_algorithm
-  0x1473,  // [32] motor_2_max_current_a
-  0x6D9C,  // [33] motor_3_max_pwm_percent
-  0x1E01,  // [34] motor_3_direction_invert
-  0x3543,  // [35] motor_3_accel_time_ms
-  0x7EB3,  // [36] motor_3_decel_time_ms
-  0xF99B,  // [37] motor_3_algorithm
-  0xBA8F,  // [38] motor_3_max_current_a
-  0x1F32,  // [39] motor_4_max_pwm_percent
-  0xEED4,  // [40] motor_4_direction_invert
-  0x4DD4,  // [41] motor_4_accel_time_ms
-  0x0624,  // [42] motor_4_decel_time_ms
-  0xD026,  // [43] motor_4_algorithm
-  0xC218  // [44] motor_4_max_current_a
+  0x31E4,  // [12] can_ans_period_ms
+  0x1681,  // [13] can_sens_period_ms
+  0x95F7,  // [14] can_pwr_period_ms
+  0xCCF0,  // [15] can_tlm_on_change
+  0x3903,  // [16] can_tlm_min_interval_ms
+  0xC780,  // [17] can_current_deadband_a
+  0xD1A4,  // [18] can_temp_deadband_c
+  0x8BE8,  // [19] can_position_deadband
+  0x9416,  // [20] short_vs_det_level
+  0xA7E8,  // [21] short_gnd_det_level
+  0x1002,  // [22] short_det_spike_filter
+  0xF40E,  // [23] short_det_delay_param
+  0x31C5,  // [24] enable_short_to_gnd_prot
+  0x7714,  // [25] enable_short_to_vs_prot
+  0x5161,  // [26] gate_driver_current_param
+  0xAEC4,  // [27] shunt_resistor
+  0x6040,  // [28] input_shunt_resistor
+  0x4C58,  // [29] motor_1_max_pwm_percent
+  0xEE42,  // [30] motor_1_direction_invert
+  0x789A,  // [31] motor_1_accel_time_ms
+  0x336A,  // [32] motor_1_decel_time_ms
+  0x5928,  // [33] motor_1_algorithm
+  0xF756,  // [34] motor_1_max_current_a
+  0x0AEF,  // [35] motor_1_max_accel
+  0x0E21,  // [36] motor_1_max_decel
+  0xE26E,  // [37] motor_1_jerk
+  0x7D7E,  // [38] motor_2_max_pwm_percent
+  0xEE30,  // [39] motor_2_direction_invert
+  0x9BBF,  // [40] motor_2_accel_time_ms
+  0xD04F,  // [41] motor_2_decel_time_ms
+  0x21D2,  // [42] motor_2_algorithm
+  0x1473,  // [43] motor_2_max_current_a
+  0x7215,  // [44] motor_2_max_accel
+  0x76DB,  // [45] motor_2_max_decel
+  0x2C8E,  // [46] motor_2_jerk
+  0x6D9C,  // [47] motor_3_max_pwm_percent
+  0x1E01,  // [48] motor_3_direction_invert
+  0x3543,  // [49] motor_3_accel_time_ms
+  0x7EB3,  // [50] motor_3_decel_time_ms
+  0xF99B,  // [51] motor_3_algorithm
+  0xBA8F,  // [52] motor_3_max_current_a
+  0xAA5C,  // [53] motor_3_max_accel
+  0xAE92,  // [54] motor_3_max_decel
+  0x692E,  // [55] motor_3_jerk
+  0x1F32,  // [56] motor_4_max_pwm_percent
+  0xEED4,  // [57] motor_4_direction_invert
+  0x4DD4,  // [58] motor_4_accel_time_ms
+  0x0624,  // [59] motor_4_decel_time_ms
+  0xD026,  // [60] motor_4_algorithm
+  0xC218,  // [61] motor_4_max_current_a
+  0x83E1,  // [62] motor_4_max_accel
+  0x872F,  // [63] motor_4_max_decel
+  0xA16F  // [64] motor_4_jerk
 };
 
 // Function to get parameter hash by index for CAN transmission
@@ -167,6 +105,265 @@ uint16_t Get_param_hash_by_index(uint16_t index)
   return param_index_to_hash_table[index];
 }
 
+// Minimal perfect hash indexes for O(1) parameter lookup by CRC16 hash, name and alias.
+// Built by the generator with collision checks, looked up with Param_phf_lookup().
+// Lookup result must be verified against the key because unknown keys also map to some slot.
+static const uint16_t param_hash_phf_disp[64] =
+{
+      1,     1,     1,     0,     0,     2,     1,     0,     0,     5,     0,    16,
+      0,     1,     1,     0,     0,     0,     0,     2,     8,     0,     0,     0,
+      0,     0,    12,     2,     3,     0,     0,     2,     0,     0,     0,     2,
+      8,     1,     0,     7,     0,     0,     1,     1,     0,     0,     4,    16,
+      2,    16,     0,     0,     0,    56,     0,     1,     2,     9,     0,    29,
+      0,    23,     0,   125
+};
+
+static const uint16_t param_hash_phf_slots[65] =
+{
+    0,  // [  0] display_orientation
+   45,  // [  1] motor_2_max_decel
+   10,  // [  2] pwm_frequency
+   37,  // [  3] motor_1_jerk
+   24,  // [  4] enable_short_to_gnd_prot
+    5,  // [  5] hardware_version
+   18,  // [  6] can_temp_deadband_c
+   54,  // [  7] motor_3_max_decel
+   46,  // [  8] motor_2_jerk
+   55,  // [  9] motor_3_jerk
+   50,  // [ 10] motor_3_decel_time_ms
+   17,  // [ 11] can_current_deadband_a
+   36,  // [ 12] motor_1_max_decel
+   26,  // [ 13] gate_driver_current_param
+   15,  // [ 14] can_tlm_on_change
+   44,  // [ 15] motor_2_max_accel
+   38,  // [ 16] motor_2_max_pwm_percent
+   42,  // [ 17] motor_2_algorithm
+   61,  // [ 18] motor_4_max_current_a
+   64,  // [ 19] motor_4_jerk
+    1,  // [ 20] en_freemaster
+   48,  // [ 21] motor_3_direction_invert
+    9,  // [ 22] en_formated_settings
+   59,  // [ 23] motor_4_decel_time_ms
+   33,  // [ 24] motor_1_algorithm
+   39,  // [ 25] motor_2_direction_invert
+    6,  // [ 26] enable_log
+   63,  // [ 27] motor_4_max_decel
+   52,  // [ 28] motor_3_max_current_a
+   30,  // [ 29] motor_1_direction_invert
+   40,  // [ 30] motor_2_accel_time_ms
+   13,  // [ 31] can_sens_period_ms
+   35,  // [ 32] motor_1_max_accel
+   14,  // [ 33] can_pwr_period_ms
+   43,  // [ 34] motor_2_max_current_a
+   62,  // [ 35] motor_4_max_accel
+   11,  // [ 36] usb_mode
+   22,  // [ 37] short_det_spike_filter
+   49,  // [ 38] motor_3_accel_time_ms
+   12,  // [ 39] can_ans_period_ms
+   53,  // [ 40] motor_3_max_accel
+    7,  // [ 41] en_log_to_file
+    2,  // [ 42] en_log_to_freemaster
+    4,  // [ 43] software_version
+   25,  // [ 44] enable_short_to_vs_prot
+   21,  // [ 45] short_gnd_det_level
+   32,  // [ 46] motor_1_decel_time_ms
+   29,  // [ 47] motor_1_max_pwm_percent
+   57,  // [ 48] motor_4_direction_invert
+   60,  // [ 49] motor_4_algorithm
+   27,  // [ 50] shunt_resistor
+   28,  // [ 51] input_shunt_resistor
+   58,  // [ 52] motor_4_accel_time_ms
+   41,  // [ 53] motor_2_decel_time_ms
+   34,  // [ 54] motor_1_max_current_a
+   47,  // [ 55] motor_3_max_pwm_percent
+    8,  // [ 56] en_compress_settins
+   20,  // [ 57] short_vs_det_level
+   16,  // [ 58] can_tlm_min_interval_ms
+   56,  // [ 59] motor_4_max_pwm_percent
+   31,  // [ 60] motor_1_accel_time_ms
+   23,  // [ 61] short_det_delay_param
+   19,  // [ 62] can_position_deadband
+   51,  // [ 63] motor_3_algorithm
+    3  // [ 64] product_name
+};
+
+static const T_param_phf param_hash_phf = { 65, 64, param_hash_phf_disp, param_hash_phf_slots };
+
+static const uint16_t param_name_phf_disp[64] =
+{
+      0,     0,     0,     0,     1,     0,     0,     0,     3,     0,     0,     0,
+      6,     0,     0,     0,     0,     1,     1,     0,     0,    16,     0,     0,
+      4,    13,     0,     1,     0,     0,    12,     5,     0,     0,     0,     0,
+      1,     1,    10,     0,     3,     5,     9,     6,     1,     0,     0,     0,
+      0,    10,     1,     6,     7,     8,    10,     0,     0,    39,     0,     3,
+      5,     0,     1,   114
+};
+
+static const uint16_t param_name_phf_slots[65] =
+{
+   46,  // [  0] motor_2_jerk
+    8,  // [  1] en_compress_settins
+   17,  // [  2] can_current_deadband_a
+   10,  // [  3] pwm_frequency
+   53,  // [  4] motor_3_max_accel
+   13,  // [  5] can_sens_period_ms
+   50,  // [  6] motor_3_decel_time_ms
+   40,  // [  7] motor_2_accel_time_ms
+   51,  // [  8] motor_3_algorithm
+   48,  // [  9] motor_3_direction_invert
+    1,  // [ 10] en_freemaster
+   63,  // [ 11] motor_4_max_decel
+   37,  // [ 12] motor_1_jerk
+   12,  // [ 13] can_ans_period_ms
+   59,  // [ 14] motor_4_decel_time_ms
+   36,  // [ 15] motor_1_max_decel
+    5,  // [ 16] hardware_version
+   45,  // [ 17] motor_2_max_decel
+   19,  // [ 18] can_position_deadband
+   24,  // [ 19] enable_short_to_gnd_prot
+   64,  // [ 20] motor_4_jerk
+   47,  // [ 21] motor_3_max_pwm_percent
+   14,  // [ 22] can_pwr_period_ms
+   30,  // [ 23] motor_1_direction_invert
+    2,  // [ 24] en_log_to_freemaster
+   41,  // [ 25] motor_2_decel_time_ms
+    9,  // [ 26] en_formated_settings
+    4,  // [ 27] software_version
+   57,  // [ 28] motor_4_direction_invert
+   11,  // [ 29] usb_mode
+   29,  // [ 30] motor_1_max_pwm_percent
+   62,  // [ 31] motor_4_max_accel
+   33,  // [ 32] motor_1_algorithm
+   26,  // [ 33] gate_driver_current_param
+   56,  // [ 34] motor_4_max_pwm_percent
+   20,  // [ 35] short_vs_det_level
+   27,  // [ 36] shunt_resistor
+   28,  // [ 37] input_shunt_resistor
+   22,  // [ 38] short_det_spike_filter
+    7,  // [ 39] en_log_to_file
+   18,  // [ 40] can_temp_deadband_c
+   31,  // [ 41] motor_1_accel_time_ms
+   43,  // [ 42] motor_2_max_current_a
+   35,  // [ 43] motor_1_max_accel
+   49,  // [ 44] motor_3_accel_time_ms
+   55,  // [ 45] motor_3_jerk
+    3,  // [ 46] product_name
+   42,  // [ 47] motor_2_algorithm
+   15,  // [ 48] can_tlm_on_change
+   54,  // [ 49] motor_3_max_decel
+   61,  // [ 50] motor_4_max_current_a
+   60,  // [ 51] motor_4_algorithm
+   58,  // [ 52] motor_4_accel_time_ms
+   52,  // [ 53] motor_3_max_current_a
+   38,  // [ 54] motor_2_max_pwm_percent
+   39,  // [ 55] motor_2_direction_invert
+    6,  // [ 56] enable_log
+   34,  // [ 57] motor_1_max_current_a
+   32,  // [ 58] motor_1_decel_time_ms
+   21,  // [ 59] short_gnd_det_level
+   16,  // [ 60] can_tlm_min_interval_ms
+   25,  // [ 61] enable_short_to_vs_prot
+   23,  // [ 62] short_det_delay_param
+   44,  // [ 63] motor_2_max_accel
+    0  // [ 64] display_orientation
+};
+
+static const T_param_phf param_name_phf = { 65, 64, param_name_phf_disp, param_name_phf_slots };
+
+static const uint16_t param_alias_phf_disp[64] =
+{
+      0,     2,     0,     0,     4,     3,     0,     0,     0,     0,     0,     0,
+      0,     3,     5,     1,     0,     0,     4,     4,     6,     0,     0,     0,
+      0,     0,     0,     4,     0,     0,     0,     0,     7,     1,     0,     0,
+      3,     0,     0,     3,     0,     0,     0,     2,     0,    12,    13,     0,
+      0,     0,     0,     0,     0,     7,     0,     9,     2,     0,     0,     6,
+      4,     5,    64,     2
+};
+
+static const uint16_t param_alias_phf_slots[65] =
+{
+    0,  // [  0] display_orientation
+   36,  // [  1] motor_1_max_decel
+   52,  // [  2] motor_3_max_current_a
+   13,  // [  3] can_sens_period_ms
+   43,  // [  4] motor_2_max_current_a
+   25,  // [  5] enable_short_to_vs_prot
+   31,  // [  6] motor_1_accel_time_ms
+   50,  // [  7] motor_3_decel_time_ms
+   38,  // [  8] motor_2_max_pwm_percent
+   45,  // [  9] motor_2_max_decel
+    2,  // [ 10] en_log_to_freemaster
+   55,  // [ 11] motor_3_jerk
+   15,  // [ 12] can_tlm_on_change
+   58,  // [ 13] motor_4_accel_time_ms
+    5,  // [ 14] hardware_version
+   23,  // [ 15] short_det_delay_param
+   57,  // [ 16] motor_4_direction_invert
+   20,  // [ 17] short_vs_det_level
+   44,  // [ 18] motor_2_max_accel
+   28,  // [ 19] input_shunt_resistor
+   46,  // [ 20] motor_2_jerk
+   54,  // [ 21] motor_3_max_decel
+   60,  // [ 22] motor_4_algorithm
+   61,  // [ 23] motor_4_max_current_a
+   12,  // [ 24] can_ans_period_ms
+   11,  // [ 25] usb_mode
+   19,  // [ 26] can_position_deadband
+   42,  // [ 27] motor_2_algorithm
+   35,  // [ 28] motor_1_max_accel
+   37,  // [ 29] motor_1_jerk
+   33,  // [ 30] motor_1_algorithm
+   16,  // [ 31] can_tlm_min_interval_ms
+    3,  // [ 32] product_name
+    9,  // [ 33] en_formated_settings
+   22,  // [ 34] short_det_spike_filter
+    4,  // [ 35] software_version
+   53,  // [ 36] motor_3_max_accel
+   21,  // [ 37] short_gnd_det_level
+   62,  // [ 38] motor_4_max_accel
+    8,  // [ 39] en_compress_settins
+   56,  // [ 40] motor_4_max_pwm_percent
+   39,  // [ 41] motor_2_direction_invert
+   30,  // [ 42] motor_1_direction_invert
+    6,  // [ 43] enable_log
+   14,  // [ 44] can_pwr_period_ms
+   27,  // [ 45] shunt_resistor
+   18,  // [ 46] can_temp_deadband_c
+   10,  // [ 47] pwm_frequency
+   40,  // [ 48] motor_2_accel_time_ms
+   32,  // [ 49] motor_1_decel_time_ms
+   59,  // [ 50] motor_4_decel_time_ms
+   49,  // [ 51] motor_3_accel_time_ms
+   64,  // [ 52] motor_4_jerk
+   24,  // [ 53] enable_short_to_gnd_prot
+   48,  // [ 54] motor_3_direction_invert
+   34,  // [ 55] motor_1_max_current_a
+   63,  // [ 56] motor_4_max_decel
+   26,  // [ 57] gate_driver_current_param
+   41,  // [ 58] motor_2_decel_time_ms
+   29,  // [ 59] motor_1_max_pwm_percent
+    7,  // [ 60] en_log_to_file
+   47,  // [ 61] motor_3_max_pwm_percent
+    1,  // [ 62] en_freemaster
+   51,  // [ 63] motor_3_algorithm
+   17  // [ 64] can_current_deadband_a
+};
+
+static const T_param_phf param_alias_phf = { 65, 64, param_alias_phf_disp, param_alias_phf_slots };
+
+// Find parameter index by CRC16 hash
+// Returns parameter index or 0xFFFF if not found
+uint16_t Find_param_by_hash(uint16_t hash)
+{
+  uint16_t index = Param_phf_lookup(&param_hash_phf, hash);
+
+  if (param_index_to_hash_table[index] != hash)
+  {
+    return 0xFFFF; // Parameter not found
+  }
+  return index;
+}
+
 // Array items are sorted by CategoryName followed by SubNumber
 static const T_NV_parameters arr_wvar[WVAR_SIZE] =
 {
@@ -183,39 +380,59 @@ static const T_NV_parameters arr_wvar[WVAR_SIZE] =
   { /* 09 */ "en_formated_settings"     , "Enable formatting in settings file"                                  , "NFRMTNG" , (void*)&wvar.en_formated_settings     , tint8u , 1     , 0     , 1     , 0   , MC80_General      , ""         , "%d"   , 0   , sizeof(wvar.en_formated_settings)     , 9       , 1           },
   { /* 10 */ "pwm_frequency"            , "PWM frequency for motor control (Hz)"                                , "PWMFRQHZ", (void*)&wvar.pwm_frequency            , tint32u, 8000  , 2000  , 16000 , 0   , MC80_General      , ""         , "%d"   , 0   , sizeof(wvar.pwm_frequency)            , 12      , 0           },
   { /* 11 */ "usb_mode"                 , "USB mode"                                                            , "SBMDSBM" , (void*)&wvar.usb_mode                 , tint32u, 1     , 0     , 7     , 0   , MC80_USB_Interface, ""         , "%d"   , 0   , sizeof(wvar.usb_mode)                 , 1       , 2           },
-  { /* 12 */ "short_vs_det_level"       , "Short to VS detector level for lowside FETs (1- highest..15-lowest)" , "SHRTVSD" , (void*)&wvar.short_vs_det_level       , tint32u, 12    , 1     , 15    , 0   , MC80_DriverIC     , ""         , "%d"   , 0   , sizeof(wvar.short_vs_det_level)       , 1       , 0           },
-  { /* 13 */ "short_gnd_det_level"      , "Short to GND detector level for highside FETs (2- highest..15lowest)", "SHRTGND" , (void*)&wvar.short_gnd_det_level      , tint32u, 12    , 2     , 15    , 0   , MC80_DriverIC     , ""         , "%d"   , 0   , sizeof(wvar.short_gnd_det_level)      , 2       , 0           },
-  { /* 14 */ "short_det_spike_filter"   , "Spike filtering bandwidth for short detection (0-100ns..3-3us)"      , "SHRTDTS" , (void*)&wvar.short_det_spike_filter   , tint32u, 0     , 0     , 3     , 0   , MC80_DriverIC     , ""         , "%d"   , 0   , sizeof(wvar.short_det_spike_filter)   , 3       , 0           },
-  { /* 15 */ "short_det_delay_param"    , "Short detection delay parameter (0..1)"                              , "SHRTDTD" , (void*)&wvar.short_det_delay_param    , tint32u, 0     , 0     , 1     , 0   , MC80_DriverIC     , ""         , "%d"   , 0   , sizeof(wvar.short_det_delay_param)    , 4       , 0           },
-  { /* 16 */ "enable_short_to_gnd_prot" , "Enable short to GND protection"                                      , "NBLSHRT" , (void*)&wvar.enable_short_to_gnd_prot , tint8u , 0     , 0     , 1     , 0   , MC80_DriverIC     , ""         , "%d"   , 0   , sizeof(wvar.enable_short_to_gnd_prot) , 5       , 1           },
-  { /* 17 */ "enable_short_to_vs_prot"  , "Enable short to VS protection"                                       , "NBLSHRA" , (void*)&wvar.enable_short_to_vs_prot  , tint8u , 0     , 0     , 1     , 0   , MC80_DriverIC     , ""         , "%d"   , 0   , sizeof(wvar.enable_short_to_vs_prot)  , 6       , 1           },
-  { /* 18 */ "gate_driver_current_param", "Gate driver current parameter (0-weak..4-strong)"                    , "GTDRVRC" , (void*)&wvar.gate_driver_current_param, tint32u, 2     , 0     , 3     , 0   , MC80_DriverIC     , ""         , "%d"   , 0   , sizeof(wvar.gate_driver_current_param), 7       , 0           },
-  { /* 19 */ "shunt_resistor"           , "Shunt resistor (Ohm)"                                                , "SHNTRSS" , (void*)&wvar.shunt_resistor           , tfloat , 0.002 , 0     , 1     , 0   , MC80_DriverIC     , ""         , "%0.6f", 0   , sizeof(wvar.shunt_resistor)           , 8       , 0           },
-  { /* 20 */ "input_shunt_resistor"     , "Input shunt resistor (Ohm)"                                          , "NPTSHNT" , (void*)&wvar.input_shunt_resistor     , tfloat , 0.001 , 0     , 1     , 0   , MC80_DriverIC     , ""         , "%0.6f", 0   , sizeof(wvar.input_shunt_resistor)     , 9       , 0           },
-  { /* 21 */ "motor_1_max_pwm_percent"  , "Maximum PWM level (percent)"                                         , "MOTR1PWM", (void*)&wvar.motor_1_max_pwm_percent  , tint8u , 100   , 1     , 100   , 0   , MC80_Motor_1      , ""         , "%d"   , 0   , sizeof(wvar.motor_1_max_pwm_percent)  , 1       , 0           },
-  { /* 22 */ "motor_1_direction_invert" , "Direction invert flag"                                               , "MOTR1INV", (void*)&wvar.motor_1_direction_invert , tint8u , 0     , 0     , 1     , 0   , MC80_Motor_1      , ""         , "%d"   , 0   , sizeof(wvar.motor_1_direction_invert) , 2       , 1           },
-  { /* 23 */ "motor_1_accel_time_ms"    , "Acceleration time (ms)"                                              , "MOTR1ACC", (void*)&wvar.motor_1_accel_time_ms    , tint32u, 1000  , 0     , 10000 , 0   , MC80_Motor_1      , ""         , "%d"   , 0   , sizeof(wvar.motor_1_accel_time_ms)    , 3       , 0           },
-  { /* 24 */ "motor_1_decel_time_ms"    , "Deceleration time (ms)"                                              , "MOTR1DEC", (void*)&wvar.motor_1_decel_time_ms    , tint32u, 500   , 0     , 10000 , 0   , MC80_Motor_1      , ""         , "%d"   , 0   , sizeof(wvar.motor_1_decel_time_ms)    , 4       , 0           },
-  { /* 25 */ "motor_1_algorithm"        , "Acceleration/Deceleration algorithm"                                 , "MOTR1ALG", (void*)&wvar.motor_1_algorithm        , tint8u , 2     , 0     , 2     , 0   , MC80_Motor_1      , ""         , "%d"   , 0   , sizeof(wvar.motor_1_algorithm)        , 5       , 3           },
-  { /* 26 */ "motor_1_max_current_a"    , "Maximum current for emergency stop (A)"                              , "MOTR1CUR", (void*)&wvar.motor_1_max_current_a    , tfloat , 25.0  , 0.1   , 100.0 , 0   , MC80_Motor_1      , ""         , "%0.1f", 0   , sizeof(wvar.motor_1_max_current_a)    , 6       , 0           },
-  { /* 27 */ "motor_2_max_pwm_percent"  , "Maximum PWM level (percent)"                                         , "MOTR2PWM", (void*)&wvar.motor_2_max_pwm_percent  , tint8u , 100   , 1     , 100   , 0   , MC80_Motor_2      , ""         , "%d"   , 0   , sizeof(wvar.motor_2_max_pwm_percent)  , 1       , 0           },
-  { /* 28 */ "motor_2_direction_invert" , "Direction invert flag"                                               , "MOTR2INV", (void*)&wvar.motor_2_direction_invert , tint8u , 0     , 0     , 1     , 0   , MC80_Motor_2      , ""         , "%d"   , 0   , sizeof(wvar.motor_2_direction_invert) , 2       , 1           },
-  { /* 29 */ "motor_2_accel_time_ms"    , "Acceleration time (ms)"                                              , "MOTR2ACC", (void*)&wvar.motor_2_accel_time_ms    , tint32u, 1000  , 0     , 10000 , 0   , MC80_Motor_2      , ""         , "%d"   , 0   , sizeof(wvar.motor_2_accel_time_ms)    , 3       , 0           },
-  { /* 30 */ "motor_2_decel_time_ms"    , "Deceleration time (ms)"                                              , "MOTR2DEC", (void*)&wvar.motor_2_decel_time_ms    , tint32u, 100   , 0     , 10000 , 0   , MC80_Motor_2      , ""         , "%d"   , 0   , sizeof(wvar.motor_2_decel_time_ms)    , 4       , 0           },
-  { /* 31 */ "motor_2_algorithm"        , "Acceleration/Deceleration algorithm"                                 , "MOTR2ALG", (void*)&wvar.motor_2_algorithm        , tint8u , 2     , 0     , 2     , 0   , MC80_Motor_2      , ""         , "%d"   , 0   , sizeof(wvar.motor_2_algorithm)        , 5       , 3           },
-  { /* 32 */ "motor_2_max_current_a"    , "Maximum current for emergency stop (A)"                              , "MOTR2CUR", (void*)&wvar.motor_2_max_current_a    , tfloat , 5.0   , 0.1   , 100.0 , 0   , MC80_Motor_2      , ""         , "%0.1f", 0   , sizeof(wvar.motor_2_max_current_a)    , 6       , 0           },
-  { /* 33 */ "motor_3_max_pwm_percent"  , "Maximum PWM level (percent)"                                         , "MOTR3PWM", (void*)&wvar.motor_3_max_pwm_percent  , tint8u , 100   , 1     , 100   , 0   , MC80_Motor_3      , ""         , "%d"   , 0   , sizeof(wvar.motor_3_max_pwm_percent)  , 1       , 0           },
-  { /* 34 */ "motor_3_direction_invert" , "Direction invert flag"                                               , "MOTR3INV", (void*)&wvar.motor_3_direction_invert , tint8u , 0     , 0     , 1     , 0   , MC80_Motor_3      , ""         , "%d"   , 0   , sizeof(wvar.motor_3_direction_invert) , 2       , 1           },
-  { /* 35 */ "motor_3_accel_time_ms"    , "Acceleration time (ms)"                                              , "MOTR3ACC", (void*)&wvar.motor_3_accel_time_ms    , tint32u, 1000  , 0     , 10000 , 0   , MC80_Motor_3      , ""         , "%d"   , 0   , sizeof(wvar.motor_3_accel_time_ms)    , 3       , 0           },
-  { /* 36 */ "motor_3_decel_time_ms"    , "Deceleration time (ms)"                                              , "MOTR3DEC", (void*)&wvar.motor_3_decel_time_ms    , tint32u, 100   , 0     , 10000 , 0   , MC80_Motor_3      , ""         , "%d"   , 0   , sizeof(wvar.motor_3_decel_time_ms)    , 4       , 0           },
-  { /* 37 */ "motor_3_algorithm"        , "Acceleration/Deceleration algorithm"                                 , "MOTR3ALG", (void*)&wvar.motor_3_algorithm        , tint8u , 2     , 0     , 2     , 0   , MC80_Motor_3      , ""         , "%d"   , 0   , sizeof(wvar.motor_3_algorithm)        , 5       , 3           },
-  { /* 38 */ "motor_3_max_current_a"    , "Maximum current for emergency stop (A)"                              , "MOTR3CUR", (void*)&wvar.motor_3_max_current_a    , tfloat , 4.0   , 0.1   , 100.0 , 0   , MC80_Motor_3      , ""         , "%0.1f", 0   , sizeof(wvar.motor_3_max_current_a)    , 6       , 0           },
-  { /* 39 */ "motor_4_max_pwm_percent"  , "Maximum PWM level (percent)"                                         , "MOTR4PWM", (void*)&wvar.motor_4_max_pwm_percent  , tint8u , 100   , 1     , 100   , 0   , MC80_Motor_4      , ""         , "%d"   , 0   , sizeof(wvar.motor_4_max_pwm_percent)  , 1       , 0           },
-  { /* 40 */ "motor_4_direction_invert" , "Direction invert flag"                                               , "MOTR4INV", (void*)&wvar.motor_4_direction_invert , tint8u , 0     , 0     , 1     , 0   , MC80_Motor_4      , ""         , "%d"   , 0   , sizeof(wvar.motor_4_direction_invert) , 2       , 1           },
-  { /* 41 */ "motor_4_accel_time_ms"    , "Acceleration time (ms)"                                              , "MOTR4ACC", (void*)&wvar.motor_4_accel_time_ms    , tint32u, 1000  , 0     , 10000 , 0   , MC80_Motor_4      , ""         , "%d"   , 0   , sizeof(wvar.motor_4_accel_time_ms)    , 3       , 0           },
-  { /* 42 */ "motor_4_decel_time_ms"    , "Deceleration time (ms)"                                              , "MOTR4DEC", (void*)&wvar.motor_4_decel_time_ms    , tint32u, 100   , 0     , 10000 , 0   , MC80_Motor_4      , ""         , "%d"   , 0   , sizeof(wvar.motor_4_decel_time_ms)    , 4       , 0           },
-  { /* 43 */ "motor_4_algorithm"        , "Acceleration/Deceleration algorithm"                                 , "MOTR4ALG", (void*)&wvar.motor_4_algorithm        , tint8u , 2     , 0     , 2     , 0   , MC80_Motor_4      , ""         , "%d"   , 0   , sizeof(wvar.motor_4_algorithm)        , 5       , 3           },
-  { /* 44 */ "motor_4_max_current_a"    , "Maximum current for emergency stop (A)"                              , "MOTR4CUR", (void*)&wvar.motor_4_max_current_a    , tfloat , 4.0   , 0.1   , 50.0  , 0   , MC80_Motor_4      , ""         , "%0.1f", 0   , sizeof(wvar.motor_4_max_current_a)    , 6       , 0           }
+  { /* 12 */ "can_ans_period_ms"        , "Status (ANS) broadcast period (ms, 0 - off)"                         , "CNANSPR" , (void*)&wvar.can_ans_period_ms        , tint32u, 0     , 0     , 60000 , 0   , MC80_CAN_Telemetry, ""         , "%d"   , 0   , sizeof(wvar.can_ans_period_ms)        , 1       , 0           },
+  { /* 13 */ "can_sens_period_ms"       , "Sensor info (SENS_INFO) broadcast period (ms, 0 - off)"              , "CNSNSPR" , (void*)&wvar.can_sens_period_ms       , tint32u, 0     , 0     , 60000 , 0   , MC80_CAN_Telemetry, ""         , "%d"   , 0   , sizeof(wvar.can_sens_period_ms)       , 2       , 0           },
+  { /* 14 */ "can_pwr_period_ms"        , "Power info (PWR_INFO) broadcast period (ms, 0 - off)"                , "CNPWRPR" , (void*)&wvar.can_pwr_period_ms        , tint32u, 0     , 0     , 60000 , 0   , MC80_CAN_Telemetry, ""         , "%d"   , 0   , sizeof(wvar.can_pwr_period_ms)        , 3       , 0           },
+  { /* 15 */ "can_tlm_on_change"        , "Send on state change and deadband excess"                            , "CNTLMCH" , (void*)&wvar.can_tlm_on_change        , tint8u , 0     , 0     , 1     , 0   , MC80_CAN_Telemetry, ""         , "%d"   , 0   , sizeof(wvar.can_tlm_on_change)        , 4       , 1           },
+  { /* 16 */ "can_tlm_min_interval_ms"  , "Minimum interval of change triggered frames (ms)"                    , "CNTLMMN" , (void*)&wvar.can_tlm_min_interval_ms  , tint32u, 20    , 0     , 1000  , 0   , MC80_CAN_Telemetry, ""         , "%d"   , 0   , sizeof(wvar.can_tlm_min_interval_ms)  , 5       , 0           },
+  { /* 17 */ "can_current_deadband_a"   , "Motor current deadband (A, 0 - off)"                                 , "CNCURDB" , (void*)&wvar.can_current_deadband_a   , tfloat , 0.5   , 0     , 100   , 0   , MC80_CAN_Telemetry, ""         , "%0.1f", 0   , sizeof(wvar.can_current_deadband_a)   , 6       , 0           },
+  { /* 18 */ "can_temp_deadband_c"      , "Driver temperature deadband (C, 0 - off)"                            , "CNTMPDB" , (void*)&wvar.can_temp_deadband_c      , tfloat , 2.0   , 0     , 100   , 0   , MC80_CAN_Telemetry, ""         , "%0.1f", 0   , sizeof(wvar.can_temp_deadband_c)      , 7       , 0           },
+  { /* 19 */ "can_position_deadband"    , "Position sensor deadband (ADC counts, 0 - off)"                      , "CNPOSDB" , (void*)&wvar.can_position_deadband    , tint32u, 20    , 0     , 4095  , 0   , MC80_CAN_Telemetry, ""         , "%d"   , 0   , sizeof(wvar.can_position_deadband)    , 8       , 0           },
+  { /* 20 */ "short_vs_det_level"       , "Short to VS detector level for lowside FETs (1- highest..15-lowest)" , "SHRTVSD" , (void*)&wvar.short_vs_det_level       , tint32u, 12    , 1     , 15    , 0   , MC80_DriverIC     , ""         , "%d"   , 0   , sizeof(wvar.short_vs_det_level)       , 1       , 0           },
+  { /* 21 */ "short_gnd_det_level"      , "Short to GND detector level for highside FETs (2- highest..15lowest)", "SHRTGND" , (void*)&wvar.short_gnd_det_level      , tint32u, 12    , 2     , 15    , 0   , MC80_DriverIC     , ""         , "%d"   , 0   , sizeof(wvar.short_gnd_det_level)      , 2       , 0           },
+  { /* 22 */ "short_det_spike_filter"   , "Spike filtering bandwidth for short detection (0-100ns..3-3us)"      , "SHRTDTS" , (void*)&wvar.short_det_spike_filter   , tint32u, 0     , 0     , 3     , 0   , MC80_DriverIC     , ""         , "%d"   , 0   , sizeof(wvar.short_det_spike_filter)   , 3       , 0           },
+  { /* 23 */ "short_det_delay_param"    , "Short detection delay parameter (0..1)"                              , "SHRTDTD" , (void*)&wvar.short_det_delay_param    , tint32u, 0     , 0     , 1     , 0   , MC80_DriverIC     , ""         , "%d"   , 0   , sizeof(wvar.short_det_delay_param)    , 4       , 0           },
+  { /* 24 */ "enable_short_to_gnd_prot" , "Enable short to GND protection"                                      , "NBLSHRT" , (void*)&wvar.enable_short_to_gnd_prot , tint8u , 0     , 0     , 1     , 0   , MC80_DriverIC     , ""         , "%d"   , 0   , sizeof(wvar.enable_short_to_gnd_prot) , 5       , 1           },
+  { /* 25 */ "enable_short_to_vs_prot"  , "Enable short to VS protection"                                       , "NBLSHRA" , (void*)&wvar.enable_short_to_vs_prot  , tint8u , 0     , 0     , 1     , 0   , MC80_DriverIC     , ""         , "%d"   , 0   , sizeof(wvar.enable_short_to_vs_prot)  , 6       , 1           },
+  { /* 26 */ "gate_driver_current_param", "Gate driver current parameter (0-weak..4-strong)"                    , "GTDRVRC" , (void*)&wvar.gate_driver_current_param, tint32u, 2     , 0     , 3     , 0   , MC80_DriverIC     , ""         , "%d"   , 0   , sizeof(wvar.gate_driver_current_param), 7       , 0           },
+  { /* 27 */ "shunt_resistor"           , "Shunt resistor (Ohm)"                                                , "SHNTRSS" , (void*)&wvar.shunt_resistor           , tfloat , 0.002 , 0     , 1     , 0   , MC80_DriverIC     , ""         , "%0.6f", 0   , sizeof(wvar.shunt_resistor)           , 8       , 0           },
+  { /* 28 */ "input_shunt_resistor"     , "Input shunt resistor (Ohm)"                                          , "NPTSHNT" , (void*)&wvar.input_shunt_resistor     , tfloat , 0.001 , 0     , 1     , 0   , MC80_DriverIC     , ""         , "%0.6f", 0   , sizeof(wvar.input_shunt_resistor)     , 9       , 0           },
+  { /* 29 */ "motor_1_max_pwm_percent"  , "Maximum PWM level (percent)"                                         , "MOTR1PWM", (void*)&wvar.motor_1_max_pwm_percent  , tint8u , 100   , 1     , 100   , 0   , MC80_Motor_1      , ""         , "%d"   , 0   , sizeof(wvar.motor_1_max_pwm_percent)  , 1       , 0           },
+  { /* 30 */ "motor_1_direction_invert" , "Direction invert flag"                                               , "MOTR1INV", (void*)&wvar.motor_1_direction_invert , tint8u , 0     , 0     , 1     , 0   , MC80_Motor_1      , ""         , "%d"   , 0   , sizeof(wvar.motor_1_direction_invert) , 2       , 1           },
+  { /* 31 */ "motor_1_accel_time_ms"    , "Acceleration time (ms)"                                              , "MOTR1ACC", (void*)&wvar.motor_1_accel_time_ms    , tint32u, 1000  , 0     , 10000 , 0   , MC80_Motor_1      , ""         , "%d"   , 0   , sizeof(wvar.motor_1_accel_time_ms)    , 3       , 0           },
+  { /* 32 */ "motor_1_decel_time_ms"    , "Deceleration time (ms)"                                              , "MOTR1DEC", (void*)&wvar.motor_1_decel_time_ms    , tint32u, 500   , 0     , 10000 , 0   , MC80_Motor_1      , ""         , "%d"   , 0   , sizeof(wvar.motor_1_decel_time_ms)    , 4       , 0           },
+  { /* 33 */ "motor_1_algorithm"        , "Acceleration/Deceleration algorithm"                                 , "MOTR1ALG", (void*)&wvar.motor_1_algorithm        , tint8u , 2     , 0     , 3     , 0   , MC80_Motor_1      , ""         , "%d"   , 0   , sizeof(wvar.motor_1_algorithm)        , 5       , 3           },
+  { /* 34 */ "motor_1_max_current_a"    , "Maximum current for emergency stop (A)"                              , "MOTR1CUR", (void*)&wvar.motor_1_max_current_a    , tfloat , 25.0  , 0.1   , 100.0 , 0   , MC80_Motor_1      , ""         , "%0.1f", 0   , sizeof(wvar.motor_1_max_current_a)    , 6       , 0           },
+  { /* 35 */ "motor_1_max_accel"        , "Jerk limited profile: maximum acceleration (%/s)"                    , "MOTR1ACL", (void*)&wvar.motor_1_max_accel        , tint32u, 200   , 1     , 10000 , 0   , MC80_Motor_1      , ""         , "%d"   , 0   , sizeof(wvar.motor_1_max_accel)        , 7       , 0           },
+  { /* 36 */ "motor_1_max_decel"        , "Jerk limited profile: maximum deceleration (%/s)"                    , "MOTR1DCL", (void*)&wvar.motor_1_max_decel        , tint32u, 200   , 1     , 10000 , 0   , MC80_Motor_1      , ""         , "%d"   , 0   , sizeof(wvar.motor_1_max_decel)        , 8       , 0           },
+  { /* 37 */ "motor_1_jerk"             , "Jerk limited profile: jerk (%/s^2)"                                  , "MOTR1JRK", (void*)&wvar.motor_1_jerk             , tint32u, 1000  , 1     , 100000, 0   , MC80_Motor_1      , ""         , "%d"   , 0   , sizeof(wvar.motor_1_jerk)             , 9       , 0           },
+  { /* 38 */ "motor_2_max_pwm_percent"  , "Maximum PWM level (percent)"                                         , "MOTR2PWM", (void*)&wvar.motor_2_max_pwm_percent  , tint8u , 100   , 1     , 100   , 0   , MC80_Motor_2      , ""         , "%d"   , 0   , sizeof(wvar.motor_2_max_pwm_percent)  , 1       , 0           },
+  { /* 39 */ "motor_2_direction_invert" , "Direction invert flag"                                               , "MOTR2INV", (void*)&wvar.motor_2_direction_invert , tint8u , 0     , 0     , 1     , 0   , MC80_Motor_2      , ""         , "%d"   , 0   , sizeof(wvar.motor_2_direction_invert) , 2       , 1           },
+  { /* 40 */ "motor_2_accel_time_ms"    , "Acceleration time (ms)"                                              , "MOTR2ACC", (void*)&wvar.motor_2_accel_time_ms    , tint32u, 1000  , 0     , 10000 , 0   , MC80_Motor_2      , ""         , "%d"   , 0   , sizeof(wvar.motor_2_accel_time_ms)    , 3       , 0           },
+  { /* 41 */ "motor_2_decel_time_ms"    , "Deceleration time (ms)"                                              , "MOTR2DEC", (void*)&wvar.motor_2_decel_time_ms    , tint32u, 100   , 0     , 10000 , 0   , MC80_Motor_2      , ""         , "%d"   , 0   , sizeof(wvar.motor_2_decel_time_ms)    , 4       , 0           },
+  { /* 42 */ "motor_2_algorithm"        , "Acceleration/Deceleration algorithm"                                 , "MOTR2ALG", (void*)&wvar.motor_2_algorithm        , tint8u , 2     , 0     , 3     , 0   , MC80_Motor_2      , ""         , "%d"   , 0   , sizeof(wvar.motor_2_algorithm)        , 5       , 3           },
+  { /* 43 */ "motor_2_max_current_a"    , "Maximum current for emergency stop (A)"                              , "MOTR2CUR", (void*)&wvar.motor_2_max_current_a    , tfloat , 5.0   , 0.1   , 100.0 , 0   , MC80_Motor_2      , ""         , "%0.1f", 0   , sizeof(wvar.motor_2_max_current_a)    , 6       , 0           },
+  { /* 44 */ "motor_2_max_accel"        , "Jerk limited profile: maximum acceleration (%/s)"                    , "MOTR2ACL", (void*)&wvar.motor_2_max_accel        , tint32u, 200   , 1     , 10000 , 0   , MC80_Motor_2      , ""         , "%d"   , 0   , sizeof(wvar.motor_2_max_accel)        , 7       , 0           },
+  { /* 45 */ "motor_2_max_decel"        , "Jerk limited profile: maximum deceleration (%/s)"                    , "MOTR2DCL", (void*)&wvar.motor_2_max_decel        , tint32u, 200   , 1     , 10000 , 0   , MC80_Motor_2      , ""         , "%d"   , 0   , sizeof(wvar.motor_2_max_decel)        , 8       , 0           },
+  { /* 46 */ "motor_2_jerk"             , "Jerk limited profile: jerk (%/s^2)"                                  , "MOTR2JRK", (void*)&wvar.motor_2_jerk             , tint32u, 1000  , 1     , 100000, 0   , MC80_Motor_2      , ""         , "%d"   , 0   , sizeof(wvar.motor_2_jerk)             , 9       , 0           },
+  { /* 47 */ "motor_3_max_pwm_percent"  , "Maximum PWM level (percent)"                                         , "MOTR3PWM", (void*)&wvar.motor_3_max_pwm_percent  , tint8u , 100   , 1     , 100   , 0   , MC80_Motor_3      , ""         , "%d"   , 0   , sizeof(wvar.motor_3_max_pwm_percent)  , 1       , 0           },
+  { /* 48 */ "motor_3_direction_invert" , "Direction invert flag"                                               , "MOTR3INV", (void*)&wvar.motor_3_direction_invert , tint8u , 0     , 0     , 1     , 0   , MC80_Motor_3      , ""         , "%d"   , 0   , sizeof(wvar.motor_3_direction_invert) , 2       , 1           },
+  { /* 49 */ "motor_3_accel_time_ms"    , "Acceleration time (ms)"                                              , "MOTR3ACC", (void*)&wvar.motor_3_accel_time_ms    , tint32u, 1000  , 0     , 10000 , 0   , MC80_Motor_3      , ""         , "%d"   , 0   , sizeof(wvar.motor_3_accel_time_ms)    , 3       , 0           },
+  { /* 50 */ "motor_3_decel_time_ms"    , "Deceleration time (ms)"                                              , "MOTR3DEC", (void*)&wvar.motor_3_decel_time_ms    , tint32u, 100   , 0     , 10000 , 0   , MC80_Motor_3      , ""         , "%d"   , 0   , sizeof(wvar.motor_3_decel_time_ms)    , 4       , 0           },
+  { /* 51 */ "motor_3_algorithm"        , "Acceleration/Deceleration algorithm"                                 , "MOTR3ALG", (void*)&wvar.motor_3_algorithm        , tint8u , 2     , 0     , 3     , 0   , MC80_Motor_3      , ""         , "%d"   , 0   , sizeof(wvar.motor_3_algorithm)        , 5       , 3           },
+  { /* 52 */ "motor_3_max_current_a"    , "Maximum current for emergency stop (A)"                              , "MOTR3CUR", (void*)&wvar.motor_3_max_current_a    , tfloat , 4.0   , 0.1   , 100.0 , 0   , MC80_Motor_3      , ""         , "%0.1f", 0   , sizeof(wvar.motor_3_max_current_a)    , 6       , 0           },
+  { /* 53 */ "motor_3_max_accel"        , "Jerk limited profile: maximum acceleration (%/s)"                    , "MOTR3ACL", (void*)&wvar.motor_3_max_accel        , tint32u, 200   , 1     , 10000 , 0   , MC80_Motor_3      , ""         , "%d"   , 0   , sizeof(wvar.motor_3_max_accel)        , 7       , 0           },
+  { /* 54 */ "motor_3_max_decel"        , "Jerk limited profile: maximum deceleration (%/s)"                    , "MOTR3DCL", (void*)&wvar.motor_3_max_decel        , tint32u, 200   , 1     , 10000 , 0   , MC80_Motor_3      , ""         , "%d"   , 0   , sizeof(wvar.motor_3_max_decel)        , 8       , 0           },
+  { /* 55 */ "motor_3_jerk"             , "Jerk limited profile: jerk (%/s^2)"                                  , "MOTR3JRK", (void*)&wvar.motor_3_jerk             , tint32u, 1000  , 1     , 100000, 0   , MC80_Motor_3      , ""         , "%d"   , 0   , sizeof(wvar.motor_3_jerk)             , 9       , 0           },
+  { /* 56 */ "motor_4_max_pwm_percent"  , "Maximum PWM level (percent)"                                         , "MOTR4PWM", (void*)&wvar.motor_4_max_pwm_percent  , tint8u , 100   , 1     , 100   , 0   , MC80_Motor_4      , ""         , "%d"   , 0   , sizeof(wvar.motor_4_max_pwm_percent)  , 1       , 0           },
+  { /* 57 */ "motor_4_direction_invert" , "Direction invert flag"                                               , "MOTR4INV", (void*)&wvar.motor_4_direction_invert , tint8u , 0     , 0     , 1     , 0   , MC80_Motor_4      , ""         , "%d"   , 0   , sizeof(wvar.motor_4_direction_invert) , 2       , 1           },
+  { /* 58 */ "motor_4_accel_time_ms"    , "Acceleration time (ms)"                                              , "MOTR4ACC", (void*)&wvar.motor_4_accel_time_ms    , tint32u, 1000  , 0     , 10000 , 0   , MC80_Motor_4      , ""         , "%d"   , 0   , sizeof(wvar.motor_4_accel_time_ms)    , 3       , 0           },
+  { /* 59 */ "motor_4_decel_time_ms"    , "Deceleration time (ms)"                                              , "MOTR4DEC", (void*)&wvar.motor_4_decel_time_ms    , tint32u, 100   , 0     , 10000 , 0   , MC80_Motor_4      , ""         , "%d"   , 0   , sizeof(wvar.motor_4_decel_time_ms)    , 4       , 0           },
+  { /* 60 */ "motor_4_algorithm"        , "Acceleration/Deceleration algorithm"                                 , "MOTR4ALG", (void*)&wvar.motor_4_algorithm        , tint8u , 2     , 0     , 3     , 0   , MC80_Motor_4      , ""         , "%d"   , 0   , sizeof(wvar.motor_4_algorithm)        , 5       , 3           },
+  { /* 61 */ "motor_4_max_current_a"    , "Maximum current for emergency stop (A)"                              , "MOTR4CUR", (void*)&wvar.motor_4_max_current_a    , tfloat , 4.0   , 0.1   , 50.0  , 0   , MC80_Motor_4      , ""         , "%0.1f", 0   , sizeof(wvar.motor_4_max_current_a)    , 6       , 0           },
+  { /* 62 */ "motor_4_max_accel"        , "Jerk limited profile: maximum acceleration (%/s)"                    , "MOTR4ACL", (void*)&wvar.motor_4_max_accel        , tint32u, 200   , 1     , 10000 , 0   , MC80_Motor_4      , ""         , "%d"   , 0   , sizeof(wvar.motor_4_max_accel)        , 7       , 0           },
+  { /* 63 */ "motor_4_max_decel"        , "Jerk limited profile: maximum deceleration (%/s)"                    , "MOTR4DCL", (void*)&wvar.motor_4_max_decel        , tint32u, 200   , 1     , 10000 , 0   , MC80_Motor_4      , ""         , "%d"   , 0   , sizeof(wvar.motor_4_max_decel)        , 8       , 0           },
+  { /* 64 */ "motor_4_jerk"             , "Jerk limited profile: jerk (%/s^2)"                                  , "MOTR4JRK", (void*)&wvar.motor_4_jerk             , tint32u, 1000  , 1     , 100000, 0   , MC80_Motor_4      , ""         , "%d"   , 0   , sizeof(wvar.motor_4_jerk)             , 9       , 0           }
 };
 
 // Selector description:  Выбор между Yes и No
@@ -238,11 +455,12 @@ static const T_selector_items selector_3[7] =
 };
 
 // Selector description:  Acceleration/deceleration algorithm selection
-static const T_selector_items selector_4[3] =
+static const T_selector_items selector_4[4] =
 {
   { 0 , "Instant"                                   , -1},
   { 1 , "Linear"                                    , -1},
   { 2 , "S-curve"                                   , -1},
+  { 3 , "Jerk limited"                              , -1},
 };
 
 static const T_selectors_list selectors_list[4] =
@@ -250,15 +468,17 @@ static const T_selectors_list selectors_list[4] =
   {"string                        ", 0   , 0           },
   {"binary                        ", 2   , selector_2  },
   {"usb_mode                      ", 7   , selector_3  },
-  {"accel_decel_alg               ", 3   , selector_4  },
+  {"accel_decel_alg               ", 4   , selector_4  },
 };
 
 const T_NV_parameters_instance wvar_inst =
 {
   WVAR_SIZE,
   arr_wvar,
-  11,
+  12,
   parmenu,
   SELECTORS_NUM,
-  selectors_list
+  selectors_list,
+  &param_name_phf,
+  &param_alias_phf
 };
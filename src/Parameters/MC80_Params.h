@@ -11,11 +11,12 @@
 #define MC80_Motor_Control 4
 #define MC80_Display       5
 #define MC80_FreeMaster    6
-#define MC80_USB_Interface 7
-#define MC80_Motor_1       8
-#define MC80_Motor_2       9
-#define MC80_Motor_3       10
-#define MC80_Motor_4       11
+#define MC80_CAN_Telemetry 7
+#define MC80_USB_Interface 8
+#define MC80_Motor_1       9
+#define MC80_Motor_2       10
+#define MC80_Motor_3       11
+#define MC80_Motor_4       12
 
 typedef struct
 {
@@ -31,6 +32,14 @@ typedef struct
   uint8_t en_formated_settings;        // Enable formatting in settings file
   uint32_t pwm_frequency;              // PWM frequency for motor control (Hz)
   uint32_t usb_mode;                   // USB mode
+  uint32_t can_ans_period_ms;          // Status (ANS) broadcast period (ms, 0 - off)
+  uint32_t can_sens_period_ms;         // Sensor info (SENS_INFO) broadcast period (ms, 0 - off)
+  uint32_t can_pwr_period_ms;          // Power info (PWR_INFO) broadcast period (ms, 0 - off)
+  uint8_t can_tlm_on_change;           // Send on state change and deadband excess
+  uint32_t can_tlm_min_interval_ms;    // Minimum interval of change triggered frames (ms)
+  float can_current_deadband_a;        // Motor current deadband (A, 0 - off)
+  float can_temp_deadband_c;           // Driver temperature deadband (C, 0 - off)
+  uint32_t can_position_deadband;      // Position sensor deadband (ADC counts, 0 - off)
   uint32_t short_vs_det_level;         // Short to VS detector level for lowside FETs (1- highest..15-lowest)
   uint32_t short_gnd_det_level;        // Short to GND detector level for highside FETs (2- highest..15lowest)
   uint32_t short_det_spike_filter;     // Spike filtering bandwidth for short detection (0-100ns..3-3us)
@@ -46,31 +55,44 @@ typedef struct
   uint32_t motor_1_decel_time_ms;      // Deceleration time (ms)
   uint8_t motor_1_algorithm;           // Acceleration/Deceleration algorithm
   float motor_1_max_current_a;         // Maximum current for emergency stop (A)
+  uint32_t motor_1_max_accel;          // Jerk limited profile: maximum acceleration (%/s)
+  uint32_t motor_1_max_decel;          // Jerk limited profile: maximum deceleration (%/s)
+  uint32_t motor_1_jerk;               // Jerk limited profile: jerk (%/s^2)
   uint8_t motor_2_max_pwm_percent;     // Maximum PWM level (percent)
   uint8_t motor_2_direction_invert;    // Direction invert flag
   uint32_t motor_2_accel_time_ms;      // Acceleration time (ms)
   uint32_t motor_2_decel_time_ms;      // Deceleration time (ms)
   uint8_t motor_2_algorithm;           // Acceleration/Deceleration algorithm
   float motor_2_max_current_a;         // Maximum current for emergency stop (A)
+  uint32_t motor_2_max_accel;          // Jerk limited profile: maximum acceleration (%/s)
+  uint32_t motor_2_max_decel;          // Jerk limited profile: maximum deceleration (%/s)
+  uint32_t motor_2_jerk;               // Jerk limited profile: jerk (%/s^2)
   uint8_t motor_3_max_pwm_percent;     // Maximum PWM level (percent)
   uint8_t motor_3_direction_invert;    // Direction invert flag
   uint32_t motor_3_accel_time_ms;      // Acceleration time (ms)
   uint32_t motor_3_decel_time_ms;      // Deceleration time (ms)
   uint8_t motor_3_algorithm;           // Acceleration/Deceleration algorithm
   float motor_3_max_current_a;         // Maximum current for emergency stop (A)
+  uint32_t motor_3_max_accel;          // Jerk limited profile: maximum acceleration (%/s)
+  uint32_t motor_3_max_decel;          // Jerk limited profile: maximum deceleration (%/s)
+  uint32_t motor_3_jerk;               // Jerk limited profile: jerk (%/s^2)
   uint8_t motor_4_max_pwm_percent;     // Maximum PWM level (percent)
   uint8_t motor_4_direction_invert;    // Direction invert flag
   uint32_t motor_4_accel_time_ms;      // Acceleration time (ms)
   uint32_t motor_4_decel_time_ms;      // Deceleration time (ms)
   uint8_t motor_4_algorithm;           // Acceleration/Deceleration algorithm
   float motor_4_max_current_a;         // Maximum current for emergency stop (A)
+  uint32_t motor_4_max_accel;          // Jerk limited profile: maximum acceleration (%/s)
+  uint32_t motor_4_max_decel;          // Jerk limited profile: maximum deceleration (%/s)
+  uint32_t motor_4_jerk;               // Jerk limited profile: jerk (%/s^2)
 } WVAR_TYPE;
 
 // Selector constants
 // accel_decel_alg
-#define ACCEL_DECEL_ALG_INSTANT 0
-#define ACCEL_DECEL_ALG_LINEAR  1
-#define ACCEL_DECEL_ALG_S_CURVE 2
+#define ACCEL_DECEL_ALG_INSTANT      0
+#define ACCEL_DECEL_ALG_LINEAR       1
+#define ACCEL_DECEL_ALG_S_CURVE      2
+#define ACCEL_DECEL_ALG_JERK_LIMITED 3
 
 // binary
 #define BINARY_NO  0
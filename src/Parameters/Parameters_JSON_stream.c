@@ -0,0 +1,1273 @@
+// Streaming JSON writer and SAX-style reader.
+// Neither side builds a document tree: memory use is the fixed size of T_json_wr or T_json_rd
+// and does not depend on the number of parameters.
+#include "App.h"
+
+// Reader states
+#define RD_VALUE          0   // Expecting a value
+#define RD_VALUE_OR_CLOSE 1   // After '[': expecting a value or ']'
+#define RD_KEY            2   // After ',' in an object: expecting a key
+#define RD_KEY_OR_CLOSE   3   // After '{': expecting a key or '}'
+#define RD_COLON          4   // After a key: expecting ':'
+#define RD_NEXT           5   // After a member: expecting ',' or the closing bracket
+#define RD_STRING         6
+#define RD_ESCAPE         7   // After '\' inside a string
+#define RD_UNICODE        8   // Collecting 4 hex digits of \uXXXX
+#define RD_NUMBER         9
+#define RD_LITERAL        10  // true, false, null
+#define RD_DONE           11  // Root value complete, only whitespace allowed
+
+#define RD_STR_IS_KEY     0x80  // Flag in state: the string being read is an object key
+
+static const char g_json_ws[] = "                                ";  // 32 spaces, maximal indentation
+
+static uint32_t _JSON_utf8_decode(const uint8_t *p, uint32_t *cp);
+static void     _JSON_wr_put(T_json_wr *w, const char *data, uint32_t len);
+static void     _JSON_wr_indent(T_json_wr *w, uint32_t depth, uint32_t space);
+static void     _JSON_wr_value_prefix(T_json_wr *w);
+static void     _JSON_wr_escaped(T_json_wr *w, const char *str);
+static void     _JSON_wr_end(T_json_wr *w, const char *bracket);
+static uint32_t _JSON_rd_tok_put(T_json_rd *r, uint32_t c);
+static uint32_t _JSON_rd_tok_put_utf8(T_json_rd *r, uint32_t cp);
+static uint32_t _JSON_rd_utf8_valid(T_json_rd *r);
+static uint32_t _JSON_rd_event(T_json_rd *r, T_json_event ev, const char *tok, uint32_t len);
+static uint32_t _JSON_rd_begin(T_json_rd *r, uint32_t is_object);
+static uint32_t _JSON_rd_end(T_json_rd *r, uint32_t is_object);
+static void     _JSON_rd_value_done(T_json_rd *r);
+static uint32_t _JSON_rd_number_valid(const char *s);
+static uint32_t _JSON_rd_finish_token(T_json_rd *r);
+static uint32_t _JSON_rd_value_start(T_json_rd *r, char c);
+static uint32_t _JSON_rd_char(T_json_rd *r, char c, uint32_t *consumed);
+
+/*-----------------------------------------------------------------------------------------------------
+  Decode one UTF-8 character. Rejects overlong forms, surrogates and code points above 0x10FFFF,
+  as utf8_check_full() of jansson does.
+
+  Parameters:
+    p  - pointer to the first byte, the sequence ends at a zero byte at the latest
+    cp - decoded code point
+
+  Return:
+    Number of bytes in the character, 0 if the sequence is invalid
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_utf8_decode(const uint8_t *p, uint32_t *cp)
+{
+  uint32_t n;
+  uint32_t i;
+  uint32_t v;
+
+  if (p[0] < 0x80)
+  {
+    *cp = p[0];
+    return 1;
+  }
+  if ((p[0] >= 0xC2) && (p[0] <= 0xDF))
+  {
+    n = 2;
+    v = p[0] & 0x1F;
+  }
+  else if ((p[0] >= 0xE0) && (p[0] <= 0xEF))
+  {
+    n = 3;
+    v = p[0] & 0x0F;
+  }
+  else if ((p[0] >= 0xF0) && (p[0] <= 0xF4))
+  {
+    n = 4;
+    v = p[0] & 0x07;
+  }
+  else
+  {
+    return 0;
+  }
+  for (i = 1; i < n; i++)
+  {
+    if ((p[i] & 0xC0) != 0x80)
+    {
+      return 0;
+    }
+    v = (v << 6) | (p[i] & 0x3F);
+  }
+  if ((v > 0x10FFFF) || ((v >= 0xD800) && (v <= 0xDFFF)) || ((n == 3) && (v < 0x800)) || ((n == 4) && (v < 0x10000)))
+  {
+    return 0;
+  }
+  *cp = v;
+  return n;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Initialize the JSON writer
+
+  Parameters:
+    w        - pointer to writer
+    sink     - output function
+    sink_ctx - context passed to the output function
+    flags    - jansson dump flags (JSON_INDENT(n), JSON_COMPACT, JSON_ENSURE_ASCII)
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void JSON_wr_init(T_json_wr *w, T_json_sink sink, void *sink_ctx, size_t flags)
+{
+  memset(w, 0, sizeof(T_json_wr));
+  w->sink     = sink;
+  w->sink_ctx = sink_ctx;
+  w->flags    = flags;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Writer sink writing to an open FileX file
+
+  Parameters:
+    ctx  - pointer to FX_FILE
+    data - data to write
+    len  - data length
+
+  Return:
+    RES_OK on success, RES_ERROR on error
+-----------------------------------------------------------------------------------------------------*/
+uint32_t JSON_wr_sink_file(void *ctx, const char *data, uint32_t len)
+{
+  if (fx_file_write((FX_FILE *)ctx, (void *)data, len) != FX_SUCCESS)
+  {
+    return RES_ERROR;
+  }
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Writer sink writing to a memory buffer. With NULL buffer only counts the bytes.
+
+  Parameters:
+    ctx  - pointer to T_json_mem_sink
+    data - data to write
+    len  - data length
+
+  Return:
+    RES_OK on success, RES_ERROR if the buffer is full
+-----------------------------------------------------------------------------------------------------*/
+uint32_t JSON_wr_sink_mem(void *ctx, const char *data, uint32_t len)
+{
+  T_json_mem_sink *p = (T_json_mem_sink *)ctx;
+
+  if (p->mem != NULL)
+  {
+    if ((p->size - p->used) < len)
+    {
+      return RES_ERROR;
+    }
+    memcpy(&p->mem[p->used], data, len);
+  }
+  p->used += len;
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Copy data to the writer buffer and pass full buffers to the sink
+
+  Parameters:
+    w    - pointer to writer
+    data - data
+    len  - data length
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _JSON_wr_put(T_json_wr *w, const char *data, uint32_t len)
+{
+  uint32_t n;
+
+  if (w->err != 0)
+  {
+    return;
+  }
+  w->total += len;
+  while (len > 0)
+  {
+    n = JSON_WR_BUF_SZ - w->fill;
+    if (n > len)
+    {
+      n = len;
+    }
+    memcpy(&w->buf[w->fill], data, n);
+    w->fill += n;
+    data += n;
+    len -= n;
+    if (w->fill == JSON_WR_BUF_SZ)
+    {
+      if (w->sink(w->sink_ctx, w->buf, w->fill) != RES_OK)
+      {
+        w->err = 1;
+        return;
+      }
+      w->fill = 0;
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Write a line break and indentation, or a single space in the non compact mode without indentation.
+  Same rules as dump_indent() of jansson.
+
+  Parameters:
+    w     - pointer to writer
+    depth - indentation level
+    space - write a space when indentation is off
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _JSON_wr_indent(T_json_wr *w, uint32_t depth, uint32_t space)
+{
+  uint32_t n_spaces = depth * (w->flags & JSON_MAX_INDENT);
+  uint32_t n;
+
+  if ((w->flags & JSON_MAX_INDENT) != 0)
+  {
+    _JSON_wr_put(w, "\n", 1);
+    while (n_spaces > 0)
+    {
+      n = (n_spaces < (sizeof(g_json_ws) - 1)) ? n_spaces : (sizeof(g_json_ws) - 1);
+      _JSON_wr_put(w, g_json_ws, n);
+      n_spaces -= n;
+    }
+  }
+  else if ((space != 0) && ((w->flags & JSON_COMPACT) == 0))
+  {
+    _JSON_wr_put(w, " ", 1);
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Write the separator that precedes a new member of the current container
+
+  Parameters:
+    w - pointer to writer
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _JSON_wr_value_prefix(T_json_wr *w)
+{
+  uint32_t bit;
+
+  if (w->after_key != 0)
+  {
+    w->after_key = 0;
+    return;
+  }
+  if (w->depth == 0)
+  {
+    return;
+  }
+  bit = BIT(w->depth - 1);
+  if ((w->has_items & bit) != 0)
+  {
+    _JSON_wr_put(w, ",", 1);
+    _JSON_wr_indent(w, w->depth, 1);
+  }
+  else
+  {
+    w->has_items |= bit;
+    _JSON_wr_indent(w, w->depth, 0);
+  }
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Write a string in quotes with JSON escaping. Non ASCII characters are written as \uXXXX when
+  JSON_ENSURE_ASCII is set. Invalid UTF-8 sets the writer error, as json_string() refuses it.
+
+  Parameters:
+    w   - pointer to writer
+    str - null terminated UTF-8 string
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _JSON_wr_escaped(T_json_wr *w, const char *str)
+{
+  const uint8_t *p = (const uint8_t *)str;
+  const uint8_t *run;
+  uint32_t       cp;
+  uint32_t       n;
+  char           seq[13];
+  const char    *text;
+  uint32_t       len;
+
+  _JSON_wr_put(w, "\"", 1);
+  run = p;
+  while (*p != 0)
+  {
+    n = _JSON_utf8_decode(p, &cp);
+    if (n == 0)
+    {
+      w->err = 1;
+      return;
+    }
+
+    if ((cp != '\\') && (cp != '"') && (cp >= 0x20) && !(((w->flags & JSON_ESCAPE_SLASH) != 0) && (cp == '/')) && !(((w->flags & JSON_ENSURE_ASCII) != 0) && (cp > 0x7F)))
+    {
+      p += n;
+      continue;
+    }
+
+    // Flush unescaped characters accumulated so far
+    _JSON_wr_put(w, (const char *)run, (uint32_t)(p - run));
+    len = 2;
+    switch (cp)
+    {
+      case '\\':
+        text = "\\\\";
+        break;
+      case '"':
+        text = "\\\"";
+        break;
+      case '\b':
+        text = "\\b";
+        break;
+      case '\f':
+        text = "\\f";
+        break;
+      case '\n':
+        text = "\\n";
+        break;
+      case '\r':
+        text = "\\r";
+        break;
+      case '\t':
+        text = "\\t";
+        break;
+      case '/':
+        text = "\\/";
+        break;
+      default:
+        if (cp < 0x10000)
+        {
+          snprintf(seq, sizeof(seq), "\\u%04X", (unsigned int)cp);
+          len = 6;
+        }
+        else
+        {
+          cp -= 0x10000;
+          snprintf(seq, sizeof(seq), "\\u%04X\\u%04X", (unsigned int)(0xD800 | ((cp & 0xFFC00) >> 10)), (unsigned int)(0xDC00 | (cp & 0x003FF)));
+          len = 12;
+        }
+        text = seq;
+        break;
+    }
+    _JSON_wr_put(w, text, len);
+    p += n;
+    run = p;
+  }
+  _JSON_wr_put(w, (const char *)run, (uint32_t)(p - run));
+  _JSON_wr_put(w, "\"", 1);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Close the current array or object
+
+  Parameters:
+    w       - pointer to writer
+    bracket - closing bracket
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _JSON_wr_end(T_json_wr *w, const char *bracket)
+{
+  if (w->depth == 0)
+  {
+    w->err = 1;
+    return;
+  }
+  if ((w->has_items & BIT(w->depth - 1)) != 0)
+  {
+    _JSON_wr_indent(w, w->depth - 1, 0);
+  }
+  w->depth--;
+  _JSON_wr_put(w, bracket, 1);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Write text as is, without separators. Used to join several root values in one file.
+
+  Parameters:
+    w   - pointer to writer
+    str - null terminated text
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void JSON_wr_raw(T_json_wr *w, const char *str)
+{
+  _JSON_wr_put(w, str, strlen(str));
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Open an array
+
+  Parameters:
+    w - pointer to writer
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void JSON_wr_begin_array(T_json_wr *w)
+{
+  _JSON_wr_value_prefix(w);
+  if (w->depth >= JSON_WR_MAX_DEPTH)
+  {
+    w->err = 1;
+    return;
+  }
+  _JSON_wr_put(w, "[", 1);
+  w->depth++;
+  w->has_items &= ~BIT(w->depth - 1);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Close an array
+
+  Parameters:
+    w - pointer to writer
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void JSON_wr_end_array(T_json_wr *w)
+{
+  _JSON_wr_end(w, "]");
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Open an object
+
+  Parameters:
+    w - pointer to writer
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void JSON_wr_begin_object(T_json_wr *w)
+{
+  _JSON_wr_value_prefix(w);
+  if (w->depth >= JSON_WR_MAX_DEPTH)
+  {
+    w->err = 1;
+    return;
+  }
+  _JSON_wr_put(w, "{", 1);
+  w->depth++;
+  w->has_items &= ~BIT(w->depth - 1);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Close an object
+
+  Parameters:
+    w - pointer to writer
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void JSON_wr_end_object(T_json_wr *w)
+{
+  _JSON_wr_end(w, "}");
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Write the key of an object member. The next written value becomes the member value.
+
+  Parameters:
+    w   - pointer to writer
+    key - member name
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void JSON_wr_key(T_json_wr *w, const char *key)
+{
+  _JSON_wr_value_prefix(w);
+  _JSON_wr_escaped(w, key);
+  if ((w->flags & JSON_COMPACT) != 0)
+  {
+    _JSON_wr_put(w, ":", 1);
+  }
+  else
+  {
+    _JSON_wr_put(w, ": ", 2);
+  }
+  w->after_key = 1;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Write a string value
+
+  Parameters:
+    w   - pointer to writer
+    str - null terminated UTF-8 string
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void JSON_wr_string(T_json_wr *w, const char *str)
+{
+  _JSON_wr_value_prefix(w);
+  _JSON_wr_escaped(w, str);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Write an integer value
+
+  Parameters:
+    w   - pointer to writer
+    val - value
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void JSON_wr_integer(T_json_wr *w, int32_t val)
+{
+  char     str[12];
+  uint32_t len;
+
+  _JSON_wr_value_prefix(w);
+  len = (uint32_t)snprintf(str, sizeof(str), "%d", (int)val);
+  _JSON_wr_put(w, str, len);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Write a real value in the format of jsonp_dtostr() of jansson with default precision
+
+  Parameters:
+    w   - pointer to writer
+    val - value
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void JSON_wr_real(T_json_wr *w, double val)
+{
+  char  str[JSON_WR_REAL_STR_SZ];
+  int   len;
+  char *start;
+  char *end;
+
+  _JSON_wr_value_prefix(w);
+  len = snprintf(str, sizeof(str) - 2, "%.17g", val);
+  if ((len < 0) || (len >= (int)(sizeof(str) - 2)))
+  {
+    w->err = 1;
+    return;
+  }
+
+  // Make sure there is a dot or an exponent, otherwise the value is read back as an integer
+  if ((strchr(str, '.') == NULL) && (strchr(str, 'e') == NULL))
+  {
+    str[len++] = '.';
+    str[len++] = '0';
+    str[len]   = 0;
+  }
+
+  // Remove '+' and leading zeros from the exponent
+  start = strchr(str, 'e');
+  if (start != NULL)
+  {
+    start++;
+    end = start + 1;
+    if (*start == '-')
+    {
+      start++;
+    }
+    while (*end == '0')
+    {
+      end++;
+    }
+    if (end != start)
+    {
+      memmove(start, end, (size_t)len - (size_t)(end - str) + 1);
+      len -= (int)(end - start);
+    }
+  }
+  _JSON_wr_put(w, str, (uint32_t)len);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Pass the remaining buffered output to the sink
+
+  Parameters:
+    w - pointer to writer
+
+  Return:
+    RES_OK if all output was written, RES_ERROR if any write failed
+-----------------------------------------------------------------------------------------------------*/
+uint32_t JSON_wr_flush(T_json_wr *w)
+{
+  if ((w->err == 0) && (w->fill > 0))
+  {
+    if (w->sink(w->sink_ctx, w->buf, w->fill) != RES_OK)
+    {
+      w->err = 1;
+    }
+    w->fill = 0;
+  }
+  return (w->err == 0) ? RES_OK : RES_ERROR;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Initialize the JSON reader
+
+  Parameters:
+    r       - pointer to reader
+    cbl     - event callback
+    cbl_ctx - context passed to the callback
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void JSON_rd_init(T_json_rd *r, T_json_event_cbl cbl, void *cbl_ctx)
+{
+  memset(r, 0, sizeof(T_json_rd));
+  r->cbl     = cbl;
+  r->cbl_ctx = cbl_ctx;
+  r->state   = RD_VALUE;
+  r->line    = 1;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Append a byte to the current token
+
+  Parameters:
+    r - pointer to reader
+    c - byte
+
+  Return:
+    RES_OK or RES_ERROR if the token is too long
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_rd_tok_put(T_json_rd *r, uint32_t c)
+{
+  if (r->tok_len >= (JSON_RD_TOKEN_SZ - 1))
+  {
+    r->err = JSON_RD_ERR_TOKEN;
+    return RES_ERROR;
+  }
+  r->tok[r->tok_len++] = (char)c;
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Append a code point to the current token in UTF-8 encoding
+
+  Parameters:
+    r  - pointer to reader
+    cp - Unicode code point
+
+  Return:
+    RES_OK or RES_ERROR if the token is too long
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_rd_tok_put_utf8(T_json_rd *r, uint32_t cp)
+{
+  uint32_t res;
+
+  if (cp < 0x80)
+  {
+    return _JSON_rd_tok_put(r, cp);
+  }
+  if (cp < 0x800)
+  {
+    res = _JSON_rd_tok_put(r, 0xC0 | (cp >> 6));
+  }
+  else
+  {
+    if (cp < 0x10000)
+    {
+      res = _JSON_rd_tok_put(r, 0xE0 | (cp >> 12));
+    }
+    else
+    {
+      res = _JSON_rd_tok_put(r, 0xF0 | (cp >> 18));
+      res |= _JSON_rd_tok_put(r, 0x80 | ((cp >> 12) & 0x3F));
+    }
+    res |= _JSON_rd_tok_put(r, 0x80 | ((cp >> 6) & 0x3F));
+  }
+  res |= _JSON_rd_tok_put(r, 0x80 | (cp & 0x3F));
+  return res;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Check that the completed string token is valid UTF-8
+
+  Parameters:
+    r - pointer to reader
+
+  Return:
+    1 if valid, 0 otherwise
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_rd_utf8_valid(T_json_rd *r)
+{
+  const uint8_t *p   = (const uint8_t *)r->tok;
+  const uint8_t *end = p + r->tok_len;
+  uint32_t       cp;
+  uint32_t       n;
+
+  while (p < end)
+  {
+    n = _JSON_utf8_decode(p, &cp);
+    if (n == 0)
+    {
+      return 0;
+    }
+    p += n;
+  }
+  return 1;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Pass an event to the callback
+
+  Parameters:
+    r   - pointer to reader
+    ev  - event
+    tok - token text or NULL
+    len - token length
+
+  Return:
+    RES_OK or RES_ERROR if the callback stopped the parsing
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_rd_event(T_json_rd *r, T_json_event ev, const char *tok, uint32_t len)
+{
+  if (r->cbl(r->cbl_ctx, ev, r->depth, tok, len) != RES_OK)
+  {
+    r->err = JSON_RD_ERR_ABORTED;
+    return RES_ERROR;
+  }
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Open an array or an object
+
+  Parameters:
+    r         - pointer to reader
+    is_object - 1 for object, 0 for array
+
+  Return:
+    RES_OK or RES_ERROR
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_rd_begin(T_json_rd *r, uint32_t is_object)
+{
+  if (r->depth >= JSON_RD_MAX_DEPTH)
+  {
+    r->err = JSON_RD_ERR_DEPTH;
+    return RES_ERROR;
+  }
+  if (_JSON_rd_event(r, is_object ? JSON_EV_BEGIN_OBJECT : JSON_EV_BEGIN_ARRAY, NULL, 0) != RES_OK)
+  {
+    return RES_ERROR;
+  }
+  r->depth++;
+  if (is_object)
+  {
+    r->obj_stack |= BIT(r->depth - 1);
+    r->state = RD_KEY_OR_CLOSE;
+  }
+  else
+  {
+    r->obj_stack &= ~BIT(r->depth - 1);
+    r->state = RD_VALUE_OR_CLOSE;
+  }
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Close an array or an object
+
+  Parameters:
+    r         - pointer to reader
+    is_object - 1 for '}', 0 for ']'
+
+  Return:
+    RES_OK or RES_ERROR if the bracket does not match
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_rd_end(T_json_rd *r, uint32_t is_object)
+{
+  if ((r->depth == 0) || (((r->obj_stack & BIT(r->depth - 1)) != 0) != (is_object != 0)))
+  {
+    r->err = JSON_RD_ERR_SYNTAX;
+    return RES_ERROR;
+  }
+  r->depth--;
+  if (_JSON_rd_event(r, is_object ? JSON_EV_END_OBJECT : JSON_EV_END_ARRAY, NULL, 0) != RES_OK)
+  {
+    return RES_ERROR;
+  }
+  _JSON_rd_value_done(r);
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Switch state after a complete value
+
+  Parameters:
+    r - pointer to reader
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _JSON_rd_value_done(T_json_rd *r)
+{
+  r->state = (r->depth == 0) ? RD_DONE : RD_NEXT;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Check number syntax: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+
+  Parameters:
+    s - null terminated number text
+
+  Return:
+    1 if valid, 0 otherwise
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_rd_number_valid(const char *s)
+{
+  if (*s == '-')
+  {
+    s++;
+  }
+  if (*s == '0')
+  {
+    s++;
+  }
+  else if (isdigit((uint8_t)*s))
+  {
+    while (isdigit((uint8_t)*s)) s++;
+  }
+  else
+  {
+    return 0;
+  }
+  if (*s == '.')
+  {
+    s++;
+    if (!isdigit((uint8_t)*s)) return 0;
+    while (isdigit((uint8_t)*s)) s++;
+  }
+  if ((*s == 'e') || (*s == 'E'))
+  {
+    s++;
+    if ((*s == '+') || (*s == '-')) s++;
+    if (!isdigit((uint8_t)*s)) return 0;
+    while (isdigit((uint8_t)*s)) s++;
+  }
+  return (*s == 0) ? 1 : 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Complete a number or a literal token and report it
+
+  Parameters:
+    r - pointer to reader
+
+  Return:
+    RES_OK or RES_ERROR
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_rd_finish_token(T_json_rd *r)
+{
+  T_json_event ev;
+
+  r->tok[r->tok_len] = 0;
+  if (r->state == RD_NUMBER)
+  {
+    if (_JSON_rd_number_valid(r->tok) == 0)
+    {
+      r->err = JSON_RD_ERR_SYNTAX;
+      return RES_ERROR;
+    }
+    if (_JSON_rd_event(r, JSON_EV_NUMBER, r->tok, r->tok_len) != RES_OK)
+    {
+      return RES_ERROR;
+    }
+  }
+  else
+  {
+    if (strcmp(r->tok, "true") == 0)
+    {
+      ev = JSON_EV_TRUE;
+    }
+    else if (strcmp(r->tok, "false") == 0)
+    {
+      ev = JSON_EV_FALSE;
+    }
+    else if (strcmp(r->tok, "null") == 0)
+    {
+      ev = JSON_EV_NULL;
+    }
+    else
+    {
+      r->err = JSON_RD_ERR_SYNTAX;
+      return RES_ERROR;
+    }
+    if (_JSON_rd_event(r, ev, NULL, 0) != RES_OK)
+    {
+      return RES_ERROR;
+    }
+  }
+  _JSON_rd_value_done(r);
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Start a value with its first character
+
+  Parameters:
+    r - pointer to reader
+    c - first character
+
+  Return:
+    RES_OK or RES_ERROR
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_rd_value_start(T_json_rd *r, char c)
+{
+  r->tok_len = 0;
+  if (c == '{')
+  {
+    return _JSON_rd_begin(r, 1);
+  }
+  if (c == '[')
+  {
+    return _JSON_rd_begin(r, 0);
+  }
+  if (c == '"')
+  {
+    r->state = RD_STRING;
+    return RES_OK;
+  }
+  if ((c == '-') || isdigit((uint8_t)c))
+  {
+    r->state = RD_NUMBER;
+    return _JSON_rd_tok_put(r, (uint8_t)c);
+  }
+  if ((c >= 'a') && (c <= 'z'))
+  {
+    r->state = RD_LITERAL;
+    return _JSON_rd_tok_put(r, (uint8_t)c);
+  }
+  r->err = JSON_RD_ERR_SYNTAX;
+  return RES_ERROR;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Process one input character
+
+  Parameters:
+    r        - pointer to reader
+    c        - character
+    consumed - set to 0 if the character ends a number or a literal and must be processed again
+
+  Return:
+    RES_OK or RES_ERROR
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_rd_char(T_json_rd *r, char c, uint32_t *consumed)
+{
+  uint32_t state  = r->state & ~RD_STR_IS_KEY;
+  uint32_t is_key = r->state & RD_STR_IS_KEY;
+  uint32_t cp;
+
+  *consumed = 1;
+  switch (state)
+  {
+    case RD_STRING:
+      if ((r->high_surrogate != 0) && (c != '\\'))
+      {
+        r->err = JSON_RD_ERR_ESCAPE;
+        return RES_ERROR;
+      }
+      if (c == '"')
+      {
+        r->tok[r->tok_len] = 0;
+        if (_JSON_rd_utf8_valid(r) == 0)
+        {
+          r->err = JSON_RD_ERR_UTF8;
+          return RES_ERROR;
+        }
+        if (_JSON_rd_event(r, is_key ? JSON_EV_KEY : JSON_EV_STRING, r->tok, r->tok_len) != RES_OK)
+        {
+          return RES_ERROR;
+        }
+        if (is_key)
+        {
+          r->state = RD_COLON;
+        }
+        else
+        {
+          _JSON_rd_value_done(r);
+        }
+        return RES_OK;
+      }
+      if (c == '\\')
+      {
+        r->state = RD_ESCAPE | is_key;
+        return RES_OK;
+      }
+      if ((uint8_t)c < 0x20)
+      {
+        r->err = JSON_RD_ERR_SYNTAX;
+        return RES_ERROR;
+      }
+      return _JSON_rd_tok_put(r, (uint8_t)c);
+
+    case RD_ESCAPE:
+      r->state = RD_STRING | is_key;
+      if ((r->high_surrogate != 0) && (c != 'u'))
+      {
+        r->err = JSON_RD_ERR_ESCAPE;
+        return RES_ERROR;
+      }
+      switch (c)
+      {
+        case '"':
+        case '\\':
+        case '/':
+          return _JSON_rd_tok_put(r, (uint8_t)c);
+        case 'b':
+          return _JSON_rd_tok_put(r, '\b');
+        case 'f':
+          return _JSON_rd_tok_put(r, '\f');
+        case 'n':
+          return _JSON_rd_tok_put(r, '\n');
+        case 'r':
+          return _JSON_rd_tok_put(r, '\r');
+        case 't':
+          return _JSON_rd_tok_put(r, '\t');
+        case 'u':
+          r->state   = RD_UNICODE | is_key;
+          r->hex_cnt = 0;
+          r->hex_val = 0;
+          return RES_OK;
+        default:
+          r->err = JSON_RD_ERR_ESCAPE;
+          return RES_ERROR;
+      }
+
+    case RD_UNICODE:
+      if (!isxdigit((uint8_t)c))
+      {
+        r->err = JSON_RD_ERR_ESCAPE;
+        return RES_ERROR;
+      }
+      r->hex_val = (r->hex_val << 4) | (uint32_t)(isdigit((uint8_t)c) ? (c - '0') : ((toupper((uint8_t)c) - 'A') + 10));
+      if (++r->hex_cnt < 4)
+      {
+        return RES_OK;
+      }
+      r->state = RD_STRING | is_key;
+      cp       = r->hex_val;
+      if (r->high_surrogate != 0)
+      {
+        if ((cp < 0xDC00) || (cp > 0xDFFF))
+        {
+          r->err = JSON_RD_ERR_ESCAPE;
+          return RES_ERROR;
+        }
+        cp                = 0x10000 + ((r->high_surrogate - 0xD800) << 10) + (cp - 0xDC00);
+        r->high_surrogate = 0;
+      }
+      else if ((cp >= 0xD800) && (cp <= 0xDBFF))
+      {
+        r->high_surrogate = cp;
+        return RES_OK;
+      }
+      else if (((cp >= 0xDC00) && (cp <= 0xDFFF)) || (cp == 0))
+      {
+        r->err = JSON_RD_ERR_ESCAPE;
+        return RES_ERROR;
+      }
+      return _JSON_rd_tok_put_utf8(r, cp);
+
+    case RD_NUMBER:
+      if (isdigit((uint8_t)c) || (c == '.') || (c == 'e') || (c == 'E') || (c == '+') || (c == '-'))
+      {
+        return _JSON_rd_tok_put(r, (uint8_t)c);
+      }
+      *consumed = 0;
+      return _JSON_rd_finish_token(r);
+
+    case RD_LITERAL:
+      if ((c >= 'a') && (c <= 'z'))
+      {
+        return _JSON_rd_tok_put(r, (uint8_t)c);
+      }
+      *consumed = 0;
+      return _JSON_rd_finish_token(r);
+
+    default:
+      break;
+  }
+
+  // Structural states: skip whitespace
+  if ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n'))
+  {
+    return RES_OK;
+  }
+
+  switch (state)
+  {
+    case RD_VALUE_OR_CLOSE:
+      if (c == ']')
+      {
+        return _JSON_rd_end(r, 0);
+      }
+      return _JSON_rd_value_start(r, c);
+
+    case RD_VALUE:
+      return _JSON_rd_value_start(r, c);
+
+    case RD_KEY_OR_CLOSE:
+      if (c == '}')
+      {
+        return _JSON_rd_end(r, 1);
+      }
+      // fall through
+    case RD_KEY:
+      if (c != '"')
+      {
+        break;
+      }
+      r->tok_len = 0;
+      r->state   = RD_STRING | RD_STR_IS_KEY;
+      return RES_OK;
+
+    case RD_COLON:
+      if (c != ':')
+      {
+        break;
+      }
+      r->state = RD_VALUE;
+      return RES_OK;
+
+    case RD_NEXT:
+      if (c == ',')
+      {
+        r->state = ((r->obj_stack & BIT(r->depth - 1)) != 0) ? RD_KEY : RD_VALUE;
+        return RES_OK;
+      }
+      if ((c == ']') || (c == '}'))
+      {
+        return _JSON_rd_end(r, (c == '}') ? 1 : 0);
+      }
+      break;
+
+    default:
+      break;
+  }
+  r->err = JSON_RD_ERR_SYNTAX;
+  return RES_ERROR;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Parse the next part of the text. The text can be split at any byte.
+
+  Parameters:
+    r    - pointer to reader
+    data - text
+    len  - text length
+
+  Return:
+    RES_OK or RES_ERROR, the reason is in r->err
+-----------------------------------------------------------------------------------------------------*/
+uint32_t JSON_rd_feed(T_json_rd *r, const char *data, uint32_t len)
+{
+  uint32_t i = 0;
+  uint32_t consumed;
+
+  if (r->err != JSON_RD_ERR_NONE)
+  {
+    return RES_ERROR;
+  }
+  while (i < len)
+  {
+    if (_JSON_rd_char(r, data[i], &consumed) != RES_OK)
+    {
+      if (r->err == JSON_RD_ERR_NONE)
+      {
+        r->err = JSON_RD_ERR_SYNTAX;
+      }
+      return RES_ERROR;
+    }
+    if (consumed != 0)
+    {
+      if (data[i] == '\n')
+      {
+        r->line++;
+      }
+      i++;
+    }
+  }
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Complete parsing at the end of the text
+
+  Parameters:
+    r - pointer to reader
+
+  Return:
+    RES_OK if the text contained one complete root value, RES_ERROR otherwise
+-----------------------------------------------------------------------------------------------------*/
+uint32_t JSON_rd_finish(T_json_rd *r)
+{
+  if (r->err != JSON_RD_ERR_NONE)
+  {
+    return RES_ERROR;
+  }
+  // A root number or literal ends with the text
+  if (((r->state == RD_NUMBER) || (r->state == RD_LITERAL)) && (r->depth == 0))
+  {
+    if (_JSON_rd_finish_token(r) != RES_OK)
+    {
+      return RES_ERROR;
+    }
+  }
+  if (r->state != RD_DONE)
+  {
+    r->err = JSON_RD_ERR_EOF;
+    return RES_ERROR;
+  }
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Get reader error description
+
+  Parameters:
+    err - JSON_RD_ERR_* code
+
+  Return:
+    Error description string
+-----------------------------------------------------------------------------------------------------*/
+const char *JSON_rd_error_str(uint32_t err)
+{
+  switch (err)
+  {
+    case JSON_RD_ERR_NONE:
+      return "no error";
+    case JSON_RD_ERR_SYNTAX:
+      return "unexpected character";
+    case JSON_RD_ERR_TOKEN:
+      return "string or number too long";
+    case JSON_RD_ERR_DEPTH:
+      return "nesting too deep";
+    case JSON_RD_ERR_ESCAPE:
+      return "invalid escape";
+    case JSON_RD_ERR_EOF:
+      return "unexpected end of text";
+    case JSON_RD_ERR_ABORTED:
+      return "rejected by handler";
+    case JSON_RD_ERR_UTF8:
+      return "invalid UTF-8";
+    default:
+      return "unknown error";
+  }
+}
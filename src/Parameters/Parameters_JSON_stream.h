@@ -0,0 +1,105 @@
+#ifndef PARAMETERS_JSON_STREAM_H
+#define PARAMETERS_JSON_STREAM_H
+
+// Streaming JSON writer and SAX-style reader with fixed working buffers.
+// The writer produces the same text as json_dump* of jansson for flags JSON_INDENT(n), JSON_COMPACT and JSON_ENSURE_ASCII,
+// except that object members keep the order in which they were written.
+
+#define JSON_WR_BUF_SZ        256  // Output is passed to the sink in blocks of this size
+#define JSON_WR_MAX_DEPTH     16   // Maximal nesting of arrays and objects
+#define JSON_WR_REAL_STR_SZ   32
+
+#define JSON_RD_TOKEN_SZ      256  // Maximal decoded length of a string or number token including terminating zero
+#define JSON_RD_MAX_DEPTH     16   // Maximal nesting of arrays and objects
+#define JSON_RD_CHUNK_SZ      512  // Size of the block read from a file at once
+
+// Reader errors
+#define JSON_RD_ERR_NONE      0
+#define JSON_RD_ERR_SYNTAX    1  // Unexpected character
+#define JSON_RD_ERR_TOKEN     2  // String or number longer than JSON_RD_TOKEN_SZ
+#define JSON_RD_ERR_DEPTH     3  // Nesting deeper than JSON_RD_MAX_DEPTH
+#define JSON_RD_ERR_ESCAPE    4  // Invalid escape sequence or \u0000
+#define JSON_RD_ERR_EOF       5  // Text ended before the root value was complete
+#define JSON_RD_ERR_ABORTED   6  // Event callback returned error
+#define JSON_RD_ERR_UTF8      7  // String is not valid UTF-8
+
+// Output sink: write len bytes, return RES_OK or RES_ERROR
+typedef uint32_t (*T_json_sink)(void *ctx, const char *data, uint32_t len);
+
+// Memory sink context. With mem == NULL only counts the bytes, this is used to find the required buffer size.
+typedef struct
+{
+  char    *mem;
+  uint32_t size;
+  uint32_t used;
+} T_json_mem_sink;
+
+typedef struct
+{
+  T_json_sink sink;
+  void       *sink_ctx;
+  size_t      flags;        // jansson dump flags
+  uint32_t    depth;        // Number of open arrays and objects
+  uint32_t    has_items;    // Bit n - container at depth n+1 already has members
+  uint32_t    after_key;    // Next value is the value of an object member
+  uint32_t    err;          // Sticky error, set by a failed sink write or a misuse
+  uint32_t    total;        // Number of bytes produced
+  uint32_t    fill;
+  char        buf[JSON_WR_BUF_SZ];
+} T_json_wr;
+
+typedef enum
+{
+  JSON_EV_BEGIN_ARRAY,
+  JSON_EV_END_ARRAY,
+  JSON_EV_BEGIN_OBJECT,
+  JSON_EV_END_OBJECT,
+  JSON_EV_KEY,
+  JSON_EV_STRING,
+  JSON_EV_NUMBER,
+  JSON_EV_TRUE,
+  JSON_EV_FALSE,
+  JSON_EV_NULL,
+} T_json_event;
+
+// Reader event callback. depth is the nesting level of the value: 0 for the root value, 1 for members of the root container.
+// tok is the decoded zero terminated token for JSON_EV_KEY, JSON_EV_STRING and JSON_EV_NUMBER, otherwise NULL.
+// Returning anything except RES_OK stops the parsing.
+typedef uint32_t (*T_json_event_cbl)(void *ctx, T_json_event ev, uint32_t depth, const char *tok, uint32_t len);
+
+typedef struct
+{
+  T_json_event_cbl cbl;
+  void            *cbl_ctx;
+  uint8_t          state;
+  uint8_t          depth;
+  uint8_t          err;
+  uint8_t          hex_cnt;
+  uint32_t         obj_stack;  // Bit n - container at depth n+1 is an object
+  uint32_t         hex_val;
+  uint32_t         high_surrogate;
+  uint32_t         line;       // Current line for error messages, starts from 1
+  uint32_t         tok_len;
+  char             tok[JSON_RD_TOKEN_SZ];
+} T_json_rd;
+
+void        JSON_wr_init(T_json_wr *w, T_json_sink sink, void *sink_ctx, size_t flags);
+uint32_t    JSON_wr_sink_file(void *ctx, const char *data, uint32_t len);
+uint32_t    JSON_wr_sink_mem(void *ctx, const char *data, uint32_t len);
+void        JSON_wr_raw(T_json_wr *w, const char *str);
+void        JSON_wr_begin_array(T_json_wr *w);
+void        JSON_wr_end_array(T_json_wr *w);
+void        JSON_wr_begin_object(T_json_wr *w);
+void        JSON_wr_end_object(T_json_wr *w);
+void        JSON_wr_key(T_json_wr *w, const char *key);
+void        JSON_wr_string(T_json_wr *w, const char *str);
+void        JSON_wr_integer(T_json_wr *w, int32_t val);
+void        JSON_wr_real(T_json_wr *w, double val);
+uint32_t    JSON_wr_flush(T_json_wr *w);
+
+void        JSON_rd_init(T_json_rd *r, T_json_event_cbl cbl, void *cbl_ctx);
+uint32_t    JSON_rd_feed(T_json_rd *r, const char *data, uint32_t len);
+uint32_t    JSON_rd_finish(T_json_rd *r);
+const char *JSON_rd_error_str(uint32_t err);
+
+#endif  // PARAMETERS_JSON_STREAM_H
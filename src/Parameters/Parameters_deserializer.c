@@ -4,8 +4,33 @@
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 #include "App.h"
 
-static uint32_t _JSON_Deser_params(uint8_t ptype, json_t *root);
+// Context of the streaming settings reader. Its size does not depend on the number of parameters.
+typedef struct
+{
+  T_json_rd                       rd;
+  const T_NV_parameters_instance *p_pars;
+  uint32_t                        flags;         // JSON_DESER_* flags
+  uint8_t                         params_key;    // Last key of a root member object was MAIN_PARAMETERS_KEY
+  uint8_t                         in_params;     // Inside the parameters array
+  uint8_t                         params_found;  // Parameters array was found, later ones are ignored as in the tree search
+  uint8_t                         name_ok;       // Parameter name fitted into name buffer
+  uint32_t                        item_indx;     // Index of the current parameter item
+  uint32_t                        field_cnt;     // Number of strings read in the current parameter item
+  uint32_t                        hits_cnt;
+  uint32_t                        loop_err_cnt;  // Counter for conversion errors
+  char                            name[JSON_DESER_NAME_SZ];
+  char                            chunk[JSON_RD_CHUNK_SZ];
+} T_json_deser_ctx;
+
+static uint32_t _JSON_Deser_params(uint8_t ptype, json_t *root, uint32_t flags);
 static uint32_t _JSON_find_array(json_t *root, json_t **object, char const *key_name);
+static uint32_t _JSON_Deser_apply(T_json_deser_ctx *p_ctx, char *var_name, char *val);
+static uint32_t _JSON_Deser_event(void *ctx, T_json_event ev, uint32_t depth, const char *tok, uint32_t len);
+static uint32_t _JSON_Deser_done(T_json_deser_ctx *p_ctx, uint32_t res);
+static uint32_t _JSON_Deser_tree(uint8_t ptype, char *text, uint32_t flags);
+static T_json_deser_ctx *_JSON_Deser_open(uint8_t ptype, uint32_t flags);
+static uint32_t _JSON_Deser_close(T_json_deser_ctx *p_ctx, uint32_t res);
+static uint32_t _JSON_Deser_file_pass(uint8_t ptype, FX_FILE *p_file, uint32_t flags);
 
 /*-----------------------------------------------------------------------------------------------------
   Searches for a JSON array with the specified key name in the root array.
@@ -69,27 +94,27 @@ static uint32_t _JSON_find_array(json_t *root, json_t **object, char const *key_
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Deserializes parameters from a JSON array and updates the settings instance.
+  Deserializes parameters from a JSON document tree and updates the settings instance.
+  Kept as the reference for the streaming reader in Settings_JSON_benchmark.
 
   Parameters:
     ptype - Parameter type (used to select settings instance)
     root  - Pointer to the root JSON array
+    flags - JSON_DESER_* flags
 
   Return:
     RES_OK if all parameters are successfully updated, RES_ERROR otherwise.
     Returns RES_ERROR immediately on structural errors or if any conversion fails.
 -----------------------------------------------------------------------------------------------------*/
-static uint32_t _JSON_Deser_params(uint8_t ptype, json_t *root)
+static uint32_t _JSON_Deser_params(uint8_t ptype, json_t *root, uint32_t flags)
 {
   json_t  *params = 0;
   json_t  *item   = 0;
-  int32_t  indx;
   char    *var_name;
   char    *val;
   uint32_t i;
   uint32_t err;
-  uint32_t hits_cnt                      = 0;
-  uint32_t loop_err_cnt                  = 0;  // Counter for conversion errors within the loop
+  T_json_deser_ctx *p_ctx;
 
   const T_NV_parameters_instance *p_pars = Get_settings_instance(ptype);
   if (p_pars == NULL)
@@ -103,6 +128,14 @@ static uint32_t _JSON_Deser_params(uint8_t ptype, json_t *root)
     return RES_ERROR;  // Error logged in _JSON_find_array
   }
 
+  p_ctx = App_malloc_pending(sizeof(T_json_deser_ctx), 10);
+  if (p_ctx == NULL)
+  {
+    return RES_ERROR;
+  }
+  p_ctx->p_pars = p_pars;
+  p_ctx->flags  = flags;
+
   for (i = 0; i < json_array_size(params); i++)
   {
     item = json_array_get(params, i);
@@ -111,6 +144,7 @@ static uint32_t _JSON_Deser_params(uint8_t ptype, json_t *root)
     if (!json_is_array(item))
     {
       EAPPLOG("Error: Parameter item at index %d is not an array.", i);
+      App_free(p_ctx);
       return RES_ERROR;  // Return immediately on structural error
     }
 
@@ -118,44 +152,198 @@ static uint32_t _JSON_Deser_params(uint8_t ptype, json_t *root)
     if (json_unpack(item, "[ss]", &var_name, &val) != 0)
     {
       EAPPLOG("Error unpacking parameter at index %d. Expected [string, string].", i);
+      App_free(p_ctx);
       return RES_ERROR;  // Return immediately on structural error
     }
 
-    // If structure is valid, proceed with parameter lookup and conversion
-    indx = Find_param_by_name(p_pars, var_name);
-    if (indx >= 0)
+    _JSON_Deser_apply(p_ctx, var_name, val);
+  }
+
+  return _JSON_Deser_done(p_ctx, RES_OK);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Find a parameter by name and convert its value
+
+  Parameters:
+    p_ctx    - reader context
+    var_name - parameter name
+    val      - value string
+
+  Return:
+    RES_OK, or RES_ERROR if the value was not accepted
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_Deser_apply(T_json_deser_ctx *p_ctx, char *var_name, char *val)
+{
+  int32_t indx;
+
+  indx = Find_param_by_name(p_ctx->p_pars, var_name);
+  if (indx < 0)
+  {
+    if ((p_ctx->flags & JSON_DESER_DRY_RUN) == 0)
     {
-      // Attempt conversion
-      if (Convert_str_to_parameter(p_pars, (uint8_t *)val, indx) == RES_OK)
-      {
-        hits_cnt++;
-      }
-      else
-      {
-        EAPPLOG("Error converting parameter '%s' with value '%s'.", var_name, val);  // Log conversion error
-        loop_err_cnt++;
-      }
+      EAPPLOG("Warning: Parameter '%s' not found in settings definition.", var_name);  // Log if parameter name from JSON is not found
     }
-    else
+    return RES_OK;
+  }
+  if ((p_ctx->flags & JSON_DESER_DRY_RUN) != 0)
+  {
+    p_ctx->hits_cnt++;
+    return RES_OK;
+  }
+  if ((p_ctx->flags & JSON_DESER_VALIDATE) != 0)
+  {
+    if (Convert_str_to_value(p_ctx->p_pars, (uint8_t *)val, indx, NULL) == RES_OK)
     {
-      EAPPLOG("Warning: Parameter '%s' not found in settings definition.", var_name);  // Log if parameter name from JSON is not found
+      p_ctx->hits_cnt++;
+      return RES_OK;
     }
   }
+  else if (Convert_str_to_parameter(p_ctx->p_pars, (uint8_t *)val, indx) == RES_OK)
+  {
+    p_ctx->hits_cnt++;
+    return RES_OK;
+  }
+  EAPPLOG("Error converting parameter '%s' with value '%s'.", var_name, val);  // Log conversion error
+  p_ctx->loop_err_cnt++;
+  return RES_ERROR;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Streaming reader event handler. Applies every ["name", "value"] item of the parameters array
+  as soon as its value string is read.
+
+  Expected document: [{"Device": {...}}, {"Parameters": [["name", "value"], ...]}, ...]
+  depth 0 - root array, depth 2 - members of root objects, depth 3 - parameter items, depth 4 - item fields.
+
+  Parameters:
+    ctx   - pointer to T_json_deser_ctx
+    ev    - event
+    depth - nesting level of the value
+    tok   - token text
+    len   - token length
+
+  Return:
+    RES_OK to continue, RES_ERROR on a structural error
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_Deser_event(void *ctx, T_json_event ev, uint32_t depth, const char *tok, uint32_t len)
+{
+  T_json_deser_ctx *p_ctx = (T_json_deser_ctx *)ctx;
 
-  // After processing all items:
-  if (hits_cnt > 0)
+  if (depth == 0)
   {
-    EAPPLOG("Successfully updated %d params.", hits_cnt);
+    if ((ev != JSON_EV_BEGIN_ARRAY) && (ev != JSON_EV_END_ARRAY))
+    {
+      EAPPLOG("JSON decoding error: root is not array.");
+      return RES_ERROR;
+    }
+    return RES_OK;
   }
 
-  // Return error if any conversion errors occurred during the loop
-  if (loop_err_cnt > 0)
+  if (p_ctx->in_params == 0)
   {
-    EAPPLOG("Encountered %d conversion errors during parameter deserialization.", loop_err_cnt);
+    if ((depth == 2) && (ev == JSON_EV_KEY))
+    {
+      p_ctx->params_key = (strcmp(tok, MAIN_PARAMETERS_KEY) == 0) ? 1 : 0;
+    }
+    else if ((depth == 2) && (ev == JSON_EV_BEGIN_ARRAY) && (p_ctx->params_key != 0) && (p_ctx->params_found == 0))
+    {
+      p_ctx->in_params    = 1;
+      p_ctx->params_found = 1;
+      p_ctx->item_indx    = 0;
+    }
+    return RES_OK;
+  }
+
+  if (depth == 2)
+  {
+    // End of the parameters array
+    p_ctx->in_params = 0;
+    return RES_OK;
+  }
+
+  if (depth == 3)
+  {
+    if (ev == JSON_EV_BEGIN_ARRAY)
+    {
+      p_ctx->field_cnt = 0;
+      return RES_OK;
+    }
+    if (ev == JSON_EV_END_ARRAY)
+    {
+      if (p_ctx->field_cnt < 2)
+      {
+        EAPPLOG("Error unpacking parameter at index %d. Expected [string, string].", p_ctx->item_indx);
+        return RES_ERROR;
+      }
+      p_ctx->item_indx++;
+      return RES_OK;
+    }
+    EAPPLOG("Error: Parameter item at index %d is not an array.", p_ctx->item_indx);
     return RES_ERROR;
   }
 
-  return RES_OK;  // Return OK only if no structural or conversion errors occurred
+  if ((depth == 4) && (ev != JSON_EV_END_ARRAY) && (ev != JSON_EV_END_OBJECT))
+  {
+    if (p_ctx->field_cnt < 2)
+    {
+      if (ev != JSON_EV_STRING)
+      {
+        EAPPLOG("Error unpacking parameter at index %d. Expected [string, string].", p_ctx->item_indx);
+        return RES_ERROR;
+      }
+      if (p_ctx->field_cnt == 0)
+      {
+        // Longer names can not match any parameter, they are kept truncated for the warning
+        p_ctx->name_ok = (len < JSON_DESER_NAME_SZ) ? 1 : 0;
+        strncpy(p_ctx->name, tok, JSON_DESER_NAME_SZ - 1);
+        p_ctx->name[JSON_DESER_NAME_SZ - 1] = 0;
+      }
+      else if (p_ctx->name_ok != 0)
+      {
+        _JSON_Deser_apply(p_ctx, p_ctx->name, (char *)tok);
+      }
+      else if ((p_ctx->flags & JSON_DESER_DRY_RUN) == 0)
+      {
+        EAPPLOG("Warning: Parameter '%s' not found in settings definition.", p_ctx->name);
+      }
+    }
+    // Further item fields are ignored, as json_unpack("[ss]") does
+    p_ctx->field_cnt++;
+  }
+  return RES_OK;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Log the result of deserialization and free the reader context
+
+  Parameters:
+    p_ctx - reader context
+    res   - result of parsing
+
+  Return:
+    RES_OK if parsing succeeded without conversion errors, RES_ERROR otherwise
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_Deser_done(T_json_deser_ctx *p_ctx, uint32_t res)
+{
+  if ((p_ctx->flags & (JSON_DESER_DRY_RUN | JSON_DESER_VALIDATE)) == 0)
+  {
+    if (p_ctx->hits_cnt > 0)
+    {
+      EAPPLOG("Successfully updated %d params.", p_ctx->hits_cnt);
+    }
+    // Return error if any conversion errors occurred
+    if (p_ctx->loop_err_cnt > 0)
+    {
+      EAPPLOG("Encountered %d conversion errors during parameter deserialization.", p_ctx->loop_err_cnt);
+    }
+  }
+  if (p_ctx->loop_err_cnt > 0)
+  {
+    res = RES_ERROR;
+  }
+  App_free(p_ctx);
+  return res;
 }
 
 /*-----------------------------------------------------------------------------------------------------
@@ -239,17 +427,17 @@ uint32_t _JSON_Deser_DT(json_t *root)
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Deserializes parameters from storage.
+  Deserializes parameters through the jansson document tree.
 
   Parameters:
     ptype - Parameter type (used to select settings instance)
-    text  - Pointer to the JSON text buffer
+    text  - Pointer to the null terminated JSON text
+    flags - JSON_DESER_* flags
 
   Return:
     RES_OK if deserialization is successful, RES_ERROR otherwise.
-    Logs errors and success messages accordingly.
 -----------------------------------------------------------------------------------------------------*/
-uint32_t JSON_Deser_settings(uint8_t ptype, char *text)
+static uint32_t _JSON_Deser_tree(uint8_t ptype, char *text, uint32_t flags)
 {
   json_t      *root;
   json_error_t error;
@@ -270,18 +458,231 @@ uint32_t JSON_Deser_settings(uint8_t ptype, char *text)
     return RES_ERROR;
   }
 
-  res = _JSON_Deser_params(ptype, root);
+  res = _JSON_Deser_params(ptype, root, flags);
 
   json_decref(root);
+  return res;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Allocate and prepare the streaming reader context
+
+  Parameters:
+    ptype - Parameter type (used to select settings instance)
+    flags - JSON_DESER_* flags
+
+  Return:
+    Pointer to context or NULL
+-----------------------------------------------------------------------------------------------------*/
+static T_json_deser_ctx *_JSON_Deser_open(uint8_t ptype, uint32_t flags)
+{
+  T_json_deser_ctx               *p_ctx;
+  const T_NV_parameters_instance *p_pars = Get_settings_instance(ptype);
+
+  if (p_pars == NULL)
+  {
+    return NULL;
+  }
+  p_ctx = App_malloc_pending(sizeof(T_json_deser_ctx), 10);
+  if (p_ctx == NULL)
+  {
+    EAPPLOG("JSON decoding error: no memory.");
+    return NULL;
+  }
+  p_ctx->p_pars = p_pars;
+  p_ctx->flags  = flags;
+  JSON_rd_init(&p_ctx->rd, _JSON_Deser_event, p_ctx);
+  return p_ctx;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Complete streaming parsing and check that the parameters array was found
+
+  Parameters:
+    p_ctx - reader context
+    res   - result of feeding the text
+
+  Return:
+    RES_OK or RES_ERROR
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_Deser_close(T_json_deser_ctx *p_ctx, uint32_t res)
+{
+  if (res == RES_OK)
+  {
+    res = JSON_rd_finish(&p_ctx->rd);
+  }
+  if ((res != RES_OK) && (p_ctx->rd.err != JSON_RD_ERR_ABORTED))
+  {
+    EAPPLOG("JSON decoding error: on line %d: %s", p_ctx->rd.line, JSON_rd_error_str(p_ctx->rd.err));
+  }
+  if ((res == RES_OK) && (p_ctx->params_found == 0))
+  {
+    EAPPLOG("Error: Key '%s' not found or its value is not a JSON array.", MAIN_PARAMETERS_KEY);
+    res = RES_ERROR;
+  }
+  return _JSON_Deser_done(p_ctx, res);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Deserializes parameters from a text in memory.
+  Unless JSON_DESER_DRY_RUN or JSON_DESER_VALIDATE is set, the whole text is validated first and
+  parameters are changed only if every value is accepted.
+
+  Parameters:
+    ptype - Parameter type (used to select settings instance)
+    text  - Pointer to the JSON text, null terminated if JSON_DESER_TREE is set
+    len   - Text length
+    flags - JSON_DESER_DRY_RUN to only check names without changing parameters,
+            JSON_DESER_VALIDATE to check names and values without changing parameters,
+            JSON_DESER_TREE to parse through the jansson document tree instead of the streaming reader
+
+  Return:
+    RES_OK if deserialization is successful, RES_ERROR otherwise.
+-----------------------------------------------------------------------------------------------------*/
+uint32_t JSON_Deser_settings_ex(uint8_t ptype, char *text, uint32_t len, uint32_t flags)
+{
+  T_json_deser_ctx *p_ctx;
+  uint32_t          res;
+
+  if ((flags & (JSON_DESER_DRY_RUN | JSON_DESER_VALIDATE)) == 0)
+  {
+    if (JSON_Deser_settings_ex(ptype, text, len, flags | JSON_DESER_VALIDATE) != RES_OK)
+    {
+      EAPPLOG("Deserialization failed. Settings rejected, parameters not changed.");
+      return RES_ERROR;
+    }
+  }
 
+  if ((flags & JSON_DESER_TREE) != 0)
+  {
+    res = _JSON_Deser_tree(ptype, text, flags);
+  }
+  else
+  {
+    p_ctx = _JSON_Deser_open(ptype, flags);
+    if (p_ctx == NULL)
+    {
+      return RES_ERROR;
+    }
+    res = _JSON_Deser_close(p_ctx, JSON_rd_feed(&p_ctx->rd, text, len));
+  }
+
+  if ((flags & (JSON_DESER_DRY_RUN | JSON_DESER_VALIDATE)) == 0)
+  {
+    if (res != RES_OK)
+    {
+      EAPPLOG("Deserialization failed.");
+    }
+    else
+    {
+      EAPPLOG("Deserialization done successfully.");
+    }
+  }
+  return res;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Deserializes parameters from storage.
+
+  Parameters:
+    ptype - Parameter type (used to select settings instance)
+    text  - Pointer to the null terminated JSON text
+
+  Return:
+    RES_OK if deserialization is successful, RES_ERROR otherwise.
+    Logs errors and success messages accordingly.
+-----------------------------------------------------------------------------------------------------*/
+uint32_t JSON_Deser_settings(uint8_t ptype, char *text)
+{
+  return JSON_Deser_settings_ex(ptype, text, strlen(text), 0);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  One pass of the streaming reader over a file from its beginning, reading it in blocks of
+  JSON_RD_CHUNK_SZ bytes
+
+  Parameters:
+    ptype  - Parameter type (used to select settings instance)
+    p_file - file opened for reading
+    flags  - JSON_DESER_* flags
+
+  Return:
+    RES_OK if the pass is successful, RES_ERROR otherwise.
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _JSON_Deser_file_pass(uint8_t ptype, FX_FILE *p_file, uint32_t flags)
+{
+  T_json_deser_ctx *p_ctx;
+  uint32_t          res = RES_OK;
+  ULONG             actual_sz;
+  UINT              status;
+
+  status = fx_file_seek(p_file, 0);
+  if (status != FX_SUCCESS)
+  {
+    EAPPLOG("File seek error %d", status);
+    return RES_ERROR;
+  }
+
+  p_ctx = _JSON_Deser_open(ptype, flags);
+  if (p_ctx == NULL)
+  {
+    return RES_ERROR;
+  }
+
+  while (res == RES_OK)
+  {
+    actual_sz = 0;
+    status    = fx_file_read(p_file, p_ctx->chunk, JSON_RD_CHUNK_SZ, &actual_sz);
+    if ((status == FX_END_OF_FILE) || ((status == FX_SUCCESS) && (actual_sz == 0)))
+    {
+      break;
+    }
+    if (status != FX_SUCCESS)
+    {
+      EAPPLOG("File read error %d", status);
+      res = RES_ERROR;
+      break;
+    }
+    res = JSON_rd_feed(&p_ctx->rd, p_ctx->chunk, actual_sz);
+  }
+
+  return _JSON_Deser_close(p_ctx, res);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Deserializes parameters from an open file. The file is never loaded into memory as a whole.
+  The first pass converts and checks every value without changing parameters, the second pass
+  applies them. A file with any error leaves the parameters unchanged. If the file can not be
+  read again in the second pass, default values are restored so that no mix of old and new
+  parameters remains.
+
+  Parameters:
+    ptype  - Parameter type (used to select settings instance)
+    p_file - file opened for reading
+
+  Return:
+    RES_OK if deserialization is successful, RES_ERROR otherwise.
+-----------------------------------------------------------------------------------------------------*/
+uint32_t JSON_Deser_settings_from_file(uint8_t ptype, FX_FILE *p_file)
+{
+  uint32_t res;
+
+  res = _JSON_Deser_file_pass(ptype, p_file, JSON_DESER_VALIDATE);
   if (res != RES_OK)
   {
-    EAPPLOG("Deserialization failed.");
+    EAPPLOG("Deserialization failed. Settings rejected, parameters not changed.");
+    return RES_ERROR;
+  }
+
+  res = _JSON_Deser_file_pass(ptype, p_file, 0);
+  if (res != RES_OK)
+  {
+    Return_def_params(ptype);
+    EAPPLOG("Deserialization failed. Default parameters restored.");
   }
   else
   {
     EAPPLOG("Deserialization done successfully.");
   }
-
   return res;
 }
@@ -1,6 +1,13 @@
 #ifndef PARAMETERS_DESERIALIZER_H
 #define PARAMETERS_DESERIALIZER_H
 
+#define JSON_DESER_DRY_RUN  BIT(0)  // Only look up parameter names, do not change parameters
+#define JSON_DESER_TREE     BIT(1)  // Parse through the jansson document tree instead of the streaming reader
+#define JSON_DESER_VALIDATE BIT(2)  // Convert and check all values, do not change parameters
+#define JSON_DESER_NAME_SZ  64      // Maximal parameter name length in the streaming reader, including terminating zero
+
 uint32_t    JSON_Deser_settings(uint8_t ptype, char *text);
+uint32_t    JSON_Deser_settings_ex(uint8_t ptype, char *text, uint32_t len, uint32_t flags);
+uint32_t    JSON_Deser_settings_from_file(uint8_t ptype, FX_FILE *p_file);
 
 #endif
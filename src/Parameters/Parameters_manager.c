@@ -3,6 +3,67 @@
 //----------------------------------------------------------------------
 #include "App.h"
 
+/*-----------------------------------------------------------------------------------------------------
+  Mix a 32-bit key with a seed. Must match phf_mix() in ParametersGenerator.
+
+  Parameters:
+    key  - key value
+    seed - seed value
+
+  Return:
+    Mixed 32-bit value
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Param_phf_mix(uint32_t key, uint32_t seed)
+{
+  uint32_t x = key ^ (seed * 0x9E3779B9u);
+
+  x ^= x >> 16;
+  x *= 0x85EBCA6Bu;
+  x ^= x >> 13;
+  x *= 0xC2B2AE35u;
+  x ^= x >> 16;
+  return x;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Calculate the perfect hash key of a parameter name or alias (32-bit FNV-1a).
+  Must match fnv1a32() in ParametersGenerator.
+
+  Parameters:
+    str - null terminated string
+
+  Return:
+    Key value
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Param_phf_str_key(const char *str)
+{
+  uint32_t h = 0x811C9DC5u;
+
+  while (*str != 0)
+  {
+    h ^= (uint8_t)*str++;
+    h *= 0x01000193u;
+  }
+  return h;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Look up a key in a minimal perfect hash index.
+  Every key maps to some slot, so the caller must compare the found parameter with the searched key.
+
+  Parameters:
+    p_phf - pointer to perfect hash index
+    key   - key value
+
+  Return:
+    Parameter index
+-----------------------------------------------------------------------------------------------------*/
+uint16_t Param_phf_lookup(const T_param_phf *p_phf, uint32_t key)
+{
+  uint32_t d = p_phf->displacements[_Param_phf_mix(key, 0) & (p_phf->buckets_num - 1u)];
+  return p_phf->slots[_Param_phf_mix(key, d + 1u) % p_phf->keys_num];
+}
+
 /*-----------------------------------------------------------------------------------------------------
   Find the index of a parameter by its alias.
 
@@ -16,6 +77,17 @@
 int32_t Find_param_by_alias(const T_NV_parameters_instance *p_pars, char *alias)
 {
   int i;
+
+  if (p_pars->alias_index != NULL)
+  {
+    i = Param_phf_lookup(p_pars->alias_index, Param_phf_str_key(alias));
+    if (strcmp((char *)p_pars->items_array[i].var_alias, alias) == 0)
+    {
+      return i;
+    }
+    return -1;
+  }
+
   for (i = 0; i < p_pars->items_num; i++)
   {
     if (strcmp((char *)p_pars->items_array[i].var_alias, alias) == 0)
@@ -39,6 +111,17 @@ int32_t Find_param_by_alias(const T_NV_parameters_instance *p_pars, char *alias)
 int32_t Find_param_by_name(const T_NV_parameters_instance *p_pars, char *name)
 {
   int i;
+
+  if (p_pars->name_index != NULL)
+  {
+    i = Param_phf_lookup(p_pars->name_index, Param_phf_str_key(name));
+    if (strcmp((char *)p_pars->items_array[i].var_name, name) == 0)
+    {
+      return i;
+    }
+    return -1;
+  }
+
   for (i = 0; i < p_pars->items_num; i++)
   {
     if (strcmp((char *)p_pars->items_array[i].var_name, name) == 0)
@@ -107,18 +190,20 @@ const char *Convrt_var_type_to_str(enum vartypes vartype)
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Convert a string to a parameter value.
+  Convert a string to a value of the parameter type with the limits of the parameter.
   The input string must be modifiable.
 
   Parameters:
     p_pars - Pointer to the parameters instance structure
     in_str - Pointer to the input string (modifiable)
     indx   - Index of the parameter in the items array
+    p_dst  - Destination of the value, storage of the parameter type.
+             NULL to only check that the string is accepted without writing anything.
 
   Return:
     RES_OK if conversion is successful, RES_ERROR otherwise.
 -----------------------------------------------------------------------------------------------------*/
-uint32_t Convert_str_to_parameter(const T_NV_parameters_instance *p_pars, uint8_t *in_str, uint16_t indx)
+uint32_t Convert_str_to_value(const T_NV_parameters_instance *p_pars, uint8_t *in_str, uint16_t indx, void *p_dst)
 {
   char         *end;
   float         d_tmp;
@@ -159,7 +244,7 @@ uint32_t Convert_str_to_parameter(const T_NV_parameters_instance *p_pars, uint8_
       }
       else
       {
-        *(uint8_t *)p_pars->items_array[indx].val = (uint8_t)ulg_tmp;
+        if (p_dst != NULL) *(uint8_t *)p_dst = (uint8_t)ulg_tmp;
       }
       break;
     case tint16u:
@@ -178,7 +263,7 @@ uint32_t Convert_str_to_parameter(const T_NV_parameters_instance *p_pars, uint8_
       }
       else
       {
-        *(uint16_t *)p_pars->items_array[indx].val = (uint16_t)ulg_tmp;
+        if (p_dst != NULL) *(uint16_t *)p_dst = (uint16_t)ulg_tmp;
       }
       break;
     case tint32u:
@@ -200,7 +285,7 @@ uint32_t Convert_str_to_parameter(const T_NV_parameters_instance *p_pars, uint8_
       }
       else
       {
-        *(uint32_t *)p_pars->items_array[indx].val = ulg_tmp;
+        if (p_dst != NULL) *(uint32_t *)p_dst = ulg_tmp;
       }
       break;
     case tint32s:
@@ -221,7 +306,7 @@ uint32_t Convert_str_to_parameter(const T_NV_parameters_instance *p_pars, uint8_
       }
       else
       {
-        *(int32_t *)p_pars->items_array[indx].val = slg_tmp;
+        if (p_dst != NULL) *(int32_t *)p_dst = slg_tmp;
       }
       break;
     case tfloat:
@@ -234,7 +319,7 @@ uint32_t Convert_str_to_parameter(const T_NV_parameters_instance *p_pars, uint8_
       {
         if (d_tmp > ((float)p_pars->items_array[indx].maxval)) d_tmp = (float)p_pars->items_array[indx].maxval;
         if (d_tmp < ((float)p_pars->items_array[indx].minval)) d_tmp = (float)p_pars->items_array[indx].minval;
-        *(float *)p_pars->items_array[indx].val = d_tmp;
+        if (p_dst != NULL) *(float *)p_dst = d_tmp;
       }
       break;
     case tstring:
@@ -244,9 +329,12 @@ uint32_t Convert_str_to_parameter(const T_NV_parameters_instance *p_pars, uint8_
       {
         // Truncate if string is too long
       }
-      strncpy((char *)p_pars->items_array[indx].val, (char *)in_str, p_pars->items_array[indx].varlen - 1);
-      st                                       = (uint8_t *)p_pars->items_array[indx].val;
-      st[p_pars->items_array[indx].varlen - 1] = 0;
+      if (p_dst != NULL)
+      {
+        strncpy((char *)p_dst, (char *)in_str, p_pars->items_array[indx].varlen - 1);
+        st                                       = (uint8_t *)p_dst;
+        st[p_pars->items_array[indx].varlen - 1] = 0;
+      }
     }
     break;
     case tarrofbyte:
@@ -260,6 +348,23 @@ uint32_t Convert_str_to_parameter(const T_NV_parameters_instance *p_pars, uint8_
   return res;
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Convert a string to a parameter value.
+  The input string must be modifiable.
+
+  Parameters:
+    p_pars - Pointer to the parameters instance structure
+    in_str - Pointer to the input string (modifiable)
+    indx   - Index of the parameter in the items array
+
+  Return:
+    RES_OK if conversion is successful, RES_ERROR otherwise.
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Convert_str_to_parameter(const T_NV_parameters_instance *p_pars, uint8_t *in_str, uint16_t indx)
+{
+  return Convert_str_to_value(p_pars, in_str, indx, p_pars->items_array[indx].val);
+}
+
 /*-----------------------------------------------------------------------------------------------------
   Convert a parameter value to a string.
 
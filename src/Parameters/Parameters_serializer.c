@@ -3,112 +3,53 @@
 // 18:55:03
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 #include "App.h"
-#include <stdarg.h>
-
-#define JSON_DECREF(x) \
-  {                    \
-    if (x != 0)        \
-    {                  \
-      json_decref(x);  \
-      x = 0;           \
-    }                  \
-  }
 
 // --- JSON error message templates ---
 static const char *ERR_JSON_ALLOC = "json error.";
-static const char *ERR_JSON_INDEX = "json error. Indx %d ";
-
-// --- Macro for typical JSON error handling ---
-#define JSON_ERR_AND_GOTO         \
-  do                              \
-  {                               \
-    APPLOG("%s", ERR_JSON_ALLOC); \
-    goto error;                   \
-  } while (0)
-
-// --- Macro for typical JSON error handling with index ---
-#define JSON_INDEX_ERR_AND_GOTO(i) \
-  do                               \
-  {                                \
-    APPLOG(ERR_JSON_INDEX, (i));   \
-    goto error;                    \
-  } while (0)
-
-typedef enum
-{
-  CLEANUP_TYPE_JSON,
-  CLEANUP_TYPE_STR
-} cleanup_type_t;
-
-/*-----------------------------------------------------------------------------------------------------
-  Universal resource cleanup function for json_t* and char*.
-
-  Parameters:
-    type - resource type (CLEANUP_TYPE_JSON or CLEANUP_TYPE_STR)
-    ...  - pointer addresses for cleanup, terminated by -1
+static const char *ERR_JSON_WRITE = "json write error.";
 
-  Return:
-    void
------------------------------------------------------------------------------------------------------*/
-static inline void cleanup_json_resources(int type, ...)
+// Serializer working memory. Its size does not depend on the number of parameters.
+typedef struct
 {
-  va_list args;
-  void **ptr;
-  va_start(args, type);
-  while (type != -1)
-  {
-    ptr = va_arg(args, void **);
-    if (ptr && *ptr)
-    {
-      if (type == CLEANUP_TYPE_JSON)
-      {
-        json_decref(*((json_t **)ptr));
-      }
-      else if (type == CLEANUP_TYPE_STR)
-      {
-        App_free(*ptr);
-      }
-      *ptr = 0;
-    }
-    type = va_arg(args, int);
-  }
-  va_end(args);
-}
+  T_json_wr       wr;
+  T_json_mem_sink mem;
+  char            str[MAX_PARAMETER_STRING_LEN];
+} T_json_ser_ctx;
+
+static void     _Ser_device_description(T_json_wr *w, char *obj_name);
+static void     _Ser_main_params_schema(const T_NV_parameters_instance *p_pars, T_json_ser_ctx *p_ctx, char *obj_name);
+static void     _Ser_params_vals(const T_NV_parameters_instance *p_pars, T_json_ser_ctx *p_ctx, char *obj_name);
+static void     _Ser_params_tree(const T_NV_parameters_instance *p_pars, T_json_wr *w, char *obj_name);
+static void     _Ser_selectors(const T_NV_parameters_instance *p_pars, T_json_wr *w, char *obj_name);
+static void     _Ser_root_separator(T_json_wr *w, size_t flags, const char *str);
+static void     _Ser_settings(const T_NV_parameters_instance *p_pars, T_json_ser_ctx *p_ctx);
+static void     _Ser_device_state(T_json_ser_ctx *p_ctx);
+static void     _Ser_device_state_adapter(const T_NV_parameters_instance *p_pars, T_json_ser_ctx *p_ctx);
+static uint32_t _Ser_to_mem(const T_NV_parameters_instance *p_pars, void (*ser_func)(const T_NV_parameters_instance *, T_json_ser_ctx *), char **mem, uint32_t *str_size, size_t flags);
 
 /*-----------------------------------------------------------------------------------------------------
-  Serialize device description to JSON object.
+  Write device description object: {"obj_name": {"HW_Ver": ..., "CompDate": ..., "CompTime": ...}}
 
   Parameters:
-    obj      - JSON object to fill
+    w        - JSON writer
     obj_name - key name for the object
 
   Return:
-    RES_OK on success, RES_ERROR on error
+    None, errors are kept in the writer
 -----------------------------------------------------------------------------------------------------*/
-static uint32_t Serialize_device_description_to_obj(json_t *obj, char *obj_name)
+static void _Ser_device_description(T_json_wr *w, char *obj_name)
 {
-  json_t *main_obj = 0;
-  json_t *item_obj = 0;
-  uint32_t res = RES_ERROR;
-
-  item_obj = json_object();
-  if (!item_obj)
-  {
-    JSON_ERR_AND_GOTO;
-  }
-
-  if (json_object_set_new(item_obj, "HW_Ver", json_string((char *)wvar.product_name)) != 0) goto error;
-  if (json_object_set_new(item_obj, "CompDate", json_string(__DATE__)) != 0) goto error;
-  if (json_object_set_new(item_obj, "CompTime", json_string(__TIME__)) != 0) goto error;
-
-  if (json_object_set(obj, obj_name, item_obj) != 0) goto error;
-  json_decref(item_obj);
-  item_obj = 0;
-
-  res = RES_OK;
-error:
-  cleanup_json_resources(CLEANUP_TYPE_JSON, &item_obj, CLEANUP_TYPE_JSON, &main_obj, -1);
-  return res;
+  JSON_wr_begin_object(w);
+  JSON_wr_key(w, obj_name);
+  JSON_wr_begin_object(w);
+  JSON_wr_key(w, "HW_Ver");
+  JSON_wr_string(w, (char *)wvar.product_name);
+  JSON_wr_key(w, "CompDate");
+  JSON_wr_string(w, __DATE__);
+  JSON_wr_key(w, "CompTime");
+  JSON_wr_string(w, __TIME__);
+  JSON_wr_end_object(w);
+  JSON_wr_end_object(w);
 }
 
 /*-----------------------------------------------------------------------------------------------------
@@ -124,463 +65,193 @@ error:
 -----------------------------------------------------------------------------------------------------*/
 uint32_t Serialize_device_description_to_file(FX_FILE *p_file, size_t flags, char *obj_name)
 {
-  json_t *main_obj = 0;
-  json_t *item_obj = 0;
-  uint32_t res = RES_ERROR;
-
-  main_obj = json_object();
-  if (!main_obj)
-  {
-    JSON_ERR_AND_GOTO;
-  }
-
-  if (Serialize_device_description_to_obj(main_obj, obj_name) != RES_OK) goto error;
-
-  if (json_dumpf(main_obj, p_file, flags) != 0) goto error;
-  json_decref(main_obj);
-  main_obj = 0;
-
-  res = RES_OK;
-error:
-  cleanup_json_resources(CLEANUP_TYPE_JSON, &item_obj, CLEANUP_TYPE_JSON, &main_obj, -1);
-  return res;
-}
-
-/*-----------------------------------------------------------------------------------------------------
-  Serialize main parameters schema to JSON object.
-
-  Parameters:
-    p_pars   - pointer to parameters structure
-    obj      - JSON object to fill
-    obj_name - key name for the object
-
-  Return:
-    RES_OK on success, RES_ERROR on error
------------------------------------------------------------------------------------------------------*/
-static uint32_t Serialize_main_params_schema_to_obj(const T_NV_parameters_instance *p_pars, json_t *obj, char *obj_name)
-{
-  int32_t i = 0;
-  const T_NV_parameters *pp;
-  char *str = 0;
-  json_t *main_obj = 0;
-  json_t *jarray = 0;
-  json_t *item_obj = 0;
-  uint32_t res = RES_ERROR;
-
-  str = App_malloc_pending(MAX_PARAMETER_STRING_LEN, 10);
-  if (str == NULL)
-  {
-    JSON_INDEX_ERR_AND_GOTO(i);
-  }
-  jarray = json_array();
-  if (!jarray)
-  {
-    JSON_ERR_AND_GOTO;
-  }
-
-  // Create an array describing the parameters
-
-  for (i = 0; i < p_pars->items_num; i++)
-  {
-    pp = &p_pars->items_array[i];
-    item_obj = json_object();
-    if (json_object_set_new(item_obj, "name", json_string((char const *)pp->var_name)) != 0)
-    {
-      JSON_INDEX_ERR_AND_GOTO(i);
-    }
-    if (json_object_set_new(item_obj, "alias", json_string((char const *)pp->var_alias)) != 0)
-    {
-      JSON_INDEX_ERR_AND_GOTO(i);
-    }
-    if (json_object_set_new(item_obj, "descr", json_string((char const *)pp->var_description)) != 0)
-    {
-      JSON_INDEX_ERR_AND_GOTO(i);
-    }
-
-    Convert_parameter_to_str(p_pars, (uint8_t *)str, MAX_PARAMETER_STRING_LEN, i);
-    if (json_object_set_new(item_obj, "value", json_string(str)) != 0)
-    {
-      JSON_INDEX_ERR_AND_GOTO(i);
-    }
-    if (json_object_set_new(item_obj, "type", json_string(Convrt_var_type_to_str(pp->vartype))) != 0)
-    {
-      JSON_INDEX_ERR_AND_GOTO(i);
-    }
-    if (json_object_set_new(item_obj, "max_len", json_integer(pp->varlen)) != 0)
-    {
-      JSON_INDEX_ERR_AND_GOTO(i);
-    }
-    if (json_object_set_new(item_obj, "max_value", json_real((double)pp->maxval)) != 0)
-    {
-      JSON_INDEX_ERR_AND_GOTO(i);
-    }
-    if (json_object_set_new(item_obj, "min_value", json_real((double)pp->minval)) != 0)
-    {
-      JSON_INDEX_ERR_AND_GOTO(i);
-    }
-    if (json_object_set_new(item_obj, "c_format", json_string(pp->format)) != 0)
-    {
-      JSON_INDEX_ERR_AND_GOTO(i);
-    }
-    if (json_object_set_new(item_obj, "attributes", json_integer(pp->attr)) != 0)
-    {
-      JSON_INDEX_ERR_AND_GOTO(i);
-    }
-    if (json_object_set_new(item_obj, "level", json_integer(pp->parmnlev)) != 0)
-    {
-      JSON_INDEX_ERR_AND_GOTO(i);
-    }
-    if (json_object_set_new(item_obj, "num", json_integer(pp->menu_pos)) != 0)
-    {
-      JSON_INDEX_ERR_AND_GOTO(i);
-    }
-    if (json_object_set_new(item_obj, "selector", json_integer(pp->selector_id)) != 0)
-    {
-      JSON_INDEX_ERR_AND_GOTO(i);
-    }
-
-    if (json_array_insert(jarray, i, item_obj) != 0)
-    {
-      JSON_INDEX_ERR_AND_GOTO(i);
-    }
-    JSON_DECREF(item_obj);
-  }
-  if (json_object_set(obj, obj_name, jarray) != 0)
-  {
-    JSON_INDEX_ERR_AND_GOTO(i);
-  }
-  JSON_DECREF(jarray);
-  res = RES_OK;
-error:
-  cleanup_json_resources(CLEANUP_TYPE_STR, &str, CLEANUP_TYPE_JSON, &item_obj, CLEANUP_TYPE_JSON, &jarray, CLEANUP_TYPE_JSON, &main_obj, -1);
-  return res;
-}
-
-/*-----------------------------------------------------------------------------------------------------
-  Serialize main parameters schema to JSON file.
-
-  Parameters:
-    p_pars   - pointer to parameters structure
-    p_file   - file descriptor
-    flags    - JSON formatting flags
-    obj_name - key name for the object
+  T_json_wr *w;
+  uint32_t   res;
 
-  Return:
-    RES_OK on success, RES_ERROR on error
------------------------------------------------------------------------------------------------------*/
-static uint32_t Serialize_main_params_schema_to_file(const T_NV_parameters_instance *p_pars, FX_FILE *p_file, size_t flags, char *obj_name)
-{
-  char *str = 0;
-  json_t *main_obj = 0;
-  json_t *jarray = 0;
-  json_t *item_obj = 0;
-  uint32_t res = RES_ERROR;
-
-  main_obj = json_object();
-  if (!main_obj)
+  w = App_malloc_pending(sizeof(T_json_wr), 10);
+  if (w == NULL)
   {
-    JSON_ERR_AND_GOTO;
+    APPLOG("%s", ERR_JSON_ALLOC);
+    return RES_ERROR;
   }
-
-  if (Serialize_main_params_schema_to_obj(p_pars, main_obj, obj_name) != RES_OK) goto error;
-  // Write the created object and close it to free dynamic memory
-  if (json_dumpf(main_obj, p_file, flags) != 0) goto error;
-  JSON_DECREF(main_obj);
-
-  res = RES_OK;
-error:
-  cleanup_json_resources(CLEANUP_TYPE_STR, &str, CLEANUP_TYPE_JSON, &item_obj, CLEANUP_TYPE_JSON, &jarray, CLEANUP_TYPE_JSON, &main_obj, -1);
+  JSON_wr_init(w, JSON_wr_sink_file, p_file, flags);
+  _Ser_device_description(w, obj_name);
+  res = JSON_wr_flush(w);
+  App_free(w);
   return res;
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Serialize parameter values to JSON object.
+  Write main parameters schema object: {"obj_name": [{"name": ..., "alias": ..., ...}, ...]}
 
   Parameters:
     p_pars   - pointer to parameters structure
-    obj      - JSON object to fill
+    p_ctx    - serializer context
     obj_name - key name for the object
 
   Return:
-    RES_OK on success, RES_ERROR on error
+    None, errors are kept in the writer
 -----------------------------------------------------------------------------------------------------*/
-static uint32_t Serialize_params_vals_to_obj(const T_NV_parameters_instance *p_pars, json_t *obj, char *obj_name)
+static void _Ser_main_params_schema(const T_NV_parameters_instance *p_pars, T_json_ser_ctx *p_ctx, char *obj_name)
 {
   const T_NV_parameters *pp;
-  char *str = 0;
-  json_t *main_obj = 0;
-  json_t *jarray = 0;
-  json_t *item_obj = 0;
-  uint32_t res = RES_ERROR;
-
-  str = App_malloc_pending(MAX_PARAMETER_STRING_LEN, 0);
-  if (str == NULL)
-  {
-    JSON_ERR_AND_GOTO;
-  }
+  T_json_wr             *w = &p_ctx->wr;
 
-  jarray = json_array();
-  if (!jarray)
-  {
-    JSON_ERR_AND_GOTO;
-  }
-
-  // Create an array describing the parameters
-
-  for (int32_t i = 0; i < p_pars->items_num; i++)
+  JSON_wr_begin_object(w);
+  JSON_wr_key(w, obj_name);
+  JSON_wr_begin_array(w);
+  for (uint32_t i = 0; (i < p_pars->items_num) && (w->err == 0); i++)
   {
     pp = &p_pars->items_array[i];
-    item_obj = json_array();
-    if (json_array_append_new(item_obj, json_string((char const *)pp->var_name)) != 0)
-    {
-      JSON_ERR_AND_GOTO;
-    }
-
-    Convert_parameter_to_str(p_pars, (uint8_t *)str, MAX_PARAMETER_STRING_LEN, i);
-    if (json_array_append_new(item_obj, json_string(str)) != 0)
-    {
-      JSON_ERR_AND_GOTO;
-    }
-
-    if (json_array_insert(jarray, i, item_obj) != 0)
-    {
-      JSON_ERR_AND_GOTO;
-    }
-    JSON_DECREF(item_obj);
+    JSON_wr_begin_object(w);
+    JSON_wr_key(w, "name");
+    JSON_wr_string(w, (char const *)pp->var_name);
+    JSON_wr_key(w, "alias");
+    JSON_wr_string(w, (char const *)pp->var_alias);
+    JSON_wr_key(w, "descr");
+    JSON_wr_string(w, (char const *)pp->var_description);
+    Convert_parameter_to_str(p_pars, (uint8_t *)p_ctx->str, MAX_PARAMETER_STRING_LEN, i);
+    JSON_wr_key(w, "value");
+    JSON_wr_string(w, p_ctx->str);
+    JSON_wr_key(w, "type");
+    JSON_wr_string(w, Convrt_var_type_to_str(pp->vartype));
+    JSON_wr_key(w, "max_len");
+    JSON_wr_integer(w, pp->varlen);
+    JSON_wr_key(w, "max_value");
+    JSON_wr_real(w, (double)pp->maxval);
+    JSON_wr_key(w, "min_value");
+    JSON_wr_real(w, (double)pp->minval);
+    JSON_wr_key(w, "c_format");
+    JSON_wr_string(w, pp->format);
+    JSON_wr_key(w, "attributes");
+    JSON_wr_integer(w, pp->attr);
+    JSON_wr_key(w, "level");
+    JSON_wr_integer(w, pp->parmnlev);
+    JSON_wr_key(w, "num");
+    JSON_wr_integer(w, pp->menu_pos);
+    JSON_wr_key(w, "selector");
+    JSON_wr_integer(w, pp->selector_id);
+    JSON_wr_end_object(w);
   }
-  if (json_object_set(obj, obj_name, jarray) != 0)
-  {
-    JSON_ERR_AND_GOTO;
-  }
-  JSON_DECREF(jarray);
-
-  res = RES_OK;
-error:
-  cleanup_json_resources(CLEANUP_TYPE_STR, &str, CLEANUP_TYPE_JSON, &item_obj, CLEANUP_TYPE_JSON, &jarray, CLEANUP_TYPE_JSON, &main_obj, -1);
-  return res;
+  JSON_wr_end_array(w);
+  JSON_wr_end_object(w);
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Serialize parameter values to JSON file.
+  Write parameter values object: {"obj_name": [["name", "value"], ...]}
 
   Parameters:
     p_pars   - pointer to parameters structure
-    p_file   - file descriptor
-    flags    - JSON formatting flags
+    p_ctx    - serializer context
     obj_name - key name for the object
 
   Return:
-    RES_OK on success, RES_ERROR on error
+    None, errors are kept in the writer
 -----------------------------------------------------------------------------------------------------*/
-static uint32_t Serialize_params_vals_to_file(const T_NV_parameters_instance *p_pars, FX_FILE *p_file, size_t flags, char *obj_name)
+static void _Ser_params_vals(const T_NV_parameters_instance *p_pars, T_json_ser_ctx *p_ctx, char *obj_name)
 {
-  char *str = 0;
-  json_t *main_obj = 0;
-  json_t *jarray = 0;
-  json_t *item_obj = 0;
-  uint32_t res = RES_ERROR;
-
-  main_obj = json_object();
-  if (!main_obj)
-  {
-    JSON_ERR_AND_GOTO;
+  T_json_wr *w = &p_ctx->wr;
+
+  JSON_wr_begin_object(w);
+  JSON_wr_key(w, obj_name);
+  JSON_wr_begin_array(w);
+  for (uint32_t i = 0; (i < p_pars->items_num) && (w->err == 0); i++)
+  {
+    JSON_wr_begin_array(w);
+    JSON_wr_string(w, (char const *)p_pars->items_array[i].var_name);
+    Convert_parameter_to_str(p_pars, (uint8_t *)p_ctx->str, MAX_PARAMETER_STRING_LEN, i);
+    JSON_wr_string(w, p_ctx->str);
+    JSON_wr_end_array(w);
   }
-
-  if (Serialize_params_vals_to_obj(p_pars, main_obj, obj_name) != RES_OK) goto error;
-  // Write the created object and close it to free dynamic memory
-  if (json_dumpf(main_obj, p_file, flags) != 0) goto error;
-  JSON_DECREF(main_obj);
-
-  res = RES_OK;
-error:
-  cleanup_json_resources(CLEANUP_TYPE_STR, &str, CLEANUP_TYPE_JSON, &item_obj, CLEANUP_TYPE_JSON, &jarray, CLEANUP_TYPE_JSON, &main_obj, -1);
-  return res;
+  JSON_wr_end_array(w);
+  JSON_wr_end_object(w);
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Serialize parameter tree to JSON object.
+  Write parameter tree object: {"obj_name": [{"level": ..., "parent": ..., "name": ..., "attributes": ...}, ...]}
 
   Parameters:
     p_pars   - pointer to parameters structure
-    obj      - JSON object to fill
+    w        - JSON writer
     obj_name - key name for the object
 
   Return:
-    RES_OK on success, RES_ERROR on error
+    None, errors are kept in the writer
 -----------------------------------------------------------------------------------------------------*/
-static uint32_t Serialize_params_tree_to_obj(const T_NV_parameters_instance *p_pars, json_t *obj, char *obj_name)
+static void _Ser_params_tree(const T_NV_parameters_instance *p_pars, T_json_wr *w, char *obj_name)
 {
   const T_parmenu *pm;
-  json_t *main_obj = 0;
-  json_t *jarray = 0;
-  json_t *item_obj = 0;
-  uint32_t res = RES_ERROR;
-
-  jarray = json_array();
-  if (!jarray)
-  {
-    JSON_ERR_AND_GOTO;
-  }
-
-  // Create an array describing the parameter tree
 
-  for (int32_t i = 0; i < p_pars->menu_items_num; i++)
+  JSON_wr_begin_object(w);
+  JSON_wr_key(w, obj_name);
+  JSON_wr_begin_array(w);
+  for (uint32_t i = 0; (i < p_pars->menu_items_num) && (w->err == 0); i++)
   {
     pm = &p_pars->menu_items_array[i];
-    item_obj = json_object();
-    if (json_object_set_new(item_obj, "level", json_integer(pm->currlev)) != 0)
-    {
-      JSON_ERR_AND_GOTO;
-    }
-    if (json_object_set_new(item_obj, "parent", json_integer(pm->prevlev)) != 0)
-    {
-      JSON_ERR_AND_GOTO;
-    }
-    if (json_object_set_new(item_obj, "name", json_string(pm->name)) != 0)
-    {
-      JSON_ERR_AND_GOTO;
-    }
-    if (json_object_set_new(item_obj, "attributes", json_integer(pm->visible)) != 0)
-    {
-      JSON_ERR_AND_GOTO;
-    }
-
-    if (json_array_insert(jarray, i, item_obj) != 0)
-    {
-      JSON_ERR_AND_GOTO;
-    }
-    JSON_DECREF(item_obj);
-  }
-  if (json_object_set(obj, obj_name, jarray) != 0)
-  {
-    JSON_ERR_AND_GOTO;
-  }
-  JSON_DECREF(jarray);
-
-  res = RES_OK;
-error:
-  cleanup_json_resources(CLEANUP_TYPE_JSON, &item_obj, CLEANUP_TYPE_JSON, &jarray, CLEANUP_TYPE_JSON, &main_obj, -1);
-  return res;
-}
-
-/*-----------------------------------------------------------------------------------------------------
-  Serialize parameter tree to JSON file.
-
-  Parameters:
-    p_pars   - pointer to parameters structure
-    p_file   - file descriptor
-    flags    - JSON formatting flags
-    obj_name - key name for the object
-
-  Return:
-    RES_OK on success, RES_ERROR on error
------------------------------------------------------------------------------------------------------*/
-static uint32_t Serialize_params_tree_to_file(const T_NV_parameters_instance *p_pars, FX_FILE *p_file, size_t flags, char *obj_name)
-{
-  json_t *main_obj = 0;
-  json_t *jarray = 0;
-  json_t *item_obj = 0;
-  uint32_t res = RES_ERROR;
-
-  main_obj = json_object();
-  if (!main_obj)
-  {
-    JSON_ERR_AND_GOTO;
+    JSON_wr_begin_object(w);
+    JSON_wr_key(w, "level");
+    JSON_wr_integer(w, pm->currlev);
+    JSON_wr_key(w, "parent");
+    JSON_wr_integer(w, pm->prevlev);
+    JSON_wr_key(w, "name");
+    JSON_wr_string(w, pm->name);
+    JSON_wr_key(w, "attributes");
+    JSON_wr_integer(w, pm->visible);
+    JSON_wr_end_object(w);
   }
-
-  if (Serialize_params_tree_to_obj(p_pars, main_obj, obj_name) != RES_OK) goto error;
-  // Write the created object and close it to free dynamic memory
-  if (json_dumpf(main_obj, p_file, flags) != 0) goto error;
-  JSON_DECREF(main_obj);
-
-  res = RES_OK;
-error:
-  cleanup_json_resources(CLEANUP_TYPE_JSON, &item_obj, CLEANUP_TYPE_JSON, &jarray, CLEANUP_TYPE_JSON, &main_obj, -1);
-  return res;
+  JSON_wr_end_array(w);
+  JSON_wr_end_object(w);
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Serialize parameter selectors to JSON object.
+  Write parameter selectors object: {"obj_name": [{"name": ..., "count": ..., "items": [...], "imgs": ...}, ...]}
 
   Parameters:
     p_pars   - pointer to parameters structure
-    obj      - JSON object to fill
+    w        - JSON writer
     obj_name - key name for the object
 
   Return:
-    RES_OK on success, RES_ERROR on error
+    None, errors are kept in the writer
 -----------------------------------------------------------------------------------------------------*/
-static uint32_t Serialize_selectors_to_obj(const T_NV_parameters_instance *p_pars, json_t *obj, char *obj_name)
+static void _Ser_selectors(const T_NV_parameters_instance *p_pars, T_json_wr *w, char *obj_name)
 {
   const T_selectors_list *sl;
-
-  json_t *main_obj = 0;
-  json_t *jarray = 0;
-  json_t *item_obj1 = 0;
-  json_t *item_obj2 = 0;
-  json_t *jarray_items = 0;
-  uint32_t res = RES_ERROR;
-
-  jarray = json_array();
-  if (!jarray)
-  {
-    JSON_ERR_AND_GOTO;
-  }
-
-  for (int32_t i = 0; i < p_pars->selectors_num; i++)
-  {
-    sl = &p_pars->selectors_array[i];
-    item_obj1 = json_object();
-    if (!item_obj1)
-    {
-      JSON_ERR_AND_GOTO;
-    }
-
-    if (json_object_set_new(item_obj1, "name", json_string((char const *)sl->name)) != 0)
-    {
-      JSON_ERR_AND_GOTO;
-    }
-    int32_t num = sl->items_cnt;
-    if (json_object_set_new(item_obj1, "count", json_integer(num)) != 0)
-    {
-      JSON_ERR_AND_GOTO;
-    }
+  int32_t                 num;
+  int32_t                 first;
+  uint8_t                 all_same;
+
+  JSON_wr_begin_object(w);
+  JSON_wr_key(w, obj_name);
+  JSON_wr_begin_array(w);
+  for (uint32_t i = 0; (i < p_pars->selectors_num) && (w->err == 0); i++)
+  {
+    sl  = &p_pars->selectors_array[i];
+    num = sl->items_cnt;
+    JSON_wr_begin_object(w);
+    JSON_wr_key(w, "name");
+    JSON_wr_string(w, (char const *)sl->name);
+    JSON_wr_key(w, "count");
+    JSON_wr_integer(w, num);
     if (num > 0)
     {
-      // Insert an array of selector item values and names
-      jarray_items = json_array();
-      if (!jarray_items)
-      {
-        JSON_ERR_AND_GOTO;
-      }
-
+      // Array of selector item values and names
+      JSON_wr_key(w, "items");
+      JSON_wr_begin_array(w);
       for (int32_t j = 0; j < num; j++)
       {
-        item_obj2 = json_object();
-        if (!item_obj2)
-        {
-          JSON_ERR_AND_GOTO;
-        }
-
-        if (json_object_set_new(item_obj2, "v", json_integer(sl->items_list[j].val)) != 0)
-        {
-          JSON_ERR_AND_GOTO;
-        }
-        if (json_object_set_new(item_obj2, "n", json_string((char const *)sl->items_list[j].caption)) != 0)
-        {
-          JSON_ERR_AND_GOTO;
-        }
-
-        json_array_insert(jarray_items, j, item_obj2);
-        JSON_DECREF(item_obj2);
+        JSON_wr_begin_object(w);
+        JSON_wr_key(w, "v");
+        JSON_wr_integer(w, sl->items_list[j].val);
+        JSON_wr_key(w, "n");
+        JSON_wr_string(w, (char const *)sl->items_list[j].caption);
+        JSON_wr_end_object(w);
       }
-      json_object_set(item_obj1, "items", jarray_items);
-      JSON_DECREF(jarray_items);
-
-      uint8_t all_same = 1;
+      JSON_wr_end_array(w);
 
       // Check if all image indices are the same
-      int32_t first = sl->items_list[0].img_indx;
+      all_same = 1;
+      first    = sl->items_list[0].img_indx;
       for (int32_t j = 0; j < num; j++)
       {
         if (sl->items_list[j].img_indx != first)
@@ -590,88 +261,48 @@ static uint32_t Serialize_selectors_to_obj(const T_NV_parameters_instance *p_par
         }
       }
 
+      JSON_wr_key(w, "imgs");
       if (all_same == 0)
       {
-        // Insert an array of selector item image indices if there are different indices
-        jarray_items = json_array();
-        if (!jarray_items)
-        {
-          JSON_ERR_AND_GOTO;
-        }
-
+        // Array of image indices if there are different indices
+        JSON_wr_begin_array(w);
         for (int32_t j = 0; j < num; j++)
         {
-          if (json_array_insert_new(jarray_items, j, json_integer(sl->items_list[j].img_indx)) != 0)
-          {
-            JSON_ERR_AND_GOTO;
-          }
+          JSON_wr_integer(w, sl->items_list[j].img_indx);
         }
-        json_object_set(item_obj1, "imgs", jarray_items);
-        JSON_DECREF(jarray_items);
+        JSON_wr_end_array(w);
       }
       else
       {
-        // If all indices are the same, insert only one index object
-        if (json_object_set_new(item_obj1, "imgs", json_integer(first)) != 0)
-        {
-          JSON_ERR_AND_GOTO;
-        }
+        // If all indices are the same, only one index
+        JSON_wr_integer(w, first);
       }
     }
-    if (json_array_insert(jarray, i, item_obj1) != 0)
-    {
-      JSON_ERR_AND_GOTO;
-    }
-    JSON_DECREF(item_obj1);
+    JSON_wr_end_object(w);
   }
-  if (json_object_set(obj, obj_name, jarray) != 0)
-  {
-    JSON_ERR_AND_GOTO;
-  }
-  JSON_DECREF(jarray);
-
-  res = RES_OK;
-error:
-  cleanup_json_resources(CLEANUP_TYPE_JSON, &jarray_items, CLEANUP_TYPE_JSON, &item_obj1, CLEANUP_TYPE_JSON, &item_obj2, CLEANUP_TYPE_JSON, &jarray, CLEANUP_TYPE_JSON, &main_obj, -1);
-  return res;
+  JSON_wr_end_array(w);
+  JSON_wr_end_object(w);
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Serialize parameter selectors to JSON file.
+  Write text between root values of a multi-part file, followed by a line break when indentation is on.
+  Same output as Write_json_str_to_file.
 
   Parameters:
-    p_pars   - pointer to parameters structure
-    p_file   - file descriptor
-    flags    - JSON formatting flags
-    obj_name - key name for the object
+    w     - JSON writer
+    flags - JSON formatting flags
+    str   - text to write
 
   Return:
-    RES_OK on success, RES_ERROR on error
+    None
 -----------------------------------------------------------------------------------------------------*/
-static uint32_t Serialize_selectors_to_file(const T_NV_parameters_instance *p_pars, FX_FILE *p_file, size_t flags, char *obj_name)
+static void _Ser_root_separator(T_json_wr *w, size_t flags, const char *str)
 {
-  json_t *main_obj = 0;
-  json_t *jarray = 0;
-  json_t *item_obj1 = 0;
-  json_t *item_obj2 = 0;
-  json_t *jarray_items = 0;
-  uint32_t res = RES_ERROR;
-
-  main_obj = json_object();
-  if (!main_obj)
+  JSON_wr_raw(w, str);
+  if ((flags & JSON_MAX_INDENT) != 0)
   {
-    JSON_ERR_AND_GOTO;
+    JSON_wr_raw(w, "\n");
   }
-
-  if (Serialize_selectors_to_obj(p_pars, main_obj, obj_name) != RES_OK) goto error;
-  // Write the created object and close it to free dynamic memory
-  if (json_dumpf(main_obj, p_file, flags) != 0) goto error;
-  JSON_DECREF(main_obj);
-
-  res = RES_OK;
-error:
-  cleanup_json_resources(CLEANUP_TYPE_JSON, &jarray_items, CLEANUP_TYPE_JSON, &item_obj1, CLEANUP_TYPE_JSON, &item_obj2, CLEANUP_TYPE_JSON, &jarray, CLEANUP_TYPE_JSON, &main_obj, -1);
-  return res;
 }
 
 /*-----------------------------------------------------------------------------------------------------
@@ -710,43 +341,46 @@ uint32_t Write_json_str_to_file(FX_FILE *p_file, size_t flags, char *str)
 -----------------------------------------------------------------------------------------------------*/
 uint32_t Serialze_settings_schema_to_JSON_file(const T_NV_parameters_instance *p_pars, char *filename, size_t flags)
 {
-  uint32_t res;
-  FX_FILE f;
+  uint32_t        res;
+  FX_FILE         f;
+  T_json_ser_ctx *p_ctx;
+  T_json_wr      *w;
+
+  p_ctx = App_malloc_pending(sizeof(T_json_ser_ctx), 10);
+  if (p_ctx == NULL)
+  {
+    APPLOG("%s", ERR_JSON_ALLOC);
+    return RES_ERROR;
+  }
 
   // Open file for writing
   res = Recreate_file_for_write(&f, (CHAR *)filename);
   if (res != FX_SUCCESS)
   {
     EAPPLOG("Error %d", res);
+    App_free(p_ctx);
     return RES_ERROR;
   }
 
-  do
-  {
-    res = RES_ERROR;
-
-    if (Write_json_str_to_file(&f, flags, "[") != RES_OK) break;
-
-    // Create JSON with an array describing the parameters
-    if (Serialize_device_description_to_file(&f, flags, DEVICE_HEADER_KEY) != RES_OK) break;
-    if (Write_json_str_to_file(&f, flags, ",") != RES_OK) break;
-
-    if (Serialize_main_params_schema_to_file(p_pars, &f, flags, MAIN_PARAMETERS_KEY) != RES_OK) break;
-    if (Write_json_str_to_file(&f, flags, ",") != RES_OK) break;
+  w = &p_ctx->wr;
+  JSON_wr_init(w, JSON_wr_sink_file, &f, flags);
 
-    if (Serialize_params_tree_to_file(p_pars, &f, flags, PARAMETERS_TREE_KEY) != RES_OK) break;
-    if (Write_json_str_to_file(&f, flags, ",") != RES_OK) break;
+  _Ser_root_separator(w, flags, "[");
+  _Ser_device_description(w, DEVICE_HEADER_KEY);
+  _Ser_root_separator(w, flags, ",");
+  _Ser_main_params_schema(p_pars, p_ctx, MAIN_PARAMETERS_KEY);
+  _Ser_root_separator(w, flags, ",");
+  _Ser_params_tree(p_pars, w, PARAMETERS_TREE_KEY);
+  _Ser_root_separator(w, flags, ",");
+  _Ser_selectors(p_pars, w, "Selectors");
+  _Ser_root_separator(w, flags, "]");
 
-    // Create JSON with an array describing the selectors in the parameters
-    if (Serialize_selectors_to_file(p_pars, &f, flags, "Selectors") != RES_OK) break;
-
-    // if (Serialize_din_list(&f, flags, TYPE_RECORDS_LIST, "RECORDS_LIST") != RES_OK) break;
-    if (Write_json_str_to_file(&f, flags, "]") != RES_OK) break;
-
-    res = RES_OK;
-    break;
-
-  } while (0);
+  res = JSON_wr_flush(w);
+  if (res != RES_OK)
+  {
+    APPLOG("%s", ERR_JSON_WRITE);
+  }
+  App_free(p_ctx);
 
   if (fx_file_close(&f) != RES_OK) return RES_ERROR;
 
@@ -754,7 +388,7 @@ uint32_t Serialze_settings_schema_to_JSON_file(const T_NV_parameters_instance *p
 }
 
 /*-----------------------------------------------------------------------------------------------------
-  Save device parameter values to JSON file.
+  Save device parameter values to JSON file as separate root objects joined into an array.
 
   Parameters:
     p_pars   - pointer to parameters structure
@@ -766,38 +400,159 @@ uint32_t Serialze_settings_schema_to_JSON_file(const T_NV_parameters_instance *p
 -----------------------------------------------------------------------------------------------------*/
 uint32_t Serialze_settings_to_JSON_file(const T_NV_parameters_instance *p_pars, char *filename, size_t flags)
 {
-  uint32_t res;
-  FX_FILE f;
+  uint32_t        res;
+  FX_FILE         f;
+  T_json_ser_ctx *p_ctx;
+  T_json_wr      *w;
+
+  p_ctx = App_malloc_pending(sizeof(T_json_ser_ctx), 10);
+  if (p_ctx == NULL)
+  {
+    APPLOG("%s", ERR_JSON_ALLOC);
+    return RES_ERROR;
+  }
 
   // Open file for writing
   res = Recreate_file_for_write(&f, (CHAR *)filename);
   if (res != FX_SUCCESS)
   {
     EAPPLOG("%s", ERR_JSON_ALLOC);
+    App_free(p_ctx);
     return res;
   }
 
-  res = RES_ERROR;
-  Write_json_str_to_file(&f, flags, "[");
+  w = &p_ctx->wr;
+  JSON_wr_init(w, JSON_wr_sink_file, &f, flags);
 
-  do
+  _Ser_root_separator(w, flags, "[");
+  _Ser_device_description(w, DEVICE_HEADER_KEY);
+  _Ser_root_separator(w, flags, ",");
+  _Ser_params_vals(p_pars, p_ctx, MAIN_PARAMETERS_KEY);
+  _Ser_root_separator(w, flags, "]");
+
+  res = JSON_wr_flush(w);
+  if (res != RES_OK)
   {
-    // Create JSON with an array describing the parameters
-    if (Serialize_device_description_to_file(&f, flags, DEVICE_HEADER_KEY) != RES_OK) break;
-    if (Write_json_str_to_file(&f, flags, ",") != RES_OK) break;
+    APPLOG("%s", ERR_JSON_WRITE);
+  }
+  App_free(p_ctx);
 
-    if (Serialize_params_vals_to_file(p_pars, &f, flags, MAIN_PARAMETERS_KEY) != RES_OK) break;
-    if (Write_json_str_to_file(&f, flags, ",") != RES_OK) break;
+  fx_file_close(&f);
+  return res;
+}
 
-    res = RES_OK;
-    break;
+/*-----------------------------------------------------------------------------------------------------
+  Write settings document: [{"Device": {...}}, {"Parameters": [["name", "value"], ...]}]
 
-  } while (0);
+  Parameters:
+    p_pars - pointer to parameters structure
+    p_ctx  - serializer context
 
-  Write_json_str_to_file(&f, flags, "]");
+  Return:
+    None, errors are kept in the writer
+-----------------------------------------------------------------------------------------------------*/
+static void _Ser_settings(const T_NV_parameters_instance *p_pars, T_json_ser_ctx *p_ctx)
+{
+  JSON_wr_begin_array(&p_ctx->wr);
+  _Ser_device_description(&p_ctx->wr, DEVICE_HEADER_KEY);
+  _Ser_params_vals(p_pars, p_ctx, MAIN_PARAMETERS_KEY);
+  JSON_wr_end_array(&p_ctx->wr);
+}
 
-  fx_file_close(&f);
-  return RES_OK;
+/*-----------------------------------------------------------------------------------------------------
+  Write device state document: [{"Device": {...}}, {"UpTime_sec": N}]
+
+  Parameters:
+    p_ctx - serializer context
+
+  Return:
+    None, errors are kept in the writer
+-----------------------------------------------------------------------------------------------------*/
+static void _Ser_device_state(T_json_ser_ctx *p_ctx)
+{
+  T_json_wr *w = &p_ctx->wr;
+
+  JSON_wr_begin_array(w);
+  _Ser_device_description(w, DEVICE_HEADER_KEY);
+  JSON_wr_begin_object(w);
+  JSON_wr_key(w, "UpTime_sec");
+  JSON_wr_integer(w, (int32_t)(_tx_time_get() / TX_TIMER_TICKS_PER_SECOND));
+  JSON_wr_end_object(w);
+  JSON_wr_end_array(w);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Serialize a document into an allocated string of exact size.
+  The first pass only counts the output bytes, the second pass writes them into the allocated memory.
+
+  Parameters:
+    p_pars   - pointer to parameters structure, passed to ser_func
+    ser_func - function writing the document
+    mem      - pointer to pointer for allocated memory with JSON string (the memory must be freed by the caller)
+    str_size - pointer to the size of the resulting string
+    flags    - JSON formatting flags
+
+  Return:
+    RES_OK on success, RES_ERROR on error
+-----------------------------------------------------------------------------------------------------*/
+static uint32_t _Ser_to_mem(const T_NV_parameters_instance *p_pars, void (*ser_func)(const T_NV_parameters_instance *, T_json_ser_ctx *), char **mem, uint32_t *str_size, size_t flags)
+{
+  T_json_ser_ctx *p_ctx;
+  char           *ptr = NULL;
+  uint32_t        size;
+  uint32_t        res = RES_ERROR;
+
+  *mem  = NULL;
+  p_ctx = App_malloc_pending(sizeof(T_json_ser_ctx), 10);
+  if (p_ctx == NULL)
+  {
+    APPLOG("%s", ERR_JSON_ALLOC);
+    return RES_ERROR;
+  }
+
+  // Parameters can change between the passes, then the counting is repeated
+  for (uint32_t attempt = 0; (attempt < 2) && (res != RES_OK); attempt++)
+  {
+    // Calculate required memory size for serialization
+    p_ctx->mem.mem  = NULL;
+    p_ctx->mem.used = 0;
+    JSON_wr_init(&p_ctx->wr, JSON_wr_sink_mem, &p_ctx->mem, flags);
+    ser_func(p_pars, p_ctx);
+    if (JSON_wr_flush(&p_ctx->wr) != RES_OK) break;
+    size = p_ctx->mem.used;
+    if (size == 0) break;
+
+    // Allocate required memory, with space for the terminating zero
+    ptr = App_malloc_pending(size + 1, 10);
+    if (ptr == NULL) break;
+
+    // Serialize
+    p_ctx->mem.mem  = ptr;
+    p_ctx->mem.size = size;
+    p_ctx->mem.used = 0;
+    JSON_wr_init(&p_ctx->wr, JSON_wr_sink_mem, &p_ctx->mem, flags);
+    ser_func(p_pars, p_ctx);
+    if (JSON_wr_flush(&p_ctx->wr) != RES_OK)
+    {
+      App_free(ptr);
+      ptr = NULL;
+      continue;
+    }
+    ptr[p_ctx->mem.used] = 0;
+
+    *str_size = p_ctx->mem.used;
+    *mem      = ptr;
+    ptr       = NULL;
+    res       = RES_OK;
+  }
+
+  if (res != RES_OK)
+  {
+    APPLOG("%s", ERR_JSON_WRITE);
+  }
+  if (ptr != NULL) App_free(ptr);
+  App_free(p_ctx);
+  return res;
 }
 
 /*-----------------------------------------------------------------------------------------------------
@@ -815,57 +570,57 @@ uint32_t Serialze_settings_to_JSON_file(const T_NV_parameters_instance *p_pars,
 -----------------------------------------------------------------------------------------------------*/
 uint32_t Serialze_settings_to_mem(const T_NV_parameters_instance *p_pars, char **mem, uint32_t *str_size, uint32_t flags)
 {
-  char *ptr = NULL;
-  json_t *main_arr = 0;
-  json_t *arr_item = 0;
-  uint32_t res = RES_ERROR;
-  size_t size = 0;
-
-  main_arr = json_array();
-  if (!main_arr)
-  {
-    JSON_ERR_AND_GOTO;
-  }
+  return _Ser_to_mem(p_pars, _Ser_settings, mem, str_size, flags);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Serialize device parameters directly to an open file in the same format as Serialze_settings_to_mem.
 
-  arr_item = json_object();
-  if (!arr_item)
+  Parameters:
+    p_pars - pointer to parameters structure
+    p_file - file descriptor
+    flags  - JSON formatting flags
+
+  Return:
+    RES_OK on success, RES_ERROR on error
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Serialze_settings_to_file(const T_NV_parameters_instance *p_pars, FX_FILE *p_file, uint32_t flags)
+{
+  T_json_ser_ctx *p_ctx;
+  uint32_t        res;
+
+  p_ctx = App_malloc_pending(sizeof(T_json_ser_ctx), 10);
+  if (p_ctx == NULL)
   {
-    JSON_ERR_AND_GOTO;
+    APPLOG("%s", ERR_JSON_ALLOC);
+    return RES_ERROR;
   }
-  if (Serialize_device_description_to_obj(arr_item, DEVICE_HEADER_KEY) != RES_OK) goto error;
-  if (json_array_append(main_arr, arr_item) != 0) goto error;
-  JSON_DECREF(arr_item);
-
-  arr_item = json_object();
-  if (!arr_item)
+  JSON_wr_init(&p_ctx->wr, JSON_wr_sink_file, p_file, flags);
+  _Ser_settings(p_pars, p_ctx);
+  res = JSON_wr_flush(&p_ctx->wr);
+  if (res != RES_OK)
   {
-    JSON_ERR_AND_GOTO;
+    APPLOG("%s", ERR_JSON_WRITE);
   }
-  if (Serialize_params_vals_to_obj(p_pars, arr_item, MAIN_PARAMETERS_KEY) != RES_OK) goto error;
-  if (json_array_append(main_arr, arr_item) != 0) goto error;
-  JSON_DECREF(arr_item);
-
-  // Calculate required memory size for serialization
-  size = json_dumpb(main_arr, NULL, 0, flags);
-  if (size == 0) goto error;
-
-  *mem = NULL;
-  // Allocate required memory
-  ptr = App_malloc_pending(size, 10);
-  if (ptr == NULL) goto error;
-
-  // Serialize
-  size = json_dumpb(main_arr, ptr, size, flags);
-
-  *str_size = size;
-  *mem = ptr;
-  res = RES_OK;
-error:
-  // Do not free ptr here, as it is returned to the caller and must be freed by the caller
-  cleanup_json_resources(CLEANUP_TYPE_JSON, &main_arr, CLEANUP_TYPE_JSON, &arr_item, -1);
+  App_free(p_ctx);
   return res;
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Adapter for _Ser_to_mem, the device state does not depend on parameters
+
+  Parameters:
+    p_pars - not used
+    p_ctx  - serializer context
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Ser_device_state_adapter(const T_NV_parameters_instance *p_pars, T_json_ser_ctx *p_ctx)
+{
+  _Ser_device_state(p_ctx);
+}
+
 /*-----------------------------------------------------------------------------------------------------
   Serialize current device state to memory (JSON string).
 
@@ -878,58 +633,142 @@ error:
 -----------------------------------------------------------------------------------------------------*/
 uint32_t Serialze_device_state_to_mem(char **mem, uint32_t *str_size)
 {
-  char *ptr = NULL;
-  json_t *main_arr = 0;
-  json_t *arr_item = 0;
-  uint32_t flags;
-  uint32_t res = RES_ERROR;
-  size_t size = 0;
-  uint32_t up_time = 0;
-
-  main_arr = json_array();
-  if (!main_arr)
-  {
-    JSON_ERR_AND_GOTO;
-  }
+  return _Ser_to_mem(NULL, _Ser_device_state_adapter, mem, str_size, JSON_ENSURE_ASCII | JSON_COMPACT);
+}
 
-  arr_item = json_object();
-  if (!arr_item)
-  {
-    JSON_ERR_AND_GOTO;
-  }
-  if (Serialize_device_description_to_obj(arr_item, DEVICE_HEADER_KEY) != RES_OK) goto error;
-  if (json_array_append(main_arr, arr_item) != 0) goto error;
-  JSON_DECREF(arr_item);
+/*-----------------------------------------------------------------------------------------------------
+  Build the settings document as a jansson tree and dump it to memory, as the serializer did before
+  the streaming writer. Kept as the reference for Settings_JSON_benchmark and the host test of the
+  streaming serializer, the output of both must be the same.
+
+  Parameters:
+    p_pars   - pointer to parameters structure
+    mem      - pointer to pointer for allocated memory with JSON string (the memory must be freed by the caller)
+    str_size - pointer to the size of the resulting string
+    flags    - JSON formatting flags
+
+  Return:
+    RES_OK on success, RES_ERROR on error
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Settings_JSON_tree_to_mem(const T_NV_parameters_instance *p_pars, char **mem, uint32_t *str_size, uint32_t flags)
+{
+  json_t  *main_arr = json_array();
+  json_t  *dev_obj  = json_object();
+  json_t  *dev      = json_object();
+  json_t  *vals_obj = json_object();
+  json_t  *jarray   = json_array();
+  json_t  *item;
+  char    *str      = App_malloc_pending(MAX_PARAMETER_STRING_LEN, 10);
+  char    *ptr      = NULL;
+  size_t   size     = 0;
+  uint32_t res      = RES_ERROR;
+  uint32_t i;
 
-  arr_item = json_object();
-  if (!arr_item)
+  do
   {
-    JSON_ERR_AND_GOTO;
+    if (!main_arr || !dev_obj || !dev || !vals_obj || !jarray || !str) break;
+    if (json_object_set_new(dev, "HW_Ver", json_string((char *)wvar.product_name)) != 0) break;
+    if (json_object_set_new(dev, "CompDate", json_string(__DATE__)) != 0) break;
+    if (json_object_set_new(dev, "CompTime", json_string(__TIME__)) != 0) break;
+    if (json_object_set(dev_obj, DEVICE_HEADER_KEY, dev) != 0) break;
+    if (json_array_append(main_arr, dev_obj) != 0) break;
+
+    for (i = 0; i < p_pars->items_num; i++)
+    {
+      item = json_array();
+      if (item == NULL) break;
+      if (json_array_append_new(jarray, item) != 0) break;
+      Convert_parameter_to_str(p_pars, (uint8_t *)str, MAX_PARAMETER_STRING_LEN, i);
+      if (json_array_append_new(item, json_string((char const *)p_pars->items_array[i].var_name)) != 0) break;
+      if (json_array_append_new(item, json_string(str)) != 0) break;
+    }
+    if (i < p_pars->items_num) break;
+    if (json_object_set(vals_obj, MAIN_PARAMETERS_KEY, jarray) != 0) break;
+    if (json_array_append(main_arr, vals_obj) != 0) break;
+
+    size = json_dumpb(main_arr, NULL, 0, flags);
+    if (size == 0) break;
+    ptr = App_malloc_pending(size + 1, 10);
+    if (ptr == NULL) break;
+    size      = json_dumpb(main_arr, ptr, size, flags);
+    ptr[size] = 0;
+    *str_size = size;
+    *mem      = ptr;
+    res       = RES_OK;
+  } while (0);
+
+  if (str != NULL) App_free(str);
+  if (jarray != NULL) json_decref(jarray);
+  if (vals_obj != NULL) json_decref(vals_obj);
+  if (dev != NULL) json_decref(dev);
+  if (dev_obj != NULL) json_decref(dev_obj);
+  if (main_arr != NULL) json_decref(main_arr);
+  return res;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Compare the streaming writer and reader with the jansson tree based path on the current settings.
+  Time is measured with the DWT cycle counter, peak heap with the byte pool low-water mark.
+  Allocations of other tasks during the run add to the heap figures.
+  Readers run in dry run mode and do not change parameters.
+
+  Parameters:
+    ptype - Parameter type (used to select settings instance)
+    p_res - results
+
+  Return:
+    RES_OK on success, RES_ERROR on error
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Settings_JSON_benchmark(uint8_t ptype, T_settings_json_bench *p_res)
+{
+  const T_NV_parameters_instance *p_pars = Get_settings_instance(ptype);
+  char                           *text   = NULL;
+  uint32_t                        text_sz;
+  uint32_t                        avail;
+  uint32_t                        t;
+  uint32_t                        res;
+
+  memset(p_res, 0, sizeof(T_settings_json_bench));
+  if (p_pars == NULL) return RES_ERROR;
+
+  // jansson tree writer
+  avail = App_reset_RAM_pool_min_avail();
+  t     = CYCLE_PROFILER_NOW();
+  res   = Settings_JSON_tree_to_mem(p_pars, &text, &text_sz, JSON_COMPACT);
+  p_res->tree_wr_cycles = CYCLE_PROFILER_NOW() - t;
+  p_res->tree_wr_heap   = avail - App_get_RAM_pool_min_avail();
+  if (res != RES_OK) return RES_ERROR;
+  p_res->tree_json_size = text_sz;
+  App_free(text);
+  text = NULL;
+
+  // Streaming writer
+  avail = App_reset_RAM_pool_min_avail();
+  t     = CYCLE_PROFILER_NOW();
+  res   = Serialze_settings_to_mem(p_pars, &text, &text_sz, JSON_COMPACT);
+  p_res->stream_wr_cycles = CYCLE_PROFILER_NOW() - t;
+  p_res->stream_wr_heap   = avail - App_get_RAM_pool_min_avail();
+  if (res != RES_OK) return RES_ERROR;
+  p_res->json_size = text_sz;
+
+  // jansson tree reader
+  avail = App_reset_RAM_pool_min_avail();
+  t     = CYCLE_PROFILER_NOW();
+  res   = JSON_Deser_settings_ex(ptype, text, text_sz, JSON_DESER_DRY_RUN | JSON_DESER_TREE);
+  p_res->tree_rd_cycles = CYCLE_PROFILER_NOW() - t;
+  p_res->tree_rd_heap   = avail - App_get_RAM_pool_min_avail();
+
+  // Streaming reader
+  if (res == RES_OK)
+  {
+    avail = App_reset_RAM_pool_min_avail();
+    t     = CYCLE_PROFILER_NOW();
+    res   = JSON_Deser_settings_ex(ptype, text, text_sz, JSON_DESER_DRY_RUN);
+    p_res->stream_rd_cycles = CYCLE_PROFILER_NOW() - t;
+    p_res->stream_rd_heap   = avail - App_get_RAM_pool_min_avail();
   }
-  up_time = _tx_time_get() / TX_TIMER_TICKS_PER_SECOND;
-  if (json_object_set_new(arr_item, "UpTime_sec", json_integer(up_time)) != 0) goto error;
-  if (json_array_append(main_arr, arr_item) != 0) goto error;
-  JSON_DECREF(arr_item);
-
-  flags = JSON_ENSURE_ASCII | JSON_COMPACT;
-
-  // Calculate required memory size for serialization
-  size = json_dumpb(main_arr, NULL, 0, flags);
-  if (size == 0) goto error;
-
-  // Allocate required memory
-  *mem = NULL;
-  ptr = App_malloc_pending(size, 10);
-  if (ptr == NULL) goto error;
-
-  // Serialize
-  size = json_dumpb(main_arr, ptr, size, flags);
-
-  *str_size = size;
-  *mem = ptr;
-  res = RES_OK;
-error:
-  // Do not free ptr here, as it is returned to the caller and must be freed by the caller
-  cleanup_json_resources(CLEANUP_TYPE_JSON, &main_arr, CLEANUP_TYPE_JSON, &arr_item, -1);
+
+  App_free(text);
+  p_res->done = (res == RES_OK) ? 1 : 0;
   return res;
 }
@@ -1,12 +1,31 @@
 #ifndef PARAMETERS_SERIALIZER_H
 #define PARAMETERS_SERIALIZER_H
 
+// Results of Settings_JSON_benchmark
+typedef struct
+{
+  uint32_t done;              // 1 - all runs completed
+  uint32_t json_size;         // Size of the settings text produced by the streaming writer
+  uint32_t tree_json_size;    // Size of the settings text produced by json_dumpb
+  uint32_t tree_wr_cycles;    // jansson: build tree and dump to memory
+  uint32_t tree_wr_heap;      // Peak heap use in bytes
+  uint32_t stream_wr_cycles;  // Streaming writer to memory
+  uint32_t stream_wr_heap;
+  uint32_t tree_rd_cycles;    // jansson: json_loads and walk the tree
+  uint32_t tree_rd_heap;
+  uint32_t stream_rd_cycles;  // Streaming reader
+  uint32_t stream_rd_heap;
+} T_settings_json_bench;
+
 uint32_t Serialze_settings_schema_to_JSON_file(const T_NV_parameters_instance *p_pars, char *filename, size_t flags);
 uint32_t Serialze_settings_to_JSON_file(const T_NV_parameters_instance *p_pars, char *filename, size_t flags);
 uint32_t Serialze_settings_to_mem(const T_NV_parameters_instance *p_pars, char **mem, uint32_t *str_size, uint32_t flags);
+uint32_t Serialze_settings_to_file(const T_NV_parameters_instance *p_pars, FX_FILE *p_file, uint32_t flags);
 
 uint32_t Write_json_str_to_file(FX_FILE *p_file, size_t flags, char *str);
 uint32_t Serialize_device_description_to_file(FX_FILE *p_file, size_t flags, char *obj_name);
 uint32_t Serialze_device_state_to_mem(char **mem, uint32_t *str_size);
+uint32_t Settings_JSON_tree_to_mem(const T_NV_parameters_instance *p_pars, char **mem, uint32_t *str_size, uint32_t flags);
+uint32_t Settings_JSON_benchmark(uint8_t ptype, T_settings_json_bench *p_res);
 
 #endif
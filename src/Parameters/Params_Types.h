@@ -73,6 +73,17 @@ typedef struct
 } T_selectors_list;
 
 
+// Минимальная совершенная хеш-функция над ключами параметров, генерируется ParametersGenerator
+typedef struct
+{
+  uint16_t           keys_num;       // Количество ключей и слотов
+  uint16_t           buckets_num;    // Количество корзин, степень 2
+  const uint16_t*    displacements;  // Смещение зерна хеша для каждой корзины
+  const uint16_t*    slots;          // Индекс параметра в каждом слоте
+}
+T_param_phf;
+
+
 typedef struct
 {
   uint32_t                  items_num;
@@ -81,6 +92,8 @@ typedef struct
   const T_parmenu          *menu_items_array;
   uint32_t                  selectors_num;
   const T_selectors_list   *selectors_array;
+  const T_param_phf        *name_index;   // Индекс по имени, NULL - линейный поиск
+  const T_param_phf        *alias_index;  // Индекс по псевдониму, NULL - линейный поиск
 }
 T_NV_parameters_instance;
 
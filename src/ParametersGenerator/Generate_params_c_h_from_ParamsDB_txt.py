@@ -3,11 +3,17 @@
 """
 Params_generate.py
 Автоматическая генерация {ProfileName}_Params.h и {ProfileName}_Params.c из ParamsDB.txt
+
+Запуск с ключом --bench выводит сравнение линейного, бинарного и перфект-хеш поиска параметров.
+Запуск с ключом --bench-tables <файл.c> генерирует синтетические таблицы параметров разного размера
+для хост-теста и хост-бенчмарка поиска (host/tests/test_param_lookup.c, host/bench/param_lookup_bench.c)
 """
 import os
+import sys
 import json
 import re
 import csv
+import time
 from io import StringIO
 
 PARAMS_DB_PATH = os.path.join(os.path.dirname(__file__), 'ParamsDB.txt')
@@ -37,6 +43,96 @@ def crc16_ccitt(data):
             crc &= 0xFFFF
     return crc
 
+def fnv1a32(data):
+    """
+    Вычисление 32-битного хеша FNV-1a для строки (ключ имени и псевдонима параметра).
+    Должно совпадать с Param_phf_str_key() в Parameters_manager.c
+
+    Args:
+        data: строка
+
+    Returns:
+        int: значение хеша
+    """
+    if isinstance(data, str):
+        data = data.encode('utf-8')
+
+    h = 0x811C9DC5
+    for byte in data:
+        h ^= byte
+        h = (h * 0x01000193) & 0xFFFFFFFF
+    return h
+
+def phf_mix(key, seed):
+    """
+    Перемешивание 32-битного ключа с зерном. Должно совпадать с _Param_phf_mix() в Parameters_manager.c
+    """
+    x = (key ^ (seed * 0x9E3779B9)) & 0xFFFFFFFF
+    x ^= x >> 16
+    x = (x * 0x85EBCA6B) & 0xFFFFFFFF
+    x ^= x >> 13
+    x = (x * 0xC2B2AE35) & 0xFFFFFFFF
+    x ^= x >> 16
+    return x
+
+PHF_MAX_DISPLACEMENT = 0xFFFE  # Зерно слота хранится как uint16_t (displacement + 1 не должно переполняться)
+
+def build_phf(keys, what):
+    """
+    Построение минимальной совершенной хеш-функции методом "hash and displace".
+    Ключ попадает в корзину phf_mix(key, 0) & (buckets - 1), для каждой корзины подбирается
+    смещение d такое, что слоты phf_mix(key, d + 1) % n всех ключей корзины свободны и различны.
+
+    Args:
+        keys: список пар (ключ uint32, индекс параметра)
+        what: описание ключей для сообщений об ошибках
+
+    Returns:
+        tuple: (buckets_num, displacements, slots) где slots[слот] = индекс параметра
+    """
+    n = len(keys)
+    # Проверка коллизий ключей: такие ключи невозможно разделить никакой хеш-функцией
+    seen = {}
+    for key, idx in keys:
+        if key in seen:
+            raise SystemExit(f'PHF {what}: key 0x{key:08X} of parameter {idx} collides with parameter {seen[key]}')
+        seen[key] = idx
+
+    buckets_num = 1
+    while buckets_num * 2 < n:
+        buckets_num *= 2
+
+    while True:
+        buckets = [[] for _ in range(buckets_num)]
+        for key, idx in keys:
+            buckets[phf_mix(key, 0) & (buckets_num - 1)].append((key, idx))
+
+        displacements = [0] * buckets_num
+        slots = [None] * n
+        ok = True
+        # Сначала размещаются самые большие корзины, пока свободных слотов много
+        for b in sorted(range(buckets_num), key=lambda i: -len(buckets[i])):
+            if not buckets[b]:
+                continue
+            for d in range(PHF_MAX_DISPLACEMENT):
+                pos = [phf_mix(key, d + 1) % n for key, _ in buckets[b]]
+                if len(set(pos)) == len(pos) and all(slots[p] is None for p in pos):
+                    for p, (_, idx) in zip(pos, buckets[b]):
+                        slots[p] = idx
+                    displacements[b] = d
+                    break
+            else:
+                ok = False
+                break
+        if ok:
+            return buckets_num, displacements, slots
+        buckets_num *= 2
+
+def phf_lookup(buckets_num, displacements, slots, key):
+    """Поиск по построенной хеш-функции, повторяет Param_phf_lookup() в Parameters_manager.c"""
+    d = displacements[phf_mix(key, 0) & (buckets_num - 1)]
+    return slots[phf_mix(key, d + 1) % len(slots)]
+
 # --- Утилиты ---
 def load_params_db():
     with open(PARAMS_DB_PATH, encoding='utf-8') as f:
@@ -352,73 +448,108 @@ def generate_wvar_inst(db):
         f'  {n_parmenu},\n'
         f'  parmenu,\n'
         f'  SELECTORS_NUM,\n'
-        f'  selectors_list\n'
+        f'  selectors_list,\n'
+        f'  &param_name_phf,\n'
+        f'  &param_alias_phf\n'
         '};\n'
     )
 
-def generate_param_hash_table(db):
-    """Генерирует таблицу CRC16 хешей имен параметров для быстрого поиска"""
-    lines = []
+def get_param_phf_keys(db):
+    """
+    Собирает ключи трёх индексов параметров: CRC16 имени, FNV-1a имени и FNV-1a псевдонима.
+    Проверяет уникальность имён, псевдонимов и CRC16 (CRC16 используется как идентификатор в CAN протоколе).
+    """
     devparams = db['DevParams']['rows']
-
-    # Собираем пары (хеш, индекс) для всех параметров
-    hash_entries = []
+    hash_keys  = []
+    name_keys  = []
+    alias_keys = []
+    crc_owner   = {}
+    name_owner  = {}
+    alias_owner = {}
     for i, row in enumerate(devparams):
-        var_name = row[5]  # Variable_name в 6-м столбце (индекс 5)
-        hash_value = crc16_ccitt(var_name)
-        hash_entries.append((hash_value, i, var_name))
+        var_name  = row[5]  # Variable_name в 6-м столбце (индекс 5)
+        var_alias = row[4][:8] if row[4] else ''
+        crc       = crc16_ccitt(var_name)
+        if var_name in name_owner:
+            raise SystemExit(f'Duplicate parameter name {var_name} (parameters {name_owner[var_name]} and {i})')
+        if crc in crc_owner:
+            raise SystemExit(f'CRC16 collision 0x{crc:04X}: {var_name} and {devparams[crc_owner[crc]][5]}. Rename one of the parameters')
+        name_owner[var_name] = i
+        crc_owner[crc]       = i
+        hash_keys.append((crc, i))
+        name_keys.append((fnv1a32(var_name), i))
+        # Find_param_by_alias возвращает первый параметр с данным псевдонимом, повторы в индекс не попадают
+        if var_alias in alias_owner:
+            print(f'Warning: alias "{var_alias}" of {var_name} duplicates parameter {alias_owner[var_alias]}')
+            continue
+        alias_owner[var_alias] = i
+        alias_keys.append((fnv1a32(var_alias), i))
+    return hash_keys, name_keys, alias_keys
 
-    # Сортируем по хешу для использования бинарного поиска
-    hash_entries.sort(key=lambda x: x[0])
+def generate_phf_table(name, keys, what, key_comments):
+    """Генерирует массивы и структуру T_param_phf одного индекса"""
+    buckets_num, displacements, slots = build_phf(keys, what)
 
-    lines.append('// Parameter hash table for fast parameter lookup by CRC16 hash')
-    lines.append('// Table is sorted by hash values for binary search')
-    lines.append('typedef struct')
+    # Проверка построенной функции на всех ключах
+    for key, idx in keys:
+        if phf_lookup(buckets_num, displacements, slots, key) != idx:
+            raise SystemExit(f'PHF {what}: self check failed for parameter {idx}')
+
+    lines = []
+    lines.append(f'static const uint16_t {name}_disp[{buckets_num}] =')
     lines.append('{')
-    lines.append('  uint16_t hash;     // CRC16 hash of parameter name')
-    lines.append('  uint16_t index;    // Index in parameter array')
-    lines.append('} T_param_hash_entry;')
+    for i in range(0, buckets_num, 12):
+        chunk = ', '.join(f'{d:5d}' for d in displacements[i:i + 12])
+        comma = '' if i + 12 >= buckets_num else ','
+        lines.append(f'  {chunk}{comma}')
+    lines.append('};')
     lines.append('')
-
-    lines.append('static const T_param_hash_entry param_hash_table[WVAR_SIZE] =')
+    lines.append(f'static const uint16_t {name}_slots[{len(slots)}] =')
     lines.append('{')
-
-    for i, (hash_value, param_index, var_name) in enumerate(hash_entries):
-        is_last = (i == len(hash_entries) - 1)
-        comma = '' if is_last else ','
-        lines.append(f'  {{0x{hash_value:04X}, {param_index:2d}}}{comma}  // {var_name}')
-
+    for i, idx in enumerate(slots):
+        comma = '' if i == len(slots) - 1 else ','
+        lines.append(f'  {idx:3d}{comma}  // [{i:3d}] {key_comments[idx]}')
     lines.append('};')
     lines.append('')
+    lines.append(f'static const T_param_phf {name} = {{ {len(slots)}, {buckets_num}, {name}_disp, {name}_slots }};')
+    lines.append('')
+    return '\n'.join(lines)
+
+def generate_param_hash_table(db):
+    """Генерирует минимальные совершенные хеш-индексы параметров по CRC16, имени и псевдониму"""
+    lines = []
+    devparams = db['DevParams']['rows']
+    names = [row[5] for row in devparams]
+    hash_keys, name_keys, alias_keys = get_param_phf_keys(db)
+
+    lines.append('// Minimal perfect hash indexes for O(1) parameter lookup by CRC16 hash, name and alias.')
+    lines.append('// Built by the generator with collision checks, looked up with Param_phf_lookup().')
+    lines.append('// Lookup result must be verified against the key because unknown keys also map to some slot.')
+    lines.append(generate_phf_table('param_hash_phf', hash_keys, 'CRC16 hash', names))
+    lines.append(generate_phf_table('param_name_phf', name_keys, 'name', names))
+    lines.append(generate_phf_table('param_alias_phf', alias_keys, 'alias', names))
 
     # Добавляем функцию поиска
-    lines.append('// Binary search function to find parameter index by CRC16 hash')
+    lines.append(generate_find_by_hash('Find_param_by_hash', 'param_hash_phf', 'param_index_to_hash_table'))
+
+    return '\n'.join(lines)
+
+def generate_find_by_hash(func_name, phf_name, table_name, static=False):
+    """Генерирует функцию поиска индекса параметра по CRC16 через хеш-индекс с проверкой по таблице индекс->хеш"""
+    lines = []
+    lines.append('// Find parameter index by CRC16 hash')
     lines.append('// Returns parameter index or 0xFFFF if not found')
-    lines.append('uint16_t Find_param_by_hash(uint16_t hash)')
+    lines.append(f'{"static " if static else ""}uint16_t {func_name}(uint16_t hash)')
     lines.append('{')
-    lines.append('  int left = 0;')
-    lines.append('  int right = WVAR_SIZE - 1;')
+    lines.append(f'  uint16_t index = Param_phf_lookup(&{phf_name}, hash);')
     lines.append('')
-    lines.append('  while (left <= right)')
+    lines.append(f'  if ({table_name}[index] != hash)')
     lines.append('  {')
-    lines.append('    int mid = (left + right) / 2;')
-    lines.append('    if (param_hash_table[mid].hash == hash)')
-    lines.append('    {')
-    lines.append('      return param_hash_table[mid].index;')
-    lines.append('    }')
-    lines.append('    if (param_hash_table[mid].hash < hash)')
-    lines.append('    {')
-    lines.append('      left = mid + 1;')
-    lines.append('    }')
-    lines.append('    else')
-    lines.append('    {')
-    lines.append('      right = mid - 1;')
-    lines.append('    }')
+    lines.append('    return 0xFFFF; // Parameter not found')
     lines.append('  }')
-    lines.append('  return 0xFFFF; // Parameter not found')
+    lines.append('  return index;')
     lines.append('}')
     lines.append('')
-
     return '\n'.join(lines)
 
 def generate_param_index_to_hash_table(db):
@@ -487,10 +618,10 @@ def generate_c(db):
     lines.append('')
     # parmenu
     lines.append(generate_parmenu(db))
-    # Parameter hash table
-    lines.append(generate_param_hash_table(db))
     # Parameter index-to-hash table
     lines.append(generate_param_index_to_hash_table(db))
+    # Parameter perfect hash indexes
+    lines.append(generate_param_hash_table(db))
     # arr_wvar
     lines.append(generate_arr_wvar(db))
     # Селекторы
@@ -687,6 +818,114 @@ def postprocess_arr_wvar_c_file(c_path):
     with open(c_path, 'w', encoding='utf-8') as f:
         f.writelines(lines)
 
+# --- Оценка стоимости поиска ---
+def benchmark_lookup(sizes=(45, 100, 250, 500, 1000, 2000)):
+    """
+    Сравнение стоимости поиска параметра при росте базы: число сравнений строк/ключей
+    для линейного поиска, бинарного поиска и совершенного хеша, время построения хеша
+    и размер таблиц. Используются синтетические имена параметров.
+    """
+    print(f'{"Params":>7} {"Linear strcmp":>14} {"Binary cmp":>11} {"PHF cmp":>8} {"PHF buckets":>12} {"Max disp":>9} {"Tables, B":>10} {"Build, ms":>10}')
+    for n in sizes:
+        names = [f'motor_{i // 16}_param_{i % 16}_value' for i in range(n)]
+        keys = [(fnv1a32(nm), i) for i, nm in enumerate(names)]
+        t0 = time.perf_counter()
+        buckets_num, displacements, slots = build_phf(keys, 'benchmark')
+        build_ms = (time.perf_counter() - t0) * 1000.0
+
+        # Среднее число сравнений при поиске существующего ключа
+        linear = sum(i + 1 for i in range(n)) / n
+        sorted_keys = sorted(k for k, _ in keys)
+        binary = 0
+        for key in sorted_keys:
+            lo, hi, steps = 0, n - 1, 0
+            while lo <= hi:
+                mid = (lo + hi) // 2
+                steps += 1
+                if sorted_keys[mid] == key:
+                    break
+                if sorted_keys[mid] < key:
+                    lo = mid + 1
+                else:
+                    hi = mid - 1
+            binary += steps
+        binary /= n
+        for key, idx in keys:
+            assert phf_lookup(buckets_num, displacements, slots, key) == idx
+        tables = 2 * (buckets_num + n)
+        print(f'{n:7d} {linear:14.1f} {binary:11.1f} {1:8d} {buckets_num:12d} {max(displacements):9d} {tables:10d} {build_ms:10.1f}')
+
+def synthetic_params(n):
+    """
+    Синтетические имена и псевдонимы n параметров в стиле ParamsDB. Имена с повторяющимся CRC16
+    пропускаются, как это пришлось бы сделать с реальной базой.
+    """
+    names = []
+    crc_owner = set()
+    i = 0
+    while len(names) < n:
+        name = f'motor_{i // 16}_param_{i % 16}_value'
+        i += 1
+        if crc16_ccitt(name) in crc_owner:
+            continue
+        crc_owner.add(crc16_ccitt(name))
+        names.append(name)
+    aliases = [f'MP{k:05d}' for k in range(n)]
+    return names, aliases
+
+def generate_bench_tables(out_path, sizes=(45, 100, 250, 500, 1000, 2000)):
+    """
+    Генерирует C файл с синтетическими наборами параметров разного размера: массив T_NV_parameters
+    (только имя и псевдоним), таблицу индекс->CRC16, отсортированную таблицу CRC16 для бинарного поиска,
+    хеш-индексы и функцию поиска по CRC16 так же, как для рабочей базы. Описание наборов в
+    host/tests/param_lookup_tables.h
+    """
+    lines = []
+    lines.append('// Generated by Generate_params_c_h_from_ParamsDB_txt.py --bench-tables, do not edit')
+    lines.append('#include "App.h"')
+    lines.append('#include "param_lookup_tables.h"')
+    lines.append('')
+    entries = []
+    for n in sizes:
+        names, aliases = synthetic_params(n)
+        hashes = [crc16_ccitt(nm) for nm in names]
+        p = f'bench_{n}'
+        lines.append(f'static const T_NV_parameters {p}_params[{n}] =')
+        lines.append('{')
+        for i in range(n):
+            comma = '' if i == n - 1 else ','
+            lines.append(f'  {{ (const uint8_t *)"{names[i]}", (const uint8_t *)"", (const uint8_t *)"{aliases[i]}" }}{comma}')
+        lines.append('};')
+        lines.append('')
+        lines.append(f'static const uint16_t {p}_index_to_hash[{n}] =')
+        lines.append('{')
+        for i in range(n):
+            comma = '' if i == n - 1 else ','
+            lines.append(f'  0x{hashes[i]:04X}{comma}')
+        lines.append('};')
+        lines.append('')
+        lines.append(f'static const T_param_hash_entry {p}_hash_sorted[{n}] =')
+        lines.append('{')
+        order = sorted(range(n), key=lambda i: hashes[i])
+        for k, i in enumerate(order):
+            comma = '' if k == n - 1 else ','
+            lines.append(f'  {{0x{hashes[i]:04X}, {i:4d}}}{comma}')
+        lines.append('};')
+        lines.append('')
+        lines.append(generate_phf_table(f'{p}_hash_phf', [(h, i) for i, h in enumerate(hashes)], 'CRC16 hash', names))
+        lines.append(generate_phf_table(f'{p}_name_phf', [(fnv1a32(nm), i) for i, nm in enumerate(names)], 'name', names))
+        lines.append(generate_phf_table(f'{p}_alias_phf', [(fnv1a32(a), i) for i, a in enumerate(aliases)], 'alias', names))
+        lines.append(generate_find_by_hash(f'{p}_find_by_hash', f'{p}_hash_phf', f'{p}_index_to_hash', static=True))
+        entries.append(f'  {{{n}, {p}_params, {p}_index_to_hash, {p}_hash_sorted, &{p}_name_phf, &{p}_alias_phf, {p}_find_by_hash}}')
+    lines.append(f'const T_param_lookup_set g_param_lookup_sets[PARAM_LOOKUP_SETS_NUM] =')
+    lines.append('{')
+    lines.append(',\n'.join(entries))
+    lines.append('};')
+    lines.append('')
+    lines.append(f'_Static_assert(PARAM_LOOKUP_SETS_NUM == {len(sizes)}, "PARAM_LOOKUP_SETS_NUM does not match the generated sets");')
+    with open(out_path, 'w', encoding='utf-8') as f:
+        f.write('\n'.join(lines) + '\n')
+
 # --- Главная функция ---
 def get_file_paths(db):
     """Генерирует пути к выходным файлам на основе ProfileName"""
@@ -697,6 +936,12 @@ def get_file_paths(db):
     return c_path, h_path
 
 def main():
+    if '--bench' in sys.argv:
+        benchmark_lookup()
+        return
+    if '--bench-tables' in sys.argv:
+        generate_bench_tables(sys.argv[sys.argv.index('--bench-tables') + 1])
+        return
     db = load_params_db()
     params_c_path, params_h_path = get_file_paths(db)
     h = generate_h(db)
@@ -0,0 +1,154 @@
+#include "App.h"
+
+/*-----------------------------------------------------------------------------------------------------
+  Enable the DWT cycle counter used for execution time profiling
+
+  Parameters:
+    None
+
+  Return:
+    1 if the cycle counter is running, 0 otherwise
+-----------------------------------------------------------------------------------------------------*/
+uint32_t Cycle_profiler_init(void)
+{
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;  // Trace enable is required for DWT operation
+  DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+
+  if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0)
+  {
+    return 1;
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Clear accumulated statistics of a profile. Period and budget settings are preserved.
+
+  Parameters:
+    p_prof - pointer to profile
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Cycle_profile_reset(T_cycle_profile *p_prof)
+{
+  TX_INTERRUPT_SAVE_AREA
+  TX_DISABLE
+  p_prof->count             = 0;
+  p_prof->last_cycles       = 0;
+  p_prof->min_cycles        = UINT32_MAX;
+  p_prof->max_cycles        = 0;
+  p_prof->sum_cycles        = 0;
+  p_prof->overrun_count     = 0;
+  p_prof->prev_start        = 0;
+  p_prof->max_jitter_cycles = 0;
+  TX_RESTORE
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Set expected call period and execution budget of a profile and clear its statistics
+
+  Parameters:
+    p_prof         - pointer to profile
+    nominal_period - expected period between entries in CPU cycles (0 disables jitter tracking)
+    budget_cycles  - execution time budget in CPU cycles (0 disables overrun counting)
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Cycle_profile_set_period(T_cycle_profile *p_prof, uint32_t nominal_period, uint32_t budget_cycles)
+{
+  p_prof->nominal_period = nominal_period;
+  p_prof->budget_cycles  = budget_cycles;
+  Cycle_profile_reset(p_prof);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Account one execution of the profiled section.
+  Called from the profiled context (ISR or thread) right after the end timestamp is taken,
+  so the call itself does not contribute to the measured duration.
+
+  Parameters:
+    p_prof       - pointer to profile
+    start_cycles - DWT counter value at section entry
+    end_cycles   - DWT counter value at section exit
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Cycle_profile_update(T_cycle_profile *p_prof, uint32_t start_cycles, uint32_t end_cycles)
+{
+  uint32_t duration = end_cycles - start_cycles;  // Unsigned arithmetic handles counter wrap
+
+  p_prof->last_cycles = duration;
+  p_prof->sum_cycles += duration;
+  if (duration < p_prof->min_cycles)
+  {
+    p_prof->min_cycles = duration;
+  }
+  if (duration > p_prof->max_cycles)
+  {
+    p_prof->max_cycles = duration;
+  }
+  if ((p_prof->budget_cycles != 0) && (duration > p_prof->budget_cycles))
+  {
+    p_prof->overrun_count++;
+  }
+
+  if ((p_prof->nominal_period != 0) && (p_prof->count != 0))
+  {
+    uint32_t period = start_cycles - p_prof->prev_start;
+    uint32_t jitter;
+    if (period > p_prof->nominal_period)
+    {
+      jitter = period - p_prof->nominal_period;
+    }
+    else
+    {
+      jitter = p_prof->nominal_period - period;
+    }
+    if (jitter > p_prof->max_jitter_cycles)
+    {
+      p_prof->max_jitter_cycles = jitter;
+    }
+  }
+  p_prof->prev_start = start_cycles;
+  p_prof->count++;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Take a consistent snapshot of a profile and convert it to nanoseconds
+
+  Parameters:
+    p_prof   - pointer to profile
+    p_report - pointer to report structure to fill
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Cycle_profile_get_report(T_cycle_profile *p_prof, T_cycle_profile_report *p_report)
+{
+  T_cycle_profile snap;
+
+  TX_INTERRUPT_SAVE_AREA
+  TX_DISABLE
+  snap = *p_prof;
+  TX_RESTORE
+
+  p_report->count         = snap.count;
+  p_report->last_ns       = CYCLES_TO_NS(snap.last_cycles);
+  p_report->max_ns        = CYCLES_TO_NS(snap.max_cycles);
+  p_report->budget_ns     = CYCLES_TO_NS(snap.budget_cycles);
+  p_report->overrun_count = snap.overrun_count;
+  p_report->max_jitter_ns = CYCLES_TO_NS(snap.max_jitter_cycles);
+  if (snap.count != 0)
+  {
+    p_report->min_ns = CYCLES_TO_NS(snap.min_cycles);
+    p_report->avg_ns = CYCLES_TO_NS(snap.sum_cycles / snap.count);
+  }
+  else
+  {
+    p_report->min_ns = 0;
+    p_report->avg_ns = 0;
+  }
+}
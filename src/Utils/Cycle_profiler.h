@@ -0,0 +1,50 @@
+#ifndef CYCLE_PROFILER_H
+#define CYCLE_PROFILER_H
+
+// Current value of the DWT cycle counter (CPU clock cycles, wraps every 2^32 cycles).
+// The host build supplies its own counter in the same units.
+#ifndef CYCLE_PROFILER_NOW
+#define CYCLE_PROFILER_NOW()             (DWT->CYCCNT)
+#endif
+
+// Conversion of CPU clock cycles to nanoseconds
+#define CYCLES_TO_NS(cycles)             ((uint32_t)(((uint64_t)(cycles) * 1000ull) / FRQ_CPUCLK_MHZ))
+
+// Conversion of a frequency in Hz to the corresponding period in CPU clock cycles
+#define CYCLE_PROFILER_PERIOD(freq_hz)   ((uint32_t)((FRQ_CPUCLK_MHZ * 1000000ull) / (freq_hz)))
+
+// Execution profile of a periodically called code section
+typedef struct
+{
+  uint32_t count;              // Number of measured executions
+  uint32_t last_cycles;        // Duration of the last execution [CPU cycles]
+  uint32_t min_cycles;         // Minimum execution duration [CPU cycles]
+  uint32_t max_cycles;         // Maximum execution duration [CPU cycles]
+  uint64_t sum_cycles;         // Sum of all durations for average calculation [CPU cycles]
+  uint32_t budget_cycles;      // Execution time budget [CPU cycles], 0 = budget not checked
+  uint32_t overrun_count;      // Number of executions that exceeded the budget
+  uint32_t nominal_period;     // Expected period between entries [CPU cycles], 0 = jitter not tracked
+  uint32_t prev_start;         // DWT counter value at previous entry
+  uint32_t max_jitter_cycles;  // Worst-case deviation of the entry period from nominal [CPU cycles]
+} T_cycle_profile;
+
+// Snapshot of a profile converted to nanoseconds for display
+typedef struct
+{
+  uint32_t count;          // Number of measured executions
+  uint32_t last_ns;        // Duration of the last execution [ns]
+  uint32_t min_ns;         // Minimum execution duration [ns]
+  uint32_t avg_ns;         // Average execution duration [ns]
+  uint32_t max_ns;         // Maximum execution duration [ns]
+  uint32_t budget_ns;      // Execution time budget [ns]
+  uint32_t overrun_count;  // Number of executions that exceeded the budget
+  uint32_t max_jitter_ns;  // Worst-case entry period jitter [ns]
+} T_cycle_profile_report;
+
+uint32_t Cycle_profiler_init(void);
+void     Cycle_profile_reset(T_cycle_profile *p_prof);
+void     Cycle_profile_set_period(T_cycle_profile *p_prof, uint32_t nominal_period, uint32_t budget_cycles);
+void     Cycle_profile_update(T_cycle_profile *p_prof, uint32_t start_cycles, uint32_t end_cycles);
+void     Cycle_profile_get_report(T_cycle_profile *p_prof, T_cycle_profile_report *p_report);
+
+#endif  // CYCLE_PROFILER_H
@@ -47,11 +47,15 @@ static uint32_t         g_can_auto_send_last = 0;
 static T_recent_can_msg g_recent_messages[CAN_MAX_RECENT_MESSAGES];
 static uint8_t          g_recent_msg_index   = 0;                                                   // Next message index to write
 
+static const char *const g_can_tx_class_names[CAN_TX_CLASS_COUNT] = { "Status", "Telemetry", "Other" };
+
 // Diagnostic callback management
 static T_can_rx_callback g_original_callback = NULL;  // Store original callback when diagnostic is active
 
 // Function prototypes
 static uint8_t _Can_diag_print_status(void);
+static uint8_t _Can_diag_print_rx_dispatch(uint8_t cln);
+static uint8_t _Can_diag_print_telemetry(uint8_t cln);
 static void    _Can_add_recent_message(const T_can_msg* msg);
 static void    _Can_clear_recent_messages(void);
 static void    _Can_send_test_message(void);
@@ -85,6 +89,14 @@ static uint8_t _Can_diag_print_status(void)
   MPRINTF_LINE(cln, "=== CAN System Status ===\r\n");
   MPRINTF_LINE(cln, "CAN Ready:        %s\r\n", can_ready ? "YES" : "NO");
   MPRINTF_LINE(cln, "RX Queue Count:   %u messages\r\n", (unsigned int)rx_queue_count);
+  if (Can_get_afl_rule_count() != 0)
+  {
+    MPRINTF_LINE(cln, "AFL Rules:        %u\r\n", (unsigned int)Can_get_afl_rule_count());
+  }
+  else
+  {
+    MPRINTF_LINE(cln, "AFL Rules:        accept all extended IDs\r\n");
+  }
   MPRINTF_LINE(cln, "Auto Send:        %s\r\n", g_can_auto_send ? "ENABLED" : "DISABLED");
   MPRINTF_LINE(cln, "\r\n");
 
@@ -92,15 +104,36 @@ static uint8_t _Can_diag_print_status(void)
   MPRINTF_LINE(cln, "=== Error Counters ===\r\n");
   MPRINTF_LINE(cln, "TX Messages:      %u\r\n", (unsigned int)counters->total_tx_messages);
   MPRINTF_LINE(cln, "RX Messages:      %u\r\n", (unsigned int)counters->total_rx_messages);
+  MPRINTF_LINE(cln, "FD TX/RX:         %u / %u\r\n", (unsigned int)counters->total_fd_tx_messages, (unsigned int)counters->total_fd_rx_messages);
   MPRINTF_LINE(cln, "TX Queue Full:    %u\r\n", (unsigned int)counters->tx_queue_full_errors);
   MPRINTF_LINE(cln, "RX Queue Full:    %u\r\n", (unsigned int)counters->rx_queue_full_errors);
   MPRINTF_LINE(cln, "TX HW Errors:     %u\r\n", (unsigned int)counters->tx_hardware_errors);
-  MPRINTF_LINE(cln, "TX Sem Timeout:   %u\r\n", (unsigned int)counters->tx_semaphore_timeout_errors);
+  MPRINTF_LINE(cln, "TX Stale Dropped: %u\r\n", (unsigned int)counters->tx_stale_dropped);
   MPRINTF_LINE(cln, "Bus Off Errors:   %u\r\n", (unsigned int)counters->bus_off_errors);
   MPRINTF_LINE(cln, "Warning Count:    %u\r\n", (unsigned int)counters->error_warning_count);
   MPRINTF_LINE(cln, "Passive Count:    %u\r\n", (unsigned int)counters->error_passive_count);
   MPRINTF_LINE(cln, "\r\n");
 
+  // TX scheduler: queue-to-wire latency per scheduling class
+  MPRINTF_LINE(cln, "=== TX Scheduler (pending %u, peak %u) ===\r\n", (unsigned int)Can_get_tx_pending_count(), (unsigned int)counters->tx_peak_pending);
+  MPRINTF_LINE(cln, "Class          Count   Min,us   Avg,us   Max,us\r\n");
+  for (uint32_t i = 0; i < CAN_TX_CLASS_COUNT; i++)
+  {
+    T_cycle_profile_report rep;
+    Cycle_profile_get_report(&g_can_tx_latency[i], &rep);
+    MPRINTF_LINE(cln, "%-10s %9u %8u %8u %8u\r\n", g_can_tx_class_names[i], (unsigned int)rep.count,
+                 (unsigned int)(rep.min_ns / 1000), (unsigned int)(rep.avg_ns / 1000), (unsigned int)(rep.max_ns / 1000));
+  }
+  MPRINTF_LINE(cln, "\r\n");
+
+  // RX dispatch: latency from the RX interrupt to the return of the handler
+  cln = _Can_diag_print_rx_dispatch(cln);
+  MPRINTF_LINE(cln, "\r\n");
+
+  // Telemetry broadcaster: frames sent without a request
+  cln = _Can_diag_print_telemetry(cln);
+  MPRINTF_LINE(cln, "\r\n");
+
   // Test Message Configuration
   MPRINTF_LINE(cln, "=== Test Message Config ===\r\n");
   MPRINTF_LINE(cln, "CAN ID:           0x%08X\r\n", (unsigned int)g_can_test_id);
@@ -162,6 +195,78 @@ static uint8_t _Can_diag_print_status(void)
   return cln + 1;
 }
 
+/*-----------------------------------------------------------------------------------------------------
+  Print RX dispatch counters and latency histograms of the ISR and task paths
+
+  Parameters:
+    cln - current screen line
+
+  Return:
+    Next screen line
+-----------------------------------------------------------------------------------------------------*/
+static uint8_t _Can_diag_print_rx_dispatch(uint8_t cln)
+{
+  GET_MCBL;
+  T_can_rx_dispatch_stats st;
+  T_can_rx_path_stats*    paths[2];
+  static const char*      names[2] = { "ISR", "Task" };
+
+  Can_rx_dispatch_stats_get(&st);
+  paths[0] = &st.isr;
+  paths[1] = &st.task;
+  MPRINTF_LINE(cln, "=== RX Dispatch (unmatched %u, disabled %u) ===\r\n", (unsigned int)st.unmatched, (unsigned int)st.disabled);
+  for (uint32_t p = 0; p < 2; p++)
+  {
+    MPRINTF_LINE(cln, "%-4s   Count: %u  Last: %u us  Max: %u us\r\n", names[p],
+                 (unsigned int)paths[p]->count, (unsigned int)paths[p]->last_us, (unsigned int)paths[p]->max_us);
+    MPRINTF(CL);
+    for (uint32_t i = 0; i < CAN_RX_LATENCY_BINS; i++)
+    {
+      if (g_can_rx_latency_edges_us[i] == UINT32_MAX)
+      {
+        MPRINTF(" >%u:%u", (unsigned int)g_can_rx_latency_edges_us[i - 1], (unsigned int)paths[p]->hist[i]);
+      }
+      else
+      {
+        MPRINTF(" <=%u:%u", (unsigned int)g_can_rx_latency_edges_us[i], (unsigned int)paths[p]->hist[i]);
+      }
+    }
+    MPRINTF("\r\n");
+    cln++;
+  }
+  return cln;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Print telemetry broadcaster counters and the configured periods
+
+  Parameters:
+    cln - current screen line
+
+  Return:
+    Next screen line
+-----------------------------------------------------------------------------------------------------*/
+static uint8_t _Can_diag_print_telemetry(uint8_t cln)
+{
+  GET_MCBL;
+  T_can_telemetry_stats st;
+  static const char*    names[CAN_TLM_MSG_COUNT] = { "ANS", "SENS_INFO", "PWR_INFO" };
+  uint32_t              periods[CAN_TLM_MSG_COUNT];
+
+  Can_telemetry_stats_get(&st);
+  periods[CAN_TLM_MSG_ANS]  = wvar.can_ans_period_ms;
+  periods[CAN_TLM_MSG_SENS] = wvar.can_sens_period_ms;
+  periods[CAN_TLM_MSG_PWR]  = wvar.can_pwr_period_ms;
+  MPRINTF_LINE(cln, "=== Telemetry Broadcast (on change %s) ===\r\n", wvar.can_tlm_on_change ? "ON" : "OFF");
+  MPRINTF_LINE(cln, "Message    Period,ms  Periodic  OnChange    Failed\r\n");
+  for (uint32_t i = 0; i < CAN_TLM_MSG_COUNT; i++)
+  {
+    MPRINTF_LINE(cln, "%-10s %9u %9u %9u %9u\r\n", names[i], (unsigned int)periods[i], (unsigned int)st.msg[i].periodic,
+                 (unsigned int)st.msg[i].on_change, (unsigned int)st.msg[i].tx_failed);
+  }
+  return cln;
+}
+
 /*-----------------------------------------------------------------------------------------------------
   Add received message to recent messages buffer
 
@@ -371,6 +476,7 @@ void Diagnostic_CAN(uint8_t keycode)
           break;
         case CAN_KEY_RESET_COUNTERS:
           Can_reset_error_counters();
+          Can_telemetry_stats_reset();
           break;
         case CAN_KEY_TOGGLE_AUTO_SEND:
           g_can_auto_send      = !g_can_auto_send;
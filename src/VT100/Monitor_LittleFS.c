@@ -1,6 +1,8 @@
 #include "App.h"
 #include "LittleFS/littlefs_demo.h"
 #include "LittleFS/littlefs_adapter.h"
+#include "LittleFS/littlefs_bench.h"
+#include "LittleFS/storage_bench.h"
 
 #define LFS_TEST_FILE_SIZE 256
 
@@ -191,8 +193,152 @@ void Do_LittleFS_dir_ops(uint8_t keycode)
 -----------------------------------------------------------------------------------------------------*/
 void Do_LittleFS_benchmark(uint8_t keycode)
 {
-  Do_LittleFS_format(keycode);  // Reuse the comprehensive test function
+  GET_MCBL;
+  T_lfs_bench_report rep;
+  static const uint32_t page_cache[2] = { 0, LITTLEFS_BD_PAGE_SIZE };
+
+  MPRINTF(VT100_CLEAR_AND_HOME);
+  MPRINTF("=== LittleFS Benchmark (RAM flash model, %u blocks) ===\n\r", LFS_BENCH_BLOCK_COUNT);
+  MPRINTF("Small: %u files x %u bytes, large: 1 file x %u bytes\n\r", LFS_BENCH_SMALL_FILES, LFS_BENCH_SMALL_FILE_SZ, LFS_BENCH_LARGE_FILE_SZ);
+
+  for (uint32_t n = 0; n < 2; n++)
+  {
+    int result = Littlefs_bench_run(page_cache[n], &rep);
+
+    MPRINTF("\n\rPage cache: %u bytes\n\r", rep.page_cache);
+    if (result != 0)
+    {
+      MPRINTF("Benchmark failed: %d\n\r", result);
+      continue;
+    }
+    MPRINTF("Workload      files/s      MB/s   CPU,us   Flash,us  Progs  Erases\n\r");
+    const T_lfs_bench_result *res[4] = { &rep.small_write, &rep.small_read, &rep.large_write, &rep.large_read };
+    const char               *name[4] = { "small write", "small read", "large write", "large read" };
+    for (uint32_t i = 0; i < 4; i++)
+    {
+      MPRINTF("%-12s %8u %5u.%03u %8u %10u %6u %7u\n\r",
+              name[i],
+              res[i]->files_per_s,
+              res[i]->bytes_per_s / 1000000,
+              (res[i]->bytes_per_s / 1000) % 1000,
+              res[i]->cpu_us,
+              res[i]->dev_us,
+              res[i]->dev_progs,
+              res[i]->dev_erases);
+    }
+  }
+
+  // Read latency does not depend on the page cache, the result of the last run is shown
+  if ((rep.erase_sync.reads != 0) && (rep.erase_async.reads != 0))
+  {
+    MPRINTF("\n\rReads during erase of %u sectors, read every %u us on average:\n\r", LFS_BENCH_LAT_ERASES, LFS_BENCH_LAT_PERIOD_US);
+    MPRINTF("Erase         Reads  Worst,us   Avg,us  Erase total,us  Suspends\n\r");
+    const T_lfs_bench_latency *lat[2]  = { &rep.erase_sync, &rep.erase_async };
+    const char                *mode[2] = { "blocking", "background" };
+    for (uint32_t i = 0; i < 2; i++)
+    {
+      MPRINTF("%-12s %6u %9u %8u %15u %9u\n\r",
+              mode[i],
+              lat[i]->reads,
+              lat[i]->worst_us,
+              lat[i]->avg_us,
+              lat[i]->erase_us,
+              lat[i]->suspends);
+    }
+  }
+
+  MPRINTF("\n\rPress any key to continue...\n\r");
+  uint8_t dummy_key;
+  WAIT_CHAR(&dummy_key, ms_to_ticks(100000));
+}
+
+/*-----------------------------------------------------------------------------------------------------
+
+  \param keycode
+
+  \return none
+-----------------------------------------------------------------------------------------------------*/
+void Do_LittleFS_geometry(uint8_t keycode)
+{
+  GET_MCBL;
+  T_lfs_bench_geo_report rep;
+
+  MPRINTF(VT100_CLEAR_AND_HOME);
+  MPRINTF("=== LittleFS Geometry Profiles (RAM flash model, %u blocks) ===\n\r", LFS_BENCH_BLOCK_COUNT);
+  MPRINTF("Log: %u x %u bytes synced, rewrite: %u files x %u bytes x %u, scan: %u files x %u\n\r",
+          LFS_BENCH_LOG_RECORDS, LFS_BENCH_LOG_RECORD_SZ,
+          LFS_BENCH_RW_FILES, LFS_BENCH_RW_FILE_SZ, LFS_BENCH_RW_ROUNDS,
+          LFS_BENCH_DIR_FILES, LFS_BENCH_DIR_SCANS);
+  MPRINTF("OSPI file system profile: %s\n\r", g_littlefs_geometry.name);
+
+  for (uint32_t n = 0; n < LITTLEFS_PROFILE_COUNT; n++)
+  {
+    const T_littlefs_geometry *geo    = &g_littlefs_profiles[n];
+    int                        result = Littlefs_bench_profile(geo, &rep);
+
+    MPRINTF("\n\r%s: read %u, prog %u, cache %u, lookahead %u, block_cycles %u\n\r",
+            geo->name, geo->read_size, geo->prog_size, geo->cache_size, geo->lookahead_size, geo->block_cycles);
+    if (result != 0)
+    {
+      MPRINTF("Benchmark failed: %d\n\r", result);
+      continue;
+    }
+    MPRINTF("Workload        ops/s  Prog/byte  Prog,bytes  Progs  Erases\n\r");
+    const T_lfs_bench_result *res[3]  = { &rep.log_append, &rep.rewrite, &rep.dir_scan };
+    const char               *name[3] = { "log append", "rewrite", "dir scan" };
+    for (uint32_t i = 0; i < 3; i++)
+    {
+      uint32_t amp_x100 = (res[i]->bytes != 0) ? (uint32_t)(((uint64_t)res[i]->prog_bytes * 100u) / res[i]->bytes) : 0;
+      MPRINTF("%-12s %8u %6u.%02u %11u %6u %7u\n\r",
+              name[i],
+              res[i]->files_per_s,
+              amp_x100 / 100,
+              amp_x100 % 100,
+              res[i]->prog_bytes,
+              res[i]->dev_progs,
+              res[i]->dev_erases);
+    }
+  }
+
+  MPRINTF("\n\rPress any key to continue...\n\r");
+  uint8_t dummy_key;
+  WAIT_CHAR(&dummy_key, ms_to_ticks(100000));
+}
+
+#if STORAGE_BENCH_ENABLE
+/*-----------------------------------------------------------------------------------------------------
+
+  \param keycode
+
+  \return none
+-----------------------------------------------------------------------------------------------------*/
+void Do_Storage_benchmark(uint8_t keycode)
+{
+  GET_MCBL;
+  T_stb_report rep;
+  char         line[160];
+
+  MPRINTF(VT100_CLEAR_AND_HOME);
+  MPRINTF("=== LittleFS vs LevelX+FileX (RAM flash model, %u blocks) ===\n\r", STB_BLOCK_COUNT);
+  MPRINTF("Running...\n\r\n\r");
+
+  Storage_bench_csv_header(line, sizeof(line));
+  MPRINTF("%s\n\r", line);
+  for (uint32_t n = 0; n < STB_STACK_COUNT; n++)
+  {
+    Storage_bench_run((T_stb_stack)n, 12345, &rep);
+    for (uint32_t w = 0; w < STB_WORKLOAD_COUNT; w++)
+    {
+      Storage_bench_csv_row(&rep, (T_stb_workload)w, line, sizeof(line));
+      MPRINTF("%s\n\r", line);
+    }
+  }
+
+  MPRINTF("\n\rPress any key to continue...\n\r");
+  uint8_t dummy_key;
+  WAIT_CHAR(&dummy_key, ms_to_ticks(100000));
 }
+#endif
 
 /*-----------------------------------------------------------------------------------------------------
 
@@ -210,6 +356,11 @@ const T_VT100_Menu_item MENU_LittleFS_items[] = {
   { '2', Do_LittleFS_format,       NULL },
   { '3', Do_LittleFS_info,         NULL },
   { '4', Do_LittleFS_test_file_ops, NULL },
+  { '5', Do_LittleFS_benchmark,    NULL },
+  { '6', Do_LittleFS_geometry,     NULL },
+#if STORAGE_BENCH_ENABLE
+  { '7', Do_Storage_benchmark,     NULL },
+#endif
   { 'R', NULL,                     NULL },
   { 0 } // End of menu
 };
@@ -221,6 +372,11 @@ const T_VT100_Menu MENU_LittleFS = {
   "\033[5C <2> - Run comprehensive test\r\n"
   "\033[5C <3> - List files\r\n"
   "\033[5C <4> - Test file operations\r\n"
+  "\033[5C <5> - Benchmark on RAM flash model\r\n"
+  "\033[5C <6> - Geometry profiles on RAM flash model\r\n"
+#if STORAGE_BENCH_ENABLE
+  "\033[5C <7> - LittleFS vs LevelX+FileX on RAM flash model\r\n"
+#endif
   "\033[5C <R> - Return to previous menu\r\n",
   MENU_LittleFS_items
 };
@@ -9,6 +9,8 @@ void Do_LittleFS_info(uint8_t keycode);
 void Do_LittleFS_test_file_ops(uint8_t keycode);
 void Do_LittleFS_dir_ops(uint8_t keycode);
 void Do_LittleFS_benchmark(uint8_t keycode);
+void Do_LittleFS_geometry(uint8_t keycode);
+void Do_Storage_benchmark(uint8_t keycode);
 void Do_LittleFS_mount_test(uint8_t keycode);
 
 extern const T_VT100_Menu MENU_LittleFS;
@@ -352,7 +352,7 @@ static const char* _Get_phase_state_str(uint8_t motor_driver, uint8_t phase, uin
     algorithm - algorithm type
 
   Return:
-    String representing algorithm (INSTANT/LINEAR/S-CURVE)
+    String representing algorithm (INSTANT/LINEAR/S-CURVE/JERK)
 -----------------------------------------------------------------------------------------------------*/
 static const char* _Get_algorithm_str(T_soft_start_algorithm algorithm)
 {
@@ -364,6 +364,8 @@ static const char* _Get_algorithm_str(T_soft_start_algorithm algorithm)
       return "LINEAR";
     case SOFT_START_ALG_S_CURVE:
       return "S-CURVE";
+    case SOFT_START_ALG_JERK:
+      return "JERK";
     default:
       return "UNKNOWN";
   }
@@ -380,7 +382,7 @@ static const char* _Get_algorithm_str(T_soft_start_algorithm algorithm)
 -----------------------------------------------------------------------------------------------------*/
 static void _Toggle_algorithm(void)
 {
-  // Cycle through algorithms: INSTANT -> LINEAR -> S_CURVE -> INSTANT
+  // Cycle through algorithms: INSTANT -> LINEAR -> S_CURVE -> JERK -> INSTANT
   if (g_current_algorithm == SOFT_START_ALG_INSTANT)
   {
     g_current_algorithm = SOFT_START_ALG_LINEAR;
@@ -389,6 +391,10 @@ static void _Toggle_algorithm(void)
   {
     g_current_algorithm = SOFT_START_ALG_S_CURVE;
   }
+  else if (g_current_algorithm == SOFT_START_ALG_S_CURVE)
+  {
+    g_current_algorithm = SOFT_START_ALG_JERK;
+  }
   else
   {
     g_current_algorithm = SOFT_START_ALG_INSTANT;
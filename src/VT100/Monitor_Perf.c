@@ -0,0 +1,295 @@
+#include "App.h"
+
+#define PERF_DIAG_HEADER     "================== Performance Counters ==================\r\n"
+#define PERF_DIAG_START_LINE 3  // Line where counters start (after header)
+#define PERF_DIAG_REFRESH_MS 500
+
+// Performance diagnostic key definitions
+#define PERF_KEY_RESET       'R'  // Reset all statistics
+#define PERF_KEY_JSON_BENCH  'J'  // Run settings JSON serializer benchmark
+#define PERF_KEY_EXIT        VT100_ESC
+
+// Short macro for VT100 line clearing
+#define CL                   VT100_CLR_LINE
+
+// Macro to combine MPRINTF with line counter increment for cleaner code
+#define MPRINTF_LINE(line_var, ...) \
+  do                                \
+  {                                 \
+    MPRINTF(CL __VA_ARGS__);        \
+    (line_var)++;                   \
+  } while (0)
+
+static uint8_t _Perf_print_profile(uint8_t cln, const char *name, T_cycle_profile *p_prof);
+static uint8_t _Perf_print_motor_cmd_latency(uint8_t cln);
+static uint8_t _Perf_print_log_file(uint8_t cln);
+static uint8_t _Perf_print_json_bench_line(uint8_t cln, const char *name, uint32_t cycles, uint32_t heap, uint32_t size);
+static uint8_t _Perf_print_json_bench(uint8_t cln);
+static uint8_t _Perf_print_status(void);
+static void    _Perf_reset_all(void);
+
+static T_settings_json_bench g_perf_json_bench;  // Results of the last settings JSON benchmark run
+
+/*-----------------------------------------------------------------------------------------------------
+  Print one line with execution time statistics of a profile
+
+  Parameters:
+    cln    - current screen line
+    name   - profile name (up to 16 characters)
+    p_prof - pointer to profile
+
+  Return:
+    Next screen line
+-----------------------------------------------------------------------------------------------------*/
+static uint8_t _Perf_print_profile(uint8_t cln, const char *name, T_cycle_profile *p_prof)
+{
+  GET_MCBL;
+  T_cycle_profile_report rep;
+
+  Cycle_profile_get_report(p_prof, &rep);
+  MPRINTF_LINE(cln, "%-16s %10u %8u %8u %8u %8u %8u %8u\r\n",
+               name,
+               (unsigned int)rep.count,
+               (unsigned int)rep.last_ns,
+               (unsigned int)rep.min_ns,
+               (unsigned int)rep.avg_ns,
+               (unsigned int)rep.max_ns,
+               (unsigned int)rep.max_jitter_ns,
+               (unsigned int)rep.overrun_count);
+  return cln;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Print motor command enqueue-to-apply latency statistics and histogram
+
+  Parameters:
+    cln - current screen line
+
+  Return:
+    Next screen line
+-----------------------------------------------------------------------------------------------------*/
+static uint8_t _Perf_print_motor_cmd_latency(uint8_t cln)
+{
+  GET_MCBL;
+  T_motor_cmd_latency_stats st;
+
+  Motor_cmd_latency_get(&st);
+  MPRINTF_LINE(cln, "=== Motor command latency (enqueue to apply) ===\r\n");
+  MPRINTF_LINE(cln, "Applied: %u  Coalesced: %u  Max batch: %u  Last: %u us  Max: %u us\r\n",
+               (unsigned int)st.applied_count,
+               (unsigned int)st.coalesced_count,
+               (unsigned int)st.max_batch,
+               (unsigned int)st.last_us,
+               (unsigned int)st.max_us);
+  MPRINTF(CL);
+  for (uint32_t i = 0; i < MOTOR_CMD_LATENCY_BINS; i++)
+  {
+    if (g_motor_cmd_latency_edges_us[i] == UINT32_MAX)
+    {
+      MPRINTF(" >%u:%u", (unsigned int)g_motor_cmd_latency_edges_us[i - 1], (unsigned int)st.hist[i]);
+    }
+    else
+    {
+      MPRINTF(" <=%u:%u", (unsigned int)g_motor_cmd_latency_edges_us[i], (unsigned int)st.hist[i]);
+    }
+  }
+  MPRINTF("\r\n");
+  cln++;
+  return cln;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Print log file writer throughput and Logger_Task blocking time
+
+  Parameters:
+    cln - current screen line
+
+  Return:
+    Next screen line
+-----------------------------------------------------------------------------------------------------*/
+static uint8_t _Perf_print_log_file(uint8_t cln)
+{
+  GET_MCBL;
+  static const char *const names[] = { "App log", "Net log" };
+  static const uint32_t    ids[]   = { APP_LOG_ID, NET_LOG_ID };
+  T_log_file_stats         st;
+  T_cycle_profile_report   rep;
+
+  MPRINTF_LINE(cln, "=== Log file writer (%u byte buffer, flush every %u ms) ===\r\n", (unsigned int)LOG_FILE_WBUF_SZ, (unsigned int)LOG_FILE_FLUSH_PERIOD_MS);
+  MPRINTF_LINE(cln, "Log         Bytes/s      Bytes   Writes  Flushes   Errors  Avg,us  Max,us  Lost\r\n");
+  for (uint32_t i = 0; i < 2; i++)
+  {
+    LogFile_get_stats(ids[i], &st);
+    Cycle_profile_get_report(&st.write_profile, &rep);
+    MPRINTF_LINE(cln, "%-8s %10u %10u %8u %8u %8u %7u %7u %5u\r\n",
+                 names[i],
+                 (unsigned int)st.bytes_per_s,
+                 (unsigned int)st.bytes_written,
+                 (unsigned int)st.write_count,
+                 (unsigned int)st.flush_count,
+                 (unsigned int)st.write_err,
+                 (unsigned int)(rep.avg_ns / 1000),
+                 (unsigned int)(rep.max_ns / 1000),
+                 (unsigned int)Get_log_cbl(ids[i])->file_log_overfl_err);
+  }
+  return cln;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Print one line of the settings JSON benchmark
+
+  Parameters:
+    cln    - current screen line
+    name   - method name
+    cycles - execution time in CPU cycles
+    heap   - peak heap use in bytes
+    size   - processed JSON text size in bytes
+
+  Return:
+    Next screen line
+-----------------------------------------------------------------------------------------------------*/
+static uint8_t _Perf_print_json_bench_line(uint8_t cln, const char *name, uint32_t cycles, uint32_t heap, uint32_t size)
+{
+  GET_MCBL;
+  uint32_t us   = CYCLES_TO_NS(cycles) / 1000;
+  uint32_t kbps = (us > 0) ? (uint32_t)(((uint64_t)size * 1000000ull) / ((uint64_t)us * 1024ull)) : 0;
+
+  MPRINTF_LINE(cln, "%-22s %10u %10u %10u\r\n", name, (unsigned int)us, (unsigned int)heap, (unsigned int)kbps);
+  return cln;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Print results of the settings JSON benchmark: jansson tree against streaming writer and reader
+
+  Parameters:
+    cln - current screen line
+
+  Return:
+    Next screen line
+-----------------------------------------------------------------------------------------------------*/
+static uint8_t _Perf_print_json_bench(uint8_t cln)
+{
+  GET_MCBL;
+  T_settings_json_bench *p = &g_perf_json_bench;
+
+  MPRINTF_LINE(cln, "=== Settings JSON (%u params, %u bytes, press <J> to run) ===\r\n", (unsigned int)wvar_inst.items_num, (unsigned int)p->json_size);
+  if (p->done == 0)
+  {
+    MPRINTF_LINE(cln, "Not run\r\n");
+    return cln;
+  }
+  MPRINTF_LINE(cln, "Method                       Time,us  Peak heap     KB/s\r\n");
+  cln = _Perf_print_json_bench_line(cln, "Write, jansson tree", p->tree_wr_cycles, p->tree_wr_heap, p->tree_json_size);
+  cln = _Perf_print_json_bench_line(cln, "Write, streaming", p->stream_wr_cycles, p->stream_wr_heap, p->json_size);
+  cln = _Perf_print_json_bench_line(cln, "Read, jansson tree", p->tree_rd_cycles, p->tree_rd_heap, p->json_size);
+  cln = _Perf_print_json_bench_line(cln, "Read, streaming", p->stream_rd_cycles, p->stream_rd_heap, p->json_size);
+  return cln;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Display all performance counters
+
+  Parameters:
+    None
+
+  Return:
+    Next available line number
+-----------------------------------------------------------------------------------------------------*/
+static uint8_t _Perf_print_status(void)
+{
+  GET_MCBL;
+  uint8_t        cln = PERF_DIAG_START_LINE;
+  T_fmrec_status fmrec;
+
+  MPRINTF(VT100_CURSOR_SET, cln, 1);
+
+  MPRINTF_LINE(cln, "=== Execution time (DWT, CPU %u MHz) ===\r\n", (unsigned int)FRQ_CPUCLK_MHZ);
+  MPRINTF_LINE(cln, "Section               Count  Last,ns   Min,ns   Avg,ns   Max,ns Jitter,ns Overrun\r\n");
+  MPRINTF_LINE(cln, "---------------- ---------- -------- -------- -------- -------- -------- --------\r\n");
+  cln = _Perf_print_profile(cln, "ADC ISR", &g_adc_isr_profile);
+  cln = _Perf_print_profile(cln, "FMSTR rec", &g_fmrec_isr_profile);
+  cln = _Perf_print_profile(cln, "Motor loop", &g_motor_loop_profile);
+  cln = _Perf_print_profile(cln, "Soft start", &g_soft_start_profile);
+  MPRINTF_LINE(cln, "\r\n");
+  MPRINTF_LINE(cln, "ADC ISR budget:   %u ns (%u%% of PWM period at %u Hz)\r\n",
+               (unsigned int)CYCLES_TO_NS(g_adc_isr_profile.budget_cycles),
+               (unsigned int)ADC_ISR_BUDGET_PERCENT,
+               (unsigned int)g_adc_pwm_frequency);
+  Fmstr_rec_get_status(&fmrec);
+  MPRINTF_LINE(cln, "FMSTR recorder:   %s, decimation %u (%u Hz), fault capture %s, triggers %u\r\n",
+               (fmrec.active != 0) ? "on" : "off",
+               (unsigned int)fmrec.decimation,
+               (unsigned int)fmrec.sample_rate_hz,
+               (fmrec.fault_armed != 0) ? "armed" : "off",
+               (unsigned int)fmrec.fault_triggers);
+  MPRINTF_LINE(cln, "\r\n");
+  cln = _Perf_print_motor_cmd_latency(cln);
+  MPRINTF_LINE(cln, "\r\n");
+  cln = _Perf_print_log_file(cln);
+  MPRINTF_LINE(cln, "\r\n");
+  cln = _Perf_print_json_bench(cln);
+  MPRINTF_LINE(cln, "\r\n");
+  MPRINTF_LINE(cln, "<R> - Reset statistics, <J> - Run settings JSON benchmark, <ESC> - Exit\r\n");
+
+  return cln;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Reset statistics of all profiles
+
+  Parameters:
+    None
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+static void _Perf_reset_all(void)
+{
+  Cycle_profile_reset(&g_adc_isr_profile);
+  Cycle_profile_reset(&g_fmrec_isr_profile);
+  Cycle_profile_reset(&g_motor_loop_profile);
+  Cycle_profile_reset(&g_soft_start_profile);
+  Motor_cmd_latency_reset();
+  LogFile_reset_stats(APP_LOG_ID);
+  LogFile_reset_stats(NET_LOG_ID);
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Performance counters screen. Shows execution time and jitter of time critical code sections
+  measured on target with the DWT cycle counter.
+
+  Parameters:
+    keycode - Not used
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Diagnostic_Performance(uint8_t keycode)
+{
+  GET_MCBL;
+  uint8_t key = 0;
+
+  MPRINTF(VT100_CLEAR_AND_HOME);
+  MPRINTF(PERF_DIAG_HEADER);
+  (void)_Perf_print_status();
+
+  while (1)
+  {
+    if (VT100_wait_special_key(&key, ms_to_ticks(PERF_DIAG_REFRESH_MS)) == RES_OK)
+    {
+      if (key == PERF_KEY_EXIT)
+      {
+        break;
+      }
+      if ((key == PERF_KEY_RESET) || (key == 'r'))
+      {
+        _Perf_reset_all();
+      }
+      else if ((key == PERF_KEY_JSON_BENCH) || (key == 'j'))
+      {
+        Settings_JSON_benchmark(APPLICATION_PARAMS, &g_perf_json_bench);
+      }
+    }
+    (void)_Perf_print_status();
+  }
+}
@@ -0,0 +1,6 @@
+#ifndef MONITOR_PERF_H
+#define MONITOR_PERF_H
+
+void Diagnostic_Performance(uint8_t keycode);
+
+#endif  // MONITOR_PERF_H
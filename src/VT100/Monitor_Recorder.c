@@ -0,0 +1,146 @@
+#include "App.h"
+
+#define MREC_DIAG_HEADER     "==================== Motion Recorder =====================\r\n"
+#define MREC_DIAG_START_LINE 3  // Line where status starts (after header)
+#define MREC_DIAG_REFRESH_MS 500
+
+#define MREC_DURATION_MS     10000  // Duration of a recording started from this screen
+
+// Motion recorder key definitions
+#define MREC_KEY_START       'S'  // Start recording now
+#define MREC_KEY_ARM         'A'  // Arm recording, start on the next motor soft start
+#define MREC_KEY_STOP        'T'  // Stop recording
+#define MREC_KEY_DECIMATION  'D'  // Cycle decimation factor
+#define MREC_KEY_CHANNELS    'C'  // Cycle channel preset
+#define MREC_KEY_EXIT        VT100_ESC
+
+// Short macro for VT100 line clearing
+#define CL                   VT100_CLR_LINE
+
+// Macro to combine MPRINTF with line counter increment for cleaner code
+#define MPRINTF_LINE(line_var, ...) \
+  do                                \
+  {                                 \
+    MPRINTF(CL __VA_ARGS__);        \
+    (line_var)++;                   \
+  } while (0)
+
+typedef struct
+{
+  const char *name;
+  uint32_t    mask;
+} T_mrec_preset;
+
+// clang-format off
+static const T_mrec_preset g_mrec_presets[] =
+{
+  { "Currents and PWM, both motors", MREC_DEFAULT_CHANNELS },
+  { "Motor 1 raw ADC and PWM",       BIT(MREC_CH_I_U_M1) | BIT(MREC_CH_I_V_M1) | BIT(MREC_CH_I_W_M1) | BIT(MREC_CH_IPWR_M1) |
+                                     BIT(MREC_CH_SPEED_M1) | BIT(MREC_CH_POS_M1) | BIT(MREC_CH_V_U_M1) | BIT(MREC_CH_V_V_M1) |
+                                     BIT(MREC_CH_V_W_M1) | BIT(MREC_CH_PWM_U_M1) | BIT(MREC_CH_PWM_V_M1) | BIT(MREC_CH_PWM_W_M1) },
+  { "Motor 2 raw ADC and PWM",       BIT(MREC_CH_I_U_M2) | BIT(MREC_CH_I_V_M2) | BIT(MREC_CH_I_W_M2) | BIT(MREC_CH_IPWR_M2) |
+                                     BIT(MREC_CH_SPEED_M2) | BIT(MREC_CH_POS_M2) | BIT(MREC_CH_V_U_M2) | BIT(MREC_CH_V_V_M2) |
+                                     BIT(MREC_CH_V_W_M2) | BIT(MREC_CH_PWM_U_M2) | BIT(MREC_CH_PWM_V_M2) | BIT(MREC_CH_PWM_W_M2) },
+  { "Fast filtered currents",        BIT(MREC_CH_I_U_FAST_M1) | BIT(MREC_CH_I_V_FAST_M1) | BIT(MREC_CH_I_W_FAST_M1) |
+                                     BIT(MREC_CH_I_U_FAST_M2) | BIT(MREC_CH_I_V_FAST_M2) | BIT(MREC_CH_I_W_FAST_M2) },
+};
+
+static const uint16_t g_mrec_decimations[] = { 1, 2, 4, 8, 16 };
+
+static const char *const g_mrec_state_names[] = { "IDLE", "ARMED", "RUNNING", "FLUSHING" };
+// clang-format on
+
+static uint32_t g_mrec_preset_indx;
+static uint32_t g_mrec_decim_indx;
+
+static uint8_t _Mrec_print_status(void);
+
+/*-----------------------------------------------------------------------------------------------------
+  Display recorder settings and status
+
+  Parameters:
+    None
+
+  Return:
+    Next available line number
+-----------------------------------------------------------------------------------------------------*/
+static uint8_t _Mrec_print_status(void)
+{
+  GET_MCBL;
+  uint8_t                cln = MREC_DIAG_START_LINE;
+  T_mrec_status          st;
+  T_cycle_profile_report rep;
+
+  Motion_recorder_get_status(&st);
+  Cycle_profile_get_report(&g_mrec_write_profile, &rep);
+
+  MPRINTF(VT100_CURSOR_SET, cln, 1);
+  MPRINTF_LINE(cln, "Preset:      %s\r\n", g_mrec_presets[g_mrec_preset_indx].name);
+  MPRINTF_LINE(cln, "Decimation:  %u (%u Hz frame rate at %u Hz PWM), duration %u ms\r\n",
+               (unsigned int)g_mrec_decimations[g_mrec_decim_indx],
+               (unsigned int)(g_adc_pwm_frequency / g_mrec_decimations[g_mrec_decim_indx]),
+               (unsigned int)g_adc_pwm_frequency,
+               (unsigned int)MREC_DURATION_MS);
+  MPRINTF_LINE(cln, "\r\n");
+  MPRINTF_LINE(cln, "State:       %s\r\n", (st.state < 4) ? g_mrec_state_names[st.state] : "?");
+  MPRINTF_LINE(cln, "File:        %s\r\n", st.file_name);
+  MPRINTF_LINE(cln, "Channels:    %u (mask 0x%08X), %u Hz\r\n", (unsigned int)st.channel_count, (unsigned int)st.channel_mask, (unsigned int)st.frame_rate_hz);
+  MPRINTF_LINE(cln, "Captured:    %u frames\r\n", (unsigned int)st.frames_captured);
+  MPRINTF_LINE(cln, "Written:     %u frames in %u blocks\r\n", (unsigned int)st.frames_written, (unsigned int)st.blocks_written);
+  MPRINTF_LINE(cln, "Lost:        %u frames\r\n", (unsigned int)st.frames_lost);
+  MPRINTF_LINE(cln, "Errors:      %u\r\n", (unsigned int)st.write_err);
+  MPRINTF_LINE(cln, "Block write: avg %u us, max %u us\r\n", (unsigned int)(rep.avg_ns / 1000), (unsigned int)(rep.max_ns / 1000));
+  MPRINTF_LINE(cln, "\r\n");
+  MPRINTF_LINE(cln, "<S> - Start, <A> - Arm (start on motor soft start), <T> - Stop\r\n");
+  MPRINTF_LINE(cln, "<C> - Next channel preset, <D> - Next decimation, <ESC> - Exit\r\n");
+
+  return cln;
+}
+
+/*-----------------------------------------------------------------------------------------------------
+  Motion recorder screen. Captures ADC samples and PWM levels every PWM cycle to a file on the SD card.
+
+  Parameters:
+    keycode - Not used
+
+  Return:
+    None
+-----------------------------------------------------------------------------------------------------*/
+void Diagnostic_Motion_recorder(uint8_t keycode)
+{
+  GET_MCBL;
+  uint8_t key = 0;
+
+  MPRINTF(VT100_CLEAR_AND_HOME);
+  MPRINTF(MREC_DIAG_HEADER);
+  (void)_Mrec_print_status();
+
+  while (1)
+  {
+    if (VT100_wait_special_key(&key, ms_to_ticks(MREC_DIAG_REFRESH_MS)) == RES_OK)
+    {
+      if (key == MREC_KEY_EXIT)
+      {
+        break;
+      }
+      key = (uint8_t)toupper(key);
+      if ((key == MREC_KEY_START) || (key == MREC_KEY_ARM))
+      {
+        Motion_recorder_start(g_mrec_presets[g_mrec_preset_indx].mask, g_mrec_decimations[g_mrec_decim_indx], MREC_DURATION_MS, (key == MREC_KEY_ARM) ? 1 : 0);
+      }
+      else if (key == MREC_KEY_STOP)
+      {
+        Motion_recorder_stop();
+      }
+      else if (key == MREC_KEY_CHANNELS)
+      {
+        g_mrec_preset_indx = (g_mrec_preset_indx + 1) % (sizeof(g_mrec_presets) / sizeof(g_mrec_presets[0]));
+      }
+      else if (key == MREC_KEY_DECIMATION)
+      {
+        g_mrec_decim_indx = (g_mrec_decim_indx + 1) % (sizeof(g_mrec_decimations) / sizeof(g_mrec_decimations[0]));
+      }
+    }
+    (void)_Mrec_print_status();
+  }
+}
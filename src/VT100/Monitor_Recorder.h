@@ -0,0 +1,6 @@
+#ifndef MONITOR_RECORDER_H
+#define MONITOR_RECORDER_H
+
+void Diagnostic_Motion_recorder(uint8_t keycode);
+
+#endif  // MONITOR_RECORDER_H
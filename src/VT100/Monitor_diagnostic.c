@@ -24,6 +24,8 @@ const T_VT100_Menu_item MENU_DIAGNOSTIC_ITEMS[] =
   { '7', 0,                            (void *)&MENU_LittleFS },
   { '8', 0,                            (void *)&MENU_RTT      },
   { '9', 0,                            (void *)&MENU_OSPI     },
+  { 'P', Diagnostic_Performance,       0                      },
+  { 'C', Diagnostic_Motion_recorder,   0                      },
   { 'R', 0,                            0                      },
   { 'M', 0,                            (void *)&MENU_MAIN     },
   { 0 } // End of menu
@@ -42,6 +44,8 @@ const T_VT100_Menu MENU_DIAGNOSTIC = {
   "\033[5C <7> - LittleFS file system\r\n"
   "\033[5C <8> - RTT testing menu\r\n"
   "\033[5C <9> - OSPI flash testing\r\n"
+  "\033[5C <P> - Performance counters\r\n"
+  "\033[5C <C> - Motion recorder\r\n"
   "\033[5C <R> - Display previous menu\r\n"
   "\033[5C <M> - Display main menu\r\n",
   MENU_DIAGNOSTIC_ITEMS,
@@ -332,6 +336,7 @@ static void Diagnostic_Show_heap_state(uint8_t keycode)
     MPRINTF(" %-20s : %10lu bytes\r\n", "Total size", (unsigned long)pool_size);
     MPRINTF(" %-20s : %10lu bytes\r\n", "Used", (unsigned long)used_bytes);            // Сколько байт занято
     MPRINTF(" %-20s : %10lu bytes\r\n", "Available", (unsigned long)avail_bytes);
+    MPRINTF(" %-20s : %10lu bytes\r\n", "Min available", (unsigned long)App_get_RAM_pool_min_avail());  // Наименьший свободный объем с момента старта
     MPRINTF(" %-20s : %9lu %%\r\n\r\n", "Used percent", (unsigned long)used_percent);  // Процент занятой памяти
     MPRINTF(" %-20s : %10lu\r\n", "Fragments", (unsigned long)fragments);
     MPRINTF(" %-20s : %10lu\r\n", "Suspended threads", (unsigned long)suspended_count);